@@ -2275,6 +2275,23 @@ std::optional<rjson::value> executor::describe_single_item(schema_ptr schema,
     return item;
 }
 
+std::vector<rjson::value> executor::describe_multi_item(schema_ptr schema,
+        const query::partition_slice& slice,
+        const cql3::selection::selection& selection,
+        const query::result& query_result,
+        const attrs_to_get& attrs_to_get) {
+    cql3::selection::result_set_builder builder(selection, gc_clock::now(), cql_serialization_format::latest());
+    query::result_view::consume(query_result, slice, cql3::selection::result_set_builder::visitor(builder, *schema, selection));
+    auto result_set = builder.build();
+    std::vector<rjson::value> ret;
+    for (auto& result_row : result_set->rows()) {
+        rjson::value item = rjson::empty_object();
+        describe_single_item(selection, result_row, attrs_to_get, item);
+        ret.push_back(std::move(item));
+    }
+    return ret;
+}
+
 static bool check_needs_read_before_write(const parsed::value& v) {
     return std::visit(overloaded_functor {
         [&] (const parsed::constant& c) -> bool {
@@ -2961,51 +2978,6 @@ static rjson::value describe_item(schema_ptr schema,
     return item_descr;
 }
 
-future<executor::request_return_type> executor::get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
-    _stats.api_operations.get_item++;
-    auto start_time = std::chrono::steady_clock::now();
-    elogger.trace("Getting item {}", request);
-
-    schema_ptr schema = get_table(_proxy, request);
-
-    tracing::add_table_name(trace_state, schema->ks_name(), schema->cf_name());
-
-    rjson::value& query_key = request["Key"];
-    db::consistency_level cl = get_read_consistency(request);
-
-    partition_key pk = pk_from_json(query_key, schema);
-    dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*schema, pk))};
-
-    std::vector<query::clustering_range> bounds;
-    if (schema->clustering_key_size() == 0) {
-        bounds.push_back(query::clustering_range::make_open_ended_both_sides());
-    } else {
-        clustering_key ck = ck_from_json(query_key, schema);
-        bounds.push_back(query::clustering_range::make_singular(std::move(ck)));
-    }
-    check_key(query_key, schema);
-
-    //TODO(sarna): It would be better to fetch only some attributes of the map, not all
-    auto regular_columns = boost::copy_range<query::column_id_vector>(
-            schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-
-    auto selection = cql3::selection::selection::wildcard(schema);
-
-    auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
-    auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice));
-
-    std::unordered_set<std::string> used_attribute_names;
-    auto attrs_to_get = calculate_attrs_to_get(request, used_attribute_names);
-    verify_all_are_used(request, "ExpressionAttributeNames", used_attribute_names, "GetItem");
-
-    return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl,
-            service::storage_proxy::coordinator_query_options(executor::default_timeout(), std::move(permit), client_state, trace_state)).then(
-            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = std::move(attrs_to_get), start_time = std::move(start_time)] (service::storage_proxy::coordinator_query_result qr) mutable {
-        _stats.api_operations.get_item_latency.add(std::chrono::steady_clock::now() - start_time);
-        return make_ready_future<executor::request_return_type>(make_jsonable(describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get))));
-    });
-}
-
 // is_big() checks approximately if the given JSON value is "bigger" than
 // the given big_size number of bytes. The goal is to *quickly* detect
 // oversized JSON that, for example, is too large to be serialized to a
@@ -3069,6 +3041,55 @@ static void check_big_object(const rjson::value& val, int& size_left) {
     }
 }
 
+future<executor::request_return_type> executor::get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
+    _stats.api_operations.get_item++;
+    auto start_time = std::chrono::steady_clock::now();
+    elogger.trace("Getting item {}", request);
+
+    schema_ptr schema = get_table(_proxy, request);
+
+    tracing::add_table_name(trace_state, schema->ks_name(), schema->cf_name());
+
+    rjson::value& query_key = request["Key"];
+    db::consistency_level cl = get_read_consistency(request);
+
+    partition_key pk = pk_from_json(query_key, schema);
+    dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*schema, pk))};
+
+    std::vector<query::clustering_range> bounds;
+    if (schema->clustering_key_size() == 0) {
+        bounds.push_back(query::clustering_range::make_open_ended_both_sides());
+    } else {
+        clustering_key ck = ck_from_json(query_key, schema);
+        bounds.push_back(query::clustering_range::make_singular(std::move(ck)));
+    }
+    check_key(query_key, schema);
+
+    //TODO(sarna): It would be better to fetch only some attributes of the map, not all
+    auto regular_columns = boost::copy_range<query::column_id_vector>(
+            schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+
+    auto selection = cql3::selection::selection::wildcard(schema);
+
+    auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
+    auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice));
+
+    std::unordered_set<std::string> used_attribute_names;
+    auto attrs_to_get = calculate_attrs_to_get(request, used_attribute_names);
+    verify_all_are_used(request, "ExpressionAttributeNames", used_attribute_names, "GetItem");
+
+    return _proxy.query(schema, std::move(command), std::move(partition_ranges), cl,
+            service::storage_proxy::coordinator_query_options(executor::default_timeout(), std::move(permit), client_state, trace_state)).then(
+            [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = std::move(attrs_to_get), start_time = std::move(start_time)] (service::storage_proxy::coordinator_query_result qr) mutable {
+        _stats.api_operations.get_item_latency.add(std::chrono::steady_clock::now() - start_time);
+        rjson::value res = describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get));
+        if (is_big(res)) {
+            return make_ready_future<executor::request_return_type>(make_streamed(std::move(res)));
+        }
+        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(res)));
+    });
+}
+
 future<executor::request_return_type> executor::batch_get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     // FIXME: In this implementation, an unbounded batch size can cause
     // unbounded response JSON object to be buffered in memory, unbounded
@@ -3081,13 +3102,17 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
     // We need to validate all the parameters before starting any asynchronous
     // query, and fail the entire request on any parse error. So we parse all
     // the input into our own vector "requests".
+    // Keys of the same partition are read with one query, with a singular
+    // clustering range for each of them, so each single_request holds the
+    // keys of one partition and their positions in the table's "Keys" array.
     struct table_requests {
         schema_ptr schema;
         db::consistency_level cl;
         ::shared_ptr<const alternator::attrs_to_get> attrs_to_get;
         struct single_request {
             partition_key pk;
-            clustering_key ck;
+            std::vector<clustering_key> cks;
+            std::vector<size_t> key_indexes;
         };
         std::vector<single_request> requests;
     };
@@ -3101,46 +3126,73 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
         std::unordered_set<std::string> used_attribute_names;
         rs.attrs_to_get = ::make_shared<const attrs_to_get>(calculate_attrs_to_get(it->value, used_attribute_names));
         verify_all_are_used(request, "ExpressionAttributeNames", used_attribute_names, "GetItem");
+        std::unordered_map<partition_key, size_t, partition_key::hashing, partition_key::equality> partition_requests(
+                1, partition_key::hashing(*rs.schema), partition_key::equality(*rs.schema));
         auto& keys = (it->value)["Keys"];
+        size_t key_index = 0;
         for (const rjson::value& key : keys.GetArray()) {
-            rs.requests.push_back({pk_from_json(key, rs.schema), ck_from_json(key, rs.schema)});
+            partition_key pk = pk_from_json(key, rs.schema);
+            clustering_key ck = ck_from_json(key, rs.schema);
             check_key(key, rs.schema);
+            auto pr = partition_requests.find(pk);
+            // A key already requested in this partition (or any key, for
+            // tables without a clustering key) gets a query of its own, so
+            // that duplicate keys still get one item each in the response.
+            if (pr == partition_requests.end() || rs.schema->clustering_key_size() == 0 ||
+                    boost::algorithm::any_of(rs.requests[pr->second].cks, [&] (const clustering_key& other) {
+                        return clustering_key::equality(*rs.schema)(ck, other);
+                    })) {
+                pr = partition_requests.insert_or_assign(pk, rs.requests.size()).first;
+                rs.requests.push_back({std::move(pk), {}, {}});
+            }
+            auto& r = rs.requests[pr->second];
+            r.cks.push_back(std::move(ck));
+            r.key_indexes.push_back(key_index++);
         }
         requests.emplace_back(std::move(rs));
     }
 
     // If got here, all "requests" are valid, so let's start them all
     // in parallel. The requests object are then immediately destroyed.
-    std::vector<future<std::tuple<std::string, std::optional<rjson::value>>>> response_futures;
-    for (const auto& rs : requests) {
-        for (const auto &r : rs.requests) {
+    std::vector<future<std::tuple<std::string, std::vector<rjson::value>>>> response_futures;
+    // The table and the positions in its "Keys" array of the keys read by
+    // each of response_futures, used to fill UnprocessedKeys on failure.
+    std::vector<std::pair<size_t, std::vector<size_t>>> response_keys;
+    for (size_t table_index = 0; table_index < requests.size(); ++table_index) {
+        auto& rs = requests[table_index];
+        for (auto& r : rs.requests) {
             dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*rs.schema, std::move(r.pk)))};
             std::vector<query::clustering_range> bounds;
             if (rs.schema->clustering_key_size() == 0) {
                 bounds.push_back(query::clustering_range::make_open_ended_both_sides());
             } else {
-                bounds.push_back(query::clustering_range::make_singular(std::move(r.ck)));
+                // The ranges of a slice must be sorted in clustering order.
+                std::sort(r.cks.begin(), r.cks.end(), clustering_key::less_compare(*rs.schema));
+                for (auto& ck : r.cks) {
+                    bounds.push_back(query::clustering_range::make_singular(std::move(ck)));
+                }
             }
             auto regular_columns = boost::copy_range<query::column_id_vector>(
                     rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
             auto selection = cql3::selection::selection::wildcard(rs.schema);
             auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
             auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice));
-            future<std::tuple<std::string, std::optional<rjson::value>>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
+            future<std::tuple<std::string, std::vector<rjson::value>>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
                     service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
                     [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
                 utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
-                std::optional<rjson::value> json = describe_single_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
-                return make_ready_future<std::tuple<std::string, std::optional<rjson::value>>>(
-                        std::make_tuple(schema->cf_name(), std::move(json)));
+                std::vector<rjson::value> jsons = describe_multi_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
+                return make_ready_future<std::tuple<std::string, std::vector<rjson::value>>>(
+                        std::make_tuple(schema->cf_name(), std::move(jsons)));
             });
             response_futures.push_back(std::move(f));
+            response_keys.emplace_back(table_index, std::move(r.key_indexes));
         }
     }
 
     // Wait for all requests to complete, and then return the response.
     return when_all(response_futures.begin(), response_futures.end()).then(
-            [request_items = std::move(request_items)] (std::vector<future<std::tuple<std::string, std::optional<rjson::value>>>> responses) mutable {
+            [request_items = std::move(request_items), response_keys = std::move(response_keys)] (std::vector<future<std::tuple<std::string, std::vector<rjson::value>>>> responses) mutable {
         rjson::value response = rjson::empty_object();
         rjson::add(response, "Responses", rjson::empty_object());
         rjson::add(response, "UnprocessedKeys", rjson::empty_object());
@@ -3148,16 +3200,15 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
         // from one of the operations will be returned.
         bool some_succeeded = false;
         std::exception_ptr eptr;
-        // These iterators are used to match keys from the requests with their corresponding responses.
-        // If any of the responses failed, the key iterator will be used to insert
-        // an entry into the UnprocessedKeys object, which will ultimately be returned
-        // to the user in case of partial success of BatchGetItem operation.
-        rjson::value::MemberIterator table_items_it = request_items.MemberBegin();
-        rjson::value::ValueIterator key_it = table_items_it->value["Keys"].Begin();
-
-        for (auto& fut : responses) {
+        // If any of the responses failed, response_keys is used to insert
+        // the keys it was reading into the UnprocessedKeys object, which
+        // will ultimately be returned to the user in case of partial success
+        // of BatchGetItem operation.
+        for (size_t i = 0; i < responses.size(); ++i) {
+            auto& fut = responses[i];
             if (fut.failed()) {
                 eptr = fut.get_exception();
+                auto table_items_it = request_items.MemberBegin() + response_keys[i].first;
                 if (!response["UnprocessedKeys"].HasMember(table_items_it->name)) {
                     rjson::add_with_string_name(response["UnprocessedKeys"], rjson::to_string_view(table_items_it->name), rjson::empty_object());
                     rjson::value& unprocessed_item = response["UnprocessedKeys"][table_items_it->name];
@@ -3168,22 +3219,17 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
                     }
                     rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
                 }
-                rjson::push_back(response["UnprocessedKeys"][table_items_it->name]["Keys"], std::move(*key_it));
+                for (size_t key_index : response_keys[i].second) {
+                    rjson::push_back(response["UnprocessedKeys"][table_items_it->name]["Keys"], std::move(table_items_it->value["Keys"][key_index]));
+                }
             } else {
                 auto t = fut.get();
                 some_succeeded = true;
                 if (!response["Responses"].HasMember(std::get<0>(t).c_str())) {
                     rjson::add_with_string_name(response["Responses"], std::get<0>(t), rjson::empty_array());
                 }
-                if (std::get<1>(t)) {
-                    rjson::push_back(response["Responses"][std::get<0>(t)], std::move(*std::get<1>(t)));
-                }
-            }
-            key_it++;
-            if (key_it == table_items_it->value["Keys"].End()) {
-                table_items_it++;
-                if (table_items_it != request_items.MemberEnd()) {
-                    key_it = table_items_it->value["Keys"].Begin();
+                for (auto& json : std::get<1>(t)) {
+                    rjson::push_back(response["Responses"][std::get<0>(t)], std::move(json));
                 }
             }
         }
@@ -3543,8 +3589,7 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
             // update our "filtered_row_matched_total" for all the rows matched, despited the filter
             cql_stats.filtered_rows_matched_total += size;
         }
-        // TODO: better threshold
-        if (size > 10) {
+        if (is_big(items)) {
             return make_ready_future<executor::request_return_type>(make_streamed(std::move(items)));
         }
         return make_ready_future<executor::request_return_type>(make_jsonable(std::move(items)));
@@ -218,6 +218,12 @@ class executor : public peering_sharded_service<executor> {
         const query::result&,
         const attrs_to_get&);
 
+    static std::vector<rjson::value> describe_multi_item(schema_ptr,
+        const query::partition_slice&,
+        const cql3::selection::selection&,
+        const query::result&,
+        const attrs_to_get&);
+
     static void describe_single_item(const cql3::selection::selection&,
         const std::vector<bytes_opt>&,
         const attrs_to_get&,
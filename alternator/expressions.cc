@@ -24,6 +24,7 @@
 #include <boost/algorithm/cxx11/all_of.hpp>
 
 #include <functional>
+#include <list>
 #include <unordered_map>
 
 namespace alternator {
@@ -43,31 +44,92 @@ Result do_with_parser(std::string_view input, Func&& f) {
     return result;
 }
 
+static thread_local expression_cache_stats cache_stats;
+
+// A per-shard cache of parsed expressions, keyed by the expression's text.
+// Clients typically send the same few expression strings over and over, so
+// the cache saves running the ANTLR parser on most requests. The cached
+// expressions are unresolved - they still refer to ":val" and "#name"
+// placeholders - so a lookup returns a copy, which the caller then resolves
+// against its own request's ExpressionAttributeNames/Values. Expressions
+// which fail to parse are not cached.
+template <typename Parsed>
+class parsed_expression_cache {
+    using lru_list = std::list<std::pair<std::string, Parsed>>;
+    lru_list _lru;
+    std::unordered_map<std::string_view, typename lru_list::iterator> _index;
+public:
+    static constexpr size_t max_entries = 1024;
+    // Returns the cached parse of the given expression, or nullptr.
+    const Parsed* find(std::string_view query) {
+        auto it = _index.find(query);
+        if (it == _index.end()) {
+            ++cache_stats.misses;
+            return nullptr;
+        }
+        ++cache_stats.hits;
+        _lru.splice(_lru.begin(), _lru, it->second);
+        return &it->second->second;
+    }
+    void insert(std::string_view query, const Parsed& parsed) {
+        if (_index.contains(query)) {
+            return;
+        }
+        if (_lru.size() >= max_entries) {
+            _index.erase(_lru.back().first);
+            _lru.pop_back();
+        }
+        _lru.emplace_front(std::string(query), parsed);
+        _index.emplace(_lru.front().first, _lru.begin());
+    }
+};
+
+template <typename Parsed, typename Func>
+static Parsed parse_cached(std::string_view query, Func&& parse) {
+    static thread_local parsed_expression_cache<Parsed> cache;
+    if (const Parsed* parsed = cache.find(query)) {
+        return *parsed;
+    }
+    Parsed ret = parse();
+    cache.insert(query, ret);
+    return ret;
+}
+
+const expression_cache_stats& get_expression_cache_stats() {
+    return cache_stats;
+}
+
 parsed::update_expression
 parse_update_expression(std::string_view query) {
-    try {
-        return do_with_parser(query,  std::mem_fn(&expressionsParser::update_expression));
-    } catch (...) {
-        throw expressions_syntax_error(format("Failed parsing UpdateExpression '{}': {}", query, std::current_exception()));
-    }
+    return parse_cached<parsed::update_expression>(query, [query] {
+        try {
+            return do_with_parser(query,  std::mem_fn(&expressionsParser::update_expression));
+        } catch (...) {
+            throw expressions_syntax_error(format("Failed parsing UpdateExpression '{}': {}", query, std::current_exception()));
+        }
+    });
 }
 
 std::vector<parsed::path>
 parse_projection_expression(std::string_view query) {
-    try {
-        return do_with_parser(query,  std::mem_fn(&expressionsParser::projection_expression));
-    } catch (...) {
-        throw expressions_syntax_error(format("Failed parsing ProjectionExpression '{}': {}", query, std::current_exception()));
-    }
+    return parse_cached<std::vector<parsed::path>>(query, [query] {
+        try {
+            return do_with_parser(query,  std::mem_fn(&expressionsParser::projection_expression));
+        } catch (...) {
+            throw expressions_syntax_error(format("Failed parsing ProjectionExpression '{}': {}", query, std::current_exception()));
+        }
+    });
 }
 
 parsed::condition_expression
 parse_condition_expression(std::string_view query) {
-    try {
-        return do_with_parser(query,  std::mem_fn(&expressionsParser::condition_expression));
-    } catch (...) {
-        throw expressions_syntax_error(format("Failed parsing ConditionExpression '{}': {}", query, std::current_exception()));
-    }
+    return parse_cached<parsed::condition_expression>(query, [query] {
+        try {
+            return do_with_parser(query,  std::mem_fn(&expressionsParser::condition_expression));
+        } catch (...) {
+            throw expressions_syntax_error(format("Failed parsing ConditionExpression '{}': {}", query, std::current_exception()));
+        }
+    });
 }
 
 namespace parsed {
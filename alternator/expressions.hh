@@ -26,10 +26,19 @@ class expressions_syntax_error : public std::runtime_error {
     using runtime_error::runtime_error;
 };
 
+// The parse_*_expression() functions cache the expressions they parse,
+// per shard, and return a copy of the cached parse on a repeated query.
 parsed::update_expression parse_update_expression(std::string_view query);
 std::vector<parsed::path> parse_projection_expression(std::string_view query);
 parsed::condition_expression parse_condition_expression(std::string_view query);
 
+struct expression_cache_stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+// Returns this shard's hit and miss counts of the cache of parsed expressions.
+const expression_cache_stats& get_expression_cache_stats();
+
 void resolve_update_expression(parsed::update_expression& ue,
         const rjson::value* expression_attribute_names,
         const rjson::value* expression_attribute_values,
@@ -111,6 +111,9 @@ struct to_json_visitor {
         std::string b64 = base64_encode(bv);
         rjson::add_with_string_name(deserialized, type_ident, rjson::from_string(b64));
     }
+    void operator()(const boolean_type_impl& t) const {
+        rjson::add_with_string_name(deserialized, type_ident, rjson::value(value_cast<bool>(boolean_type->deserialize(bv))));
+    }
     // default
     void operator()(const abstract_type& t) const {
         rjson::add_with_string_name(deserialized, type_ident, rjson::parse(to_json_string(t, bytes(bv))));
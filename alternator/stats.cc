@@ -7,6 +7,7 @@
  */
 
 #include "stats.hh"
+#include "expressions.hh"
 #include "utils/histogram_metrics_helper.hh"
 #include <seastar/core/metrics.hh>
 
@@ -92,6 +93,10 @@ stats::stats() : api_operations{} {
                     seastar::metrics::description("number of rows read and matched during filtering operations")),
             seastar::metrics::make_total_operations("filtered_rows_dropped_total", [this] { return cql_stats.filtered_rows_read_total - cql_stats.filtered_rows_matched_total; },
                     seastar::metrics::description("number of rows read and dropped during filtering operations")),
+            seastar::metrics::make_total_operations("expression_cache_hits", [] { return get_expression_cache_stats().hits; },
+                    seastar::metrics::description("number of expressions found already parsed in the expression cache")),
+            seastar::metrics::make_total_operations("expression_cache_misses", [] { return get_expression_cache_stats().misses; },
+                    seastar::metrics::description("number of expressions which had to be parsed because they were not in the expression cache")),
     });
 }
 
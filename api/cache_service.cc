@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/coroutine.hh>
+
 #include "cache_service.hh"
 #include "api/api-doc/cache_service.json.hh"
 #include "column_family.hh"
@@ -255,6 +257,43 @@ void set_cache_service(http_context& ctx, routes& r) {
         });
     });
 
+    cs::get_row_table_occupancy.set(r, [&ctx] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        // Partitions and partition evictions, by table id.
+        using table_occupancy = std::unordered_map<utils::UUID, std::pair<uint64_t, uint64_t>>;
+        auto occupancy = co_await ctx.db.map_reduce0([] (replica::database& db) {
+            table_occupancy res;
+            for (auto& [id, t] : db.get_column_families()) {
+                if (auto ts = db.row_cache_tracker().get_table_stats(id)) {
+                    res.emplace(id, std::make_pair(ts->partitions, ts->partition_evictions));
+                }
+            }
+            return res;
+        }, table_occupancy(), [] (table_occupancy a, const table_occupancy& b) {
+            for (auto& [id, v] : b) {
+                a[id].first += v.first;
+                a[id].second += v.second;
+            }
+            return a;
+        });
+        auto& db = ctx.db.local();
+        std::vector<cs::table_cache_occupancy> res;
+        for (auto& [id, v] : occupancy) {
+            if (!db.column_family_exists(id)) {
+                continue;
+            }
+            auto s = db.find_schema(id);
+            cs::table_cache_occupancy o;
+            o.ks = s->ks_name();
+            o.cf = s->cf_name();
+            o.partitions = v.first;
+            o.evictions = v.second;
+            o.min_fraction = s->caching_options().min_fraction();
+            o.max_fraction = s->caching_options().max_fraction();
+            res.push_back(std::move(o));
+        }
+        co_return res;
+    });
+
     cs::get_counter_capacity.set(r, [] (std::unique_ptr<request> req) {
         // TBD
         // FIXME
@@ -17,6 +17,7 @@
 #include "storage_service.hh"
 
 #include <utility>
+#include <boost/lexical_cast.hpp>
 
 namespace api {
 
@@ -41,6 +42,21 @@ static std::unordered_map<std::pair<sstring, sstring>, uint64_t, utils::tuple_ha
     return std::move(a);
 }
 
+static double parse_min_droppable_ratio(const request& req) {
+    auto s = req.get_query_param("min_droppable_ratio");
+    if (s.empty()) {
+        return 0.2;
+    }
+    try {
+        auto ratio = boost::lexical_cast<double>(s);
+        if (ratio >= 0 && ratio <= 1) {
+            return ratio;
+        }
+    } catch (boost::bad_lexical_cast&) {
+    }
+    throw httpd::bad_param_exception(format("min_droppable_ratio must be a number between 0 and 1, got {}", s));
+}
+
 
 void set_compaction_manager(http_context& ctx, routes& r) {
     cm::get_compactions.set(r, [&ctx] (std::unique_ptr<request> req) {
@@ -125,6 +141,52 @@ void set_compaction_manager(http_context& ctx, routes& r) {
         co_return json_void();
     });
 
+    cm::get_tombstone_gc_estimates.set(r, [&ctx] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        auto ks_name = validate_keyspace(ctx, req->param);
+        auto table_names = parse_tables(ks_name, ctx, req->query_parameters, "tables");
+        if (table_names.empty()) {
+            table_names = map_keys(ctx.db.local().find_keyspace(ks_name).metadata().get()->cf_meta_data());
+        }
+        auto min_droppable_ratio = parse_min_droppable_ratio(*req);
+        auto res = co_await ctx.db.map_reduce0([&ks_name, &table_names, min_droppable_ratio] (replica::database& db) {
+            std::vector<cm::tombstone_gc_estimate> res;
+            auto& cm = db.get_compaction_manager();
+            for (auto& table_name : table_names) {
+                auto& t = db.find_column_family(ks_name, table_name);
+                for (auto& e : cm.estimate_droppable_tombstones(t, min_droppable_ratio)) {
+                    cm::tombstone_gc_estimate est;
+                    est.ks = ks_name;
+                    est.cf = table_name;
+                    est.sstable = e.sst->get_filename();
+                    est.data_size = e.sst->data_size();
+                    est.droppable_ratio = e.droppable_ratio;
+                    est.droppable_bytes = e.droppable_bytes;
+                    est.selected = e.selected;
+                    res.push_back(std::move(est));
+                }
+            }
+            return res;
+        }, std::vector<cm::tombstone_gc_estimate>(), concat<cm::tombstone_gc_estimate>);
+        co_return res;
+    });
+
+    cm::force_tombstone_gc_compaction.set(r, [&ctx] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        auto ks_name = validate_keyspace(ctx, req->param);
+        auto table_names = parse_tables(ks_name, ctx, req->query_parameters, "tables");
+        if (table_names.empty()) {
+            table_names = map_keys(ctx.db.local().find_keyspace(ks_name).metadata().get()->cf_meta_data());
+        }
+        auto min_droppable_ratio = parse_min_droppable_ratio(*req);
+        co_await ctx.db.invoke_on_all([&ks_name, &table_names, min_droppable_ratio] (replica::database& db) {
+            auto& cm = db.get_compaction_manager();
+            return parallel_for_each(table_names, [&db, &cm, &ks_name, min_droppable_ratio] (sstring& table_name) {
+                auto& t = db.find_column_family(ks_name, table_name);
+                return cm.perform_tombstone_gc_compaction(&t, min_droppable_ratio);
+            });
+        });
+        co_return json_void();
+    });
+
     cm::get_pending_tasks.set(r, [&ctx] (std::unique_ptr<request> req) {
         return map_reduce_cf(ctx, int64_t(0), [](replica::column_family& cf) {
             return cf.get_compaction_strategy().estimated_pending_compactions(cf.as_table_state());
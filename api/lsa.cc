@@ -28,6 +28,41 @@ void set_lsa(http_context& ctx, routes& r) {
             return json::json_return_type(json::json_void());
         });
     });
+
+    httpd::lsa_json::get_lsa_regions.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return ctx.db.map_reduce0([] (replica::database&) {
+            std::vector<httpd::lsa_json::region_stats> res;
+            for (auto& st : logalloc::shard_tracker().get_region_stats()) {
+                httpd::lsa_json::region_stats rs;
+                rs.shard = this_shard_id();
+                rs.id = st.id;
+                rs.owner = st.owner;
+                rs.evictable = st.evictable;
+                rs.total_space = st.occupancy.total_space();
+                rs.used_space = st.occupancy.used_space();
+                for (auto n : st.occupancy_histogram) {
+                    rs.occupancy_histogram.push(n);
+                }
+                rs.segments_compacted = st.segments_compacted;
+                rs.memory_compacted = st.memory_compacted;
+                rs.memory_evicted = st.memory_evicted;
+                rs.allocating_section_retries = st.allocating_section_retries;
+                rs.allocating_section_retry_time = st.allocating_section_retry_time.count();
+                res.push_back(std::move(rs));
+            }
+            return res;
+        }, std::vector<httpd::lsa_json::region_stats>(), concat<httpd::lsa_json::region_stats>).then([] (std::vector<httpd::lsa_json::region_stats> res) {
+            return json::json_return_type(std::move(res));
+        });
+    });
+
+    httpd::lsa_json::get_lsa_largest_reclaim_duration.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return ctx.db.map_reduce0([] (replica::database&) {
+            return int64_t(logalloc::shard_tracker().largest_reclaim_duration().count());
+        }, int64_t(0), [] (int64_t a, int64_t b) { return std::max(a, b); }).then([] (int64_t res) {
+            return json::json_return_type(res);
+        });
+    });
 }
 
 }
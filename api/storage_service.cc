@@ -320,6 +320,31 @@ void set_repair(http_context& ctx, routes& r, sharded<repair_service>& repair) {
         });
     });
 
+    ss::get_repair_parallelism.set(r, [&repair] (std::unique_ptr<request> req) {
+        return repair.local().get_parallelism().then([] (repair_parallelism p) {
+            ss::repair_parallelism res;
+            res.max_ranges_in_parallel = p.max_ranges_in_parallel;
+            res.ranges_in_parallel = p.ranges_in_parallel;
+            res.finished_ranges = p.finished_ranges;
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
+
+    ss::set_repair_parallelism.set(r, [&repair] (std::unique_ptr<request> req) {
+        long value;
+        try {
+            value = std::stol(req->get_query_param("value"));
+        } catch (...) {
+            throw httpd::bad_param_exception(format("Bad format value: {}", req->get_query_param("value")));
+        }
+        if (value < 1) {
+            throw httpd::bad_param_exception(format("Repair parallelism must be at least 1, got {}", value));
+        }
+        return repair.local().set_max_ranges_in_parallel(value).then([] {
+            return make_ready_future<json::json_return_type>(json_void());
+        });
+    });
+
     ss::force_terminate_all_repair_sessions.set(r, [&repair] (std::unique_ptr<request> req) {
         return repair.local().abort_all().then([] {
             return make_ready_future<json::json_return_type>(json_void());
@@ -339,6 +364,8 @@ void unset_repair(http_context& ctx, routes& r) {
     ss::get_active_repair_async.unset(r);
     ss::repair_async_status.unset(r);
     ss::repair_await_completion.unset(r);
+    ss::get_repair_parallelism.unset(r);
+    ss::set_repair_parallelism.unset(r);
     ss::force_terminate_all_repair_sessions.unset(r);
     ss::force_terminate_all_repair_sessions_new.unset(r);
 }
@@ -368,10 +395,32 @@ void set_sstables_loader(http_context& ctx, routes& r, sharded<sstables_loader>&
             return make_ready_future<json::json_return_type>(json_void());
         });
     });
+
+    ss::get_load_and_stream_progress.set(r, [&sst_loader] (std::unique_ptr<request> req) {
+        return sst_loader.local().get_load_and_stream_progress().then([] (load_and_stream_progress p) {
+            ss::load_and_stream_progress res;
+            res.sstables_total = p.sstables_total;
+            res.sstables_streamed = p.sstables_streamed;
+            res.partitions_total = p.partitions_total;
+            res.partitions_streamed = p.partitions_streamed;
+            res.bytes_streamed = p.bytes_streamed;
+            res.duration = p.duration;
+            res.bytes_per_second = p.duration > 0 ? p.bytes_streamed / p.duration : 0;
+            double eta = -1;
+            if (p.partitions_streamed >= p.partitions_total) {
+                eta = 0;
+            } else if (p.partitions_streamed && p.duration > 0) {
+                eta = (p.partitions_total - p.partitions_streamed) * p.duration / p.partitions_streamed;
+            }
+            res.eta = eta;
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
 }
 
 void unset_sstables_loader(http_context& ctx, routes& r) {
     ss::load_new_ss_tables.unset(r);
+    ss::get_load_and_stream_progress.unset(r);
 }
 
 void set_view_builder(http_context& ctx, routes& r, sharded<db::view::view_builder>& vb) {
@@ -1004,16 +1053,50 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         res.ttl = tracing::tracing::get_local_tracing_instance().slow_query_record_ttl().count() ;
         res.threshold = tracing::tracing::get_local_tracing_instance().slow_query_threshold().count();
         res.fast = tracing::tracing::get_local_tracing_instance().ignore_trace_events_enabled();
+        res.persist_ratio = tracing::tracing::get_local_tracing_instance().slow_query_persist_ratio();
         return res;
     });
 
+    ss::get_recent_slow_queries.set(r, [](std::unique_ptr<request> req) {
+        return tracing::tracing::tracing_instance().map_reduce0([] (const tracing::tracing& local_tracing) {
+            std::vector<ss::slow_query_summary> res;
+            for (const auto& q : local_tracing.recent_slow_queries()) {
+                ss::slow_query_summary s;
+                s.session_id = q.session_id.to_sstring();
+                s.shard = this_shard_id();
+                s.started_at = std::chrono::duration_cast<std::chrono::milliseconds>(q.session.started_at.time_since_epoch()).count();
+                s.duration = std::chrono::duration_cast<std::chrono::microseconds>(q.session.elapsed).count();
+                s.client = q.session.client.to_sstring();
+                s.username = q.session.username;
+                s.request = q.session.request;
+                for (const auto& t : q.session.tables) {
+                    s.tables.push(t);
+                }
+                for (const auto& [key, value] : q.session.parameters) {
+                    ss::mapper m;
+                    m.key = key;
+                    m.value = value;
+                    s.parameters.push(m);
+                }
+                res.push_back(std::move(s));
+            }
+            return res;
+        }, std::vector<ss::slow_query_summary>(), [] (std::vector<ss::slow_query_summary> a, std::vector<ss::slow_query_summary> b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        }).then([] (std::vector<ss::slow_query_summary> res) {
+            return make_ready_future<json::json_return_type>(std::move(res));
+        });
+    });
+
     ss::set_slow_query.set(r, [](std::unique_ptr<request> req) {
         auto enable = req->get_query_param("enable");
         auto ttl = req->get_query_param("ttl");
         auto threshold = req->get_query_param("threshold");
         auto fast = req->get_query_param("fast");
+        auto persist_ratio = req->get_query_param("persist_ratio");
         try {
-            return tracing::tracing::tracing_instance().invoke_on_all([enable, ttl, threshold, fast] (auto& local_tracing) {
+            return tracing::tracing::tracing_instance().invoke_on_all([enable, ttl, threshold, fast, persist_ratio] (auto& local_tracing) {
                 if (threshold != "") {
                     local_tracing.set_slow_query_threshold(std::chrono::microseconds(std::stol(threshold.c_str())));
                 }
@@ -1026,6 +1109,9 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
                 if (fast != "") {
                     local_tracing.set_ignore_trace_events(strcasecmp(fast.c_str(), "true") == 0);
                 }
+                if (persist_ratio != "") {
+                    local_tracing.set_slow_query_persist_ratio(std::stod(persist_ratio.c_str()));
+                }
             }).then([] {
                 return make_ready_future<json::json_return_type>(json_void());
             });
@@ -1202,6 +1288,17 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
                             info.filter_size = sstable->filter_size();
                             info.version = sstable->get_version();
 
+                            auto to_read_heat = [] (const sstables::read_heat::counters& c) {
+                                ss::sstable_read_heat h;
+                                h.filter_probes = c.filter_probes;
+                                h.filter_positives = c.filter_positives;
+                                h.index_lookups = c.index_lookups;
+                                h.bytes_read = c.bytes_read;
+                                return h;
+                            };
+                            info.read_heat = to_read_heat(sstable->get_read_heat().total());
+                            info.recent_read_heat = to_read_heat(sstable->get_read_heat().recent());
+
                             if (sstable->has_component(sstables::component_type::CompressionInfo)) {
                                 auto& c = sstable->get_compression();
                                 auto cp = sstables::get_sstable_compressor(c);
@@ -1315,12 +1412,13 @@ void set_snapshot(http_context& ctx, routes& r, sharded<db::snapshot_ctl>& snap_
         auto column_families = split(req->get_query_param("cf"), ",");
         auto sfopt = req->get_query_param("sf");
         auto sf = db::snapshot_ctl::skip_flush(strcasecmp(sfopt.c_str(), "true") == 0);
+        auto base = req->get_query_param("base");
 
         std::vector<sstring> keynames = split(req->get_query_param("kn"), ",");
 
         auto resp = make_ready_future<>();
         if (column_families.empty()) {
-            resp = snap_ctl.local().take_snapshot(tag, keynames, sf);
+            resp = snap_ctl.local().take_snapshot(tag, keynames, sf, base);
         } else {
             if (keynames.empty()) {
                 throw httpd::bad_param_exception("The keyspace of column families must be specified");
@@ -1328,7 +1426,7 @@ void set_snapshot(http_context& ctx, routes& r, sharded<db::snapshot_ctl>& snap_
             if (keynames.size() > 1) {
                 throw httpd::bad_param_exception("Only one keyspace allowed when specifying a column family");
             }
-            resp = snap_ctl.local().take_column_family_snapshot(keynames[0], column_families, tag, sf);
+            resp = snap_ctl.local().take_column_family_snapshot(keynames[0], column_families, tag, sf, base);
         }
         return resp.then([] {
             return make_ready_future<json::json_return_type>(json_void());
@@ -12,13 +12,45 @@
 #include "auth/common.hh"
 #include "auth/service.hh"
 
+#include <seastar/core/metrics.hh>
+#include <seastar/core/smp.hh>
+
 namespace auth {
 
 permissions_cache::permissions_cache(const permissions_cache_config& c, service& ser, logging::logger& log)
-        : _cache(c.max_entries, c.validity_period, c.update_period, log, [&ser, &log](const key_type& k) {
-              log.debug("Refreshing permissions for {}", k.first);
-              return ser.get_uncached_permissions(k.first, k.second);
+        : _cache(c.max_entries, c.validity_period, c.update_period, log, [this, &ser, &log](const key_type& k) {
+              return load(ser, log, k);
           }) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("permissions_cache", {
+        sm::make_derive("hits", [] { return shard_stats().hits; },
+                sm::description("Counts the permission lookups served from the cache.")),
+        sm::make_derive("misses", [] { return shard_stats().misses; },
+                sm::description("Counts the permission lookups that found no cached entry.")),
+        sm::make_derive("loads", [] { return shard_stats().loads; },
+                sm::description("Counts the permissions loaded, or refreshed, from the system tables by this shard.")),
+        sm::make_derive("remote_loads", [] { return shard_stats().remote_loads; },
+                sm::description("Counts the permissions loaded, or refreshed, from the cache of the shard owning them.")),
+        sm::make_derive("load_latency", [] { return shard_stats().load_latency_us; },
+                sm::description("Total time spent loading permissions from the system tables, in microseconds.")),
+    });
+}
+
+future<permission_set> permissions_cache::load(service& ser, logging::logger& log, const key_type& k) {
+    const auto owner = utils::tuple_hash()(k) % smp::count;
+    if (owner != this_shard_id()) {
+        ++shard_stats().remote_loads;
+        return ser.container().invoke_on(owner, [k] (service& s) {
+            return s.get_permissions(k.first, k.second);
+        });
+    }
+
+    log.debug("Refreshing permissions for {}", k.first);
+    ++shard_stats().loads;
+    const auto start = std::chrono::steady_clock::now();
+    return ser.get_uncached_permissions(k.first, k.second).finally([start] {
+        shard_stats().load_latency_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    });
 }
 
 future<permission_set> permissions_cache::get(const role_or_anonymous& maybe_role, const resource& r) {
@@ -16,6 +16,7 @@
 #include <utility>
 
 #include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
@@ -50,18 +51,59 @@ struct permissions_cache_config final {
     std::chrono::milliseconds update_period;
 };
 
+///
+/// Permissions cached on each shard.
+///
+/// Every key is owned by one shard, which loads it from the authorizer and role manager. The other shards load it
+/// from the owner's cache, so that each key is loaded from the system tables once per node, and not once per shard,
+/// when many shards see the same roles, as after a restart. This can delay changes in permissions by up to one more
+/// update period on the shards that don't own the key.
+///
 class permissions_cache final {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t loads = 0;
+        uint64_t remote_loads = 0;
+        uint64_t load_latency_us = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    struct stats_updater {
+        static void inc_hits() noexcept {
+            ++shard_stats().hits;
+        }
+        static void inc_misses() noexcept {
+            ++shard_stats().misses;
+        }
+        static void inc_blocks() noexcept {}
+        static void inc_evictions() noexcept {}
+        static void inc_unprivileged_on_cache_size_eviction() noexcept {}
+    };
+
+private:
     using cache_type = utils::loading_cache<
             std::pair<role_or_anonymous, resource>,
             permission_set,
             1,
             utils::loading_cache_reload_enabled::yes,
             utils::simple_entry_size<permission_set>,
-            utils::tuple_hash>;
+            utils::tuple_hash,
+            std::equal_to<std::pair<role_or_anonymous, resource>>,
+            stats_updater,
+            stats_updater>;
 
     using key_type = typename cache_type::key_type;
 
     cache_type _cache;
+    seastar::metrics::metric_groups _metrics;
+
+    future<permission_set> load(service&, logging::logger&, const key_type&);
 
 public:
     explicit permissions_cache(const permissions_cache_config&, service&, logging::logger&);
@@ -15,6 +15,7 @@
 #include <cmath>
 
 #include "seastarx.hh"
+#include "utils/estimated_histogram.hh"
 
 // Simple proportional controller to adjust shares for processes for which a backlog can be clearly
 // defined.
@@ -122,16 +123,64 @@ class flush_controller : public backlog_controller {
     {}
 };
 
+// compaction CPU and I/O controller.
+//
+// The shares follow the backlog through the control points. Optionally, they are also scaled by
+// a latency factor, which keeps the p99 latency of foreground reads under an SLO: every time
+// enough reads completed since the last change, the factor is cut by a quarter if their p99 went
+// above the SLO, and grows by a small step if it stayed below 80% of it. With an additive
+// increase and a multiplicative decrease, the factor settles just under the largest value the
+// reads can take. With no reads to protect it grows, up to doubling the shares, which are still
+// capped by the last control point.
 class compaction_controller : public backlog_controller {
+public:
+    struct latency_feedback {
+        // The cumulative histogram of foreground read latencies.
+        std::function<utils::time_estimated_histogram()> read_latency;
+        // The p99 read latency to keep. Zero disables the feedback.
+        std::function<std::chrono::microseconds()> read_latency_slo;
+    };
+private:
+    static constexpr float min_latency_factor = 0.1;
+    static constexpr float max_latency_factor = 2.0;
+    static constexpr float latency_factor_decrease = 0.75;
+    static constexpr float latency_factor_increase = 0.05;
+    static constexpr uint64_t min_latency_samples = 100;
+
+    latency_feedback _latency_feedback;
+    // The histogram as of the last change of the factor.
+    utils::time_estimated_histogram _last_read_latency;
+    float _latency_factor = 1.0;
+    std::chrono::microseconds _last_read_latency_p99{0};
+    float _last_shares = 0;
+protected:
+    virtual void update_controller(float shares) override;
+private:
+    void update_latency_factor();
 public:
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
-    compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, float static_shares) : backlog_controller(sg, iop, static_shares) {}
-    compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, std::chrono::milliseconds interval, std::function<float()> current_backlog)
+    compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, float static_shares) : backlog_controller(sg, iop, static_shares), _last_shares(static_shares) {}
+    compaction_controller(seastar::scheduling_group sg, const ::io_priority_class& iop, std::chrono::milliseconds interval, std::function<float()> current_backlog,
+                          latency_feedback feedback = {})
         : backlog_controller(sg, iop, std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
           std::move(current_backlog)
         )
+        , _latency_feedback(std::move(feedback))
     {}
+
+    // The shares set by the last adjustment.
+    float shares() const noexcept {
+        return _last_shares;
+    }
+    // The factor the shares given by the backlog are scaled by.
+    float latency_factor() const noexcept {
+        return _latency_factor;
+    }
+    // The p99 latency of the reads which drove the last change of the factor.
+    std::chrono::microseconds read_latency_p99() const noexcept {
+        return _last_read_latency_p99;
+    }
 };
@@ -318,8 +318,17 @@ class bytes_ostream {
         return _size == 0;
     }
 
+    // Allocates the first chunk with room for size bytes, up to
+    // max_chunk_size(), so that writing that much takes a single allocation
+    // instead of a chain of growing chunks. Has no effect on a stream which
+    // already has a chunk.
     void reserve(size_t size) {
-        // FIXME: implement
+        if (_begin || !size) {
+            return;
+        }
+        alloc_new(std::min(size, size_t(max_chunk_size())));
+        _current->offset = 0;
+        _size = 0;
     }
 
     void append(const bytes_ostream& o) {
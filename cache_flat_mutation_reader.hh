@@ -9,6 +9,7 @@
 #pragma once
 
 #include <vector>
+#include <seastar/util/defer.hh>
 #include "row_cache.hh"
 #include "mutation_reader.hh"
 #include "mutation_fragment.hh"
@@ -102,6 +103,11 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
     flat_mutation_reader* _underlying = nullptr;
     flat_mutation_reader_opt _underlying_holder;
 
+    // Clustering rows read from underlying, populated into the cache together.
+    // Kept as a member so that its storage is reused across batches.
+    std::vector<mutation_fragment> _population_batch;
+    static constexpr size_t max_population_batch = 32;
+
     future<> do_fill_buffer();
     future<> ensure_underlying();
     void copy_from_cache_to_buffer();
@@ -134,6 +140,13 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
     bool ensure_population_lower_bound();
     void maybe_add_to_cache(const mutation_fragment& mf);
     void maybe_add_to_cache(const clustering_row& cr);
+    // Populates the cache with the clustering row mf and the clustering rows
+    // which follow it in the buffer of the underlying reader, up to
+    // max_population_batch of them, in one update section. Then adds them to
+    // the buffer.
+    void populate_and_add_to_buffer(mutation_fragment&& mf);
+    // Requires the update section and the cache region's allocator.
+    void add_to_cache(const clustering_row& cr);
     void maybe_add_to_cache(const range_tombstone& rt);
     void maybe_add_to_cache(const static_row& sr);
     void maybe_set_static_row_continuous();
@@ -146,6 +159,16 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
         return _snp->schema();
     }
     void touch_partition();
+    void on_row_hit() {
+        _read_context.cache().on_row_hit();
+        ++_permit.get_read_stats().cache_row_hits;
+    }
+    void on_row_miss() {
+        _read_context.cache().on_row_miss();
+        ++_permit.get_read_stats().cache_row_misses;
+    }
+    // Links an entry populated by this reader into the LRU.
+    void insert_into_lru(rows_entry&);
 
     position_in_partition_view to_table_domain(position_in_partition_view query_domain_pos) {
         if (!_read_context.is_reversed()) [[likely]] {
@@ -234,7 +257,7 @@ class cache_flat_mutation_reader final : public flat_mutation_reader::impl {
 inline
 future<> cache_flat_mutation_reader::process_static_row() {
     if (_snp->static_row_continuous()) {
-        _read_context.cache().on_row_hit();
+        on_row_hit();
         static_row sr = _lsa_manager.run_in_read_section([this] {
             return _snp->static_row(_read_context.digest_requested());
         });
@@ -243,7 +266,7 @@ future<> cache_flat_mutation_reader::process_static_row() {
         }
         return make_ready_future<>();
     } else {
-        _read_context.cache().on_row_miss();
+        on_row_miss();
         return ensure_underlying().then([this] {
             return (*_underlying)().then([this] (mutation_fragment_opt&& sr) {
                 if (sr) {
@@ -259,7 +282,13 @@ future<> cache_flat_mutation_reader::process_static_row() {
 
 inline
 void cache_flat_mutation_reader::touch_partition() {
-    _snp->touch();
+    _snp->touch(!_read_context.is_probationary());
+}
+
+inline
+void cache_flat_mutation_reader::insert_into_lru(rows_entry& e) {
+    // See cache_tracker::insert() for why older versions matter.
+    _snp->tracker()->insert(e, _read_context.is_probationary() && _snp->at_oldest_version());
 }
 
 inline
@@ -365,9 +394,13 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
     return consume_mutation_fragments_until(*_underlying,
         [this] { return _state != state::reading_from_underlying || is_buffer_full(); },
         [this] (mutation_fragment mf) {
-            _read_context.cache().on_row_miss();
-            maybe_add_to_cache(mf);
-            add_to_buffer(std::move(mf));
+            on_row_miss();
+            if (mf.is_clustering_row() && can_populate()) {
+                populate_and_add_to_buffer(std::move(mf));
+            } else {
+                maybe_add_to_cache(mf);
+                add_to_buffer(std::move(mf));
+            }
         },
         [this] {
             _state = state::reading_from_cache;
@@ -403,7 +436,7 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
                                 auto insert_result = rows.insert_before_hint(_next_row.get_iterator_in_latest_version(), std::move(e), cmp);
                                 if (insert_result.second) {
                                     auto it = insert_result.first;
-                                    _snp->tracker()->insert(*it);
+                                    insert_into_lru(*it);
                                     auto next = std::next(it);
                                     // Also works in reverse read mode.
                                     // It preserves the continuity of the range the entry falls into.
@@ -419,7 +452,7 @@ future<> cache_flat_mutation_reader::read_from_underlying() {
                                 auto insert_result = rows.insert_before_hint(_next_row.get_iterator_in_latest_version(), std::move(e), cmp);
                                 if (insert_result.second) {
                                     clogger.trace("csm {}: inserted dummy at {}", fmt::ptr(this), _upper_bound);
-                                    _snp->tracker()->insert(*insert_result.first);
+                                    insert_into_lru(*insert_result.first);
                                 }
                                 if (_read_context.is_reversed()) [[unlikely]] {
                                     clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), _last_row.position());
@@ -468,7 +501,7 @@ bool cache_flat_mutation_reader::ensure_population_lower_bound() {
             if (insert_result.second) {
                 auto it = insert_result.first;
                 clogger.trace("csm {}: inserted lower bound dummy at {}", fmt::ptr(this), it->position());
-                _snp->tracker()->insert(*it);
+                insert_into_lru(*it);
             }
             _last_row.set_latest(insert_result.first);
         });
@@ -514,42 +547,68 @@ void cache_flat_mutation_reader::maybe_add_to_cache(const clustering_row& cr) {
         _read_context.cache().on_mispopulate();
         return;
     }
-    clogger.trace("csm {}: populate({})", fmt::ptr(this), clustering_row::printer(*_schema, cr));
     _lsa_manager.run_in_update_section_with_allocator([this, &cr] {
-        mutation_partition& mp = _snp->version()->partition();
-        rows_entry::tri_compare cmp(table_schema());
+        add_to_cache(cr);
+    });
+}
 
-        if (_read_context.digest_requested()) {
-            cr.cells().prepare_hash(*_schema, column_kind::regular_column);
-        }
-        auto new_entry = alloc_strategy_unique_ptr<rows_entry>(
-            current_allocator().construct<rows_entry>(table_schema(), cr.key(), cr.as_deletable_row()));
-        new_entry->set_continuous(false);
-        auto it = _next_row.iterators_valid() ? _next_row.get_iterator_in_latest_version()
-                                              : mp.clustered_rows().lower_bound(cr.key(), cmp);
-        auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
-        it = insert_result.first;
-        if (insert_result.second) {
-            _snp->tracker()->insert(*it);
+inline
+void cache_flat_mutation_reader::populate_and_add_to_buffer(mutation_fragment&& mf) {
+    auto clear_batch = defer([this] () noexcept { _population_batch.clear(); });
+    _population_batch.push_back(std::move(mf));
+    while (_population_batch.size() < max_population_batch && !_underlying->is_buffer_empty()
+            && _underlying->peek_buffer().is_clustering_row()) {
+        on_row_miss();
+        _population_batch.push_back(_underlying->pop_mutation_fragment());
+    }
+    // The section may be retried, resume with the first row not yet populated.
+    size_t populated = 0;
+    _lsa_manager.run_in_update_section_with_allocator([this, &populated] {
+        for (; populated < _population_batch.size(); ++populated) {
+            add_to_cache(_population_batch[populated].as_clustering_row());
         }
+    });
+    for (auto& mf : _population_batch) {
+        add_to_buffer(std::move(mf));
+    }
+}
 
-        rows_entry& e = *it;
-        if (ensure_population_lower_bound()) {
-            if (_read_context.is_reversed()) [[unlikely]] {
-                clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), _last_row.position());
-                _last_row->set_continuous(true);
-            } else {
-                clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), e.position());
-                e.set_continuous(true);
-            }
+inline
+void cache_flat_mutation_reader::add_to_cache(const clustering_row& cr) {
+    clogger.trace("csm {}: populate({})", fmt::ptr(this), clustering_row::printer(*_schema, cr));
+    mutation_partition& mp = _snp->version()->partition();
+    rows_entry::tri_compare cmp(table_schema());
+
+    if (_read_context.digest_requested()) {
+        cr.cells().prepare_hash(*_schema, column_kind::regular_column);
+    }
+    auto new_entry = alloc_strategy_unique_ptr<rows_entry>(
+        current_allocator().construct<rows_entry>(table_schema(), cr.key(), cr.as_deletable_row()));
+    new_entry->set_continuous(false);
+    auto it = _next_row.iterators_valid() ? _next_row.get_iterator_in_latest_version()
+                                          : mp.clustered_rows().lower_bound(cr.key(), cmp);
+    auto insert_result = mp.mutable_clustered_rows().insert_before_hint(it, std::move(new_entry), cmp);
+    it = insert_result.first;
+    if (insert_result.second) {
+        insert_into_lru(*it);
+    }
+
+    rows_entry& e = *it;
+    if (ensure_population_lower_bound()) {
+        if (_read_context.is_reversed()) [[unlikely]] {
+            clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), _last_row.position());
+            _last_row->set_continuous(true);
         } else {
-            _read_context.cache().on_mispopulate();
+            clogger.trace("csm {}: set_continuous({})", fmt::ptr(this), e.position());
+            e.set_continuous(true);
         }
-        with_allocator(standard_allocator(), [&] {
-            _last_row = partition_snapshot_row_weakref(*_snp, it, true);
-        });
-        _population_range_starts_before_all_rows = false;
+    } else {
+        _read_context.cache().on_mispopulate();
+    }
+    with_allocator(standard_allocator(), [&] {
+        _last_row = partition_snapshot_row_weakref(*_snp, it, true);
     });
+    _population_range_starts_before_all_rows = false;
 }
 
 inline
@@ -562,13 +621,13 @@ inline
 void cache_flat_mutation_reader::start_reading_from_underlying() {
     clogger.trace("csm {}: start_reading_from_underlying(), range=[{}, {})", fmt::ptr(this), _lower_bound, _next_row_in_range ? _next_row.position() : _upper_bound);
     _state = state::move_to_underlying;
-    _next_row.touch();
+    _next_row.touch(!_read_context.is_probationary());
 }
 
 inline
 void cache_flat_mutation_reader::copy_from_cache_to_buffer() {
     clogger.trace("csm {}: copy_from_cache, next={}, next_row_in_range={}", fmt::ptr(this), _next_row.position(), _next_row_in_range);
-    _next_row.touch();
+    _next_row.touch(!_read_context.is_probationary());
     position_in_partition_view next_lower_bound = _next_row.dummy() ? _next_row.position() : position_in_partition_view::after_key(_next_row.key());
     auto upper_bound = _next_row_in_range ? next_lower_bound : _upper_bound;
     if (_snp->range_tombstones(_lower_bound, upper_bound, [&] (range_tombstone rts) {
@@ -640,7 +699,7 @@ void cache_flat_mutation_reader::move_to_range(query::clustering_row_ranges::con
                 });
                 auto it = insert_result.first;
                 if (insert_result.second) {
-                    _snp->tracker()->insert(*it);
+                    insert_into_lru(*it);
                 }
                 _last_row = partition_snapshot_row_weakref(*_snp, it, true);
             } else {
@@ -721,7 +780,7 @@ void cache_flat_mutation_reader::add_to_buffer(mutation_fragment&& mf) {
 inline
 void cache_flat_mutation_reader::add_to_buffer(const partition_snapshot_row_cursor& row) {
     if (!row.dummy()) {
-        _read_context.cache().on_row_hit();
+        on_row_hit();
         if (_read_context.digest_requested()) {
             row.latest_row().cells().prepare_hash(table_schema(), column_kind::regular_column);
         }
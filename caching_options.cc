@@ -12,12 +12,23 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, double min_fraction, double max_fraction,
+        std::chrono::milliseconds result_cache_ttl)
+        : _key_cache(k), _row_cache(r), _enabled(enabled), _min_fraction(min_fraction), _max_fraction(max_fraction)
+        , _result_cache_ttl(result_cache_ttl) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
 
+    if (!(min_fraction >= 0 && min_fraction <= max_fraction && max_fraction <= 1)) {
+        throw exceptions::configuration_exception(format("Invalid cache fractions: min_fraction {} and max_fraction {}, "
+                "expected 0 <= min_fraction <= max_fraction <= 1", min_fraction, max_fraction));
+    }
+
+    if (result_cache_ttl.count() < 0) {
+        throw exceptions::configuration_exception(format("Invalid result_cache_ttl_in_ms value: {}", result_cache_ttl.count()));
+    }
+
     if ((r == "ALL") || (r == "NONE")) {
         return;
     } else {
@@ -40,6 +51,15 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_min_fraction != 0) {
+        res.insert({"min_fraction", format("{}", _min_fraction)});
+    }
+    if (_max_fraction != 1) {
+        res.insert({"max_fraction", format("{}", _max_fraction)});
+    }
+    if (_result_cache_ttl.count() != 0) {
+        res.insert({"result_cache_ttl_in_ms", format("{}", _result_cache_ttl.count())});
+    }
     return res;
 }
 
@@ -58,6 +78,16 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    double min_fraction = 0;
+    double max_fraction = 1;
+    std::chrono::milliseconds result_cache_ttl{0};
+    auto parse_fraction = [] (const std::pair<const sstring, sstring>& p) {
+        try {
+            return boost::lexical_cast<double>(p.second);
+        } catch (boost::bad_lexical_cast& e) {
+            throw exceptions::configuration_exception(format("Invalid {} value: {}", p.first, p.second));
+        }
+    };
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +96,21 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "min_fraction") {
+            min_fraction = parse_fraction(p);
+        } else if (p.first == "max_fraction") {
+            max_fraction = parse_fraction(p);
+        } else if (p.first == "result_cache_ttl_in_ms") {
+            try {
+                result_cache_ttl = std::chrono::milliseconds(boost::lexical_cast<int64_t>(p.second));
+            } catch (boost::bad_lexical_cast& e) {
+                throw exceptions::configuration_exception(format("Invalid {} value: {}", p.first, p.second));
+            }
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, min_fraction, max_fraction, result_cache_ttl);
 }
 
 caching_options
@@ -81,7 +121,9 @@ caching_options::from_sstring(const sstring& str) {
 bool
 caching_options::operator==(const caching_options& other) const {
     return _key_cache == other._key_cache && _row_cache == other._row_cache
-        && _enabled == other._enabled;
+        && _enabled == other._enabled
+        && _min_fraction == other._min_fraction && _max_fraction == other._max_fraction
+        && _result_cache_ttl == other._result_cache_ttl;
 }
 
 bool
@@ -8,6 +8,7 @@
 
 #pragma once
 #include <seastar/core/sstring.hh>
+#include <chrono>
 #include <map>
 #include "seastarx.hh"
 
@@ -25,7 +26,12 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // Fractions of the partitions in the row cache of a shard, see cache_tracker::table_stats.
+    double _min_fraction = 0;
+    double _max_fraction = 1;
+    std::chrono::milliseconds _result_cache_ttl{0};
+    caching_options(sstring k, sstring r, bool enabled, double min_fraction = 0, double max_fraction = 1,
+            std::chrono::milliseconds result_cache_ttl = std::chrono::milliseconds(0));
 
     friend class schema;
     caching_options();
@@ -34,6 +40,26 @@ class caching_options {
         return _enabled;
     }
 
+    // The fraction of the row cache which the table is guaranteed, as long as
+    // its partitions are read. The cache avoids evicting them while the table
+    // holds less than this.
+    double min_fraction() const {
+        return _min_fraction;
+    }
+
+    // The fraction of the row cache above which the partitions of the table
+    // are evicted before those of other tables.
+    double max_fraction() const {
+        return _max_fraction;
+    }
+
+    // How long results of single-partition SELECTs of the table may be served
+    // from the coordinator's result cache, see cql3::result_cache. Zero, the
+    // default, doesn't cache them.
+    std::chrono::milliseconds result_cache_ttl() const {
+        return _result_cache_ttl;
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
@@ -1728,6 +1728,33 @@ transform_mutations(std::vector<mutation>& muts, decltype(muts.size()) batch_siz
         .then([&muts] () mutable { return std::move(muts); });
 }
 
+// Merges the log mutations, which start at `first_log`, that go to the same
+// stream. Base writes to partitions of one vnode usually share a stream, so a
+// batch writing several of them would otherwise send a mutation per base
+// partition to the same log partition. Log rows are keyed by a random timeuuid,
+// so the merged rows never overlap.
+static void coalesce_log_mutations(std::vector<mutation>& mutations, size_t first_log) {
+    auto logs_begin = mutations.begin() + first_log;
+    if (std::distance(logs_begin, mutations.end()) < 2) {
+        return;
+    }
+    std::sort(logs_begin, mutations.end(), [] (const mutation& a, const mutation& b) {
+        if (a.schema()->id() != b.schema()->id()) {
+            return a.schema()->id() < b.schema()->id();
+        }
+        return a.decorated_key().less_compare(*a.schema(), b.decorated_key());
+    });
+    auto out = logs_begin;
+    for (auto it = std::next(logs_begin); it != mutations.end(); ++it) {
+        if (it->schema()->id() == out->schema()->id() && it->decorated_key().equal(*out->schema(), out->decorated_key())) {
+            out->apply(std::move(*it));
+        } else if (++out != it) {
+            *out = std::move(*it);
+        }
+    }
+    mutations.erase(std::next(out), mutations.end());
+}
+
 } // namespace cdc
 
 future<std::tuple<std::vector<mutation>, lw_shared_ptr<cdc::operation_result_tracker>>>
@@ -1743,10 +1770,11 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
     }
 
     tracing::trace(tr_state, "CDC: Started generating mutations for log rows");
+    const size_t base_mutations_count = mutations.size();
     mutations.reserve(2 * mutations.size());
 
     return do_with(std::move(mutations), service::query_state(service::client_state::for_internal_calls(), empty_service_permit()), operation_details{},
-            [this, timeout, i, tr_state = std::move(tr_state), write_cl] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details) {
+            [this, timeout, i, tr_state = std::move(tr_state), write_cl, base_mutations_count] (std::vector<mutation>& mutations, service::query_state& qs, operation_details& details) {
         return transform_mutations(mutations, 1, [this, &mutations, timeout, &qs, tr_state = tr_state, &details, write_cl] (int idx) mutable {
             auto& m = mutations[idx];
             auto s = m.schema();
@@ -1806,8 +1834,9 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
                 tracing::trace(tr_state, "CDC: Generated {} log mutations from {}", generated_count, mutations[idx].decorated_key());
                 details.touched_parts.add(touched_parts);
             });
-        }).then([this, tr_state, &details](std::vector<mutation> mutations) {
-            tracing::trace(tr_state, "CDC: Finished generating all log mutations");
+        }).then([this, tr_state, &details, base_mutations_count](std::vector<mutation> mutations) {
+            coalesce_log_mutations(mutations, base_mutations_count);
+            tracing::trace(tr_state, "CDC: Finished generating all log mutations, {} after merging per stream", mutations.size() - base_mutations_count);
             auto tracker = make_lw_shared<cdc::operation_result_tracker>(_ctxt._proxy.get_cdc_stats(), details);
             return make_ready_future<std::tuple<std::vector<mutation>, lw_shared_ptr<cdc::operation_result_tracker>>>(std::make_tuple(std::move(mutations), std::move(tracker)));
         });
@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include <boost/intrusive/unordered_set.hpp>
+#include <seastar/core/coroutine.hh>
 
 #include "utils/small_vector.hh"
 #include "mutation_partition.hh"
@@ -108,246 +108,54 @@ class partition_cells_range {
     }
 };
 
-class locked_cell;
+class locked_cells;
 
 struct cell_locker_stats {
     uint64_t lock_acquisitions = 0;
     uint64_t operations_waiting_for_lock = 0;
 };
 
+// Locks the counter cells modified by a write, for the read-modify-write of
+// their counter shards.
+//
+// Cells are mapped to a fixed array of lock stripes by a hash of their
+// partition, row and column, so locking allocates nothing per partition or
+// cell, and a write which finds its stripes free takes them right away.
+// Unrelated cells may share a stripe and wait for each other, which the
+// number of stripes keeps rare. A write takes its stripes in ascending
+// order, so writes can't deadlock.
+//
+// Columns are hashed by name rather than id, so that locks taken with an
+// older schema keep excluding writes with the new one.
 class cell_locker {
+public:
+    static constexpr size_t default_stripe_count = 1024;
+    using stripes_type = utils::small_vector<uint32_t, 8>;
 private:
-    class partition_entry;
-
-    struct cell_address {
-        position_in_partition position;
-        column_id id;
+    struct stripe {
+        db::timeout_semaphore semaphore { 1 };
     };
 
-    class cell_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>>,
-                       public enable_lw_shared_from_this<cell_entry> {
-        partition_entry& _parent;
-        cell_address _address;
-        db::timeout_semaphore _semaphore { 0 };
-
-        friend class cell_locker;
-    public:
-        cell_entry(partition_entry& parent, position_in_partition position, column_id id)
-            : _parent(parent)
-            , _address { std::move(position), id }
-        { }
-
-        // Upgrades cell_entry to another schema.
-        // Changes the value of cell_address, so cell_entry has to be
-        // temporarily removed from its parent partition_entry.
-        // Returns true if the cell_entry still exist in the new schema and
-        // should be reinserted.
-        bool upgrade(const schema& from, const schema& to, column_kind kind) noexcept {
-            auto& old_column_mapping = from.get_column_mapping();
-            auto& column = old_column_mapping.column_at(kind, _address.id);
-            auto cdef = to.get_column_definition(column.name());
-            if (!cdef) {
-                return false;
-            }
-            _address.id = cdef->id;
-            return true;
-        }
-
-        const position_in_partition& position() const {
-            return _address.position;
-        }
-
-        future<> lock(db::timeout_clock::time_point _timeout) {
-            return _semaphore.wait(_timeout);
-        }
-        void unlock() {
-            _semaphore.signal();
-        }
-
-        ~cell_entry() {
-            if (!is_linked()) {
-                return;
-            }
-            unlink();
-            if (!--_parent._cell_count) {
-                delete &_parent;
-            }
-        }
-
-        class hasher {
-            const schema* _schema; // pointer instead of reference for default assignment
-        public:
-            explicit hasher(const schema& s) : _schema(&s) { }
-
-            size_t operator()(const cell_address& ca) const {
-                xx_hasher hasher;
-                ca.position.feed_hash(hasher, *_schema);
-                ::feed_hash(hasher, ca.id);
-                return static_cast<size_t>(hasher.finalize_uint64());
-            }
-            size_t operator()(const cell_entry& ce) const {
-                return operator()(ce._address);
-            }
-        };
-
-        class equal_compare {
-            position_in_partition::equal_compare _cmp;
-        private:
-            bool do_compare(const cell_address& a, const cell_address& b) const {
-                return a.id == b.id && _cmp(a.position, b.position);
-            }
-        public:
-            explicit equal_compare(const schema& s) : _cmp(s) { }
-            bool operator()(const cell_address& ca, const cell_entry& ce) const {
-                return do_compare(ca, ce._address);
-            }
-            bool operator()(const cell_entry& ce, const cell_address& ca) const {
-                return do_compare(ca, ce._address);
-            }
-            bool operator()(const cell_entry& a, const cell_entry& b) const {
-                return do_compare(a._address, b._address);
-            }
-        };
-    };
-
-    class partition_entry : public bi::unordered_set_base_hook<bi::link_mode<bi::auto_unlink>> {
-        using cells_type = bi::unordered_set<cell_entry,
-                                             bi::equal<cell_entry::equal_compare>,
-                                             bi::hash<cell_entry::hasher>,
-                                             bi::constant_time_size<false>>;
-
-        static constexpr size_t initial_bucket_count = 16;
-        using max_load_factor = std::ratio<3, 4>;
-        dht::decorated_key _key;
-        cell_locker& _parent;
-        size_t _rehash_at_size = compute_rehash_at_size(initial_bucket_count);
-        std::unique_ptr<cells_type::bucket_type[]> _buckets; // TODO: start with internal storage?
-        size_t _cell_count = 0; // cells_type::empty() is not O(1) if the hook is auto-unlink
-        cells_type::bucket_type _internal_buckets[initial_bucket_count];
-        cells_type _cells;
-        schema_ptr _schema;
-
-        friend class cell_entry;
-    private:
-        static constexpr size_t compute_rehash_at_size(size_t bucket_count) {
-            return bucket_count * max_load_factor::num / max_load_factor::den;
-        }
-        void maybe_rehash() {
-            if (_cell_count >= _rehash_at_size) {
-                auto new_bucket_count = std::min(_cells.bucket_count() * 2, _cells.bucket_count() + 1024);
-                auto buckets = std::make_unique<cells_type::bucket_type[]>(new_bucket_count);
-
-                _cells.rehash(cells_type::bucket_traits(buckets.get(), new_bucket_count));
-                _buckets = std::move(buckets);
-
-                _rehash_at_size = compute_rehash_at_size(new_bucket_count);
-            }
-        }
-    public:
-        partition_entry(schema_ptr s, cell_locker& parent, const dht::decorated_key& dk)
-            : _key(dk)
-            , _parent(parent)
-            , _cells(cells_type::bucket_traits(_internal_buckets, initial_bucket_count),
-                     cell_entry::hasher(*s), cell_entry::equal_compare(*s))
-            , _schema(s)
-        { }
-
-        ~partition_entry() {
-            if (is_linked()) {
-                _parent._partition_count--;
-            }
-        }
-
-        // Upgrades partition entry to new schema. Returns false if all
-        // cell_entries has been removed during the upgrade.
-        bool upgrade(schema_ptr new_schema);
-
-        void insert(lw_shared_ptr<cell_entry> cell) {
-            _cells.insert(*cell);
-            _cell_count++;
-            maybe_rehash();
-        }
-
-        cells_type& cells() {
-            return _cells;
-        }
-
-        struct hasher {
-            size_t operator()(const dht::decorated_key& dk) const {
-                return std::hash<dht::decorated_key>()(dk);
-            }
-            size_t operator()(const partition_entry& pe) const {
-                return operator()(pe._key);
-            }
-        };
-
-        class equal_compare {
-            dht::decorated_key_equals_comparator _cmp;
-        public:
-            explicit equal_compare(const schema& s) : _cmp(s) { }
-            bool operator()(const dht::decorated_key& dk, const partition_entry& pe) {
-                return _cmp(dk, pe._key);
-            }
-            bool operator()(const partition_entry& pe, const dht::decorated_key& dk) {
-                return _cmp(dk, pe._key);
-            }
-            bool operator()(const partition_entry& a, const partition_entry& b) {
-                return _cmp(a._key, b._key);
-            }
-        };
-    };
-
-    using partitions_type = bi::unordered_set<partition_entry,
-                                              bi::equal<partition_entry::equal_compare>,
-                                              bi::hash<partition_entry::hasher>,
-                                              bi::constant_time_size<false>>;
-
-    static constexpr size_t initial_bucket_count = 4 * 1024;
-    using max_load_factor = std::ratio<3, 4>;
-
-    std::unique_ptr<partitions_type::bucket_type[]> _buckets;
-    partitions_type _partitions;
-    size_t _partition_count = 0;
-    size_t _rehash_at_size = compute_rehash_at_size(initial_bucket_count);
+    size_t _stripe_count;
+    std::unique_ptr<stripe[]> _stripes;
     schema_ptr _schema;
-
-    // partitions_type uses equality comparator which keeps a reference to the
-    // original schema, we must ensure that it doesn't die.
-    schema_ptr _original_schema;
     cell_locker_stats& _stats;
 
-    friend class locked_cell;
+    friend class locked_cells;
 private:
-    struct locker;
-
-    static constexpr size_t compute_rehash_at_size(size_t bucket_count) {
-        return bucket_count * max_load_factor::num / max_load_factor::den;
-    }
-    void maybe_rehash() {
-        if (_partition_count >= _rehash_at_size) {
-            auto new_bucket_count = std::min(_partitions.bucket_count() * 2, _partitions.bucket_count() + 64 * 1024);
-            auto buckets = std::make_unique<partitions_type::bucket_type[]>(new_bucket_count);
-
-            _partitions.rehash(partitions_type::bucket_traits(buckets.get(), new_bucket_count));
-            _buckets = std::move(buckets);
+    // The sorted, distinct stripes of the cells in range, and their number in cells.
+    stripes_type stripes_of(const dht::decorated_key& dk, const partition_cells_range& range, uint64_t& cells) const;
 
-            _rehash_at_size = compute_rehash_at_size(new_bucket_count);
-        }
-    }
+    future<locked_cells> lock_slow(locked_cells locks, stripes_type stripes, size_t first, uint64_t cells,
+                                   db::timeout_clock::time_point timeout);
 public:
-    explicit cell_locker(schema_ptr s, cell_locker_stats& stats)
-        : _buckets(std::make_unique<partitions_type::bucket_type[]>(initial_bucket_count))
-        , _partitions(partitions_type::bucket_traits(_buckets.get(), initial_bucket_count),
-                      partition_entry::hasher(), partition_entry::equal_compare(*s))
-        , _schema(s)
-        , _original_schema(std::move(s))
+    explicit cell_locker(schema_ptr s, cell_locker_stats& stats, size_t stripe_count = default_stripe_count)
+        : _stripe_count(stripe_count)
+        , _stripes(std::make_unique<stripe[]>(stripe_count))
+        , _schema(std::move(s))
         , _stats(stats)
     { }
 
-    ~cell_locker() {
-        assert(_partitions.empty());
-    }
-
     void set_schema(schema_ptr s) {
         _schema = s;
     }
@@ -356,181 +164,118 @@ class cell_locker {
     }
 
     // partition_cells_range is required to be in cell_locker::schema()
-    future<std::vector<locked_cell>> lock_cells(const dht::decorated_key& dk, partition_cells_range&& range,
-                                                db::timeout_clock::time_point timeout);
+    future<locked_cells> lock_cells(const dht::decorated_key& dk, partition_cells_range&& range,
+                                    db::timeout_clock::time_point timeout);
 };
 
-
-class locked_cell {
-    lw_shared_ptr<cell_locker::cell_entry> _entry;
-public:
-    explicit locked_cell(lw_shared_ptr<cell_locker::cell_entry> entry)
-        : _entry(std::move(entry)) { }
-
-    locked_cell(const locked_cell&) = delete;
-    locked_cell(locked_cell&&) = default;
-
-    ~locked_cell() {
-        if (_entry) {
-            _entry->unlock();
+// The stripes of a cell_locker held by a write, released on destruction.
+class locked_cells {
+    cell_locker* _locker = nullptr;
+    cell_locker::stripes_type _stripes;
+private:
+    void release() noexcept {
+        if (_locker) {
+            for (auto s : _stripes) {
+                _locker->_stripes[s].semaphore.signal();
+            }
         }
+        _stripes.clear();
     }
-};
+public:
+    locked_cells() = default;
 
-struct cell_locker::locker {
-    cell_entry::hasher _hasher;
-    cell_entry::equal_compare _eq_cmp;
-    partition_entry& _partition_entry;
+    locked_cells(cell_locker& locker, size_t stripes)
+        : _locker(&locker)
+    {
+        _stripes.reserve(stripes);
+    }
 
-    partition_cells_range _range;
-    partition_cells_range::iterator _current_ck;
-    cells_range::const_iterator _current_cell;
+    locked_cells(const locked_cells&) = delete;
+    locked_cells(locked_cells&& o) noexcept
+        : _locker(std::exchange(o._locker, nullptr))
+        , _stripes(std::move(o._stripes))
+    { }
 
-    db::timeout_clock::time_point _timeout;
-    std::vector<locked_cell> _locks;
-    cell_locker_stats& _stats;
-private:
-    void update_ck() {
-        if (!is_done()) {
-            _current_cell = _current_ck->begin();
+    locked_cells& operator=(locked_cells&& o) noexcept {
+        if (this != &o) {
+            release();
+            _locker = std::exchange(o._locker, nullptr);
+            _stripes = std::move(o._stripes);
         }
+        return *this;
     }
 
-    future<> lock_next();
-
-    bool is_done() const { return _current_ck == _range.end(); }
-public:
-    explicit locker(const ::schema& s, cell_locker_stats& st, partition_entry& pe, partition_cells_range&& range, db::timeout_clock::time_point timeout)
-        : _hasher(s)
-        , _eq_cmp(s)
-        , _partition_entry(pe)
-        , _range(std::move(range))
-        , _current_ck(_range.begin())
-        , _timeout(timeout)
-        , _stats(st)
-    {
-        update_ck();
+    ~locked_cells() {
+        release();
     }
 
-    locker(const locker&) = delete;
-    locker(locker&&) = delete;
-
-    future<> lock_all() {
-        // Cannot defer before first call to lock_next().
-        return lock_next().then([this] {
-            return do_until([this] { return is_done(); }, [this] {
-                return lock_next();
-            });
-        });
+    // Records a stripe which was just taken. Doesn't allocate, as the
+    // constructor reserves room for all the stripes of the write.
+    void add(uint32_t stripe) noexcept {
+        _stripes.push_back(stripe);
     }
-
-    std::vector<locked_cell> get() && { return std::move(_locks); }
 };
 
 inline
-future<std::vector<locked_cell>> cell_locker::lock_cells(const dht::decorated_key& dk, partition_cells_range&& range, db::timeout_clock::time_point timeout) {
-    partition_entry::hasher pe_hash;
-    partition_entry::equal_compare pe_eq(*_schema);
-
-    auto it = _partitions.find(dk, pe_hash, pe_eq);
-    std::unique_ptr<partition_entry> partition;
-    if (it == _partitions.end()) {
-        partition = std::make_unique<partition_entry>(_schema, *this, dk);
-    } else if (!it->upgrade(_schema)) {
-        partition = std::unique_ptr<partition_entry>(&*it);
-        _partition_count--;
-        _partitions.erase(it);
-    }
-
-    if (partition) {
-        std::vector<locked_cell> locks;
-        for (auto&& r : range) {
-            if (r.empty()) {
-                continue;
-            }
-            for (auto&& c : r) {
-                auto cell = make_lw_shared<cell_entry>(*partition, position_in_partition(r.position()), c);
-                _stats.lock_acquisitions++;
-                partition->insert(cell);
-                locks.emplace_back(std::move(cell));
-            }
+cell_locker::stripes_type cell_locker::stripes_of(const dht::decorated_key& dk, const partition_cells_range& range, uint64_t& cells) const {
+    stripes_type stripes;
+    auto partition_hash = std::hash<dht::decorated_key>()(dk);
+    for (auto&& r : range) {
+        if (r.empty()) {
+            continue;
         }
-
-        if (!locks.empty()) {
-            _partitions.insert(*partition.release());
-            _partition_count++;
-            maybe_rehash();
+        xx_hasher row_hasher(partition_hash);
+        auto kind = column_kind::regular_column;
+        if (r.position().is_static_row()) {
+            ::feed_hash(row_hasher, false);
+            kind = column_kind::static_column;
+        } else {
+            ::feed_hash(row_hasher, true);
+            ::feed_hash(row_hasher, r.position().key(), *_schema);
+        }
+        for (auto id : r) {
+            auto& name = _schema->column_at(kind, id).name();
+            auto cell_hasher = row_hasher;
+            cell_hasher.update(reinterpret_cast<const char*>(name.data()), name.size());
+            stripes.push_back(cell_hasher.finalize_uint64() % _stripe_count);
+            cells++;
         }
-        return make_ready_future<std::vector<locked_cell>>(std::move(locks));
     }
-
-    auto l = std::make_unique<locker>(*_schema, _stats, *it, std::move(range), timeout);
-    auto f = l->lock_all();
-    return f.then([l = std::move(l)] {
-        return std::move(*l).get();
-    });
+    std::sort(stripes.begin(), stripes.end());
+    stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+    return stripes;
 }
 
 inline
-future<> cell_locker::locker::lock_next() {
-    while (!is_done()) {
-        if (_current_cell == _current_ck->end()) {
-            ++_current_ck;
-            update_ck();
-            continue;
-        }
-
-        auto cid = *_current_cell++;
-
-        cell_address ca { position_in_partition(_current_ck->position()), cid };
-        auto it = _partition_entry.cells().find(ca, _hasher, _eq_cmp);
-        if (it != _partition_entry.cells().end()) {
-            _stats.operations_waiting_for_lock++;
-            return it->lock(_timeout).then([this, ce = it->shared_from_this()] () mutable {
-                _stats.operations_waiting_for_lock--;
-                _stats.lock_acquisitions++;
-                _locks.emplace_back(std::move(ce));
-            });
+future<locked_cells> cell_locker::lock_cells(const dht::decorated_key& dk, partition_cells_range&& range, db::timeout_clock::time_point timeout) {
+    uint64_t cells = 0;
+    auto stripes = stripes_of(dk, range, cells);
+    locked_cells locks(*this, stripes.size());
+    for (size_t i = 0; i < stripes.size(); i++) {
+        if (!_stripes[stripes[i]].semaphore.try_wait()) {
+            // Keep the stripes already taken, they are lower than the rest.
+            return lock_slow(std::move(locks), std::move(stripes), i, cells, timeout);
         }
-
-        auto cell = make_lw_shared<cell_entry>(_partition_entry, position_in_partition(_current_ck->position()), cid);
-        _stats.lock_acquisitions++;
-        _partition_entry.insert(cell);
-        _locks.emplace_back(std::move(cell));
+        locks.add(stripes[i]);
     }
-    return make_ready_future<>();
+    _stats.lock_acquisitions += cells;
+    return make_ready_future<locked_cells>(std::move(locks));
 }
 
 inline
-bool cell_locker::partition_entry::upgrade(schema_ptr new_schema) {
-    if (_schema == new_schema) {
-        return true;
-    }
-
-    auto buckets = std::make_unique<cells_type::bucket_type[]>(_cells.bucket_count());
-    auto cells = cells_type(cells_type::bucket_traits(buckets.get(), _cells.bucket_count()),
-                            cell_entry::hasher(*new_schema), cell_entry::equal_compare(*new_schema));
-
-    _cells.clear_and_dispose([&] (cell_entry* cell_ptr) noexcept {
-        auto& cell = *cell_ptr;
-        auto kind = cell.position().is_static_row() ? column_kind::static_column
-                                                    : column_kind::regular_column;
-        auto reinsert = cell.upgrade(*_schema, *new_schema, kind);
-        if (reinsert) {
-            cells.insert(cell);
-        } else {
-            _cell_count--;
+future<locked_cells> cell_locker::lock_slow(locked_cells locks, stripes_type stripes, size_t first, uint64_t cells,
+                                            db::timeout_clock::time_point timeout) {
+    _stats.operations_waiting_for_lock++;
+    try {
+        for (auto i = first; i < stripes.size(); i++) {
+            co_await _stripes[stripes[i]].semaphore.wait(timeout);
+            locks.add(stripes[i]);
         }
-    });
-
-    // bi::unordered_set move assignment is actually a swap.
-    // Original _buckets cannot be destroyed before the container using them is
-    // so we need to explicitly make sure that the original _cells is no more.
-    _cells = std::move(cells);
-    auto destroy = [] (auto) { };
-    destroy(std::move(cells));
-
-    _buckets = std::move(buckets);
-    _schema = new_schema;
-    return _cell_count;
+    } catch (...) {
+        _stats.operations_waiting_for_lock--;
+        throw;
+    }
+    _stats.operations_waiting_for_lock--;
+    _stats.lock_acquisitions += cells;
+    co_return std::move(locks);
 }
@@ -31,9 +31,11 @@
 #include "sstables/sstable_writer.hh"
 #include "sstables/progress_monitor.hh"
 #include "sstables/sstables_manager.hh"
+#include "sstables/hyperloglog.hh"
 #include "compaction.hh"
 #include "compaction_manager.hh"
 #include "mutation_reader.hh"
+#include "readers/multi_range.hh"
 #include "schema.hh"
 #include "db/system_keyspace.hh"
 #include "service/priority_manager.hh"
@@ -197,6 +199,111 @@ static std::vector<shared_sstable> get_uncompacting_sstables(const table_state&
     return not_compacted_sstables;
 }
 
+// Returns whether the sstable has an ancestor which was compacted, but isn't
+// deleted yet.
+//
+// Ancestors are taken from sstable which is empty after restart. It works for
+// this purpose because we only need to check that a sstable compacted *in
+// this instance* hasn't an ancestor undeleted. Not getting it from sstable
+// metadata because mc format hasn't it available.
+static std::function<bool(const shared_sstable&)> make_undeleted_ancestor_checker(const table_state& table_s) {
+    auto compacted_undeleted_gens = boost::copy_range<std::unordered_set<int64_t>>(table_s.compacted_undeleted_sstables()
+        | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::generation)));
+    return [compacted_undeleted_gens = std::move(compacted_undeleted_gens)] (const shared_sstable& candidate) {
+        return boost::algorithm::any_of(candidate->compaction_ancestors(), [&compacted_undeleted_gens] (auto gen) {
+            return compacted_undeleted_gens.contains(gen);
+        });
+    };
+}
+
+// Returns the ranges of partitions to read from the compacting sstables in
+// which the expiry index shows runs of partitions that can be dropped without
+// reading them, like fully expired sstables can: all their data expired past
+// gc grace, and is older than any data it may shadow in the other sstables.
+// Sstables with no such partitions are left out of the returned map.
+static std::unordered_map<shared_sstable, dht::partition_range_vector>
+get_unexpired_partition_ranges(const table_state& table_s, const std::vector<shared_sstable>& compacting,
+        const std::unordered_set<shared_sstable>& fully_expired, gc_clock::time_point compaction_time) {
+    std::unordered_map<shared_sstable, dht::partition_range_vector> ret;
+    auto has_expiry_index = [] (const shared_sstable& sst) {
+        auto* sm = sst->get_scylla_metadata();
+        return sm && sm->get_expiry_index();
+    };
+    if (std::ranges::none_of(compacting, has_expiry_index)) {
+        return ret;
+    }
+
+    auto uncompacting_sstables = get_uncompacting_sstables(table_s, compacting);
+    std::vector<sstables::shared_sstable> overlapping = leveled_manifest::overlapping(*table_s.schema(), compacting, uncompacting_sstables);
+    auto min_timestamp = std::numeric_limits<api::timestamp_type>::max();
+    for (auto& sst : overlapping) {
+        min_timestamp = std::min(min_timestamp, sst->get_stats_metadata().min_timestamp);
+    }
+
+    auto has_undeleted_ancestor = make_undeleted_ancestor_checker(table_s);
+    for (auto& sst : compacting) {
+        if (fully_expired.contains(sst) || !has_expiry_index(sst) || has_undeleted_ancestor(sst)) {
+            continue;
+        }
+        // The partitions may also shadow data in the other compacting sstables.
+        auto max_purgeable = min_timestamp;
+        for (auto& other : compacting) {
+            if (other != sst && !fully_expired.contains(other)) {
+                max_purgeable = std::min(max_purgeable, other->get_stats_metadata().min_timestamp);
+            }
+        }
+        if (auto ranges = sst->get_unexpired_partition_ranges(compaction_time, max_purgeable)) {
+            ret.emplace(sst, std::move(*ranges));
+        }
+    }
+    return ret;
+}
+
+// Merges the cardinality estimators of the input sstables, to estimate the
+// number of distinct partitions in the output. Keys present in several inputs
+// are counted once, unlike when summing the key counts of the inputs.
+class cardinality_estimator_merger {
+    std::optional<hll::HyperLogLog> _merged;
+    bool _complete = true;
+public:
+    // Whether the estimators of all sstables added so far were available.
+    bool complete() const noexcept {
+        return _complete;
+    }
+
+    void add(std::optional<hll::HyperLogLog> e) {
+        if (!_complete) {
+            return;
+        }
+        if (!e) {
+            _complete = false;
+            _merged.reset();
+            return;
+        }
+        if (!_merged) {
+            _merged = std::move(e);
+            return;
+        }
+        // Sstables written by older versions have narrower estimators.
+        auto b = std::min(_merged->bitWidth(), e->bitWidth());
+        if (_merged->bitWidth() > b) {
+            _merged = _merged->fold(b);
+        }
+        _merged->merge(e->bitWidth() > b ? e->fold(b) : *e);
+    }
+
+    // Disengaged unless every input had an estimator. The estimate is padded
+    // by two standard errors, since an undersized bloom filter costs more
+    // than an oversized one.
+    std::optional<uint64_t> estimate() const {
+        if (!_merged) {
+            return std::nullopt;
+        }
+        auto std_error = 1.04 / std::sqrt(_merged->registerSize());
+        return uint64_t(std::ceil(_merged->estimate() * (1 + 2 * std_error)));
+    }
+};
+
 class compaction;
 
 class compaction_write_monitor final : public sstables::write_monitor, public backlog_write_progress_manager {
@@ -325,6 +432,126 @@ class compacted_fragments_writer {
     void consume_end_of_stream();
 };
 
+// Splits the compacted fragments between the compaction's output and a
+// separate tombstone output.
+//
+// An expired tombstone reaching the output wasn't purged only because it may
+// shadow data in sstables which don't take part in the compaction. Such
+// tombstones are written to the tombstone output: partition tombstones, range
+// tombstones and rows with nothing but a row tombstone. The main output is
+// then as small as if they were purged, and the tombstones are purged once
+// their small sstables are compacted together with the data they shadow.
+class unpurgeable_tombstone_splitter {
+    schema_ptr _schema;
+    gc_clock::time_point _compaction_time;
+    compacted_fragments_writer _main;
+    compacted_fragments_writer _tombstones;
+    std::optional<dht::decorated_key> _dk;
+    gc_clock::time_point _gc_before;
+    bool _main_partition_started = false;
+    bool _tombstones_partition_started = false;
+    // The range tombstone open in each output.
+    tombstone _main_range_tombstone;
+    tombstone _tombstones_range_tombstone;
+private:
+    bool is_expired(tombstone t) const {
+        return t && t.deletion_time < _gc_before;
+    }
+    bool is_expired_tombstone_only(const clustering_row& cr) const {
+        return cr.tomb() && cr.tomb().max_deletion_time() < _gc_before && cr.marker().is_missing() && cr.cells().empty();
+    }
+    compacted_fragments_writer& main() {
+        if (!_main_partition_started) {
+            _main.consume_new_partition(*_dk);
+            _main_partition_started = true;
+        }
+        return _main;
+    }
+    compacted_fragments_writer& tombstones() {
+        if (!_tombstones_partition_started) {
+            _tombstones.consume_new_partition(*_dk);
+            _tombstones_partition_started = true;
+        }
+        return _tombstones;
+    }
+public:
+    unpurgeable_tombstone_splitter(schema_ptr s, gc_clock::time_point compaction_time, compacted_fragments_writer main, compacted_fragments_writer tombstones)
+        : _schema(std::move(s))
+        , _compaction_time(compaction_time)
+        , _main(std::move(main))
+        , _tombstones(std::move(tombstones))
+    { }
+
+    void consume_new_partition(const dht::decorated_key& dk) {
+        _dk = dk;
+        _gc_before = ::get_gc_before_for_key(_schema, dk, _compaction_time);
+        _main_partition_started = false;
+        _tombstones_partition_started = false;
+        _main_range_tombstone = {};
+        _tombstones_range_tombstone = {};
+    }
+
+    void consume(tombstone t) {
+        if (is_expired(t)) {
+            tombstones().consume(t);
+        } else if (t) {
+            main().consume(t);
+        }
+    }
+    stop_iteration consume(static_row&& sr, tombstone t, bool is_live) {
+        return main().consume(std::move(sr), t, is_live);
+    }
+    stop_iteration consume(static_row&& sr) {
+        return consume(std::move(sr), tombstone{}, bool{});
+    }
+    stop_iteration consume(clustering_row&& cr, row_tombstone t, bool is_live) {
+        if (!is_live && is_expired_tombstone_only(cr)) {
+            return tombstones().consume(std::move(cr), t, is_live);
+        }
+        return main().consume(std::move(cr), t, is_live);
+    }
+    stop_iteration consume(clustering_row&& cr) {
+        return consume(std::move(cr), row_tombstone{}, bool{});
+    }
+    stop_iteration consume(range_tombstone_change&& rtc) {
+        // Each output gets a well-formed stream: the range tombstone open in
+        // one output is closed when the next one goes to the other.
+        auto stop = stop_iteration::no;
+        if (is_expired(rtc.tombstone())) {
+            if (_main_range_tombstone) {
+                stop = main().consume(range_tombstone_change(rtc.position(), tombstone{}));
+                _main_range_tombstone = {};
+            }
+            _tombstones_range_tombstone = rtc.tombstone();
+            return tombstones().consume(std::move(rtc)) || stop;
+        }
+        if (_tombstones_range_tombstone) {
+            stop = tombstones().consume(range_tombstone_change(rtc.position(), tombstone{}));
+            _tombstones_range_tombstone = {};
+        }
+        if (!rtc.tombstone() && !_main_range_tombstone) {
+            return stop;
+        }
+        _main_range_tombstone = rtc.tombstone();
+        return main().consume(std::move(rtc)) || stop;
+    }
+
+    stop_iteration consume_end_of_partition() {
+        auto stop = stop_iteration::no;
+        if (_main_partition_started) {
+            stop = _main.consume_end_of_partition();
+        }
+        if (_tombstones_partition_started) {
+            stop = _tombstones.consume_end_of_partition() || stop;
+        }
+        return stop;
+    }
+    void consume_end_of_stream() {
+        _main.consume_end_of_stream();
+        _tombstones.consume_end_of_stream();
+    }
+};
+
 struct compaction_read_monitor_generator final : public read_monitor_generator {
     class compaction_read_monitor final : public  sstables::read_monitor, public backlog_read_progress_manager {
         sstables::shared_sstable _sst;
@@ -437,6 +664,9 @@ class compaction {
     std::vector<shared_sstable> _new_unused_sstables;
     std::vector<shared_sstable> _all_new_sstables;
     lw_shared_ptr<sstable_set> _compacting;
+    // Ranges of partitions to read from the compacting sstables whose
+    // expiry index allows leaving some out.
+    std::unordered_map<shared_sstable, dht::partition_range_vector> _unexpired_partition_ranges;
     sstables::compaction_type _type;
     uint64_t _max_sstable_size;
     uint32_t _sstable_level;
@@ -616,8 +846,13 @@ class compaction {
     void setup() {
         auto ssts = make_lw_shared<sstables::sstable_set>(make_sstable_set_for_input());
         formatted_sstables_list formatted_msg;
-        auto fully_expired = _table_s.fully_expired_sstables(_sstables, gc_clock::now());
+        auto compaction_time = gc_clock::now();
+        auto fully_expired = _table_s.fully_expired_sstables(_sstables, compaction_time);
+        if (tombstone_expiration_enabled() && _type == compaction_type::Compaction) {
+            _unexpired_partition_ranges = get_unexpired_partition_ranges(_table_s, _sstables, fully_expired, compaction_time);
+        }
         min_max_tracker<api::timestamp_type> timestamp_tracker;
+        cardinality_estimator_merger cardinality;
 
         for (auto& sst : _sstables) {
             auto& sst_stats = sst->get_stats_metadata();
@@ -636,13 +871,18 @@ class compaction {
                 log_debug("Fully expired sstable {} will be dropped on compaction completion", sst->get_filename());
                 continue;
             }
+            if (auto it = _unexpired_partition_ranges.find(sst); it != _unexpired_partition_ranges.end() && it->second.empty()) {
+                log_debug("Expired sstable {} will be dropped on compaction completion", sst->get_filename());
+                _unexpired_partition_ranges.erase(it);
+                continue;
+            }
 
             // We also capture the sstable, so we keep it alive while the read isn't done
             ssts->insert(sst);
-            // FIXME: If the sstables have cardinality estimation bitmaps, use that
-            // for a better estimate for the number of partitions in the merged
-            // sstable than just adding up the lengths of individual sstables.
             _estimated_partitions += sst->get_estimated_key_count();
+            if (cardinality.complete()) {
+                cardinality.add(sst->get_cardinality_estimator(_io_priority).get0());
+            }
             // TODO:
             // Note that this is not fully correct. Since we might be merging sstables that originated on
             // another shard (#cpu changed), we might be comparing RP:s with differing shard ids,
@@ -652,6 +892,11 @@ class compaction {
             // compacted sstables anyway (CL should be clean by then).
             _rp = std::max(_rp, sst_stats.position);
         }
+        // The sum of the key counts over-estimates the output when the inputs
+        // overlap, and the writer sizes the output's bloom filter from it.
+        if (auto estimate = cardinality.estimate()) {
+            _estimated_partitions = std::min(_estimated_partitions, std::max<uint64_t>(*estimate, 1));
+        }
         log_info("{} {}", report_start_desc(), formatted_msg);
         if (ssts->all()->size() < _sstables.size()) {
             log_debug("{} out of {} input sstables are fully expired sstables that will not be actually compacted",
@@ -668,9 +913,13 @@ class compaction {
     // compacting_reader. It's useful for allowing data from different buckets
     // to be compacted together.
     future<> consume_without_gc_writer(gc_clock::time_point compaction_time) {
-        auto consumer = make_interposer_consumer([this] (flat_mutation_reader_v2 reader) mutable {
-            return seastar::async([this, reader = std::move(reader)] () mutable {
+        auto consumer = make_interposer_consumer([this, compaction_time] (flat_mutation_reader_v2 reader) mutable {
+            return seastar::async([this, reader = std::move(reader), compaction_time] () mutable {
                 auto close_reader = deferred_close(reader);
+                if (split_unpurgeable_tombstones()) {
+                    reader.consume_in_thread(get_unpurgeable_tombstone_splitter(compaction_time));
+                    return;
+                }
                 auto cfc = compacted_fragments_writer(get_compacted_fragments_writer());
                 reader.consume_in_thread(std::move(cfc));
             });
@@ -701,6 +950,15 @@ class compaction {
                     reader.consume_in_thread(std::move(cfc));
                     return;
                 }
+                if (split_unpurgeable_tombstones()) {
+                    using compact_mutations = compact_for_compaction_v2<unpurgeable_tombstone_splitter, noop_compacted_fragments_consumer>;
+                    auto cfc = compact_mutations(*schema(), now,
+                        max_purgeable_func(),
+                        get_unpurgeable_tombstone_splitter(now),
+                        noop_compacted_fragments_consumer());
+                    reader.consume_in_thread(std::move(cfc));
+                    return;
+                }
                 using compact_mutations = compact_for_compaction_v2<compacted_fragments_writer, noop_compacted_fragments_consumer>;
                 auto cfc = compact_mutations(*schema(), now,
                     max_purgeable_func(),
@@ -783,6 +1041,25 @@ class compaction {
             [this] (compaction_writer* cw) { stop_sstable_writer(cw); });
     }
 
+    // Expired tombstones which can't be purged are written to sstables of
+    // their own, see unpurgeable_tombstone_splitter. Only done by regular
+    // compaction into level 0 which doesn't replace exhausted sstables
+    // incrementally, as the extra sstables would otherwise overlap a level or
+    // a run.
+    bool split_unpurgeable_tombstones() const {
+        return _type == compaction_type::Compaction
+            && tombstone_expiration_enabled()
+            && !enable_garbage_collected_sstable_writer()
+            && _sstable_level == 0
+            && _table_s.compaction_split_unpurgeable_tombstones();
+    }
+
+    unpurgeable_tombstone_splitter get_unpurgeable_tombstone_splitter(gc_clock::time_point compaction_time) {
+        return unpurgeable_tombstone_splitter(schema(), compaction_time,
+            get_compacted_fragments_writer(),
+            get_compacted_fragments_writer());
+    }
+
     const schema_ptr& schema() const {
         return _schema;
     }
@@ -941,9 +1218,39 @@ class regular_compaction : public compaction {
         , _monitor_generator(_table_s)
     {
     }
+protected:
+    flat_mutation_reader_v2 make_sstable_reader(const dht::partition_range& range, ::mutation_reader::forwarding fwd_mr) const {
+        return _compacting->make_local_shard_sstable_reader(_schema,
+                _permit,
+                range,
+                _schema->full_slice(),
+                _io_priority,
+                tracing::trace_state_ptr(),
+                ::streamed_mutation::forwarding::no,
+                fwd_mr,
+                _monitor_generator);
+    }
+public:
 
     flat_mutation_reader_v2 make_sstable_reader() const override {
-        return _compacting->make_local_shard_sstable_reader(_schema,
+        if (_unexpired_partition_ranges.empty()) {
+            return make_sstable_reader(query::full_partition_range, ::mutation_reader::forwarding::no);
+        }
+        // The sstables with expired partitions are read range by range, to
+        // skip over those.
+        auto rest = make_lw_shared<sstable_set>(*_compacting);
+        std::vector<flat_mutation_reader_v2> readers;
+        readers.reserve(_unexpired_partition_ranges.size() + 1);
+        for (auto& [sst, ranges] : _unexpired_partition_ranges) {
+            rest->erase(sst);
+            auto source = mutation_source([this, sst = sst] (schema_ptr s, reader_permit permit, const dht::partition_range& pr,
+                    const query::partition_slice& slice, const io_priority_class& pc, tracing::trace_state_ptr trace_state,
+                    ::streamed_mutation::forwarding fwd, ::mutation_reader::forwarding fwd_mr) {
+                return sst->make_reader(std::move(s), std::move(permit), pr, slice, pc, std::move(trace_state), fwd, fwd_mr, _monitor_generator(sst));
+            });
+            readers.push_back(make_flat_multi_range_reader(_schema, _permit, std::move(source), ranges, _schema->full_slice(), _io_priority));
+        }
+        readers.push_back(rest->make_local_shard_sstable_reader(_schema,
                 _permit,
                 query::full_partition_range,
                 _schema->full_slice(),
@@ -951,7 +1258,8 @@ class regular_compaction : public compaction {
                 tracing::trace_state_ptr(),
                 ::streamed_mutation::forwarding::no,
                 ::mutation_reader::forwarding::no,
-                _monitor_generator);
+                _monitor_generator));
+        return make_combined_reader(_schema, _permit, std::move(readers), ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no);
     }
 
     std::string_view report_start_desc() const override {
@@ -1087,6 +1395,8 @@ class cleanup_compaction final : public regular_compaction {
     };
 
     const dht::token_range_vector _owned_ranges;
+    // The owned ranges as partition ranges, read by make_sstable_reader()
+    const dht::partition_range_vector _owned_partition_ranges;
     incremental_owned_ranges_checker _owned_ranges_checker;
 private:
     // Called in a seastar thread
@@ -1127,6 +1437,7 @@ class cleanup_compaction final : public regular_compaction {
     cleanup_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, dht::token_range_vector owned_ranges)
         : regular_compaction(table_s, std::move(descriptor), cdata)
         , _owned_ranges(std::move(owned_ranges))
+        , _owned_partition_ranges(dht::to_partition_ranges(_owned_ranges))
         , _owned_ranges_checker(_owned_ranges)
     {
     }
@@ -1137,8 +1448,17 @@ class cleanup_compaction final : public regular_compaction {
     cleanup_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, compaction_type_options::upgrade opts)
         : cleanup_compaction(table_s, std::move(descriptor), cdata, std::move(opts.owned_ranges)) {}
 
+    // Reads only the owned ranges, so the index is used to skip over the
+    // partitions which don't belong to this node instead of reading them.
+    // An sstable with no owned data is dropped after a few index lookups,
+    // and a straddling one is read only where it's owned.
     flat_mutation_reader_v2 make_sstable_reader() const override {
-        return make_filtering_reader(regular_compaction::make_sstable_reader(), make_partition_filter());
+        auto source = mutation_source([this] (schema_ptr s, reader_permit permit, const dht::partition_range& range, const query::partition_slice& slice,
+                const io_priority_class& pc, tracing::trace_state_ptr trace_state, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
+            return regular_compaction::make_sstable_reader(range, fwd_mr);
+        });
+        auto reader = make_flat_multi_range_reader(_schema, _permit, std::move(source), _owned_partition_ranges, _schema->full_slice(), _io_priority);
+        return make_filtering_reader(std::move(reader), make_partition_filter());
     }
 
     std::string_view report_start_desc() const override {
@@ -1744,16 +2064,7 @@ get_fully_expired_sstables(const table_state& table_s, const std::vector<sstable
         }
     }
 
-    auto compacted_undeleted_gens = boost::copy_range<std::unordered_set<int64_t>>(table_s.compacted_undeleted_sstables()
-        | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::generation)));
-    auto has_undeleted_ancestor = [&compacted_undeleted_gens] (auto& candidate) {
-        // Get ancestors from sstable which is empty after restart. It works for this purpose because
-        // we only need to check that a sstable compacted *in this instance* hasn't an ancestor undeleted.
-        // Not getting it from sstable metadata because mc format hasn't it available.
-        return boost::algorithm::any_of(candidate->compaction_ancestors(), [&compacted_undeleted_gens] (auto gen) {
-            return compacted_undeleted_gens.contains(gen);
-        });
-    };
+    auto has_undeleted_ancestor = make_undeleted_ancestor_checker(table_s);
 
     // SStables that do not contain live data is added to list of possibly expired sstables.
     for (auto& candidate : compacting) {
@@ -77,6 +77,11 @@ class compaction_backlog_tracker {
     void transfer_ongoing_charges(compaction_backlog_tracker& new_bt, bool move_read_charges = true);
     void revert_charges(sstables::shared_sstable sst);
 
+    // See compaction_strategy_impl::backlog_priority().
+    void set_priority(double priority) noexcept {
+        _priority = priority;
+    }
+
     void disable() {
         _impl = {};
         _ongoing_writes = {};
@@ -91,6 +96,7 @@ class compaction_backlog_tracker {
     // changed in the middle of a compaction.
     ongoing_writes _ongoing_writes;
     ongoing_compactions _ongoing_compactions;
+    double _priority = 1.0;
     compaction_backlog_manager* _manager = nullptr;
     friend class compaction_backlog_manager;
 };
@@ -19,6 +19,7 @@
 #include "locator/abstract_replication_strategy.hh"
 #include "utils/fb_utilities.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/stall_activity.hh"
 #include <cmath>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
@@ -284,6 +285,51 @@ future<> compaction_manager::perform_task(shared_ptr<compaction_manager::task> t
     }
 }
 
+// A regular compaction of a single sstable into another level, with nothing
+// to purge, would write the same data again. Such jobs are common with LCS,
+// when an sstable doesn't overlap anything in the next level.
+static bool can_move_to_level_without_rewrite(const sstables::compaction_descriptor& descriptor) {
+    if (descriptor.options.type() != sstables::compaction_type::Compaction || descriptor.sstables.size() != 1) {
+        return false;
+    }
+    auto& sst = descriptor.sstables.front();
+    if (descriptor.level < 0 || sst->get_sstable_level() == uint32_t(descriptor.level) || sst->data_size() > descriptor.max_sstable_bytes) {
+        return false;
+    }
+    auto gc_before = sst->get_gc_before_for_drop_estimation(gc_clock::now());
+    return sst->estimate_droppable_tombstone_ratio(gc_before) == 0;
+}
+
+sstables::compaction_sstable_replacer_fn compaction_manager::task::make_replacer(release_exhausted_func_t release_exhausted) {
+    return [this, &t = *_compacting_table, release_exhausted = std::move(release_exhausted)] (sstables::compaction_completion_desc desc) {
+        t.get_compaction_strategy().notify_completion(desc.old_sstables, desc.new_sstables);
+        _cm.propagate_replacement(&t, desc.old_sstables, desc.new_sstables);
+        t.on_compaction_completion(desc);
+        // Calls compaction manager's task for this compaction to release reference to exhausted SSTables.
+        if (release_exhausted) {
+            release_exhausted(desc.old_sstables);
+        }
+    };
+}
+
+future<> compaction_manager::task::move_to_level_without_rewrite(sstables::compaction_descriptor descriptor, release_exhausted_func_t release_exhausted) {
+    replica::table& t = *_compacting_table;
+    auto& old_sst = descriptor.sstables.front();
+    // Link the files under a new generation and change the level of the new
+    // sstable. Statistics is rewritten through a temporary file, so the
+    // old sstable is left as it is.
+    auto new_sst = t.make_sstable(old_sst->get_dir(), t.calculate_generation_for_new_table(), old_sst->get_version(), old_sst->get_format());
+    co_await old_sst->create_links(new_sst->get_dir(), new_sst->generation());
+    co_await new_sst->load(descriptor.io_priority);
+    co_await new_sst->mutate_sstable_level(descriptor.level);
+    cmlog.info("Moved {} to level {} as {} without rewriting it", old_sst->get_filename(), descriptor.level, new_sst->get_filename());
+    // The data is the same, so there is nothing to invalidate in the cache.
+    make_replacer(std::move(release_exhausted))(sstables::compaction_completion_desc{
+        .old_sstables = descriptor.sstables,
+        .new_sstables = {std::move(new_sst)},
+    });
+}
+
 future<> compaction_manager::task::compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted) {
     if (!descriptor.sstables.size()) {
         // if there is nothing to compact, just return.
@@ -295,15 +341,7 @@ future<> compaction_manager::task::compact_sstables(sstables::compaction_descrip
         auto sst = t.make_sstable();
         return sst;
     };
-    descriptor.replacer = [this, &t, release_exhausted] (sstables::compaction_completion_desc desc) {
-        t.get_compaction_strategy().notify_completion(desc.old_sstables, desc.new_sstables);
-        _cm.propagate_replacement(&t, desc.old_sstables, desc.new_sstables);
-        t.on_compaction_completion(desc);
-        // Calls compaction manager's task for this compaction to release reference to exhausted SSTables.
-        if (release_exhausted) {
-            release_exhausted(desc.old_sstables);
-        }
-    };
+    descriptor.replacer = make_replacer(std::move(release_exhausted));
     auto compaction_type = descriptor.options.type();
     auto start_size = boost::accumulate(descriptor.sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0));
 
@@ -570,8 +608,10 @@ sstables::compaction_stopped_exception compaction_manager::task::make_compaction
     return sstables::compaction_stopped_exception(s->ks_name(), s->cf_name(), _compaction_data.stop_requested);
 }
 
-compaction_manager::compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, abort_source& as)
-    : _compaction_controller(csg.cpu, csg.io, 250ms, [this, available_memory] () -> float {
+compaction_manager::compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, abort_source& as,
+                                       utils::updateable_value<uint32_t> read_latency_slo_in_ms)
+    : _read_latency_slo_in_ms(std::move(read_latency_slo_in_ms))
+    , _compaction_controller(csg.cpu, csg.io, 250ms, [this, available_memory] () -> float {
         _last_backlog = backlog();
         auto b = _last_backlog / available_memory;
         // This means we are using an unimplemented strategy
@@ -582,6 +622,9 @@ compaction_manager::compaction_manager(compaction_scheduling_group csg, maintena
             return compaction_controller::normalization_factor;
         }
         return b;
+    }, compaction_controller::latency_feedback{
+        .read_latency = [this] { return read_latency_histogram(); },
+        .read_latency_slo = [this] { return std::chrono::microseconds(std::chrono::milliseconds(_read_latency_slo_in_ms())); },
     })
     , _backlog_manager(_compaction_controller)
     , _maintenance_sg(msg)
@@ -642,9 +685,23 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of compaction backlog for all tables in the system.")),
         sm::make_gauge("normalized_backlog", [this] { return _last_backlog / _available_memory; },
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
+        sm::make_gauge("shares", [this] { return _compaction_controller.shares(); },
+                       sm::description("Holds the shares set for compaction by the controller.")),
+        sm::make_gauge("latency_factor", [this] { return _compaction_controller.latency_factor(); },
+                       sm::description("Holds the factor by which the controller scales the compaction shares given by the backlog, to keep the read latency under compaction_read_latency_slo_in_ms.")),
+        sm::make_gauge("read_latency_p99", [this] { return _compaction_controller.read_latency_p99().count(); },
+                       sm::description("Holds the p99 latency of reads, in microseconds, which drove the last change of latency_factor.")),
     });
 }
 
+utils::time_estimated_histogram compaction_manager::read_latency_histogram() const {
+    utils::time_estimated_histogram h;
+    for (auto& [t, state] : _compaction_state) {
+        h.merge(t->get_stats().estimated_read);
+    }
+    return h;
+}
+
 void compaction_manager::enable() {
     assert(_state == state::none || _state == state::disabled);
     _state = state::enabled;
@@ -848,7 +905,10 @@ class compaction_manager::regular_compaction_task : public compaction_manager::t
 
             replica::table& t = *_compacting_table;
             sstables::compaction_strategy cs = t.get_compaction_strategy();
-            sstables::compaction_descriptor descriptor = cs.get_sstables_for_compaction(t.as_table_state(), _cm.get_strategy_control(), _cm.get_candidates(t));
+            sstables::compaction_descriptor descriptor = [&] {
+                utils::stall_activity_scope activity(utils::stall_activity::compaction_planning);
+                return cs.get_sstables_for_compaction(t.as_table_state(), _cm.get_strategy_control(), _cm.get_candidates(t));
+            }();
             int weight = calculate_weight(descriptor);
 
             if (descriptor.sstables.empty() || !can_proceed() || t.is_auto_compaction_disabled_by_user()) {
@@ -874,7 +934,11 @@ class compaction_manager::regular_compaction_task : public compaction_manager::t
             std::exception_ptr ex;
 
             try {
-                co_await compact_sstables(std::move(descriptor), _compaction_data, std::move(release_exhausted));
+                if (can_move_to_level_without_rewrite(descriptor)) {
+                    co_await move_to_level_without_rewrite(std::move(descriptor), std::move(release_exhausted));
+                } else {
+                    co_await compact_sstables(std::move(descriptor), _compaction_data, std::move(release_exhausted));
+                }
                 finish_compaction();
                 _cm.reevaluate_postponed_compactions();
                 continue;
@@ -1256,6 +1320,39 @@ future<> compaction_manager::perform_sstable_upgrade(replica::database& db, repl
     return rewrite_sstables(t, sstables::compaction_type_options::make_upgrade(db.get_keyspace_local_ranges(t->schema()->ks_name())), std::move(get_sstables));
 }
 
+std::vector<compaction_manager::tombstone_gc_estimate> compaction_manager::estimate_droppable_tombstones(const replica::table& t, double min_droppable_ratio) {
+    auto compaction_time = gc_clock::now();
+    std::vector<tombstone_gc_estimate> estimates;
+    for (auto& sst : get_candidates(t)) {
+        auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time);
+        auto ratio = sst->estimate_droppable_tombstone_ratio(gc_before);
+        estimates.push_back(tombstone_gc_estimate{
+            .sst = sst,
+            .droppable_ratio = ratio,
+            .droppable_bytes = uint64_t(ratio * sst->data_size()),
+            .selected = ratio > 0 && ratio >= min_droppable_ratio,
+        });
+    }
+    return estimates;
+}
+
+future<> compaction_manager::perform_tombstone_gc_compaction(replica::table* t, double min_droppable_ratio) {
+    auto get_sstables = [this, t, min_droppable_ratio] {
+        std::vector<sstables::shared_sstable> sstables;
+        uint64_t droppable_bytes = 0;
+        for (auto& e : estimate_droppable_tombstones(*t, min_droppable_ratio)) {
+            if (e.selected) {
+                droppable_bytes += e.droppable_bytes;
+                sstables.push_back(std::move(e.sst));
+            }
+        }
+        cmlog.info("Tombstone GC of {}.{}: rewriting {} sstable(s) with an estimated {} bytes of droppable tombstones",
+                t->schema()->ks_name(), t->schema()->cf_name(), sstables.size(), droppable_bytes);
+        return make_ready_future<std::vector<sstables::shared_sstable>>(std::move(sstables));
+    };
+    return rewrite_sstables(t, sstables::compaction_type_options::make_regular(), std::move(get_sstables));
+}
+
 // Submit a table to be scrubbed and wait for its termination.
 future<> compaction_manager::perform_sstable_scrub(replica::table* t, sstables::compaction_type_options::scrub opts) {
     auto scrub_mode = opts.operation_mode;
@@ -1389,7 +1486,7 @@ compaction::strategy_control& compaction_manager::get_strategy_control() const n
 }
 
 double compaction_backlog_tracker::backlog() const {
-    return disabled() ? compaction_controller::disable_backlog : _impl->backlog(_ongoing_writes, _ongoing_compactions);
+    return disabled() ? compaction_controller::disable_backlog : _impl->backlog(_ongoing_writes, _ongoing_compactions) * _priority;
 }
 
 void compaction_backlog_tracker::replace_sstables(const std::vector<sstables::shared_sstable>& old_ssts, const std::vector<sstables::shared_sstable>& new_ssts) {
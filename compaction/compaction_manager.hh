@@ -20,6 +20,7 @@
 #include <seastar/core/condition-variable.hh>
 #include "log.hh"
 #include "utils/exponential_backoff_retry.hh"
+#include "utils/updateable_value.hh"
 #include <vector>
 #include <list>
 #include <functional>
@@ -147,6 +148,10 @@ class compaction_manager {
         // Compacts set of SSTables according to the descriptor.
         using release_exhausted_func_t = std::function<void(const std::vector<sstables::shared_sstable>& exhausted_sstables)>;
         future<> compact_sstables(sstables::compaction_descriptor descriptor, sstables::compaction_data& cdata, release_exhausted_func_t release_exhausted);
+        // Replaces the single sstable of the descriptor with a copy, linked
+        // rather than rewritten, at the descriptor's level.
+        future<> move_to_level_without_rewrite(sstables::compaction_descriptor descriptor, release_exhausted_func_t release_exhausted);
+        sstables::compaction_sstable_replacer_fn make_replacer(release_exhausted_func_t release_exhausted);
     public:
         future<> run() noexcept;
 
@@ -270,6 +275,7 @@ class compaction_manager {
     timer<lowres_clock> _compaction_submission_timer = timer<lowres_clock>(compaction_submission_callback());
     static constexpr std::chrono::seconds periodic_compaction_submission_interval() { return std::chrono::seconds(3600); }
 
+    utils::updateable_value<uint32_t> _read_latency_slo_in_ms;
     compaction_controller _compaction_controller;
     compaction_backlog_manager _backlog_manager;
     maintenance_scheduling_group _maintenance_sg;
@@ -321,13 +327,17 @@ class compaction_manager {
 
     future<> perform_sstable_scrub_validate_mode(replica::table* t);
 
+    // The latency of reads from all registered tables, fed back to the controller.
+    utils::time_estimated_histogram read_latency_histogram() const;
+
     using get_candidates_func = std::function<future<std::vector<sstables::shared_sstable>>()>;
     class can_purge_tombstones_tag;
     using can_purge_tombstones = bool_class<can_purge_tombstones_tag>;
 
     future<> rewrite_sstables(replica::table* t, sstables::compaction_type_options options, get_candidates_func, can_purge_tombstones can_purge = can_purge_tombstones::yes);
 public:
-    compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, abort_source& as);
+    compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, abort_source& as,
+                       utils::updateable_value<uint32_t> read_latency_slo_in_ms = utils::updateable_value<uint32_t>(0));
     compaction_manager(compaction_scheduling_group csg, maintenance_scheduling_group msg, size_t available_memory, uint64_t shares, abort_source& as);
     compaction_manager();
     ~compaction_manager();
@@ -374,6 +384,28 @@ class compaction_manager {
     // Submit a table for major compaction.
     future<> perform_major_compaction(replica::table* t);
 
+    struct tombstone_gc_estimate {
+        sstables::shared_sstable sst;
+        // Estimated fraction of the sstable made of tombstones which can be purged now.
+        double droppable_ratio;
+        uint64_t droppable_bytes;
+        bool selected;
+    };
+
+    // Estimates the droppable tombstones of each sstable of the table which isn't
+    // being compacted, from its tombstone histogram and the table's tombstone_gc
+    // options. sstables with a droppable ratio of at least min_droppable_ratio are
+    // selected for perform_tombstone_gc_compaction().
+    std::vector<tombstone_gc_estimate> estimate_droppable_tombstones(const replica::table& t, double min_droppable_ratio);
+
+    // Submit a table to have its sstables with droppable tombstones rewritten and
+    // wait for its termination.
+    //
+    // Each sstable selected by estimate_droppable_tombstones() is rewritten on its own,
+    // which purges its droppable tombstones and nothing else. This catches sstables
+    // that the compaction strategy never picks because of their size.
+    future<> perform_tombstone_gc_compaction(replica::table* t, double min_droppable_ratio);
+
 
     // Run a custom job for a given table, defined by a function
     // it completes when future returned by job is ready or returns immediately
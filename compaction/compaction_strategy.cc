@@ -26,6 +26,7 @@
 #include "date_tiered_compaction_strategy.hh"
 #include "leveled_compaction_strategy.hh"
 #include "time_window_compaction_strategy.hh"
+#include "incremental_compaction_strategy.hh"
 #include "backlog_controller.hh"
 #include "compaction_backlog_manager.hh"
 #include "size_tiered_backlog_tracker.hh"
@@ -86,6 +87,12 @@ compaction_strategy_impl::compaction_strategy_impl(const std::map<sstring, sstri
     auto interval = property_definitions::to_long(TOMBSTONE_COMPACTION_INTERVAL_OPTION, tmp_value, DEFAULT_TOMBSTONE_COMPACTION_INTERVAL().count());
     _tombstone_compaction_interval = db_clock::duration(std::chrono::seconds(interval));
 
+    tmp_value = get_value(options, BACKLOG_PRIORITY_OPTION);
+    _backlog_priority = property_definitions::to_double(BACKLOG_PRIORITY_OPTION, tmp_value, 1.0);
+    if (_backlog_priority <= 0) {
+        throw exceptions::configuration_exception(format("{} value ({}) must be positive", BACKLOG_PRIORITY_OPTION, _backlog_priority));
+    }
+
     // FIXME: validate options.
 }
 
@@ -293,6 +300,7 @@ class leveled_compaction_backlog_tracker final : public compaction_backlog_track
     size_tiered_backlog_tracker _l0_scts;
     std::vector<uint64_t> _size_per_level;
     uint64_t _max_sstable_size;
+    size_t _l0_sstables = 0;
 public:
     leveled_compaction_backlog_tracker(int32_t max_sstable_size_in_mb, size_tiered_compaction_strategy_options stcs_options)
         : _l0_scts(stcs_options)
@@ -338,6 +346,14 @@ class leveled_compaction_backlog_tracker final : public compaction_backlog_track
                 b += std::min(double(leveled_manifest::leveled_fan_out), double(lsize_next) / _max_sstable_size)  * lsize;
             }
         }
+        // A compaction into L1 takes at most MAX_COMPACTING_L0 sstables, so an L0
+        // deeper than that rewrites the L1 data it overlaps once per extra batch.
+        // Count it, so that the controller speeds up compaction as L0 piles up,
+        // rather than only once its size shows up in the levels above.
+        if (_l0_sstables > size_t(leveled_manifest::MAX_COMPACTING_L0)) {
+            auto extra_batches = (_l0_sstables - 1) / leveled_manifest::MAX_COMPACTING_L0;
+            b += double(extra_batches) * effective_size_per_level[1];
+        }
         return b;
     }
 
@@ -347,6 +363,7 @@ class leveled_compaction_backlog_tracker final : public compaction_backlog_track
             auto level = sst->get_sstable_level();
             _size_per_level[level] += sst->data_size();
             if (level == 0) {
+                ++_l0_sstables;
                 l0_new_ssts.push_back(std::move(sst));
             }
         }
@@ -354,6 +371,7 @@ class leveled_compaction_backlog_tracker final : public compaction_backlog_track
             auto level = sst->get_sstable_level();
             _size_per_level[level] -= sst->data_size();
             if (level == 0) {
+                --_l0_sstables;
                 l0_old_ssts.push_back(std::move(sst));
             }
         }
@@ -720,9 +738,15 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::time_window:
         impl = ::make_shared<time_window_compaction_strategy>(options);
         break;
+    case compaction_strategy_type::incremental:
+        impl = ::make_shared<incremental_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
+    // Strategies without a backlog of their own share a tracker, whose
+    // backlog is either zero or disabled, so the priority doesn't matter there.
+    impl->get_backlog_tracker().set_priority(impl->backlog_priority());
 
     return compaction_strategy(std::move(impl));
 }
@@ -33,11 +33,15 @@ class compaction_strategy_impl {
 protected:
     const sstring TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     const sstring TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
+    const sstring BACKLOG_PRIORITY_OPTION = "backlog_priority";
 
     bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
+    // The table's backlog is multiplied by it before being summed with the
+    // backlog of other tables, to give the table more or less compaction shares.
+    double _backlog_priority = 1.0;
 public:
     static std::optional<sstring> get_value(const std::map<sstring, sstring>& options, const sstring& name);
 protected:
@@ -59,6 +63,10 @@ class compaction_strategy_impl {
         return _use_clustering_key_filter;
     }
 
+    double backlog_priority() const {
+        return _backlog_priority;
+    }
+
     // Check if a given sstable is entitled for tombstone compaction based on its
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time);
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "incremental_compaction_strategy.hh"
+
+#include <cmath>
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/algorithm/min_element.hpp>
+
+namespace sstables {
+
+// Backlog for one run under ICS is the STCS backlog with the run taking the
+// place of the SSTable:
+//
+//   Bi = (Si - Ci) * log4(T / Si),
+//
+// where Si is the size of the run, Ci the amount of bytes already compacted
+// from its fragments and T the total size of the table. Accounting fragments
+// individually would treat a table made of a single large run as having a
+// large backlog, when there is nothing left to compact.
+class incremental_backlog_tracker final : public compaction_backlog_tracker::impl {
+    std::unordered_map<utils::UUID, sstable_run> _runs;
+    int64_t _total_bytes = 0;
+
+    static double log4(double x) {
+        double inv_log_4 = 1.0f / std::log(4);
+        return std::log(x) * inv_log_4;
+    }
+public:
+    virtual double backlog(const compaction_backlog_tracker::ongoing_writes& ow, const compaction_backlog_tracker::ongoing_compactions& oc) const override {
+        if (_total_bytes <= 0) {
+            return 0;
+        }
+        std::unordered_map<utils::UUID, uint64_t> compacted;
+        for (auto const& crp : oc) {
+            compacted[crp.first->run_identifier()] += crp.second->compacted();
+        }
+        double b = 0;
+        for (auto& [id, run] : _runs) {
+            auto run_size = run.data_size();
+            auto it = compacted.find(id);
+            auto run_compacted = it != compacted.end() ? it->second : 0;
+            if (run_size <= run_compacted) {
+                continue;
+            }
+            b += (run_size - run_compacted) * log4(double(_total_bytes) / run_size);
+        }
+        return b > 0 ? b : 0;
+    }
+
+    virtual void replace_sstables(std::vector<sstables::shared_sstable> old_ssts, std::vector<sstables::shared_sstable> new_ssts) override {
+        for (auto& sst : old_ssts) {
+            if (sst->data_size() > 0) {
+                auto it = _runs.find(sst->run_identifier());
+                if (it == _runs.end()) {
+                    continue;
+                }
+                _total_bytes -= sst->data_size();
+                it->second.erase(sst);
+                if (it->second.all().empty()) {
+                    _runs.erase(it);
+                }
+            }
+        }
+        for (auto& sst : new_ssts) {
+            if (sst->data_size() > 0) {
+                _total_bytes += sst->data_size();
+                _runs[sst->run_identifier()].insert(std::move(sst));
+            }
+        }
+    }
+};
+
+incremental_compaction_strategy::incremental_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _stcs_options(options)
+    , _backlog_tracker(std::make_unique<incremental_backlog_tracker>())
+{
+    using namespace cql3::statements;
+
+    auto tmp_value = compaction_strategy_impl::get_value(options, SSTABLE_SIZE_OPTION);
+    auto size_in_mb = property_definitions::to_long(SSTABLE_SIZE_OPTION, tmp_value, DEFAULT_MAX_SSTABLE_SIZE_IN_MB);
+    if (size_in_mb <= 0) {
+        throw exceptions::configuration_exception(format("{} value ({}) must be positive", SSTABLE_SIZE_OPTION, size_in_mb));
+    }
+    _fragment_size = uint64_t(size_in_mb) * 1024 * 1024;
+}
+
+std::vector<sstable_run> incremental_compaction_strategy::make_runs(const std::vector<shared_sstable>& sstables) {
+    std::unordered_map<utils::UUID, sstable_run> runs;
+    for (auto& sst : sstables) {
+        runs[sst->run_identifier()].insert(sst);
+    }
+    return boost::copy_range<std::vector<sstable_run>>(runs | boost::adaptors::map_values);
+}
+
+std::vector<std::vector<sstable_run>>
+incremental_compaction_strategy::get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options) {
+    // Same bucketing as size_tiered_compaction_strategy::get_buckets(), with the run size in place of the sstable size.
+    std::vector<std::pair<sstable_run, uint64_t>> sorted_runs;
+    sorted_runs.reserve(runs.size());
+    for (auto& run : runs) {
+        auto size = run.data_size();
+        sorted_runs.emplace_back(std::move(run), size);
+    }
+    std::sort(sorted_runs.begin(), sorted_runs.end(), [] (auto& i, auto& j) {
+        return i.second < j.second;
+    });
+
+    std::vector<std::vector<sstable_run>> bucket_list;
+    std::vector<double> bucket_average_size_list;
+    std::vector<uint64_t> bucket_smallest_size_list;
+
+    for (auto& [run, size] : sorted_runs) {
+        if (!bucket_list.empty()) {
+            auto& bucket_average_size = bucket_average_size_list.back();
+
+            if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
+                    (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
+                auto& bucket = bucket_list.back();
+                auto total_size = bucket.size() * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket.size() + 1);
+
+                // Don't let the average drift so high that the smallest run falls out of range.
+                if (size < options.min_sstable_size || bucket_smallest_size_list.back() > new_average_size * options.bucket_low) {
+                    bucket.push_back(std::move(run));
+                    bucket_average_size = new_average_size;
+                    continue;
+                }
+            }
+        }
+
+        bucket_list.emplace_back();
+        bucket_list.back().push_back(std::move(run));
+        bucket_average_size_list.push_back(size);
+        bucket_smallest_size_list.push_back(size);
+    }
+
+    return bucket_list;
+}
+
+std::vector<shared_sstable>
+incremental_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstable_run>>& buckets, size_t min_threshold, size_t max_threshold) {
+    std::vector<sstable_run>* most_interesting = nullptr;
+    for (auto& bucket : buckets) {
+        bucket.resize(std::min(bucket.size(), max_threshold));
+        if (bucket.size() >= min_threshold && (!most_interesting || bucket.size() > most_interesting->size())) {
+            most_interesting = &bucket;
+        }
+    }
+
+    std::vector<shared_sstable> fragments;
+    if (most_interesting) {
+        for (auto& run : *most_interesting) {
+            fragments.insert(fragments.end(), run.all().begin(), run.all().end());
+        }
+    }
+    return fragments;
+}
+
+compaction_descriptor incremental_compaction_strategy::make_descriptor(table_state& table_s, std::vector<shared_sstable> fragments) const {
+    return compaction_descriptor(std::move(fragments), table_s.get_sstable_set(), service::get_local_compaction_priority(),
+            compaction_descriptor::default_level, _fragment_size);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+
+    auto buckets = get_buckets(make_runs(candidates), _stcs_options);
+
+    if (auto fragments = most_interesting_bucket(buckets, min_threshold, max_threshold); !fragments.empty()) {
+        return make_descriptor(table_s, std::move(fragments));
+    }
+
+    if (!table_s.compaction_enforce_min_threshold()) {
+        if (auto fragments = most_interesting_bucket(buckets, 2, max_threshold); !fragments.empty()) {
+            return make_descriptor(table_s, std::move(fragments));
+        }
+    }
+
+    // Like STCS, fall back to rewriting a single sstable with enough droppable tombstones,
+    // oldest first from the biggest tiers. Only the fragment is rewritten, and the output
+    // keeps its run identifier, so the run stays a single run of disjoint fragments.
+    for (auto& bucket : buckets | boost::adaptors::reversed) {
+        std::vector<shared_sstable> fragments;
+        for (auto& run : bucket) {
+            for (auto& sst : run.all()) {
+                if (worth_dropping_tombstones(sst, compaction_time)) {
+                    fragments.push_back(sst);
+                }
+            }
+        }
+        if (fragments.empty()) {
+            continue;
+        }
+        auto sst = *boost::range::min_element(fragments, [] (auto& i, auto& j) {
+            return i->get_stats_metadata().min_timestamp < j->get_stats_metadata().min_timestamp;
+        });
+        auto run_identifier = sst->run_identifier();
+        return compaction_descriptor({ std::move(sst) }, table_s.get_sstable_set(), service::get_local_compaction_priority(),
+                compaction_descriptor::default_level, _fragment_size, run_identifier);
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    return make_descriptor(table_s, std::move(candidates));
+}
+
+int64_t incremental_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    std::vector<shared_sstable> sstables;
+
+    auto all_sstables = table_s.get_sstable_set().all();
+    sstables.reserve(all_sstables->size());
+    for (auto& entry : *all_sstables) {
+        sstables.push_back(entry);
+    }
+
+    int64_t n = 0;
+    for (auto& bucket : get_buckets(make_runs(sstables), _stcs_options)) {
+        if (bucket.size() >= min_threshold) {
+            n += std::ceil(double(bucket.size()) / max_threshold);
+        }
+    }
+    return n;
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) {
+    // Sstables coming from off-strategy sources aren't organized in runs yet, so
+    // reshape them like STCS would, but write the output as a run of fragments.
+    auto desc = size_tiered_compaction_strategy(_stcs_options).get_reshaping_job(std::move(input), std::move(schema), iop, mode);
+    desc.max_sstable_bytes = _fragment_size;
+    return desc;
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "sstables/sstable_set.hh"
+
+namespace sstables {
+
+// Size-tiered compaction over sstable runs rather than over sstables.
+//
+// Compaction output is split into fragments of at most sstable_size_in_mb, which
+// together form a run of disjoint sstables. Runs of similar size are bucketed and
+// compacted together the same way STCS does it for sstables. Since every input is
+// a run of fragments, regular compaction can release each input fragment as soon
+// as the output has gone past its last key, so the temporary space needed by a
+// compaction is a few fragments rather than the size of its input.
+class incremental_compaction_strategy : public compaction_strategy_impl {
+    static constexpr uint64_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 1000;
+    const sstring SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+
+    uint64_t _fragment_size = DEFAULT_MAX_SSTABLE_SIZE_IN_MB * 1024 * 1024;
+    size_tiered_compaction_strategy_options _stcs_options;
+    compaction_backlog_tracker _backlog_tracker;
+
+    // Group the fragments of the given sstables by run.
+    static std::vector<sstable_run> make_runs(const std::vector<shared_sstable>& sstables);
+
+    // Group runs of similar size into buckets.
+    static std::vector<std::vector<sstable_run>> get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options);
+
+    // Return the fragments of the largest bucket with at least min_threshold runs,
+    // or nothing if there is no such bucket.
+    static std::vector<shared_sstable> most_interesting_bucket(std::vector<std::vector<sstable_run>>& buckets, size_t min_threshold, size_t max_threshold);
+
+    compaction_descriptor make_descriptor(table_state& table_s, std::vector<shared_sstable> fragments) const;
+public:
+    incremental_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::incremental;
+    }
+
+    virtual compaction_backlog_tracker& get_backlog_tracker() override {
+        return _backlog_tracker;
+    }
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
+
+    uint64_t fragment_size() const noexcept {
+        return _fragment_size;
+    }
+};
+
+}
@@ -19,7 +19,6 @@
 #include "range.hh"
 #include "log.hh"
 #include <boost/range/algorithm/sort.hpp>
-#include <boost/range/algorithm/partial_sort.hpp>
 #include "service/priority_manager.hh"
 
 class leveled_manifest {
@@ -390,6 +389,41 @@ class leveled_manifest {
     bool worth_promoting_L0_candidates(const std::vector<sstables::shared_sstable>& candidates) const {
         return get_total_bytes(candidates) >= _max_sstable_size_in_bytes;
     }
+
+    // Picks MAX_COMPACTING_L0 of the L0 sstables, sorted oldest first, for a
+    // compaction into L1. The oldest one and the L1 sstables it overlaps
+    // delimit a token range, and the L0 sstables which fall within it are
+    // taken, oldest first. When L0 sstables cover parts of the ring, as
+    // those of flushes split into token ranges do, the compaction then
+    // rewrites only the part of L1 it has data for, rather than the union
+    // of the spans of the oldest sstables, which is usually all of L1.
+    // If the range doesn't hold enough data, falls back to the oldest ones.
+    std::vector<sstables::shared_sstable> l1_aligned_L0_candidates(std::vector<sstables::shared_sstable> l0) const {
+        const auto& oldest = l0.front();
+        auto start = oldest->get_first_decorated_key()._token;
+        auto end = oldest->get_last_decorated_key()._token;
+        for (auto& sst : overlapping(*_schema, oldest, get_level(1))) {
+            start = std::min(start, sst->get_first_decorated_key()._token);
+            end = std::max(end, sst->get_last_decorated_key()._token);
+        }
+
+        std::vector<sstables::shared_sstable> candidates;
+        candidates.reserve(MAX_COMPACTING_L0);
+        for (auto& sst : l0) {
+            if (candidates.size() == MAX_COMPACTING_L0) {
+                break;
+            }
+            if (sst->get_first_decorated_key()._token >= start && sst->get_last_decorated_key()._token <= end) {
+                candidates.push_back(sst);
+            }
+        }
+        if (!worth_promoting_L0_candidates(candidates)) {
+            l0.resize(MAX_COMPACTING_L0);
+            return l0;
+        }
+        logger.debug("Compacting {} of {} L0 sstables, within {}..{}", candidates.size(), l0.size(), start, end);
+        return candidates;
+    }
 private:
     candidates_info candidates_for_level_0_compaction() {
         // L0 is the dumping ground for new sstables which thus may overlap each other.
@@ -407,11 +441,11 @@ class leveled_manifest {
         if (worth_promoting_L0_candidates(get_level(0))) {
             candidates = get_level(0);
             if (candidates.size() > MAX_COMPACTING_L0) {
-                // limit to only the MAX_COMPACTING_L0 oldest candidates
-                boost::partial_sort(candidates, candidates.begin() + MAX_COMPACTING_L0, [] (auto& i, auto& j) {
+                // limit to MAX_COMPACTING_L0 candidates, oldest first
+                boost::sort(candidates, [] (auto& i, auto& j) {
                     return i->compare_by_max_timestamp(*j) < 0;
                 });
-                candidates.resize(MAX_COMPACTING_L0);
+                candidates = l1_aligned_L0_candidates(std::move(candidates));
             }
             // add sstables from L1 that overlap candidates
             auto l1overlapping = overlapping(*_schema, candidates, get_level(1));
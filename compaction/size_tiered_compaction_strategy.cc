@@ -11,6 +11,7 @@
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm.hpp>
+#include <boost/range/numeric.hpp>
 
 namespace sstables {
 
@@ -108,23 +109,33 @@ size_tiered_compaction_strategy::get_buckets(const std::vector<sstables::shared_
     return get_buckets(sstables, _options);
 }
 
+// Recent single partition reads of the sstable which found their partition,
+// per partition in it, so that small sstables aren't seen as colder than big
+// ones for being read as often.
+static double read_hotness(const sstables::shared_sstable& sst) {
+    auto keys = std::max<uint64_t>(sst->get_estimated_key_count(), 1);
+    return double(sst->get_read_heat().recent().index_lookups) / keys;
+}
+
 std::vector<sstables::shared_sstable>
 size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstables::shared_sstable>> buckets,
         unsigned min_threshold, unsigned max_threshold)
 {
-    std::vector<std::pair<std::vector<sstables::shared_sstable>, uint64_t>> pruned_buckets_and_hotness;
+    std::vector<std::pair<std::vector<sstables::shared_sstable>, double>> pruned_buckets_and_hotness;
     pruned_buckets_and_hotness.reserve(buckets.size());
 
-    // FIXME: add support to get hotness for each bucket.
-
     for (auto& bucket : buckets) {
-        // FIXME: the coldest sstables will be trimmed to meet the threshold, so we must add support to this feature
-        // by converting SizeTieredCompactionStrategy::trimToThresholdWithHotness.
-        // By the time being, we will only compact buckets that meet the threshold.
-        bucket.resize(std::min(bucket.size(), size_t(max_threshold)));
+        // Trim the coldest sstables to meet the threshold, so that the ones
+        // reads go through the most are merged first.
+        if (bucket.size() > max_threshold) {
+            std::stable_sort(bucket.begin(), bucket.end(), [] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+                return read_hotness(a) > read_hotness(b);
+            });
+            bucket.resize(max_threshold);
+        }
         if (is_bucket_interesting(bucket, min_threshold)) {
-            auto avg = avg_size(bucket);
-            pruned_buckets_and_hotness.push_back({ std::move(bucket), avg });
+            auto hotness = boost::accumulate(bucket | boost::adaptors::transformed([] (const sstables::shared_sstable& sst) { return read_hotness(sst); }), 0.0);
+            pruned_buckets_and_hotness.push_back({ std::move(bucket), hotness });
         }
     }
 
@@ -133,10 +144,12 @@ size_tiered_compaction_strategy::most_interesting_bucket(std::vector<std::vector
     }
 
     // Pick the bucket with more elements, as efficiency of same-tier compactions increases with number of files.
+    // Among buckets of the same size, pick the hottest one.
     auto& min = *std::min_element(pruned_buckets_and_hotness.begin(), pruned_buckets_and_hotness.end(), [] (auto& i, auto& j) {
-        // FIXME: ignoring hotness by the time being.
-
-        return i.first.size() > j.first.size();
+        if (i.first.size() != j.first.size()) {
+            return i.first.size() > j.first.size();
+        }
+        return i.second > j.second;
     });
     auto hottest = std::move(min.first);
 
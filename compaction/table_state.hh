@@ -28,6 +28,9 @@ class table_state {
     // min threshold as defined by table.
     virtual unsigned min_compaction_threshold() const noexcept = 0;
     virtual bool compaction_enforce_min_threshold() const noexcept = 0;
+    // Whether compactions write expired tombstones, which cannot be purged
+    // yet, to separate sstables.
+    virtual bool compaction_split_unpurgeable_tombstones() const noexcept = 0;
     virtual const sstables::sstable_set& get_sstable_set() const = 0;
     virtual std::unordered_set<sstables::shared_sstable> fully_expired_sstables(const std::vector<sstables::shared_sstable>& sstables, gc_clock::time_point compaction_time) const = 0;
     virtual const std::vector<sstables::shared_sstable>& compacted_undeleted_sstables() const noexcept = 0;
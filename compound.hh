@@ -17,13 +17,144 @@
 #include "utils/serialization.hh"
 #include <seastar/util/backtrace.hh>
 #include "cql_serialization_format.hh"
+#include "utils/UUID.hh"
+#include <seastar/core/byteorder.hh>
 
 enum class allow_prefixes { no, yes };
 
+// Compares values of one component of a compound.
+//
+// The way values are compared is resolved once from the component's type,
+// when the compound type is created. Fixed-width integers, timestamps,
+// timeuuids and types ordered by their bytes are then compared inline,
+// without going through abstract_type::compare() for every cell.
+// Values whose size doesn't match the type go to abstract_type::compare(),
+// which treats them the way it always did.
+class compound_component_comparator {
+    enum class kind : uint8_t {
+        generic,
+        byte_order,
+        int8,
+        int16,
+        int32,
+        int64,
+        uint32,
+        timeuuid,
+    };
+    // The type with reversed_type_impl stripped, kept alive by the compound's _types.
+    const abstract_type* _type;
+    kind _kind;
+    bool _reversed;
+
+    static kind kind_of(const abstract_type& t) {
+        switch (t.get_kind()) {
+        case abstract_type::kind::byte: return kind::int8;
+        case abstract_type::kind::short_kind: return kind::int16;
+        case abstract_type::kind::int32: return kind::int32;
+        case abstract_type::kind::long_kind:
+        case abstract_type::kind::timestamp:
+        case abstract_type::kind::time:
+            return kind::int64;
+        case abstract_type::kind::simple_date: return kind::uint32;
+        case abstract_type::kind::timeuuid: return kind::timeuuid;
+        case abstract_type::kind::ascii:
+        case abstract_type::kind::utf8:
+        case abstract_type::kind::bytes:
+        case abstract_type::kind::inet:
+        case abstract_type::kind::duration:
+        case abstract_type::kind::date:
+            return kind::byte_order;
+        default:
+            return kind::generic;
+        }
+    }
+
+    template <typename T>
+    static std::strong_ordering compare_integers(bytes_view v1, bytes_view v2) {
+        return read_be<T>(reinterpret_cast<const char*>(v1.data())) <=> read_be<T>(reinterpret_cast<const char*>(v2.data()));
+    }
+
+    std::strong_ordering compare_nonempty(bytes_view v1, bytes_view v2) const {
+        auto has_size = [&] (size_t size) {
+            return v1.size() == size && v2.size() == size;
+        };
+        switch (_kind) {
+        case kind::int8:
+            if (has_size(1)) {
+                return compare_integers<int8_t>(v1, v2);
+            }
+            break;
+        case kind::int16:
+            if (has_size(2)) {
+                return compare_integers<int16_t>(v1, v2);
+            }
+            break;
+        case kind::int32:
+            if (has_size(4)) {
+                return compare_integers<int32_t>(v1, v2);
+            }
+            break;
+        case kind::int64:
+            if (has_size(8)) {
+                return compare_integers<int64_t>(v1, v2);
+            }
+            break;
+        case kind::uint32:
+            if (has_size(4)) {
+                return compare_integers<uint32_t>(v1, v2);
+            }
+            break;
+        case kind::timeuuid:
+            if (has_size(16)) {
+                return utils::timeuuid_tri_compare(v1, v2);
+            }
+            break;
+        case kind::byte_order:
+        case kind::generic:
+            break;
+        }
+        return _type->compare(v1, v2);
+    }
+
+    std::strong_ordering compare_unreversed(bytes_view v1, bytes_view v2) const {
+        if (_kind == kind::generic) {
+            return _type->compare(v1, v2);
+        }
+        if (_kind == kind::byte_order) {
+            return compare_unsigned(v1, v2);
+        }
+        if (v1.empty()) {
+            return v2.empty() ? std::strong_ordering::equal : std::strong_ordering::less;
+        }
+        if (v2.empty()) {
+            return std::strong_ordering::greater;
+        }
+        return compare_nonempty(v1, v2);
+    }
+public:
+    explicit compound_component_comparator(const data_type& type)
+        : _type(&type->without_reversed())
+        , _kind(kind_of(*_type))
+        , _reversed(type->is_reversed())
+    { }
+
+    // Orders v1 and v2 the same way as compare() of the component's type.
+    std::strong_ordering compare(bytes_view v1, bytes_view v2) const {
+        return _reversed ? compare_unreversed(v2, v1) : compare_unreversed(v1, v2);
+    }
+    std::strong_ordering compare(managed_bytes_view v1, managed_bytes_view v2) const {
+        if (v1.current_fragment().size() != v1.size_bytes() || v2.current_fragment().size() != v2.size_bytes()) {
+            return _reversed ? _type->compare(v2, v1) : _type->compare(v1, v2);
+        }
+        return compare(v1.current_fragment(), v2.current_fragment());
+    }
+};
+
 template<allow_prefixes AllowPrefixes = allow_prefixes::no>
 class compound_type final {
 private:
     const std::vector<data_type> _types;
+    const std::vector<compound_component_comparator> _comparators;
     const bool _byte_order_equal;
     const bool _byte_order_comparable;
     const bool _is_reversed;
@@ -35,6 +166,7 @@ class compound_type final {
 
     compound_type(std::vector<data_type> types)
         : _types(std::move(types))
+        , _comparators(_types.begin(), _types.end())
         , _byte_order_equal(std::all_of(_types.begin(), _types.end(), [] (const auto& t) {
                 return t->is_byte_order_equal();
             }))
@@ -250,9 +382,9 @@ class compound_type final {
                 return compare_unsigned(b1, b2);
             }
         }
-        return lexicographical_tri_compare(_types.begin(), _types.end(),
-            begin(b1), end(b1), begin(b2), end(b2), [] (auto&& type, auto&& v1, auto&& v2) {
-                return type->compare(v1, v2);
+        return lexicographical_tri_compare(_comparators.begin(), _comparators.end(),
+            begin(b1), end(b1), begin(b2), end(b2), [] (const compound_component_comparator& c, managed_bytes_view v1, managed_bytes_view v2) {
+                return c.compare(v1, v2);
             });
     }
     // Retruns true iff given prefix has no missing components
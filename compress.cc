@@ -60,6 +60,18 @@ std::map<sstring, sstring> compressor::options() const {
     return {};
 }
 
+shared_ptr<compressor> compressor::with_dictionary(bytes_view) const {
+    throw std::runtime_error(format("{} does not support compression dictionaries", name()));
+}
+
+std::optional<bytes> compressor::train_dictionary(const std::vector<bytes_view>&) const {
+    return std::nullopt;
+}
+
+size_t compressor::dictionary_size() const {
+    return 0;
+}
+
 compressor::ptr_type compressor::create(const sstring& name, const opt_getter& opts) {
     if (name.empty()) {
         return {};
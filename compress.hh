@@ -15,6 +15,7 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sstring.hh>
 
+#include "bytes.hh"
 #include "exceptions/exceptions.hh"
 
 
@@ -42,6 +43,24 @@ class compressor {
      */
     virtual size_t compress_max_size(size_t input_len) const = 0;
 
+    /**
+     * Returns a compressor with the same options as this one, which
+     * compresses and uncompresses using the given dictionary.
+     * Throws if the algorithm has no dictionary support.
+     */
+    virtual shared_ptr<compressor> with_dictionary(bytes_view dict) const;
+    /**
+     * Trains a dictionary of at most dictionary_size() bytes on the given
+     * samples of uncompressed data. Returns std::nullopt if dictionary
+     * compression is disabled or the samples were not good enough.
+     */
+    virtual std::optional<bytes> train_dictionary(const std::vector<bytes_view>& samples) const;
+    /**
+     * Returns the requested size of the per-sstable dictionary,
+     * or 0 if dictionary compression is disabled.
+     */
+    virtual size_t dictionary_size() const;
+
     /**
      * Returns accepted option names for this compressor
      */
@@ -362,11 +362,13 @@ scylla_tests = set([
     'test/boost/allocation_strategy_test',
     'test/boost/alternator_unit_test',
     'test/boost/anchorless_list_test',
+    'test/boost/array_search_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
     'test/boost/auth_test',
     'test/boost/batchlog_manager_test',
     'test/boost/big_decimal_test',
+    'test/boost/bloom_filter_test',
     'test/boost/broken_sstable_test',
     'test/boost/bytes_ostream_test',
     'test/boost/cache_flat_mutation_reader_test',
@@ -414,6 +416,7 @@ scylla_tests = set([
     'test/boost/hash_test',
     'test/boost/hashers_test',
     'test/boost/hint_test',
+    'test/boost/hyperloglog_test',
     'test/boost/idl_test',
     'test/boost/input_stream_test',
     'test/boost/json_cql_query_test',
@@ -444,6 +447,7 @@ scylla_tests = set([
     'test/boost/network_topology_strategy_test',
     'test/boost/nonwrapping_range_test',
     'test/boost/observable_test',
+    'test/boost/partition_trie_test',
     'test/boost/partitioner_test',
     'test/boost/querier_cache_test',
     'test/boost/query_processor_test',
@@ -476,6 +480,7 @@ scylla_tests = set([
     'test/boost/statement_restrictions_test',
     'test/boost/storage_proxy_test',
     'test/boost/top_k_test',
+    'test/boost/tournament_tree_test',
     'test/boost/transport_test',
     'test/boost/types_test',
     'test/boost/user_function_test',
@@ -516,9 +521,11 @@ scylla_tests = set([
     'test/manual/sstable_scan_footprint_test',
     'test/perf/memory_footprint_test',
     'test/perf/perf_cache_eviction',
+    'test/perf/perf_commitlog',
     'test/perf/perf_cql_parser',
     'test/perf/perf_fast_forward',
     'test/perf/perf_hash',
+    'test/perf/perf_messaging',
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_update',
@@ -545,7 +552,9 @@ perf_tests = set([
     'test/perf/perf_mutation_fragment',
     'test/perf/perf_idl',
     'test/perf/perf_vint',
+    'test/perf/perf_radix_tree',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_expr',
 ])
 
 raft_tests = set([
@@ -663,6 +672,7 @@ scylla_core = (['replica/database.cc',
                 'replica/table.cc',
                 'replica/distributed_loader.cc',
                 'replica/memtable.cc',
+                'replica/counter_shard_cache.cc',
                 'absl-flat_hash_map.cc',
                 'atomic_cell.cc',
                 'caching_options.cc',
@@ -685,6 +695,10 @@ scylla_core = (['replica/database.cc',
                 'utils/array-search.cc',
                 'utils/base64.cc',
                 'utils/logalloc.cc',
+                'utils/stall_activity.cc',
+                'utils/dma_buffer_pool.cc',
+                'utils/linux-perf-event.cc',
+                'utils/hardware_counters.cc',
                 'utils/large_bitset.cc',
                 'utils/buffer_input_stream.cc',
                 'utils/limiting_data_source.cc',
@@ -714,12 +728,14 @@ scylla_core = (['replica/database.cc',
                 'sstables/kl/reader.cc',
                 'sstables/sstable_version.cc',
                 'sstables/compress.cc',
+                'sstables/partition_trie.cc',
                 'sstables/sstable_mutation_reader.cc',
                 'compaction/compaction.cc',
                 'compaction/compaction_strategy.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
                 'compaction/leveled_compaction_strategy.cc',
                 'compaction/time_window_compaction_strategy.cc',
+                'compaction/incremental_compaction_strategy.cc',
                 'compaction/compaction_manager.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/prepended_input_stream.cc',
@@ -853,6 +869,7 @@ scylla_core = (['replica/database.cc',
                 'cql3/selection/selector.cc',
                 'cql3/restrictions/statement_restrictions.cc',
                 'cql3/result_set.cc',
+                'cql3/result_cache.cc',
                 'cql3/prepare_context.cc',
                 'db/consistency_level.cc',
                 'db/system_keyspace.cc',
@@ -881,6 +898,7 @@ scylla_core = (['replica/database.cc',
                 'db/view/row_locking.cc',
                 'db/sstables-format-selector.cc',
                 'db/snapshot-ctl.cc',
+                'db/row_cache_saver.cc',
                 'index/secondary_index_manager.cc',
                 'index/secondary_index.cc',
                 'utils/UUID_gen.cc',
@@ -1156,9 +1174,11 @@ deps = {
 
 pure_boost_tests = set([
     'test/boost/anchorless_list_test',
+    'test/boost/array_search_test',
     'test/boost/auth_passwords_test',
     'test/boost/auth_resource_test',
     'test/boost/big_decimal_test',
+    'test/boost/bloom_filter_test',
     'test/boost/caching_options_test',
     'test/boost/cartesian_product_test',
     'test/boost/checksum_utils_test',
@@ -1170,6 +1190,7 @@ pure_boost_tests = set([
     'test/boost/dynamic_bitset_test',
     'test/boost/enum_option_test',
     'test/boost/enum_set_test',
+    'test/boost/hyperloglog_test',
     'test/boost/idl_test',
     'test/boost/json_test',
     'test/boost/keys_test',
@@ -1178,11 +1199,13 @@ pure_boost_tests = set([
     'test/boost/map_difference_test',
     'test/boost/nonwrapping_range_test',
     'test/boost/observable_test',
+    'test/boost/partition_trie_test',
     'test/boost/range_test',
     'test/boost/range_tombstone_list_test',
     'test/boost/serialization_test',
     'test/boost/small_vector_test',
     'test/boost/top_k_test',
+    'test/boost/tournament_tree_test',
     'test/boost/vint_serialization_test',
     'test/boost/bptree_test',
     'test/boost/utf8_test',
@@ -1198,6 +1221,7 @@ tests_not_using_seastar_test_framework = set([
     'test/perf/perf_cache_eviction',
     'test/perf/perf_cql_parser',
     'test/perf/perf_hash',
+    'test/perf/perf_messaging',
     'test/perf/perf_mutation',
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_update',
@@ -1232,7 +1256,7 @@ perf_tests_seastar_deps = [
 
 for t in perf_tests:
     deps[t] = [t + '.cc'] + scylla_tests_dependencies + perf_tests_seastar_deps
-    deps[t] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
+    deps[t] += ['test/perf/perf.cc']
 
 deps['test/boost/sstable_test'] += ['test/lib/normalizing_reader.cc']
 deps['test/boost/sstable_datafile_test'] += ['test/lib/normalizing_reader.cc']
@@ -1244,20 +1268,20 @@ deps['test/boost/bytes_ostream_test'] = [
     "bytes.cc",
     "utils/managed_bytes.cc",
     "utils/logalloc.cc",
+    "utils/stall_activity.cc",
     "utils/dynamic_bitset.cc",
     "test/lib/log.cc",
 ]
 deps['test/boost/input_stream_test'] = ['test/boost/input_stream_test.cc']
 deps['test/boost/UUID_test'] = ['utils/UUID_gen.cc', 'test/boost/UUID_test.cc', 'utils/uuid.cc', 'utils/dynamic_bitset.cc', 'hashers.cc']
 deps['test/boost/murmur_hash_test'] = ['bytes.cc', 'utils/murmur_hash.cc', 'test/boost/murmur_hash_test.cc']
-deps['test/boost/allocation_strategy_test'] = ['test/boost/allocation_strategy_test.cc', 'utils/logalloc.cc', 'utils/dynamic_bitset.cc']
+deps['test/boost/allocation_strategy_test'] = ['test/boost/allocation_strategy_test.cc', 'utils/logalloc.cc', 'utils/stall_activity.cc', 'utils/dynamic_bitset.cc']
 deps['test/boost/log_heap_test'] = ['test/boost/log_heap_test.cc']
 deps['test/boost/estimated_histogram_test'] = ['test/boost/estimated_histogram_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
-deps['test/perf/perf_fast_forward'] += ['test/perf/linux-perf-event.cc']
-deps['test/perf/perf_simple_query'] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc', 'test/lib/alternator_test_env.cc'] + alternator
-deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
-deps['test/perf/perf_row_cache_update'] += ['test/perf/perf.cc', 'test/perf/linux-perf-event.cc']
+deps['test/perf/perf_simple_query'] += ['test/perf/perf.cc', 'test/lib/alternator_test_env.cc'] + alternator
+deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc']
+deps['test/perf/perf_row_cache_update'] += ['test/perf/perf.cc']
 deps['test/boost/reusable_buffer_test'] = [
     "test/boost/reusable_buffer_test.cc",
     "test/lib/log.cc",
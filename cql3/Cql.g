@@ -840,12 +840,14 @@ createIndexStatement returns [std::unique_ptr<create_index_statement> expr]
         bool if_not_exists = false;
         auto name = ::make_shared<cql3::index_name>();
         std::vector<::shared_ptr<index_target::raw>> targets;
+        std::vector<::shared_ptr<cql3::column_identifier::raw>> included_columns;
     }
     : K_CREATE (K_CUSTOM { props->is_custom = true; })? K_INDEX (K_IF K_NOT K_EXISTS { if_not_exists = true; } )?
         (idxName[*name])? K_ON cf=columnFamilyName '(' (target1=indexIdent { targets.emplace_back(target1); } (',' target2=indexIdent { targets.emplace_back(target2); } )*)? ')'
+        (K_INCLUDE '(' c1=cident { included_columns.push_back(c1); } (',' cn=cident { included_columns.push_back(cn); } )* ')')?
         (K_USING cls=STRING_LITERAL { props->custom_class = sstring{$cls.text}; })?
         (K_WITH properties[*props])?
-      { $expr = std::make_unique<create_index_statement>(cf, name, targets, props, if_not_exists); }
+      { $expr = std::make_unique<create_index_statement>(cf, name, targets, std::move(included_columns), props, if_not_exists); }
     ;
 
 indexIdent returns [::shared_ptr<index_target::raw> id]
@@ -1900,6 +1902,7 @@ basic_unreserved_keyword returns [sstring str]
         | K_SERVICE
         | K_LEVEL
         | K_LEVELS
+        | K_INCLUDE
         ) { $str = $k.text; }
     ;
 
@@ -1939,6 +1942,7 @@ K_COLUMNFAMILY:( C O L U M N F A M I L Y
 K_MATERIALIZED:M A T E R I A L I Z E D;
 K_VIEW:        V I E W;
 K_INDEX:       I N D E X;
+K_INCLUDE:     I N C L U D E;
 K_CUSTOM:      C U S T O M;
 K_ON:          O N;
 K_TO:          T O;
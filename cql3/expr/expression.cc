@@ -146,6 +146,15 @@ const column_value& get_subscripted_column(const column_maybe_subscripted& cms)
     }, cms);
 }
 
+/// Returns e's value.  A constant, which is what fold_constants() leaves on the right-hand side of
+/// restrictions, is returned in place; anything else is evaluated into storage.
+static const constant& evaluate_in_place(const expression& e, const query_options& options, std::optional<constant>& storage) {
+    if (auto c = as_if<constant>(&e)) {
+        return *c;
+    }
+    return storage.emplace(evaluate(e, options));
+}
+
 /// Returns col's value from queried data.
 static managed_bytes_opt get_value(const column_maybe_subscripted& col, const column_value_eval_bag& bag) {
     const row_data_from_partition_slice& data = bag.row_data;
@@ -170,7 +179,8 @@ static managed_bytes_opt get_value(const column_maybe_subscripted& col, const co
             }
             const auto deserialized = cdef->type->deserialize(managed_bytes_view(*data.other_columns[index]));
             const auto& data_map = value_cast<map_type_impl::native_type>(deserialized);
-            const auto key = evaluate(s->sub, options);
+            std::optional<constant> storage;
+            const constant& key = evaluate_in_place(s->sub, options, storage);
             auto&& key_type = col_type->name_comparator();
             const auto found = key.view().with_linearized([&] (bytes_view key_bv) {
                 using entry = std::pair<data_value, data_value>;
@@ -201,26 +211,41 @@ const abstract_type* get_value_comparator(const column_maybe_subscripted& col) {
     }, col);
 }
 
+/// The bytes of a constant which is neither null nor unset.
+static managed_bytes_view value_view(const constant& c) {
+    return c.view().with_value(overloaded_functor{
+        [] (const managed_bytes_view& v) { return v; },
+        [] (const fragmented_temporary_buffer::view&) -> managed_bytes_view {
+            on_internal_error(expr_logger, "value_view: a constant refers to a request buffer");
+        },
+    });
+}
+
 /// True iff lhs's value equals rhs.
-bool equal(const managed_bytes_opt& rhs, const column_maybe_subscripted& lhs, const column_value_eval_bag& bag) {
-    if (!rhs) {
-        return false;
-    }
+bool equal(managed_bytes_view rhs, const column_maybe_subscripted& lhs, const column_value_eval_bag& bag) {
     const auto value = get_value(lhs, bag);
     if (!value) {
         return false;
     }
-    return get_value_comparator(lhs)->equal(managed_bytes_view(*value), managed_bytes_view(*rhs));
+    return get_value_comparator(lhs)->equal(managed_bytes_view(*value), rhs);
+}
+
+/// True iff lhs's value equals rhs.
+bool equal(const managed_bytes_opt& rhs, const column_maybe_subscripted& lhs, const column_value_eval_bag& bag) {
+    return rhs && equal(managed_bytes_view(*rhs), lhs, bag);
 }
 
 /// Convenience overload for expression.
 bool equal(const expression& rhs, const column_maybe_subscripted& lhs, const column_value_eval_bag& bag) {
-    return equal(evaluate(rhs, bag.options).value.to_managed_bytes_opt(), lhs, bag);
+    std::optional<constant> storage;
+    const constant& c = evaluate_in_place(rhs, bag.options, storage);
+    return !c.is_null_or_unset() && equal(value_view(c), lhs, bag);
 }
 
 /// True iff columns' values equal t.
 bool equal(const expression& t, const tuple_constructor& columns_tuple, const column_value_eval_bag& bag) {
-    const constant tup = evaluate(t, bag.options);
+    std::optional<constant> storage;
+    const constant& tup = evaluate_in_place(t, bag.options, storage);
     if (!tup.type->is_tuple()) {
         throw exceptions::invalid_request_exception("multi-column equality has right-hand side that isn't a tuple");
     }
@@ -266,8 +291,9 @@ bool limits(const column_maybe_subscripted& col, oper_t op, const expression& rh
     if (!lhs) {
         return false;
     }
-    const auto b = evaluate(rhs, bag.options).value.to_managed_bytes_opt();
-    return b ? limits(*lhs, op, *b, *get_value_comparator(col)) : false;
+    std::optional<constant> storage;
+    const constant& c = evaluate_in_place(rhs, bag.options, storage);
+    return !c.is_null_or_unset() && limits(*lhs, op, value_view(c), *get_value_comparator(col));
 }
 
 /// True iff the column values are limited by t in the manner prescribed by op.
@@ -276,7 +302,8 @@ bool limits(const tuple_constructor& columns_tuple, const oper_t op, const expre
     if (!is_slice(op)) { // For EQ or NEQ, use equal().
         throw std::logic_error("limits() called on non-slice op");
     }
-    const constant tup = evaluate(e, bag.options);
+    std::optional<constant> storage;
+    const constant& tup = evaluate_in_place(e, bag.options, storage);
     if (!tup.type->is_tuple()) {
         throw exceptions::invalid_request_exception(
                 "multi-column comparison has right-hand side that isn't a tuple");
@@ -438,7 +465,8 @@ bool like(const column_value& cv, const raw_value_view& pattern, const column_va
 
 /// True iff the column value is in the set defined by rhs.
 bool is_one_of(const column_maybe_subscripted& col, const expression& rhs, const column_value_eval_bag& bag) {
-    const constant in_list = evaluate_IN_list(rhs, bag.options);
+    std::optional<constant> storage;
+    const constant& in_list = is<constant>(rhs) ? as<constant>(rhs) : storage.emplace(evaluate_IN_list(rhs, bag.options));
     const column_definition* cdef = get_subscripted_column(col).col;
     statements::request_validations::check_false(
             in_list.is_null(), "Invalid null value for column {}", cdef->name_as_text());
@@ -453,7 +481,8 @@ bool is_one_of(const column_maybe_subscripted& col, const expression& rhs, const
 
 /// True iff the tuple of column values is in the set defined by rhs.
 bool is_one_of(const tuple_constructor& tuple, const expression& rhs, const column_value_eval_bag& bag) {
-    constant in_list = evaluate_IN_list(rhs, bag.options);
+    std::optional<constant> storage;
+    const constant& in_list = is<constant>(rhs) ? as<constant>(rhs) : storage.emplace(evaluate_IN_list(rhs, bag.options));
     if (!in_list.type->without_reversed().is_list()) {
         throw std::logic_error("unexpected expression type in is_one_of(multi-column)");
     }
@@ -505,14 +534,14 @@ bool is_satisfied_by(const binary_operator& opr, const column_value_eval_bag& ba
                 } else if (is_slice(opr.op)) {
                     return limits(&col, opr.op, opr.rhs, bag);
                 } else if (opr.op == oper_t::CONTAINS) {
-                    constant val = evaluate(opr.rhs, bag.options);
-                    return contains(col, val.view(), bag);
+                    std::optional<constant> storage;
+                    return contains(col, evaluate_in_place(opr.rhs, bag.options, storage).view(), bag);
                 } else if (opr.op == oper_t::CONTAINS_KEY) {
-                    constant val = evaluate(opr.rhs, bag.options);
-                    return contains_key(col, val.view(), bag);
+                    std::optional<constant> storage;
+                    return contains_key(col, evaluate_in_place(opr.rhs, bag.options, storage).view(), bag);
                 } else if (opr.op == oper_t::LIKE) {
-                    constant val = evaluate(opr.rhs, bag.options);
-                    return like(col, val.view(), bag);
+                    std::optional<constant> storage;
+                    return like(col, evaluate_in_place(opr.rhs, bag.options, storage).view(), bag);
                 } else if (opr.op == oper_t::IN) {
                     return is_one_of(&col, opr.rhs, bag);
                 } else {
@@ -659,12 +688,18 @@ bool is_satisfied_by(const expression& restr, const column_value_eval_bag& bag)
         }, restr);
 }
 
+/// Sorts values and removes duplicates, in place.
+static value_list to_sorted_vector(value_list values, const serialized_compare& comparator) {
+    boost::sort(values, comparator);
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
 template<typename Range>
 value_list to_sorted_vector(Range r, const serialized_compare& comparator) {
     BOOST_CONCEPT_ASSERT((boost::ForwardRangeConcept<Range>));
-    value_list tmp(r.begin(), r.end()); // Need random-access range to sort (r is not necessarily random-access).
-    const auto unique = boost::unique(boost::sort(tmp, comparator));
-    return value_list(unique.begin(), unique.end());
+    // Need random-access range to sort (r is not necessarily random-access).
+    return to_sorted_vector(value_list(r.begin(), r.end()), comparator);
 }
 
 const auto non_null = boost::adaptors::filtered([] (const managed_bytes_opt& b) { return b.has_value(); });
@@ -683,8 +718,9 @@ value_list get_IN_values(
     if (!in_list.type->without_reversed().is_list()) {
         throw std::logic_error(format("get_IN_values(single-column) on invalid expression {}", e));
     }
+    // get_list_elements() returns no nulls, so the elements can be moved into the result as they are.
     utils::chunked_vector<managed_bytes> list_elems = get_list_elements(in_list);
-    return to_sorted_vector(std::move(list_elems) | non_null | deref, comparator);
+    return to_sorted_vector(value_list(std::make_move_iterator(list_elems.begin()), std::make_move_iterator(list_elems.end())), comparator);
 }
 
 /// Returns possible values for k-th column from t, which must be RHS of IN.
@@ -737,8 +773,63 @@ bool is_satisfied_by(
         const query::result_row_view& static_row, const query::result_row_view* row,
         const selection& selection, const query_options& options) {
     const auto regulars = get_non_pk_values(selection, static_row, row);
+    return is_satisfied_by(restr, partition_key, clustering_key, regulars, selection, options);
+}
+
+bool is_satisfied_by(
+        const expression& restr,
+        const std::vector<bytes>& partition_key, const std::vector<bytes>& clustering_key,
+        const std::vector<managed_bytes_opt>& non_pk_values,
+        const selection& selection, const query_options& options) {
     return is_satisfied_by(
-            restr, {options, row_data_from_partition_slice{partition_key, clustering_key, regulars, selection}});
+            restr, {options, row_data_from_partition_slice{partition_key, clustering_key, non_pk_values, selection}});
+}
+
+/// True iff e can be evaluated without a row, to the same value every time.
+static bool is_row_independent(const expression& e) {
+    return expr::visit(overloaded_functor{
+            [] (const constant&) { return true; },
+            [] (const null&) { return true; },
+            [] (const bind_variable&) { return true; },
+            [] (const tuple_constructor& tc) {
+                return boost::algorithm::all_of(tc.elements, is_row_independent);
+            },
+            [] (const collection_constructor& c) {
+                return boost::algorithm::all_of(c.elements, is_row_independent);
+            },
+            [] (const usertype_constructor& uc) {
+                return boost::algorithm::all_of(uc.elements | boost::adaptors::map_values, is_row_independent);
+            },
+            [] (const function_call& fc) {
+                auto fun = std::get_if<::shared_ptr<functions::function>>(&fc.func);
+                return fun && (*fun)->is_pure() && boost::algorithm::all_of(fc.args, is_row_independent);
+            },
+            [] (const auto&) { return false; },
+        }, e);
+}
+
+expression fold_constants(const expression& restr, const query_options& options) {
+    auto fold = [&] (const expression& e, bool in_list) -> expression {
+        if (is<constant>(e) || !is_row_independent(e)) {
+            return e;
+        }
+        try {
+            return in_list ? evaluate_IN_list(e, options) : evaluate(e, options);
+        } catch (...) {
+            return e;
+        }
+    };
+    return search_and_replace(restr, [&] (const expression& e) -> std::optional<expression> {
+        auto binop = as_if<binary_operator>(&e);
+        if (!binop) {
+            return std::nullopt;
+        }
+        expression lhs = binop->lhs;
+        if (auto sub = as_if<subscript>(&binop->lhs)) {
+            lhs = subscript{.val = sub->val, .sub = fold(sub->sub, false)};
+        }
+        return binary_operator(std::move(lhs), binop->op, fold(binop->rhs, binop->op == oper_t::IN), binop->order);
+    });
 }
 
 template<typename T>
@@ -431,6 +431,24 @@ extern bool is_satisfied_by(
         const query::result_row_view& static_row, const query::result_row_view* row,
         const selection::selection&, const query_options&);
 
+/// Returns the values of the selection's non-primary-key columns in a row, in selection order.
+extern std::vector<managed_bytes_opt> get_non_pk_values(
+        const selection::selection&, const query::result_row_view& static_row, const query::result_row_view* row);
+
+/// Like is_satisfied_by() above, with the row's non-primary-key values already extracted by
+/// get_non_pk_values(), so that several restrictions can be checked against a row extracting them once.
+extern bool is_satisfied_by(
+        const expression& restr,
+        const std::vector<bytes>& partition_key, const std::vector<bytes>& clustering_key,
+        const std::vector<managed_bytes_opt>& non_pk_values,
+        const selection::selection&, const query_options&);
+
+/// Replaces the parts of restr which don't depend on the row - bind variables, constructors of them
+/// and calls of pure functions on them - with their values under options. is_satisfied_by() then uses
+/// the values in place, instead of evaluating them again for every row it is called on.
+/// Parts which fail to evaluate are left alone, so the error is reported when a row is checked.
+extern expression fold_constants(const expression& restr, const query_options& options);
+
 /// A set of discrete values.
 using value_list = std::vector<managed_bytes>; // Sorted and deduped using value comparator.
 
@@ -172,7 +172,12 @@ shared_ptr<function>
 make_to_json_function(data_type t) {
     return make_native_scalar_function<true>("tojson", utf8_type, {t},
             [t](cql_serialization_format sf, const std::vector<bytes_opt>& parameters) -> bytes_opt {
-        return utf8_type->decompose(to_json_string(*t, parameters[0]));
+        if (!parameters[0]) {
+            return utf8_type->decompose(sstring("null"));
+        }
+        std::string json;
+        write_json_string(*t, bytes_view(*parameters[0]), json);
+        return bytes(reinterpret_cast<const int8_t*>(json.data()), json.size());
     });
 }
 
@@ -52,7 +52,7 @@ bytes_opt user_function::execute(cql_serialization_format sf, const std::vector<
                 }
                 values.push_back(bytes ? type->deserialize(*bytes) : data_value::make_null(type));
             }
-            return lua::run_script(lua::bitcode_view{ctx.bitcode}, values, return_type(), ctx.cfg).get0();
+            return lua::run_script(lua::bitcode_view{ctx.bitcode}, values, return_type(), ctx.cfg, ctx.states).get0();
         },
         [&] (wasm::context& ctx) {
             try {
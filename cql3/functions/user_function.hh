@@ -31,6 +31,7 @@ class user_function final : public abstract_function, public scalar_function {
         // lua_runtime in a thread_local variable, but that is one extra
         // global.
         lua::runtime_config cfg;
+        lua::state_cache states;
     };
 
     using context = std::variant<lua_context, wasm::context>;
@@ -20,11 +20,13 @@
 #include "cql3/error_collector.hh"
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "cql3/util.hh"
 #include "cql3/untyped_result_set.hh"
 #include "db/config.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include "hashers.hh"
+#include "utils/stall_activity.hh"
 
 namespace cql3 {
 
@@ -34,6 +36,7 @@ using namespace cql_transport::messages;
 logging::logger log("query_processor");
 logging::logger prep_cache_log("prepared_statements_cache");
 logging::logger authorized_prepared_statements_cache_log("authorized_prepared_statements_cache");
+logging::logger unprep_cache_log("unprepared_statements_cache");
 
 const sstring query_processor::CQL_VERSION = "3.3.1";
 
@@ -71,7 +74,9 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
         , _authorized_prepared_cache(std::min(std::chrono::milliseconds(_db.get_config().permissions_validity_in_ms()),
                                               std::chrono::duration_cast<std::chrono::milliseconds>(prepared_statements_cache::entry_expiry)),
                                      std::chrono::milliseconds(_db.get_config().permissions_update_interval_in_ms()),
-                                     mcfg.authorized_prepared_cache_size, authorized_prepared_statements_cache_log) {
+                                     mcfg.authorized_prepared_cache_size, authorized_prepared_statements_cache_log)
+        , _unprepared_cache(unprep_cache_log, mcfg.unprepared_cache_size)
+        , _result_cache(mcfg.result_cache_size) {
     namespace sm = seastar::metrics;
     namespace stm = statements;
     using clevel = db::consistency_level;
@@ -337,6 +342,26 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
                             [this] { return _prepared_cache.memory_footprint(); },
                             sm::description("Size (in bytes) of the prepared statements cache.")),
 
+                    sm::make_derive(
+                            "unprepared_cache_hits",
+                            _stats.unprepared_cache_hits,
+                            sm::description("Counts unprepared statements which were found in the unprepared statements cache and weren't parsed again.")),
+
+                    sm::make_derive(
+                            "unprepared_cache_misses",
+                            _stats.unprepared_cache_misses,
+                            sm::description("Counts unprepared statements which weren't found in the unprepared statements cache and had to be parsed.")),
+
+                    sm::make_gauge(
+                            "unprepared_cache_size",
+                            [this] { return _unprepared_cache.size(); },
+                            sm::description("A number of entries in the unprepared statements cache.")),
+
+                    sm::make_gauge(
+                            "unprepared_cache_memory_footprint",
+                            [this] { return _unprepared_cache.memory_footprint(); },
+                            sm::description("Size (in bytes) of the unprepared statements cache.")),
+
                     sm::make_derive(
                             "secondary_index_creates",
                             _cql_stats.secondary_index_creates,
@@ -457,24 +482,75 @@ query_processor::~query_processor() {
 
 future<> query_processor::stop() {
     return _mnotifier.unregister_listener(_migration_subscriber.get()).then([this] {
-        return _authorized_prepared_cache.stop().finally([this] { return _prepared_cache.stop(); });
+        return _authorized_prepared_cache.stop().finally([this] {
+            return _unprepared_cache.stop();
+        }).finally([this] {
+            return _prepared_cache.stop();
+        });
+    });
+}
+
+future<> query_processor::invalidate_cached_results(std::vector<result_cache::partition_id> partitions) {
+    if (partitions.empty()) {
+        return make_ready_future<>();
+    }
+    return do_with(std::move(partitions), [this] (std::vector<result_cache::partition_id>& partitions) {
+        return parallel_for_each(partitions, [this] (const result_cache::partition_id& id) {
+            if (id.shard == this_shard_id()) {
+                _result_cache.invalidate(id);
+                return make_ready_future<>();
+            }
+            return container().invoke_on(id.shard, [id] (query_processor& qp) {
+                qp._result_cache.invalidate(id);
+            });
+        });
     });
 }
 
 future<::shared_ptr<result_message>>
 query_processor::execute_direct_without_checking_exception_message(const sstring_view& query_string, service::query_state& query_state, query_options& options) {
     log.trace("execute_direct: \"{}\"", query_string);
+    auto key = compute_id(query_string, query_state.get_client_state().get_raw_keyspace());
+    if (auto cached = _unprepared_cache.find(key)) {
+        ++_stats.unprepared_cache_hits;
+        tracing::trace(query_state.get_trace_state(), "Using a cached statement");
+        return execute_direct_statement(cached->statement, cached->bound_names, cached->warnings, query_state, options);
+    }
+    ++_stats.unprepared_cache_misses;
     tracing::trace(query_state.get_trace_state(), "Parsing a statement");
     auto p = get_statement(query_string, query_state.get_client_state());
-    auto cql_statement = p->statement;
-    const auto warnings = std::move(p->warnings);
+    if (!is_cacheable_unprepared(*p->statement)) {
+        return execute_direct_statement(p->statement, p->bound_names, std::move(p->warnings), query_state, options);
+    }
+    auto f = execute_direct_statement(p->statement, p->bound_names, p->warnings, query_state, options);
+    // The loader is invoked synchronously, so capturing the statement by reference is safe. If another
+    // fiber is already loading the same key, the loader isn't called and the statement is dropped.
+    return _unprepared_cache.get(key, [&p] {
+        return make_ready_future<std::unique_ptr<statements::prepared_statement>>(std::move(p));
+    }).then_wrapped([f = std::move(f)] (future<prepared_statements_cache::value_type> cached) mutable {
+        if (cached.failed()) {
+            unprep_cache_log.debug("failed to cache the statement: {}", cached.get_exception());
+        } else {
+            cached.ignore_ready_future();
+        }
+        return std::move(f);
+    });
+}
+
+future<::shared_ptr<result_message>>
+query_processor::execute_direct_statement(
+        ::shared_ptr<cql_statement> cql_statement,
+        const std::vector<lw_shared_ptr<column_specification>>& bound_names,
+        std::vector<sstring> warnings,
+        service::query_state& query_state,
+        query_options& options) {
     if (cql_statement->get_bound_terms() != options.get_values_count()) {
         const auto msg = format("Invalid amount of bind variables: expected {:d} received {:d}",
                 cql_statement->get_bound_terms(),
                 options.get_values_count());
         throw exceptions::invalid_request_exception(msg);
     }
-    options.prepare(p->bound_names);
+    options.prepare(bound_names);
 
     warn(unimplemented::cause::METRICS);
 #if 0
@@ -494,6 +570,12 @@ query_processor::execute_direct_without_checking_exception_message(const sstring
     });
 }
 
+bool query_processor::is_cacheable_unprepared(const cql_statement& statement) {
+    return dynamic_cast<const statements::select_statement*>(&statement)
+            || dynamic_cast<const statements::modification_statement*>(&statement)
+            || dynamic_cast<const statements::batch_statement*>(&statement);
+}
+
 future<::shared_ptr<result_message>>
 query_processor::execute_prepared_without_checking_exception_message(
         statements::prepared_statement::checked_weak_ptr prepared,
@@ -526,7 +608,11 @@ query_processor::process_authorized_statement(const ::shared_ptr<cql_statement>
 
     statement->validate(*this, client_state);
 
-    auto fut = statement->execute_without_checking_exception_message(*this, query_state, options);
+    auto fut = [&] {
+        // Only the part of the execution which runs before its first suspension.
+        utils::stall_activity_scope activity(utils::stall_activity::cql_execute);
+        return statement->execute_without_checking_exception_message(*this, query_state, options);
+    }();
 
     return fut.then([statement] (auto msg) {
         if (msg) {
@@ -583,7 +669,10 @@ prepared_cache_key_type query_processor::compute_thrift_id(
 
 std::unique_ptr<prepared_statement>
 query_processor::get_statement(const sstring_view& query, const service::client_state& client_state) {
-    std::unique_ptr<raw::parsed_statement> statement = parse_statement(query);
+    std::unique_ptr<raw::parsed_statement> statement = [&] {
+        utils::stall_activity_scope activity(utils::stall_activity::cql_parse);
+        return parse_statement(query);
+    }();
 
     // Set keyspace for statement that require login
     auto cf_stmt = dynamic_cast<raw::cf_statement*>(statement.get());
@@ -591,6 +680,7 @@ query_processor::get_statement(const sstring_view& query, const service::client_
         cf_stmt->prepare_keyspace(client_state);
     }
     ++_stats.prepare_invocations;
+    utils::stall_activity_scope activity(utils::stall_activity::cql_prepare);
     auto p = statement->prepare(_db, _cql_stats);
     p->statement->raw_cql_statement = sstring(query);
     return p;
@@ -953,6 +1043,9 @@ void query_processor::migration_subscriber::remove_invalid_prepared_statements(
     _qp->_prepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
         return this->should_invalidate(ks_name, cf_name, stmt);
     });
+    _qp->_unprepared_cache.remove_if([&] (::shared_ptr<cql_statement> stmt) {
+        return this->should_invalidate(ks_name, cf_name, stmt);
+    });
 }
 
 bool query_processor::migration_subscriber::should_invalidate(
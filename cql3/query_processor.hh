@@ -22,6 +22,7 @@
 
 #include "cql3/prepared_statements_cache.hh"
 #include "cql3/authorized_prepared_statements_cache.hh"
+#include "cql3/result_cache.hh"
 #include "cql3/statements/prepared_statement.hh"
 #include "exceptions/exceptions.hh"
 #include "service/migration_listener.hh"
@@ -87,6 +88,8 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     struct memory_config {
         size_t prepared_statment_cache_size = 0;
         size_t authorized_prepared_cache_size = 0;
+        size_t result_cache_size = 0;
+        size_t unprepared_cache_size = 0;
     };
 
 private:
@@ -100,6 +103,8 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     struct stats {
         uint64_t prepare_invocations = 0;
+        uint64_t unprepared_cache_hits = 0;
+        uint64_t unprepared_cache_misses = 0;
         uint64_t queries_by_cl[size_t(db::consistency_level::MAX_VALUE) + 1] = {};
     } _stats;
 
@@ -112,6 +117,10 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     prepared_statements_cache _prepared_cache;
     authorized_prepared_statements_cache _authorized_prepared_cache;
+    // Statements executed without being prepared, keyed like _prepared_cache. Kept apart
+    // from it so that one-off queries don't evict the statements clients prepared.
+    prepared_statements_cache _unprepared_cache;
+    result_cache _result_cache;
 
     // A map for prepared statements used internally (which we don't want to mix with user statement, in particular we
     // don't bother with expiration on those.
@@ -158,6 +167,13 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _cql_stats;
     }
 
+    result_cache& get_result_cache() noexcept {
+        return _result_cache;
+    }
+
+    // Drops the cached results of the partitions, on the shards owning them.
+    future<> invalidate_cached_results(std::vector<result_cache::partition_id> partitions);
+
     statements::prepared_statement::checked_weak_ptr get_prepared(const std::optional<auth::authenticated_user>& user, const prepared_cache_key_type& key) {
         if (user) {
             auto vp = _authorized_prepared_cache.find(*user, key);
@@ -372,6 +388,18 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     future<::shared_ptr<cql_transport::messages::result_message>>
     process_authorized_statement(const ::shared_ptr<cql_statement> statement, service::query_state& query_state, const query_options& options);
 
+    future<::shared_ptr<cql_transport::messages::result_message>>
+    execute_direct_statement(
+            ::shared_ptr<cql_statement> statement,
+            const std::vector<lw_shared_ptr<column_specification>>& bound_names,
+            std::vector<sstring> warnings,
+            service::query_state& query_state,
+            query_options& options);
+
+    // Only statements which read or write data are worth caching: schema changes, USE and
+    // the like are rare, and some of them depend on state that changes under them.
+    static bool is_cacheable_unprepared(const cql_statement& statement);
+
     /*!
      * \brief created a state object for paging
      *
@@ -807,8 +807,19 @@ dht::partition_range_vector partition_ranges_from_singles(
         }
     }
     cartesian_product cp(column_values);
-    dht::partition_range_vector ranges(product_size);
-    std::transform(cp.begin(), cp.end(), ranges.begin(), std::bind_front(range_from_bytes, std::ref(schema)));
+    std::vector<partition_key> keys;
+    keys.reserve(product_size);
+    std::transform(cp.begin(), cp.end(), std::back_inserter(keys), [] (const std::vector<managed_bytes>& pk) {
+        return partition_key::from_exploded(pk);
+    });
+    // Large IN lists are hashed in bulk.
+    std::vector<dht::token> tokens(keys.size());
+    schema.get_partitioner().get_tokens(schema, keys, tokens);
+    dht::partition_range_vector ranges;
+    ranges.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ranges.push_back(dht::partition_range::make_singular(query::ring_position(std::move(tokens[i]), std::move(keys[i]))));
+    }
     return ranges;
 }
 
@@ -1111,7 +1122,8 @@ struct multi_column_range_accumulator {
         if (ranges.empty()) {
             return; // Shortcircuit an easy case.
         }
-        std::set<query::clustering_range, range_less> new_ranges(range_less{*schema});
+        std::vector<query::clustering_range> new_ranges;
+        new_ranges.reserve(in_values.size() * ranges.size());
         for (const auto& current_tuple : in_values) {
             // Each IN value is like a separate EQ restriction ANDed to the existing state.
             auto current_range = to_range(
@@ -1119,11 +1131,17 @@ struct multi_column_range_accumulator {
             for (const auto& r : ranges) {
                 auto intrs = intersection(r, current_range, prefix3cmp);
                 if (intrs) {
-                    new_ranges.insert(*intrs);
+                    new_ranges.push_back(std::move(*intrs));
                 }
             }
         }
-        ranges.assign(new_ranges.cbegin(), new_ranges.cend());
+        // Sorted and deduplicated in one vector, keeping the first of ranges with the same start.
+        const range_less less{*schema};
+        std::stable_sort(new_ranges.begin(), new_ranges.end(), less);
+        new_ranges.erase(std::unique(new_ranges.begin(), new_ranges.end(), [&] (const query::clustering_range& a, const query::clustering_range& b) {
+            return !less(a, b) && !less(b, a);
+        }), new_ranges.end());
+        ranges = std::move(new_ranges);
     }
 };
 
@@ -1164,6 +1182,11 @@ std::vector<query::clustering_range> get_single_column_clustering_bounds(
             if (list->empty()) { // Impossible condition -- no rows can possibly match.
                 return {};
             }
+            // possible_lhs_values() sorts by the unreversed type. Put the values in clustering order, so that
+            // the Cartesian product below comes out sorted by range_less without sorting it again.
+            if (schema.clustering_column_at(i).type->is_reversed()) {
+                std::reverse(list->begin(), list->end());
+            }
             product_size *= list->size();
             prior_column_values.push_back(std::move(*list));
             error_if_exceeds(product_size, size_limit);
@@ -1200,7 +1223,7 @@ std::vector<query::clustering_range> get_single_column_clustering_bounds(
                     ck_ranges.push_back(reverse_if_reqd({new_start, new_end}, *schema.clustering_column_at(i).type));
                 }
             }
-            sort(ck_ranges.begin(), ck_ranges.end(), range_less{schema});
+            // Already sorted: the ranges are disjoint, and ordered by their prefixes from the Cartesian product.
             return ck_ranges;
         }
     }
@@ -1209,7 +1232,7 @@ std::vector<query::clustering_range> get_single_column_clustering_bounds(
     std::vector<query::clustering_range> ck_ranges(product_size);
     cartesian_product cp(prior_column_values);
     std::transform(cp.begin(), cp.end(), ck_ranges.begin(), std::bind_front(query::clustering_range::make_singular));
-    sort(ck_ranges.begin(), ck_ranges.end(), range_less{schema});
+    // Already sorted, as the Cartesian product of per-column values in clustering order is.
     return ck_ranges;
 }
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/metrics.hh>
+
+#include "cql3/result_cache.hh"
+#include "dht/i_partitioner.hh"
+#include "mutation.hh"
+#include "query-result.hh"
+#include "schema.hh"
+#include "utils/hash.hh"
+
+namespace cql3 {
+
+result_cache::partition_id::partition_id(const schema& s, const dht::decorated_key& dk)
+    : table(s.id())
+    , token(dk.token())
+    , key(to_bytes(dk.key().representation()))
+    , shard(dht::shard_of(s, dk.token()))
+{ }
+
+size_t result_cache::partition_id_hash::operator()(const partition_id& id) const noexcept {
+    return utils::hash_combine(std::hash<utils::UUID>()(id.table), std::hash<dht::token>()(id.token));
+}
+
+size_t result_cache::key_hash::operator()(const key& k) const noexcept {
+    auto h = utils::hash_combine(std::hash<sstring>()(k.statement), std::hash<bytes_view>()(k.values));
+    return utils::hash_combine(h, size_t(k.cl));
+}
+
+result_cache::result_cache(size_t capacity)
+    : _capacity(capacity)
+{
+    namespace sm = seastar::metrics;
+    _metrics.add_group("cql", {
+        sm::make_gauge("result_cache_entries", [this] { return _entries; },
+                sm::description("Number of results of SELECTs cached on the coordinator.")),
+        sm::make_gauge("result_cache_bytes", [this] { return _memory; },
+                sm::description("Memory taken by the results of SELECTs cached on the coordinator.")),
+        sm::make_counter("result_cache_evictions", _stats.evictions,
+                sm::description("Counts results evicted from the coordinator result cache to make room for new ones.")),
+        sm::make_counter("result_cache_invalidations", _stats.invalidations,
+                sm::description("Counts results dropped from the coordinator result cache by writes to their partitions.")),
+    });
+}
+
+result_cache::~result_cache() {
+    _lru.clear();
+}
+
+void result_cache::erase(entry& e) noexcept {
+    _memory -= e.size;
+    --_entries;
+    auto& p = *e.owner;
+    p.entries.erase(p.entries.find(*e.k));
+    if (p.entries.empty()) {
+        _partitions.erase(_partitions.find(*p.id));
+    }
+}
+
+lw_shared_ptr<query::result> result_cache::find(const partition_id& id, const key& k) {
+    auto p = _partitions.find(id);
+    if (p == _partitions.end()) {
+        return nullptr;
+    }
+    auto e = p->second.entries.find(k);
+    if (e == p->second.entries.end()) {
+        return nullptr;
+    }
+    if (e->second.expires <= clock::now()) {
+        erase(e->second);
+        return nullptr;
+    }
+    e->second.lru_link.unlink();
+    _lru.push_front(e->second);
+    return e->second.result;
+}
+
+uint64_t result_cache::generation(const utils::UUID& table) const noexcept {
+    auto it = _generations.find(table);
+    return it == _generations.end() ? 0 : it->second;
+}
+
+void result_cache::insert(partition_id id, key k, lw_shared_ptr<query::result> result, clock::duration ttl, uint64_t generation) {
+    if (generation != this->generation(id.table)) {
+        return;
+    }
+    auto size = sizeof(entry) + result->buf().size() + id.key.size() + k.statement.size() + k.values.size();
+    if (size > _capacity / max_entry_fraction) {
+        return;
+    }
+    while (_memory + size > _capacity && !_lru.empty()) {
+        erase(_lru.back());
+        ++_stats.evictions;
+    }
+
+    auto [p, p_inserted] = _partitions.try_emplace(std::move(id));
+    if (p_inserted) {
+        p->second.id = &p->first;
+    }
+    auto [e, e_inserted] = p->second.entries.try_emplace(std::move(k));
+    if (!e_inserted) {
+        _memory -= e->second.size;
+        --_entries;
+        e->second.lru_link.unlink();
+    }
+    e->second.result = std::move(result);
+    e->second.expires = clock::now() + ttl;
+    e->second.size = size;
+    e->second.owner = &p->second;
+    e->second.k = &e->first;
+    _lru.push_front(e->second);
+    _memory += size;
+    ++_entries;
+}
+
+void result_cache::invalidate(const partition_id& id) {
+    ++_generations[id.table];
+    auto p = _partitions.find(id);
+    if (p == _partitions.end()) {
+        return;
+    }
+    for (auto& [k, e] : p->second.entries) {
+        _memory -= e.size;
+        --_entries;
+        ++_stats.invalidations;
+    }
+    _partitions.erase(p);
+}
+
+std::vector<result_cache::partition_id> result_cache::cached_partitions(const std::vector<mutation>& mutations) {
+    std::vector<partition_id> ret;
+    for (auto& m : mutations) {
+        if (m.schema()->caching_options().result_cache_ttl().count()) {
+            ret.emplace_back(*m.schema(), m.decorated_key());
+        }
+    }
+    return ret;
+}
+
+std::vector<result_cache::partition_id> result_cache::cached_partitions(const schema& s, const dht::decorated_key& dk) {
+    std::vector<partition_id> ret;
+    if (s.caching_options().result_cache_ttl().count()) {
+        ret.emplace_back(s, dk);
+    }
+    return ret;
+}
+
+}
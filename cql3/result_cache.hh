@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <boost/intrusive/list.hpp>
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sstring.hh>
+
+#include "bytes.hh"
+#include "db/consistency_level_type.hh"
+#include "dht/token.hh"
+#include "schema_fwd.hh"
+#include "seastarx.hh"
+#include "utils/UUID.hh"
+
+class mutation;
+
+namespace dht {
+class decorated_key;
+}
+
+namespace query {
+class result;
+}
+
+namespace cql3 {
+
+// Keeps the results of single-partition SELECTs on the coordinator, for the
+// tables whose caching options set a result_cache_ttl_in_ms. A hit saves the
+// whole read, replicas included, at the cost of returning results up to the
+// TTL old. Writes coordinated by this node drop the cached results of the
+// partitions they modify, on the shard owning the partition, which is the
+// only shard caching them.
+//
+// Results are the query::result of the read, before selection, so they are
+// stored once per statement, bound values and consistency level, and turned
+// into rows for each hit.
+class result_cache {
+public:
+    using clock = seastar::lowres_clock;
+
+    struct partition_id {
+        utils::UUID table;
+        dht::token token;
+        bytes key;
+        // The shard owning the partition, the only one caching its results.
+        unsigned shard;
+
+        partition_id(const schema& s, const dht::decorated_key& dk);
+        bool operator==(const partition_id&) const = default;
+    };
+
+    // Identifies the result of a read of a partition. The text of the
+    // statement stands for the prepared statement, whose id is a hash of it
+    // and its keyspace.
+    struct key {
+        utils::UUID schema_version;
+        sstring statement;
+        bytes values;
+        db::consistency_level cl;
+
+        bool operator==(const key&) const = default;
+    };
+
+    struct stats {
+        uint64_t evictions = 0;
+        uint64_t invalidations = 0;
+    };
+private:
+    struct partition_id_hash {
+        size_t operator()(const partition_id&) const noexcept;
+    };
+    struct key_hash {
+        size_t operator()(const key&) const noexcept;
+    };
+    struct partition;
+    using lru_link_type = boost::intrusive::list_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+    struct entry {
+        lru_link_type lru_link;
+        lw_shared_ptr<query::result> result;
+        clock::time_point expires;
+        size_t size;
+        partition* owner;
+        const key* k;
+    };
+    using lru_type = boost::intrusive::list<entry,
+        boost::intrusive::member_hook<entry, lru_link_type, &entry::lru_link>,
+        boost::intrusive::constant_time_size<false>>;
+    struct partition {
+        const partition_id* id;
+        std::unordered_map<key, entry, key_hash> entries;
+    };
+
+    size_t _capacity;
+    size_t _memory = 0;
+    size_t _entries = 0;
+    std::unordered_map<partition_id, partition, partition_id_hash> _partitions;
+    lru_type _lru;
+    // Bumped by every invalidation of a table, so that reads which ran
+    // concurrently with a write don't insert results from before it.
+    std::unordered_map<utils::UUID, uint64_t> _generations;
+    stats _stats;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void erase(entry&) noexcept;
+public:
+    // Results larger than the capacity divided by this aren't cached.
+    static constexpr size_t max_entry_fraction = 64;
+
+    explicit result_cache(size_t capacity);
+    ~result_cache();
+
+    bool enabled() const noexcept {
+        return _capacity != 0;
+    }
+
+    // The result of the read, if cached and not older than its TTL.
+    lw_shared_ptr<query::result> find(const partition_id&, const key&);
+
+    // To be read before starting the read whose result is inserted, and passed to insert().
+    uint64_t generation(const utils::UUID& table) const noexcept;
+
+    // Caches the result of a read which started at the given generation of
+    // its table, unless a write invalidated the table since.
+    void insert(partition_id, key, lw_shared_ptr<query::result>, clock::duration ttl, uint64_t generation);
+
+    // Drops the cached results of the partition.
+    void invalidate(const partition_id&);
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+
+    // The partitions of the mutations whose tables cache results, so may have
+    // cached results to invalidate after the mutations are applied.
+    static std::vector<partition_id> cached_partitions(const std::vector<mutation>&);
+    static std::vector<partition_id> cached_partitions(const schema&, const dht::decorated_key&);
+};
+
+}
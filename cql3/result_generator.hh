@@ -25,13 +25,34 @@ class result_generator {
     template<typename Visitor>
     class query_result_visitor {
         const schema& _schema;
-        std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Views of the components of the current keys, so that rows don't
+        // copy them. The partition key is kept for the whole partition, the
+        // clustering key is only valid while its row is visited. Components
+        // are copied only if fragmented, which keys are too small to be.
+        std::optional<partition_key> _partition_key_storage;
+        std::vector<bytes_view> _partition_key;
+        std::vector<bytes> _linearized_partition_key;
+        std::vector<bytes_view> _clustering_key;
+        std::vector<bytes> _linearized_clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
         const selection::selection& _selection;
     private:
+        template<typename Key>
+        static void explode(const Key& key, size_t component_count, std::vector<bytes_view>& components, std::vector<bytes>& linearized) {
+            components.clear();
+            linearized.clear();
+            // Views into linearized must not move.
+            linearized.reserve(component_count);
+            for (managed_bytes_view c : key.components()) {
+                if (c.is_linearized()) {
+                    components.push_back(c.current_fragment());
+                } else {
+                    components.push_back(linearized.emplace_back(c.linearize()));
+                }
+            }
+        }
         void accept_cell_value(const column_definition& def, query::result_row_view::iterator_type& i) {
             if (def.is_multi_cell()) {
                 _visitor.accept_value(i.next_collection_cell());
@@ -45,7 +66,8 @@ class result_generator {
             : _schema(s), _visitor(visitor), _selection(select) { }
 
         void accept_new_partition(const partition_key& key, uint64_t row_count) {
-            _partition_key = key.explode(_schema);
+            _partition_key_storage = key;
+            explode(*_partition_key_storage, _schema.partition_key_size(), _partition_key, _linearized_partition_key);
             accept_new_partition(row_count);
         }
         void accept_new_partition(uint64_t row_count) {
@@ -55,10 +77,15 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
-            accept_new_row(static_row, row);
+            explode(key, _schema.clustering_key_size(), _clustering_key, _linearized_clustering_key);
+            accept_row(static_row, row);
+            _clustering_key.clear();
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
+            accept_row(static_row, row);
+        }
+    private:
+        void accept_row(query::result_row_view static_row, query::result_row_view row) {
             auto static_row_iterator = static_row.iterator();
             auto row_iterator = row.iterator();
             _visitor.start_row();
@@ -84,7 +111,7 @@ class result_generator {
             }
             _visitor.end_row();
         }
-
+    public:
         void accept_partition_end(const query::result_row_view& static_row) {
             if (_partition_row_count == 0) {
                 _total_row_count++;
@@ -407,92 +407,82 @@ result_set_builder::restrictions_filter::restrictions_filter(::shared_ptr<restri
     , _options(options)
     , _skip_pk_restrictions(!_restrictions->pk_restrictions_need_filtering())
     , _skip_ck_restrictions(!_restrictions->ck_restrictions_need_filtering())
+    , _multi_column_ck_restrictions(bool(dynamic_pointer_cast<cql3::restrictions::multi_column_restriction>(_restrictions->get_clustering_columns_restrictions())))
     , _remaining(remaining)
     , _schema(schema)
     , _per_partition_limit(per_partition_limit)
     , _per_partition_remaining(_per_partition_limit)
     , _rows_fetched_for_last_partition(rows_fetched_for_last_partition)
     , _last_pkey(std::move(last_pkey))
-{ }
+{
+    if (_multi_column_ck_restrictions) {
+        _clustering_columns_restriction = expr::fold_constants(
+                _restrictions->get_clustering_columns_restrictions()->expression, _options);
+        return;
+    }
+    auto add_restrictions = [this] (const restrictions::single_column_restrictions::restrictions_map& restrictions) {
+        for (auto&& [cdef, restriction] : restrictions) {
+            _column_restrictions.emplace(cdef, expr::fold_constants(restriction->expression, _options));
+        }
+    };
+    add_restrictions(_restrictions->get_non_pk_restriction());
+    if (!_skip_pk_restrictions) {
+        add_restrictions(_restrictions->get_single_column_partition_key_restrictions());
+    }
+    if (!_skip_ck_restrictions) {
+        add_restrictions(_restrictions->get_single_column_clustering_key_restrictions());
+    }
+}
 
 bool result_set_builder::restrictions_filter::do_filter(const selection& selection,
                                                          const std::vector<bytes>& partition_key,
                                                          const std::vector<bytes>& clustering_key,
                                                          const query::result_row_view& static_row,
                                                          const query::result_row_view* row) const {
-    static logging::logger rlogger("restrictions_filter");
-
     if (_current_partition_key_does_not_match || _current_static_row_does_not_match || _remaining == 0 || _per_partition_remaining == 0) {
         return false;
     }
 
-    auto clustering_columns_restrictions = _restrictions->get_clustering_columns_restrictions();
-    if (dynamic_pointer_cast<cql3::restrictions::multi_column_restriction>(clustering_columns_restrictions)) {
-        clustering_key_prefix ckey = clustering_key_prefix::from_exploded(clustering_key);
-        return expr::is_satisfied_by(
-                clustering_columns_restrictions->expression,
-                partition_key, clustering_key, static_row, row, selection, _options);
+    // Extracted at most once per row, however many restrictions are checked against it.
+    std::optional<std::vector<managed_bytes_opt>> non_pk_values;
+    auto is_satisfied_by = [&] (const expr::expression& restriction) {
+        if (!non_pk_values) {
+            non_pk_values = expr::get_non_pk_values(selection, static_row, row);
+        }
+        return expr::is_satisfied_by(restriction, partition_key, clustering_key, *non_pk_values, selection, _options);
+    };
+
+    if (_clustering_columns_restriction) {
+        return is_satisfied_by(*_clustering_columns_restriction);
     }
 
-    auto static_row_iterator = static_row.iterator();
-    auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    auto non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
     for (auto&& cdef : selection.get_columns()) {
+        auto restr_it = _column_restrictions.find(cdef);
+        if (restr_it == _column_restrictions.end()) {
+            continue;
+        }
         switch (cdef->kind) {
         case column_kind::static_column:
             // fallthrough
-        case column_kind::regular_column: {
-            if (cdef->kind == column_kind::regular_column && !row_iterator) {
+        case column_kind::regular_column:
+            if (cdef->kind == column_kind::regular_column && !row) {
                 continue;
             }
-            auto restr_it = non_pk_restrictions_map.find(cdef);
-            if (restr_it == non_pk_restrictions_map.end()) {
-                continue;
-            }
-            restrictions::single_column_restriction& restriction = *restr_it->second;
-            bool regular_restriction_matches = expr::is_satisfied_by(
-                    restriction.expression, partition_key, clustering_key, static_row, row, selection, _options);
-            if (!regular_restriction_matches) {
+            if (!is_satisfied_by(restr_it->second)) {
                 _current_static_row_does_not_match = (cdef->kind == column_kind::static_column);
                 return false;
             }
-            }
             break;
-        case column_kind::partition_key: {
-            if (_skip_pk_restrictions) {
-                continue;
-            }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
-            auto restr_it = partition_key_restrictions_map.find(cdef);
-            if (restr_it == partition_key_restrictions_map.end()) {
-                continue;
-            }
-            restrictions::single_column_restriction& restriction = *restr_it->second;
-            if (!expr::is_satisfied_by(
-                        restriction.expression, partition_key, clustering_key, static_row, row, selection, _options)) {
+        case column_kind::partition_key:
+            if (!is_satisfied_by(restr_it->second)) {
                 _current_partition_key_does_not_match = true;
                 return false;
             }
-            }
             break;
-        case column_kind::clustering_key: {
-            if (_skip_ck_restrictions) {
-                continue;
-            }
-            auto clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
-            auto restr_it = clustering_key_restrictions_map.find(cdef);
-            if (restr_it == clustering_key_restrictions_map.end()) {
-                continue;
-            }
-            if (clustering_key.empty()) {
+        case column_kind::clustering_key:
+            if (clustering_key.empty() || !is_satisfied_by(restr_it->second)) {
                 return false;
             }
-            restrictions::single_column_restriction& restriction = *restr_it->second;
-            if (!expr::is_satisfied_by(
-                        restriction.expression, partition_key, clustering_key, static_row, row, selection, _options)) {
-                return false;
-            }
-            }
             break;
         default:
             break;
@@ -17,6 +17,7 @@
 #include "schema_fwd.hh"
 #include "query-result-reader.hh"
 #include "cql3/column_specification.hh"
+#include "cql3/expr/expression.hh"
 #include "cql3/selection/selector.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
@@ -218,6 +219,11 @@ class result_set_builder {
         const query_options& _options;
         const bool _skip_pk_restrictions;
         const bool _skip_ck_restrictions;
+        const bool _multi_column_ck_restrictions;
+        // The restrictions checked on every row, with what doesn't depend on the row
+        // evaluated once, by expr::fold_constants(), when the filter is created.
+        std::unordered_map<const column_definition*, expr::expression> _column_restrictions;
+        std::optional<expr::expression> _clustering_columns_restriction;
         mutable bool _current_partition_key_does_not_match = false;
         mutable bool _current_static_row_does_not_match = false;
         mutable uint64_t _rows_dropped = 0;
@@ -343,6 +349,15 @@ class result_set_builder {
             }
         }
 
+        // Accepts rows which were counted but not sent, see
+        // query::partition_slice::option::count_only. Only valid when
+        // the selection is a count of rows.
+        void accept_counted_rows(uint64_t count) {
+            for (uint64_t i = 0; i < count; ++i) {
+                _builder.new_row();
+            }
+        }
+
         uint64_t accept_partition_end(const query::result_row_view& static_row) {
             if (_row_count == 0) {
                 if (!_filter(_selection, _partition_key, _clustering_key, static_row, nullptr)) {
@@ -190,6 +190,11 @@ future<std::vector<mutation>> batch_statement::get_mutations(query_processor& qp
             for (auto&& m : result) {
                 vresult.push_back(std::move(m));
             }
+            // Dispatch in token order, so that writes to the same replicas and shards
+            // are started back to back and queue up on the same connections together.
+            std::sort(vresult.begin(), vresult.end(), [] (const mutation& a, const mutation& b) {
+                return a.token() < b.token();
+            });
             return vresult;
         });
     });
@@ -319,7 +324,11 @@ future<coordinator_result<>> batch_statement::execute_without_conditions(
             mutate_atomic = false;
         }
     }
-    return qp.proxy().mutate_with_triggers(std::move(mutations), cl, timeout, mutate_atomic, std::move(tr_state), std::move(permit));
+    auto cached = result_cache::cached_partitions(mutations);
+    return qp.proxy().mutate_with_triggers(std::move(mutations), cl, timeout, mutate_atomic, std::move(tr_state), std::move(permit))
+            .finally([&qp, cached = std::move(cached)] () mutable {
+        return qp.invalidate_cached_results(std::move(cached));
+    });
 }
 
 future<shared_ptr<cql_transport::messages::result_message>> batch_statement::execute_with_conditions(
@@ -375,9 +384,12 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::exe
             );
     }
 
+    auto cached = result_cache::cached_partitions(*schema, request->key()[0].start()->value().as_decorated_key());
     return qp.proxy().cas(schema, request, request->read_command(qp), request->key(),
             {read_timeout, qs.get_permit(), qs.get_client_state(), qs.get_trace_state()},
-            cl_for_paxos, cl_for_learn, batch_timeout, cas_timeout).then([this, request] (bool is_applied) {
+            cl_for_paxos, cl_for_learn, batch_timeout, cas_timeout).finally([&qp, cached = std::move(cached)] () mutable {
+        return qp.invalidate_cached_results(std::move(cached));
+    }).then([this, request] (bool is_applied) {
         return request->build_cas_result_set(_metadata, _columns_of_cas_result_set, is_applied);
     });
 }
@@ -27,6 +27,7 @@
 #include "cql3/index_name.hh"
 #include "cql3/statements/index_prop_defs.hh"
 #include "index/secondary_index_manager.hh"
+#include "index/secondary_index.hh"
 #include "mutation.hh"
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -39,11 +40,13 @@ namespace statements {
 create_index_statement::create_index_statement(cf_name name,
                                                ::shared_ptr<index_name> index_name,
                                                std::vector<::shared_ptr<index_target::raw>> raw_targets,
+                                               std::vector<::shared_ptr<column_identifier::raw>> raw_included_columns,
                                                ::shared_ptr<index_prop_defs> properties,
                                                bool if_not_exists)
     : schema_altering_statement(name)
     , _index_name(index_name->get_idx())
     , _raw_targets(raw_targets)
+    , _raw_included_columns(std::move(raw_included_columns))
     , _properties(properties)
     , _if_not_exists(if_not_exists)
 {
@@ -250,6 +253,51 @@ void create_index_statement::validate_targets_for_multi_column_index(std::vector
     }
 }
 
+std::vector<::shared_ptr<column_identifier>> create_index_statement::prepare_included_columns(const schema& schema,
+        const std::vector<::shared_ptr<index_target>>& targets) const
+{
+    std::vector<::shared_ptr<column_identifier>> columns;
+    if (_raw_included_columns.empty()) {
+        return columns;
+    }
+    if (_properties->is_custom) {
+        throw exceptions::invalid_request_exception("Included columns are not supported for CUSTOM indexes");
+    }
+    for (auto& target : targets) {
+        if (target->type != index_target::target_type::values) {
+            throw exceptions::invalid_request_exception(
+                    format("Included columns are not supported for {} indexes", index_target::index_option(target->type)));
+        }
+    }
+    for (auto& raw_column : _raw_included_columns) {
+        auto column = raw_column->prepare_column_identifier(schema);
+        auto cd = schema.get_column_definition(column->name());
+        if (cd == nullptr) {
+            throw exceptions::invalid_request_exception(format("No column definition found for included column {}", *column));
+        }
+        if (cd->is_primary_key()) {
+            throw exceptions::invalid_request_exception(
+                    format("Cannot include primary key column {}, primary key columns are always included", *column));
+        }
+        if (cd->is_static()) {
+            throw exceptions::invalid_request_exception(format("Cannot include static column {}", *column));
+        }
+        for (auto& target : targets) {
+            auto* ident = std::get_if<index_target::single_column>(&target->value);
+            if (ident && **ident == *column) {
+                throw exceptions::invalid_request_exception(format("Cannot include the indexed column {}", *column));
+            }
+        }
+        for (auto& other : columns) {
+            if (*other == *column) {
+                throw exceptions::invalid_request_exception(format("Duplicate included column {}", *column));
+            }
+        }
+        columns.push_back(std::move(column));
+    }
+    return columns;
+}
+
 schema_ptr create_index_statement::build_index_schema(query_processor& qp) const {
     auto targets = validate_while_executing(qp);
 
@@ -274,6 +322,11 @@ schema_ptr create_index_statement::build_index_schema(query_processor& qp) const
     } else {
         kind = schema->is_compound() ? index_metadata_kind::composites : index_metadata_kind::keys;
     }
+    auto included_columns = prepare_included_columns(*schema, targets);
+    if (!included_columns.empty()) {
+        index_options.emplace(db::index::secondary_index::included_columns_option_name,
+                secondary_index::target_parser::serialize_included_columns(included_columns));
+    }
     auto index = make_index_metadata(targets, accepted_name, kind, index_options);
     auto existing_index = schema->find_index_noname(index);
     if (existing_index) {
@@ -39,6 +39,7 @@ class index_prop_defs;
 class create_index_statement : public schema_altering_statement {
     const sstring _index_name;
     const std::vector<::shared_ptr<index_target::raw>> _raw_targets;
+    const std::vector<::shared_ptr<column_identifier::raw>> _raw_included_columns;
     const ::shared_ptr<index_prop_defs> _properties;
     const bool _if_not_exists;
     cql_stats* _cql_stats = nullptr;
@@ -46,6 +47,7 @@ class create_index_statement : public schema_altering_statement {
 public:
     create_index_statement(cf_name name, ::shared_ptr<index_name> index_name,
             std::vector<::shared_ptr<index_target::raw>> raw_targets,
+            std::vector<::shared_ptr<column_identifier::raw>> raw_included_columns,
             ::shared_ptr<index_prop_defs> properties, bool if_not_exists);
 
     future<> check_access(query_processor& qp, const service::client_state& state) const override;
@@ -62,6 +64,8 @@ class create_index_statement : public schema_altering_statement {
                                                                   const index_target& target) const;
     void validate_target_column_is_map_if_index_involves_keys(bool is_map, const index_target& target) const;
     void validate_targets_for_multi_column_index(std::vector<::shared_ptr<index_target>> targets) const;
+    std::vector<::shared_ptr<column_identifier>> prepare_included_columns(const schema& schema,
+                                                                          const std::vector<::shared_ptr<index_target>>& targets) const;
     static index_metadata make_index_metadata(const std::vector<::shared_ptr<index_target>>& targets,
                                               const sstring& name,
                                               index_metadata_kind kind,
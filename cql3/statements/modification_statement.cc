@@ -287,7 +287,11 @@ modification_statement::execute_without_condition(query_processor& qp, service::
             return make_ready_future<coordinator_result<>>(bo::success());
         }
         
-        return qp.proxy().mutate_with_triggers(std::move(mutations), cl, timeout, false, qs.get_trace_state(), qs.get_permit(), this->is_raw_counter_shard_write());
+        auto cached = result_cache::cached_partitions(mutations);
+        return qp.proxy().mutate_with_triggers(std::move(mutations), cl, timeout, false, qs.get_trace_state(), qs.get_permit(), this->is_raw_counter_shard_write())
+                .finally([&qp, cached = std::move(cached)] () mutable {
+            return qp.invalidate_cached_results(std::move(cached));
+        });
     });
 }
 
@@ -324,9 +328,12 @@ modification_statement::execute_with_condition(query_processor& qp, service::que
             );
     }
 
+    auto cached = result_cache::cached_partitions(*s, request->key()[0].start()->value().as_decorated_key());
     return qp.proxy().cas(s, request, request->read_command(qp), request->key(),
             {read_timeout, qs.get_permit(), qs.get_client_state(), qs.get_trace_state()},
-            cl_for_paxos, cl_for_learn, statement_timeout, cas_timeout).then([this, request] (bool is_applied) {
+            cl_for_paxos, cl_for_learn, statement_timeout, cas_timeout).finally([&qp, cached = std::move(cached)] () mutable {
+        return qp.invalidate_cached_results(std::move(cached));
+    }).then([this, request] (bool is_applied) {
         return request->build_cas_result_set(_metadata, _columns_of_cas_result_set, is_applied);
     });
 }
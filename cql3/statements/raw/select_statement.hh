@@ -154,6 +154,14 @@ class select_statement : public cf_statement
 
     bool contains_alias(const column_identifier& name) const;
 
+    // Returns the table of the index the query would use, if it has included
+    // columns and holds everything the query restricts and selects, so that the
+    // query can be served from it without reading the base table.
+    schema_ptr find_covering_index_table(data_dictionary::database db,
+                                         schema_ptr schema,
+                                         const selection::selection& selection,
+                                         const restrictions::statement_restrictions& restrictions) const;
+
     lw_shared_ptr<column_specification> limit_receiver(bool per_partition = false);
 
 #if 0
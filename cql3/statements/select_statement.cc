@@ -17,11 +17,15 @@
 #include "cql3/query_processor.hh"
 #include "transport/messages/result_message.hh"
 #include "cql3/functions/as_json_function.hh"
+#include "cql3/functions/aggregate_fcts.hh"
+#include "cql3/functions/functions.hh"
 #include "cql3/selection/selection.hh"
 #include "cql3/util.hh"
 #include "cql3/restrictions/single_column_primary_key_restrictions.hh"
 #include "cql3/restrictions/statement_restrictions.hh"
 #include "cql3/selection/selector_factories.hh"
+#include "index/secondary_index.hh"
+#include "index/secondary_index_manager.hh"
 #include "validation.hh"
 #include "exceptions/unrecognized_entity_exception.hh"
 #include <seastar/core/shared_ptr.hh>
@@ -30,6 +34,7 @@
 #include "query_result_merger.hh"
 #include "service/pager/query_pagers.hh"
 #include "service/storage_proxy.hh"
+#include "replica/database.hh"
 #include <seastar/core/execution_stage.hh>
 #include "view_info.hh"
 #include "partition_slice_builder.hh"
@@ -43,6 +48,8 @@
 #include "utils/result.hh"
 #include "utils/result_combinators.hh"
 #include "utils/result_loop.hh"
+#include "utils/big_decimal.hh"
+#include "utils/multiprecision_int.hh"
 
 template<typename T = void>
 using coordinator_result = cql3::statements::select_statement::coordinator_result<T>;
@@ -390,10 +397,28 @@ select_statement::do_execute(query_processor& qp,
     if (!aggregate && !_restrictions_need_filtering && (page_size <= 0
             || !service::pager::query_pagers::may_need_paging(*_schema, page_size,
                     *command, key_ranges))) {
+        // Only the shard owning the partition caches its results, so that
+        // writes have a single shard to invalidate.
+        if (_schema->caching_options().result_cache_ttl().count() && qp.get_result_cache().enabled()
+                && !state.get_client_state().is_internal() && !_parameters->bypass_cache() && !raw_cql_statement.empty()
+                && !db::is_serial_consistency(options.get_consistency())
+                && key_ranges.size() == 1 && query::is_single_partition(key_ranges.front())
+                && dht::shard_of(*_schema, key_ranges.front().start()->value().token()) == this_shard_id()) {
+            return execute_with_result_cache(qp, command, std::move(key_ranges), state, options, now);
+        }
         return execute_without_checking_exception_message(qp, command, std::move(key_ranges), state, options, now);
     }
 
     command->slice.options.set<query::partition_slice::option::allow_short_read>();
+    // A count(*) of a single partition needs only the number of rows, the
+    // replicas don't have to send them. Filtering needs the rows, and results
+    // of several partitions are merged by trimming their rows.
+    if (aggregate && _selection->is_count() && !has_group_by() && !_restrictions_need_filtering
+            && command->slice.partition_row_limit() == query::max_rows_if_set
+            && key_ranges.size() == 1 && query::is_single_partition(key_ranges.front())
+            && qp.db().features().cluster_supports_count_only_reads()) {
+        command->slice.options.set<query::partition_slice::option::count_only>();
+    }
     auto timeout_duration = get_timeout(state.get_client_state(), options);
     auto timeout = db::timeout_clock::now() + timeout_duration;
     auto p = service::pager::query_pagers::pager(qp.proxy(), _schema, _selection,
@@ -677,18 +702,39 @@ indexed_table_select_statement::do_execute_base_query(
             }
             next_iteration_size = std::min<size_t>({next_iteration_size, keys.size() - already_done, max_base_table_query_concurrency});
             auto key_it_end = key_it + next_iteration_size;
-            auto command = ::make_lw_shared<query::read_command>(*cmd);
+
+            // Keys come in index order, in which the rows of one base partition
+            // are adjacent: always for local indexes, and for global ones when
+            // several rows of a partition have the indexed value. Read all such
+            // rows with one command, and don't split them between iterations.
+            auto same_partition = [this] (const dht::decorated_key& a, const dht::decorated_key& b) {
+                return a.equal(*_schema, b);
+            };
+            while (key_it_end != keys.end() && same_partition(std::prev(key_it_end)->partition, key_it_end->partition)) {
+                ++key_it_end;
+            }
+            std::vector<std::pair<std::vector<primary_key>::iterator, std::vector<primary_key>::iterator>> partitions;
+            for (auto it = key_it; it != key_it_end;) {
+                auto first = it++;
+                while (it != key_it_end && same_partition(first->partition, it->partition)) {
+                    ++it;
+                }
+                partitions.emplace_back(first, it);
+            }
 
             query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
-            return utils::result_map_reduce(key_it, key_it_end, [this, &qp, &state, &options, cmd, timeout] (auto& key) {
+            return utils::result_map_reduce(partitions.begin(), partitions.end(), [this, &qp, &state, &options, cmd, timeout] (auto& partition_keys) {
                 auto command = ::make_lw_shared<query::read_command>(*cmd);
-                // for each partition, read just one clustering row (TODO: can
-                // get all needed rows of one partition at once.)
+                // for each partition, read just the clustering rows pointed to
+                // by the index
                 command->slice._row_ranges.clear();
-                if (key.clustering) {
-                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
+                const auto& [first, last] = partition_keys;
+                for (auto it = first; it != last; ++it) {
+                    if (it->clustering) {
+                        command->slice._row_ranges.push_back(query::clustering_range::make_singular(it->clustering));
+                    }
                 }
-                return qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+                return qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(first->partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
                 .then(utils::result_wrap([] (service::storage_proxy::coordinator_query_result qr) -> coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> {
                     return std::move(qr.query_result);
                 }));
@@ -773,6 +819,64 @@ select_statement::execute_without_checking_exception_message(query_processor& qp
     }
 }
 
+// The bound values of the statement, as part of a result_cache::key.
+static bytes serialize_bound_values(const query_options& options) {
+    bytes_ostream out;
+    auto write_size = [&out] (int32_t size) {
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    };
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        auto v = options.get_value_at(i);
+        if (v.is_null()) {
+            write_size(-1);
+        } else if (v.is_unset_value()) {
+            write_size(-2);
+        } else {
+            v.with_linearized([&] (bytes_view bv) {
+                write_size(bv.size());
+                out.write(bv);
+            });
+        }
+    }
+    return bytes(out.linearize());
+}
+
+future<shared_ptr<cql_transport::messages::result_message>>
+select_statement::execute_with_result_cache(query_processor& qp,
+                          lw_shared_ptr<query::read_command> cmd,
+                          dht::partition_range_vector&& partition_ranges,
+                          service::query_state& state,
+                          const query_options& options,
+                          gc_clock::time_point now) const
+{
+    auto& cache = qp.get_result_cache();
+    auto& table_stats = qp.proxy().local_db().find_column_family(_schema).get_stats();
+    result_cache::partition_id id(*_schema, partition_ranges.front().start()->value().as_decorated_key());
+    result_cache::key key{_schema->version(), raw_cql_statement, serialize_bound_values(options), options.get_consistency()};
+    if (auto cached = cache.find(id, key)) {
+        ++table_stats.coordinator_result_cache_hits;
+        tracing::trace(state.get_trace_state(), "Found the result in the coordinator result cache");
+        return process_results(make_foreign(std::move(cached)), std::move(cmd), options, now);
+    }
+    ++table_stats.coordinator_result_cache_misses;
+
+    auto generation = cache.generation(id.table);
+    auto ttl = _schema->caching_options().result_cache_ttl();
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    return qp.proxy().query_result(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+        .then(wrap_result_to_error_message([this, &qp, &options, now, cmd, id = std::move(id), key = std::move(key), ttl, generation] (service::storage_proxy::coordinator_query_result qr) mutable {
+            auto& result = qr.query_result;
+            // Cached results are shared between the reads which hit them, so
+            // they must belong to this shard.
+            if (result.get_owner_shard() == this_shard_id() && !result->is_short_read()) {
+                auto shared = result.release();
+                qp.get_result_cache().insert(std::move(id), std::move(key), shared, ttl, generation);
+                result = make_foreign(std::move(shared));
+            }
+            return this->process_results(std::move(result), cmd, options, now);
+        }));
+}
+
 future<shared_ptr<cql_transport::messages::result_message>>
 indexed_table_select_statement::process_base_query_results(
         foreign_ptr<lw_shared_ptr<query::result>> results,
@@ -1349,6 +1453,171 @@ indexed_table_select_statement::find_index_clustering_rows(query_processor& qp,
 }
 
 
+// An aggregation query executed by `forward_service`: the reductions which
+// are computed for it across the cluster, and how each selector is computed
+// from the merged results of the reductions.
+struct parallelized_aggregation {
+    struct selector {
+        enum class kind {
+            // The result of the reduction as is.
+            reduction,
+            // A sum of integers, which the reduction computed as a varint,
+            // see `forward_request::reduction_type::sum`.
+            integer_sum,
+            // An average: the reduction is the sum, and the next one is the
+            // count of values.
+            average,
+        };
+
+        kind what;
+        size_t reduction;
+        // The type of the aggregated column.
+        data_type type;
+
+        bytes_opt compute(const std::vector<bytes_opt>& results) const;
+    };
+
+    std::vector<query::forward_request::reduction_type> reduction_types;
+    std::vector<sstring> reduction_columns;
+    std::vector<selector> selectors;
+};
+
+template <typename T>
+static bytes narrow_integer_sum(const boost::multiprecision::cpp_int& sum) {
+    if (sum < std::numeric_limits<T>::min() || sum > std::numeric_limits<T>::max()) {
+        throw exceptions::overflow_error_exception("Sum overflow. Values should be casted to a wider type.");
+    }
+    return data_type_for<T>()->decompose(static_cast<T>(sum));
+}
+
+// Computes the value of an integer column of type `type` out of a varint,
+// throwing if it doesn't fit, as `sum()` does.
+static bytes narrow_integer_sum(const data_type& type, const utils::multiprecision_int& sum) {
+    if (type == byte_type) {
+        return narrow_integer_sum<int8_t>(sum);
+    } else if (type == short_type) {
+        return narrow_integer_sum<int16_t>(sum);
+    } else if (type == int32_type) {
+        return narrow_integer_sum<int32_t>(sum);
+    } else if (type == long_type) {
+        return narrow_integer_sum<int64_t>(sum);
+    }
+    throw std::runtime_error(format("cannot narrow an integer sum to {}", type->name()));
+}
+
+// Divides as `avg()` does, which returns 0 for no values.
+static bytes average(const data_type& type, const data_type& sum_type, const bytes& sum, int64_t count) {
+    if (sum_type == varint_type) {
+        auto avg = value_cast<utils::multiprecision_int>(varint_type->deserialize(sum));
+        if (count) {
+            avg /= count;
+        }
+        return type == varint_type ? varint_type->decompose(avg) : narrow_integer_sum(type, avg);
+    } else if (sum_type == decimal_type) {
+        auto avg = value_cast<big_decimal>(decimal_type->deserialize(sum));
+        return decimal_type->decompose(count ? avg.div(count, big_decimal::rounding_mode::HALF_EVEN) : big_decimal());
+    } else if (sum_type == float_type) {
+        auto avg = value_cast<float>(float_type->deserialize(sum));
+        return float_type->decompose(count ? avg / count : 0.0f);
+    } else if (sum_type == double_type) {
+        auto avg = value_cast<double>(double_type->deserialize(sum));
+        return double_type->decompose(count ? avg / count : 0.0);
+    }
+    throw std::runtime_error(format("cannot compute an average of {}", type->name()));
+}
+
+bytes_opt parallelized_aggregation::selector::compute(const std::vector<bytes_opt>& results) const {
+    switch (what) {
+        case kind::reduction:
+            return results.at(reduction);
+        case kind::integer_sum:
+            return narrow_integer_sum(type, value_cast<utils::multiprecision_int>(varint_type->deserialize(*results.at(reduction))));
+        case kind::average: {
+            auto count = value_cast<int64_t>(long_type->deserialize(*results.at(reduction + 1)));
+            auto sum_type = service::reduction_result_type(query::forward_request::reduction_type::sum, type);
+            return average(type, sum_type, *results.at(reduction), count);
+        }
+    }
+    throw std::runtime_error("unknown parallelized selector kind");
+}
+
+// Returns how `forward_service` can compute the selectors of an aggregation
+// query, if they are all count(*), or count(), sum(), avg(), min() or max()
+// of a column of a native type. Clusters without the
+// PARALLELIZED_NATIVE_AGGREGATES feature (`native_aggregates`) support only
+// count(*).
+static std::optional<parallelized_aggregation> parallelize_aggregation(const schema& s,
+        const std::vector<::shared_ptr<selection::raw_selector>>& select_clause, bool native_aggregates) {
+    using reduction_type = query::forward_request::reduction_type;
+    using kind = parallelized_aggregation::selector::kind;
+
+    parallelized_aggregation res;
+    bool count_only = true;
+    for (const auto& raw_selector : select_clause) {
+        auto call = expr::as_if<expr::function_call>(&raw_selector->selectable_);
+        if (!call) {
+            return std::nullopt;
+        }
+        auto name = std::get_if<functions::function_name>(&call->func);
+        if (!name || (name->has_keyspace() && name->keyspace != db::system_keyspace_name())) {
+            return std::nullopt;
+        }
+        const size_t reduction = res.reduction_types.size();
+        auto add_reduction = [&] (reduction_type type, sstring column) {
+            res.reduction_types.push_back(type);
+            res.reduction_columns.push_back(std::move(column));
+        };
+
+        if (call->args.empty()) {
+            if (name->name != functions::aggregate_fcts::COUNT_ROWS_FUNCTION_NAME) {
+                return std::nullopt;
+            }
+            add_reduction(reduction_type::count, "");
+            res.selectors.push_back({kind::reduction, reduction, long_type});
+            continue;
+        }
+
+        auto column = call->args.size() == 1 ? expr::as_if<expr::unresolved_identifier>(&call->args[0]) : nullptr;
+        if (!column) {
+            return std::nullopt;
+        }
+        auto def = get_column_definition(s, *column->ident->prepare_column_identifier(s));
+        if (!def || def->is_hidden_from_cql()) {
+            return std::nullopt;
+        }
+        auto type = def->type->underlying_type();
+        // Anything but a native function of a native type, like max() of a
+        // collection, is left to the coordinator.
+        if (!functions::functions::find(functions::function_name::native_function(name->name), {type})) {
+            return std::nullopt;
+        }
+        const auto column_name = def->name_as_text();
+        count_only = false;
+        if (name->name == "count") {
+            add_reduction(reduction_type::count_column, column_name);
+            res.selectors.push_back({kind::reduction, reduction, long_type});
+        } else if (name->name == "min" || name->name == "max") {
+            add_reduction(name->name == "min" ? reduction_type::min : reduction_type::max, column_name);
+            res.selectors.push_back({kind::reduction, reduction, type});
+        } else if (name->name == "sum") {
+            add_reduction(reduction_type::sum, column_name);
+            const bool integer_sum = service::reduction_result_type(reduction_type::sum, type) != type;
+            res.selectors.push_back({integer_sum ? kind::integer_sum : kind::reduction, reduction, type});
+        } else if (name->name == "avg") {
+            add_reduction(reduction_type::sum, column_name);
+            add_reduction(reduction_type::count_column, column_name);
+            res.selectors.push_back({kind::average, reduction, type});
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (!count_only && !native_aggregates) {
+        return std::nullopt;
+    }
+    return res;
+}
+
 class parallelized_select_statement : public select_statement {
 public:
     static ::shared_ptr<cql3::statements::select_statement> prepare(
@@ -1363,7 +1632,8 @@ class parallelized_select_statement : public select_statement {
         std::optional<expr::expression> limit,
         std::optional<expr::expression> per_partition_limit,
         cql_stats& stats,
-        std::unique_ptr<cql3::attributes> attrs
+        std::unique_ptr<cql3::attributes> attrs,
+        parallelized_aggregation aggregation
     );
 
     parallelized_select_statement(
@@ -1378,10 +1648,13 @@ class parallelized_select_statement : public select_statement {
         std::optional<expr::expression> limit,
         std::optional<expr::expression> per_partition_limit,
         cql_stats& stats,
-        std::unique_ptr<cql3::attributes> attrs
+        std::unique_ptr<cql3::attributes> attrs,
+        parallelized_aggregation aggregation
     );
 
 private:
+    const parallelized_aggregation _aggregation;
+
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(
         query_processor& qp,
         service::query_state& state,
@@ -1401,7 +1674,8 @@ ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::
     std::optional<expr::expression> limit,
     std::optional<expr::expression> per_partition_limit,
     cql_stats& stats,
-    std::unique_ptr<cql3::attributes> attrs
+    std::unique_ptr<cql3::attributes> attrs,
+    parallelized_aggregation aggregation
 ) {
     return ::make_shared<cql3::statements::parallelized_select_statement>(
         schema,
@@ -1415,7 +1689,8 @@ ::shared_ptr<cql3::statements::select_statement> parallelized_select_statement::
         std::move(limit),
         std::move(per_partition_limit),
         stats,
-        std::move(attrs)
+        std::move(attrs),
+        std::move(aggregation)
     );
 }
 
@@ -1431,7 +1706,8 @@ parallelized_select_statement::parallelized_select_statement(
     std::optional<expr::expression> limit,
     std::optional<expr::expression> per_partition_limit,
     cql_stats& stats,
-    std::unique_ptr<cql3::attributes> attrs
+    std::unique_ptr<cql3::attributes> attrs,
+    parallelized_aggregation aggregation
 ) : select_statement(
     schema,
     bound_terms,
@@ -1445,7 +1721,7 @@ parallelized_select_statement::parallelized_select_statement(
     std::move(per_partition_limit),
     stats,
     std::move(attrs)
-) {
+), _aggregation(std::move(aggregation)) {
 }
 
 future<::shared_ptr<cql_transport::messages::result_message>>
@@ -1498,18 +1774,21 @@ parallelized_select_statement::do_execute(
     auto timeout = db::timeout_clock::now() + timeout_duration;
 
     query::forward_request req = {
-        .reduction_types = {query::forward_request::reduction_type::count},
+        .reduction_types = _aggregation.reduction_types,
         .cmd = *command,
         .pr = std::move(key_ranges),
         .cl = options.get_consistency(),
         .timeout = timeout,
+        .reduction_columns = _aggregation.reduction_columns,
     };
 
     // dispatch execution of this statement to other nodes
     return qp.forwarder().dispatch(req, state.get_trace_state()).then([this] (query::forward_result res) {
         auto meta = make_shared<metadata>(*_selection->get_result_metadata());
         auto rs = std::make_unique<result_set>(std::move(meta));
-        rs->add_column_value(*res.query_results[0]);
+        for (const auto& selector : _aggregation.selectors) {
+            rs->add_column_value(selector.compute(res.query_results));
+        }
         update_stats_rows_read(rs->size());
         return shared_ptr<cql_transport::messages::result_message>(
             make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)))
@@ -1599,6 +1878,16 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
 
     auto restrictions = prepare_restrictions(db, schema, ctx, selection, for_view, _parameters->allow_filtering());
 
+    if (!for_view && restrictions->uses_secondary_indexing()) {
+        if (auto index_table = find_covering_index_table(db, schema, *selection, *restrictions)) {
+            // Prepare the same query against the index table. The bind markers
+            // are the same, so the context is reused and its specifications are
+            // overwritten.
+            _cf_name->set_column_family(index_table->cf_name(), true);
+            return prepare(db, stats, for_view);
+        }
+    }
+
     if (_parameters->is_distinct()) {
         validate_distinct_selection(*schema, *selection, *restrictions);
     }
@@ -1629,13 +1918,18 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
     // using `forward_service`.
     auto can_be_forwarded = [&] {
         return selection->is_aggregate()        // Aggregation only
-            && selection->is_count()            // Only count(*) selection is supported.
             && !restrictions->need_filtering()  // No filtering
             && group_by_cell_indices->empty()   // No GROUP BY
             // All potential intermediate coordinators must support forwarding
             && db.features().cluster_supports_parallelized_aggregation()
             && db.get_config().enable_parallelized_aggregation();
     };
+    // Only native aggregates of columns are supported, see parallelize_aggregation().
+    std::optional<parallelized_aggregation> aggregation;
+    if (can_be_forwarded()) {
+        aggregation = parallelize_aggregation(*schema, _select_clause,
+                db.features().cluster_supports_parallelized_native_aggregates());
+    }
 
     if (restrictions->uses_secondary_indexing()) {
         stmt = indexed_table_select_statement::prepare(
@@ -1652,7 +1946,7 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
                 prepare_limit(db, ctx, _per_partition_limit),
                 stats,
                 std::move(prepared_attrs));
-    } else if (can_be_forwarded()) {
+    } else if (aggregation) {
         stmt = parallelized_select_statement::prepare(
             schema,
             ctx.bound_variables_size(),
@@ -1665,7 +1959,8 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
             prepare_limit(db, ctx, _limit),
             prepare_limit(db, ctx, _per_partition_limit),
             stats,
-            std::move(prepared_attrs)
+            std::move(prepared_attrs),
+            std::move(*aggregation)
         );
     } else {
         stmt = ::make_shared<cql3::statements::primary_key_select_statement>(
@@ -1688,6 +1983,61 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
     return make_unique<prepared_statement>(std::move(stmt), ctx, move(partition_key_bind_indices), move(warnings));
 }
 
+schema_ptr select_statement::find_covering_index_table(data_dictionary::database db,
+                                                       schema_ptr schema,
+                                                       const selection::selection& selection,
+                                                       const restrictions::statement_restrictions& restrictions) const {
+    // Only plain column selections are served from the index table; functions
+    // such as token() or writetime() would be evaluated against its own keys.
+    if (_parameters->is_json() || _parameters->is_distinct() || !_parameters->orderings().empty()
+            || !_group_by_columns.empty() || _per_partition_limit || _select_clause.empty()) {
+        return nullptr;
+    }
+    for (const auto& raw_selector : _select_clause) {
+        if (!expr::is<expr::unresolved_identifier>(raw_selector->selectable_)) {
+            return nullptr;
+        }
+    }
+    if (restrictions.need_filtering() || restrictions.has_token_restrictions()
+            || restrictions.has_clustering_columns_restriction()) {
+        return nullptr;
+    }
+
+    auto& sim = db.find_column_family(schema).get_index_manager();
+    auto [index_opt, used_index_restrictions] = restrictions.find_idx(sim);
+    if (!index_opt || !index_opt->metadata().options().contains(db::index::secondary_index::included_columns_option_name)) {
+        return nullptr;
+    }
+    const auto& im = index_opt->metadata();
+    const column_definition* target = schema->get_column_definition(to_bytes(index_opt->target_column()));
+    if (!target || !target->is_regular() || !restrictions.has_eq_restriction_on_column(*target)) {
+        return nullptr;
+    }
+    // The index table must be read as a single partition: by the indexed value
+    // for a global index, by the base partition key and the indexed value for
+    // a local one.
+    const auto& non_pk_restrictions = restrictions.get_non_pk_restriction();
+    if (non_pk_restrictions.size() != 1 || !non_pk_restrictions.contains(target)) {
+        return nullptr;
+    }
+    if (im.local()) {
+        if (restrictions.has_partition_key_unrestricted_components() || restrictions.key_is_in_relation()) {
+            return nullptr;
+        }
+    } else if (!restrictions.get_partition_key_restrictions()->empty()) {
+        return nullptr;
+    }
+
+    schema_ptr index_table = db.find_schema(schema->ks_name(), secondary_index::index_table_name(im.name()));
+    for (const column_definition* cdef : selection.get_columns()) {
+        const column_definition* index_cdef = index_table->get_column_definition(cdef->name());
+        if (!index_cdef || index_cdef->is_computed() || index_cdef->is_view_virtual()) {
+            return nullptr;
+        }
+    }
+    return index_table;
+}
+
 ::shared_ptr<restrictions::statement_restrictions>
 select_statement::prepare_restrictions(data_dictionary::database db,
                                        schema_ptr schema,
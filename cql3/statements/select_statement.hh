@@ -149,6 +149,10 @@ protected :
         return do_get_limit(options, _per_partition_limit, query::partition_max_rows);
     }
     bool needs_post_query_ordering() const;
+    // Reads a single partition through the coordinator result cache, see cql3::result_cache.
+    future<::shared_ptr<cql_transport::messages::result_message>> execute_with_result_cache(query_processor& qp,
+        lw_shared_ptr<query::read_command> cmd, dht::partition_range_vector&& partition_ranges, service::query_state& state,
+        const query_options& options, gc_clock::time_point now) const;
     virtual void update_stats_rows_read(int64_t rows_read) const {
         _stats.rows_read += rows_read;
     }
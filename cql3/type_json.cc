@@ -18,6 +18,7 @@
 #include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/managed_bytes.hh"
 #include "exceptions/exceptions.hh"
+#include <cstring>
 #include <limits>
 #include <utility>
 #include <boost/algorithm/string/trim_all.hpp>
@@ -27,55 +28,74 @@ static inline bool is_control_char(char c) {
     return c >= 0 && c <= 0x1F;
 }
 
-static inline bool needs_escaping(const sstring& s) {
-    return std::any_of(s.begin(), s.end(), [](char c) {return is_control_char(c) || c == '"' || c == '\\';});
+static inline bool needs_escaping(char c) {
+    return is_control_char(c) || c == '"' || c == '\\';
 }
 
-
-static sstring quote_json_string(const sstring& value) {
-    if (!needs_escaping(value)) {
-        return format("\"{}\"", value);
+// Returns the length of the longest prefix of s which needs no escaping.
+// Eight bytes are checked at a time, and only words which contain a
+// character to escape are looked at byte by byte.
+static size_t unescaped_prefix_length(std::string_view s) {
+    constexpr uint64_t ones = 0x0101010101010101;
+    constexpr uint64_t highs = 0x8080808080808080;
+    auto has_zero_byte = [] (uint64_t x) {
+        return (x - ones) & ~x & highs;
+    };
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= s.size(); i += sizeof(uint64_t)) {
+        uint64_t w;
+        std::memcpy(&w, s.data() + i, sizeof(w));
+        // Bytes below 0x20, or equal to '"' or '\\'.
+        if (((w - ones * 0x20) & ~w & highs) | has_zero_byte(w ^ (ones * '"')) | has_zero_byte(w ^ (ones * '\\'))) {
+            break;
+        }
+    }
+    while (i < s.size() && !needs_escaping(s[i])) {
+        ++i;
     }
-    std::ostringstream oss;
-    oss << std::hex << std::uppercase << std::setfill('0');
-    oss.put('"');
-    for (char c : value) {
+    return i;
+}
+
+static void write_quoted_json_string(std::string& out, std::string_view value) {
+    out.push_back('"');
+    while (!value.empty()) {
+        auto n = unescaped_prefix_length(value);
+        out.append(value.data(), n);
+        if (n == value.size()) {
+            break;
+        }
+        char c = value[n];
+        value.remove_prefix(n + 1);
         switch (c) {
         case '"':
-            oss.put('\\').put('"');
+            out.append("\\\"");
             break;
         case '\\':
-            oss.put('\\').put('\\');
+            out.append("\\\\");
             break;
         case '\b':
-            oss.put('\\').put('b');
+            out.append("\\b");
             break;
         case '\f':
-            oss.put('\\').put('f');
+            out.append("\\f");
             break;
         case '\n':
-            oss.put('\\').put('n');
+            out.append("\\n");
             break;
         case '\r':
-            oss.put('\\').put('r');
+            out.append("\\r");
             break;
         case '\t':
-            oss.put('\\').put('t');
+            out.append("\\t");
             break;
         default:
-            if (is_control_char(c)) {
-                oss.put('\\').put('u') << std::setw(4) << static_cast<int>(c);
-            } else {
-                oss.put(c);
-            }
+            fmt::format_to(std::back_inserter(out), "\\u{:04X}", static_cast<int>(c));
             break;
         }
     }
-    oss.put('"');
-    return oss.str();
+    out.push_back('"');
 }
 
-
 template <typename T> static T to_int(const rjson::value& value) {
     int64_t result;
 
@@ -342,189 +362,182 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void write_json_string_aux(const map_type_impl& t, bytes_view bv, std::string& out) {
     auto sf = cql_serialization_format::internal();
 
-    out << '{';
+    out.push_back('{');
     auto size = read_collection_size(bv, sf);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_value(bv, sf);
         auto vb = read_collection_value(bv, sf);
 
         if (i > 0) {
-            out << ", ";
+            out.append(", ");
         }
 
         // Valid keys in JSON map must be quoted strings
-        sstring string_key = to_json_string(*t.get_keys_type(), kb);
-        bool is_unquoted = string_key.empty() || string_key[0] != '"';
-        if (is_unquoted) {
-            out << '"';
-        }
-        out << string_key;
-        if (is_unquoted) {
-            out << '"';
+        auto key_start = out.size();
+        write_json_string(*t.get_keys_type(), kb, out);
+        if (out.size() == key_start || out[key_start] != '"') {
+            out.insert(key_start, 1, '"');
+            out.push_back('"');
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        out.append(": ");
+        write_json_string(*t.get_values_type(), vb, out);
     }
-    out << '}';
-    return out.str();
+    out.push_back('}');
 }
 
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
+static void write_json_string_aux(const listlike_collection_type_impl& t, bytes_view bv, std::string& out) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
-    out << '[';
+    out.push_back('[');
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            out.append(", ");
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        write_json_string(*t.get_elements_type(), e, out);
     });
-    out << ']';
-    return out.str();
+    out.push_back(']');
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    auto sf = cql_serialization_format::internal();
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        out << to_json_string(*t.get_elements_type(), e);
-    });
-    out << ']';
-    return out.str();
-}
-
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_string_aux(const tuple_type_impl& t, bytes_view bv, std::string& out) {
+    out.push_back('[');
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.append(", ");
         }
         if (*vi) {
-            // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json_string(**ti, **vi, out);
         } else {
-            out << "null";
+            out.append("null");
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return out.str();
+    out.push_back(']');
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_string_aux(const user_type_impl& t, bytes_view bv, std::string& out) {
+    out.push_back('{');
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            out.append(", ");
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        write_quoted_json_string(out, t.field_name_as_string(i));
+        out.append(": ");
         if (*vi) {
-            //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json_string(**ti, **vi, out);
         } else {
-            out << "null";
+            out.append("null");
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return out.str();
+    out.push_back('}');
 }
 
 namespace {
 struct to_json_string_visitor {
     bytes_view bv;
-    sstring operator()(const reversed_type_impl& t) { return to_json_string(*t.underlying_type(), bv); }
-    template <typename T> sstring operator()(const integer_type_impl<T>& t) { return to_sstring(compose_value(t, bv)); }
-    template <typename T> sstring operator()(const floating_type_impl<T>& t) {
+    std::string& out;
+    void quoted(std::string_view s) { write_quoted_json_string(out, s); }
+    void operator()(const reversed_type_impl& t) { write_json_string(*t.underlying_type(), bv, out); }
+    template <typename T> void operator()(const integer_type_impl<T>& t) { out.append(to_sstring(compose_value(t, bv))); }
+    template <typename T> void operator()(const floating_type_impl<T>& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
         T d = value_cast<T>(v);
         if (std::isnan(d) || std::isinf(d)) {
-            return "null";
+            out.append("null");
+            return;
         }
-        return to_sstring(d);
-    }
-    sstring operator()(const uuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const inet_addr_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const string_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const bytes_type_impl& t) { return quote_json_string("0x" + t.to_string(bv)); }
-    sstring operator()(const boolean_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const timestamp_date_base_class& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const timeuuid_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const map_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const set_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const list_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const tuple_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const user_type_impl& t) { return to_json_string_aux(t, bv); }
-    sstring operator()(const simple_date_type_impl& t) { return quote_json_string(t.to_string(bv)); }
-    sstring operator()(const time_type_impl& t) { return t.to_string(bv); }
-    sstring operator()(const empty_type_impl& t) { return "null"; }
-    sstring operator()(const duration_type_impl& t) {
+        out.append(to_sstring(d));
+    }
+    void operator()(const uuid_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const inet_addr_type_impl& t) { quoted(t.to_string(bv)); }
+    // A string's serialized form is its text, so it is escaped straight from the cell.
+    void operator()(const string_type_impl& t) { quoted(std::string_view(reinterpret_cast<const char*>(bv.data()), bv.size())); }
+    void operator()(const bytes_type_impl& t) {
+        out.append("\"0x");
+        out.append(t.to_string(bv));
+        out.push_back('"');
+    }
+    void operator()(const boolean_type_impl& t) { out.append(t.to_string(bv)); }
+    void operator()(const timestamp_date_base_class& t) { quoted(t.to_string(bv)); }
+    void operator()(const timeuuid_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const map_type_impl& t) { write_json_string_aux(t, bv, out); }
+    void operator()(const set_type_impl& t) { write_json_string_aux(t, bv, out); }
+    void operator()(const list_type_impl& t) { write_json_string_aux(t, bv, out); }
+    void operator()(const tuple_type_impl& t) { write_json_string_aux(t, bv, out); }
+    void operator()(const user_type_impl& t) { write_json_string_aux(t, bv, out); }
+    void operator()(const simple_date_type_impl& t) { quoted(t.to_string(bv)); }
+    void operator()(const time_type_impl& t) { out.append(t.to_string(bv)); }
+    void operator()(const empty_type_impl& t) { out.append("null"); }
+    void operator()(const duration_type_impl& t) {
         auto v = t.deserialize(bv);
         if (v.is_null()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
-        return quote_json_string(t.to_string(bv));
+        quoted(t.to_string(bv));
     }
-    sstring operator()(const counter_type_impl& t) {
+    void operator()(const counter_type_impl& t) {
         // It will be called only from cql3 layer while processing query results.
-        return to_json_string(*counter_cell_view::total_value_type(), bv);
+        write_json_string(*counter_cell_view::total_value_type(), bv, out);
     }
-    sstring operator()(const decimal_type_impl& t) {
+    void operator()(const decimal_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<big_decimal>(v).to_string();
+        out.append(value_cast<big_decimal>(v).to_string());
     }
-    sstring operator()(const varint_type_impl& t) {
+    void operator()(const varint_type_impl& t) {
         if (bv.empty()) {
             throw exceptions::invalid_request_exception("Cannot create JSON string - deserialization error");
         }
         auto v = t.deserialize(bv);
-        return value_cast<utils::multiprecision_int>(v).str();
+        out.append(value_cast<utils::multiprecision_int>(v).str());
     }
 };
 }
 
+void write_json_string(const abstract_type& t, bytes_view bv, std::string& out) {
+    visit(t, to_json_string_visitor{bv, out});
+}
+
+void write_json_string(const abstract_type& t, const managed_bytes_view& mbv, std::string& out) {
+    if (mbv.current_fragment().size() == mbv.size_bytes()) {
+        write_json_string(t, mbv.current_fragment(), out);
+    } else {
+        write_json_string(t, linearized(mbv), out);
+    }
+}
+
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
-    return visit(t, to_json_string_visitor{bv});
+    std::string out;
+    write_json_string(t, bv, out);
+    return sstring(out.data(), out.size());
 }
 
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
-    return visit(t, to_json_string_visitor{linearized(mbv)});
+    std::string out;
+    write_json_string(t, mbv, out);
+    return sstring(out.data(), out.size());
 }
@@ -12,6 +12,11 @@
 #include "utils/rjson.hh"
 
 bytes from_json_object(const abstract_type &t, const rjson::value& value, cql_serialization_format sf);
+// Appends the JSON representation of a value to out. Nested values are
+// written straight into out, without a string of their own.
+void write_json_string(const abstract_type& t, bytes_view bv, std::string& out);
+void write_json_string(const abstract_type& t, const managed_bytes_view& bv, std::string& out);
+
 sstring to_json_string(const abstract_type &t, bytes_view bv);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
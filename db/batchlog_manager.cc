@@ -43,6 +43,7 @@
 #include "cql3/untyped_result_set.hh"
 #include "service_permit.hh"
 #include "cql3/query_processor.hh"
+#include "replica/database.hh"
 
 static logging::logger blogger("batchlog_manager");
 
@@ -296,18 +297,13 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
                 });
             });
         }).then([this] {
-        // TODO FIXME : cleanup()
-#if 0
-            ColumnFamilyStore cfs = Keyspace.open(SystemKeyspace.NAME).getColumnFamilyStore(SystemKeyspace.BATCHLOG);
-            cfs.forceBlockingFlush();
-            Collection<Descriptor> descriptors = new ArrayList<>();
-            for (SSTableReader sstr : cfs.getSSTables())
-            descriptors.add(sstr.descriptor);
-            if (!descriptors.isEmpty()) // don't pollute the logs if there is nothing to compact.
-            CompactionManager.instance.submitUserDefined(cfs, descriptors, Integer.MAX_VALUE).get();
-
-#endif
-
+            // Batches are removed with partition tombstones, so the batchlog
+            // fills with them and replay has to scan past them. The batchlog
+            // has a gc_grace_seconds of 0, so a major compaction of it drops
+            // the tombstones, along with the batches they shadow, and leaves
+            // only batches still awaiting replay for the next round.
+            auto& cf = _qp.db().real_database().find_column_family(system_keyspace::NAME, system_keyspace::BATCHLOG);
+            return cf.compact_all_sstables();
         }).then([this] {
             blogger.debug("Finished replayAllFailedBatches");
         });
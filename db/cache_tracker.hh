@@ -9,13 +9,16 @@
 #pragma once
 
 #include "utils/lru.hh"
+#include "utils/frequency_sketch.hh"
 #include "utils/logalloc.hh"
 #include "partition_version.hh"
 #include "mutation_cleaner.hh"
+#include "utils/UUID.hh"
 
 #include <seastar/core/metrics_registration.hh>
 
 #include <stdint.h>
+#include <unordered_map>
 
 class cache_entry;
 
@@ -66,38 +69,102 @@ class cache_tracker final {
         uint64_t pinned_dirty_memory_overload;
         uint64_t range_tombstone_reads;
         uint64_t row_tombstone_reads;
+        uint64_t probationary_reads;
+        uint64_t probationary_row_insertions;
+        uint64_t row_promotions;
+        uint64_t reserved_row_deferrals;
+        // Reads of partitions with more than one version, and the versions they
+        // had to merge on the fly, which is the MVCC amplification of reads.
+        uint64_t multi_version_reads;
+        uint64_t multi_version_read_versions;
 
         uint64_t active_reads() const {
             return reads - reads_done;
         }
     };
+    // The partitions of a table in the cache, and its quotas, from the
+    // caching options of its schema.
+    //
+    // Occupancy is measured in partitions rather than bytes: all tables share
+    // one LSA region and the LRU, in which an entry doesn't know the table it
+    // belongs to, so memory can't be attributed to tables cheaply. The fractions
+    // are of the partitions of all tables, the same measure as the size reported
+    // by the cache_service API.
+    //
+    // The quotas are enforced through the LRU. Reads of a table over its
+    // max_fraction are probationary, so their entries are evicted before those
+    // of other tables. Reads of a table under its min_fraction aren't, and the
+    // eviction of its rows is deferred (see defer_eviction()).
+    struct table_stats {
+        uint64_t partitions = 0;
+        uint64_t partition_evictions = 0;
+        double min_fraction = 0;
+        double max_fraction = 1;
+        // The number of row_cache objects of the table using this tracker.
+        unsigned caches = 0;
+    };
 private:
     stats _stats{};
     seastar::metrics::metric_groups _metrics;
     logalloc::region _region;
     lru _lru;
+    // Frequency of single-partition reads, by partition, see admit().
+    utils::frequency_sketch _read_frequency;
+    std::unordered_map<utils::UUID, table_stats> _tables;
+    unsigned _tables_with_reservation = 0;
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
 private:
     void setup_metrics();
+    table_stats* find_table(const schema&) noexcept;
 public:
     using register_metrics = bool_class<class register_metrics_tag>;
     cache_tracker(mutation_application_stats&, register_metrics);
     cache_tracker(register_metrics = register_metrics::no);
     ~cache_tracker();
     void clear();
-    void touch(rows_entry&);
-    void insert(cache_entry&);
-    void insert(partition_entry&) noexcept;
-    void insert(partition_version&) noexcept;
-    void insert(rows_entry&) noexcept;
+    // Rows are inserted into and touched within either segment of the LRU, see lru.
+    //
+    // Reads which are not known to be repeated (scans, and reads of a partition
+    // which was not read recently) are probationary: the entries they populate
+    // go to the probationary segment and the entries they touch stay in their
+    // segment. Other touches promote entries to the protected segment.
+    //
+    // Eviction must go from older versions to newer, so entries cannot be inserted
+    // into the probationary segment when the partition has older versions, which
+    // may have entries in the protected one.
+    void touch(rows_entry&, bool promote = true);
+    void insert(cache_entry&, bool probationary = false);
+    void insert(partition_entry&, bool probationary = false) noexcept;
+    void insert(partition_version&, bool probationary = false) noexcept;
+    void insert(rows_entry&, bool probationary = false) noexcept;
+    // Records a single-partition read of the given partition key hash.
+    // Returns true if the read should be probationary.
+    bool admit(uint64_t key_hash) noexcept;
+    // Estimates the number of recent single-partition reads of the given partition key hash.
+    unsigned read_frequency(uint64_t key_hash) const noexcept { return _read_frequency.frequency(key_hash); }
+    // The partition key hash used by admit() and read_frequency().
+    static uint64_t key_hash(const schema&, const dht::decorated_key&) noexcept;
+    // Called by row_cache for its table, see table_stats.
+    void register_table(const schema&);
+    void unregister_table(const schema&) noexcept;
+    // Applies the quotas of the table's caching options.
+    void update_table_quotas(const schema&) noexcept;
+    // Returns whether a read of the table should be probationary, given whether
+    // it would be regardless of the table's quotas.
+    bool is_probationary(const schema&, bool probationary) noexcept;
+    // Returns true, after moving the entry to the front of the protected segment
+    // of the LRU, if the entry belongs to a table under its min_fraction.
+    bool defer_eviction(rows_entry&) noexcept;
+    // Returns nullptr if no row_cache of the table uses this tracker.
+    const table_stats* get_table_stats(const utils::UUID& table_id) const noexcept;
     void on_remove() noexcept;
     void clear_continuity(cache_entry& ce) noexcept;
-    void on_partition_erase() noexcept;
+    void on_partition_erase(const schema&) noexcept;
     void on_partition_merge() noexcept;
     void on_partition_hit() noexcept;
     void on_partition_miss() noexcept;
-    void on_partition_eviction() noexcept;
+    void on_partition_eviction(const schema&) noexcept;
     void on_row_eviction() noexcept;
     void on_row_hit() noexcept;
     void on_dummy_row_hit() noexcept;
@@ -109,6 +176,7 @@ class cache_tracker final {
     void on_row_merged_from_memtable() noexcept { ++_stats.rows_merged_from_memtable; }
     void on_range_tombstone_read() noexcept { ++_stats.range_tombstone_reads; }
     void on_row_tombstone_read() noexcept { ++_stats.row_tombstone_reads; }
+    void on_partition_snapshot_read(unsigned versions) noexcept;
     void pinned_dirty_memory_overload(uint64_t bytes) noexcept;
     allocation_strategy& allocator() noexcept;
     logalloc::region& region() noexcept;
@@ -128,22 +196,30 @@ void cache_tracker::on_remove() noexcept {
 }
 
 inline
-void cache_tracker::insert(rows_entry& entry) noexcept {
+void cache_tracker::insert(rows_entry& entry, bool probationary) noexcept {
     ++_stats.row_insertions;
     ++_stats.rows;
-    _lru.add(entry);
+    entry.set_probationary(probationary);
+    if (probationary) {
+        ++_stats.probationary_row_insertions;
+        _lru.add_probationary(entry);
+    } else {
+        _lru.add(entry);
+    }
 }
 
 inline
-void cache_tracker::insert(partition_version& pv) noexcept {
+void cache_tracker::insert(partition_version& pv, bool probationary) noexcept {
     for (rows_entry& row : pv.partition().clustered_rows()) {
-        insert(row);
+        insert(row, probationary);
     }
 }
 
 inline
-void cache_tracker::insert(partition_entry& pe) noexcept {
+void cache_tracker::insert(partition_entry& pe, bool probationary) noexcept {
+    // Only a partition with a single version may go to the probationary segment.
+    probationary = probationary && !pe.version()->next();
     for (partition_version& pv : pe.versions_from_oldest()) {
-        insert(pv);
+        insert(pv, probationary);
     }
 }
@@ -35,6 +35,7 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/net/byteorder.hh>
 #include <seastar/util/defer.hh>
@@ -60,6 +61,8 @@
 
 #include "checked-file-impl.hh"
 #include "utils/disk-error-handler.hh"
+#include "utils/histogram_metrics_helper.hh"
+#include "utils/dma_buffer_pool.hh"
 
 static logging::logger clogger("commitlog");
 
@@ -105,7 +108,10 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_total_space_in_mb = cfg.commitlog_total_space_in_mb() >= 0 ? cfg.commitlog_total_space_in_mb() : (shard_available_memory * smp::count) >> 20;
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
-    c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
+    c.mode = cfg.commitlog_sync() == "batch" || cfg.commitlog_sync() == "group" ? sync_mode::BATCH : sync_mode::PERIODIC;
+    if (cfg.commitlog_sync() == "group") {
+        c.max_group_commit_window = std::chrono::microseconds(cfg.commitlog_sync_group_window_in_us());
+    }
     c.extensions = &cfg.extensions();
     c.reuse_segments = cfg.commitlog_reuse_segments();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
@@ -295,10 +301,41 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         // size allocated on disk - i.e. files created (new, reserve, recycled)
         uint64_t total_size_on_disk = 0;
         uint64_t requests_blocked_memory = 0;
+        // batch mode: allocations written by each sync, and the time (in
+        // microseconds) writes waited for their sync.
+        utils::approx_exponential_histogram<1, 4096, 1> sync_batch_size;
+        utils::approx_exponential_histogram<16, 33554432, 4> sync_wait_time;
     };
 
     stats totals;
 
+    // batch mode: moving averages of the time between writes, and of the
+    // time a sync takes, from which the group commit window is sized.
+    using batch_clock = std::chrono::steady_clock;
+    batch_clock::time_point _last_batch_write;
+    std::chrono::microseconds _batch_write_interval = std::chrono::seconds(1);
+    std::chrono::microseconds _batch_sync_latency{0};
+
+    void account_batch_write(batch_clock::time_point now) {
+        auto interval = std::chrono::duration_cast<std::chrono::microseconds>(now - _last_batch_write);
+        _batch_write_interval += (std::min<std::chrono::microseconds>(interval, std::chrono::seconds(1)) - _batch_write_interval) / 8;
+        _last_batch_write = now;
+    }
+    void account_batch_sync(batch_clock::duration latency, size_t allocations) {
+        _batch_sync_latency += (std::chrono::duration_cast<std::chrono::microseconds>(latency) - _batch_sync_latency) / 8;
+        totals.sync_batch_size.add(allocations);
+    }
+    // How long the first write of a batch waits for more writes to join its
+    // sync. Waiting only pays off when writes arrive faster than the disk
+    // syncs them, and is kept to half a sync, so that it costs less latency
+    // than the syncs it saves.
+    std::chrono::microseconds group_commit_window() const {
+        if (_batch_write_interval >= _batch_sync_latency) {
+            return std::chrono::microseconds(0);
+        }
+        return std::min(cfg.max_group_commit_window, _batch_sync_latency / 2);
+    }
+
     size_t pending_allocations() const {
         return _request_controller.waiters();
     }
@@ -510,6 +547,10 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
     uint64_t _num_allocs = 0;
 
+    // Set while the first write of a batch waits out the group commit
+    // window. Writes added to the buffer meanwhile wait for its sync.
+    std::optional<shared_promise<>> _group_commit;
+
     std::unordered_set<table_schema_version> _known_schema_versions;
 
     friend std::ostream& operator<<(std::ostream&, const segment&);
@@ -887,32 +928,60 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
          *
          * This has the benefit of allowing several allocations to
          * queue up in a single buffer.
+         *
+         * With group commit, the first write of a buffer also waits for
+         * the group commit window before syncing, and the writes which fill
+         * the buffer meanwhile wait for that sync instead of issuing their
+         * own.
          */
         auto me = shared_from_this();
         auto fp = _file_pos;
+        auto start = segment_manager::batch_clock::now();
+        _segment_manager->account_batch_write(start);
+        std::optional<shared_promise<>> group;
         try {
             co_await _pending_ops.wait_for_pending(timeout);
-            if (fp != _file_pos) {
-                // some other request already wrote this buffer.
-                // If so, wait for the operation at our intended file offset
-                // to finish, then we know the flush is complete and we
-                // are in accord.
-                // (Note: wait_for_pending(pos) waits for operation _at_ pos (and before),
-                replay_position rp(_desc.id, position_type(fp));
-                co_await _pending_ops.wait_for_pending(rp, timeout);
-                
-                assert(_segment_manager->cfg.mode != sync_mode::BATCH || _flush_pos > fp);
-                if (_flush_pos <= fp) {
-                    // previous op we were waiting for was not sync one, so it did not flush
-                    // force flush here
-                    co_await do_flush(fp);
-                }
+            if (fp == _file_pos && _group_commit) {
+                co_await with_timeout(timeout, _group_commit->get_shared_future());
             } else {
-                // It is ok to leave the sync behind on timeout because there will be at most one
-                // such sync, all later allocations will block on _pending_ops until it is done.
-                co_await with_timeout(timeout, sync());
+                if (fp == _file_pos) {
+                    if (auto window = _segment_manager->group_commit_window(); window.count()) {
+                        _group_commit.emplace();
+                        co_await sleep(window);
+                        group = std::exchange(_group_commit, std::nullopt);
+                    }
+                }
+                if (fp != _file_pos) {
+                    // some other request already wrote this buffer.
+                    // If so, wait for the operation at our intended file offset
+                    // to finish, then we know the flush is complete and we
+                    // are in accord.
+                    // (Note: wait_for_pending(pos) waits for operation _at_ pos (and before),
+                    replay_position rp(_desc.id, position_type(fp));
+                    co_await _pending_ops.wait_for_pending(rp, timeout);
+
+                    assert(_segment_manager->cfg.mode != sync_mode::BATCH || _flush_pos > fp);
+                    if (_flush_pos <= fp) {
+                        // previous op we were waiting for was not sync one, so it did not flush
+                        // force flush here
+                        co_await do_flush(fp);
+                    }
+                } else {
+                    // It is ok to leave the sync behind on timeout because there will be at most one
+                    // such sync, all later allocations will block on _pending_ops until it is done.
+                    auto allocations = _num_allocs;
+                    auto sync_start = segment_manager::batch_clock::now();
+                    co_await with_timeout(timeout, sync());
+                    _segment_manager->account_batch_sync(segment_manager::batch_clock::now() - sync_start, allocations);
+                }
+                if (group) {
+                    group->set_value();
+                }
             }
         } catch (...) {
+            if (group) {
+                group->set_exception(std::current_exception());
+            }
             // If we get an IO exception (which we assume this is)
             // we should close the segment.
             // TODO: should we also trunctate away any partial write
@@ -920,6 +989,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             me->_closed = true; // just mark segment as closed, no writes will be done.
             throw;
         };
+        _segment_manager->totals.sync_wait_time.add(std::chrono::duration_cast<std::chrono::microseconds>(
+                segment_manager::batch_clock::now() - start).count());
         co_return me;
     }
 
@@ -1367,6 +1438,15 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
 
         sm::make_gauge("memory_buffer_bytes", totals.buffer_list_bytes,
                        sm::description("Holds the total number of bytes in internal memory buffers.")),
+
+        sm::make_histogram("sync_batch_size", [this] { return to_metrics_histogram(totals.sync_batch_size); },
+                       sm::description("Histogram of the number of allocations written to disk by each sync in batch mode.")),
+
+        sm::make_histogram("sync_wait_time", [this] { return to_metrics_histogram(totals.sync_wait_time); },
+                       sm::description("Histogram of the time, in microseconds, writes waited for their data to be synced in batch mode.")),
+
+        sm::make_gauge("group_commit_window", [this] { return group_commit_window().count(); },
+                       sm::description("Holds the time, in microseconds, the first write of a batch currently waits for others to join its sync.")),
     });
 }
 
@@ -2104,7 +2184,7 @@ uint64_t db::commitlog::segment_manager::get_num_active_segments() const {
 }
 
 temporary_buffer<char> db::commitlog::segment_manager::allocate_single_buffer(size_t s, size_t alignment) {
-    return temporary_buffer<char>::aligned(alignment, s);
+    return utils::local_dma_buffer_pool().allocate(s, alignment);
 }
 
 db::commitlog::segment_manager::buffer_type db::commitlog::segment_manager::acquire_buffer(size_t s, size_t alignment) {
@@ -107,6 +107,10 @@ class commitlog {
         uint64_t max_active_flushes = 0;
 
         sync_mode mode = sync_mode::PERIODIC;
+        // In batch mode, the longest time the first write of a batch waits
+        // for others to join its sync (group commit). The actual wait adapts
+        // to the rate of writes and the latency of syncs. Zero never waits.
+        std::chrono::microseconds max_group_commit_window{0};
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool reuse_segments = true;
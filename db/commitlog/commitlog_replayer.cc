@@ -18,6 +18,8 @@
 
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/loop.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -55,6 +57,15 @@ class db::commitlog_replayer::impl {
 
     future<> init();
 
+    // Mutations are applied on their shard in the background, so that
+    // reading and deserializing a segment goes on while they are, up to
+    // this much memory of entries read but not yet applied per segment.
+    // Mutations commute, so the order in which they are applied doesn't
+    // matter.
+    static constexpr size_t max_pending_apply_memory = 16 << 20;
+    // Segments replayed at the same time by each shard.
+    static constexpr size_t max_concurrent_segments = 2;
+
     struct stats {
         uint64_t invalid_mutations = 0;
         uint64_t skipped_mutations = 0;
@@ -84,7 +95,7 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    future<> process(stats*, semaphore& pending, commitlog::buffer_and_replay_position buf_rp) const;
     future<stats> recover(sstring file, const sstring& fname_prefix) const;
 
     typedef std::unordered_map<utils::UUID, replay_position> rp_map;
@@ -196,23 +207,27 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
     }
 
     auto s = make_lw_shared<stats>();
+    auto pending = make_lw_shared<semaphore>(max_pending_apply_memory);
     auto& exts = _db.local().extensions();
 
     return db::commitlog::read_log_file(file, fname_prefix, service::get_local_commitlog_priority(),
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
-        try {
-            f.get();
-        } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (...) {
-            throw;
-        }
-        return make_ready_future<stats>(*s);
+            std::bind(&impl::process, this, s.get(), std::ref(*pending), std::placeholders::_1),
+            p, &exts).then_wrapped([s, pending](future<> f) {
+        // Wait for the mutations still being applied.
+        return pending->wait(max_pending_apply_memory).then([s, pending, f = std::move(f)] () mutable {
+            try {
+                f.get();
+            } catch (commitlog::segment_data_corruption_error& e) {
+                s->corrupt_bytes += e.bytes();
+            } catch (...) {
+                throw;
+            }
+            return make_ready_future<stats>(*s);
+        });
     });
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::process(stats* s, semaphore& pending, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -247,50 +262,55 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
         }
 
         auto shard = _db.local().shard_of(fm);
-        return _db.invoke_on(shard, [this, cer = std::move(cer), &src_cm, rp, shard, s] (replica::database& db) mutable -> future<> {
-            auto& fm = cer.mutation();
-            // TODO: might need better verification that the deserialized mutation
-            // is schema compatible. My guess is that just applying the mutation
-            // will not do this.
-            auto& cf = db.find_column_family(fm.column_family_id());
-
-            if (rlogger.is_enabled(logging::log_level::debug)) {
-                rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-            }
-            if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-            }
-            // Removed forwarding "new" RP. Instead give none/empty.
-            // This is what origin does, and it should be fine.
-            // The end result should be that once sstables are flushed out
-            // their "replay_position" attribute will be empty, which is
-            // lower than anything the new session will produce.
-            if (cf.schema()->version() != fm.schema_version()) {
-                auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                const column_mapping& cm = cm_it->second;
-                mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
-            } else {
-                return do_with(std::move(cer).mutation(), [&](const frozen_mutation& m) {
-                    return db.apply_in_memory(m, cf.schema(), db::rp_handle(), db::no_timeout);
-                });
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
-            }
+        auto memory = std::min(buf.size_bytes(), max_pending_apply_memory);
+        return get_units(pending, memory).then([this, cer = std::move(cer), &src_cm, rp, shard, s] (semaphore_units<> units) mutable {
+            // Not waited for, see max_pending_apply_memory. The units are
+            // released when the mutation is applied.
+            (void)_db.invoke_on(shard, [this, cer = std::move(cer), &src_cm, rp, shard, s] (replica::database& db) mutable -> future<> {
+                auto& fm = cer.mutation();
+                // TODO: might need better verification that the deserialized mutation
+                // is schema compatible. My guess is that just applying the mutation
+                // will not do this.
+                auto& cf = db.find_column_family(fm.column_family_id());
+
+                if (rlogger.is_enabled(logging::log_level::debug)) {
+                    rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                            cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
+                }
+                if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+                    throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                            fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
+                }
+                // Removed forwarding "new" RP. Instead give none/empty.
+                // This is what origin does, and it should be fine.
+                // The end result should be that once sstables are flushed out
+                // their "replay_position" attribute will be empty, which is
+                // lower than anything the new session will produce.
+                if (cf.schema()->version() != fm.schema_version()) {
+                    auto& local_cm = _column_mappings.local().map;
+                    auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
+                    const column_mapping& cm = cm_it->second;
+                    mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+                    converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+                    fm.partition().accept(cm, v);
+                    return do_with(std::move(m), [&db, &cf] (const mutation& m) {
+                        return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+                    });
+                } else {
+                    return do_with(std::move(cer).mutation(), [&](const frozen_mutation& m) {
+                        return db.apply_in_memory(m, cf.schema(), db::rp_handle(), db::no_timeout);
+                    });
+                }
+            }).then_wrapped([s, units = std::move(units)] (future<> f) {
+                try {
+                    f.get();
+                    s->applied_mutations++;
+                } catch (...) {
+                    s->invalid_mutations++;
+                    // TODO: write mutation to file like origin.
+                    rlogger.warn("error replaying: {}", std::current_exception());
+                }
+            });
         });
     } catch (replica::no_such_column_family&) {
         // No such CF now? Origin just ignores this.
@@ -341,11 +361,11 @@ future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fna
             return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
                 return smp::submit_to(id, [this, id, map, &fname_prefix] () {
                     auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
+                    // A few segments at a time per shard, to limit mutation congestion.
+                    // Applying their mutations is pipelined with reading them anyway,
+                    // see impl::max_pending_apply_memory.
                     auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
+                    return max_concurrent_for_each(range.first, range.second, impl::max_concurrent_segments, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
                         auto&f = p.second;
                         rlogger.debug("Replaying {}", f);
                         return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
@@ -282,6 +282,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
         "If set to true, enforce the min_threshold option for compactions strictly. If false (default), Scylla may decide to compact even if below min_threshold")
+    , compaction_split_unpurgeable_tombstones(this, "compaction_split_unpurgeable_tombstones", liveness::LiveUpdate, value_status::Used, false,
+        "If set to true, regular and major compactions of tables without leveled or incremental sstable runs write expired tombstones, which cannot be purged yet because they may shadow data in sstables not taking part in the compaction, to a separate sstable rather than to the compaction's output. The small tombstone sstables are compacted, and their tombstones purged, like any other sstable.")
+    , compaction_read_latency_slo_in_ms(this, "compaction_read_latency_slo_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller also watches the p99 latency of reads on each shard, reducing compaction shares while it is above this value and increasing them while it is well below. Ignored if compaction_static_shares is set.")
     /* Initialization properties */
     /* The minimal properties needed for configuring a cluster. */
     , cluster_name(this, "cluster_name", value_status::Used, "",
@@ -308,7 +312,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "The directory where hints files are stored if hinted handoff is enabled.")
     , view_hints_directory(this, "view_hints_directory", value_status::Used, "",
         "The directory where materialized-view updates are stored while a view replica is unreachable.")
-    , saved_caches_directory(this, "saved_caches_directory", value_status::Unused, "",
+    , saved_caches_directory(this, "saved_caches_directory", value_status::Used, "",
         "The directory location where table key and row caches are stored.")
     /* Commonly used properties */
     /* Properties most frequently used when configuring Scylla. */
@@ -411,6 +415,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\n"
         "\tperiodic : Used with commitlog_sync_period_in_ms (Default: 10000 - 10 seconds ) to control how often the commit log is synchronized to disk. Periodic syncs are acknowledged immediately.\n"
         "\tbatch : Used with commitlog_sync_batch_window_in_ms (Default: disabled **) to control how long Scylla waits for other writes before performing a sync. When using this method, writes are not acknowledged until fsynced to disk.\n"
+        "\tgroup : Like batch, but the first write of each sync waits up to commitlog_sync_group_window_in_us for other writes to join it, for as long as writes arrive faster than the disk syncs them.\n"
         "Related information: Durability")
     , commitlog_segment_size_in_mb(this, "commitlog_segment_size_in_mb", value_status::Used, 64,
         "Sets the size of the individual commitlog file segments. A commitlog segment may be archived, deleted, or recycled after all its data has been flushed to SSTables. This amount of data can potentially include commitlog segments from every table in the system. The default size is usually suitable for most commitlog archiving, but if you want a finer granularity, 8 or 16 MB is reasonable. See Commit log archive configuration.\n"
@@ -421,6 +426,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in \"batch\" mode.")
+    , commitlog_sync_group_window_in_us(this, "commitlog_sync_group_window_in_us", value_status::Used, 500,
+        "The longest time, in microseconds, a write waits for other writes to join its sync in \"group\" mode. The wait is half the recent sync latency, within this limit, "
+        "and there is none while writes arrive more slowly than syncs complete.")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "Related information: Configuring memtable throughput")
@@ -525,12 +533,14 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , key_cache_size_in_mb(this, "key_cache_size_in_mb", value_status::Unused, 100,
         "A global cache setting for tables. It is the maximum size of the key cache in memory. To disable set to 0.\n"
         "Related information: nodetool setcachecapacity.")
-    , row_cache_keys_to_save(this, "row_cache_keys_to_save", value_status::Unused, 0,
-        "Number of keys from the row cache to save.")
+    , row_cache_keys_to_save(this, "row_cache_keys_to_save", liveness::LiveUpdate, value_status::Used, 0,
+        "Number of keys from the row cache to save. They are the keys of the partitions read most often, and are read back into the cache on start. (0: all sampled keys)")
     , row_cache_size_in_mb(this, "row_cache_size_in_mb", value_status::Unused, 0,
         "Maximum size of the row cache in memory. Row cache can save more time than key_cache_size_in_mb, but is space-intensive because it contains the entire row. Use the row cache only for hot rows or static rows. If you reduce the size, you may not get you hottest keys loaded on start up.")
-    , row_cache_save_period(this, "row_cache_save_period", value_status::Unused, 0,
-        "Duration in seconds that rows are saved in cache. Caches are saved to saved_caches_directory.")
+    , row_cache_save_period(this, "row_cache_save_period", liveness::LiveUpdate, value_status::Used, 0,
+        "Duration in seconds that rows are saved in cache. Caches are saved to saved_caches_directory. (0: disabled)")
+    , row_cache_preload_keys_per_second(this, "row_cache_preload_keys_per_second", liveness::LiveUpdate, value_status::Used, 100,
+        "Maximum rate, per shard, at which the partitions of the keys saved from the row cache are read back into it on start. (0: disabled)")
     , memory_allocator(this, "memory_allocator", value_status::Invalid, "NativeAllocator",
         "The off-heap memory allocator. In addition to caches, this property affects storage engine meta data. Supported values:\n"
         "\tNativeAllocator\n"
@@ -540,8 +550,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Counter caches properties */
     /* Counter cache helps to reduce counter locks' contention for hot counter cells. In case of RF = 1 a counter cache hit will cause Cassandra to skip the read before write entirely. With RF > 1 a counter cache hit will still help to reduce the duration of the lock hold, helping with hot counter cell updates, but will not allow skipping the read entirely. Only the local (clock, count) tuple of a counter cell is kept in memory, not the whole counter, so it's relatively cheap. */
     /* Note: Reducing the size counter cache may result in not getting the hottest keys loaded on start-up. */
-    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", value_status::Unused, 0,
-        "When no value is specified a minimum of 2.5% of Heap or 50MB. If you perform counter deletes and rely on low gc_grace_seconds, you should disable the counter cache. To disable, set to 0")
+    , counter_cache_size_in_mb(this, "counter_cache_size_in_mb", value_status::Used, 50,
+        "Memory in MB, split among the shards, for caching the local shards of the recently updated counter cells. Counter updates which find all their cells in the cache skip the read before write. If you perform counter deletes and rely on low gc_grace_seconds, you should disable the counter cache. To disable, set to 0")
     , counter_cache_save_period(this, "counter_cache_save_period", value_status::Unused, 7200,
         "Duration after which Cassandra should save the counter cache (keys only). Caches are saved to saved_caches_directory.")
     , counter_cache_keys_to_save(this, "counter_cache_keys_to_save", value_status::Unused, 0,
@@ -591,6 +601,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tall: All traffic is compressed.\n"
         "\tdc : Traffic between data centers is compressed.\n"
         "\tnone : No compression.")
+    , internode_compression_zstd_level(this, "internode_compression_zstd_level", value_status::Used, 0,
+        "When non-zero, compressed traffic to other data centers uses zstd at this level, from 1 to 19, instead of LZ4. Higher levels compress better at a higher CPU cost. Traffic within a data center, and to nodes which don't support zstd, stays on LZ4.")
+    , internode_shard_aware_connections(this, "internode_shard_aware_connections", value_status::Used, false,
+        "Send writes and single-partition reads over connections to the shard of the replica which owns the data, saving the replica a cross-shard hop. Each shard then keeps a connection to every shard of every peer, per connection type, so this is meant for clusters with few nodes or few shards per node.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
@@ -644,6 +658,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tYour own RPC server: You must provide a fully-qualified class name of an o.a.c.t.TServerFactory that can create a server instance.")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be choosen based on cache hit ratio")
+    , latency_aware_read_balancing(this, "latency_aware_read_balancing", liveness::LiveUpdate, value_status::Used, true,
+        "This boolean controls whether reads avoid replicas which recently answered reads of the table much slower than the replica they could speculate on, and speculate earlier when all replicas they wait for are fast")
+    , forward_requests_to_owning_shard(this, "forward_requests_to_owning_shard", liveness::LiveUpdate, value_status::Used, true,
+        "Execute prepared statements which read or write a single partition which this node is a replica of on the shard owning the partition, if they were received on another shard")
+    , max_concurrent_partition_reads_per_query(this, "max_concurrent_partition_reads_per_query", liveness::LiveUpdate, value_status::Used, 100,
+        "The maximum number of partitions a coordinator reads at the same time for a query of several partition keys, like a SELECT with IN on the partition key. Partitions are read in the order of the results, and those past the end of a page are not read")
     /* Advanced fault detection settings */
     /* Settings to handle poorly performing or failing nodes. */
     , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", value_status::Unused, 0,
@@ -782,6 +802,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , override_decommission(this, "override_decommission", value_status::Used, false, "Set true to force a decommissioned node to join the cluster")
     , enable_repair_based_node_ops(this, "enable_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, true, "Set true to use enable repair based node operations instead of streaming based")
     , allowed_repair_based_node_ops(this, "allowed_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, "replace", "A comma separated list of node operations which are allowed to enable repair based node operations. The operations can be bootstrap, replace, removenode, decommission and rebuild")
+    , repair_skip_ranges_repaired_within_seconds(this, "repair_skip_ranges_repaired_within_seconds", liveness::LiveUpdate, value_status::Used, 0,
+        "Repair skips a range of a table if all its replicas were repaired less than this many seconds ago, as recorded in system.repair_history. "
+        "Running a repair that was interrupted, for example by a restart, again then resumes it from the ranges it didn't finish. Set to 0 to repair all ranges")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -793,14 +816,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , experimental(this, "experimental", value_status::Used, false, "[Deprecated] Set to true to unlock all experimental features (except 'raft' feature, which should be enabled explicitly via 'experimental-features' option). Please use 'experimental-features', instead.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step")
+    , lsa_background_reclaim_free_memory(this, "lsa_background_reclaim_free_memory", value_status::Used, 60000000,
+        "Amount of free memory, in bytes, which each shard reclaims in the background ahead of demand, so that allocations rarely have to compact or evict synchronously. Set to 0 to disable the background reclaim.")
+    , lsa_transparent_huge_pages(this, "lsa_transparent_huge_pages", value_status::Used, false,
+        "When set to true, asks the kernel to back the memory of each shard, where LSA segments are allocated, with transparent huge pages. This reduces TLB misses of the row cache and memtables. Has no effect when Scylla runs with --hugepages, whose memory is already made of huge pages.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
     , abort_on_lsa_bad_alloc(this, "abort_on_lsa_bad_alloc", value_status::Used, false, "Abort when allocation in LSA region fails")
     , murmur3_partitioner_ignore_msb_bits(this, "murmur3_partitioner_ignore_msb_bits", value_status::Used, 12, "Number of most siginificant token bits to ignore in murmur3 partitioner; increase for very large clusters")
     , virtual_dirty_soft_limit(this, "virtual_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of virtual dirty memory expressed as a portion of the hard limit")
+    , virtual_dirty_throttle_limit(this, "virtual_dirty_throttle_limit", value_status::Used, 0, "Portion of the hard limit of virtual dirty memory above which writes are delayed, increasingly, to match the rate at which memtables are flushed. 0 disables the throttling, so writes are only blocked at the hard limit")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default) "
         "bytes written to data file. Value must be between 0 and 1.")
+    , sstable_write_behind(this, "sstable_write_behind", value_status::Used, 10, "Maximum number of buffers written concurrently by each sstable component writer. "
+        "Serializing and compressing the next buffer proceeds while these writes are in flight, so a larger value keeps the disk busier during flushes and compactions "
+        "at the cost of up to that many buffers of memory per writer.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting")
@@ -808,8 +839,15 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , enable_sstable_split_block_bloom_filter(this, "enable_sstable_split_block_bloom_filter", value_status::Used, false, "Write sstable bloom filters in the split-block layout, which needs a single cache line per lookup."
+        " Such filters take slightly more memory for the same false positive chance and are ignored (treated as always matching) by versions which don't support them.")
+    , enable_compressed_data_cache(this, "enable_compressed_data_cache", value_status::Used, false, "Cache the compressed chunks of sstable Data files read by single-partition queries."
+        " The chunks are kept in the memory of the row cache and evicted with it, and take about as much space as they do on disk. Applies to sstables opened after the change.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building")
+    , view_flow_control_backlog_half_life_in_ms(this, "view_flow_control_backlog_half_life_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "Half-life of the moving average of each replica's view update backlog used to delay base writes."
+        " With 0, the last backlog reported by the replica is used, so the delay follows spikes in the backlog immediately.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"mc", "md", "me"})
@@ -832,6 +870,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "This is the hard limit, queries violating this limit will be aborted.")
     , initial_sstable_loading_concurrency(this, "initial_sstable_loading_concurrency", value_status::Used, 4u,
             "Maximum amount of sstables to load in parallel during initialization. A higher number can lead to more memory consumption. You should not need to touch this")
+    , load_sstable_filters_in_background(this, "load_sstable_filters_in_background", value_status::Used, false,
+            "Read the bloom filters of sstables found during initialization after the table is populated, instead of before. "
+            "This shortens startup on nodes with many sstables, at the cost of reads checking every sstable until the filters are read.")
     , enable_3_1_0_compatibility_mode(this, "enable_3_1_0_compatibility_mode", value_status::Used, false,
         "Set to true if the cluster was initially installed from 3.1.0. If it was upgraded from an earlier version,"
         " or installed from a later version, leave this set to false. This adjusts the communication protocol to"
@@ -851,6 +892,38 @@ db::config::config(std::shared_ptr<db::extensions> exts)
             "Bypass in-memory data cache (the row cache) when performing reversed queries.")
     , enable_optimized_reversed_reads(this, "enable_optimized_reversed_reads", liveness::LiveUpdate, value_status::Used, true,
             "Use a new optimized algorithm for performing reversed reads.")
+    , enable_timestamp_ordered_reads(this, "enable_timestamp_ordered_reads", liveness::LiveUpdate, value_status::Used, false,
+            "Read single rows from sstables in descending order of their maximum timestamp, and stop once the row read so far "
+            "is newer than anything the remaining sstables may contain.")
+    , memtable_flush_parallelism(this, "memtable_flush_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+            "Split the flush of a large memtable into up to this many token ranges, each written to an sstable of its own, "
+            "in parallel. Ranges are kept at 32MB of memtable memory at least. 1 writes a single sstable per flush.")
+    , cheap_read_sstables_threshold(this, "cheap_read_sstables_threshold", value_status::Used, 2,
+            "User reads estimated to read from fewer than this many sstables, counting reads of partitions fully in cache as reading none, "
+            "wait for admission in a queue of their own, ahead of the other reads, so that they are not held up behind expensive reads. "
+            "0 queues all reads together.")
+    , hot_partitions_sample_period(this, "hot_partitions_sample_period", value_status::Used, 100,
+            "Sample one in this many single partition reads and writes to keep track of the most read and written partitions "
+            "of each table, listed in system.hot_partitions. 0 disables tracking.")
+    , enable_hardware_counters(this, "enable_hardware_counters", value_status::Used, true,
+            "Count instructions, cycles, last level cache misses and branch mispredictions of each shard in user space, "
+            "using the kernel's perf events, and export them as metrics. Events the kernel doesn't give access to are not exported.")
+    , reshape_on_boot(this, "reshape_on_boot", value_status::Used, true,
+            "Reshape the sstables of user tables which don't fit their compaction strategy, as after restoring a backup, before the node "
+            "starts serving. When false, the node starts serving once sstables are resharded, and off-strategy compaction reshapes them "
+            "in the background, in the maintenance scheduling group, where its progress is listed with the other compactions.")
+    , index_cache_pinned_memory_fraction(this, "index_cache_pinned_memory_fraction", value_status::Used, 0.02,
+            "Fraction of each shard's memory in which the cached partition index pages of sstables hot with single partition reads "
+            "are kept when the cache evicts. Pages past it are evicted with the rest of the cache. 0 disables pinning.")
+    , dma_buffer_pool_memory_fraction(this, "dma_buffer_pool_memory_fraction", value_status::Used, 0.01,
+            "Fraction of each shard's memory which free aligned write buffers, kept for reuse by the commitlog and hints writers, "
+            "may hold. 0 disables the pool, and buffers are allocated and freed with every write.")
+    , batch_workload_cpu_shares(this, "batch_workload_cpu_shares", value_status::Used, 1000,
+            "CPU shares of the statements of service levels with workload_type 'batch', which run in their own scheduling group. "
+            "The statements of the other service levels run with 1000 shares. Has no effect when cpu_scheduler is disabled.")
+    , batch_workload_io_shares(this, "batch_workload_io_shares", value_status::Used, 200,
+            "I/O shares of the sstable reads of the statements of service levels with workload_type 'batch'. "
+            "The reads of the other service levels run with 1000 shares. Has no effect when cpu_scheduler is disabled.")
     , enable_cql_config_updates(this, "enable_cql_config_updates", liveness::LiveUpdate, value_status::Used, true,
             "Make the system.config table UPDATEable")
     , enable_parallelized_aggregation(this, "enable_parallelized_aggregation", liveness::LiveUpdate, value_status::Used, true,
@@ -136,6 +136,8 @@ class config : public utils::config_file {
     named_value<float> memtable_flush_static_shares;
     named_value<float> compaction_static_shares;
     named_value<bool> compaction_enforce_min_threshold;
+    named_value<bool> compaction_split_unpurgeable_tombstones;
+    named_value<uint32_t> compaction_read_latency_slo_in_ms;
     named_value<sstring> cluster_name;
     named_value<sstring> listen_address;
     named_value<sstring> listen_interface;
@@ -170,6 +172,7 @@ class config : public utils::config_file {
     named_value<uint32_t> commitlog_segment_size_in_mb;
     named_value<uint32_t> commitlog_sync_period_in_ms;
     named_value<uint32_t> commitlog_sync_batch_window_in_ms;
+    named_value<uint32_t> commitlog_sync_group_window_in_us;
     named_value<int64_t> commitlog_total_space_in_mb;
     named_value<bool> commitlog_reuse_segments;
     named_value<bool> commitlog_use_o_dsync;
@@ -212,6 +215,7 @@ class config : public utils::config_file {
     named_value<uint32_t> row_cache_keys_to_save;
     named_value<uint32_t> row_cache_size_in_mb;
     named_value<uint32_t> row_cache_save_period;
+    named_value<uint32_t> row_cache_preload_keys_per_second;
     named_value<sstring> memory_allocator;
     named_value<uint32_t> counter_cache_size_in_mb;
     named_value<uint32_t> counter_cache_save_period;
@@ -229,6 +233,8 @@ class config : public utils::config_file {
     named_value<uint32_t> internode_send_buff_size_in_bytes;
     named_value<uint32_t> internode_recv_buff_size_in_bytes;
     named_value<sstring> internode_compression;
+    named_value<int> internode_compression_zstd_level;
+    named_value<bool> internode_shard_aware_connections;
     named_value<bool> inter_dc_tcp_nodelay;
     named_value<uint32_t> streaming_socket_timeout_in_ms;
     named_value<bool> start_native_transport;
@@ -248,6 +254,9 @@ class config : public utils::config_file {
     named_value<uint32_t> rpc_send_buff_size_in_bytes;
     named_value<sstring> rpc_server_type;
     named_value<bool> cache_hit_rate_read_balancing;
+    named_value<bool> latency_aware_read_balancing;
+    named_value<bool> forward_requests_to_owning_shard;
+    named_value<uint32_t> max_concurrent_partition_reads_per_query;
     named_value<double> dynamic_snitch_badness_threshold;
     named_value<uint32_t> dynamic_snitch_reset_interval_in_ms;
     named_value<uint32_t> dynamic_snitch_update_interval_in_ms;
@@ -291,6 +300,7 @@ class config : public utils::config_file {
     named_value<bool> override_decommission;
     named_value<bool> enable_repair_based_node_ops;
     named_value<sstring> allowed_repair_based_node_ops;
+    named_value<uint32_t> repair_skip_ranges_repaired_within_seconds;
     named_value<uint32_t> ring_delay_ms;
     named_value<uint32_t> shadow_round_ms;
     named_value<uint32_t> fd_max_interval_ms;
@@ -302,20 +312,27 @@ class config : public utils::config_file {
     named_value<bool> experimental;
     named_value<std::vector<enum_option<experimental_features_t>>> experimental_features;
     named_value<size_t> lsa_reclamation_step;
+    named_value<size_t> lsa_background_reclaim_free_memory;
+    named_value<bool> lsa_transparent_huge_pages;
     named_value<uint16_t> prometheus_port;
     named_value<sstring> prometheus_address;
     named_value<sstring> prometheus_prefix;
     named_value<bool> abort_on_lsa_bad_alloc;
     named_value<unsigned> murmur3_partitioner_ignore_msb_bits;
     named_value<double> virtual_dirty_soft_limit;
+    named_value<double> virtual_dirty_throttle_limit;
     named_value<double> sstable_summary_ratio;
+    named_value<uint32_t> sstable_write_behind;
     named_value<size_t> large_memory_allocation_warning_threshold;
     named_value<bool> enable_deprecated_partitioners;
     named_value<bool> enable_keyspace_column_family_metrics;
     named_value<bool> enable_sstable_data_integrity_check;
     named_value<bool> enable_sstable_key_validation;
+    named_value<bool> enable_sstable_split_block_bloom_filter;
+    named_value<bool> enable_compressed_data_cache;
     named_value<bool> cpu_scheduler;
     named_value<bool> view_building;
+    named_value<uint32_t> view_flow_control_backlog_half_life_in_ms;
     named_value<bool> enable_sstables_mc_format;
     named_value<bool> enable_sstables_md_format;
     named_value<sstring> sstable_format;
@@ -328,6 +345,7 @@ class config : public utils::config_file {
     named_value<uint64_t> max_memory_for_unlimited_query_soft_limit;
     named_value<uint64_t> max_memory_for_unlimited_query_hard_limit;
     named_value<unsigned> initial_sstable_loading_concurrency;
+    named_value<bool> load_sstable_filters_in_background;
     named_value<bool> enable_3_1_0_compatibility_mode;
     named_value<bool> enable_user_defined_functions;
     named_value<unsigned> user_defined_function_time_limit_ms;
@@ -339,6 +357,16 @@ class config : public utils::config_file {
     named_value<tri_mode_restriction> strict_allow_filtering;
     named_value<bool> reversed_reads_auto_bypass_cache;
     named_value<bool> enable_optimized_reversed_reads;
+    named_value<bool> enable_timestamp_ordered_reads;
+    named_value<unsigned> memtable_flush_parallelism;
+    named_value<unsigned> cheap_read_sstables_threshold;
+    named_value<unsigned> hot_partitions_sample_period;
+    named_value<bool> enable_hardware_counters;
+    named_value<bool> reshape_on_boot;
+    named_value<double> index_cache_pinned_memory_fraction;
+    named_value<double> dma_buffer_pool_memory_fraction;
+    named_value<uint32_t> batch_workload_cpu_shares;
+    named_value<uint32_t> batch_workload_io_shares;
     named_value<bool> enable_cql_config_updates;
     named_value<bool> enable_parallelized_aggregation;
 
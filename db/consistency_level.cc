@@ -16,6 +16,7 @@
 
 #include <boost/range/algorithm/stable_partition.hpp>
 #include <boost/range/algorithm/find.hpp>
+#include <boost/range/algorithm/find_if.hpp>
 #include <boost/range/algorithm/transform.hpp>
 #include "exceptions/exceptions.hh"
 #include <seastar/core/sstring.hh>
@@ -342,6 +343,27 @@ filter_for_query(consistency_level cl,
             // local node is always first if present (see storage_proxy::get_live_sorted_endpoints)
             unsigned local_idx = epi[0].first == utils::fb_utilities::get_broadcast_address() ? 0 : epi.size() + 1;
             live_endpoints = boost::copy_range<inet_address_vector_replica_set>(miss_equalizing_combination(epi, local_idx, remaining_bf, bool(extra)));
+
+            // The data request goes to the first endpoint, the digest requests
+            // to the others. Move the warmest endpoint to the front, so that
+            // the data is read from its cache, while the colder ones warm up
+            // on digest reads. Endpoints with a similar hit rate keep their
+            // proximity order, to keep data reads local when possible.
+            if (remaining_bf > 1 && selected_endpoints.empty()) {
+                auto hit_rate_of = [&epi] (gms::inet_address ep) {
+                    return boost::find_if(epi, [ep] (const auto& e) { return e.first == ep; })->second;
+                };
+                auto warmest = live_endpoints.begin();
+                auto warmest_ht = hit_rate_of(*warmest);
+                for (auto it = warmest + 1; it != live_endpoints.begin() + remaining_bf; ++it) {
+                    auto ht = hit_rate_of(*it);
+                    if (ht > warmest_ht + 0.01) {
+                        warmest = it;
+                        warmest_ht = ht;
+                    }
+                }
+                std::rotate(live_endpoints.begin(), warmest, warmest + 1);
+            }
         }
     }
 
@@ -12,6 +12,12 @@
 
 #include <tuple>
 
+#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/algorithm/find_if.hpp>
+#include <boost/range/algorithm/min_element.hpp>
+#include <boost/range/numeric.hpp>
+
 extern logging::logger dblog;
 
 namespace db {
@@ -113,6 +119,74 @@ toppartitions_data_listener::localize(const global_top_k::results& r) {
     return n;
 }
 
+hot_partitions_tracker::hot_partitions_tracker(replica::database& db, unsigned sample_period)
+        : _db(db)
+        , _sample_period(sample_period)
+        , _countdown(sample_period)
+        , _decay_timer([this] { decay(); }) {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("hot_partitions", {
+        sm::make_derive("sampled_reads", _sampled_reads,
+                sm::description("Counts single partition reads sampled to track the most read partitions.")),
+        sm::make_derive("sampled_writes", _sampled_writes,
+                sm::description("Counts writes sampled to track the most written partitions.")),
+        sm::make_gauge("tracked_partitions", [this] {
+            return boost::accumulate(_tables | boost::adaptors::map_values | boost::adaptors::transformed(std::mem_fn(&std::vector<item>::size)), size_t(0));
+        }, sm::description("Holds the number of partitions tracked as candidates for the most read and written.")),
+    });
+    _decay_timer.arm_periodic(decay_period);
+    _db.data_listeners().install(this);
+}
+
+hot_partitions_tracker::~hot_partitions_tracker() {
+    _db.data_listeners().uninstall(this);
+}
+
+hot_partitions_tracker::item& hot_partitions_tracker::get_item(const schema& s, const dht::decorated_key& dk) {
+    auto& items = _tables[s.id()];
+    auto it = boost::find_if(items, [&] (const item& i) { return i.key.equal(s, dk); });
+    if (it != items.end()) {
+        return *it;
+    }
+    if (items.size() < max_partitions_per_table) {
+        return items.emplace_back(item{dk});
+    }
+    auto& min = *boost::min_element(items, [] (const item& a, const item& b) { return a.count() < b.count(); });
+    min.key = dk;
+    return min;
+}
+
+void hot_partitions_tracker::decay() {
+    for (auto it = _tables.begin(); it != _tables.end();) {
+        auto& items = it->second;
+        for (auto& i : items) {
+            i.reads /= 2;
+            i.writes /= 2;
+            i.write_bytes /= 2;
+        }
+        std::erase_if(items, [] (const item& i) { return !i.count(); });
+        it = items.empty() ? _tables.erase(it) : std::next(it);
+    }
+}
+
+flat_mutation_reader_v2 hot_partitions_tracker::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    if (range.is_singular() && range.start()->value().has_key() && sample()) {
+        ++_sampled_reads;
+        get_item(*s, range.start()->value().as_decorated_key()).reads += _sample_period;
+    }
+    return std::move(rd);
+}
+
+void hot_partitions_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    if (sample()) {
+        ++_sampled_writes;
+        auto& i = get_item(*s, m.decorated_key(*s));
+        i.writes += _sample_period;
+        i.write_bytes += uint64_t(m.representation().size()) * _sample_period;
+    }
+}
+
 toppartitions_query::toppartitions_query(distributed<replica::database>& xdb, std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash>&& table_filters,
         std::unordered_set<sstring>&& keyspace_filters, std::chrono::milliseconds duration, size_t list_size, size_t capacity)
         : _xdb(xdb), _table_filters(std::move(table_filters)), _keyspace_filters(std::move(keyspace_filters)), _duration(duration), _list_size(list_size), _capacity(capacity),
@@ -12,6 +12,9 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
 
 #include "utils/hash.hh"
 #include "schema_fwd.hh"
@@ -139,6 +142,64 @@ class toppartitions_data_listener : public data_listener, public weakly_referenc
     future<> stop();
 };
 
+// Keeps track, continuously, of the partitions of each table that are read
+// and written the most on this shard. One in sample_period reads and writes
+// is sampled, and only single partition reads are counted. The partitions
+// of a table are kept in a small list, space-saving style: a partition not
+// in a full list replaces the one with the lowest count, and takes over its
+// count. Counts are halved every decay_period, so that partitions which are
+// no longer hot drop out, and are scaled by sample_period, so that they
+// estimate the number of operations.
+class hot_partitions_tracker : public data_listener {
+public:
+    struct item {
+        dht::decorated_key key;
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t write_bytes = 0;
+
+        uint64_t count() const { return reads + writes; }
+    };
+
+    static constexpr size_t max_partitions_per_table = 32;
+    static constexpr std::chrono::seconds decay_period{60};
+
+private:
+    replica::database& _db;
+    const unsigned _sample_period;
+    unsigned _countdown;
+    std::unordered_map<utils::UUID, std::vector<item>> _tables;
+    timer<lowres_clock> _decay_timer;
+    uint64_t _sampled_reads = 0;
+    uint64_t _sampled_writes = 0;
+    metrics::metric_groups _metrics;
+
+    bool sample() noexcept {
+        if (--_countdown) {
+            return false;
+        }
+        _countdown = _sample_period;
+        return true;
+    }
+    item& get_item(const schema& s, const dht::decorated_key& dk);
+    void decay();
+
+public:
+    // sample_period must be positive.
+    hot_partitions_tracker(replica::database& db, unsigned sample_period);
+    ~hot_partitions_tracker();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    // The tracked partitions of each table, in no particular order.
+    const std::unordered_map<utils::UUID, std::vector<item>>& tables() const {
+        return _tables;
+    }
+};
+
 class toppartitions_query {
     distributed<replica::database>& _xdb;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
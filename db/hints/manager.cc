@@ -15,6 +15,7 @@
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
 #include <boost/range/adaptors.hpp>
+#include <boost/range/algorithm/sort.hpp>
 #include "utils/div_ceil.hh"
 #include "db/extensions.hh"
 #include "service/storage_proxy.hh"
@@ -83,6 +84,9 @@ void manager::register_metrics(const sstring& group_name) {
         sm::make_derive("corrupted_files", _stats.corrupted_files,
                         sm::description("Number of hints files that were discarded during sending because the file was corrupted.")),
 
+        sm::make_derive("throttled", _stats.throttled,
+                        sm::description("Number of hints whose sending was delayed because of the view update backlog of their destination.")),
+
         sm::make_gauge("pending_drains", 
                         sm::description("Number of tasks waiting in the queue for draining hints"),
                         [this] { return _drain_lock.waiters(); }),
@@ -145,11 +149,25 @@ void manager::forbid_hints() {
     boost::for_each(_ep_managers, [] (auto& pair) { pair.second.forbid_hints(); });
 }
 
-void manager::forbid_hints_for_eps_with_pending_hints() {
-    manager_logger.trace("space_watchdog: Going to block hints to: {}", _eps_with_pending_hints);
-    boost::for_each(_ep_managers, [this] (auto& pair) {
+void manager::forbid_hints_for_eps_with_pending_hints(size_t backlog, size_t max_backlog) {
+    // Block the end points with the most pending hints first, until what is
+    // left fits the quota. Those are the nodes which have been down the
+    // longest, so nodes which are down briefly keep being hinted even when a
+    // long dead one has filled the disk.
+    std::vector<std::pair<ep_key_type, size_t>> eps(_eps_with_pending_hints.begin(), _eps_with_pending_hints.end());
+    boost::sort(eps, [] (const auto& a, const auto& b) { return a.second > b.second; });
+    std::unordered_set<ep_key_type> blocked;
+    for (const auto& [ep, size] : eps) {
+        if (backlog < max_backlog) {
+            break;
+        }
+        blocked.insert(ep);
+        backlog -= std::min(backlog, size);
+    }
+    manager_logger.trace("space_watchdog: Going to block hints to: {}", blocked);
+    boost::for_each(_ep_managers, [&blocked] (auto& pair) {
         end_point_hints_manager& ep_man = pair.second;
-        if (has_ep_with_pending_hints(ep_man.end_point_key())) {
+        if (blocked.contains(ep_man.end_point_key())) {
             ep_man.forbid_hints();
         } else {
             ep_man.allow_hints();
@@ -549,6 +567,22 @@ future<> manager::end_point_hints_manager::sender::do_send_one_mutation(frozen_m
     });
 }
 
+future<> manager::end_point_hints_manager::sender::throttle_by_backlog() noexcept {
+    constexpr auto delay_limit_us = 1000000;
+    auto backlog = std::min(_proxy.get_backlog_of(end_point_key()).relative_size(), 1.0f);
+    std::chrono::microseconds delay(uint32_t(backlog * backlog * backlog * delay_limit_us));
+    if (delay.count() == 0) {
+        co_return;
+    }
+    ++shard_stats().throttled;
+    manager_logger.trace("Delaying sending the next hint to {} by {}us because of its view update backlog", end_point_key(), delay.count());
+    try {
+        co_await sleep_abortable(delay, _stop_as);
+    } catch (const seastar::sleep_aborted&) {
+        // stop() was called, send_one_file() checks can_send() next.
+    }
+}
+
 bool manager::end_point_hints_manager::sender::can_send() noexcept {
     if (stopping() && !draining()) {
         return false;
@@ -1066,6 +1100,7 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
                 } else {
+                    co_await throttle_by_backlog();
                     co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
                     break;
                 }
@@ -1335,7 +1370,7 @@ void manager::update_backlog(size_t backlog, size_t max_backlog) {
     if (backlog < max_backlog) {
         allow_hints();
     } else {
-        forbid_hints_for_eps_with_pending_hints();
+        forbid_hints_for_eps_with_pending_hints(backlog, max_backlog);
     }
 }
 
@@ -76,6 +76,7 @@ class manager {
         uint64_t sent = 0;
         uint64_t discarded = 0;
         uint64_t corrupted_files = 0;
+        uint64_t throttled = 0;
     };
 
     // map: shard -> segments
@@ -245,6 +246,14 @@ class manager {
             /// \return future that resolves when next hint may be sent
             future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
 
+            /// \brief Delays sending the next hint while the destination is behind with its view updates.
+            ///
+            /// The delay grows with the cube of the view update backlog the end point last reported, the same way
+            /// storage_proxy delays writes to base tables with backlogged replicas, so that replaying hints
+            /// doesn't overload a node which just came back.
+            /// \return Ready, never exceptional, future that resolves when the next hint may be sent.
+            future<> throttle_by_backlog() noexcept;
+
             /// \brief Send all hint from a single file and delete it after it has been successfully sent.
             /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
             /// iteration from where we left in this one.
@@ -526,7 +535,8 @@ class manager {
     ep_managers_map_type _ep_managers;
     stats _stats;
     seastar::metrics::metric_groups _metrics;
-    std::unordered_set<ep_key_type> _eps_with_pending_hints;
+    // End points with more hints than the segment being written to, and the size of their hints.
+    std::unordered_map<ep_key_type, size_t> _eps_with_pending_hints;
     seastar::named_semaphore _drain_lock = {1, named_semaphore_exception_factory{"drain lock"}};
 
 public:
@@ -596,8 +606,8 @@ class manager {
         return it->second.hints_in_progress();
     }
 
-    void add_ep_with_pending_hints(ep_key_type key) {
-        _eps_with_pending_hints.insert(key);
+    void add_ep_with_pending_hints(ep_key_type key, size_t size) {
+        _eps_with_pending_hints[key] += size;
     }
 
     void clear_eps_with_pending_hints() {
@@ -627,7 +637,7 @@ class manager {
 
     void allow_hints();
     void forbid_hints();
-    void forbid_hints_for_eps_with_pending_hints();
+    void forbid_hints_for_eps_with_pending_hints(size_t backlog, size_t max_backlog);
 
     void allow_replaying() noexcept {
         _state.set(state::replay_allowed);
@@ -99,16 +99,18 @@ future<> space_watchdog::scan_one_ep_dir(fs::path path, manager& shard_manager,
             if (!exists) {
                 return make_ready_future<>();
             } else {
-                return lister::scan_dir(path, { directory_entry_type::regular }, [this, ep_key, &shard_manager] (fs::path dir, directory_entry de) {
-                    // Put the current end point ID to state.eps_with_pending_hints when we see the second hints file in its directory
-                    if (_files_count == 1) {
-                        shard_manager.add_ep_with_pending_hints(ep_key);
-                    }
+                return lister::scan_dir(path, { directory_entry_type::regular }, [this] (fs::path dir, directory_entry de) {
                     ++_files_count;
 
                     return io_check(file_size, (dir / de.name.c_str()).c_str()).then([this] (uint64_t fsize) {
                         _total_size += fsize;
+                        _ep_size += fsize;
                     });
+                }).then([this, ep_key, &shard_manager] {
+                    // An end point with a single hints file has nothing but the one being written to
+                    if (_files_count > 1) {
+                        shard_manager.add_ep_with_pending_hints(ep_key, _ep_size);
+                    }
                 });
             }
         });
@@ -140,6 +142,7 @@ void space_watchdog::on_timer() {
             shard_manager.clear_eps_with_pending_hints();
             lister::scan_dir(shard_manager.hints_dir(), {directory_entry_type::directory}, [this, &shard_manager] (fs::path dir, directory_entry de) {
                 _files_count = 0;
+                _ep_size = 0;
                 // Let's scan per-end-point directories and enumerate hints files...
                 //
                 // Let's check if there is a corresponding end point manager (may not exist if the corresponding DC is
@@ -79,6 +79,7 @@ class space_watchdog {
     future<> _started = make_ready_future<>();
     seastar::abort_source _as;
     int _files_count = 0;
+    size_t _ep_size = 0;
 
 public:
     space_watchdog(shard_managers_set& managers, per_device_limits_map& per_device_limits_map);
@@ -94,8 +95,9 @@ class space_watchdog {
     ///
     /// Verifies that all \ref manager::_hints_dir dirs for all managers occupy less than \ref resource_manager::max_shard_disk_space_size.
     ///
-    /// If they do, stop all end point managers that have more than one hints file - we don't want some DOWN Node to
-    /// prevent hints to other Nodes from being generated (e.g. due to some temporary overload and timeout).
+    /// If they do, stop the end point managers that have more than one hints file, those with the most hints first,
+    /// until the rest fit - we don't want some DOWN Node to prevent hints to other Nodes from being generated
+    /// (e.g. due to some temporary overload and timeout).
     ///
     /// This is a simplistic implementation of a manager for a limited shared resource with a minimum guaranteed share for all
     /// participants.
@@ -105,9 +107,9 @@ class space_watchdog {
 
     /// \brief Scan files in a single end point directory.
     ///
-    /// Add sizes of files in the directory to _total_size. If number of files is greater than 1 add this end point ID
-    /// to _eps_with_pending_hints so that we may block it if _total_size value becomes greater than the maximum allowed
-    /// value.
+    /// Add sizes of files in the directory to _total_size. If number of files is greater than 1 add this end point ID,
+    /// with the size of its files, to _eps_with_pending_hints so that we may block it if _total_size value becomes
+    /// greater than the maximum allowed value.
     ///
     /// \param path directory to scan
     /// \param ep_name end point ID (as a string)
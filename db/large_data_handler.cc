@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/print.hh>
 #include "db/query_context.hh"
 #include "db/system_keyspace.hh"
@@ -40,15 +42,43 @@ future<large_data_handler::partition_above_threshold> large_data_handler::maybe_
         ++_stats.partitions_bigger_than_threshold;
     }
     if (above_threshold.size || above_threshold.rows) [[unlikely]] {
-        return with_sem([&sst, &key, partition_size, rows, this] {
-            return record_large_partitions(sst, key, partition_size, rows);
-        }).then([above_threshold] {
-            return above_threshold;
-        });
+        if (admit_record()) {
+            record_large_partitions(sst, key, partition_size, rows);
+        }
+        return make_ready_future<partition_above_threshold>(above_threshold);
     }
     return make_ready_future<partition_above_threshold>();
 }
 
+bool large_data_handler::admit_record() noexcept {
+    auto queued = _queued_records.size();
+    if (queued < sampling_threshold) {
+        _records_sampled = 0;
+        return true;
+    }
+    if (queued >= max_queued_records || _records_sampled++ % sampling_ratio != 0) {
+        ++_stats.records_dropped;
+        return false;
+    }
+    return true;
+}
+
+void large_data_handler::queue_record(record_write write) const {
+    _queued_records.push_back(std::move(write));
+    if (_record_writer.available()) {
+        _record_writer = write_records();
+    }
+}
+
+future<> large_data_handler::write_records() const {
+    while (!_queued_records.empty()) {
+        auto batch = std::exchange(_queued_records, {});
+        co_await max_concurrent_for_each(batch, max_concurrency, [] (record_write& write) {
+            return write();
+        });
+    }
+}
+
 void large_data_handler::start() {
     _running = true;
 }
@@ -58,7 +88,7 @@ future<> large_data_handler::stop() {
         return make_ready_future<>();
     }
     _running = false;
-    return _sem.wait(max_concurrency);
+    return when_all(std::exchange(_record_writer, make_ready_future<>()), _sem.wait(max_concurrency)).discard_result();
 }
 
 template <typename T> static std::string key_to_str(const T& key, const schema& s) {
@@ -103,14 +133,8 @@ future<> large_data_handler::maybe_delete_large_data_entries(sstables::shared_ss
 }
 
 template <typename... Args>
-static future<> try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
-        std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) {
-    // FIXME  This check is for test/cql-test-env that stop qctx (it does so because
-    // it stops query processor and doesn't want us to access its freed instantes)
-    if (!db::qctx) {
-        return make_ready_future<>();
-    }
-
+void cql_table_large_data_handler::try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
+        std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) const {
     sstring extra_fields_str;
     sstring extra_values;
     for (std::string_view field : extra_fields) {
@@ -126,19 +150,26 @@ static future<> try_record(std::string_view large_table, const sstables::sstable
     std::string pk_str = key_to_str(partition_key.to_partition_key(s), s);
     auto timestamp = db_clock::now();
     large_data_logger.warn("Writing large {} {}/{}: {}{} ({} bytes) to {}", desc, ks_name, cf_name, pk_str, extra_path, size, sstable_name);
-    return db::qctx->execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
-            .discard_result()
-            .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
-                large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
-                        large_table, ks_name, cf_name, sstable_name, ep);
-            });
+    queue_record([=, large_table = sstring(large_table)] {
+        // FIXME  This check is for test/cql-test-env that stop qctx (it does so because
+        // it stops query processor and doesn't want us to access its freed instantes)
+        if (!db::qctx) {
+            return make_ready_future<>();
+        }
+        return db::qctx->execute_cql(req, ks_name, cf_name, sstable_name, size, pk_str, timestamp, args...)
+                .discard_result()
+                .handle_exception([ks_name, cf_name, large_table, sstable_name] (std::exception_ptr ep) {
+                    large_data_logger.warn("Failed to add a record to system.large_{}s: ks = {}, table = {}, sst = {} exception = {}",
+                            large_table, ks_name, cf_name, sstable_name, ep);
+                });
+    });
 }
 
-future<> cql_table_large_data_handler::record_large_partitions(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size, uint64_t rows) const {
-    return try_record("partition", sst, key, int64_t(partition_size), "partition", "", {"rows"}, data_value((int64_t)rows));
+void cql_table_large_data_handler::record_large_partitions(const sstables::sstable& sst, const sstables::key& key, uint64_t partition_size, uint64_t rows) const {
+    try_record("partition", sst, key, int64_t(partition_size), "partition", "", {"rows"}, data_value((int64_t)rows));
 }
 
-future<> cql_table_large_data_handler::record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+void cql_table_large_data_handler::record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const {
     auto column_name = cdef.name_as_text();
     std::string_view cell_type = cdef.is_atomic() ? "cell" : "collection";
@@ -146,21 +177,21 @@ future<> cql_table_large_data_handler::record_large_cells(const sstables::sstabl
     if (clustering_key) {
         const schema &s = *sst.get_schema();
         auto ck_str = key_to_str(*clustering_key, s);
-        return try_record("cell", sst, partition_key, int64_t(cell_size), cell_type, format("{} {}", ck_str, column_name), extra_fields, ck_str, column_name);
+        try_record("cell", sst, partition_key, int64_t(cell_size), cell_type, format("{} {}", ck_str, column_name), extra_fields, ck_str, column_name);
     } else {
-        return try_record("cell", sst, partition_key, int64_t(cell_size), cell_type, column_name, extra_fields, data_value::make_null(utf8_type), column_name);
+        try_record("cell", sst, partition_key, int64_t(cell_size), cell_type, column_name, extra_fields, data_value::make_null(utf8_type), column_name);
     }
 }
 
-future<> cql_table_large_data_handler::record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+void cql_table_large_data_handler::record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, uint64_t row_size) const {
     static const std::vector<sstring> extra_fields{"clustering_key"};
     if (clustering_key) {
         const schema &s = *sst.get_schema();
         std::string ck_str = key_to_str(*clustering_key, s);
-        return try_record("row", sst, partition_key, int64_t(row_size), "row", ck_str, extra_fields,  ck_str);
+        try_record("row", sst, partition_key, int64_t(row_size), "row", ck_str, extra_fields,  ck_str);
     } else {
-        return try_record("row", sst, partition_key, int64_t(row_size), "static row", "", extra_fields, data_value::make_null(utf8_type));
+        try_record("row", sst, partition_key, int64_t(row_size), "static row", "", extra_fields, data_value::make_null(utf8_type));
     }
 }
 
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <cstdint>
+#include <seastar/util/noncopyable_function.hh>
+#include "utils/chunked_vector.hh"
 #include "schema_fwd.hh"
 #include "system_keyspace.hh"
 #include "sstables/shared_sstable.hh"
@@ -24,8 +26,16 @@ class large_data_handler {
 public:
     struct stats {
         int64_t partitions_bigger_than_threshold = 0; // number of large partition updates exceeding threshold_bytes
+        uint64_t records_dropped = 0; // number of large data records not written because too many were queued
     };
 
+    // Records are queued and written in the background, so that writing an sstable
+    // never waits for them. Past sampling_threshold queued records, only one in
+    // sampling_ratio records is queued, and past max_queued_records none is.
+    static constexpr size_t max_queued_records = 1000;
+    static constexpr size_t sampling_threshold = max_queued_records / 4;
+    static constexpr unsigned sampling_ratio = 16;
+
 private:
     // Assuming:
     // * there is at most one log entry every 1MB
@@ -49,6 +59,18 @@ class large_data_handler {
         });
     }
 
+    using record_write = noncopyable_function<future<>()>;
+    // Mutable, because the record_*() implementations, which queue the writes, are const.
+    mutable utils::chunked_vector<record_write> _queued_records;
+    mutable future<> _record_writer = make_ready_future<>();
+    uint64_t _records_sampled = 0;
+
+    // Decides whether a record above the threshold is queued or dropped.
+    bool admit_record() noexcept;
+    // Writes the queued records until there are none left, each batch being
+    // all the records queued while the previous one was written.
+    future<> write_records() const;
+
     bool _running = false;
     uint64_t _partition_threshold_bytes;
     uint64_t _row_threshold_bytes;
@@ -69,11 +91,10 @@ class large_data_handler {
             const clustering_key_prefix* clustering_key, uint64_t row_size) {
         assert(running());
         if (__builtin_expect(row_size > _row_threshold_bytes, false)) {
-            return with_sem([&sst, &partition_key, clustering_key, row_size, this] {
-                return record_large_rows(sst, partition_key, clustering_key, row_size);
-            }).then([] {
-                return true;
-            });
+            if (admit_record()) {
+                record_large_rows(sst, partition_key, clustering_key, row_size);
+            }
+            return make_ready_future<bool>(true);
         }
         return make_ready_future<bool>(false);
     }
@@ -88,11 +109,10 @@ class large_data_handler {
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) {
         assert(running());
         if (__builtin_expect(cell_size > _cell_threshold_bytes, false)) {
-            return with_sem([&sst, &partition_key, clustering_key, &cdef, cell_size, this] {
-                return record_large_cells(sst, partition_key, clustering_key, cdef, cell_size);
-            }).then([] {
-                return true;
-            });
+            if (admit_record()) {
+                record_large_cells(sst, partition_key, clustering_key, cdef, cell_size);
+            }
+            return make_ready_future<bool>(true);
         }
         return make_ready_future<bool>(false);
     }
@@ -113,15 +133,24 @@ class large_data_handler {
     uint64_t get_rows_count_threshold() const noexcept {
         return _rows_count_threshold;
     }
+    size_t queued_records() const noexcept {
+        return _queued_records.size();
+    }
 
     static sstring sst_filename(const sstables::sstable& sst);
 
 protected:
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    // Queues a write of a record, to be done in the background.
+    void queue_record(record_write write) const;
+
+    // The record_*() functions are called while the sstable is written. They must copy what
+    // they need of their arguments and queue the write of the record with queue_record(),
+    // rather than write it.
+    virtual void record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const = 0;
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
+    virtual void record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const = 0;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const = 0;
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const = 0;
+    virtual void record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const = 0;
 };
 
 class cql_table_large_data_handler : public large_data_handler {
@@ -130,32 +159,33 @@ class cql_table_large_data_handler : public large_data_handler {
         : large_data_handler(partition_threshold_bytes, row_threshold_bytes, cell_threshold_bytes, rows_count_threshold) {}
 
 protected:
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const override;
+    virtual void record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const override;
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const override;
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual void record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const override;
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+    virtual void record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key, const clustering_key_prefix* clustering_key, uint64_t row_size) const override;
+private:
+    template <typename... Args>
+    void try_record(std::string_view large_table, const sstables::sstable& sst,  const sstables::key& partition_key, int64_t size,
+            std::string_view desc, std::string_view extra_path, const std::vector<sstring> &extra_fields, Args&&... args) const;
 };
 
 class nop_large_data_handler : public large_data_handler {
 public:
     nop_large_data_handler();
-    virtual future<> record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const override {
-        return make_ready_future<>();
+    virtual void record_large_partitions(const sstables::sstable& sst, const sstables::key& partition_key, uint64_t partition_size, uint64_t rows) const override {
     }
 
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view large_table_name) const override {
         return make_ready_future<>();
     }
 
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual void record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const override {
-        return make_ready_future<>();
     }
 
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual void record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, uint64_t row_size) const override {
-        return make_ready_future<>();
     }
 };
 
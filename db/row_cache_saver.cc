@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/util/file.hh>
+
+#include "db/row_cache_saver.hh"
+#include "replica/database.hh"
+#include "service/priority_manager.hh"
+#include "utils/lister.hh"
+#include "log.hh"
+
+namespace db {
+
+static logging::logger rcslogger("row_cache_saver");
+
+// The file of each shard holds a header, followed by records of the saved keys,
+// hottest first:
+//
+//   header: magic (4 bytes), version (4 bytes)
+//   record: table id (16 bytes), key length (4 bytes), serialized partition key
+//
+// Integers are big-endian.
+static constexpr uint32_t file_magic = 0x5343524b; // "SCRK"
+static constexpr uint32_t file_version = 1;
+static constexpr std::string_view file_prefix = "row_cache_keys-";
+
+namespace {
+
+struct saved_key {
+    unsigned frequency;
+    utils::UUID table_id;
+    partition_key key;
+};
+
+template <typename T>
+void append_be(sstring& buf, T v) {
+    char tmp[sizeof(T)];
+    write_be<T>(tmp, v);
+    buf.append(tmp, sizeof(T));
+}
+
+}
+
+row_cache_saver::row_cache_saver(replica::database& db, config cfg)
+    : _db(db)
+    , _cfg(std::move(cfg))
+{ }
+
+std::filesystem::path row_cache_saver::file_path(unsigned shard) const {
+    return _cfg.directory / format("{}{}.db", file_prefix, shard);
+}
+
+void row_cache_saver::enable_sampling() {
+    auto size = _cfg.save_period() ? sample_size_per_table : 0;
+    for (auto& [id, t] : _db.get_column_families()) {
+        t->get_row_cache().set_hot_key_sample_size(t->schema()->caching_options().enabled() ? size : 0);
+    }
+}
+
+future<> row_cache_saver::save() {
+    std::vector<lw_shared_ptr<replica::table>> tables;
+    for (auto& [id, t] : _db.get_column_families()) {
+        tables.push_back(t);
+    }
+    std::vector<saved_key> keys;
+    for (auto& t : tables) {
+        for (auto& hk : t->get_row_cache().take_hot_keys()) {
+            keys.push_back(saved_key{hk.frequency, t->schema()->id(), std::move(hk.key._key)});
+        }
+        co_await coroutine::maybe_yield();
+    }
+    if (keys.empty()) {
+        // Keep the keys saved in the previous period.
+        co_return;
+    }
+    std::stable_sort(keys.begin(), keys.end(), [] (const saved_key& a, const saved_key& b) {
+        return a.frequency > b.frequency;
+    });
+    if (auto limit = _cfg.keys_to_save()) {
+        auto per_shard = std::min<size_t>(keys.size(), (limit + smp::count - 1) / smp::count);
+        keys.erase(keys.begin() + per_shard, keys.end());
+    }
+
+    sstring buf;
+    append_be<uint32_t>(buf, file_magic);
+    append_be<uint32_t>(buf, file_version);
+    for (auto& k : keys) {
+        auto key = to_bytes(k.key.representation());
+        append_be<int64_t>(buf, k.table_id.get_most_significant_bits());
+        append_be<int64_t>(buf, k.table_id.get_least_significant_bits());
+        append_be<uint32_t>(buf, key.size());
+        buf.append(reinterpret_cast<const char*>(key.data()), key.size());
+        co_await coroutine::maybe_yield();
+    }
+
+    co_await recursive_touch_directory(_cfg.directory.native());
+    auto path = file_path(this_shard_id());
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    auto f = co_await open_file_dma(tmp_path.native(), open_flags::wo | open_flags::create | open_flags::truncate);
+    auto out = co_await make_file_output_stream(std::move(f));
+    std::exception_ptr ex;
+    try {
+        co_await out.write(buf.data(), buf.size());
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await rename_file(tmp_path.native(), path.native());
+    co_await sync_directory(_cfg.directory.native());
+    rcslogger.debug("Saved {} row cache keys to {}", keys.size(), path.native());
+}
+
+future<> row_cache_saver::run_saver() {
+    while (!_as.abort_requested()) {
+        enable_sampling();
+        auto period = _cfg.save_period();
+        try {
+            // Check every minute whether saving was enabled.
+            co_await sleep_abortable(std::chrono::seconds(period ? period : 60), _as);
+        } catch (const sleep_aborted&) {
+            co_return;
+        }
+        if (!period) {
+            continue;
+        }
+        try {
+            co_await save();
+        } catch (...) {
+            rcslogger.warn("Failed to save row cache keys: {}", std::current_exception());
+        }
+    }
+}
+
+future<> row_cache_saver::preload_file(std::filesystem::path path) {
+    auto data = co_await util::read_entire_file_contiguous(path);
+    const char* p = data.begin();
+    const char* end = data.end();
+    auto remaining = [&] { return size_t(end - p); };
+
+    if (remaining() < 8 || read_be<uint32_t>(p) != file_magic || read_be<uint32_t>(p + 4) != file_version) {
+        rcslogger.warn("Ignoring {}: unknown format", path.native());
+        co_return;
+    }
+    p += 8;
+
+    size_t loaded = 0;
+    while (remaining() && !_as.abort_requested()) {
+        auto rate = _cfg.preload_keys_per_second();
+        if (!rate) {
+            break;
+        }
+        if (remaining() < 20 || remaining() - 20 < read_be<uint32_t>(p + 16)) {
+            rcslogger.warn("Ignoring the rest of {}: truncated record", path.native());
+            break;
+        }
+        auto table_id = utils::UUID(read_be<int64_t>(p), read_be<int64_t>(p + 8));
+        auto key_size = read_be<uint32_t>(p + 16);
+        auto key = partition_key::from_bytes(bytes_view(reinterpret_cast<const int8_t*>(p + 20), key_size));
+        p += 20 + key_size;
+
+        if (!_db.column_family_exists(table_id)) {
+            continue;
+        }
+        auto t = _db.find_column_family(table_id).shared_from_this();
+        auto s = t->schema();
+        if (!s->caching_options().enabled()) {
+            continue;
+        }
+        auto dk = dht::decorate_key(*s, std::move(key));
+        if (dht::shard_of(*s, dk.token()) != this_shard_id()) {
+            continue;
+        }
+
+        try {
+            auto permit = co_await t->streaming_read_concurrency_semaphore().obtain_permit(s.get(), "row-cache-preload",
+                    t->estimate_read_memory_cost(), db::no_timeout);
+            auto pr = dht::partition_range::make_singular(dk);
+            auto rd = t->make_reader(s, std::move(permit), pr, s->full_slice(), service::get_local_streaming_priority());
+            std::exception_ptr ex;
+            try {
+                while (co_await rd()) { }
+            } catch (...) {
+                ex = std::current_exception();
+            }
+            co_await rd.close();
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+            ++loaded;
+        } catch (...) {
+            rcslogger.debug("Failed to pre-load {} of {}.{}: {}", dk, s->ks_name(), s->cf_name(), std::current_exception());
+        }
+        co_await sleep_abortable(std::chrono::microseconds(1000000 / rate), _as);
+    }
+    rcslogger.info("Pre-loaded {} partitions into the row cache from {}", loaded, path.native());
+}
+
+future<> row_cache_saver::preload() {
+    if (!_cfg.preload_keys_per_second() || !co_await file_exists(_cfg.directory.native())) {
+        co_return;
+    }
+    std::vector<std::filesystem::path> files;
+    co_await lister::scan_dir(_cfg.directory, { directory_entry_type::regular }, [&files] (std::filesystem::path dir, directory_entry de) {
+        std::string_view name = de.name;
+        if (name.starts_with(file_prefix) && name.ends_with(".db")) {
+            files.push_back(dir / de.name.c_str());
+        }
+        return make_ready_future<>();
+    });
+    for (auto& f : files) {
+        try {
+            co_await preload_file(f);
+        } catch (const sleep_aborted&) {
+            co_return;
+        } catch (...) {
+            rcslogger.warn("Failed to pre-load the row cache from {}: {}", f.native(), std::current_exception());
+        }
+    }
+}
+
+future<> row_cache_saver::start() {
+    _preloader = with_scheduling_group(_cfg.sched_group, [this] {
+        return preload();
+    });
+    _saver = with_scheduling_group(_cfg.sched_group, [this] {
+        return run_saver();
+    });
+    return make_ready_future<>();
+}
+
+future<> row_cache_saver::stop() {
+    _as.request_abort();
+    co_await std::exchange(_preloader, make_ready_future<>());
+    co_await std::exchange(_saver, make_ready_future<>());
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <filesystem>
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/sharded.hh>
+
+#include "replica/database_fwd.hh"
+#include "utils/updateable_value.hh"
+
+using namespace seastar;
+
+namespace db {
+
+// Saves the keys of the partitions which are read repeatedly from the row cache,
+// and reads them back into the cache when the node starts, so that it doesn't
+// serve reads from a cold cache for long after a restart.
+//
+// Every row_cache_save_period, each shard writes the hottest keys sampled by
+// the row caches of its tables (see row_cache::take_hot_keys()) to a file of
+// its own in the saved caches directory. On start, each shard reads the files
+// of all shards, as the number of shards may have changed, and reads the
+// partitions it owns through the cache at a limited rate, hottest first,
+// until stopped. This runs in the background, while the node joins the cluster.
+class row_cache_saver : public peering_sharded_service<row_cache_saver> {
+public:
+    struct config {
+        std::filesystem::path directory;
+        // In seconds, 0 disables saving.
+        utils::updateable_value<uint32_t> save_period;
+        // For the whole node, 0 saves all sampled keys.
+        utils::updateable_value<uint32_t> keys_to_save;
+        // Per shard, 0 disables the pre-load.
+        utils::updateable_value<uint32_t> preload_keys_per_second;
+        scheduling_group sched_group;
+    };
+
+    // The number of keys sampled by the row cache of each table on each shard.
+    static constexpr size_t sample_size_per_table = 1000;
+private:
+    replica::database& _db;
+    config _cfg;
+    abort_source _as;
+    future<> _saver = make_ready_future<>();
+    future<> _preloader = make_ready_future<>();
+private:
+    std::filesystem::path file_path(unsigned shard) const;
+    void enable_sampling();
+    future<> save();
+    future<> run_saver();
+    future<> preload();
+    future<> preload_file(std::filesystem::path);
+public:
+    row_cache_saver(replica::database& db, config cfg);
+
+    // Starts the pre-load and the periodic saving.
+    future<> start();
+    future<> stop();
+};
+
+}
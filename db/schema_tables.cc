@@ -25,6 +25,7 @@
 #include "map_difference.hh"
 #include "utils/UUID_gen.hh"
 #include <seastar/coroutine/all.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include "log.hh"
 #include "frozen_schema.hh"
 #include "schema_registry.hh"
@@ -908,15 +909,82 @@ static utils::UUID table_id_from_mutations(const schema_mutations& sm) {
     return table_row.get_nonnull<utils::UUID>("id");
 }
 
+// Names of the tables and views of each keyspace whose definitions are touched
+// by a set of schema mutations. A keyspace maps to std::nullopt when the mutations
+// may touch any of its tables (e.g. DROP KEYSPACE), so all of them have to be read.
+using affected_tables = std::map<sstring, std::optional<std::set<sstring>>>;
+
+// Schema tables whose first clustering column is the name of the table or view
+// the row belongs to.
+static bool is_keyed_by_table_name(const schema& s) {
+    static const std::unordered_set<sstring> names = {
+        TABLES, SCYLLA_TABLES, COLUMNS, DROPPED_COLUMNS, TRIGGERS, VIEWS, INDEXES, VIEW_VIRTUAL_COLUMNS, COMPUTED_COLUMNS,
+    };
+    return names.contains(s.cf_name());
+}
+
+static void add_affected_tables(affected_tables& affected, const sstring& keyspace_name, const mutation& m) {
+    auto [it, inserted] = affected.try_emplace(keyspace_name, std::set<sstring>());
+    auto& names = it->second;
+    const schema& s = *m.schema();
+    auto all_tables = [&] {
+        names = std::nullopt;
+    };
+    if (!names) {
+        return;
+    }
+    if (m.partition().partition_tombstone()) {
+        return all_tables();
+    }
+    // Keyspaces, types, functions and aggregates don't define tables.
+    if (!is_keyed_by_table_name(s)) {
+        return;
+    }
+    if (!m.partition().static_row().empty()) {
+        return all_tables();
+    }
+    auto table_name_of = [&] (const clustering_key_prefix& ckp) -> std::optional<sstring> {
+        if (ckp.is_empty()) {
+            return std::nullopt;
+        }
+        return value_cast<sstring>(utf8_type->deserialize(*ckp.begin(s)));
+    };
+    for (auto&& rt : m.partition().row_tombstones()) {
+        auto start = table_name_of(rt.tombstone().start);
+        if (!start || start != table_name_of(rt.tombstone().end)) {
+            return all_tables();
+        }
+        names->insert(std::move(*start));
+    }
+    for (auto&& row : m.partition().clustered_rows()) {
+        auto name = table_name_of(row.key());
+        if (!name) {
+            return all_tables();
+        }
+        names->insert(std::move(*name));
+    }
+}
+
 static
 future<std::map<utils::UUID, schema_mutations>>
-read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const std::set<sstring>& keyspace_names, schema_ptr s)
+read_tables_for_keyspaces(distributed<service::storage_proxy>& proxy, const affected_tables& keyspaces, schema_ptr s)
 {
     std::map<utils::UUID, schema_mutations> result;
-    for (auto&& keyspace_name : keyspace_names) {
-        for (auto&& table_name : co_await read_table_names_of_keyspace(proxy, keyspace_name, s)) {
+    for (auto&& [keyspace_name, affected_names] : keyspaces) {
+        std::vector<sstring> table_names;
+        if (affected_names) {
+            table_names.assign(affected_names->begin(), affected_names->end());
+        } else {
+            table_names = co_await read_table_names_of_keyspace(proxy, keyspace_name, s);
+        }
+        for (auto&& table_name : table_names) {
             auto qn = qualified_name(keyspace_name, table_name);
             auto muts = co_await read_table_mutations(proxy, qn, s);
+            // Names taken from the mutations include views when reading tables and
+            // vice versa, as well as tables which don't exist on this side of the merge.
+            if (affected_names && query::result_set(muts.columnfamilies_mutation()).empty()) {
+                continue;
+            }
             auto id = table_id_from_mutations(muts);
             result.emplace(std::move(id), std::move(muts));
         }
@@ -1023,21 +1091,34 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
     // compare before/after schemas of the affected keyspaces only
     std::set<sstring> keyspaces;
     std::set<utils::UUID> column_families;
+    // Only the tables and views the mutations touch are read and diffed,
+    // rather than every table of the affected keyspaces.
+    affected_tables tables_to_diff;
     for (auto&& mutation : mutations) {
-        keyspaces.emplace(value_cast<sstring>(utf8_type->deserialize(mutation.key().get_component(*s, 0))));
+        auto keyspace_name = value_cast<sstring>(utf8_type->deserialize(mutation.key().get_component(*s, 0)));
+        add_affected_tables(tables_to_diff, keyspace_name, mutation);
+        keyspaces.emplace(std::move(keyspace_name));
         column_families.emplace(mutation.column_family_id());
         // We must force recalculation of schema version after the merge, since the resulting
         // schema may be a mix of the old and new schemas.
         delete_schema_version(mutation);
     }
 
+    using clock = std::chrono::steady_clock;
+    auto phase_start = clock::now();
+    auto end_phase = [&phase_start] {
+        auto now = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(now - std::exchange(phase_start, now)).count();
+    };
+
     // current state of the schema
     auto&& old_keyspaces = co_await read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
-    auto&& old_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables());
+    auto&& old_column_families = co_await read_tables_for_keyspaces(proxy, tables_to_diff, tables());
     auto&& old_types = co_await read_schema_for_keyspaces(proxy, TYPES, keyspaces);
-    auto&& old_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views());
+    auto&& old_views = co_await read_tables_for_keyspaces(proxy, tables_to_diff, views());
     auto old_functions = co_await read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces);
     auto old_aggregates = co_await read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces);
+    auto read_old_ms = end_phase();
 
     co_await proxy.local().mutate_locally(std::move(mutations), tracing::trace_state_ptr());
 
@@ -1050,14 +1131,16 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
             });
         });
     }
+    auto apply_ms = end_phase();
 
     // with new data applied
     auto&& new_keyspaces = co_await read_schema_for_keyspaces(proxy, KEYSPACES, keyspaces);
-    auto&& new_column_families = co_await read_tables_for_keyspaces(proxy, keyspaces, tables());
+    auto&& new_column_families = co_await read_tables_for_keyspaces(proxy, tables_to_diff, tables());
     auto&& new_types = co_await read_schema_for_keyspaces(proxy, TYPES, keyspaces);
-    auto&& new_views = co_await read_tables_for_keyspaces(proxy, keyspaces, views());
+    auto&& new_views = co_await read_tables_for_keyspaces(proxy, tables_to_diff, views());
     auto new_functions = co_await read_schema_for_keyspaces(proxy, FUNCTIONS, keyspaces);
     auto new_aggregates = co_await read_schema_for_keyspaces(proxy, AGGREGATES, keyspaces);
+    auto read_new_ms = end_phase();
 
     std::set<sstring> keyspaces_to_drop = co_await merge_keyspaces(proxy, std::move(old_keyspaces), std::move(new_keyspaces));
     auto types_to_drop = co_await merge_types(proxy, std::move(old_types), std::move(new_types));
@@ -1075,6 +1158,10 @@ static future<> do_merge_schema(distributed<service::storage_proxy>& proxy, std:
             co_await db.get_notifier().drop_keyspace(keyspace_to_drop);
         }
     });
+    auto merge_ms = end_phase();
+
+    slogger.debug("Merged schema of keyspaces {}: read old {}ms, apply mutations {}ms, read new {}ms, merge {}ms",
+            keyspaces, read_old_ms, apply_ms, read_new_ms, merge_ms);
 }
 
 future<std::set<sstring>> merge_keyspaces(distributed<service::storage_proxy>& proxy, schema_result&& before, schema_result&& after)
@@ -1263,6 +1350,7 @@ static future<> merge_tables_and_views(distributed<service::storage_proxy>& prox
         columns_changed.reserve(tables_diff.altered.size() + views_diff.altered.size());
         for (auto&& altered : boost::range::join(tables_diff.altered, views_diff.altered)) {
             columns_changed.push_back(db.update_column_family(altered.new_schema));
+            co_await coroutine::maybe_yield();
         }
 
         auto it = columns_changed.begin();
@@ -52,7 +52,7 @@ std::result_of_t<Func()> snapshot_ctl::run_snapshot_list_operation(Func&& f) {
     });
 }
 
-future<> snapshot_ctl::take_snapshot(sstring tag, std::vector<sstring> keyspace_names, skip_flush sf) {
+future<> snapshot_ctl::take_snapshot(sstring tag, std::vector<sstring> keyspace_names, skip_flush sf, sstring base_tag) {
     if (tag.empty()) {
         throw std::runtime_error("You must supply a snapshot name.");
     }
@@ -61,16 +61,16 @@ future<> snapshot_ctl::take_snapshot(sstring tag, std::vector<sstring> keyspace_
         boost::copy(_db.local().get_keyspaces() | boost::adaptors::map_keys, std::back_inserter(keyspace_names));
     };
 
-    return run_snapshot_modify_operation([tag = std::move(tag), keyspace_names = std::move(keyspace_names), sf, this] {
+    return run_snapshot_modify_operation([tag = std::move(tag), keyspace_names = std::move(keyspace_names), sf, base_tag = std::move(base_tag), this] {
         return parallel_for_each(keyspace_names, [tag, this] (auto& ks_name) {
             return check_snapshot_not_exist(ks_name, tag);
-        }).then([this, tag, keyspace_names, sf] {
-            return _db.invoke_on_all([tag = std::move(tag), keyspace_names, sf] (replica::database& db) {
-                return parallel_for_each(keyspace_names, [&db, tag = std::move(tag), sf] (auto& ks_name) {
+        }).then([this, tag, keyspace_names, sf, base_tag] {
+            return _db.invoke_on_all([tag = std::move(tag), keyspace_names, sf, base_tag] (replica::database& db) {
+                return parallel_for_each(keyspace_names, [&db, tag = std::move(tag), sf, base_tag] (auto& ks_name) {
                     auto& ks = db.find_keyspace(ks_name);
-                    return parallel_for_each(ks.metadata()->cf_meta_data(), [&db, tag = std::move(tag), sf] (auto& pair) {
+                    return parallel_for_each(ks.metadata()->cf_meta_data(), [&db, tag = std::move(tag), sf, base_tag] (auto& pair) {
                         auto& cf = db.find_column_family(pair.second);
-                        return cf.snapshot(db, tag, bool(sf));
+                        return cf.snapshot(db, tag, bool(sf), base_tag);
                     });
                 });
             });
@@ -78,7 +78,7 @@ future<> snapshot_ctl::take_snapshot(sstring tag, std::vector<sstring> keyspace_
     });
 }
 
-future<> snapshot_ctl::take_column_family_snapshot(sstring ks_name, std::vector<sstring> tables, sstring tag, skip_flush sf) {
+future<> snapshot_ctl::take_column_family_snapshot(sstring ks_name, std::vector<sstring> tables, sstring tag, skip_flush sf, sstring base_tag) {
     if (ks_name.empty()) {
         throw std::runtime_error("You must supply a keyspace name");
     }
@@ -89,16 +89,21 @@ future<> snapshot_ctl::take_column_family_snapshot(sstring ks_name, std::vector<
         throw std::runtime_error("You must supply a snapshot name.");
     }
 
-    return run_snapshot_modify_operation([this, ks_name = std::move(ks_name), tables = std::move(tables), tag = std::move(tag), sf] {
-        return check_snapshot_not_exist(ks_name, tag, tables).then([this, ks_name, tables, tag, sf] {
-            return do_with(std::vector<sstring>(std::move(tables)),[this, ks_name, tag, sf](const std::vector<sstring>& tables) {
-                return do_for_each(tables, [ks_name, tag, sf, this] (const sstring& table_name) {
-                    if (table_name.find(".") != sstring::npos) {
-                        throw std::invalid_argument("Cannot take a snapshot of a secondary index by itself. Run snapshot on the table that owns the index.");
-                    }
-                    return _db.invoke_on_all([ks_name, table_name, tag, sf] (replica::database &db) {
+    for (auto& table_name : tables) {
+        if (table_name.find(".") != sstring::npos) {
+            throw std::invalid_argument("Cannot take a snapshot of a secondary index by itself. Run snapshot on the table that owns the index.");
+        }
+    }
+
+    return run_snapshot_modify_operation([this, ks_name = std::move(ks_name), tables = std::move(tables), tag = std::move(tag), sf, base_tag = std::move(base_tag)] {
+        return check_snapshot_not_exist(ks_name, tag, tables).then([this, ks_name, tables, tag, sf, base_tag] {
+            return do_with(std::vector<sstring>(std::move(tables)),[this, ks_name, tag, sf, base_tag](const std::vector<sstring>& tables) {
+                // Tables are linked in parallel, as in take_snapshot(). The number of
+                // sstables linked at once is bounded by table::snapshot().
+                return parallel_for_each(tables, [ks_name, tag, sf, base_tag, this] (const sstring& table_name) {
+                    return _db.invoke_on_all([ks_name, table_name, tag, sf, base_tag] (replica::database &db) {
                         auto& cf = db.find_column_family(ks_name, table_name);
-                        return cf.snapshot(db, tag, bool(sf));
+                        return cf.snapshot(db, tag, bool(sf), base_tag);
                     });
                 });
             });
@@ -56,8 +56,10 @@ class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
      *
      * @param tag the tag given to the snapshot; may not be null or empty
      * @param keyspaceNames the names of the keyspaces to snapshot; empty means "all."
+     * @param base_tag the tag of a previous snapshot; if not empty, the manifest of
+     *        each table also lists the files that are not in that snapshot
      */
-    future<> take_snapshot(sstring tag, std::vector<sstring> keyspace_names, skip_flush sf = skip_flush::no);
+    future<> take_snapshot(sstring tag, std::vector<sstring> keyspace_names, skip_flush sf = skip_flush::no, sstring base_tag = {});
 
     /**
      * Takes the snapshot of multiple tables. A snapshot name must be specified.
@@ -65,8 +67,10 @@ class snapshot_ctl : public peering_sharded_service<snapshot_ctl> {
      * @param ks_name the keyspace which holds the specified column family
      * @param tables a vector of tables names to snapshot
      * @param tag the tag given to the snapshot; may not be null or empty
+     * @param base_tag the tag of a previous snapshot; if not empty, the manifest of
+     *        each table also lists the files that are not in that snapshot
      */
-    future<> take_column_family_snapshot(sstring ks_name, std::vector<sstring> tables, sstring tag, skip_flush sf = skip_flush::no);
+    future<> take_column_family_snapshot(sstring ks_name, std::vector<sstring> tables, sstring tag, skip_flush sf = skip_flush::no, sstring base_tag = {});
 
     /**
      * Takes the snapshot of a specific column family. A snapshot name must be specified.
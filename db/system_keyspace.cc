@@ -68,6 +68,8 @@
 #include "idl/frozen_mutation.dist.impl.hh"
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include "client_data.hh"
+#include "tracing/tracing.hh"
+#include "db/data_listeners.hh"
 
 using days = std::chrono::duration<int, std::ratio<24 * 3600>>;
 
@@ -180,11 +182,13 @@ schema_ptr system_keyspace::batchlog() {
         utf8_type,
         // comment
         "in-progress paxos proposals"
-        // FIXME: the original Java code also had:
-        // operations on resulting CFMetaData:
-        //    .compactionStrategyClass(LeveledCompactionStrategy.class);
        );
        builder.set_gc_grace_seconds(0);
+       // Every round overwrites the row of its key and prune deletes it, so
+       // most of the table is shadowed data. Leveled compaction keeps a key
+       // in few SSTables, bounding the reads of paxos_state and dropping the
+       // pruned rows soon, since gc_grace_seconds is 0.
+       builder.set_compaction_strategy(sstables::compaction_strategy_type::leveled);
        builder.with_version(generate_schema_version(builder.uuid()));
        builder.set_wait_for_sync_to_commitlog(true);
        return builder.build(schema_builder::compact_storage::no);
@@ -2604,6 +2608,216 @@ class clients_table : public streaming_virtual_table {
     }
 };
 
+// Lists the partitions each shard tracks as the most read and written, see db::hot_partitions_tracker.
+class hot_partitions_table : public streaming_virtual_table {
+    distributed<replica::database>& _db;
+
+    struct hot_partition_info {
+        sstring table_name;
+        sstring partition_key;
+        int32_t shard;
+        int64_t reads;
+        int64_t writes;
+        int64_t write_bytes;
+    };
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+        : streaming_virtual_table(build_schema())
+        , _db(db) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::clustering_key)
+            .with_column("shard_id", int32_type, column_kind::clustering_key)
+            .with_column("partition_key", utf8_type, column_kind::clustering_key)
+            .with_column("reads", long_type)
+            .with_column("writes", long_type)
+            .with_column("write_bytes", long_type)
+            .set_comment("The partitions of each table read and written the most recently, per shard, with estimated operation counts.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    dht::decorated_key make_partition_key(const sstring& keyspace_name) {
+        return dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(keyspace_name).serialize_nonnull()));
+    }
+
+    // Collects the hot partitions of a single keyspace at a time, so that a
+    // query holds those of the partition it is emitting, not of the whole table.
+    future<std::vector<hot_partition_info>> get_hot_partitions(sstring keyspace_name) {
+        return _db.map_reduce0([keyspace_name] (replica::database& db) {
+            std::vector<hot_partition_info> res;
+            auto tracker = db.hot_partitions_tracker();
+            if (!tracker) {
+                return res;
+            }
+            for (const auto& [table_id, items] : tracker->tables()) {
+                schema_ptr s;
+                try {
+                    s = db.find_schema(table_id);
+                } catch (replica::no_such_column_family&) {
+                    continue;
+                }
+                if (s->ks_name() != keyspace_name) {
+                    continue;
+                }
+                for (const auto& i : items) {
+                    res.push_back(hot_partition_info{s->cf_name(), format("{}", i.key.key().with_schema(*s)),
+                            int32_t(this_shard_id()), int64_t(i.reads), int64_t(i.writes), int64_t(i.write_bytes)});
+                }
+            }
+            return res;
+        }, std::vector<hot_partition_info>(), [] (std::vector<hot_partition_info> a, std::vector<hot_partition_info> b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        struct decorated_keyspace_name {
+            sstring name;
+            dht::decorated_key key;
+        };
+
+        auto keyspace_names = boost::copy_range<std::vector<decorated_keyspace_name>>(
+                _db.local().get_keyspaces() | boost::adaptors::transformed([this] (auto&& e) {
+                    return decorated_keyspace_name{e.first, make_partition_key(e.first)};
+        }));
+
+        boost::sort(keyspace_names, [less = dht::ring_position_less_comparator(*_s)]
+                (const decorated_keyspace_name& l, const decorated_keyspace_name& r) {
+            return less(l.key, r.key);
+        });
+
+        for (const decorated_keyspace_name& e : keyspace_names) {
+            auto&& dk = e.key;
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+
+            auto infos = co_await get_hot_partitions(e.name);
+
+            const auto& ranges = qr.slice().row_ranges(*_s, dk.key());
+            std::vector<clustering_row> rows;
+            for (auto& info : infos) {
+                auto ck = clustering_key::from_exploded(*_s, {
+                    data_value(info.table_name).serialize_nonnull(),
+                    data_value(info.shard).serialize_nonnull(),
+                    data_value(info.partition_key).serialize_nonnull()
+                });
+                if (!contains_row(ranges, ck)) {
+                    continue;
+                }
+                clustering_row cr(std::move(ck));
+                set_cell(cr.cells(), "reads", info.reads);
+                set_cell(cr.cells(), "writes", info.writes);
+                set_cell(cr.cells(), "write_bytes", info.write_bytes);
+                rows.push_back(std::move(cr));
+            }
+            if (rows.empty()) {
+                continue;
+            }
+            boost::sort(rows, [less = clustering_key::less_compare(*_s)] (const clustering_row& l, const clustering_row& r) {
+                return less(l.key(), r.key());
+            });
+
+            co_await result.emit_partition_start(dk);
+            for (auto& cr : rows) {
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
+// Lists the slow queries each shard keeps in memory, see tracing::recent_slow_queries().
+// Unlike system_traces.node_slow_log, it has all of them, whatever the persist ratio.
+class slow_queries_table : public streaming_virtual_table {
+public:
+    explicit slow_queries_table()
+        : streaming_virtual_table(build_schema()) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "slow_queries");
+        return schema_builder(system_keyspace::NAME, "slow_queries", std::make_optional(id))
+            .with_column("shard_id", int32_type, column_kind::partition_key)
+            .with_column("started_at", timestamp_type, column_kind::clustering_key)
+            .with_column("session_id", uuid_type, column_kind::clustering_key)
+            .with_column("duration", long_type)
+            .with_column("client", inet_addr_type)
+            .with_column("username", utf8_type)
+            .with_column("request", utf8_type)
+            .with_column("tables", set_type_impl::get_instance(utf8_type, false))
+            .with_column("parameters", map_type_impl::get_instance(utf8_type, utf8_type, false))
+            .set_comment("The most recent queries of each shard that took longer than the slow query threshold.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(reader_permit permit, result_collector& result, const query_restrictions& qr) override {
+        auto shard_keys = boost::copy_range<std::vector<std::pair<unsigned, dht::decorated_key>>>(
+                boost::irange(0u, smp::count) | boost::adaptors::transformed([this] (unsigned shard) {
+                    return std::pair(shard, dht::decorate_key(*_s, partition_key::from_single_value(*_s, data_value(int32_t(shard)).serialize_nonnull())));
+        }));
+        boost::sort(shard_keys, [less = dht::ring_position_less_comparator(*_s)] (const auto& l, const auto& r) {
+            return less(l.second, r.second);
+        });
+
+        for (const auto& [shard, dk] : shard_keys) {
+            if (!this_shard_owns(dk) || !contains_key(qr.partition_range(), dk)) {
+                continue;
+            }
+            auto queries = co_await tracing::tracing::tracing_instance().invoke_on(shard, [] (tracing::tracing& local_tracing) {
+                return boost::copy_range<std::vector<tracing::slow_query_summary>>(local_tracing.recent_slow_queries());
+            });
+
+            const auto& ranges = qr.slice().row_ranges(*_s, dk.key());
+            std::vector<clustering_row> rows;
+            for (const auto& q : queries) {
+                auto started_at = db_clock::time_point(std::chrono::duration_cast<db_clock::duration>(q.session.started_at.time_since_epoch()));
+                auto ck = clustering_key::from_exploded(*_s, {
+                    data_value(started_at).serialize_nonnull(),
+                    data_value(q.session_id).serialize_nonnull()
+                });
+                if (!contains_row(ranges, ck)) {
+                    continue;
+                }
+                clustering_row cr(std::move(ck));
+                set_cell(cr.cells(), "duration", int64_t(std::chrono::duration_cast<std::chrono::microseconds>(q.session.elapsed).count()));
+                set_cell(cr.cells(), "client", q.session.client.addr());
+                set_cell(cr.cells(), "username", q.session.username);
+                set_cell(cr.cells(), "request", q.session.request);
+                std::vector<data_value> tables(q.session.tables.begin(), q.session.tables.end());
+                set_cell(cr.cells(), "tables", make_set_value(_s->get_column_definition("tables")->type, std::move(tables)));
+                map_type_impl::native_type parameters;
+                for (const auto& [key, value] : q.session.parameters) {
+                    parameters.emplace_back(key, value);
+                }
+                set_cell(cr.cells(), "parameters", make_map_value(_s->get_column_definition("parameters")->type, std::move(parameters)));
+                rows.push_back(std::move(cr));
+            }
+            if (rows.empty()) {
+                continue;
+            }
+            boost::sort(rows, [less = clustering_key::less_compare(*_s)] (const clustering_row& l, const clustering_row& r) {
+                return less(l.key(), r.key());
+            });
+
+            co_await result.emit_partition_start(dk);
+            for (auto& cr : rows) {
+                co_await result.emit_row(std::move(cr));
+            }
+            co_await result.emit_partition_end();
+        }
+    }
+};
+
 // Map from table's schema ID to table itself. Helps avoiding accidental duplication.
 static thread_local std::map<utils::UUID, std::unique_ptr<virtual_table>> virtual_tables;
 
@@ -2625,6 +2839,8 @@ void register_virtual_tables(distributed<replica::database>& dist_db, distribute
     add_table(std::make_unique<versions_table>());
     add_table(std::make_unique<db_config_table>(cfg));
     add_table(std::make_unique<clients_table>(ss));
+    add_table(std::make_unique<slow_queries_table>());
+    add_table(std::make_unique<hot_partitions_table>(dist_db));
 }
 
 std::vector<schema_ptr> system_keyspace::all_tables(const db::config& cfg) {
@@ -18,6 +18,40 @@ row_locker::row_locker(schema_ptr s)
     : _schema(s)
     , _two_level_locks(1, decorated_key_hash(), decorated_key_equals_comparator(this))
 {
+    _free_partition_locks.reserve(max_free_lock_entries);
+    _free_row_locks.reserve(max_free_lock_entries);
+}
+
+row_locker::two_level_locks_type::iterator
+row_locker::find_or_create_partition_lock(const dht::decorated_key& pk) {
+    auto i = _two_level_locks.find(pk);
+    if (i != _two_level_locks.end()) {
+        return i;
+    }
+    if (_free_partition_locks.empty()) {
+        return _two_level_locks.try_emplace(pk, this).first;
+    }
+    auto node = std::move(_free_partition_locks.back());
+    _free_partition_locks.pop_back();
+    node.key() = pk;
+    return _two_level_locks.insert(std::move(node)).position;
+}
+
+row_locker::two_level_lock::row_locks_type::iterator
+row_locker::find_or_create_row_lock(two_level_lock& partition_lock, const clustering_key_prefix& cpk) {
+    auto& row_locks = partition_lock._row_locks;
+    auto j = row_locks.find(cpk);
+    if (j != row_locks.end()) {
+        return j;
+    }
+    // Not yet locked, need to create the lock. This makes a copy of cpk.
+    if (_free_row_locks.empty()) {
+        return row_locks.emplace(cpk, lock_type()).first;
+    }
+    auto node = std::move(_free_row_locks.back());
+    _free_row_locks.pop_back();
+    node.key() = cpk;
+    return row_locks.insert(std::move(node)).position;
 }
 
 void row_locker::upgrade(schema_ptr new_schema) {
@@ -55,7 +89,7 @@ row_locker::lock_holder::lock_holder(row_locker* locker, const dht::decorated_ke
 future<row_locker::lock_holder>
 row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_clock::time_point timeout, stats& stats) {
     mylog.debug("taking {} lock on entire partition {}", (exclusive ? "exclusive" : "shared"), pk);
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = find_or_create_partition_lock(pk);
     single_lock_stats &single_lock_stats = exclusive ? stats.exclusive_partition : stats.shared_partition;
     single_lock_stats.operations_currently_waiting_for_lock++;
     utils::latency_counter waiting_latency;
@@ -76,27 +110,24 @@ row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_cl
 future<row_locker::lock_holder>
 row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& cpk, bool exclusive, db::timeout_clock::time_point timeout, stats& stats) {
     mylog.debug("taking shared lock on partition {}, and {} lock on row {} in it", pk, (exclusive ? "exclusive" : "shared"), cpk);
-    auto i = _two_level_locks.try_emplace(pk, this).first;
+    auto i = find_or_create_partition_lock(pk);
     future<lock_type::holder> lock_partition = i->second._partition_lock.hold_read_lock(timeout);
-    auto j = i->second._row_locks.find(cpk);
-    if (j == i->second._row_locks.end()) {
-        // Not yet locked, need to create the lock. This makes a copy of cpk.
-        try {
-            j = i->second._row_locks.emplace(cpk, lock_type()).first;
-        } catch(...) {
-            // If this emplace() failed, e.g., out of memory, we fail. We
-            // could do nothing - the partition lock we already started
-            // taking will be unlocked automatically after being locked.
-            // But it's better form to wait for the work we started, and it
-            // will also allow us to remove the hash-table row we added.
-            return lock_partition.then([ex = std::current_exception()] (auto lock) {
-                // The lock is automatically released when "lock" goes out of scope.
-                // TODO: unlock (lock = {}) now, search for the partition in the
-                // hash table (we know it's still there, because we held the lock until
-                // now) and remove the unused lock from the hash table if still unused.
-                return make_exception_future<row_locker::lock_holder>(std::current_exception());
-            });
-        }
+    two_level_lock::row_locks_type::iterator j;
+    try {
+        j = find_or_create_row_lock(i->second, cpk);
+    } catch(...) {
+        // If creating the lock failed, e.g., out of memory, we fail. We
+        // could do nothing - the partition lock we already started
+        // taking will be unlocked automatically after being locked.
+        // But it's better form to wait for the work we started, and it
+        // will also allow us to remove the hash-table row we added.
+        return lock_partition.then([ex = std::current_exception()] (auto lock) {
+            // The lock is automatically released when "lock" goes out of scope.
+            // TODO: unlock (lock = {}) now, search for the partition in the
+            // hash table (we know it's still there, because we held the lock until
+            // now) and remove the unused lock from the hash table if still unused.
+            return make_exception_future<row_locker::lock_holder>(std::current_exception());
+        });
     }
     single_lock_stats &single_lock_stats = exclusive ? stats.exclusive_row : stats.shared_row;
     single_lock_stats.operations_currently_waiting_for_lock++;
@@ -173,7 +204,10 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
             }
             if (!lock.locked()) {
                 mylog.debug("Erasing lock object for row {} in partition {}", *cpk, *pk);
-                pli->second._row_locks.erase(rli);
+                auto node = pli->second._row_locks.extract(rli);
+                if (_free_row_locks.size() < max_free_lock_entries) {
+                    _free_row_locks.push_back(std::move(node));
+                }
             }
         }
         mylog.debug("releasing {} lock for entire partition {}", (partition_exclusive ? "exclusive" : "shared"), *pk);
@@ -185,7 +219,10 @@ row_locker::unlock(const dht::decorated_key* pk, bool partition_exclusive,
         }
         if (!lock.locked()) {
             mylog.debug("Erasing lock object for partition {}", *pk);
-            _two_level_locks.erase(pli);
+            auto node = _two_level_locks.extract(pli);
+            if (_free_partition_locks.size() < max_free_lock_entries) {
+                _free_partition_locks.push_back(std::move(node));
+            }
         }
      }
 }
@@ -21,6 +21,7 @@
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include <seastar/core/rwlock.hh>
 #include <seastar/core/future.hh>
@@ -81,7 +82,8 @@ class row_locker {
                 return clustering_key_prefix::less_compare(*locker->_schema)(k1, k2);
             }
         };
-        std::map<clustering_key_prefix, lock_type, clustering_key_prefix_less> _row_locks;
+        using row_locks_type = std::map<clustering_key_prefix, lock_type, clustering_key_prefix_less>;
+        row_locks_type _row_locks;
         two_level_lock(row_locker* locker)
             : _row_locks(locker) { }
     };
@@ -97,7 +99,17 @@ class row_locker {
             return k1.equal(*locker->_schema, k2);
         }
     };
-    std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator> _two_level_locks;
+    using two_level_locks_type = std::unordered_map<dht::decorated_key, two_level_lock, decorated_key_hash, decorated_key_equals_comparator>;
+    two_level_locks_type _two_level_locks;
+    // Entries of released locks, kept for reuse by the next locks so that
+    // taking an uncontended lock doesn't allocate the hash table and tree
+    // nodes every time. Their capacity is reserved up front, so recycling an
+    // entry in unlock() never allocates.
+    static constexpr size_t max_free_lock_entries = 64;
+    std::vector<two_level_locks_type::node_type> _free_partition_locks;
+    std::vector<two_level_lock::row_locks_type::node_type> _free_row_locks;
+    two_level_locks_type::iterator find_or_create_partition_lock(const dht::decorated_key& pk);
+    two_level_lock::row_locks_type::iterator find_or_create_row_lock(two_level_lock& partition_lock, const clustering_key_prefix& cpk);
     void unlock(const dht::decorated_key* pk, bool partition_exclusive, const clustering_key_prefix* cpk, bool row_exclusive);
 public:
     // row_locker needs to know the column_family's schema because key
@@ -1212,8 +1212,14 @@ static future<> apply_to_remote_endpoints(gms::inet_address target, inet_address
 
 // Take the view mutations generated by generate_view_updates(), which pertain
 // to a modification of a single base partition, and apply them to the
-// appropriate paired replicas. This is done asynchronously - we do not wait
-// for the writes to complete.
+// appropriate paired replicas. Updates whose paired replica is this node are
+// applied locally with mutate_locally(), without going through the write
+// handlers of the storage proxy, and the returned future waits for them.
+// This is always the case for views whose partition key is the base
+// partition key, since the view token equals the base token and so pairs
+// with this node, so their updates are applied together with the base
+// write. Updates sent to other nodes are sent asynchronously - unless
+// wait_for_all is set, we do not wait for those writes to complete.
 future<> mutate_MV(
         dht::token base_token,
         utils::chunked_vector<frozen_mutation_and_schema> view_updates,
@@ -58,6 +58,12 @@ namespace db::view {
  * calculate and insert the respective entries for one or more views.
  *
  * We employ a flat_mutation_reader for each base table for which we're building views.
+ * All views of a base that are being built share this reader, so building N views of a base
+ * costs one scan of it, not N:
+ *   - A view created while others of its base are being built joins the scan at the current
+ *     token, and is done once the scan wraps around the ring back to that token;
+ *   - On restart, the scan resumes at the smallest next_token of the views being built. Views
+ *     that made more progress are skipped until the scan reaches their own next_token.
  *
  * We aim to be resource-conscious. On a given shard, at any given moment, we consume at most
  * from one reader. We also strive for fairness, in that each build step inserts entries for
@@ -8,6 +8,9 @@
 
 #include <seastar/util/defer.hh>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/numeric.hpp>
+#include <seastar/core/loop.hh>
 #include "view_update_generator.hh"
 #include "service/priority_manager.hh"
 #include "utils/error_injection.hh"
@@ -45,68 +48,22 @@ future<> view_update_generator::start() {
 
             // If we got here, we will process all tables we know about so far eventually so there
             // is no starvation
-            for (auto table_it = sstables_with_tables.begin(); table_it != sstables_with_tables.end(); table_it = sstables_with_tables.erase(table_it)) {
-                auto& [t, sstables] = *table_it;
-                schema_ptr s = t->schema();
-
-                vug_logger.trace("Processing {}.{}: {} sstables", s->ks_name(), s->cf_name(), sstables.size());
-
-                const auto num_sstables = sstables.size();
-
-                try {
-                    // Exploit the fact that sstables in the staging directory
-                    // are usually non-overlapping and use a partitioned set for
-                    // the read.
-                    auto ssts = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, make_lw_shared<sstable_list>(sstable_list{}), false));
-                    for (auto& sst : sstables) {
-                        ssts->insert(sst);
+            bool stop = false;
+            max_concurrent_for_each(sstables_with_tables, max_tables_in_parallel, [this, &stop] (auto& table_and_sstables) {
+                thread_attributes attr;
+                attr.sched_group = _db.get_streaming_scheduling_group();
+                return seastar::async(std::move(attr), [this, &stop, &table_and_sstables] {
+                    if (stop) {
+                        return;
                     }
-
-                    auto permit = _db.obtain_reader_permit(*t, "view_update_generator", db::no_timeout).get0();
-                    auto ms = mutation_source([this, ssts] (
-                                schema_ptr s,
-                                reader_permit permit,
-                                const dht::partition_range& pr,
-                                const query::partition_slice& ps,
-                                const io_priority_class& pc,
-                                tracing::trace_state_ptr ts,
-                                streamed_mutation::forwarding fwd_ms,
-                                mutation_reader::forwarding fwd_mr) {
-                        return ssts->make_range_sstable_reader(s, std::move(permit), pr, ps, pc, std::move(ts), fwd_ms, fwd_mr);
-                    });
-                    auto [staging_sstable_reader, staging_sstable_reader_handle] = make_manually_paused_evictable_reader_v2(
-                            std::move(ms),
-                            s,
-                            permit,
-                            query::full_partition_range,
-                            s->full_slice(),
-                            service::get_local_streaming_priority(),
-                            nullptr,
-                            ::mutation_reader::forwarding::no);
-
-                    inject_failure("view_update_generator_consume_staging_sstable");
-                    auto result = staging_sstable_reader.consume_in_thread(view_updating_consumer(s, std::move(permit), *t, sstables, _as, staging_sstable_reader_handle));
-                    staging_sstable_reader.close().get();
-                    if (result == stop_iteration::yes) {
-                        break;
+                    auto& [t, sstables] = table_and_sstables;
+                    if (process_staging_sstables(t, std::move(sstables)) == stop_iteration::yes) {
+                        stop = true;
                     }
-                } catch (...) {
-                    vug_logger.warn("Processing {} failed for table {}:{}. Will retry...", s->ks_name(), s->cf_name(), std::current_exception());
-                    // Need to add sstables back to the set so we can retry later. By now it may
-                    // have had other updates.
-                    std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_with_tables[t]));
-                    break;
-                }
-                try {
-                    inject_failure("view_update_generator_collect_consumed_sstables");
-                    // collect all staging sstables to move in a map, grouped by table.
-                    std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_to_move[t]));
-                } catch (...) {
-                    // Move from staging will be retried upon restart.
-                    vug_logger.warn("Moving {} from staging failed: {}:{}. Ignoring...", s->ks_name(), s->cf_name(), std::current_exception());
-                }
-                _registration_sem.signal(num_sstables);
-            }
+                });
+            }).get();
+            sstables_with_tables.clear();
+
             // For each table, move the processed staging sstables into the table's base dir.
             for (auto it = _sstables_to_move.begin(); it != _sstables_to_move.end(); ) {
                 auto& [t, sstables] = *it;
@@ -124,6 +81,74 @@ future<> view_update_generator::start() {
     return make_ready_future<>();
 }
 
+stop_iteration view_update_generator::process_staging_sstables(lw_shared_ptr<replica::table> t, std::vector<sstables::shared_sstable> sstables) {
+    schema_ptr s = t->schema();
+
+    vug_logger.trace("Processing {}.{}: {} sstables", s->ks_name(), s->cf_name(), sstables.size());
+
+    const auto num_sstables = sstables.size();
+    const auto bytes = boost::accumulate(sstables | boost::adaptors::transformed(std::mem_fn(&sstables::sstable::data_size)), uint64_t(0));
+
+    ++_tables_in_progress;
+    auto decrement = defer([this] () noexcept { --_tables_in_progress; });
+    try {
+        // Exploit the fact that sstables in the staging directory
+        // are usually non-overlapping and use a partitioned set for
+        // the read.
+        auto ssts = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, make_lw_shared<sstable_list>(sstable_list{}), false));
+        for (auto& sst : sstables) {
+            ssts->insert(sst);
+        }
+
+        auto permit = _db.obtain_reader_permit(*t, "view_update_generator", db::no_timeout).get0();
+        auto ms = mutation_source([this, ssts] (
+                    schema_ptr s,
+                    reader_permit permit,
+                    const dht::partition_range& pr,
+                    const query::partition_slice& ps,
+                    const io_priority_class& pc,
+                    tracing::trace_state_ptr ts,
+                    streamed_mutation::forwarding fwd_ms,
+                    mutation_reader::forwarding fwd_mr) {
+            return ssts->make_range_sstable_reader(s, std::move(permit), pr, ps, pc, std::move(ts), fwd_ms, fwd_mr);
+        });
+        auto [staging_sstable_reader, staging_sstable_reader_handle] = make_manually_paused_evictable_reader_v2(
+                std::move(ms),
+                s,
+                permit,
+                query::full_partition_range,
+                s->full_slice(),
+                service::get_local_streaming_priority(),
+                nullptr,
+                ::mutation_reader::forwarding::no);
+
+        inject_failure("view_update_generator_consume_staging_sstable");
+        auto result = staging_sstable_reader.consume_in_thread(view_updating_consumer(s, std::move(permit), *t, sstables, _as, staging_sstable_reader_handle));
+        staging_sstable_reader.close().get();
+        if (result == stop_iteration::yes) {
+            return stop_iteration::yes;
+        }
+    } catch (...) {
+        vug_logger.warn("Processing {} failed for table {}:{}. Will retry...", s->ks_name(), s->cf_name(), std::current_exception());
+        // Need to add sstables back to the set so we can retry later. By now it may
+        // have had other updates.
+        std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_with_tables[t]));
+        return stop_iteration::no;
+    }
+    _processed_sstables += num_sstables;
+    _processed_bytes += bytes;
+    try {
+        inject_failure("view_update_generator_collect_consumed_sstables");
+        // collect all staging sstables to move in a map, grouped by table.
+        std::move(sstables.begin(), sstables.end(), std::back_inserter(_sstables_to_move[t]));
+    } catch (...) {
+        // Move from staging will be retried upon restart.
+        vug_logger.warn("Moving {} from staging failed: {}:{}. Ignoring...", s->ks_name(), s->cf_name(), std::current_exception());
+    }
+    _registration_sem.signal(num_sstables);
+    return stop_iteration::no;
+}
+
 future<> view_update_generator::stop() {
     _as.request_abort();
     _pending_sstables.signal();
@@ -165,7 +190,19 @@ void view_update_generator::setup_metrics() {
 
         sm::make_gauge("sstables_to_move_count",
                 sm::description("Number of sets of sstables which are already processed and wait to be moved from their staging directory"),
-                [this] { return _sstables_to_move.size(); })
+                [this] { return _sstables_to_move.size(); }),
+
+        sm::make_gauge("tables_in_progress",
+                sm::description("Number of tables whose staging sstables are being processed"),
+                [this] { return _tables_in_progress; }),
+
+        sm::make_counter("processed_sstables",
+                sm::description("Number of staging sstables for which view updates were generated"),
+                [this] { return _processed_sstables; }),
+
+        sm::make_counter("processed_bytes",
+                sm::description("Size of the staging sstables for which view updates were generated"),
+                [this] { return _processed_bytes; })
     });
 }
 
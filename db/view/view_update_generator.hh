@@ -20,6 +20,10 @@ namespace db::view {
 class view_update_generator {
 public:
     static constexpr size_t registration_queue_size = 5;
+    // The number of tables whose staging sstables are processed in parallel.
+    // View updates generated for all of them go through the same view update
+    // concurrency semaphore, which limits the backlog they create.
+    static constexpr size_t max_tables_in_parallel = 4;
 
 private:
     replica::database& _db;
@@ -30,6 +34,9 @@ class view_update_generator {
     std::unordered_map<lw_shared_ptr<replica::table>, std::vector<sstables::shared_sstable>> _sstables_with_tables;
     std::unordered_map<lw_shared_ptr<replica::table>, std::vector<sstables::shared_sstable>> _sstables_to_move;
     metrics::metric_groups _metrics;
+    size_t _tables_in_progress = 0;
+    uint64_t _processed_sstables = 0;
+    uint64_t _processed_bytes = 0;
 public:
     view_update_generator(replica::database& db) : _db(db) {
         setup_metrics();
@@ -43,6 +50,9 @@ class view_update_generator {
     ssize_t available_register_units() const { return _registration_sem.available_units(); }
 private:
     bool should_throttle() const;
+    // Generates view updates from the staging sstables of one table.
+    // Must run in a seastar thread.
+    stop_iteration process_staging_sstables(lw_shared_ptr<replica::table> t, std::vector<sstables::shared_sstable> sstables);
     void setup_metrics();
     void discover_staging_sstables();
 };
@@ -36,6 +36,14 @@ bool virtual_table::contains_key(const dht::partition_range& pr, const dht::deco
     return pr.contains(dk, dht::ring_position_comparator(*_s));
 }
 
+bool virtual_table::contains_row(const query::clustering_row_ranges& ranges, const clustering_key& ck) const {
+    position_in_partition::less_compare less(*_s);
+    auto pos = position_in_partition_view::for_key(ck);
+    return std::any_of(ranges.begin(), ranges.end(), [&] (const query::clustering_range& r) {
+        return !less(pos, position_in_partition::for_range_start(r)) && less(pos, position_in_partition::for_range_end(r));
+    });
+}
+
 mutation_source memtable_filling_virtual_table::as_mutation_source() {
     return mutation_source([this] (schema_ptr s,
         reader_permit permit,
@@ -109,12 +117,15 @@ mutation_source streaming_virtual_table::as_mutation_source() {
             // Valid until handle.is_terminated(), which is set to true when the
             // queue_reader dies.
             const dht::partition_range* pr;
+            const query::partition_slice* slice;
             mutation_reader::forwarding fwd_mr;
 
-            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, queue_reader_handle_v2&& handle)
+            my_result_collector(schema_ptr s, reader_permit p, const dht::partition_range* pr, const query::partition_slice* slice,
+                    queue_reader_handle_v2&& handle)
                 : result_collector(s, p)
                 , handle(std::move(handle))
                 , pr(pr)
+                , slice(slice)
             { }
 
             // result_collector
@@ -129,10 +140,17 @@ mutation_source streaming_virtual_table::as_mutation_source() {
                 }
                 return *pr;
             }
+
+            const query::partition_slice& slice() const override {
+                if (handle.is_terminated()) {
+                    throw std::runtime_error("read abandoned");
+                }
+                return *slice;
+            }
         };
 
         auto reader_and_handle = make_queue_reader_v2(s, permit);
-        auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, std::move(reader_and_handle.second));
+        auto consumer = std::make_unique<my_result_collector>(s, permit, &pr, &slice, std::move(reader_and_handle.second));
         auto f = execute(permit, *consumer, *consumer);
 
         // It is safe to discard this future because:
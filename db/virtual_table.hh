@@ -29,12 +29,16 @@ class virtual_table {
 protected:
     void set_cell(row&, const bytes& column_name, data_value);
     bool contains_key(const dht::partition_range&, const dht::decorated_key&) const;
+    bool contains_row(const query::clustering_row_ranges&, const clustering_key&) const;
     bool this_shard_owns(const dht::decorated_key&) const;
 
 public:
     class query_restrictions {
     public:
         virtual const dht::partition_range& partition_range() const = 0;
+        // The clustering ranges of the query, in the table's order, also for reversed queries.
+        // A paged query resumes with the range starting after the last row of the previous page.
+        virtual const query::partition_slice& slice() const = 0;
     };
 
     explicit virtual_table(schema_ptr s) : _s(std::move(s)) {}
@@ -99,7 +103,15 @@ class result_collector {
 //
 //  - avoid emitting partitions for which this_shard_owns() returns false.
 //
-//  - avoid emitting partitions which fall outside result_collector::partition_range().
+//  - avoid emitting partitions which fall outside query_restrictions::partition_range().
+//
+//  - avoid emitting rows which fall outside the clustering ranges of query_restrictions::slice().
+//
+// Tables which can produce a lot of data should also generate it one partition
+// at a time, as they emit it, so that a page of the query costs memory for a
+// partition rather than for the whole table. The emitting functions return a
+// non-ready future when the reader's buffer is full, holding the generation back
+// until the reader consumes what was emitted.
 //
 class streaming_virtual_table : public virtual_table {
 public:
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2022-present ScyllaDB
+ */
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "serializer.hh"
+#include "schema.hh"
+#include "log.hh"
+#include "exceptions/exceptions.hh"
+
+extern logging::logger dblog;
+
+namespace db {
+
+/**
+ * \brief Schema extension which represents `write_coalescing_window_in_us` per-table option.
+ *
+ * When not zero, a replica holds a write to a partition of the table for up
+ * to this long, and merges the writes to the same partition which arrive
+ * meanwhile into it, so that they are appended to the commitlog and applied
+ * to the memtable as a single mutation. Every merged write is acknowledged
+ * once the merged mutation is applied.
+ *
+ * Meant for workloads sending bursts of tiny writes to the same partitions,
+ * at the cost of up to the window of added write latency.
+ */
+class write_coalescing_extension : public schema_extension {
+    int32_t _window_in_us;
+public:
+    static constexpr auto NAME = "write_coalescing_window_in_us";
+    // Longer windows would add too much latency to be useful.
+    static constexpr int32_t max_window_in_us = 10'000;
+
+    write_coalescing_extension() = default;
+
+    explicit write_coalescing_extension(int32_t us)
+        : _window_in_us(us)
+    {}
+
+    explicit write_coalescing_extension(const std::map<sstring, sstring>& map) {
+        on_internal_error(dblog, "Cannot create write_coalescing_extension from map");
+    }
+
+    explicit write_coalescing_extension(bytes b) : _window_in_us(deserialize(b))
+    {}
+
+    explicit write_coalescing_extension(const sstring& s)
+        : _window_in_us(std::stoi(s))
+    {
+        if (_window_in_us < 0 || _window_in_us > max_window_in_us) {
+            throw exceptions::configuration_exception(format("{} must be between 0 and {}, got {}", NAME, max_window_in_us, _window_in_us));
+        }
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(_window_in_us);
+    }
+
+    static int32_t deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<int32_t>());
+    }
+
+    int32_t get_window_in_us() const {
+        return _window_in_us;
+    }
+};
+
+} // namespace db
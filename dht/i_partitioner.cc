@@ -41,6 +41,13 @@ sharder::token_for_next_shard(const token& t, shard_id shard, unsigned spans) co
     return dht::token_for_next_shard(_shard_start, _shard_count, _sharding_ignore_msb_bits, t, shard, spans);
 }
 
+void
+i_partitioner::get_tokens(const schema& s, std::span<const partition_key> keys, std::span<token> tokens) const {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        tokens[i] = get_token(s, keys[i]);
+    }
+}
+
 std::ostream& operator<<(std::ostream& out, const decorated_key& dk) {
     return out << "{key: " << dk._key << ", token:" << dk._token << "}";
 }
@@ -350,6 +357,21 @@ dht::partition_range_vector to_partition_ranges(const dht::token_range_vector& r
     return prs;
 }
 
+dht::partition_range_vector split_ring_uniformly(unsigned count) {
+    dht::partition_range_vector ranges;
+    ranges.reserve(count);
+    auto step = std::numeric_limits<uint64_t>::max() / std::max(count, 1u);
+    std::optional<dht::partition_range::bound> start;
+    for (unsigned i = 1; i < count; ++i) {
+        auto boundary = dht::ring_position::starting_at(dht::token(dht::token::kind::key,
+                int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + i * step)));
+        ranges.emplace_back(std::move(start), dht::partition_range::bound(boundary, false));
+        start = dht::partition_range::bound(std::move(boundary), true);
+    }
+    ranges.emplace_back(std::move(start), std::nullopt);
+    return ranges;
+}
+
 std::map<unsigned, dht::partition_range_vector>
 split_range_to_shards(dht::partition_range pr, const schema& s) {
     std::map<unsigned, dht::partition_range_vector> ret;
@@ -22,6 +22,7 @@
 #include <utility>
 #include <vector>
 #include <compare>
+#include <span>
 #include "range.hh"
 #include <byteswap.h>
 #include "dht/token.hh"
@@ -151,6 +152,13 @@ class i_partitioner {
     virtual token get_token(const schema& s, partition_key_view key) const = 0;
     virtual token get_token(const sstables::key_view& key) const = 0;
 
+    /**
+     * Computes the token of each of keys into the matching element of tokens,
+     * which must be as long as keys. Partitioners which can hash many keys
+     * faster than one at a time override it.
+     */
+    virtual void get_tokens(const schema& s, std::span<const partition_key> keys, std::span<token> tokens) const;
+
     // FIXME: token.tokenFactory
     //virtual token.tokenFactory gettokenFactory() = 0;
 
@@ -643,6 +651,10 @@ split_range_to_shards(dht::partition_range pr, const schema& s);
 // Intersect a partition_range with a shard and return the the resulting sub-ranges, in sorted order
 future<utils::chunked_vector<partition_range>> split_range_to_single_shard(const schema& s, const dht::partition_range& pr, shard_id shard);
 
+// Splits the whole ring into count sorted, disjoint ranges, which span about the same
+// number of tokens each.
+dht::partition_range_vector split_ring_uniformly(unsigned count);
+
 std::unique_ptr<dht::i_partitioner> make_partitioner(sstring name);
 
 } // dht
@@ -52,6 +52,33 @@ murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
     return get_token(hash[0]);
 }
 
+void
+murmur3_partitioner::get_tokens(const schema& s, std::span<const partition_key> keys, std::span<token> tokens) const {
+    // The legacy form of a compound key isn't contiguous, only keys of a
+    // single column, stored in a single fragment, are hashed in bulk.
+    if (!s.partition_key_type()->is_singular()) {
+        return i_partitioner::get_tokens(s, keys, tokens);
+    }
+    std::vector<bytes_view> views;
+    views.reserve(keys.size());
+    for (const auto& key : keys) {
+        if (key.representation().empty()) {
+            views.emplace_back();
+            continue;
+        }
+        managed_bytes_view v = *key.view().begin();
+        if (v.current_fragment().size() != v.size_bytes()) {
+            return i_partitioner::get_tokens(s, keys, tokens);
+        }
+        views.push_back(v.current_fragment());
+    }
+    std::vector<std::array<uint64_t, 2>> hashes(keys.size());
+    utils::murmur_hash::hash3_x64_128(views, 0, hashes);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        tokens[i] = get_token(hashes[i][0]);
+    }
+}
+
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
 static registry registrator("org.apache.cassandra.dht.Murmur3Partitioner");
 static registry registrator_short_name("Murmur3Partitioner");
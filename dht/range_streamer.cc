@@ -34,10 +34,13 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                                     const std::unordered_set<std::unique_ptr<i_source_filter>>& source_filters,
                                     const sstring& keyspace) {
     std::unordered_map<inet_address, dht::token_range_vector> range_fetch_map_map;
+    auto& snitch = locator::i_endpoint_snitch::get_local_snitch_ptr();
+    std::vector<inet_address> candidates;
     for (auto x : ranges_with_sources) {
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        candidates.clear();
         for (auto address : addresses) {
             if (address == utils::fb_utilities::get_broadcast_address()) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -58,9 +61,28 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
+            candidates.push_back(address);
             found_source = true;
-            break; // ensure we only stream from one other node for each range
+        }
+
+        // Sources are sorted by proximity. Among the closest ones, stream from
+        // the one with the fewest ranges so far, so that the ranges are spread
+        // over all replicas rather than mostly fetched from the first one.
+        if (!candidates.empty()) {
+            auto source = candidates.front();
+            auto nr_ranges = [&] (const inet_address& address) {
+                auto it = range_fetch_map_map.find(address);
+                return it == range_fetch_map_map.end() ? size_t(0) : it->second.size();
+            };
+            for (auto address : candidates) {
+                if (snitch->compare_endpoints(_address, candidates.front(), address) != 0) {
+                    break;
+                }
+                if (nr_ranges(address) < nr_ranges(source)) {
+                    source = address;
+                }
+            }
+            range_fetch_map_map[source].push_back(range_); // ensure we only stream from one other node for each range
         }
 
         if (!found_source) {
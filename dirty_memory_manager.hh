@@ -14,6 +14,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/semaphore.hh>
 #include "replica/database_fwd.hh"
+#include "utils/estimated_histogram.hh"
 #include "utils/logalloc.hh"
 
 class dirty_memory_manager;
@@ -100,6 +101,22 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
 
     unsigned _extraneous_flushes = 0;
 
+    // Write throttling, see write_throttle_delay().
+    using clock = std::chrono::steady_clock;
+    static constexpr auto flush_bandwidth_sample_period = std::chrono::milliseconds(100);
+    static constexpr auto max_write_throttle_delay = std::chrono::milliseconds(100);
+    double _throttle_limit;
+    uint64_t _flushed_bytes = 0;
+    uint64_t _flushed_bytes_at_sample = 0;
+    clock::time_point _flush_bandwidth_sampled_at;
+    // In bytes per second, 0 until the first flush is measured.
+    double _flush_bandwidth = 0;
+    clock::time_point _next_write_at;
+    uint64_t _throttled_writes = 0;
+    utils::time_estimated_histogram _write_throttle_delays;
+
+    void update_flush_bandwidth(clock::time_point now) noexcept;
+
     seastar::metrics::metric_groups _metrics;
 public:
     void setup_collectd(sstring namestr);
@@ -138,21 +155,32 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
     //
     // We then set the soft limit to 80 % of the virtual dirty hard limit, which is equal to 40 % of
     // the user-supplied threshold.
-    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
+    //
+    // Throttle Limit
+    // --------------
+    // Without throttling, writes go at full speed until the hard limit is hit, and then all of them
+    // wait until a flush frees memory. When the throttle limit, a portion of the virtual dirty hard
+    // limit, is set, writes are delayed once virtual dirty memory is above it, so that they are
+    // admitted at the measured flush bandwidth divided by how far virtual dirty memory is between the
+    // throttle limit and the hard limit. At the hard limit writes go only as fast as memtables are
+    // flushed. 0 disables throttling.
+    dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, double throttle_limit, scheduling_group deferred_work_sg)
         : logalloc::region_group_reclaimer(threshold / 2, threshold * soft_limit / 2)
         , _real_dirty_reclaimer(threshold)
         , _db(&db)
         , _real_region_group("memtable", _real_dirty_reclaimer, deferred_work_sg)
         , _virtual_region_group("memtable (virtual)", &_real_region_group, *this, deferred_work_sg)
         , _flush_serializer(1)
-        , _waiting_flush(flush_when_needed()) {}
+        , _waiting_flush(flush_when_needed())
+        , _throttle_limit(throttle_limit) {}
 
     dirty_memory_manager() : logalloc::region_group_reclaimer()
         , _db(nullptr)
         , _real_region_group("memtable", _real_dirty_reclaimer)
         , _virtual_region_group("memtable (virtual)", &_real_region_group, *this)
         , _flush_serializer(1)
-        , _waiting_flush(make_ready_future<>()) {}
+        , _waiting_flush(make_ready_future<>())
+        , _throttle_limit(0) {}
 
     static dirty_memory_manager& from_region_group(logalloc::region_group *rg) {
         return *(boost::intrusive::get_parent_from_member(rg, &dirty_memory_manager::_virtual_region_group));
@@ -176,6 +204,7 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
         _real_region_group.update(delta);
         _virtual_region_group.update(-delta);
         _dirty_bytes_released_pre_accounted += delta;
+        _flushed_bytes += delta;
     }
 
     void pin_real_dirty_memory(int64_t delta) {
@@ -194,6 +223,15 @@ class dirty_memory_manager: public logalloc::region_group_reclaimer {
         return _virtual_region_group.memory_used();
     }
 
+    // Returns how long a write of the given size should wait before it is applied, so that writes
+    // slow down gradually above the throttle limit instead of stalling at the hard limit. Writes
+    // which are given a delay are spaced apart in the order they called this.
+    clock::duration write_throttle_delay(size_t size) noexcept;
+
+    double flush_bandwidth() const noexcept {
+        return _flush_bandwidth;
+    }
+
     future<> flush_one(replica::memtable_list& cf, flush_permit&& permit);
 
     future<flush_permit> get_flush_permit() {
@@ -29,12 +29,12 @@ frozen_schema::frozen_schema(const schema_ptr& s)
         std::move(wr).write_version(s->version())
                      .write_mutations(sm)
                      .end_schema();
-        return out;
+        return std::make_shared<const bytes_ostream>(std::move(out));
     }())
 { }
 
 schema_ptr frozen_schema::unfreeze(const db::schema_ctxt& ctxt) const {
-    auto in = ser::as_input_stream(_data);
+    auto in = ser::as_input_stream(*_data);
     auto sv = ser::deserialize(in, boost::type<ser::schema_view>());
     return sv.mutations().is_view()
          ? db::schema_tables::create_view_from_mutations(ctxt, sv.mutations(), sv.version())
@@ -42,10 +42,10 @@ schema_ptr frozen_schema::unfreeze(const db::schema_ctxt& ctxt) const {
 }
 
 frozen_schema::frozen_schema(bytes_ostream b)
-    : _data(std::move(b))
+    : _data(std::make_shared<const bytes_ostream>(std::move(b)))
 { }
 
 const bytes_ostream& frozen_schema::representation() const
 {
-    return _data;
+    return *_data;
 }
@@ -12,14 +12,20 @@
 #include "frozen_mutation.hh"
 #include "bytes_ostream.hh"
 
+#include <memory>
+
 namespace db {
 class schema_ctxt;
 }
 
 // Transport for schema_ptr across shards/nodes.
 // It's safe to access from another shard by const&.
+//
+// Copies share the serialized form, including copies made on other shards,
+// so schema registries of all shards can hold the same version without
+// duplicating it.
 class frozen_schema {
-    bytes_ostream _data;
+    std::shared_ptr<const bytes_ostream> _data;
 public:
     explicit frozen_schema(bytes_ostream);
     frozen_schema(const schema_ptr&);
@@ -141,6 +141,8 @@ extern const std::string_view SUPPORTS_RAFT_CLUSTER_MANAGEMENT;
 extern const std::string_view USES_RAFT_CLUSTER_MANAGEMENT;
 extern const std::string_view TOMBSTONE_GC_OPTIONS;
 extern const std::string_view PARALLELIZED_AGGREGATION;
+extern const std::string_view PARALLELIZED_NATIVE_AGGREGATES;
+extern const std::string_view COUNT_ONLY_READS;
 
 }
 
@@ -66,6 +66,8 @@ constexpr std::string_view features::SUPPORTS_RAFT_CLUSTER_MANAGEMENT = "SUPPORT
 constexpr std::string_view features::USES_RAFT_CLUSTER_MANAGEMENT = "USES_RAFT_CLUSTER_MANAGEMENT";
 constexpr std::string_view features::TOMBSTONE_GC_OPTIONS = "TOMBSTONE_GC_OPTIONS";
 constexpr std::string_view features::PARALLELIZED_AGGREGATION = "PARALLELIZED_AGGREGATION";
+constexpr std::string_view features::PARALLELIZED_NATIVE_AGGREGATES = "PARALLELIZED_NATIVE_AGGREGATES";
+constexpr std::string_view features::COUNT_ONLY_READS = "COUNT_ONLY_READS";
 
 static logging::logger logger("features");
 
@@ -97,6 +99,8 @@ feature_service::feature_service(feature_config cfg) : _config(cfg)
         , _uses_raft_cluster_mgmt(*this, features::USES_RAFT_CLUSTER_MANAGEMENT)
         , _tombstone_gc_options(*this, features::TOMBSTONE_GC_OPTIONS)
         , _parallelized_aggregation(*this, features::PARALLELIZED_AGGREGATION)
+        , _parallelized_native_aggregates(*this, features::PARALLELIZED_NATIVE_AGGREGATES)
+        , _count_only_reads(*this, features::COUNT_ONLY_READS)
 {}
 
 feature_config feature_config_from_db_config(db::config& cfg, std::set<sstring> disabled) {
@@ -232,6 +236,8 @@ std::set<std::string_view> feature_service::known_feature_set() {
         gms::features::USES_RAFT_CLUSTER_MANAGEMENT,
         gms::features::TOMBSTONE_GC_OPTIONS,
         gms::features::PARALLELIZED_AGGREGATION,
+        gms::features::PARALLELIZED_NATIVE_AGGREGATES,
+        gms::features::COUNT_ONLY_READS,
     };
 
     for (const sstring& s : _config._disabled_features) {
@@ -343,6 +349,8 @@ void feature_service::enable(const std::set<std::string_view>& list) {
         std::ref(_uses_raft_cluster_mgmt),
         std::ref(_tombstone_gc_options),
         std::ref(_parallelized_aggregation),
+        std::ref(_parallelized_native_aggregates),
+        std::ref(_count_only_reads),
     })
     {
         if (list.contains(f.name())) {
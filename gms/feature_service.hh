@@ -93,6 +93,8 @@ class feature_service final {
     gms::feature _uses_raft_cluster_mgmt;
     gms::feature _tombstone_gc_options;
     gms::feature _parallelized_aggregation;
+    gms::feature _parallelized_native_aggregates;
+    gms::feature _count_only_reads;
 
 public:
 
@@ -199,6 +201,14 @@ class feature_service final {
         return bool(_parallelized_aggregation);
     }
 
+    bool cluster_supports_parallelized_native_aggregates() const {
+        return bool(_parallelized_native_aggregates);
+    }
+
+    bool cluster_supports_count_only_reads() const {
+        return bool(_count_only_reads);
+    }
+
     const feature& cluster_supports_raft_cluster_mgmt() const {
         return _supports_raft_cluster_mgmt;
     }
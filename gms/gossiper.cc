@@ -38,6 +38,7 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include "utils/generation-number.hh"
+#include "utils/histogram_metrics_helper.hh"
 #include "locator/token_metadata.hh"
 
 namespace gms {
@@ -98,6 +99,16 @@ gossiper::gossiper(abort_source& as, feature_service& features, const locator::s
         , _failure_detector_timeout_ms(cfg.failure_detector_timeout_in_ms)
         , _force_gossip_generation(cfg.force_gossip_generation)
         , _gcfg(std::move(gcfg)) {
+    namespace sm = seastar::metrics;
+    // The failure detector loop pings live nodes from all shards
+    _metrics.add_group("gossip", {
+        sm::make_histogram("echo_latency",
+            sm::description("Round trip time, in microseconds, of the echo messages sent to live nodes by the failure detector"),
+            [this] { return to_metrics_histogram(_echo_latency); }),
+        sm::make_counter("echo_failures", _echo_failures,
+            sm::description("Counts echo messages sent to live nodes by the failure detector which failed or timed out")),
+    });
+
     // Gossiper's stuff below runs only on CPU0
     if (this_shard_id() != 0) {
         return;
@@ -108,7 +119,6 @@ gossiper::gossiper(abort_source& as, feature_service& features, const locator::s
     fat_client_timeout = quarantine_delay() / 2;
     register_(make_shared<feature_enabler>(*this));
     // Register this instance with JMX
-    namespace sm = seastar::metrics;
     auto ep = get_broadcast_address();
     _metrics.add_group("gossip", {
         sm::make_derive("heart_beat",
@@ -740,17 +750,36 @@ future<> gossiper::failure_detector_loop_for_node(gms::inet_address node, int64_
     auto diff = gossiper::clk::duration(0);
     auto echo_interval = std::chrono::milliseconds(2000);
     auto max_duration = echo_interval + std::chrono::milliseconds(_failure_detector_timeout_ms());
+    // Time this shard may spend not running us beyond what a step of the loop
+    // should take, before the delay is blamed on a local stall rather than on
+    // the node, as failure_detector::interpret() does for heartbeats.
+    auto max_local_pause = std::chrono::milliseconds(5000);
+    auto local_pause = [&] (gossiper::clk::duration elapsed, gossiper::clk::duration expected) {
+        if (elapsed <= expected + max_local_pause) {
+            return false;
+        }
+        logger.warn("failure_detector_loop: Not marking node {} down due to local pause of {} > {} (milliseconds)", node,
+                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed - expected).count(), max_local_pause.count());
+        return true;
+    };
     while (is_enabled()) {
         bool failed = false;
+        auto echo_start = gossiper::clk::now();
+        auto latency_start = utils::time_estimated_histogram::clock::now();
         try {
             logger.debug("failure_detector_loop: Send echo to node {}, status = started", node);
             co_await _messaging.send_gossip_echo(netw::msg_addr(node), gossip_generation, max_duration);
+            _echo_latency.add(utils::time_estimated_histogram::clock::now() - latency_start);
             logger.debug("failure_detector_loop: Send echo to node {}, status = ok", node);
         } catch (...) {
             failed = true;
+            ++_echo_failures;
             logger.warn("failure_detector_loop: Send echo to node {}, status = failed: {}", node, std::current_exception());
         }
         auto now = gossiper::clk::now();
+        if (local_pause(now - echo_start, max_duration)) {
+            last = now;
+        }
         diff = now - last;
         if (!failed) {
             last = now;
@@ -772,7 +801,11 @@ future<> gossiper::failure_detector_loop_for_node(gms::inet_address node, int64_
                     node, _live_endpoints, _live_endpoints_version, live_endpoints_version);
             co_return;
         } else  {
+            auto sleep_start = gossiper::clk::now();
             co_await sleep_abortable(echo_interval, _abort_source);
+            if (local_pause(gossiper::clk::now() - sleep_start, echo_interval)) {
+                last = gossiper::clk::now();
+            }
         }
     }
     co_return;
@@ -28,6 +28,7 @@
 #include "gms/gossip_digest.hh"
 #include "utils/loading_shared_values.hh"
 #include "utils/updateable_value.hh"
+#include "utils/estimated_histogram.hh"
 #include "utils/in.hh"
 #include "message/messaging_service_fwd.hh"
 #include <optional>
@@ -598,6 +599,10 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
     future<> maybe_enable_features();
 private:
     seastar::metrics::metric_groups _metrics;
+    // Round trip times of the echoes sent by failure_detector_loop_for_node()
+    // on this shard, and the number of echoes which failed.
+    utils::time_estimated_histogram _echo_latency;
+    uint64_t _echo_failures = 0;
 public:
     void append_endpoint_state(std::stringstream& ss, const endpoint_state& state);
 public:
@@ -2,6 +2,10 @@ namespace query {
 struct forward_request {
     enum class reduction_type : uint8_t {
         count,
+        count_column,
+        sum,
+        min,
+        max,
     };
     std::vector<query::forward_request::reduction_type> reduction_types;
 
@@ -10,6 +14,7 @@ struct forward_request {
 
     db::consistency_level cl;
     lowres_clock::time_point timeout;
+    std::vector<sstring> reduction_columns [[version 5.1]];
 };
 
 struct forward_result {
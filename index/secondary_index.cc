@@ -27,6 +27,7 @@ const sstring db::index::secondary_index::custom_index_option_name = "class_name
 const sstring db::index::secondary_index::index_keys_option_name = "index_keys";
 const sstring db::index::secondary_index::index_values_option_name = "index_values";
 const sstring db::index::secondary_index::index_entries_option_name = "index_keys_and_values";
+const sstring db::index::secondary_index::included_columns_option_name = "included_columns";
 
 namespace secondary_index {
 
@@ -150,4 +151,33 @@ sstring target_parser::serialize_targets(const std::vector<::shared_ptr<cql3::st
     return rjson::print(json_map);
 }
 
+std::vector<const column_definition*> target_parser::parse_included_columns(schema_ptr schema, const index_metadata& im) {
+    std::vector<const column_definition*> columns;
+    auto it = im.options().find(db::index::secondary_index::included_columns_option_name);
+    if (it == im.options().end()) {
+        return columns;
+    }
+    std::optional<rjson::value> json_value = rjson::try_parse(it->second);
+    if (!json_value || !json_value->IsArray()) {
+        throw exceptions::configuration_exception(format("Unable to parse included columns for index {} ({})", im.name(), it->second));
+    }
+    for (const rjson::value& v : json_value->GetArray()) {
+        auto name = rjson::to_string_view(v);
+        const column_definition* cdef = schema->get_column_definition(utf8_type->decompose(sstring(name)));
+        if (!cdef) {
+            throw exceptions::configuration_exception(format("Column {} included in index {} not found", name, im.name()));
+        }
+        columns.push_back(cdef);
+    }
+    return columns;
+}
+
+sstring target_parser::serialize_included_columns(const std::vector<::shared_ptr<cql3::column_identifier>>& columns) {
+    rjson::value json_array = rjson::empty_array();
+    for (const auto& column : columns) {
+        rjson::push_back(json_array, rjson::from_string(column->to_string()));
+    }
+    return rjson::print(json_array);
+}
+
 }
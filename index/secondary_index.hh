@@ -43,6 +43,12 @@ class secondary_index {
      */
     static const sstring index_entries_option_name;
 
+    /**
+     * The name of the option listing the base columns copied into the index table
+     * with CREATE INDEX ... INCLUDE (...).
+     */
+    static const sstring included_columns_option_name;
+
 };
 
 }
@@ -138,8 +138,17 @@ view_ptr secondary_index_manager::create_view_for_index(const index_metadata& im
         }
         builder.with_column(col.name(), col.type, column_kind::clustering_key);
     }
+    // Included columns are copied into the index table, so that queries
+    // selecting only them and the key columns don't need to read the base.
+    auto included_columns = target_parser::parse_included_columns(schema, im);
+    for (auto* def : included_columns) {
+        builder.with_column(def->name(), def->type, column_kind::regular_column);
+    }
     if (index_target->is_primary_key()) {
         for (auto& def : schema->regular_columns()) {
+            if (boost::algorithm::any_of_equal(included_columns, &def)) {
+                continue;
+            }
             db::view::create_virtual_column(builder, def.name(), def.type);
         }
     }
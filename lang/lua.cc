@@ -57,9 +57,22 @@ class lua_slice_state {
         : a_state(std::move(a_state))
         , _l(std::move(l)) {}
     operator lua_State*() { return _l.get(); }
+    const alloc_state& allocator() const { return *a_state; }
 };
 }
 
+struct lua::state_cache::state {
+    lua_slice_state l;
+    // Registry references to the loaded chunk, and to the snapshot of the
+    // global environment taken before its first call.
+    int function_ref;
+    int snapshot_ref;
+};
+
+void lua::state_cache::state_deleter::operator()(state* s) const {
+    delete s;
+}
+
 static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
     auto* s = reinterpret_cast<alloc_state*>(ud);
 
@@ -446,6 +459,149 @@ static lua_slice_state load_script(const lua::runtime_config& cfg, lua::bitcode_
     return l;
 }
 
+// Adds to the snapshot at index snap a copy of the table at index t, and
+// its metatable, or false if it has none.
+static void snapshot_table(lua_State* l, int snap, int t) {
+    lua_pushvalue(l, t);
+    lua_rawget(l, snap);
+    bool seen = !lua_isnil(l, -1);
+    lua_pop(l, 1);
+    if (seen) {
+        return;
+    }
+    lua_pushvalue(l, t);
+    lua_createtable(l, 2, 0);
+    lua_newtable(l);
+    lua_pushnil(l);
+    while (lua_next(l, t)) {
+        lua_pushvalue(l, -2);
+        lua_insert(l, -2);
+        lua_rawset(l, -4);
+    }
+    lua_rawseti(l, -2, 1);
+    if (!lua_getmetatable(l, t)) {
+        lua_pushboolean(l, 0);
+    }
+    lua_rawseti(l, -2, 2);
+    lua_rawset(l, snap);
+}
+
+// The environment a script can modify without the debug library: the
+// global table, the tables stored in it (the libraries), and the
+// metatables of strings and decimals.
+static int snapshot_globals_l(lua_State* l) {
+    lua_newtable(l);
+    int snap = lua_gettop(l);
+    lua_pushglobaltable(l);
+    int g = lua_gettop(l);
+    snapshot_table(l, snap, g);
+    lua_pushnil(l);
+    while (lua_next(l, g)) {
+        if (lua_istable(l, -1)) {
+            snapshot_table(l, snap, lua_gettop(l));
+        }
+        lua_pop(l, 1);
+    }
+    lua_pushliteral(l, "");
+    if (lua_getmetatable(l, -1)) {
+        snapshot_table(l, snap, lua_gettop(l));
+    }
+    luaL_getmetatable(l, scylla_decimal_metatable_name);
+    snapshot_table(l, snap, lua_gettop(l));
+    lua_settop(l, snap);
+    return 1;
+}
+
+static int globals_unchanged_l(lua_State* l) {
+    lua_pushnil(l);
+    while (lua_next(l, 1)) {
+        int t = lua_gettop(l) - 1;
+        int entry = lua_gettop(l);
+        lua_rawgeti(l, entry, 1);
+        int copy = lua_gettop(l);
+        long n = 0;
+        lua_pushnil(l);
+        while (lua_next(l, t)) {
+            ++n;
+            lua_pushvalue(l, -2);
+            lua_rawget(l, copy);
+            if (!lua_rawequal(l, -1, -2)) {
+                lua_pushboolean(l, 0);
+                return 1;
+            }
+            lua_pop(l, 2);
+        }
+        lua_pushnil(l);
+        while (lua_next(l, copy)) {
+            --n;
+            lua_pop(l, 1);
+        }
+        lua_rawgeti(l, entry, 2);
+        if (!lua_getmetatable(l, t)) {
+            lua_pushboolean(l, 0);
+        }
+        if (n != 0 || !lua_rawequal(l, -1, -2)) {
+            lua_pushboolean(l, 0);
+            return 1;
+        }
+        lua_settop(l, t);
+    }
+    // A script could also have stopped the collector.
+    lua_pushboolean(l, lua_gc(l, LUA_GCISRUNNING, 0));
+    return 1;
+}
+
+static int prepare_state_l(lua_State* l) {
+    int function_ref = luaL_ref(l, LUA_REGISTRYINDEX);
+    snapshot_globals_l(l);
+    int snapshot_ref = luaL_ref(l, LUA_REGISTRYINDEX);
+    lua_pushinteger(l, function_ref);
+    lua_pushinteger(l, snapshot_ref);
+    return 2;
+}
+
+static lua::state_cache::state_ptr take_state(lua::state_cache& cache, const lua::runtime_config& cfg, lua::bitcode_view binary) {
+    while (!cache.states.empty()) {
+        lua::state_cache::state_ptr s = std::move(cache.states.back());
+        cache.states.pop_back();
+        // A state keeps the limits it was created with.
+        const alloc_state& a = s->l.allocator();
+        if (a.max == cfg.max_bytes() && a.max_contiguous == cfg.max_contiguous()) {
+            return s;
+        }
+    }
+
+    lua_slice_state l = load_script(cfg, binary);
+    // Keep the chunk in the registry, so that a state can call it again.
+    lua_pushcfunction(l, prepare_state_l);
+    lua_insert(l, 1);
+    if (lua_pcall(l, 1, 2, 0)) {
+        throw std::runtime_error(std::string("could not initiate: ") + lua_tostring(l, -1));
+    }
+    int function_ref = lua_tointeger(l, 1);
+    int snapshot_ref = lua_tointeger(l, 2);
+    lua_settop(l, 0);
+    return lua::state_cache::state_ptr(new lua::state_cache::state{std::move(l), function_ref, snapshot_ref});
+}
+
+// Puts a state back after a successful call, unless the call modified the
+// environment the next one would see.
+static void put_state(lua::state_cache& cache, lua::state_cache::state_ptr s) {
+    if (cache.states.size() >= lua::state_cache::max_states) {
+        return;
+    }
+    lua_slice_state& l = s->l;
+    lua_settop(l, 0);
+    lua_sethook(l, nullptr, 0, 0);
+    lua_pushcfunction(l, globals_unchanged_l);
+    lua_rawgeti(l, LUA_REGISTRYINDEX, s->snapshot_ref);
+    bool unchanged = lua_pcall(l, 1, 1, 0) == LUA_OK && lua_toboolean(l, -1);
+    lua_settop(l, 0);
+    if (unchanged) {
+        cache.states.push_back(std::move(s));
+    }
+}
+
 using millisecond = std::chrono::duration<double, std::milli>;
 static auto now() { return std::chrono::system_clock::now(); }
 
@@ -1069,8 +1225,10 @@ lua::runtime_config lua::make_runtime_config(const db::config& config) {
 }
 
 // run the script for at most max_instructions
-future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg) {
-    lua_slice_state l = load_script(cfg, bitcode);
+future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<data_value>& values, data_type return_type, const lua::runtime_config& cfg, lua::state_cache& cache) {
+    lua::state_cache::state_ptr s = take_state(cache, cfg, bitcode);
+    lua_slice_state& l = s->l;
+    lua_rawgeti(l, LUA_REGISTRYINDEX, s->function_ref);
     unsigned nargs = values.size();
     if (!lua_checkstack(l, nargs)) {
         throw std::runtime_error("could push args to the stack");
@@ -1084,7 +1242,8 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
     using duration = std::chrono::system_clock::duration;
     duration elapsed{0};
     duration timeout = std::chrono::duration_cast<duration>(millisecond(cfg.timeout_in_ms));
-    return repeat_until_value([l = std::move(l), elapsed, return_type, nargs, timeout = std::move(timeout)] () mutable {
+    return repeat_until_value([s = std::move(s), &cache, elapsed, return_type, nargs, timeout = std::move(timeout)] () mutable {
+        lua_slice_state& l = s->l;
         // Set the hook before resuming. We have to do it here since the hook can reset itself
         // if it detects we are spending too much time in C.
         // The hook will be called after 1000 instructions.
@@ -1092,8 +1251,11 @@ future<bytes_opt> lua::run_script(lua::bitcode_view bitcode, const std::vector<d
         auto start = ::now();
         LUA_504_PLUS(int nresults;)
         switch (lua_resume(l, nullptr, nargs LUA_504_PLUS(, &nresults))) {
-        case LUA_OK:
-            return make_ready_future<std::optional<bytes_opt>>(convert_return(l, return_type));
+        case LUA_OK: {
+            bytes_opt ret = convert_return(l, return_type);
+            put_state(cache, std::move(s));
+            return make_ready_future<std::optional<bytes_opt>>(std::move(ret));
+        }
         case LUA_YIELD: {
             nargs = 0;
             elapsed += ::now() - start;
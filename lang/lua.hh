@@ -11,6 +11,8 @@
 #include "types.hh"
 #include "utils/updateable_value.hh"
 #include <seastar/core/future.hh>
+#include <memory>
+#include <vector>
 
 namespace db {
 class config;
@@ -30,7 +32,24 @@ struct runtime_config {
 
 runtime_config make_runtime_config(const db::config& config);
 
+// Lua states that already loaded the bitcode of one function, kept so
+// that calling the function doesn't create a state and load the bitcode
+// each time. A call takes a state out for its duration, so concurrent
+// calls never share one, and puts it back only if the call left the
+// global environment as it found it.
+struct state_cache {
+    struct state;
+    struct state_deleter {
+        void operator()(state* s) const;
+    };
+    using state_ptr = std::unique_ptr<state, state_deleter>;
+
+    static constexpr size_t max_states = 4;
+    std::vector<state_ptr> states;
+};
+
 sstring compile(const runtime_config& cfg, const std::vector<sstring>& arg_names, sstring script);
+// The cache must hold states of the same bitcode, and outlive the returned future.
 seastar::future<bytes_opt> run_script(bitcode_view bitcode, const std::vector<data_value>& values,
-                                      data_type return_type, const runtime_config& cfg);
+                                      data_type return_type, const runtime_config& cfg, state_cache& cache);
 }
@@ -14,7 +14,6 @@
 #include "utils/ascii.hh"
 #include "utils/date.h"
 #include "db/config.hh"
-#include <seastar/core/coroutine.hh>
 #include <seastar/util/defer.hh>
 #include "seastarx.hh"
 
@@ -236,16 +235,30 @@ struct from_val_visitor {
     }
 };
 
-seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
-    wasm_logger.debug("Running function {}", ctx.function_name);
+// Arguments passed through memory grow the instance's memory on every call,
+// so a reused instance is dropped once its memory gets larger than this.
+static constexpr size_t max_reused_instance_memory = 16 * 1024 * 1024;
 
-    auto store = wasmtime::Store(ctx.engine_ptr->get());
-    // Replenish the store with initial amount of fuel
-    auto added = store.context().add_fuel(ctx.engine_ptr->initial_fuel_amount());
-    if (!added) {
-        co_return coroutine::make_exception(wasm::exception(added.err().message()));
+static wasm::instance& get_instance(context& ctx) {
+    if (!ctx.instance) {
+        wasmtime::Store store(ctx.engine_ptr->get());
+        // Fill the store with the initial amount of fuel. The fuel consumed
+        // by each call is added back after it, so that every call starts
+        // with the same amount.
+        auto added = store.context().add_fuel(ctx.engine_ptr->initial_fuel_amount());
+        if (!added) {
+            throw wasm::exception(added.err().message());
+        }
+        auto [instance, func] = create_instance_and_func(ctx, store);
+        ctx.instance.emplace(wasm::instance{std::move(store), std::move(instance), std::move(func)});
     }
-    auto [instance, func] = create_instance_and_func(ctx, store);
+    return *ctx.instance;
+}
+
+static bytes_opt call_instance(context& ctx, wasm::instance& inst, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
+    auto& store = inst.store;
+    auto& instance = inst.instance;
+    auto& func = inst.func;
     std::vector<wasmtime::Val> argv;
     for (size_t i = 0; i < arg_types.size(); ++i) {
         const abstract_type& type = *arg_types[i];
@@ -257,7 +270,7 @@ seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>
         } else if (param) {
             visit(type, init_arg_visitor{param, argv, store, instance});
         } else {
-            co_return coroutine::make_exception(wasm::exception(format("Function {} cannot be called on null values", ctx.function_name)));
+            throw wasm::exception(format("Function {} cannot be called on null values", ctx.function_name));
         }
     }
     uint64_t fuel_before = *store.context().fuel_consumed();
@@ -268,11 +281,15 @@ seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>
     wasm_logger.debug("Consumed {} fuel units", consumed);
 
     if (!result) {
-        co_return coroutine::make_exception(wasm::exception("Calling wasm function failed: " + result.err().message()));
+        throw wasm::exception("Calling wasm function failed: " + result.err().message());
+    }
+    auto added = store.context().add_fuel(consumed);
+    if (!added) {
+        throw wasm::exception(added.err().message());
     }
     std::vector<wasmtime::Val> result_vec = std::move(result).unwrap();
     if (result_vec.size() != 1) {
-      co_return coroutine::make_exception(wasm::exception(format("Unexpected number of returned values: {} (expected: 1)", result_vec.size())));
+        throw wasm::exception(format("Unexpected number of returned values: {} (expected: 1)", result_vec.size()));
     }
 
     // TODO: ABI for return values is experimental and subject to change in the future.
@@ -291,9 +308,29 @@ seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>
     if (allow_null_input) {
         // Force calling the default method for abstract_type, which checks for nulls
         // and expects a serialized input
-        co_return from_val_visitor{result_vec[0], store, instance}(static_cast<const abstract_type&>(*return_type));
+        return from_val_visitor{result_vec[0], store, instance}(static_cast<const abstract_type&>(*return_type));
     } else {
-        co_return visit(*return_type, from_val_visitor{result_vec[0], store, instance});
+        return visit(*return_type, from_val_visitor{result_vec[0], store, instance});
+    }
+}
+
+seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
+    wasm_logger.debug("Running function {}", ctx.function_name);
+
+    try {
+        wasm::instance& inst = get_instance(ctx);
+        bytes_opt ret = call_instance(ctx, inst, arg_types, params, std::move(return_type), allow_null_input);
+        auto memory_export = inst.instance.get(inst.store, "memory");
+        auto memory = memory_export ? std::get_if<wasmtime::Memory>(&*memory_export) : nullptr;
+        if (memory && memory->data(inst.store).size() > max_reused_instance_memory) {
+            ctx.instance.reset();
+        }
+        return make_ready_future<bytes_opt>(std::move(ret));
+    } catch (...) {
+        // A failed call may have left the instance in an inconsistent
+        // state, so it is not reused.
+        ctx.instance.reset();
+        return make_exception_future<bytes_opt>(std::current_exception());
     }
 }
 
@@ -25,10 +25,20 @@ struct exception : public std::exception {
 
 #ifdef SCYLLA_ENABLE_WASMTIME
 
+// A ready instance of a function's module, with the store that owns it.
+// It is created on the first call of the function on a shard and reused by
+// the following calls, instead of instantiating the module for every row.
+struct instance {
+    wasmtime::Store store;
+    wasmtime::Instance instance;
+    wasmtime::Func func;
+};
+
 struct context {
     wasm::engine* engine_ptr;
     std::optional<wasmtime::Module> module;
     std::string function_name;
+    std::optional<wasm::instance> instance;
 
     context(wasm::engine* engine_ptr, std::string name);
 };
@@ -12,6 +12,7 @@
 #include <boost/range/algorithm/remove_if.hpp>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
+#include <seastar/core/metrics.hh>
 #include "utils/stall_free.hh"
 
 namespace locator {
@@ -67,9 +68,7 @@ sstring abstract_replication_strategy::to_qualified_class_name(std::string_view
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpoints(const token& search_token, const effective_replication_map& erm) const {
-    const token& key_token = erm.get_token_metadata_ptr()->first_token(search_token);
-    auto res = erm.get_replication_map().find(key_token);
-    return res->second;
+    return erm.get_replication_map()[erm.get_token_metadata_ptr()->first_token_index(search_token)];
 }
 
 inet_address_vector_replica_set effective_replication_map::get_natural_endpoints_without_node_being_replaced(const token& search_token) const {
@@ -303,9 +302,11 @@ abstract_replication_strategy::get_pending_address_ranges(const token_metadata_p
 
 future<mutable_effective_replication_map_ptr> calculate_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr) {
     replication_map replication_map;
+    replication_map.reserve(tmptr->sorted_tokens().size());
 
     for (const auto &t : tmptr->sorted_tokens()) {
-        replication_map.emplace(t, co_await rs->calculate_natural_endpoints(t, *tmptr));
+        replication_map.push_back(co_await rs->calculate_natural_endpoints(t, *tmptr));
+        co_await coroutine::maybe_yield();
     }
 
     auto rf = rs->get_replication_factor(*tmptr);
@@ -314,9 +315,10 @@ future<mutable_effective_replication_map_ptr> calculate_effective_replication_ma
 
 future<replication_map> effective_replication_map::clone_endpoints_gently() const {
     replication_map cloned_endpoints;
+    cloned_endpoints.reserve(_replication_map.size());
 
-    for (auto& i : _replication_map) {
-        cloned_endpoints.emplace(i.first, i.second);
+    for (auto& endpoints : _replication_map) {
+        cloned_endpoints.push_back(endpoints);
         co_await coroutine::maybe_yield();
     }
 
@@ -353,6 +355,20 @@ effective_replication_map::factory_key effective_replication_map::make_factory_k
     return factory_key(rs->get_type(), rs->get_config_options(), tmptr->get_ring_version());
 }
 
+effective_replication_map_factory::effective_replication_map_factory() {
+    namespace sm = seastar::metrics;
+    _metrics.add_group("replication_map", {
+        sm::make_gauge("maps", [this] { return _effective_replication_maps.size(); },
+                sm::description("Number of effective replication maps in use. Keyspaces with the same replication options share a map.")),
+        sm::make_counter("calculated_maps", _stats.calculated_maps,
+                sm::description("Counts replication maps calculated from the token ring, on ring changes or replication option changes.")),
+        sm::make_counter("cloned_maps", _stats.cloned_maps,
+                sm::description("Counts replication maps copied from the map calculated on shard 0.")),
+        sm::make_counter("build_time_us", [this] { return _stats.build_time.count(); },
+                sm::description("Total time, in microseconds, spent calculating and cloning replication maps, including time spent yielding.")),
+    });
+}
+
 future<effective_replication_map_ptr> effective_replication_map_factory::create_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr) {
     // lookup key on local shard
     auto key = effective_replication_map::make_factory_key(rs, tmptr);
@@ -371,13 +387,17 @@ future<effective_replication_map_ptr> effective_replication_map_factory::create_
         co_return make_foreign<effective_replication_map_ptr>(std::move(erm));
     });
     mutable_effective_replication_map_ptr new_erm;
+    auto start = std::chrono::steady_clock::now();
     if (ref_erm) {
         auto rf = ref_erm->get_replication_factor();
         auto local_replication_map = co_await ref_erm->clone_endpoints_gently();
         new_erm = make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(local_replication_map), rf);
+        ++_stats.cloned_maps;
     } else {
         new_erm = co_await calculate_effective_replication_map(std::move(rs), std::move(tmptr));
+        ++_stats.calculated_maps;
     }
+    _stats.build_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
     co_return insert_effective_replication_map(std::move(new_erm), std::move(key));
 }
 
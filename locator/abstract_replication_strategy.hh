@@ -17,6 +17,7 @@
 #include "token_metadata.hh"
 #include "snitch_base.hh"
 #include <seastar/util/bool_class.hh>
+#include <seastar/core/metrics_registration.hh>
 #include "utils/maybe_yield.hh"
 
 // forward declaration since replica/database.hh includes this file
@@ -42,7 +43,10 @@ using can_yield = utils::can_yield;
 
 using replication_strategy_config_options = std::map<sstring, sstring>;
 
-using replication_map = std::unordered_map<token, inet_address_vector_replica_set>;
+// The natural endpoints of each token of the ring, in the order of
+// token_metadata::sorted_tokens(), so that the replicas of a token are
+// found by the index of the token in the ring, without hashing.
+using replication_map = std::vector<inet_address_vector_replica_set>;
 
 class effective_replication_map;
 class effective_replication_map_factory;
@@ -315,7 +319,17 @@ class effective_replication_map_factory : public peering_sharded_service<effecti
     future<> _background_work = make_ready_future<>();
     bool _stopped = false;
 
+    struct stats {
+        uint64_t calculated_maps = 0;
+        uint64_t cloned_maps = 0;
+        // Time spent calculating or cloning replication maps.
+        std::chrono::microseconds build_time{0};
+    } _stats;
+    seastar::metrics::metric_groups _metrics;
+
 public:
+    effective_replication_map_factory();
+
     // looks up the effective_replication_map on the local shard.
     // If not found, tries to look one up for reference on shard 0
     // so its replication map can be cloned.  Otherwise, calculates the
@@ -35,6 +35,8 @@
 #include "db/commitlog/commitlog_replayer.hh"
 #include "db/view/view_builder.hh"
 #include "utils/runtime.hh"
+#include "utils/hardware_counters.hh"
+#include "utils/dma_buffer_pool.hh"
 #include "log.hh"
 #include "utils/directories.hh"
 #include "debug.hh"
@@ -61,6 +63,7 @@
 
 #include "db/view/view_update_generator.hh"
 #include "service/cache_hitrate_calculator.hh"
+#include "db/row_cache_saver.hh"
 #include "compaction/compaction_manager.hh"
 #include "sstables/sstables.hh"
 #include "gms/feature_service.hh"
@@ -70,6 +73,7 @@
 #include "transport/controller.hh"
 #include "thrift/controller.hh"
 #include "service/memory_limiter.hh"
+#include "service/priority_manager.hh"
 #include "service/endpoint_lifecycle_subscriber.hh"
 #include "db/schema_tables.hh"
 
@@ -80,6 +84,7 @@
 #include "tombstone_gc_extension.hh"
 #include "alternator/tags_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/write_coalescing_extension.hh"
 #include "service/qos/standard_service_level_distributed_data_accessor.hh"
 #include "service/storage_proxy.hh"
 #include "service/forward_service.hh"
@@ -454,6 +459,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
     ext->add_schema_extension<cdc::cdc_extension>(cdc::cdc_extension::NAME);
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
     ext->add_schema_extension<tombstone_gc_extension>(tombstone_gc_extension::NAME);
+    ext->add_schema_extension<db::write_coalescing_extension>(db::write_coalescing_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -638,6 +644,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 st_cfg.abort_on_lsa_bad_alloc = cfg->abort_on_lsa_bad_alloc();
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
+                st_cfg.background_reclaim_free_memory = cfg->lsa_background_reclaim_free_memory();
+                st_cfg.transparent_huge_pages = cfg->lsa_transparent_huge_pages();
                 st_cfg.sanitizer_report_backtrace = cfg->sanitizer_report_backtrace();
                 logalloc::shard_tracker().configure(st_cfg);
             }).get();
@@ -693,6 +701,16 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 }).get();
             }
 
+            sharded<utils::hardware_counters> hardware_counters;
+            std::any stop_hardware_counters;
+            if (cfg->enable_hardware_counters()) {
+                supervisor::notify("starting hardware counters");
+                hardware_counters.start().get();
+                stop_hardware_counters = defer_verbose_shutdown("hardware counters", [&hardware_counters] {
+                    hardware_counters.stop().get();
+                });
+            }
+
             using namespace locator;
             // Re-apply strict-dma after we've read the config file, this time
             // to all reactors
@@ -768,6 +786,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             dbcfg.memory_compaction_scheduling_group = make_sched_group("mem_compaction", 1000);
             dbcfg.streaming_scheduling_group = maintenance_scheduling_group;
             dbcfg.statement_scheduling_group = make_sched_group("statement", 1000);
+            dbcfg.batch_statement_scheduling_group = cfg->cpu_scheduler()
+                    ? make_sched_group("statement_batch", cfg->batch_workload_cpu_shares())
+                    : dbcfg.statement_scheduling_group;
             dbcfg.memtable_scheduling_group = make_sched_group("memtable", 1000);
             dbcfg.memtable_to_cache_scheduling_group = make_sched_group("memtable_to_cache", 200);
             dbcfg.gossip_scheduling_group = make_sched_group("gossip", 1000);
@@ -798,6 +819,13 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            auto zstd_level = cfg->internode_compression_zstd_level();
+            if (zstd_level < 0 || zstd_level > 19) {
+                startlog.error("Bad configuration: internode_compression_zstd_level must be between 0 and 19, got {}", zstd_level);
+                throw bad_configuration_error();
+            }
+            mscfg.cross_dc_zstd_level = zstd_level;
+            mscfg.shard_aware_connections = cfg->internode_shard_aware_connections();
 
             if (!cfg->inter_dc_tcp_nodelay()) {
                 mscfg.tcp_nodelay = netw::messaging_service::tcp_nodelay_what::local;
@@ -820,6 +848,13 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
 
             netw::messaging_service::scheduling_config scfg;
             scfg.statement_tenants = { {dbcfg.statement_scheduling_group, "$user"}, {default_scheduling_group(), "$system"} };
+            if (dbcfg.batch_statement_scheduling_group != dbcfg.statement_scheduling_group) {
+                // Carries the group of batch workloads to the replicas, whose reads select their I/O class by it.
+                scfg.statement_tenants.push_back({dbcfg.batch_statement_scheduling_group, "$batch"});
+                smp::invoke_on_all([&cfg, sg = dbcfg.batch_statement_scheduling_group] {
+                    return service::get_local_priority_manager().set_batch_query_group(sg, cfg->batch_workload_io_shares());
+                }).get();
+            }
             scfg.streaming = dbcfg.streaming_scheduling_group;
             scfg.gossip = dbcfg.gossip_scheduling_group;
 
@@ -923,6 +958,10 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             }
             view_hints_dir_initializer.ensure_created_and_verified().get();
 
+            smp::invoke_on_all([&cfg] {
+                utils::local_dma_buffer_pool().init(cfg->dma_buffer_pool_memory_fraction() * memory::stats().total_memory());
+            }).get();
+
             supervisor::notify("starting database");
             debug::the_database = &db;
             db.start(std::ref(*cfg), dbcfg, std::ref(mm_notifier), std::ref(feature_service), std::ref(token_metadata),
@@ -991,7 +1030,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 mm.stop().get();
             });
             supervisor::notify("starting query processor");
-            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
+            cql3::query_processor::memory_config qp_mcfg = {memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560, memory::stats().total_memory() / 256, memory::stats().total_memory() / 2560};
             debug::the_query_processor = &qp;
             auto local_data_dict = seastar::sharded_parameter([] (const replica::database& db) { return db.as_data_dictionary(); }, std::ref(db));
             qp.start(std::ref(proxy), std::ref(forward_service), std::move(local_data_dict), std::ref(mm_notifier), std::ref(mm), qp_mcfg, std::ref(cql_config)).get();
@@ -1089,6 +1128,23 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     cf.trigger_compaction();
                 }
             }).get();
+
+            // Warm the row cache up from the keys saved before the restart while the node joins.
+            supervisor::notify("starting row cache saver");
+            static sharded<db::row_cache_saver> row_cache_saver;
+            row_cache_saver.start(std::ref(db), sharded_parameter([&] {
+                return db::row_cache_saver::config{
+                    .directory = std::filesystem::path(cfg->saved_caches_directory()),
+                    .save_period = cfg->row_cache_save_period,
+                    .keys_to_save = cfg->row_cache_keys_to_save,
+                    .preload_keys_per_second = cfg->row_cache_preload_keys_per_second,
+                    .sched_group = maintenance_scheduling_group,
+                };
+            })).get();
+            auto stop_row_cache_saver = defer_verbose_shutdown("row cache saver", [] {
+                row_cache_saver.stop().get();
+            });
+            row_cache_saver.invoke_on_all(&db::row_cache_saver::start).get();
             api::set_server_gossip(ctx, gossiper).get();
             api::set_server_snitch(ctx).get();
             api::set_server_storage_proxy(ctx, ss).get();
@@ -84,6 +84,8 @@
 #include <seastar/rpc/lz4_compressor.hh>
 #include <seastar/rpc/lz4_fragmented_compressor.hh>
 #include <seastar/rpc/multi_algo_compressor_factory.hh>
+#include <seastar/core/byteorder.hh>
+#include <zstd.h>
 #include "partition_range_compat.hh"
 #include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/indirected.hpp>
@@ -92,6 +94,8 @@
 #include "streaming/stream_manager.hh"
 #include "streaming/stream_mutation_fragments_cmd.hh"
 #include "locator/snitch_base.hh"
+#include "utils/hash.hh"
+#include <random>
 #include "idl/partition_checksum.dist.impl.hh"
 #include "idl/forward_request.dist.hh"
 #include "idl/forward_request.dist.impl.hh"
@@ -118,6 +122,120 @@ static rpc::multi_algo_compressor_factory compressor_factory {
     &lz4_compressor_factory,
 };
 
+// Compresses each frame with zstd. A frame is the size of the uncompressed
+// data, as a little-endian 32-bit integer, followed by a single zstd frame.
+// Fragmented buffers are streamed through the contexts without linearizing
+// them first.
+class zstd_rpc_compressor final : public rpc::compressor {
+    ZSTD_CCtx* _cctx;
+    ZSTD_DCtx* _dctx;
+
+    static void check(size_t ret, const char* what) {
+        if (ZSTD_isError(ret)) {
+            throw std::runtime_error(format("ZSTD {} failure: {}", what, ZSTD_getErrorName(ret)));
+        }
+    }
+
+    template <typename Buffer, typename Func>
+    static void for_each_fragment(const Buffer& buf, Func&& func) {
+        if (auto* single = std::get_if<temporary_buffer<char>>(&buf.bufs)) {
+            func(std::string_view(single->get(), single->size()));
+        } else {
+            for (auto& frag : std::get<std::vector<temporary_buffer<char>>>(buf.bufs)) {
+                func(std::string_view(frag.get(), frag.size()));
+            }
+        }
+    }
+public:
+    explicit zstd_rpc_compressor(int level)
+        : _cctx(ZSTD_createCCtx())
+        , _dctx(ZSTD_createDCtx())
+    {
+        if (!_cctx || !_dctx) {
+            ZSTD_freeCCtx(_cctx);
+            ZSTD_freeDCtx(_dctx);
+            throw std::runtime_error("Unable to initialize ZSTD contexts for RPC");
+        }
+        check(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, level), "compression");
+    }
+    ~zstd_rpc_compressor() {
+        ZSTD_freeCCtx(_cctx);
+        ZSTD_freeDCtx(_dctx);
+    }
+
+    rpc::snd_buf compress(size_t head_space, rpc::snd_buf data) override {
+        const auto bound = ZSTD_compressBound(data.size);
+        temporary_buffer<char> dst(head_space + 4 + bound);
+        write_le<uint32_t>(dst.get_write() + head_space, data.size);
+        ZSTD_outBuffer out{dst.get_write() + head_space + 4, bound, 0};
+        check(ZSTD_CCtx_reset(_cctx, ZSTD_reset_session_only), "compression");
+        for_each_fragment(data, [&] (std::string_view frag) {
+            ZSTD_inBuffer in{frag.data(), frag.size(), 0};
+            while (in.pos < in.size) {
+                check(ZSTD_compressStream2(_cctx, &out, &in, ZSTD_e_continue), "compression");
+            }
+        });
+        ZSTD_inBuffer end{nullptr, 0, 0};
+        size_t remaining;
+        do {
+            remaining = ZSTD_compressStream2(_cctx, &out, &end, ZSTD_e_end);
+            check(remaining, "compression");
+        } while (remaining);
+        dst.trim(head_space + 4 + out.pos);
+        return rpc::snd_buf(std::move(dst));
+    }
+
+    rpc::rcv_buf decompress(rpc::rcv_buf data) override {
+        if (data.size < 4) {
+            return rpc::rcv_buf();
+        }
+        char header[4];
+        size_t header_pos = 0;
+        temporary_buffer<char> dst;
+        ZSTD_outBuffer out{nullptr, 0, 0};
+        check(ZSTD_DCtx_reset(_dctx, ZSTD_reset_session_only), "decompression");
+        for_each_fragment(data, [&] (std::string_view frag) {
+            if (header_pos < sizeof(header)) {
+                auto n = std::min(sizeof(header) - header_pos, frag.size());
+                std::copy_n(frag.data(), n, header + header_pos);
+                header_pos += n;
+                frag.remove_prefix(n);
+                if (header_pos < sizeof(header)) {
+                    return;
+                }
+                dst = temporary_buffer<char>(read_le<uint32_t>(header));
+                out = ZSTD_outBuffer{dst.get_write(), dst.size(), 0};
+            }
+            ZSTD_inBuffer in{frag.data(), frag.size(), 0};
+            while (in.pos < in.size) {
+                check(ZSTD_decompressStream(_dctx, &out, &in), "decompression");
+            }
+        });
+        if (out.pos != dst.size()) {
+            throw std::runtime_error(format("ZSTD decompression failure: expected {} bytes, got {}", dst.size(), out.pos));
+        }
+        return rpc::rcv_buf(std::move(dst));
+    }
+
+    sstring name() const override {
+        return factory::name;
+    }
+
+    class factory final : public rpc::compressor::factory {
+        int _level;
+    public:
+        static inline const sstring name = "ZSTD";
+
+        explicit factory(int level) : _level(level) {}
+        const sstring& supported() const override {
+            return name;
+        }
+        std::unique_ptr<rpc::compressor> negotiate(sstring feature, bool is_server) const override {
+            return feature == name ? std::make_unique<zstd_rpc_compressor>(_level) : nullptr;
+        }
+    };
+};
+
 struct messaging_service::rpc_protocol_server_wrapper : public rpc_protocol::server { using rpc_protocol::server::server; };
 
 constexpr int32_t messaging_service::current_version;
@@ -150,6 +268,10 @@ size_t msg_addr::hash::operator()(const msg_addr& id) const noexcept {
     return std::hash<bytes_view>()(id.addr.bytes());
 }
 
+size_t msg_addr::shard_hash::operator()(const msg_addr& id) const noexcept {
+    return utils::hash_combine(std::hash<bytes_view>()(id.addr.bytes()), id.cpu_id);
+}
+
 messaging_service::shard_info::shard_info(shared_ptr<rpc_protocol_client_wrapper>&& client)
     : rpc_client(std::move(client)) {
 }
@@ -163,6 +285,9 @@ void messaging_service::foreach_client(std::function<void(const msg_addr& id, co
         for (auto i = _clients[idx].cbegin(); i != _clients[idx].cend(); i++) {
             f(i->first, i->second);
         }
+        for (auto i = _shard_clients[idx].cbegin(); i != _shard_clients[idx].cend(); i++) {
+            f(i->first, i->second);
+        }
     }
 }
 
@@ -237,7 +362,9 @@ void messaging_service::do_start_listen() {
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != utils::fb_utilities::get_broadcast_address();
     rpc::server_options so;
     if (_cfg.compress != compress_what::none) {
-        so.compressor_factory = &compressor_factory;
+        // The server accepts zstd whatever this node's level, since the
+        // algorithm is the first one the client offers that both support.
+        so.compressor_factory = _zstd_or_lz4_compressor_factory.get();
     }
     so.load_balancing_algorithm = server_socket::load_balancing_algorithm::port;
 
@@ -327,9 +454,18 @@ void messaging_service::do_start_listen() {
 
 messaging_service::messaging_service(config cfg, scheduling_config scfg, std::shared_ptr<seastar::tls::credentials_builder> credentials)
     : _cfg(std::move(cfg))
+    // Responses on connections which negotiated zstd are compressed with
+    // this node's level, or the fastest one if zstd isn't enabled here.
+    , _zstd_compressor_factory(std::make_unique<zstd_rpc_compressor::factory>(std::max(_cfg.cross_dc_zstd_level, 1)))
+    , _zstd_or_lz4_compressor_factory(std::make_unique<rpc::multi_algo_compressor_factory>(std::vector<const rpc::compressor::factory*>{
+            _zstd_compressor_factory.get(),
+            &lz4_fragmented_compressor_factory,
+            &lz4_compressor_factory,
+        }))
     , _rpc(new rpc_protocol_wrapper(serializer { }))
     , _credentials_builder(credentials ? std::make_unique<seastar::tls::credentials_builder>(*credentials) : nullptr)
     , _clients(PER_SHARD_CONNECTION_COUNT + scfg.statement_tenants.size() * PER_TENANT_CONNECTION_COUNT)
+    , _shard_clients(_clients.size())
     , _scheduling_config(scfg)
     , _scheduling_info_for_connection_index(initial_scheduling_info())
 {
@@ -389,14 +525,17 @@ future<> messaging_service::stop_nontls_server() {
 }
 
 future<> messaging_service::stop_client() {
-    return parallel_for_each(_clients, [] (auto& m) {
-        return parallel_for_each(m, [] (std::pair<const msg_addr, shard_info>& c) {
-            mlogger.info("Stopping client for address: {}", c.first);
-            return c.second.rpc_client->stop().then([addr = c.first] {
-                mlogger.info("Stopping client for address: {} - Done", addr);
+    auto stop_clients = [] (auto& clients) {
+        return parallel_for_each(clients, [] (auto& m) {
+            return parallel_for_each(m, [] (std::pair<const msg_addr, shard_info>& c) {
+                mlogger.info("Stopping client for address: {}", c.first);
+                return c.second.rpc_client->stop().then([addr = c.first] {
+                    mlogger.info("Stopping client for address: {} - Done", addr);
+                });
             });
         });
-    });
+    };
+    return when_all_succeed(stop_clients(_clients), stop_clients(_shard_clients)).discard_result();
 }
 
 future<> messaging_service::shutdown() {
@@ -641,23 +780,49 @@ gms::inet_address messaging_service::get_public_endpoint_for(const gms::inet_add
     return i != _preferred_to_endpoint.end() ? i->second : ip;
 }
 
+// A local port from which a connection is accepted by the given shard of a
+// peer, whose servers balance connections by the remote port.
+static uint16_t shard_aware_local_port(unsigned shard, unsigned shard_count) {
+    // The default range of ephemeral ports on Linux.
+    static constexpr unsigned first_port = 32768;
+    static constexpr unsigned last_port = 60999;
+    static thread_local std::default_random_engine rng{std::random_device{}()};
+    auto port = std::uniform_int_distribution<unsigned>(first_port, last_port - shard_count)(rng);
+    return port + (shard + shard_count - port % shard_count) % shard_count;
+}
+
 shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::get_rpc_client(messaging_verb verb, msg_addr id) {
     assert(!_shutting_down);
     auto idx = get_rpc_client_idx(verb);
-    auto it = _clients[idx].find(id);
-
-    if (it != _clients[idx].end()) {
-        auto c = it->second.rpc_client;
-        if (!c->error()) {
-            return c;
+    const bool to_shard = _cfg.shard_aware_connections && id.shard_count && id.cpu_id < id.shard_count;
+
+    if (to_shard) {
+        auto it = _shard_clients[idx].find(id);
+        if (it != _shard_clients[idx].end()) {
+            auto c = it->second.rpc_client;
+            if (!c->error()) {
+                return c;
+            }
+            // Could have failed to bind its local port, so don't report the
+            // peer's connection as dropped.
+            remove_rpc_client_one(_shard_clients[idx], id, true);
+        }
+    } else {
+        auto it = _clients[idx].find(id);
+        if (it != _clients[idx].end()) {
+            auto c = it->second.rpc_client;
+            if (!c->error()) {
+                return c;
+            }
+            remove_error_rpc_client(verb, id);
         }
-        remove_error_rpc_client(verb, id);
     }
 
     auto addr = get_preferred_ip(id.addr);
     auto broadcast_address = utils::fb_utilities::get_broadcast_address();
     bool listen_to_bc = _cfg.listen_on_broadcast_address && _cfg.ip != broadcast_address;
-    auto laddr = socket_address(listen_to_bc ? broadcast_address : _cfg.ip, 0);
+    auto laddr = socket_address(listen_to_bc ? broadcast_address : _cfg.ip,
+            to_shard ? shard_aware_local_port(id.cpu_id, id.shard_count) : 0);
 
     auto must_encrypt = [&] {
         if (_cfg.encrypt == encrypt_what::none) {
@@ -700,15 +865,19 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
         return broadcast_address != laddr && snitch_ptr->get_rack(laddr) != my_rack;
     }();
 
-    auto must_compress = [&id, this] {
+    auto is_cross_dc = [&id] {
+        auto& snitch_ptr = locator::i_endpoint_snitch::get_local_snitch_ptr();
+        return snitch_ptr->get_datacenter(id.addr)
+                        != snitch_ptr->get_datacenter(utils::fb_utilities::get_broadcast_address());
+    };
+
+    auto must_compress = [&is_cross_dc, this] {
         if (_cfg.compress == compress_what::none) {
             return false;
         }
 
         if (_cfg.compress == compress_what::dc) {
-            auto& snitch_ptr = locator::i_endpoint_snitch::get_local_snitch_ptr();
-            return snitch_ptr->get_datacenter(id.addr)
-                            != snitch_ptr->get_datacenter(utils::fb_utilities::get_broadcast_address());
+            return is_cross_dc();
         }
 
         return true;
@@ -732,7 +901,10 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
     // send keepalive messages each minute if connection is idle, drop connection after 10 failures
     opts.keepalive = std::optional<net::tcp_keepalive_params>({60s, 60s, 10});
     if (must_compress) {
-        opts.compressor_factory = &compressor_factory;
+        // zstd is only offered to other DCs, where bandwidth costs more than
+        // the CPU it takes. Peers which don't know it pick LZ4.
+        opts.compressor_factory = _cfg.cross_dc_zstd_level && is_cross_dc()
+                ? _zstd_or_lz4_compressor_factory.get() : &compressor_factory;
     }
     opts.tcp_nodelay = must_tcp_nodelay;
     opts.reuseaddr = true;
@@ -747,19 +919,19 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
                     ::make_shared<rpc_protocol_client_wrapper>(_rpc->protocol(), std::move(opts),
                                     remote_addr, laddr);
 
-    auto res = _clients[idx].emplace(id, shard_info(std::move(client)));
-    assert(res.second);
-    it = res.first;
+    auto& info = to_shard ? _shard_clients[idx].emplace(id, shard_info(std::move(client))).first->second
+                          : _clients[idx].emplace(id, shard_info(std::move(client))).first->second;
     uint32_t src_cpu_id = this_shard_id();
     // No reply is received, nothing to wait for.
-    (void)_rpc->make_client<rpc::no_wait_type(gms::inet_address, uint32_t, uint64_t)>(messaging_verb::CLIENT_ID)(*it->second.rpc_client, utils::fb_utilities::get_broadcast_address(), src_cpu_id,
+    (void)_rpc->make_client<rpc::no_wait_type(gms::inet_address, uint32_t, uint64_t)>(messaging_verb::CLIENT_ID)(*info.rpc_client, utils::fb_utilities::get_broadcast_address(), src_cpu_id,
                                                                                                            query::result_memory_limiter::maximum_result_size).handle_exception([ms = shared_from_this(), remote_addr, verb] (std::exception_ptr ep) {
         mlogger.debug("Failed to send client id to {} for verb {}: {}", remote_addr, std::underlying_type_t<messaging_verb>(verb), ep);
     });
-    return it->second.rpc_client;
+    return info.rpc_client;
 }
 
-bool messaging_service::remove_rpc_client_one(clients_map& clients, msg_addr id, bool dead_only) {
+template <typename Clients>
+bool messaging_service::remove_rpc_client_one(Clients& clients, msg_addr id, bool dead_only) {
     if (_shutting_down) {
         // if messaging service is in a processed of been stopped no need to
         // stop and remove connection here since they are being stopped already
@@ -796,6 +968,14 @@ void messaging_service::remove_rpc_client(msg_addr id) {
     for (auto& c : _clients) {
         remove_rpc_client_one(c, id, false);
     }
+    for (auto& c : _shard_clients) {
+        for (auto it = c.begin(); it != c.end();) {
+            auto shard_id = (it++)->first;
+            if (shard_id.addr == id.addr) {
+                remove_rpc_client_one(c, shard_id, false);
+            }
+        }
+    }
 }
 
 std::unique_ptr<messaging_service::rpc_protocol_wrapper>& messaging_service::rpc() {
@@ -190,6 +190,7 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     using inet_address = gms::inet_address;
     using UUID = utils::UUID;
     using clients_map = std::unordered_map<msg_addr, shard_info, msg_addr::hash>;
+    using shard_clients_map = std::unordered_map<msg_addr, shard_info, msg_addr::shard_hash, msg_addr::shard_equal>;
 
     // This should change only if serialization format changes
     static constexpr int32_t current_version = 0;
@@ -239,6 +240,10 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
+        // When non-zero, compressed connections to other DCs offer zstd at this level.
+        int cross_dc_zstd_level = 0;
+        // Connect to the peer's shard a message is for, when its address names one.
+        bool shard_aware_connections = false;
     };
 
     struct scheduling_config {
@@ -268,6 +273,8 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     };
 private:
     config _cfg;
+    std::unique_ptr<rpc::compressor::factory> _zstd_compressor_factory;
+    std::unique_ptr<rpc::compressor::factory> _zstd_or_lz4_compressor_factory;
     // map: Node broadcast address -> Node internal IP, and the reversed mapping, for communication within the same data center
     std::unordered_map<gms::inet_address, gms::inet_address> _preferred_ip_cache, _preferred_to_endpoint;
     std::unique_ptr<rpc_protocol_wrapper> _rpc;
@@ -276,6 +283,8 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     std::unique_ptr<seastar::tls::credentials_builder> _credentials_builder;
     std::array<std::unique_ptr<rpc_protocol_server_wrapper>, 2> _server_tls;
     std::vector<clients_map> _clients;
+    // Connections to single shards of peers, by connection index like _clients.
+    std::vector<shard_clients_map> _shard_clients;
     uint64_t _dropped_messages[static_cast<int32_t>(messaging_verb::LAST)] = {};
     bool _shutting_down = false;
     connection_drop_signal_t _connection_dropped;
@@ -301,6 +310,7 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> stop();
     static rpc::no_wait_type no_wait();
     bool is_shutting_down() { return _shutting_down; }
+    bool shard_aware_connections() const noexcept { return _cfg.shard_aware_connections; }
     gms::inet_address get_preferred_ip(gms::inet_address ep);
     void init_local_preferred_ip_cache(const std::unordered_map<gms::inet_address, gms::inet_address>& ips_cache);
     void cache_preferred_ip(gms::inet_address ep, gms::inet_address ip);
@@ -477,7 +487,8 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
 
     void foreach_server_connection_stats(std::function<void(const rpc::client_info&, const rpc::stats&)>&& f) const;
 private:
-    bool remove_rpc_client_one(clients_map& clients, msg_addr id, bool dead_only);
+    template <typename Clients>
+    bool remove_rpc_client_one(Clients& clients, msg_addr id, bool dead_only);
     void do_start_listen();
 public:
     // Return rpc::protocol::client for a shard which is a ip + cpuid pair.
@@ -16,14 +16,28 @@ namespace netw {
 struct msg_addr {
     gms::inet_address addr;
     uint32_t cpu_id;
+    // When non-zero, the number of shards of the peer, and cpu_id is the
+    // peer's shard the message is for. With shard-aware connections enabled,
+    // such messages go over a connection to that shard.
+    uint32_t shard_count = 0;
     friend bool operator==(const msg_addr& x, const msg_addr& y) noexcept;
     friend bool operator<(const msg_addr& x, const msg_addr& y) noexcept;
     friend std::ostream& operator<<(std::ostream& os, const msg_addr& x);
     struct hash {
         size_t operator()(const msg_addr& id) const noexcept;
     };
+    // Tell apart the shards of a peer, unlike the operators above.
+    struct shard_hash {
+        size_t operator()(const msg_addr& id) const noexcept;
+    };
+    struct shard_equal {
+        bool operator()(const msg_addr& x, const msg_addr& y) const noexcept {
+            return x.addr == y.addr && x.cpu_id == y.cpu_id;
+        }
+    };
     explicit msg_addr(gms::inet_address ip) noexcept : addr(ip), cpu_id(0) { }
     msg_addr(gms::inet_address ip, uint32_t cpu) noexcept : addr(ip), cpu_id(cpu) { }
+    msg_addr(gms::inet_address ip, uint32_t cpu, uint32_t shards) noexcept : addr(ip), cpu_id(cpu), shard_count(shards) { }
 };
 
 }
@@ -553,6 +553,7 @@ future<> read_context::lookup_readers(db::timeout_clock::time_point timeout) {
             auto querier_opt = db.get_querier_cache().lookup_shard_mutation_querier(cmd->query_uuid, *schema, *ranges, cmd->slice, gts.get(), timeout);
             auto& table = db.find_column_family(schema);
             auto& semaphore = this->semaphore();
+            ++(querier_opt ? table.get_stats().querier_cache_hits : table.get_stats().querier_cache_misses);
 
             if (!querier_opt) {
                 return reader_meta(reader_state::inexistent);
@@ -16,6 +16,15 @@
 class mutation_cleaner;
 
 class mutation_cleaner_impl final {
+public:
+    struct stats {
+        // Snapshots whose versions were merged, either when released or in the background.
+        uint64_t merges = 0;
+        // Preemptible steps of merging, a merge takes one or more.
+        uint64_t merge_steps = 0;
+        std::chrono::microseconds merge_time{0};
+    };
+private:
     using snapshot_list = boost::intrusive::slist<partition_snapshot,
         boost::intrusive::member_hook<partition_snapshot, boost::intrusive::slist_member_hook<>, &partition_snapshot::_cleaner_hook>>;
     struct worker {
@@ -32,6 +41,7 @@ class mutation_cleaner_impl final {
     lw_shared_ptr<worker> _worker_state;
     mutation_application_stats& _app_stats;
     seastar::scheduling_group _scheduling_group;
+    stats _stats;
 private:
     stop_iteration merge_some(partition_snapshot& snp) noexcept;
     stop_iteration merge_some() noexcept;
@@ -62,6 +72,8 @@ class mutation_cleaner_impl final {
         _scheduling_group = sg;
         _worker_state->cv.broadcast();
     }
+    const stats& get_stats() const noexcept { return _stats; }
+    size_t pending_merges() const noexcept { return _worker_state->snapshots.size(); }
 };
 
 inline
@@ -115,6 +127,15 @@ class mutation_cleaner final {
         _impl->set_scheduling_group(sg);
     }
 
+    const mutation_cleaner_impl::stats& get_stats() const noexcept {
+        return _impl->get_stats();
+    }
+
+    // The number of released snapshots whose versions wait to be merged in the background.
+    size_t pending_merges() const noexcept {
+        return _impl->pending_merges();
+    }
+
     // Frees some of the data. Returns stop_iteration::yes iff all was freed.
     // Must be invoked under owning allocator.
     stop_iteration clear_gently() noexcept {
@@ -12,6 +12,8 @@
 
 enum class mutation_fragment_stream_validation_level {
     partition_region, // fragment kind
+    // Fragment kind and token. Compares no keys and allocates nothing per
+    // fragment, so it is cheap enough to be always on.
     token,
     partition_key,
     clustering_key,
@@ -140,9 +140,29 @@ class mutation_fragment_v2 {
             partition_end _partition_end;
         };
     };
+    // The storage of data is recycled by the permit, see reader_permit::allocate_fragment().
+    struct data_deleter {
+        void operator()(data* d) const noexcept {
+            // Keeps the permit alive until the storage is returned to it.
+            auto permit = d->_memory.permit();
+            d->~data();
+            permit.free_fragment(d, sizeof(data));
+        }
+    };
+    using data_ptr = std::unique_ptr<data, data_deleter>;
+
+    static data_ptr make_data(reader_permit permit) {
+        void* p = permit.allocate_fragment(sizeof(data));
+        try {
+            return data_ptr(new (p) data(permit));
+        } catch (...) {
+            permit.free_fragment(p, sizeof(data));
+            throw;
+        }
+    }
 private:
     kind _kind;
-    std::unique_ptr<data> _data;
+    data_ptr _data;
 
     mutation_fragment_v2() = default;
     explicit operator bool() const noexcept { return bool(_data); }
@@ -156,7 +176,7 @@ class mutation_fragment_v2 {
     template<typename... Args>
     mutation_fragment_v2(clustering_row_tag_t, const schema& s, reader_permit permit, Args&&... args)
         : _kind(kind::clustering_row)
-        , _data(std::make_unique<data>(std::move(permit)))
+        , _data(make_data(std::move(permit)))
     {
         new (&_data->_clustering_row) clustering_row(std::forward<Args>(args)...);
         _data->_memory.reset(reader_resources::with_memory(calculate_memory_usage(s)));
@@ -169,7 +189,7 @@ class mutation_fragment_v2 {
     mutation_fragment_v2(const schema& s, reader_permit permit, partition_end&& r);
 
     mutation_fragment_v2(const schema& s, reader_permit permit, const mutation_fragment_v2& o)
-        : _kind(o._kind), _data(std::make_unique<data>(std::move(permit))) {
+        : _kind(o._kind), _data(make_data(std::move(permit))) {
         switch (_kind) {
             case kind::static_row:
                 new (&_data->_static_row) static_row(s, o._data->_static_row);
@@ -23,6 +23,7 @@
 #include "view_info.hh"
 #include "mutation_cleaner.hh"
 #include <seastar/core/execution_stage.hh>
+#include <seastar/util/defer.hh>
 #include "types/map.hh"
 #include "compaction/compaction_garbage_collector.hh"
 #include "utils/exceptions.hh"
@@ -1456,6 +1457,10 @@ rows_entry::rows_entry(rows_entry&& o) noexcept
 
 void rows_entry::replace_with(rows_entry&& o) noexcept {
     swap(o);
+    // The LRU segment goes with the link.
+    bool probationary = _flags._probationary;
+    _flags._probationary = o._flags._probationary;
+    o._flags._probationary = probationary;
     _row = std::move(o._row);
 }
 
@@ -1878,6 +1883,12 @@ stop_iteration mutation_querier::consume(clustering_row&& cr, row_tombstone curr
         _pw.last_modified() = max_ts.max;
     }
 
+    if (slice.options.contains(query::partition_slice::option::count_only)) {
+        _last_row_key = std::move(cr.key());
+        _live_clustering_rows++;
+        return stop_iteration::no;
+    }
+
     auto write_row = [&] (auto& rows_writer) {
         auto cells_wr = [&] {
             if (slice.options.contains(query::partition_slice::option::send_clustering_key)) {
@@ -1910,6 +1921,23 @@ stop_iteration mutation_querier::consume(clustering_row&& cr, row_tombstone curr
 uint64_t mutation_querier::consume_end_of_stream() {
     prepare_writers();
 
+    // Only the last of the counted rows is sent, so that the coordinator
+    // knows where to resume paging. Its cells aren't needed.
+    if (_last_row_key && _pw.requested_result()) {
+        const query::partition_slice& slice = _pw.slice();
+        auto cells_wr = [&] {
+            if (slice.options.contains(query::partition_slice::option::send_clustering_key)) {
+                return _rows_wr->add().write_key(*_last_row_key).start_cells().start_cells();
+            } else {
+                return _rows_wr->add().skip_key().start_cells().start_cells();
+            }
+        }();
+        for (size_t i = 0; i < slice.regular_columns.size(); ++i) {
+            cells_wr.add().skip();
+        }
+        std::move(cells_wr).end_cells().end_cells().end_qr_clustered_row();
+    }
+
     // If we got no rows, but have live static columns, we should only
     // give them back IFF we did not have any CK restrictions.
     // #589
@@ -2400,10 +2428,17 @@ stop_iteration mutation_cleaner_impl::merge_some(partition_snapshot& snp) noexce
             if (!region.reclaiming_enabled()) {
                 return stop_iteration::no;
             }
+            auto start = std::chrono::steady_clock::now();
+            auto account = defer([&] () noexcept {
+                ++_stats.merge_steps;
+                _stats.merge_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            });
             try {
-                return _worker_state->alloc_section(region, [&] {
+                auto stop = _worker_state->alloc_section(region, [&] {
                     return snp.merge_partition_versions(_app_stats);
                 });
+                _stats.merges += bool(stop);
+                return stop;
             } catch (...) {
                 // Merging failed, give up as there is no guarantee of forward progress.
                 return stop_iteration::yes;
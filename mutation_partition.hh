@@ -895,7 +895,10 @@ class rows_entry final : public evictable {
         // Marks a dummy entry which is after_all_clustered_rows() position.
         // Needed so that eviction, which can't use comparators, can check if it's dealing with it.
         bool _last_dummy : 1;
-        flags() : _before_ck(0), _after_ck(0), _continuous(true), _dummy(false), _last_dummy(false) { }
+        // Whether the entry is in the probationary segment of the cache LRU.
+        // Maintained by cache_tracker.
+        bool _probationary : 1;
+        flags() : _before_ck(0), _after_ck(0), _continuous(true), _dummy(false), _last_dummy(false), _probationary(false) { }
     } _flags{};
 public:
     struct last_dummy_tag {};
@@ -954,6 +957,8 @@ class rows_entry final : public evictable {
     bool is_last_dummy() const { return _flags._last_dummy; }
     void set_dummy(bool value) { _flags._dummy = value; }
     void set_dummy(is_dummy value) { _flags._dummy = bool(value); }
+    bool is_probationary() const { return _flags._probationary; }
+    void set_probationary(bool value) { _flags._probationary = value; }
     void replace_with(rows_entry&& other) noexcept;
 
     void apply(row_tombstone t) {
@@ -1001,6 +1006,7 @@ class rows_entry final : public evictable {
     size_t memory_usage(const schema&) const;
     void on_evicted(cache_tracker&) noexcept;
     void on_evicted() noexcept override;
+    bool defer_eviction() noexcept override;
 
     class printer {
         const schema& _schema;
@@ -9,6 +9,7 @@
 #include <boost/range/algorithm/heap_algorithm.hpp>
 #include <boost/range/algorithm/reverse.hpp>
 #include <boost/move/iterator.hpp>
+#include <unordered_map>
 #include <variant>
 
 #include <seastar/core/future-util.hh>
@@ -22,6 +23,7 @@
 #include "mutation_compactor.hh"
 #include "dht/sharder.hh"
 #include "readers/empty_v2.hh"
+#include "utils/tournament_tree.hh"
 
 logging::logger mrlog("mutation_reader");
 
@@ -263,7 +265,18 @@ class mutation_reader_merger {
     static constexpr int gallop_mode_entering_threshold = 3;
 private:
     struct reader_heap_compare;
-    struct fragment_heap_compare;
+
+    struct fragment_tri_compare {
+        position_in_partition::tri_compare cmp;
+
+        explicit fragment_tri_compare(const schema& s)
+            : cmp(s) {
+        }
+
+        std::strong_ordering operator()(const reader_and_fragment& a, const reader_and_fragment& b) const {
+            return cmp(a.fragment.position(), b.fragment.position());
+        }
+    };
 
     struct needs_merge_tag { };
     using needs_merge = bool_class<needs_merge_tag>;
@@ -283,8 +296,10 @@ class mutation_reader_merger {
     // always partition_start. Used to pick the next partition.
     merger_vector<reader_and_fragment> _reader_heap;
     // Readers and their current fragments, belonging to the current
-    // partition.
-    merger_vector<reader_and_fragment> _fragment_heap;
+    // partition. A tournament tree rather than a heap, because the
+    // reader which won is usually put back right away, and replacing
+    // the minimum of a tournament tree takes half the comparisons.
+    utils::tournament_tree<reader_and_fragment, fragment_tri_compare> _fragment_tree;
     merger_vector<reader_and_last_fragment_kind> _next;
     // Readers that reached EOS.
     merger_vector<reader_and_last_fragment_kind> _halted_readers;
@@ -307,6 +322,11 @@ class mutation_reader_merger {
     const schema_ptr _schema;
     streamed_mutation::forwarding _fwd_sm;
     mutation_reader::forwarding _fwd_mr;
+    reader_permit _permit;
+    combined_reader_lookahead _lookahead;
+    // Background fill_buffer() of readers in _reader_heap. A reader with a
+    // lookahead in flight must not be used before it resolves.
+    std::unordered_map<const flat_mutation_reader_v2*, future<>> _lookahead_fills;
 private:
     void maybe_add_readers_at_partition_boundary();
     void maybe_add_readers(const std::optional<dht::ring_position_view>& pos);
@@ -316,13 +336,21 @@ class mutation_reader_merger {
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
     // Collect all forwardable readers into _next, and remove them from
-    // their previous containers (_halted_readers and _fragment_heap).
+    // their previous containers (_halted_readers and _fragment_tree).
     void prepare_forwardable_readers();
+    // Starts filling the buffers of the readers in _reader_heap which ran
+    // dry, as long as the permit's memory allows.
+    void maybe_lookahead();
+    // Returns the lookahead in flight of the reader, if any.
+    std::optional<future<>> take_lookahead(const flat_mutation_reader_v2& r);
+    future<> wait_for_lookaheads() noexcept;
 public:
     mutation_reader_merger(schema_ptr schema,
+            reader_permit permit,
             std::unique_ptr<reader_selector> selector,
             streamed_mutation::forwarding fwd_sm,
-            mutation_reader::forwarding fwd_mr);
+            mutation_reader::forwarding fwd_mr,
+            combined_reader_lookahead lookahead);
     // Produces the next batch of mutation-fragments of the same
     // position.
     future<mutation_fragment_batch> operator()();
@@ -413,19 +441,6 @@ struct mutation_reader_merger::reader_heap_compare {
     }
 };
 
-struct mutation_reader_merger::fragment_heap_compare {
-    position_in_partition::less_compare cmp;
-
-    explicit fragment_heap_compare(const schema& s)
-        : cmp(s) {
-    }
-
-    bool operator()(const mutation_reader_merger::reader_and_fragment& a, const mutation_reader_merger::reader_and_fragment& b) {
-        // Invert comparison as this is a max-heap.
-        return cmp(b.fragment.position(), a.fragment.position());
-    }
-};
-
 bool mutation_reader_merger::in_gallop_mode() const {
     return _gallop_mode_hits >= gallop_mode_entering_threshold;
 }
@@ -434,7 +449,7 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
     // waiting for a fast-forward so there is nothing to do.
-    if (_fragment_heap.empty() && _halted_readers.empty()) {
+    if (_fragment_tree.empty() && _halted_readers.empty()) {
         if (_reader_heap.empty()) {
             maybe_add_readers(std::nullopt);
         } else {
@@ -461,6 +476,11 @@ future<> mutation_reader_merger::prepare_next() {
 
 future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
         reader_and_last_fragment_kind rk, reader_galloping reader_galloping) {
+    if (auto f = take_lookahead(*rk.reader)) [[unlikely]] {
+        return std::move(*f).then([this, rk, reader_galloping] {
+            return prepare_one(rk, reader_galloping);
+        });
+    }
     return (*rk.reader)().then([this, rk, reader_galloping] (mutation_fragment_v2_opt mfo) {
         auto to_close = make_ready_future<>();
         if (mfo) {
@@ -470,8 +490,8 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
             } else {
                 if (reader_galloping) {
                     // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
+                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the tree.
+                    if (_fragment_tree.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_tree.top().fragment.position())) {
                         _current.clear();
                         _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
                         _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
@@ -481,8 +501,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
                     _gallop_mode_hits = 0;
                 }
 
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+                _fragment_tree.push(reader_and_fragment(rk.reader, std::move(*mfo)));
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
             // When in streamed_mutation::forwarding mode we need
@@ -520,7 +539,7 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
 }
 
 void mutation_reader_merger::prepare_forwardable_readers() {
-    _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size());
+    _next.reserve(_halted_readers.size() + _fragment_tree.size() + _next.size());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
     if (_single_reader.reader != reader_iterator{}) {
@@ -530,22 +549,65 @@ void mutation_reader_merger::prepare_forwardable_readers() {
         _next.emplace_back(_galloping_reader);
         _gallop_mode_hits = 0;
     }
-    for (auto& df : _fragment_heap) {
+    _fragment_tree.for_each([this] (reader_and_fragment& df) {
         _next.emplace_back(df.reader, df.fragment.mutation_fragment_kind());
-    }
+    });
 
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
+}
+
+void mutation_reader_merger::maybe_lookahead() {
+    const auto memory_limit = _permit.max_result_size().soft_limit;
+    for (auto& rf : _reader_heap) {
+        auto& r = *rf.reader;
+        if (!r.is_buffer_empty() || r.is_end_of_stream() || _lookahead_fills.contains(&r)) {
+            continue;
+        }
+        if (uint64_t(_permit.consumed_resources().memory) >= memory_limit) {
+            return;
+        }
+        _lookahead_fills.emplace(&r, r.fill_buffer());
+    }
+}
+
+std::optional<future<>> mutation_reader_merger::take_lookahead(const flat_mutation_reader_v2& r) {
+    if (_lookahead_fills.empty()) {
+        return std::nullopt;
+    }
+    auto it = _lookahead_fills.find(&r);
+    if (it == _lookahead_fills.end()) {
+        return std::nullopt;
+    }
+    auto f = std::move(it->second);
+    _lookahead_fills.erase(it);
+    return f;
+}
+
+future<> mutation_reader_merger::wait_for_lookaheads() noexcept {
+    auto fills = std::exchange(_lookahead_fills, {});
+    for (auto& [r, f] : fills) {
+        try {
+            co_await std::move(f);
+        } catch (...) {
+            mrlog.debug("Lookahead of combined reader failed: {}", std::current_exception());
+        }
+    }
 }
 
 mutation_reader_merger::mutation_reader_merger(schema_ptr schema,
+        reader_permit permit,
         std::unique_ptr<reader_selector> selector,
         streamed_mutation::forwarding fwd_sm,
-        mutation_reader::forwarding fwd_mr)
+        mutation_reader::forwarding fwd_mr,
+        combined_reader_lookahead lookahead)
     : _selector(std::move(selector))
+    , _fragment_tree(fragment_tri_compare(*schema))
     , _schema(std::move(schema))
     , _fwd_sm(fwd_sm)
-    , _fwd_mr(fwd_mr) {
+    , _fwd_mr(fwd_mr)
+    , _permit(std::move(permit))
+    , _lookahead(lookahead) {
     maybe_add_readers(std::nullopt);
 }
 
@@ -553,6 +615,9 @@ future<mutation_fragment_batch> mutation_reader_merger::operator()() {
     // Avoid merging-related logic if we know that only a single reader owns
     // current partition.
     if (_single_reader.reader != reader_iterator{}) {
+        if (auto f = take_lookahead(*_single_reader.reader)) [[unlikely]] {
+            return std::move(*f).then([this] { return operator()(); });
+        }
         if (_single_reader.reader->is_buffer_empty()) {
             if (_single_reader.reader->is_end_of_stream()) {
                 _current.clear();
@@ -588,42 +653,47 @@ future<mutation_fragment_batch> mutation_reader_merger::operator()() {
 
     // If we ran out of fragments for the current partition, select the
     // readers for the next one.
-    if (_fragment_heap.empty()) {
+    if (_fragment_tree.empty()) {
         if (!_halted_readers.empty() || _reader_heap.empty()) {
             return make_ready_future<mutation_fragment_batch>(_current);
         }
 
-        auto key = [] (const merger_vector<reader_and_fragment>& heap) -> const dht::decorated_key& {
-            return heap.front().fragment.as_partition_start().key();
-        };
+        if (_lookahead) {
+            maybe_lookahead();
+        }
 
+        boost::range::pop_heap(_reader_heap, reader_heap_compare(*_schema));
+        auto first = std::move(_reader_heap.back());
+        _reader_heap.pop_back();
+        const auto& key = first.fragment.as_partition_start().key();
+        if (_reader_heap.empty() || !key.equal(*_schema, _reader_heap.front().fragment.as_partition_start().key())) {
+            _single_reader = { first.reader, mutation_fragment_v2::kind::partition_start };
+            _current.emplace_back(std::move(first.fragment), &*_single_reader.reader);
+            _gallop_mode_hits = 0;
+            return make_ready_future<mutation_fragment_batch>(_current);
+        }
+        _fragment_tree.push(std::move(first));
         do {
             boost::range::pop_heap(_reader_heap, reader_heap_compare(*_schema));
-            // All fragments here are partition_start so no need to
-            // heap-sort them.
-            _fragment_heap.emplace_back(std::move(_reader_heap.back()));
+            _fragment_tree.push(std::move(_reader_heap.back()));
             _reader_heap.pop_back();
         }
-        while (!_reader_heap.empty() && key(_fragment_heap).equal(*_schema, key(_reader_heap)));
-        if (_fragment_heap.size() == 1) {
-            _single_reader = { _fragment_heap.back().reader, mutation_fragment_v2::kind::partition_start };
-            _current.emplace_back(std::move(_fragment_heap.back().fragment), &*_single_reader.reader);
-            _fragment_heap.clear();
-            _gallop_mode_hits = 0;
-            return make_ready_future<mutation_fragment_batch>(_current);
-        }
+        while (!_reader_heap.empty() && _fragment_tree.top().fragment.as_partition_start().key().equal(*_schema,
+                _reader_heap.front().fragment.as_partition_start().key()));
     }
 
-    const auto equal = position_in_partition::equal_compare(*_schema);
+    // The winner's leaf is left empty, so that the reader's next fragment
+    // takes it with a single replay, unless another fragment has the same
+    // position and has to be popped as well.
+    bool more;
     do {
-        boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
-        auto& n = _fragment_heap.back();
+        more = _fragment_tree.top_has_equal();
+        auto n = _fragment_tree.pop();
         const auto kind = n.fragment.mutation_fragment_kind();
         _current.emplace_back(std::move(n.fragment), &*n.reader);
         _next.emplace_back(n.reader, kind);
-        _fragment_heap.pop_back();
     }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
+    while (more);
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
@@ -646,7 +716,7 @@ future<> mutation_reader_merger::next_partition() {
     //
     // The readers in _next are those which returned the last batch of fragments, thus they are
     // currently positioned either inside P or at the end of P, hence we need to forward them.
-    // Readers in _fragment_heap (or the _galloping_reader, if we're currently galloping) are obviously still in P,
+    // Readers in _fragment_tree (or the _galloping_reader, if we're currently galloping) are obviously still in P,
     // so we also need to forward those. Finally, _halted_readers must have been halted after returning
     // a fragment from P, hence must be forwarded.
     //
@@ -655,42 +725,51 @@ future<> mutation_reader_merger::next_partition() {
     prepare_forwardable_readers();
     for (auto& rk : _next) {
         rk.last_kind = mutation_fragment_v2::kind::partition_end;
+        if (auto f = take_lookahead(*rk.reader)) {
+            co_await std::move(*f);
+        }
         co_await rk.reader->next_partition();
     }
 }
 
 future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr) {
+    // The buffers are dropped by the fast-forward anyway.
+    co_await wait_for_lookaheads();
     _single_reader = { };
     _gallop_mode_hits = 0;
     _next.clear();
     _halted_readers.clear();
-    _fragment_heap.clear();
+    _fragment_tree.clear();
     _reader_heap.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
         _next.emplace_back(it, mutation_fragment_v2::kind::partition_end);
     }
-    return parallel_for_each(_all_readers, [this, &pr] (flat_mutation_reader_v2& mr) {
+    co_await parallel_for_each(_all_readers, [this, &pr] (flat_mutation_reader_v2& mr) {
         return mr.fast_forward_to(pr);
-    }).then([this, &pr] {
-        add_readers(_selector->fast_forward_to(pr));
     });
+    add_readers(_selector->fast_forward_to(pr));
 }
 
 future<> mutation_reader_merger::fast_forward_to(position_range pr) {
     prepare_forwardable_readers();
     return parallel_for_each(_next, [this, pr = std::move(pr)] (reader_and_last_fragment_kind rk) {
+        if (auto f = take_lookahead(*rk.reader)) {
+            return std::move(*f).then([&r = *rk.reader, pr] () mutable {
+                return r.fast_forward_to(std::move(pr));
+            });
+        }
         return rk.reader->fast_forward_to(pr);
     });
 }
 
 future<> mutation_reader_merger::close() noexcept {
-    return parallel_for_each(std::move(_to_remove), [] (flat_mutation_reader_v2& mr) {
+    co_await wait_for_lookaheads();
+    co_await parallel_for_each(std::move(_to_remove), [] (flat_mutation_reader_v2& mr) {
+        return mr.close();
+    });
+    co_await parallel_for_each(std::move(_all_readers), [] (flat_mutation_reader_v2& mr) {
         return mr.close();
-    }).then([this] {
-        return parallel_for_each(std::move(_all_readers), [] (flat_mutation_reader_v2& mr) {
-            return mr.close();
-        });
     });
 }
 
@@ -755,11 +834,12 @@ flat_mutation_reader_v2 make_combined_reader(schema_ptr schema,
         reader_permit permit,
         std::unique_ptr<reader_selector> selector,
         streamed_mutation::forwarding fwd_sm,
-        mutation_reader::forwarding fwd_mr) {
+        mutation_reader::forwarding fwd_mr,
+        combined_reader_lookahead lookahead) {
     return make_flat_mutation_reader_v2<merging_reader<mutation_reader_merger>>(schema,
-            std::move(permit),
+            permit,
             fwd_sm,
-            mutation_reader_merger(schema, std::move(selector), fwd_sm, fwd_mr));
+            mutation_reader_merger(schema, permit, std::move(selector), fwd_sm, fwd_mr, lookahead));
 }
 
 flat_mutation_reader_v2 make_combined_reader(schema_ptr schema,
@@ -1040,6 +1120,7 @@ class evictable_reader_v2 : public flat_mutation_reader_v2::impl {
     const mutation_reader::forwarding _fwd_mr;
     reader_concurrency_semaphore::inactive_read_handle _irh;
     bool _reader_recreated = false; // set if reader was recreated since last operation
+    std::optional<size_t> _underlying_buffer_size;
     position_in_partition::tri_compare _tri_cmp;
 
     std::optional<dht::decorated_key> _last_pkey;
@@ -1101,6 +1182,12 @@ class evictable_reader_v2 : public flat_mutation_reader_v2::impl {
     reader_permit permit() {
         return _permit;
     }
+    // Set the buffer size of the underlying reader, which determines how
+    // much each fill_buffer() reads.
+    void set_underlying_buffer_size(size_t size) {
+        _underlying_buffer_size = size;
+        max_buffer_size_in_bytes = size;
+    }
 };
 
 void evictable_reader_v2::do_pause(flat_mutation_reader_v2 reader) {
@@ -1386,6 +1473,9 @@ future<> evictable_reader_v2::fill_buffer() {
         co_return;
     }
     _reader = co_await resume_or_create_reader();
+    if (_underlying_buffer_size) {
+        _reader->set_max_buffer_size(*_underlying_buffer_size);
+    }
 
     if (_reader_recreated) {
         // Recreating the reader breaks snapshot isolation and creates all sorts
@@ -1532,6 +1622,7 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
+    size_t _remote_buffer_size = default_max_buffer_size_in_bytes();
 
 private:
     future<> do_fill_buffer();
@@ -1578,6 +1669,11 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     bool is_read_ahead_in_progress() const {
         return _read_ahead.has_value();
     }
+    // The size of the buffer the reader on the remote shard fills, that
+    // is, how much each fill_buffer() brings over.
+    void set_remote_buffer_size(size_t size) {
+        _remote_buffer_size = size;
+    }
 };
 
 future<> shard_reader_v2::close() noexcept {
@@ -1626,7 +1722,7 @@ future<> shard_reader_v2::do_fill_buffer() {
     };
 
     if (!_reader) {
-        fill_buf_fut = smp::submit_to(_shard, [this, gs = global_schema_ptr(_schema)] () -> future<reader_and_buffer_fill_result> {
+        fill_buf_fut = smp::submit_to(_shard, [this, gs = global_schema_ptr(_schema), buffer_size = _remote_buffer_size] () -> future<reader_and_buffer_fill_result> {
             auto ms = mutation_source([lifecycle_policy = _lifecycle_policy.get()] (
                         schema_ptr s,
                         reader_permit permit,
@@ -1642,6 +1738,7 @@ future<> shard_reader_v2::do_fill_buffer() {
             auto permit = co_await _lifecycle_policy->obtain_reader_permit(s, "shard-reader", timeout());
             auto rreader = make_foreign(std::make_unique<evictable_reader_v2>(evictable_reader_v2::auto_pause::yes, std::move(ms),
                         s, std::move(permit), *_pr, _ps, _pc, _trace_state, _fwd_mr));
+            rreader->set_underlying_buffer_size(buffer_size);
 
             std::exception_ptr ex;
             try {
@@ -1660,8 +1757,9 @@ future<> shard_reader_v2::do_fill_buffer() {
             return std::move(res.result);
         });
     } else {
-        fill_buf_fut = smp::submit_to(_shard, [this] () mutable {
+        fill_buf_fut = smp::submit_to(_shard, [this, buffer_size = _remote_buffer_size] () mutable {
             reader_permit::used_guard ug{_reader->permit()};
+            _reader->set_underlying_buffer_size(buffer_size);
             return _reader->fill_buffer().then([this, ug = std::move(ug)] {
                 return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
             });
@@ -1768,10 +1866,19 @@ class multishard_combining_reader_v2 : public flat_mutation_reader_v2::impl {
     unsigned _current_shard;
     bool _crossed_shards;
     unsigned _concurrency = 1;
+    size_t _shard_buffer_size = default_max_buffer_size_in_bytes();
+    tracing::trace_state_ptr _trace_state;
+
+    static constexpr size_t max_shard_buffer_size = 16 * default_max_buffer_size_in_bytes();
 
     void on_partition_range_change(const dht::partition_range& pr);
     bool maybe_move_to_next_shard(const dht::token* const t = nullptr);
     future<> handle_empty_reader_buffer();
+    // The memory the shard readers may fill ahead of the consumer.
+    size_t read_ahead_memory_limit() const;
+    bool read_ahead_fits(unsigned concurrency, size_t shard_buffer_size) const;
+    void set_shard_buffer_size(size_t size);
+    void maybe_reduce_read_ahead();
 
 public:
     multishard_combining_reader_v2(
@@ -1834,9 +1941,47 @@ bool multishard_combining_reader_v2::maybe_move_to_next_shard(const dht::token*
 
     _crossed_shards = true;
     _current_shard = next_shard;
+    maybe_reduce_read_ahead();
     return true;
 }
 
+size_t multishard_combining_reader_v2::read_ahead_memory_limit() const {
+    // Reading more than a page ahead is wasted, the page will end before
+    // the consumer gets to it.
+    const auto shards = _sharder.shard_count();
+    return std::clamp<uint64_t>(_permit.max_result_size().get_page_size(), shards * default_max_buffer_size_in_bytes(), shards * max_shard_buffer_size);
+}
+
+bool multishard_combining_reader_v2::read_ahead_fits(unsigned concurrency, size_t shard_buffer_size) const {
+    return concurrency * shard_buffer_size <= read_ahead_memory_limit();
+}
+
+void multishard_combining_reader_v2::set_shard_buffer_size(size_t size) {
+    _shard_buffer_size = size;
+    for (auto& sr : _shard_readers) {
+        sr->set_remote_buffer_size(size);
+    }
+}
+
+void multishard_combining_reader_v2::maybe_reduce_read_ahead() {
+    if (_concurrency == 1 && _shard_buffer_size == default_max_buffer_size_in_bytes()) {
+        return;
+    }
+    size_t buffered = 0;
+    for (const auto& sr : _shard_readers) {
+        buffered += sr->buffer_size();
+    }
+    if (buffered <= read_ahead_memory_limit()) {
+        return;
+    }
+    // The consumer doesn't keep up with the read-aheads, their buffers pile
+    // up. Back off, to stay within the memory limit.
+    _concurrency = std::max(_concurrency / 2, 1u);
+    set_shard_buffer_size(std::max(_shard_buffer_size / 2, default_max_buffer_size_in_bytes()));
+    tracing::trace(_trace_state, "Reducing multishard read-ahead to {} shard(s), {} bytes per shard, {} bytes are buffered",
+            _concurrency, _shard_buffer_size, buffered);
+}
+
 future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
     auto& reader = *_shard_readers[_current_shard];
 
@@ -1854,7 +1999,11 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
         // double concurrency so the next time we cross shards we will have
         // more chances of hitting the reader's buffer.
         if (_crossed_shards) {
-            _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
+            const auto concurrency = std::min(_concurrency * 2, _sharder.shard_count());
+            if (concurrency != _concurrency && read_ahead_fits(concurrency, _shard_buffer_size)) {
+                _concurrency = concurrency;
+                tracing::trace(_trace_state, "Increasing multishard read-ahead to {} shard(s)", _concurrency);
+            }
 
             // Read ahead shouldn't change the min selection heap so we work on a local copy.
             auto shard_selection_min_heap_copy = _shard_selection_min_heap;
@@ -1868,6 +2017,12 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
                 shard_selection_min_heap_copy.pop_back();
                 _shard_readers[next_shard]->read_ahead();
             }
+        } else if (_shard_buffer_size < max_shard_buffer_size && read_ahead_fits(_concurrency, _shard_buffer_size * 2)) {
+            // The consumer drained the buffer of the shard it is reading
+            // from and has to wait for the next one. Bring more over with
+            // each fill, so it waits for fewer round-trips to the shard.
+            set_shard_buffer_size(_shard_buffer_size * 2);
+            tracing::trace(_trace_state, "Increasing multishard read-ahead to {} bytes per shard", _shard_buffer_size);
         }
         return reader.fill_buffer();
     }
@@ -1883,7 +2038,7 @@ multishard_combining_reader_v2::multishard_combining_reader_v2(
         const io_priority_class& pc,
         tracing::trace_state_ptr trace_state,
         mutation_reader::forwarding fwd_mr)
-    : impl(std::move(s), std::move(permit)), _sharder(sharder) {
+    : impl(std::move(s), std::move(permit)), _sharder(sharder), _trace_state(trace_state) {
 
     on_partition_range_change(pr);
 
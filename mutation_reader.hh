@@ -46,11 +46,19 @@ flat_mutation_reader_v2 make_combined_reader(schema_ptr schema,
         std::vector<flat_mutation_reader_v2>,
         streamed_mutation::forwarding fwd_sm = streamed_mutation::forwarding::no,
         mutation_reader::forwarding fwd_mr = mutation_reader::forwarding::yes);
+// With lookahead, readers positioned at a partition the merge didn't reach
+// yet fill their buffers in the background, instead of issuing their I/O
+// only once the merge gets to them. Meant for scans over many overlapping
+// readers. Lookahead is started only while the memory consumed by the
+// permit is below its max result size soft limit.
+using combined_reader_lookahead = bool_class<class combined_reader_lookahead_tag>;
+
 flat_mutation_reader_v2 make_combined_reader(schema_ptr schema,
         reader_permit permit,
         std::unique_ptr<reader_selector>,
         streamed_mutation::forwarding,
-        mutation_reader::forwarding);
+        mutation_reader::forwarding,
+        combined_reader_lookahead lookahead = combined_reader_lookahead::no);
 flat_mutation_reader_v2 make_combined_reader(schema_ptr schema,
         reader_permit permit,
         flat_mutation_reader_v2&& a,
@@ -565,8 +573,14 @@ class reader_lifecycle_policy_v2 {
 /// has to move between shards often. When concurrency is > 1, the reader
 /// issues background read-aheads to the next shards so that by the time it
 /// needs to move to them they have the data ready.
-/// For dense tables (where we rarely cross shards) we rely on the
-/// foreign_reader to issue sufficient read-aheads on its own to avoid blocking.
+/// For dense tables (where we rarely cross shards) the reader instead doubles
+/// the size of the buffer filled on the remote shard (up to 16 times the
+/// default), each time it has to wait for the shard it reads from, so that
+/// it makes fewer round-trips to it.
+/// Both are bounded by the page size of the permit's max result size: the
+/// concurrency times the buffer size must fit in it. When the buffers of the
+/// shard readers grow above that, because the consumer doesn't keep up, both
+/// are halved again. The changes are logged in the trace.
 ///
 /// The readers' life-cycles are managed through the supplied lifecycle policy.
 flat_mutation_reader_v2 make_multishard_combining_reader_v2(
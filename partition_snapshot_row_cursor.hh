@@ -610,12 +610,13 @@ class partition_snapshot_row_cursor final {
 
     // Brings the entry pointed to by the cursor to the front of the LRU
     // Cursor must be valid and pointing at a row.
-    void touch() {
+    // See cache_tracker::touch() for promote.
+    void touch(bool promote = true) {
         // We cannot bring entries from non-latest versions to the front because that
         // could result violate ordering invariant for the LRU, which states that older versions
         // must be evicted first. Needed to keep the snapshot consistent.
         if (_snp.at_latest_version() && is_in_latest_version()) {
-            _snp.tracker()->touch(*get_iterator_in_latest_version());
+            _snp.tracker()->touch(*get_iterator_in_latest_version(), promote);
         }
     }
 
@@ -619,7 +619,7 @@ partition_snapshot::range_tombstones()
         position_in_partition_view::after_all_clustered_rows());
 }
 
-void partition_snapshot::touch() noexcept {
+void partition_snapshot::touch(bool promote) noexcept {
     // Eviction assumes that older versions are evicted before newer so only the latest snapshot
     // can be touched.
     if (_tracker && at_latest_version()) {
@@ -627,7 +627,7 @@ void partition_snapshot::touch() noexcept {
         assert(!rows.empty());
         rows_entry& last_dummy = *rows.rbegin();
         assert(last_dummy.is_last_dummy());
-        _tracker->touch(last_dummy);
+        _tracker->touch(last_dummy, promote);
     }
 }
 
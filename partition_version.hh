@@ -351,7 +351,8 @@ class partition_snapshot : public enable_lw_shared_from_this<partition_snapshot>
     stop_iteration slide_to_oldest() noexcept;
 
     // Brings the snapshot to the front of the LRU.
-    void touch() noexcept;
+    // See cache_tracker::touch() for promote.
+    void touch(bool promote = true) noexcept;
 
     // Must be called after snapshot's original region is merged into a different region
     // before the original region is destroyed, unless the snapshot is destroyed earlier.
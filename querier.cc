@@ -215,8 +215,16 @@ struct querier_utils {
     static void set_inactive_read_handle(querier_base& q, reader_concurrency_semaphore::inactive_read_handle h) noexcept {
         q._reader = std::move(h);
     }
+    static size_t& cached_memory_usage(querier_base& q) noexcept {
+        return q._cached_memory_usage;
+    }
 };
 
+static void on_querier_removed(querier_cache::stats& stats, querier_base& q) noexcept {
+    --stats.population;
+    stats.memory_usage -= std::exchange(querier_utils::cached_memory_usage(q), 0);
+}
+
 template <typename Querier>
 void querier_cache::insert_querier(
         utils::UUID key,
@@ -236,6 +244,16 @@ void querier_cache::insert_querier(
         return;
     }
 
+    const auto memory_usage = q.memory_usage();
+    if (stats.memory_usage + memory_usage > _max_memory_usage) {
+        tracing::trace(trace_state, "Not caching querier with key {}, the cache is full", key);
+        ++stats.memory_based_drops;
+        (void)with_gate(_closing_gate, [this, q = std::move(q)] () mutable {
+            return q.close().finally([q = std::move(q)] {});
+        });
+        return;
+    }
+
     ++stats.inserts;
 
     tracing::trace(trace_state, "Caching querier with key {}", key);
@@ -255,16 +273,20 @@ void querier_cache::insert_querier(
     auto it = index.emplace(key, std::make_unique<Querier>(std::move(q)));
 
     ++stats.population;
+    stats.memory_usage += memory_usage;
+    querier_utils::cached_memory_usage(*it->second) = memory_usage;
     auto cleanup_index = defer([&] () noexcept {
+        on_querier_removed(stats, *it->second);
         index.erase(it);
-        --stats.population;
     });
 
-    auto notify_handler = [&stats, &index, it] (reader_concurrency_semaphore::evict_reason reason) {
+    auto notify_handler = [&stats, &index, it, cost = sem.get_resumption_cost(irh)] (reader_concurrency_semaphore::evict_reason reason) {
+        on_querier_removed(stats, *it->second);
         index.erase(it);
         switch (reason) {
             case reader_concurrency_semaphore::evict_reason::permit:
                 ++stats.resource_based_evictions;
+                stats.resource_based_eviction_cost += cost;
                 break;
             case reader_concurrency_semaphore::evict_reason::time:
                 ++stats.time_based_evictions;
@@ -272,7 +294,6 @@ void querier_cache::insert_querier(
             case reader_concurrency_semaphore::evict_reason::manual:
                 break;
         }
-        --stats.population;
     };
 
     sem.set_notify_handler(irh, std::move(notify_handler), ttl);
@@ -328,7 +349,7 @@ std::optional<Querier> querier_cache::lookup_querier(
     }
     reader_opt->set_timeout(timeout);
     querier_utils::set_reader(q, std::move(*reader_opt));
-    --stats.population;
+    on_querier_removed(stats, q);
 
     const auto can_be_used = can_be_used_for_page(q, s, ranges.front(), slice);
     if (can_be_used == can_use::yes) {
@@ -338,6 +359,9 @@ std::optional<Querier> querier_cache::lookup_querier(
 
     tracing::trace(trace_state, "Dropping querier because {}", cannot_use_reason(can_be_used));
     ++stats.drops;
+    if (can_be_used == can_use::no_schema_version_mismatch) {
+        ++stats.schema_version_drops;
+    }
 
     // Close and drop the querier in the background.
     // It is safe to do so, since _closing_gate is closed and
@@ -395,6 +419,10 @@ void querier_cache::set_entry_ttl(std::chrono::seconds entry_ttl) {
     _entry_ttl = entry_ttl;
 }
 
+void querier_cache::set_max_memory_usage(size_t max_memory_usage) {
+    _max_memory_usage = max_memory_usage;
+}
+
 future<bool> querier_cache::evict_one() noexcept {
     for (auto ip : {&_data_querier_index, &_mutation_querier_index, &_shard_mutation_querier_index}) {
         auto& idx = *ip;
@@ -403,9 +431,9 @@ future<bool> querier_cache::evict_one() noexcept {
         }
         auto it = idx.begin();
         auto reader_opt = it->second->permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(*it->second));
+        on_querier_removed(_stats, *it->second);
         idx.erase(it);
         ++_stats.resource_based_evictions;
-        --_stats.population;
         if (reader_opt) {
             co_await reader_opt->close();
         }
@@ -420,8 +448,8 @@ future<> querier_cache::evict_all_for_table(const utils::UUID& schema_id) noexce
         for (auto it = idx.begin(); it != idx.end();) {
             if (it->second->schema().id() == schema_id) {
                 auto reader_opt = it->second->permit().semaphore().unregister_inactive_read(querier_utils::get_inactive_read_handle(*it->second));
+                on_querier_removed(_stats, *it->second);
                 it = idx.erase(it);
-                --_stats.population;
                 if (reader_opt) {
                     co_await reader_opt->close();
                 }
@@ -440,7 +468,7 @@ future<> querier_cache::stop() noexcept {
         auto& idx = *ip;
         for (auto it = idx.begin(); it != idx.end(); it = idx.erase(it)) {
             co_await it->second->close();
-            --_stats.population;
+            on_querier_removed(_stats, *it->second);
         }
     }
 }
@@ -103,6 +103,8 @@ class querier_base {
     std::unique_ptr<const query::partition_slice> _slice;
     std::variant<flat_mutation_reader_v2, reader_concurrency_semaphore::inactive_read_handle> _reader;
     dht::partition_ranges_view _query_ranges;
+    // The memory usage accounted to the querier_cache while the querier is in it.
+    size_t _cached_memory_usage = 0;
 
 public:
     querier_base(reader_permit permit, lw_shared_ptr<const dht::partition_range> range,
@@ -320,9 +322,9 @@ class shard_mutation_querier : public querier_base {
 /// abandoned queriers.
 /// Registers cached readers with the reader concurrency semaphore, as inactive
 /// readers, so the latter can evict them if needed.
-/// Keeps the total memory consumption of cached queriers
-/// below max_queriers_memory_usage by evicting older entries upon inserting
-/// new ones if the the memory consupmtion would go above the limit.
+/// Keeps the total memory consumption of cached queriers below the limit set
+/// with set_max_memory_usage(), by not caching queriers which would take it
+/// above the limit.
 class querier_cache {
 public:
     static const std::chrono::seconds default_entry_ttl;
@@ -335,15 +337,25 @@ class querier_cache {
         // The subset of lookups that missed.
         uint64_t misses = 0;
         // The subset of lookups that hit but the looked up querier had to be
-        // dropped due to position mismatch.
+        // dropped due to position or schema version mismatch.
         uint64_t drops = 0;
+        // The subset of drops due to schema version mismatch.
+        uint64_t schema_version_drops = 0;
+        // The number of queriers not cached because the memory consumption of
+        // the cache would go above the limit.
+        uint64_t memory_based_drops = 0;
         // The number of queriers evicted due to their TTL expiring.
         uint64_t time_based_evictions = 0;
         // The number of queriers evicted to free up resources to be able to
         // create new readers.
         uint64_t resource_based_evictions = 0;
+        // The summed resumption cost of the queriers evicted to free up
+        // resources, see reader_concurrency_semaphore::get_resumption_cost().
+        uint64_t resource_based_eviction_cost = 0;
         // The number of queriers currently in the cache.
         uint64_t population = 0;
+        // The memory consumed by the queriers currently in the cache.
+        uint64_t memory_usage = 0;
     };
 
     using index = std::unordered_multimap<utils::UUID, std::unique_ptr<querier_base>>;
@@ -353,6 +365,7 @@ class querier_cache {
     index _mutation_querier_index;
     index _shard_mutation_querier_index;
     std::chrono::seconds _entry_ttl;
+    size_t _max_memory_usage = std::numeric_limits<size_t>::max();
     stats _stats;
     gate _closing_gate;
 
@@ -437,6 +450,11 @@ class querier_cache {
     /// Applies only to entries inserted after the change.
     void set_entry_ttl(std::chrono::seconds entry_ttl);
 
+    /// Change the memory limit of the cached queriers
+    ///
+    /// Applies only to entries inserted after the change.
+    void set_max_memory_usage(size_t max_memory_usage);
+
     /// Evict a querier.
     ///
     /// Return true if a querier was evicted and false otherwise (if the cache
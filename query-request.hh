@@ -163,6 +163,11 @@ class partition_slice {
         // directly, bypassing the intermediate reconcilable_result format used
         // in pre 4.5 range scans.
         range_scan_data_variant,
+        // The coordinator only needs the number of rows, e.g. for count(*).
+        // Of each partition's clustering rows only the last one is written to
+        // the result, the others are just counted in its row count, see
+        // mutation_querier. The digest still covers all rows.
+        count_only,
     };
     using option_set = enum_set<super_enum<option,
         option::send_clustering_key,
@@ -177,7 +182,8 @@ class partition_slice {
         option::with_digest,
         option::bypass_cache,
         option::always_return_static_content,
-        option::range_scan_data_variant>>;
+        option::range_scan_data_variant,
+        option::count_only>>;
     clustering_row_ranges _row_ranges;
 public:
     column_id_vector static_columns; // TODO: consider using bitmap
@@ -363,7 +369,17 @@ class read_command {
 
 struct forward_request {
     enum class reduction_type {
+        // count(*)
         count,
+        // The reductions below aggregate the column named by the matching
+        // element of `reduction_columns`.
+        // count(column), the number of its non-null values
+        count_column,
+        // sum(column). Columns of integer types are summed up as varints,
+        // so that partial sums don't overflow where the final one doesn't.
+        sum,
+        min,
+        max,
     };
 
     // multiple reduction types are needed to support queries like:
@@ -375,6 +391,10 @@ struct forward_request {
 
     db::consistency_level cl;
     lowres_clock::time_point timeout;
+
+    // The column each reduction aggregates, empty for `count`. Coordinators
+    // which only send `count` may leave it empty altogether.
+    std::vector<sstring> reduction_columns;
 };
 
 std::ostream& operator<<(std::ostream& out, const forward_request& r);
@@ -384,8 +404,6 @@ struct forward_result {
     // vector storing query result for each selected column
     std::vector<bytes_opt> query_results;
 
-    void merge(const forward_result& other, const std::vector<forward_request::reduction_type>& types);
-
     struct printer {
         const std::vector<forward_request::reduction_type>& types;
         const query::forward_result& res;
@@ -196,6 +196,9 @@ class mutation_querier {
     bool _live_data_in_static_row{};
     uint64_t _live_clustering_rows = 0;
     std::optional<ser::qr_partition__rows<bytes_ostream>> _rows_wr;
+    // With partition_slice::option::count_only, the key of the last row
+    // consumed, written at the end of the partition.
+    std::optional<clustering_key> _last_row_key;
 private:
     void query_static_row(const row& r, tombstone current_tombstone);
     void prepare_writers();
@@ -68,6 +68,18 @@ std::ostream& operator<<(std::ostream& out, const forward_request::reduction_typ
         case forward_request::reduction_type::count:
             out << "count";
             break;
+        case forward_request::reduction_type::count_column:
+            out << "count_column";
+            break;
+        case forward_request::reduction_type::sum:
+            out << "sum";
+            break;
+        case forward_request::reduction_type::min:
+            out << "min";
+            break;
+        case forward_request::reduction_type::max:
+            out << "max";
+            break;
     }
     return out << "}";
 }
@@ -77,6 +89,7 @@ std::ostream& operator<<(std::ostream& out, const forward_request& r) {
 
     return out << "forward_request{"
         << "reduction_types=[" << join(",", r.reduction_types) << "]"
+        << ", reduction_columns=[" << join(",", r.reduction_columns) << "]"
         << ", cmd=" << r.cmd
         << ", pr=" << r.pr
         << ", cl=" << r.cl
@@ -390,38 +403,6 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
     return make_foreign(make_lw_shared<query::result>(std::move(w), is_short_read, row_count, partition_count));
 }
 
-static bytes_opt merge_singular_results(bytes_opt r1, bytes_opt r2, forward_request::reduction_type reduction) {
-    switch (reduction) {
-        case forward_request::reduction_type::count: {
-            auto count1 = value_cast<int64_t>(long_type->deserialize(bytes_view(*r1)));
-            auto count2 = value_cast<int64_t>(long_type->deserialize(bytes_view(*r2)));
-            return data_value(count1 + count2).serialize();
-        }
-    }
-    throw std::runtime_error("unknown reduction type");
-}
-
-void forward_result::merge(const forward_result& other, const std::vector<forward_request::reduction_type>& reduction_types) {
-    if (query_results.empty()) {
-        query_results.resize(other.query_results.size());
-    }
-
-    if (query_results.size() != other.query_results.size() || query_results.size() != reduction_types.size()) {
-        on_internal_error(
-            qlogger,
-            format("forward_result::merge(): operation cannot be completed due to invalid argument sizes. "
-                    "this.query_results.size(): {} "
-                    "other.query_results.size(): {} "
-                    "reduction_types.size(): {}",
-                    query_results.size(), other.query_results.size(), reduction_types.size())
-        );
-    }
-
-    for (size_t i = 0; i < query_results.size(); i++) {
-        query_results[i] = merge_singular_results(query_results[i], other.query_results[i], reduction_types[i]);
-    }
-}
-
 std::ostream& operator<<(std::ostream& out, const query::forward_result::printer& p) {
     if (p.types.size() != p.res.query_results.size()) {
         return out << "[malformed forward_result (" << p.res.query_results.size()
@@ -430,10 +411,23 @@ std::ostream& operator<<(std::ostream& out, const query::forward_result::printer
 
     out << "[";
     for (size_t i = 0; i < p.types.size(); i++) {
-        switch (p.types[i]) {
-            case forward_request::reduction_type::count: {
-                auto count = value_cast<int64_t>(long_type->deserialize(bytes_view(*p.res.query_results[i])));
-                out << count;
+        const auto& result = p.res.query_results[i];
+        if (!result) {
+            out << "null";
+        } else {
+            switch (p.types[i]) {
+                case forward_request::reduction_type::count:
+                case forward_request::reduction_type::count_column: {
+                    auto count = value_cast<int64_t>(long_type->deserialize(bytes_view(*result)));
+                    out << count;
+                    break;
+                }
+                case forward_request::reduction_type::sum:
+                case forward_request::reduction_type::min:
+                case forward_request::reduction_type::max:
+                    // The type of these depends on the aggregated column.
+                    out << to_hex(*result);
+                    break;
             }
         }
 
@@ -134,6 +134,8 @@ class server_impl : public rpc_server, public server {
         uint64_t persisted_log_entries = 0;
         uint64_t queue_entries_for_apply = 0;
         uint64_t applied_entries = 0;
+        uint64_t apply_batches = 0;
+        std::chrono::microseconds apply_time{0};
         uint64_t snapshots_taken = 0;
         uint64_t timeout_now_sent = 0;
         uint64_t timeout_now_received = 0;
@@ -295,7 +297,8 @@ future<> server_impl::start() {
                                  fsm_config {
                                      .append_request_threshold = _config.append_request_threshold,
                                      .max_log_size = _config.max_log_size,
-                                     .enable_prevoting = _config.enable_prevoting
+                                     .enable_prevoting = _config.enable_prevoting,
+                                     .max_append_requests_in_flight = _config.max_append_requests_in_flight,
                                  });
 
     _applied_idx = index_t{0};
@@ -977,12 +980,15 @@ future<> server_impl::applier_fiber() {
 
                 auto size = commands.size();
                 if (size) {
+                    auto start = std::chrono::steady_clock::now();
                     try {
                         co_await _state_machine->apply(std::move(commands));
                     } catch (...) {
                         std::throw_with_nested(raft::state_machine_error{});
                     }
                     _stats.applied_entries += size;
+                    _stats.apply_batches++;
+                    _stats.apply_time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
                 }
 
                _applied_idx = last_idx;
@@ -1292,6 +1298,10 @@ void server_impl::register_metrics() {
              sm::description("how many log entries were queued to be applied"), {server_id_label(_id)}),
         sm::make_total_operations("applied_entries", _stats.applied_entries,
              sm::description("how many log entries were applied"), {server_id_label(_id)}),
+        sm::make_total_operations("apply_batches", _stats.apply_batches,
+             sm::description("how many times the user's state machine was called to apply a batch of entries"), {server_id_label(_id)}),
+        sm::make_counter("apply_time_us", [this] { return _stats.apply_time.count(); },
+             sm::description("total time the user's state machine spent applying entries, in microseconds"), {server_id_label(_id)}),
         sm::make_total_operations("snapshots_taken", _stats.snapshots_taken,
              sm::description("how many time the user's state machine was snapshotted"), {server_id_label(_id)}),
 
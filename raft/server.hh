@@ -27,6 +27,9 @@ class server {
         size_t snapshot_trailing = 200;
         // max size of appended entries in bytes
         size_t append_request_threshold = 100000;
+        // Max number of un-acked append requests sent to a follower
+        // whose log is known to match the leader's
+        size_t max_append_requests_in_flight = 10;
         // Max number of entries of in-memory part of the log after
         // which requests are stopped to be admitted until the log
         // is shrunk back by a snapshot. Should be greater than
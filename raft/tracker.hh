@@ -46,7 +46,6 @@ class follower_progress {
     bool probe_sent = false;
     // number of in flight still un-acked append entries requests
     size_t in_flight = 0;
-    static constexpr size_t max_in_flight = 10;
 
     // Check if a reject packet should be ignored because it was delayed or reordered.
     // This is not 100% accurate (may return false negatives) and should only be relied on
@@ -72,7 +71,8 @@ class follower_progress {
     }
 
     // Return true if a new replication record can be sent to the follower.
-    bool can_send_to();
+    // In PIPELINE state, at most max_in_flight requests may be un-acked.
+    bool can_send_to(size_t max_in_flight);
 
     follower_progress(server_id id_arg, index_t next_idx_arg)
         : id(id_arg), next_idx(next_idx_arg)
@@ -110,6 +110,13 @@ class range_tombstone_list final {
         const schema& _s;
     protected:
         range_tombstone_list& _dst;
+        // Makes room for one more op, so that recording it after the change doesn't throw.
+        // Grows geometrically, since a reverter may record an op for each tombstone of a large list.
+        void reserve_op() {
+            if (_ops.size() == _ops.capacity()) {
+                _ops.reserve(std::max<size_t>(4, _ops.capacity() * 2));
+            }
+        }
     public:
         reverter(const schema& s, range_tombstone_list& dst)
                 : _s(s)
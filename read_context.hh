@@ -130,6 +130,8 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
     tracing::trace_state_ptr _trace_state;
     mutation_reader::forwarding _fwd_mr;
     bool _range_query;
+    // See cache_tracker::touch() and cache_tracker::insert().
+    bool _probationary;
     // When reader enters a partition, it must be set up for reading that
     // partition from the underlying mutation source (_underlying) in one of two ways:
     //
@@ -172,6 +174,16 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
         ++_cache._tracker._stats.reads;
         if (!_range_query) {
             _key = range.start()->value().as_decorated_key();
+            _probationary = _cache._tracker.admit(cache_tracker::key_hash(*_schema, *_key));
+            if (!_probationary) {
+                _cache.on_repeated_read(*_key);
+            }
+        } else {
+            _probationary = true;
+        }
+        _probationary = _cache._tracker.is_probationary(*_schema, _probationary);
+        if (_probationary) {
+            ++_cache._tracker._stats.probationary_reads;
         }
     }
     ~read_context() {
@@ -196,6 +208,7 @@ class read_context final : public enable_lw_shared_from_this<read_context> {
     tracing::trace_state_ptr trace_state() const { return _trace_state; }
     mutation_reader::forwarding fwd_mr() const { return _fwd_mr; }
     bool is_range_query() const { return _range_query; }
+    bool is_probationary() const { return _probationary; }
     autoupdating_underlying_reader& underlying() { return _underlying; }
     row_cache::phase_type phase() const { return _phase; }
     const dht::decorated_key& key() const { return *_key; }
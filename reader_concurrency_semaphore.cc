@@ -82,6 +82,14 @@ class reader_permit::impl
     bool _marked_as_blocked = false;
     db::timeout_clock::time_point _timeout;
     query::max_result_size _max_result_size{query::result_memory_limiter::unlimited_result_size};
+    unsigned _estimated_io = reader_concurrency_semaphore::read_cost::unknown_io;
+    reader_permit::read_stats _read_stats;
+    struct free_fragment_block {
+        free_fragment_block* next;
+    };
+    free_fragment_block* _free_fragment_blocks = nullptr;
+    size_t _free_fragment_block_count = 0;
+    size_t _fragment_block_size = 0;
 
 private:
     void on_permit_used() {
@@ -139,6 +147,10 @@ class reader_permit::impl
         _semaphore.on_permit_created(*this);
     }
     ~impl() {
+        while (_free_fragment_blocks) {
+            ::operator delete(pop_free_fragment_block());
+        }
+
         if (_base_resources_consumed) {
             signal(_base_resources);
         }
@@ -326,6 +338,44 @@ class reader_permit::impl
     void set_max_result_size(query::max_result_size s) {
         _max_result_size = std::move(s);
     }
+
+    unsigned estimated_io() const noexcept {
+        return _estimated_io;
+    }
+
+    void set_estimated_io(unsigned io) noexcept {
+        _estimated_io = io;
+    }
+
+    reader_permit::read_stats& get_read_stats() noexcept {
+        return _read_stats;
+    }
+
+    void* pop_free_fragment_block() noexcept {
+        auto b = std::exchange(_free_fragment_blocks, _free_fragment_blocks->next);
+        --_free_fragment_block_count;
+        signal(reader_resources::with_memory(_fragment_block_size));
+        return b;
+    }
+
+    void* allocate_fragment(size_t size) {
+        if (_free_fragment_blocks) {
+            assert(size == _fragment_block_size);
+            return pop_free_fragment_block();
+        }
+        return ::operator new(size);
+    }
+
+    void free_fragment(void* p, size_t size) noexcept {
+        if (_free_fragment_block_count == reader_permit::max_free_fragment_blocks) {
+            ::operator delete(p);
+            return;
+        }
+        _fragment_block_size = size;
+        consume(reader_resources::with_memory(size));
+        _free_fragment_blocks = new (p) free_fragment_block{_free_fragment_blocks};
+        ++_free_fragment_block_count;
+    }
 };
 
 static_assert(std::is_nothrow_copy_constructible_v<reader_permit>);
@@ -434,6 +484,22 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+unsigned reader_permit::estimated_io() const noexcept {
+    return _impl->estimated_io();
+}
+
+reader_permit::read_stats& reader_permit::get_read_stats() const noexcept {
+    return _impl->get_read_stats();
+}
+
+void* reader_permit::allocate_fragment(size_t size) {
+    return _impl->allocate_fragment(size);
+}
+
+void reader_permit::free_fragment(void* p, size_t size) noexcept {
+    _impl->free_fragment(p, size);
+}
+
 std::ostream& operator<<(std::ostream& os, reader_permit::state s) {
     switch (s) {
         case reader_permit::state::waiting:
@@ -638,6 +704,7 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(int count, ssize_t me
     : _initial_resources(count, memory)
     , _resources(count, memory)
     , _wait_list(expiry_handler(*this))
+    , _cheap_wait_list(expiry_handler(*this))
     , _ready_list(max_queue_length)
     , _name(std::move(name))
     , _max_queue_length(max_queue_length)
@@ -669,9 +736,9 @@ reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore:
     permit_impl.on_register_as_inactive();
     // Implies _inactive_reads.empty(), we don't queue new readers before
     // evicting all inactive reads.
-    // Checking the _wait_list covers the count resources only, so check memory
+    // Checking the wait lists covers the count resources only, so check memory
     // separately.
-    if (_wait_list.empty() && _resources.memory > 0) {
+    if (!has_waiters() && _resources.memory > 0) {
       try {
         auto irp = std::make_unique<inactive_read>(std::move(reader));
         auto& ir = *irp;
@@ -736,10 +803,33 @@ bool reader_concurrency_semaphore::try_evict_one_inactive_read(evict_reason reas
     if (_inactive_reads.empty()) {
         return false;
     }
-    evict(_inactive_reads.front(), reason);
+    evict(inactive_read_to_evict(), reason);
     return true;
 }
 
+uint64_t reader_concurrency_semaphore::get_resumption_cost(const inactive_read_handle& irh) const noexcept {
+    return irh._irp ? irh._irp->resumption_cost : 0;
+}
+
+uint64_t reader_concurrency_semaphore::resumption_cost(const flat_mutation_reader_v2& reader) noexcept {
+    auto io = reader.permit().estimated_io();
+    if (io == read_cost::unknown_io) {
+        io = 1;
+    }
+    return io * inactive_read_sstable_cost + reader.buffer_size();
+}
+
+reader_concurrency_semaphore::inactive_read& reader_concurrency_semaphore::inactive_read_to_evict() noexcept {
+    auto it = _inactive_reads.begin();
+    auto cheapest = it;
+    for (size_t i = 1; i < inactive_read_eviction_candidates && ++it != _inactive_reads.end(); ++i) {
+        if (it->resumption_cost < cheapest->resumption_cost) {
+            cheapest = it;
+        }
+    }
+    return *cheapest;
+}
+
 void reader_concurrency_semaphore::clear_inactive_reads() {
     while (!_inactive_reads.empty()) {
         auto& ir = _inactive_reads.front();
@@ -820,7 +910,7 @@ bool reader_concurrency_semaphore::all_used_permits_are_stalled() const {
 }
 
 std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_view queue_name) {
-    if ((_wait_list.size() + _ready_list.size()) >= _max_queue_length) {
+    if ((waiters() + _ready_list.size()) >= _max_queue_length) {
         _stats.total_reads_shed_due_to_overload++;
         maybe_dump_reader_permit_diagnostics(*this, _permit_list, fmt::format("{} queue overload", queue_name));
         return std::make_exception_ptr(std::runtime_error(format("{}: {} queue overload", _name, queue_name)));
@@ -828,7 +918,7 @@ std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_vi
     return {};
 }
 
-future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func) {
+future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func, bool cheap) {
     if (auto ex = check_queue_size("wait")) {
         return make_exception_future<>(std::move(ex));
     }
@@ -836,8 +926,15 @@ future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read
     auto fut = pr.get_future();
     permit.on_waiting();
     auto timeout = permit.timeout();
-    _wait_list.push_back(entry(std::move(pr), std::move(permit), std::move(func)), timeout);
+    if (!cheap && _wait_list.empty()) {
+        _cheap_reads_bypassing = 0;
+    }
+    auto& wait_list = cheap ? _cheap_wait_list : _wait_list;
+    auto e = entry(std::move(pr), std::move(permit), std::move(func));
+    e.queued_at = utils::time_estimated_histogram::clock::now();
+    wait_list.push_back(std::move(e), timeout);
     ++_stats.reads_enqueued;
+    _stats.cheap_reads_enqueued += cheap;
     return fut;
 }
 
@@ -845,8 +942,8 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
     // Evict inactive readers in the background while wait list isn't empty
     // This is safe since stop() closes _gate;
     (void)with_gate(_close_readers_gate, [this] {
-        return do_until([this] { return _wait_list.empty() || _inactive_reads.empty(); }, [this] {
-            return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close();
+        return do_until([this] { return !has_waiters() || _inactive_reads.empty(); }, [this] {
+            return detach_inactive_reader(inactive_read_to_evict(), evict_reason::permit).close();
         });
     });
  }
@@ -855,12 +952,16 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, r
     if (!_execution_loop_future) {
         _execution_loop_future.emplace(execution_loop());
     }
-    if (!_wait_list.empty() || !_ready_list.empty()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+    const bool cheap = is_cheap(permit.estimated_io());
+    // A cheap read may go ahead of waiting expensive reads, within the
+    // limit of cheap_reads_per_expensive_read.
+    const bool can_bypass = cheap && _cheap_wait_list.empty() && (_wait_list.empty() || _cheap_reads_bypassing < cheap_reads_per_expensive_read);
+    if ((!can_bypass && has_waiters()) || !_ready_list.empty()) {
+        return enqueue_waiter(std::move(permit), std::move(func), cheap);
     }
 
     if (!has_available_units(permit.base_resources())) {
-        auto fut = enqueue_waiter(std::move(permit), std::move(func));
+        auto fut = enqueue_waiter(std::move(permit), std::move(func), cheap);
         if (!_inactive_reads.empty()) {
             evict_readers_in_background();
         }
@@ -868,23 +969,49 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, r
     }
 
     if (!all_used_permits_are_stalled()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+        return enqueue_waiter(std::move(permit), std::move(func), cheap);
     }
 
-    permit.on_admission();
-    ++_stats.reads_admitted;
+    on_admission(permit, cheap);
     if (func) {
         return with_ready_permit(std::move(permit), std::move(func));
     }
     return make_ready_future<>();
 }
 
+reader_concurrency_semaphore::wait_list_type* reader_concurrency_semaphore::next_wait_list() noexcept {
+    auto can_admit = [this] (const wait_list_type& wl) {
+        return !wl.empty() && has_available_units(wl.front().permit.base_resources());
+    };
+    if (can_admit(_cheap_wait_list) && (_wait_list.empty() || _cheap_reads_bypassing < cheap_reads_per_expensive_read)) {
+        return &_cheap_wait_list;
+    }
+    // The expensive read is only admitted in order, but when it doesn't fit,
+    // cheap reads that do fit go ahead of it, within the limit above.
+    if (can_admit(_wait_list)) {
+        return &_wait_list;
+    }
+    return nullptr;
+}
+
+void reader_concurrency_semaphore::on_admission(reader_permit& permit, bool cheap) {
+    permit.on_admission();
+    ++_stats.reads_admitted;
+    if (cheap) {
+        ++_stats.cheap_reads_admitted;
+        _cheap_reads_bypassing += !_wait_list.empty();
+    } else {
+        _cheap_reads_bypassing = 0;
+    }
+}
+
 void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
-    while (!_wait_list.empty() && _ready_list.empty() && has_available_units(_wait_list.front().permit.base_resources()) && all_used_permits_are_stalled()) {
-        auto& x = _wait_list.front();
+    wait_list_type* wait_list;
+    while (_ready_list.empty() && all_used_permits_are_stalled() && (wait_list = next_wait_list())) {
+        auto& x = wait_list->front();
         try {
-            x.permit.on_admission();
-            ++_stats.reads_admitted;
+            on_admission(x.permit, wait_list == &_cheap_wait_list);
+            _stats.admission_wait_time.add(utils::time_estimated_histogram::clock::now() - x.queued_at);
             if (x.func) {
                 _ready_list.push(std::move(x));
             } else {
@@ -893,7 +1020,7 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
         } catch (...) {
             x.pr.set_exception(std::current_exception());
         }
-        _wait_list.pop_front();
+        wait_list->pop_front();
     }
 }
 
@@ -948,6 +1075,15 @@ future<reader_permit> reader_concurrency_semaphore::obtain_permit(const schema*
     });
 }
 
+future<reader_permit> reader_concurrency_semaphore::obtain_permit(const schema* const schema, const char* const op_name, read_cost cost,
+        db::timeout_clock::time_point timeout) {
+    auto permit = reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(cost.memory)}, timeout);
+    permit._impl->set_estimated_io(cost.io);
+    return do_wait_admission(permit).then([permit] () mutable {
+        return std::move(permit);
+    });
+}
+
 reader_permit reader_concurrency_semaphore::make_tracking_only_permit(const schema* const schema, const char* const op_name, db::timeout_clock::time_point timeout) {
     return reader_permit(*this, schema, std::string_view(op_name), {}, timeout);
 }
@@ -961,6 +1097,13 @@ future<> reader_concurrency_semaphore::with_permit(const schema* const schema, c
     return do_wait_admission(reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout), std::move(func));
 }
 
+future<> reader_concurrency_semaphore::with_permit(const schema* const schema, const char* const op_name, read_cost cost,
+        db::timeout_clock::time_point timeout, read_func func) {
+    auto permit = reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(cost.memory)}, timeout);
+    permit._impl->set_estimated_io(cost.io);
+    return do_wait_admission(std::move(permit), std::move(func));
+}
+
 future<> reader_concurrency_semaphore::with_ready_permit(reader_permit permit, read_func func) {
     if (auto ex = check_queue_size("ready")) {
         return make_exception_future<>(std::move(ex));
@@ -975,9 +1118,11 @@ void reader_concurrency_semaphore::broken(std::exception_ptr ex) {
     if (!ex) {
         ex = std::make_exception_ptr(broken_semaphore{});
     }
-    while (!_wait_list.empty()) {
-        _wait_list.front().pr.set_exception(ex);
-        _wait_list.pop_front();
+    for (auto* wait_list : {&_wait_list, &_cheap_wait_list}) {
+        while (!wait_list->empty()) {
+            wait_list->front().pr.set_exception(ex);
+            wait_list->pop_front();
+        }
     }
 }
 
@@ -1059,6 +1204,7 @@ class tracking_file_impl : public file_impl {
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
         return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, pc).then([this, units = _permit.consume_memory(range_size)] (temporary_buffer<uint8_t> buf) {
+            _permit.get_read_stats().sstable_bytes_read += buf.size();
             return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), _permit));
         });
     }
@@ -15,6 +15,7 @@
 #include <seastar/core/expiring_fifo.hh>
 #include "reader_permit.hh"
 #include "readers/flat_mutation_reader_v2.hh"
+#include "utils/estimated_histogram.hh"
 
 namespace bi = boost::intrusive;
 
@@ -29,7 +30,9 @@ using namespace seastar;
 /// The semaphore can be configured with the desired limits on
 /// construction. New readers will only be admitted when there is both
 /// enough count and memory units available. Readers are admitted in
-/// FIFO order.
+/// FIFO order, except for cheap reads (see \ref read_cost and
+/// \ref set_cheap_read_io_threshold()), which have a queue of their own,
+/// so that they are not held up behind expensive reads.
 /// Semaphore's `name` must be provided in ctor and its only purpose is
 /// to increase readability of exceptions: both timeout exceptions and
 /// queue overflow exceptions (read below) include this `name` in messages.
@@ -58,6 +61,28 @@ class reader_concurrency_semaphore {
 
     using eviction_notify_handler = noncopyable_function<void(evict_reason)>;
 
+    /// The estimated cost of a read, used for its admission.
+    struct read_cost {
+        // The memory the read is expected to need, it is consumed on admission.
+        size_t memory = 0;
+        // The number of sstables the read is expected to read from, 0 if
+        // it is expected to be served from the cache.
+        unsigned io = unknown_io;
+
+        static constexpr unsigned unknown_io = std::numeric_limits<unsigned>::max();
+    };
+
+    // The number of cheap reads admitted ahead of a waiting expensive read,
+    // before the expensive read is admitted.
+    static constexpr unsigned cheap_reads_per_expensive_read = 4;
+
+    // The cost of re-opening the reader of an sstable and finding the position
+    // of a read in its index, counted in bytes read, see get_resumption_cost().
+    static constexpr uint64_t inactive_read_sstable_cost = 16 * 1024;
+    // Inactive reads are evicted oldest first, but the cheapest to resume of
+    // this many of the oldest ones goes first.
+    static constexpr size_t inactive_read_eviction_candidates = 8;
+
     struct stats {
         // The number of inactive reads evicted to free up permits.
         uint64_t permit_based_evictions = 0;
@@ -75,6 +100,10 @@ class reader_concurrency_semaphore {
         uint64_t reads_admitted = 0;
         // Total number of reads enqueued to wait for admission.
         uint64_t reads_enqueued = 0;
+        // Total number of cheap reads admitted, included in `reads_admitted`.
+        uint64_t cheap_reads_admitted = 0;
+        // Total number of cheap reads enqueued, included in `reads_enqueued`.
+        uint64_t cheap_reads_enqueued = 0;
         // Total number of permits created so far.
         uint64_t total_permits = 0;
         // Current number of permits.
@@ -83,6 +112,8 @@ class reader_concurrency_semaphore {
         uint64_t used_permits = 0;
         // Current number of blocked permits.
         uint64_t blocked_permits = 0;
+        // The time reads admitted from the wait queues spent waiting.
+        utils::time_estimated_histogram admission_wait_time;
     };
 
     using permit_list_type = bi::list<
@@ -99,6 +130,8 @@ class reader_concurrency_semaphore {
         promise<> pr;
         reader_permit permit;
         read_func func;
+        // Only set for entries of the wait lists.
+        utils::time_estimated_histogram::clock::time_point queued_at;
         entry(promise<>&& pr, reader_permit permit, read_func func)
             : pr(std::move(pr)), permit(std::move(permit)), func(std::move(func)) {}
     };
@@ -116,9 +149,11 @@ class reader_concurrency_semaphore {
         eviction_notify_handler notify_handler;
         timer<lowres_clock> ttl_timer;
         inactive_read_handle* handle = nullptr;
+        uint64_t resumption_cost;
 
         explicit inactive_read(flat_mutation_reader_v2 reader_) noexcept
             : reader(std::move(reader_))
+            , resumption_cost(reader_concurrency_semaphore::resumption_cost(reader))
         { }
         ~inactive_read();
         void detach() noexcept;
@@ -173,8 +208,15 @@ class reader_concurrency_semaphore {
     const resources _initial_resources;
     resources _resources;
 
-    expiring_fifo<entry, expiry_handler, db::timeout_clock> _wait_list;
+    using wait_list_type = expiring_fifo<entry, expiry_handler, db::timeout_clock>;
+
+    wait_list_type _wait_list;
+    // Reads whose estimated I/O is below _cheap_read_io_threshold.
+    wait_list_type _cheap_wait_list;
     queue<entry> _ready_list;
+    unsigned _cheap_read_io_threshold = 0;
+    // Cheap reads admitted ahead of the expensive read at the front of _wait_list.
+    unsigned _cheap_reads_bypassing = 0;
 
     sstring _name;
     size_t _max_queue_length = std::numeric_limits<size_t>::max();
@@ -189,16 +231,29 @@ class reader_concurrency_semaphore {
 private:
     [[nodiscard]] flat_mutation_reader_v2 detach_inactive_reader(inactive_read&, evict_reason reason) noexcept;
     void evict(inactive_read&, evict_reason reason) noexcept;
+    // The inactive read to evict to free up resources.
+    inactive_read& inactive_read_to_evict() noexcept;
+    static uint64_t resumption_cost(const flat_mutation_reader_v2&) noexcept;
 
     bool has_available_units(const resources& r) const;
 
+    bool is_cheap(unsigned io) const noexcept {
+        return io < _cheap_read_io_threshold;
+    }
+    bool has_waiters() const noexcept {
+        return !_wait_list.empty() || !_cheap_wait_list.empty();
+    }
+    // The wait list to admit the next read from, nullptr if no read can be admitted.
+    wait_list_type* next_wait_list() noexcept;
+    void on_admission(reader_permit& permit, bool cheap);
+
     bool all_used_permits_are_stalled() const;
 
     [[nodiscard]] std::exception_ptr check_queue_size(std::string_view queue_name);
 
     // Add the permit to the wait queue and return the future which resolves when
     // the permit is admitted (popped from the queue).
-    future<> enqueue_waiter(reader_permit permit, read_func func);
+    future<> enqueue_waiter(reader_permit permit, read_func func, bool cheap);
     void evict_readers_in_background();
     future<> do_wait_admission(reader_permit permit, read_func func = {});
     void maybe_admit_waiters() noexcept;
@@ -300,6 +355,14 @@ class reader_concurrency_semaphore {
     /// (if there was no reader to evict).
     bool try_evict_one_inactive_read(evict_reason = evict_reason::manual);
 
+    /// The estimated cost of re-creating the reader of an inactive read, was it evicted
+    ///
+    /// Counted in bytes read: the bytes buffered by the reader, which would be
+    /// read again, plus \ref inactive_read_sstable_cost for each sstable the read
+    /// was estimated to read from (for one, when not estimated).
+    /// Returns 0 if the read was already evicted.
+    uint64_t get_resumption_cost(const inactive_read_handle& irh) const noexcept;
+
     /// Clear all inactive reads.
     void clear_inactive_reads();
 private:
@@ -340,6 +403,8 @@ class reader_concurrency_semaphore {
     /// the schema parameter is allowed.
     future<reader_permit> obtain_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout);
     future<reader_permit> obtain_permit(const schema* const schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout);
+    /// Same as above, for reads whose cost was estimated, see \ref read_cost.
+    future<reader_permit> obtain_permit(const schema* const schema, const char* const op_name, read_cost cost, db::timeout_clock::time_point timeout);
 
     /// Make a tracking only permit
     ///
@@ -377,6 +442,8 @@ class reader_concurrency_semaphore {
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
     future<> with_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, read_func func);
+    /// Same as above, for reads whose cost was estimated, see \ref read_cost.
+    future<> with_permit(const schema* const schema, const char* const op_name, read_cost cost, db::timeout_clock::time_point timeout, read_func func);
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -406,7 +473,11 @@ class reader_concurrency_semaphore {
     void signal(const resources& r) noexcept;
 
     size_t waiters() const {
-        return _wait_list.size();
+        return _wait_list.size() + _cheap_wait_list.size();
+    }
+
+    size_t cheap_waiters() const {
+        return _cheap_wait_list.size();
     }
 
     void broken(std::exception_ptr ex = {});
@@ -420,4 +491,15 @@ class reader_concurrency_semaphore {
     void set_max_queue_length(size_t size) {
         _max_queue_length = size;
     }
+
+    /// Reads estimated to read from fewer than `threshold` sstables are cheap
+    ///
+    /// Cheap reads wait for admission in a queue of their own, and are
+    /// admitted ahead of the other reads, but no more than
+    /// \ref cheap_reads_per_expensive_read of them while an expensive read
+    /// waits. Reads without a cost estimate are never cheap. 0 (the default)
+    /// makes all reads expensive.
+    void set_cheap_read_io_threshold(unsigned threshold) {
+        _cheap_read_io_threshold = threshold;
+    }
 };
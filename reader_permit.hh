@@ -93,6 +93,25 @@ class reader_permit {
 
     class impl;
 
+    // Counts the work done by the reads using the permit, to be reported
+    // in tracing. Pages resumed from the querier cache keep the permit of
+    // the first page, so compare with an earlier copy to get one page's.
+    struct read_stats {
+        uint64_t sstables_read = 0;
+        uint64_t sstable_bytes_read = 0;
+        uint64_t cache_row_hits = 0;
+        uint64_t cache_row_misses = 0;
+
+        read_stats operator-(const read_stats& o) const noexcept {
+            return read_stats{
+                sstables_read - o.sstables_read,
+                sstable_bytes_read - o.sstable_bytes_read,
+                cache_row_hits - o.cache_row_hits,
+                cache_row_misses - o.cache_row_misses,
+            };
+        }
+    };
+
 private:
     shared_ptr<impl> _impl;
 
@@ -161,6 +180,22 @@ class reader_permit {
 
     query::max_result_size max_result_size() const;
     void set_max_result_size(query::max_result_size);
+
+    // The number of sstables the read was estimated to read from, see
+    // reader_concurrency_semaphore::read_cost.
+    unsigned estimated_io() const noexcept;
+
+    read_stats& get_read_stats() const noexcept;
+
+    // Allocate and free the storage of mutation fragments of the read.
+    //
+    // Freed blocks are kept for reuse by the read, up to
+    // max_free_fragment_blocks of them, and their memory is consumed from
+    // the permit until they are reused or the permit is destroyed. All
+    // blocks must be of the same size.
+    static constexpr size_t max_free_fragment_blocks = 128;
+    void* allocate_fragment(size_t size);
+    void free_fragment(void* p, size_t size) noexcept;
 };
 
 using reader_permit_opt = optimized_optional<reader_permit>;
@@ -212,6 +212,31 @@ flat_mutation_reader_v2 make_forwardable(flat_mutation_reader_v2 m) {
                 push_mutation_fragment(*_schema, _permit, range_tombstone_change(position_in_partition_view::after_key(_current.end()), {}));
             }
         }
+        // Returns false when _next is past the current range, which ends the stream.
+        bool consume_next() {
+            position_in_partition::tri_compare cmp(*_schema);
+            if (cmp(_next->position(), _current.end()) >= 0) {
+                maybe_emit_start_tombstone();
+                maybe_emit_end_tombstone();
+                _end_of_stream = true;
+                // keep _next, it may be relevant for next range
+                return false;
+            }
+            if (_next->relevant_for_range(*_schema, _current.start())) {
+                if (!_current_has_content && (!_next->is_range_tombstone_change() || cmp(_next->position(), _current.start()) != 0)) {
+                    maybe_emit_start_tombstone();
+                }
+                if (_next->is_range_tombstone_change()) {
+                    _active_tombstone = _next->as_range_tombstone_change().tombstone();
+                }
+                _current_has_content = true;
+                push_mutation_fragment(std::move(*_next));
+            } else if (_next->is_range_tombstone_change()) {
+                _active_tombstone = _next->as_range_tombstone_change().tombstone();
+            }
+            _next = {};
+            return true;
+        }
     public:
         reader(flat_mutation_reader_v2 r) : impl(r.schema(), r.permit()), _underlying(std::move(r)), _current({
             position_in_partition(position_in_partition::partition_start_tag_t()),
@@ -219,31 +244,25 @@ flat_mutation_reader_v2 make_forwardable(flat_mutation_reader_v2 m) {
         }) { }
         virtual future<> fill_buffer() override {
             while (!is_buffer_full()) {
-                co_await ensure_next();
-                if (is_end_of_stream()) {
-                    break;
-                }
-                position_in_partition::tri_compare cmp(*_schema);
-                if (cmp(_next->position(), _current.end()) >= 0) {
-                    maybe_emit_start_tombstone();
-                    maybe_emit_end_tombstone();
-                    _end_of_stream = true;
-                    // keep _next, it may be relevant for next range
-                    break;
+                if (!_next && _underlying.is_buffer_empty()) {
+                    co_await ensure_next();
+                    if (is_end_of_stream()) {
+                        break;
+                    }
                 }
-                if (_next->relevant_for_range(*_schema, _current.start())) {
-                    if (!_current_has_content && (!_next->is_range_tombstone_change() || cmp(_next->position(), _current.start()) != 0)) {
-                        maybe_emit_start_tombstone();
+                // Consume what the underlying reader has buffered in one go,
+                // instead of waiting for each fragment.
+                while (!is_buffer_full()) {
+                    if (!_next) {
+                        if (_underlying.is_buffer_empty()) {
+                            break;
+                        }
+                        _next = _underlying.pop_mutation_fragment();
                     }
-                    if (_next->is_range_tombstone_change()) {
-                        _active_tombstone = _next->as_range_tombstone_change().tombstone();
+                    if (!consume_next()) {
+                        co_return;
                     }
-                    _current_has_content = true;
-                    push_mutation_fragment(std::move(*_next));
-                } else if (_next->is_range_tombstone_change()) {
-                    _active_tombstone = _next->as_range_tombstone_change().tombstone();
                 }
-                _next = {};
             }
         }
         virtual future<> fast_forward_to(position_range pr) override {
@@ -639,9 +658,7 @@ class flat_multi_range_mutation_reader : public flat_mutation_reader_v2::impl {
     virtual future<> fill_buffer() override {
         return do_until([this] { return is_end_of_stream() || !is_buffer_empty(); }, [this] {
             return _reader.fill_buffer().then([this] () {
-                while (!_reader.is_buffer_empty()) {
-                    push_mutation_fragment(_reader.pop_mutation_fragment());
-                }
+                _reader.move_buffer_content_to(*this);
                 if (!_reader.is_end_of_stream()) {
                     return make_ready_future<>();
                 }
@@ -19,6 +19,8 @@
 #include "redis/lolwut.hh"
 #include "redis/keyspace_utils.hh"
 
+#include <boost/range/irange.hpp>
+
 namespace redis {
 
 namespace commands {
@@ -36,6 +38,24 @@ future<redis_message> get(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // The keys are in different partitions, so they are read in parallel.
+    return do_with(std::vector<std::optional<bytes>>(req.arguments_size()), [&proxy, &options, permit, &req] (std::vector<std::optional<bytes>>& results) {
+        return seastar::parallel_for_each(boost::irange<size_t>(0, req.arguments_size()), [&proxy, &options, permit, &req, &results] (size_t i) {
+            return redis::read_strings(proxy, options, req._args[i], permit).then([&results, i] (lw_shared_ptr<strings_result> result) {
+                if (result->has_result()) {
+                    results[i] = std::move(result->result());
+                }
+            });
+        }).then([&results] () {
+            return redis_message::make_strings_list_result(results);
+        });
+    });
+}
+
 future<redis_message> exists(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() < 1) {
         throw wrong_arguments_exception(1, req.arguments_size(), req._command);
@@ -109,6 +129,22 @@ future<redis_message> hget(service::storage_proxy& proxy, request& req, redis::r
     });
 }
 
+future<redis_message> hmget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto fields = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    return redis::read_hashes(proxy, options, req._args[0], fields, permit).then([fields] (auto result) {
+        std::vector<std::optional<bytes>> results;
+        results.reserve(fields.size());
+        for (auto& field : fields) {
+            auto it = result->find(field);
+            results.push_back(it != result->end() ? std::make_optional(it->second) : std::nullopt);
+        }
+        return redis_message::make_strings_list_result(results);
+    });
+}
+
 future<redis_message> hset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 3) {
         throw wrong_number_of_arguments_exception(req._command);
@@ -162,6 +198,20 @@ future<redis_message> set(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() == 0 || req.arguments_size() % 2 != 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    std::vector<std::pair<bytes, bytes>> key_values;
+    key_values.reserve(req.arguments_size() / 2);
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        key_values.emplace_back(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    return redis::write_strings(proxy, options, std::move(key_values), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
 future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 3) {
         throw wrong_arguments_exception(3, req.arguments_size(), req._command);
@@ -22,6 +22,8 @@ class redis_options;
 
 future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& field, bytes&& data, long ttl, service_permit permit);
 future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, bytes&& data, long ttl, service_permit permit);
+// Writes all the given key/value pairs with a single call to the storage proxy.
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& key_values, service_permit permit);
 future<> delete_objects(service::storage_proxy& proxy, redis::redis_options& options, std::vector<bytes>&& keys, service_permit permit);
 future<> delete_fields(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& fields, service_permit permit);
 
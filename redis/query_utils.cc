@@ -143,6 +143,28 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
 
+future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& fields, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
+    // The clustering ranges of a slice must be sorted and must not overlap.
+    std::vector<clustering_key> ckeys;
+    ckeys.reserve(fields.size());
+    for (auto& field : fields) {
+        ckeys.push_back(clustering_key::from_single_value(*schema, field));
+    }
+    std::sort(ckeys.begin(), ckeys.end(), clustering_key::less_compare(*schema));
+    ckeys.erase(std::unique(ckeys.begin(), ckeys.end(), clustering_key::equality(*schema)), ckeys.end());
+    std::vector<query::clustering_range> clustering_ranges;
+    clustering_ranges.reserve(ckeys.size());
+    for (auto& ckey : ckeys) {
+        clustering_ranges.push_back(query::clustering_range::make_singular(std::move(ckey)));
+    }
+
+    auto ps = partition_slice_builder(*schema)
+        .with_ranges(std::move(clustering_ranges))
+        .build();
+    return query_hashes(proxy, options, key, permit, schema, ps);
+}
+
 future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
     const auto max_result_size = proxy.get_max_result_size(ps);
     query::read_command cmd(schema->id(), schema->version(), ps, std::numeric_limits<uint32_t>::max(), gc_clock::now(), std::nullopt, 1, utils::UUID(), query::is_first_page::no, max_result_size, 0);
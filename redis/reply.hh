@@ -16,6 +16,9 @@
 #include "redis/exceptions.hh"
 #include "utils/fmt-compat.hh"
 
+#include <optional>
+#include <vector>
+
 namespace redis {
 
 class redis_message final {
@@ -68,6 +71,19 @@ class redis_message final {
         }
         return make_ready_future<redis_message>(m);
     }
+    // Replies with an array of bulk strings, with a nil for each missing one.
+    static seastar::future<redis_message> make_strings_list_result(std::vector<std::optional<bytes>>& results) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", results.size()));
+        for (auto& r : results) {
+            if (r) {
+                write_bytes(m, *r);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> make_strings_result(bytes result) {
         auto m = make_lw_shared<scattered_message<char>> ();
         write_bytes(m, result);
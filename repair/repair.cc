@@ -26,6 +26,7 @@
 #include "service/migration_manager.hh"
 #include "partition_range_compat.hh"
 #include "gms/feature_service.hh"
+#include "tombstone_gc.hh"
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/split.hpp>
@@ -312,10 +313,10 @@ tracker::tracker(size_t max_repair_memory)
     : _shutdown(false)
     , _range_parallelism_semaphore(std::max(size_t(1), size_t(max_repair_memory / max_repair_memory_per_range() / 4)),
             named_semaphore_exception_factory{"repair range parallelism"})
+    , _max_ranges_in_parallel(_range_parallelism_semaphore.available_units())
 {
-    auto nr = _range_parallelism_semaphore.available_units();
     rlogger.info("Setting max_repair_memory={}, max_repair_memory_per_range={}, max_repair_ranges_in_parallel={}",
-        max_repair_memory, max_repair_memory_per_range(), nr);
+        max_repair_memory, max_repair_memory_per_range(), _max_ranges_in_parallel);
 }
 
 void tracker::start(repair_uniq_id id) {
@@ -455,6 +456,22 @@ named_semaphore& tracker::range_parallelism_semaphore() {
     return _range_parallelism_semaphore;
 }
 
+size_t tracker::ranges_in_parallel() const {
+    // Units go negative when the limit is lowered below the number of running ranges
+    return _max_ranges_in_parallel - _range_parallelism_semaphore.available_units();
+}
+
+void tracker::set_max_ranges_in_parallel(size_t nr) {
+    nr = std::max(nr, size_t(1));
+    if (nr > _max_ranges_in_parallel) {
+        _range_parallelism_semaphore.signal(nr - _max_ranges_in_parallel);
+    } else {
+        _range_parallelism_semaphore.consume(_max_ranges_in_parallel - nr);
+    }
+    rlogger.info("Setting max_repair_ranges_in_parallel={}, was {}", nr, _max_ranges_in_parallel);
+    _max_ranges_in_parallel = nr;
+}
+
 future<> tracker::run(repair_uniq_id id, std::function<void ()> func) {
     return seastar::with_gate(_gate, [this, id, func =std::move(func)] {
         start(id);
@@ -583,6 +600,15 @@ repair_neighbors repair_info::get_repair_neighbors(const dht::token_range& range
         neighbors[range];
 }
 
+bool repair_info::repaired_recently(schema_ptr s, const dht::token_range& range) const {
+    auto window = std::chrono::seconds(db.local().get_config().repair_skip_ranges_repaired_within_seconds());
+    if (reason != streaming::stream_reason::repair || window.count() == 0) {
+        return false;
+    }
+    auto repair_time = get_repair_time_for_range(std::move(s), range);
+    return repair_time != gc_clock::time_point::min() && gc_clock::now() - repair_time < window;
+}
+
 // Repair a single local range, multiple column families.
 // Comparable to RepairSession in Origin
 future<> repair_info::repair_range(const dht::token_range& range) {
@@ -625,16 +651,22 @@ future<> repair_info::repair_range(const dht::token_range& range) {
             id.uuid, ranges_index, ranges.size(), shard, keyspace, table_names(), range, neighbors, live_neighbors);
       return mm.sync_schema(db.local(), neighbors).then([this, &neighbors, range] {
         return do_for_each(table_ids.begin(), table_ids.end(), [this, &neighbors, range] (utils::UUID table_id) {
-            sstring cf;
+            schema_ptr s;
             try {
-                cf = db.local().find_column_family(table_id).schema()->cf_name();
+                s = db.local().find_column_family(table_id).schema();
             } catch (replica::no_such_column_family&) {
                 return make_ready_future<>();
             }
+            sstring cf = s->cf_name();
             // Row level repair
             if (dropped_tables.contains(cf)) {
                 return make_ready_future<>();
             }
+            if (repaired_recently(s, range)) {
+                rlogger.debug("repair[{}]: Skipped keyspace={}, table={}, range={}, repaired less than {}s ago",
+                        id.uuid, keyspace, cf, range, db.local().get_config().repair_skip_ranges_repaired_within_seconds());
+                return make_ready_future<>();
+            }
             return repair_cf_range_row_level(*this, cf, table_id, range, neighbors).handle_exception_type([this, cf] (replica::no_such_column_family&) mutable {
                 dropped_tables.insert(cf);
                 return make_ready_future<>();
@@ -1208,6 +1240,27 @@ future<> repair_service::shutdown() {
     co_await remove_repair_meta();
 }
 
+future<repair_parallelism> repair_service::get_parallelism() {
+    return container().map_reduce0([] (repair_service& rs) {
+        return repair_parallelism{
+            .max_ranges_in_parallel = rs.repair_tracker().max_ranges_in_parallel(),
+            .ranges_in_parallel = rs.repair_tracker().ranges_in_parallel(),
+            .finished_ranges = rs.get_metrics().repair_finished_ranges_sum,
+        };
+    }, repair_parallelism{}, [] (repair_parallelism a, const repair_parallelism& b) {
+        a.max_ranges_in_parallel += b.max_ranges_in_parallel;
+        a.ranges_in_parallel += b.ranges_in_parallel;
+        a.finished_ranges += b.finished_ranges;
+        return a;
+    });
+}
+
+future<> repair_service::set_max_ranges_in_parallel(size_t nr) {
+    return container().invoke_on_all([nr] (repair_service& rs) {
+        rs.repair_tracker().set_max_ranges_in_parallel(nr);
+    });
+}
+
 future<> repair_service::abort_all() {
     return container().invoke_on_all([] (repair_service& rs) {
         return rs.repair_tracker().abort_all_repairs();
@@ -201,6 +201,11 @@ class repair_info {
     }
 
     future<> repair_range(const dht::token_range& range);
+
+private:
+    // True if this is a regular repair and all replicas of the range were
+    // repaired within repair_skip_ranges_repaired_within_seconds.
+    bool repaired_recently(schema_ptr s, const dht::token_range& range) const;
 };
 
 // The repair_tracker tracks ongoing repair operations and their progress.
@@ -229,6 +234,9 @@ class tracker {
     // The semaphore used to control the maximum
     // ranges that can be repaired in parallel.
     named_semaphore _range_parallelism_semaphore;
+    // The number of units _range_parallelism_semaphore was given. Can be
+    // changed at runtime with set_max_ranges_in_parallel().
+    size_t _max_ranges_in_parallel;
     static constexpr size_t _max_repair_memory_per_range = 32 * 1024 * 1024;
     seastar::condition_variable _done_cond;
     void start(repair_uniq_id id);
@@ -246,6 +254,12 @@ class tracker {
     size_t nr_running_repair_jobs();
     void abort_all_repairs();
     named_semaphore& range_parallelism_semaphore();
+    size_t max_ranges_in_parallel() const { return _max_ranges_in_parallel; }
+    // The number of ranges being repaired on this shard
+    size_t ranges_in_parallel() const;
+    // Ranges already being repaired are not stopped when the limit is lowered,
+    // new ones wait until the number of running ranges drops below it.
+    void set_max_ranges_in_parallel(size_t nr);
     static size_t max_repair_memory_per_range() { return _max_repair_memory_per_range; }
     future<> run(repair_uniq_id id, std::function<void ()> func);
     future<repair_status> repair_await_completion(int id, std::chrono::steady_clock::time_point timeout);
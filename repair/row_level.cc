@@ -3028,8 +3028,16 @@ future<> repair_service::load_history() {
         }
         rlogger.info("Loading repair history for keyspace={}, table={}, table_uuid={}",
                 table->schema()->ks_name(), table->schema()->cf_name(), table_uuid);
+        struct history_entry {
+            db_clock::time_point repair_time;
+            utils::UUID repair_uuid;
+            int64_t range_start;
+            int64_t range_end;
+            dht::token_range range;
+        };
+        std::vector<history_entry> entries;
         auto req = format("SELECT * from system.{} WHERE table_uuid = {}", db::system_keyspace::REPAIR_HISTORY, table_uuid);
-        co_await db::qctx->qp().query_internal(req, [this] (const cql3::untyped_result_set::row& row) mutable -> future<stop_iteration> {
+        co_await db::qctx->qp().query_internal(req, [this, &entries] (const cql3::untyped_result_set::row& row) mutable -> future<stop_iteration> {
             auto table_uuid = row.get_as<utils::UUID>("table_uuid");
             auto range_start = row.get_as<int64_t>("range_start");
             auto range_end = row.get_as<int64_t>("range_end");
@@ -3041,6 +3049,8 @@ future<> repair_service::load_history() {
             auto range = dht::token_range(dht::token_range::bound(start, false), dht::token_range::bound(end, true));
             rlogger.debug("Loading repair history for keyspace={}, table={}, table_uuid={}, repair_time={}, range={}",
                     keyspace_name, table_name, table_uuid, repair_time, range);
+            entries.push_back(history_entry{row.get_as<db_clock::time_point>("repair_time"), row.get_as<utils::UUID>("repair_uuid"),
+                    range_start, range_end, range});
             co_await get_db().invoke_on_all([table_uuid, range, repair_time, keyspace_name, table_name] (replica::database& local_db) -> future<> {
                 try {
                     auto& table = local_db.find_column_family(table_uuid);
@@ -3055,6 +3065,24 @@ future<> repair_service::load_history() {
             });
             co_return stop_iteration::no;
         });
+
+        // Every repair adds rows, which would otherwise be kept, and loaded
+        // at every start, forever. A row whose whole range was repaired again
+        // later no longer contributes to the history, delete it.
+        size_t pruned = 0;
+        auto delete_cql = format("DELETE FROM system.{} WHERE table_uuid = ? AND repair_time = ? AND repair_uuid = ? AND range_start = ? AND range_end = ?",
+                db::system_keyspace::REPAIR_HISTORY);
+        for (const auto& e : entries) {
+            if (get_repair_time_for_range(table->schema(), e.range) <= to_gc_clock(e.repair_time)) {
+                continue;
+            }
+            co_await db::qctx->execute_cql(delete_cql, table_uuid, e.repair_time, e.repair_uuid, e.range_start, e.range_end).discard_result();
+            ++pruned;
+        }
+        if (pruned) {
+            rlogger.info("Pruned {} of {} superseded repair history entries for keyspace={}, table={}",
+                    pruned, entries.size(), table->schema()->ks_name(), table->schema()->cf_name());
+        }
     }
     co_return;
 }
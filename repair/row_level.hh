@@ -75,6 +75,15 @@ class node_ops_metrics {
     float repair_finished_percentage();
 };
 
+struct repair_parallelism {
+    // The maximum number of ranges that can be repaired in parallel
+    size_t max_ranges_in_parallel = 0;
+    // The number of ranges being repaired
+    size_t ranges_in_parallel = 0;
+    // The number of ranges repaired since the node started
+    uint64_t finished_ranges = 0;
+};
+
 class repair_service : public seastar::peering_sharded_service<repair_service> {
     distributed<gms::gossiper>& _gossiper;
     netw::messaging_service& _messaging;
@@ -189,6 +198,12 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     // It blocks if the repair job is still RUNNING until timeout.
     future<repair_status> await_completion(int id, std::chrono::steady_clock::time_point timeout);
 
+    // returns the range parallelism of repair, summed over all shards
+    future<repair_parallelism> get_parallelism();
+
+    // sets the number of ranges each shard can repair in parallel
+    future<> set_max_ranges_in_parallel(size_t nr);
+
     // Abort all the repairs
     future<> abort_all();
 
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "replica/counter_shard_cache.hh"
+#include "frozen_mutation.hh"
+#include "mutation_partition_view.hh"
+#include "range_tombstone.hh"
+#include "utils/hash.hh"
+
+namespace replica {
+
+size_t counter_shard_cache::entry_key_hash::operator()(const entry_key& k) const noexcept {
+    return utils::hash_combine(std::hash<utils::UUID>()(k.table_id), std::hash<dht::token>()(k.key->token()));
+}
+
+bool counter_shard_cache::entry_key_equal::operator()(const entry_key& a, const entry_key& b) const noexcept {
+    return a.table_id == b.table_id && a.key->token() == b.key->token()
+            && a.key->key().representation() == b.key->key().representation();
+}
+
+// Whether every live cell of the update has a live cell in the cached row.
+static bool covers(const schema& s, column_kind kind, const row& cached, const row& update) {
+    bool ret = true;
+    update.for_each_cell_until([&] (column_id id, const atomic_cell_or_collection& ac_o_c) {
+        auto& cdef = s.column_at(kind, id);
+        if (ac_o_c.as_atomic_cell(cdef).is_live()) {
+            auto c = cached.find_cell(id);
+            ret = c && c->as_atomic_cell(cdef).is_live();
+        }
+        return stop_iteration(!ret);
+    });
+    return ret;
+}
+
+static bool covers(const mutation& cached, const mutation& update) {
+    if (cached.schema()->version() != update.schema()->version()) {
+        return false;
+    }
+    auto& s = *update.schema();
+    if (!covers(s, column_kind::static_column, cached.partition().static_row().get(), update.partition().static_row().get())) {
+        return false;
+    }
+    for (auto& cr : update.partition().clustered_rows()) {
+        auto r = cached.partition().find_row(s, cr.key());
+        if (!r || !covers(s, column_kind::regular_column, *r, cr.row().cells())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void counter_shard_cache::erase(lru_list::iterator it) noexcept {
+    _entries.erase(entry_key{it->table_id, &it->shards.decorated_key()});
+    _memory_used -= it->memory_usage;
+    _lru.erase(it);
+}
+
+mutation_opt counter_shard_cache::get(const utils::UUID& table_id, const mutation& update) {
+    if (!enabled()) {
+        return {};
+    }
+    auto it = _entries.find(entry_key{table_id, &update.decorated_key()});
+    if (it == _entries.end() || !covers(it->second->shards, update)) {
+        ++_stats.misses;
+        return {};
+    }
+    ++_stats.hits;
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return it->second->shards;
+}
+
+void counter_shard_cache::do_update(const utils::UUID& table_id, const mutation& shards) {
+    auto memory_usage = [] (const entry& e) {
+        auto& m = e.shards;
+        return sizeof(entry) + sizeof(mutation_partition) + m.key().representation().size()
+                + m.partition().external_memory_usage(*m.schema());
+    };
+
+    auto it = _entries.find(entry_key{table_id, &shards.decorated_key()});
+    if (it != _entries.end() && it->second->shards.schema()->version() != shards.schema()->version()) {
+        erase(it->second);
+        it = _entries.end();
+    }
+    if (it != _entries.end()) {
+        auto& e = *it->second;
+        e.shards.apply(shards);
+        _memory_used -= e.memory_usage;
+        e.memory_usage = memory_usage(e);
+        _memory_used += e.memory_usage;
+        _lru.splice(_lru.begin(), _lru, it->second);
+    } else {
+        _lru.emplace_front(table_id, shards);
+        auto& e = _lru.front();
+        try {
+            _entries.emplace(entry_key{table_id, &e.shards.decorated_key()}, _lru.begin());
+        } catch (...) {
+            _lru.pop_front();
+            throw;
+        }
+        e.memory_usage = memory_usage(e);
+        _memory_used += e.memory_usage;
+    }
+
+    while (_memory_used > _max_memory && !_lru.empty()) {
+        erase(std::prev(_lru.end()));
+        ++_stats.evictions;
+    }
+}
+
+void counter_shard_cache::update(const utils::UUID& table_id, const mutation& shards, uint64_t generation) noexcept {
+    if (!enabled() || generation != _generation) {
+        return;
+    }
+    try {
+        do_update(table_id, shards);
+    } catch (...) {
+        // The cache is only an optimization, an entry which failed to be
+        // updated is dropped instead.
+        if (auto it = _entries.find(entry_key{table_id, &shards.decorated_key()}); it != _entries.end()) {
+            erase(it->second);
+        }
+    }
+}
+
+namespace {
+
+class tombstone_finder final : public mutation_partition_view_virtual_visitor {
+    bool _found = false;
+public:
+    bool found() const { return _found; }
+    virtual void accept_partition_tombstone(tombstone t) override { _found |= bool(t); }
+    virtual void accept_static_cell(column_id, atomic_cell ac) override { _found |= !ac.is_live(); }
+    virtual void accept_static_cell(column_id, collection_mutation_view) override { }
+    virtual void accept_row_tombstone(range_tombstone) override { _found = true; }
+    virtual void accept_row(position_in_partition_view, row_tombstone rt, row_marker, is_dummy, is_continuous) override { _found |= bool(rt); }
+    virtual void accept_row_cell(column_id, atomic_cell ac) override { _found |= !ac.is_live(); }
+    virtual void accept_row_cell(column_id, collection_mutation_view) override { }
+};
+
+}
+
+void counter_shard_cache::invalidate(const utils::UUID& table_id, const frozen_mutation& m, const schema& s) {
+    if (!enabled()) {
+        return;
+    }
+    tombstone_finder finder;
+    m.partition().accept(s.get_column_mapping(), finder);
+    if (!finder.found()) {
+        return;
+    }
+    ++_generation;
+    auto dk = m.decorated_key(s);
+    if (auto it = _entries.find(entry_key{table_id, &dk}); it != _entries.end()) {
+        erase(it->second);
+        ++_stats.invalidations;
+    }
+}
+
+void counter_shard_cache::invalidate(const utils::UUID& table_id) noexcept {
+    ++_generation;
+    for (auto it = _lru.begin(); it != _lru.end();) {
+        auto next = std::next(it);
+        if (it->table_id == table_id) {
+            erase(it);
+            ++_stats.invalidations;
+        }
+        it = next;
+    }
+}
+
+} // namespace replica
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include "mutation.hh"
+#include "utils/UUID.hh"
+
+class frozen_mutation;
+
+namespace replica {
+
+// Caches the local shards, the (logical clock, value) pairs, of the counter
+// cells recently updated on this shard, so that the counter updates which
+// find all their cells in it can skip the read before write.
+//
+// The cached shards are the ones written by the counter updates, which are
+// what the read would find as long as nothing else touched the cells. Only
+// this node writes its own shards, so the writes which can make the cache
+// stale are the tombstones, dropped here when they are applied to memtables,
+// and the table-wide changes like truncation, schema changes and sstables
+// added by streaming, which drop the whole table.
+//
+// Entries are evicted in LRU order once the cache grows over its memory
+// limit. A limit of zero disables the cache.
+class counter_shard_cache {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t invalidations = 0;
+        uint64_t evictions = 0;
+    };
+private:
+    struct entry {
+        utils::UUID table_id;
+        mutation shards;
+        size_t memory_usage = 0;
+
+        entry(utils::UUID table_id, mutation shards)
+            : table_id(table_id), shards(std::move(shards)) { }
+    };
+    using lru_list = std::list<entry>;
+
+    struct entry_key {
+        utils::UUID table_id;
+        const dht::decorated_key* key;
+    };
+    struct entry_key_hash {
+        size_t operator()(const entry_key& k) const noexcept;
+    };
+    struct entry_key_equal {
+        bool operator()(const entry_key& a, const entry_key& b) const noexcept;
+    };
+
+    size_t _max_memory;
+    size_t _memory_used = 0;
+    // Bumped on every invalidation, so that updates which read the counters
+    // before it don't put what they read back into the cache.
+    uint64_t _generation = 0;
+    lru_list _lru;
+    std::unordered_map<entry_key, lru_list::iterator, entry_key_hash, entry_key_equal> _entries;
+    stats _stats;
+private:
+    void erase(lru_list::iterator it) noexcept;
+    void do_update(const utils::UUID& table_id, const mutation& shards);
+public:
+    explicit counter_shard_cache(size_t max_memory) : _max_memory(max_memory) { }
+    counter_shard_cache(const counter_shard_cache&) = delete;
+
+    bool enabled() const noexcept { return _max_memory != 0; }
+    uint64_t generation() const noexcept { return _generation; }
+
+    // Returns the cached local shards of the partition of the counter update,
+    // if there is one for every live cell of the update.
+    mutation_opt get(const utils::UUID& table_id, const mutation& update);
+
+    // Merges the local shards written by a counter update into the cache,
+    // unless the cache was invalidated since the given generation() was taken.
+    void update(const utils::UUID& table_id, const mutation& shards, uint64_t generation) noexcept;
+
+    // Called for the writes applied to counter tables other than the counter
+    // updates of this node, drops the partition if the write deletes anything.
+    void invalidate(const utils::UUID& table_id, const frozen_mutation& m, const schema& s);
+
+    void invalidate(const utils::UUID& table_id) noexcept;
+
+    size_t memory_used() const noexcept { return _memory_used; }
+    const stats& get_stats() const noexcept { return _stats; }
+};
+
+} // namespace replica
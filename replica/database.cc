@@ -32,8 +32,10 @@
 #include <boost/container/static_vector.hpp>
 #include "frozen_mutation.hh"
 #include <seastar/core/do_with.hh>
+#include <seastar/core/sleep.hh>
 #include "service/migration_listener.hh"
 #include "cell_locking.hh"
+#include "replica/counter_shard_cache.hh"
 #include "view_info.hh"
 #include "db/schema_tables.hh"
 #include "compaction/compaction_manager.hh"
@@ -42,6 +44,7 @@
 #include "service/storage_proxy.hh"
 
 #include "utils/human_readable.hh"
+#include "utils/histogram_metrics_helper.hh"
 #include "utils/fb_utilities.hh"
 #include "utils/stall_free.hh"
 #include "utils/fmt-compat.hh"
@@ -60,6 +63,7 @@
 
 #include "data_dictionary/impl.hh"
 #include "readers/multi_range.hh"
+#include "utils/stall_activity.hh"
 
 using namespace std::chrono_literals;
 using namespace db;
@@ -96,7 +100,8 @@ make_compaction_manager(const db::config& cfg, database_config& dbcfg, abort_sou
             compaction_manager::compaction_scheduling_group{dbcfg.compaction_scheduling_group, service::get_local_compaction_priority()},
             compaction_manager::maintenance_scheduling_group{dbcfg.streaming_scheduling_group, service::get_local_streaming_priority()},
             dbcfg.available_memory,
-            as);
+            as,
+            utils::updateable_value<uint32_t>(cfg.compaction_read_latency_slo_in_ms));
 }
 
 keyspace::keyspace(lw_shared_ptr<keyspace_metadata> metadata, config cfg, locator::effective_replication_map_factory& erm_factory)
@@ -302,10 +307,11 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
         abort_source& as, sharded<semaphore>& sst_dir_sem, utils::cross_shard_barrier barrier)
     : _stats(make_lw_shared<db_stats>())
     , _cl_stats(std::make_unique<cell_locker_stats>())
+    , _counter_shard_cache(std::make_unique<counter_shard_cache>(size_t(cfg.counter_cache_size_in_mb()) * 1024 * 1024 / smp::count))
     , _cfg(cfg)
     // Allow system tables a pool of 10 MB memory to write, but never block on other regions.
-    , _system_dirty_memory_manager(*this, 10 << 20, cfg.virtual_dirty_soft_limit(), default_scheduling_group())
-    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.virtual_dirty_soft_limit(), dbcfg.statement_scheduling_group)
+    , _system_dirty_memory_manager(*this, 10 << 20, cfg.virtual_dirty_soft_limit(), 0, default_scheduling_group())
+    , _dirty_memory_manager(*this, dbcfg.available_memory * 0.50, cfg.virtual_dirty_soft_limit(), cfg.virtual_dirty_throttle_limit(), dbcfg.statement_scheduling_group)
     , _dbcfg(dbcfg)
     , _memtable_controller(make_flush_controller(_cfg, dbcfg.memtable_scheduling_group, service::get_local_memtable_flush_priority(), [this, limit = float(_dirty_memory_manager.throttle_threshold())] {
         auto backlog = (_dirty_memory_manager.virtual_dirty_memory()) / limit;
@@ -357,6 +363,12 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     assert(dbcfg.available_memory != 0); // Detect misconfigured unit tests, see #7544
 
     local_schema_registry().init(*this); // TODO: we're never unbound.
+    _read_concurrency_sem.set_cheap_read_io_threshold(_cfg.cheap_read_sstables_threshold());
+    // Leave at least half of the memory of user reads to active reads.
+    _querier_cache.set_max_memory_usage(max_memory_concurrent_reads() / 2);
+    if (auto period = _cfg.hot_partitions_sample_period()) {
+        _hot_partitions_tracker = std::make_unique<db::hot_partitions_tracker>(*this, period);
+    }
     setup_metrics();
 
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
@@ -422,6 +434,43 @@ void backlog_controller::update_controller(float shares) {
     _inflight_update = _io_priority.update_shares(uint32_t(shares));
 }
 
+void compaction_controller::update_controller(float shares) {
+    if (_latency_feedback.read_latency_slo) {
+        update_latency_factor();
+        shares = std::min(shares * _latency_factor, _control_points.back().output);
+    }
+    _last_shares = shares;
+    backlog_controller::update_controller(shares);
+}
+
+void compaction_controller::update_latency_factor() {
+    auto slo = _latency_feedback.read_latency_slo();
+    if (slo.count() == 0) {
+        _latency_factor = 1.0;
+        return;
+    }
+    auto current = _latency_feedback.read_latency();
+    auto window = current;
+    window.subtract(_last_read_latency);
+    auto samples = window.count();
+    if (samples && samples < min_latency_samples) {
+        // Wait for more reads, one p99 out of a handful of them is noise.
+        return;
+    }
+    _last_read_latency = std::move(current);
+    if (!samples) {
+        _last_read_latency_p99 = std::chrono::microseconds(0);
+        _latency_factor = std::min(max_latency_factor, _latency_factor + latency_factor_increase);
+        return;
+    }
+    _last_read_latency_p99 = std::chrono::microseconds(window.quantile(0.99));
+    if (_last_read_latency_p99 > slo) {
+        _latency_factor = std::max(min_latency_factor, _latency_factor * latency_factor_decrease);
+    } else if (_last_read_latency_p99 < slo * 4 / 5) {
+        _latency_factor = std::min(max_latency_factor, _latency_factor + latency_factor_increase);
+    }
+}
+
 void
 dirty_memory_manager::setup_collectd(sstring namestr) {
     namespace sm = seastar::metrics;
@@ -434,6 +483,15 @@ dirty_memory_manager::setup_collectd(sstring namestr) {
 
         sm::make_gauge(namestr +"_virtual_dirty_bytes", [this] { return virtual_dirty_memory(); },
                        sm::description("Holds the size of used memory in bytes. Compare it to \"dirty_bytes\" to see how many memory is wasted (neither used nor available).")),
+
+        sm::make_gauge(namestr + "_flush_bandwidth", [this] { return flush_bandwidth(); },
+                       sm::description("Holds the measured rate, in bytes per second, at which memtables are flushed. Only measured when write throttling is enabled.")),
+
+        sm::make_counter(namestr + "_throttled_writes", [this] { return _throttled_writes; },
+                       sm::description("Counts writes delayed because virtual dirty memory is above the throttle limit.")),
+
+        sm::make_histogram(namestr + "_write_throttle_delay", sm::description("Histogram of the delays of writes throttled because virtual dirty memory is above the throttle limit."),
+                       [this] { return to_metrics_histogram(_write_throttle_delays); }),
     });
 }
 
@@ -499,6 +557,9 @@ database::setup_metrics() {
                        sm::description("Counts sstables that survived the clustering key filtering. "
                                        "High value indicates that bloom filter is not very efficient and still have to access a lot of sstables to get data.")),
 
+        sm::make_derive("timestamp_ordered_reads_skipped_sstables", _cf_stats.sstables_skipped_by_timestamp,
+                       sm::description("Counts sstables which single-row reads did not read because the data from newer sstables shadowed them.")),
+
         sm::make_derive("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
@@ -543,7 +604,13 @@ database::setup_metrics() {
                        sm::description("Counts querier cache lookups that failed to find a cached querier")),
 
         sm::make_derive("querier_cache_drops", _querier_cache.get_stats().drops,
-                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to position mismatch")),
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to position or schema version mismatch")),
+
+        sm::make_derive("querier_cache_schema_version_drops", _querier_cache.get_stats().schema_version_drops,
+                       sm::description("Counts querier cache lookups that found a cached querier but had to drop it due to schema version mismatch")),
+
+        sm::make_derive("querier_cache_memory_based_drops", _querier_cache.get_stats().memory_based_drops,
+                       sm::description("Counts queriers that were not cached because the memory used by the querier cache would go above its limit")),
 
         sm::make_derive("querier_cache_time_based_evictions", _querier_cache.get_stats().time_based_evictions,
                        sm::description("Counts querier cache entries that timed out and were evicted.")),
@@ -552,9 +619,16 @@ database::setup_metrics() {
                        sm::description("Counts querier cache entries that were evicted to free up resources "
                                        "(limited by reader concurency limits) necessary to create new readers.")),
 
+        sm::make_derive("querier_cache_resource_based_eviction_cost", _querier_cache.get_stats().resource_based_eviction_cost,
+                       sm::description("Sums the estimated cost, in bytes read, of resuming the querier cache entries evicted to free up resources. "
+                                       "The entries cheapest to resume are evicted first.")),
+
         sm::make_gauge("querier_cache_population", _querier_cache.get_stats().population,
                        sm::description("The number of entries currently in the querier cache.")),
 
+        sm::make_current_bytes("querier_cache_memory_usage", _querier_cache.get_stats().memory_usage,
+                       sm::description("The memory used by the entries currently in the querier cache.")),
+
         sm::make_derive("sstable_read_queue_overloads", _read_concurrency_sem.get_stats().total_reads_shed_due_to_overload,
                        sm::description("Counts the number of times the sstable read queue was overloaded. "
                                        "A non-zero value indicates that we have to drop read requests because they arrive faster than we can serve them.")),
@@ -577,6 +651,19 @@ database::setup_metrics() {
                        sm::description("Holds the number of currently queued read operations."),
                        {user_label_instance}),
 
+        sm::make_gauge("queued_cheap_reads", [this] { return _read_concurrency_sem.cheap_waiters(); },
+                       sm::description("Holds the number of currently queued read operations estimated to be cheap, included in queued_reads."),
+                       {user_label_instance}),
+
+        sm::make_histogram("reads_admission_wait_time", sm::description("Histogram of the time queued read operations waited for admission."),
+                       {user_label_instance},
+                       [this] { return to_metrics_histogram(_read_concurrency_sem.get_stats().admission_wait_time); }),
+
+        sm::make_derive("cheap_reads_admitted", _read_concurrency_sem.get_stats().cheap_reads_admitted,
+                       sm::description("Counts the read operations estimated to be cheap which were admitted. "
+                                       "Such reads are admitted ahead of the other queued reads, see cheap_read_sstables_threshold."),
+                       {user_label_instance}),
+
         sm::make_gauge("paused_reads", _read_concurrency_sem.get_stats().inactive_reads,
                        sm::description("The number of currently active reads that are temporarily paused."),
                        {user_label_instance}),
@@ -636,6 +723,10 @@ database::setup_metrics() {
                        sm::description("Holds the number of currently queued read operations from \"system\" keyspace tables."),
                        {system_label_instance}),
 
+        sm::make_histogram("reads_admission_wait_time", sm::description("Histogram of the time queued read operations from \"system\" keyspace tables waited for admission."),
+                       {system_label_instance},
+                       [this] { return to_metrics_histogram(_system_read_concurrency_sem.get_stats().admission_wait_time); }),
+
         sm::make_gauge("paused_reads", _system_read_concurrency_sem.get_stats().inactive_reads,
                        sm::description("The number of currently ongoing system reads that are temporarily paused."),
                        {system_label_instance}),
@@ -678,10 +769,32 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_counter("counter_shard_cache_hits", [this] { return _counter_shard_cache->get_stats().hits; },
+                       sm::description("The number of counter updates which found the local shards of their cells in the counter shard cache and skipped the read before write.")),
+
+        sm::make_counter("counter_shard_cache_misses", [this] { return _counter_shard_cache->get_stats().misses; },
+                       sm::description("The number of counter updates which didn't find the local shards of all their cells in the counter shard cache.")),
+
+        sm::make_counter("counter_shard_cache_invalidations", [this] { return _counter_shard_cache->get_stats().invalidations; },
+                       sm::description("The number of counter shard cache entries dropped by deletions, truncations, schema changes and streamed sstables.")),
+
+        sm::make_counter("counter_shard_cache_evictions", [this] { return _counter_shard_cache->get_stats().evictions; },
+                       sm::description("The number of counter shard cache entries evicted to keep the cache within counter_cache_size_in_mb.")),
+
+        sm::make_gauge("counter_shard_cache_bytes", [this] { return _counter_shard_cache->memory_used(); },
+                       sm::description("Holds the memory used by the counter shard cache.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
 
+        sm::make_counter("large_data_records_dropped", [this] { return _large_data_handler->stats().records_dropped; },
+            sm::description("Number of large partitions, rows and cells which were not recorded in the system.large_* tables "
+                "because too many records were waiting to be written.")),
+
+        sm::make_queue_length("large_data_records_queued", [this] { return _large_data_handler->queued_records(); },
+            sm::description("Number of large partition, row and cell records waiting to be written to the system.large_* tables.")),
+
         sm::make_total_operations("total_view_updates_pushed_local", _cf_stats.total_view_updates_pushed_local,
                 sm::description("Total number of view updates generated for tables and applied locally.")),
 
@@ -694,6 +807,21 @@ database::setup_metrics() {
         sm::make_total_operations("total_view_updates_failed_remote", _cf_stats.total_view_updates_failed_remote,
                 sm::description("Total number of view updates generated for tables and failed to be sent to remote replicas.")),
     });
+    static const metrics::label activity_label("activity");
+    // Nothing is attributed to stall_activity::none.
+    for (size_t i = 1; i < size_t(utils::stall_activity::count); ++i) {
+        auto activity = utils::stall_activity(i);
+        _metrics.add_group("reactor_stalls", {
+            sm::make_derive("count", [activity] { return utils::get_stall_activity_stats(activity).stalls; },
+                    sm::description("Number of reactor stalls attributed to the activity, which ran for at least blocked_reactor_notify_ms without yielding."),
+                    {activity_label(sstring(utils::to_string(activity)))}),
+            sm::make_derive("time_us", [activity] {
+                        return std::chrono::duration_cast<std::chrono::microseconds>(utils::get_stall_activity_stats(activity).stall_time).count();
+                    },
+                    sm::description("Total duration in microseconds of the reactor stalls attributed to the activity."),
+                    {activity_label(sstring(utils::to_string(activity)))}),
+        });
+    }
     if (this_shard_id() == 0) {
         _metrics.add_group("database", {
                 sm::make_derive("schema_changed", _schema_change_count,
@@ -1109,10 +1237,12 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_cache = _config.enable_cache;
     cfg.enable_dangerous_direct_import_of_cassandra_counters = _config.enable_dangerous_direct_import_of_cassandra_counters;
     cfg.compaction_enforce_min_threshold = _config.compaction_enforce_min_threshold;
+    cfg.compaction_split_unpurgeable_tombstones = _config.compaction_split_unpurgeable_tombstones;
     cfg.dirty_memory_manager = _config.dirty_memory_manager;
     cfg.streaming_read_concurrency_semaphore = _config.streaming_read_concurrency_semaphore;
     cfg.compaction_concurrency_semaphore = _config.compaction_concurrency_semaphore;
     cfg.cf_stats = _config.cf_stats;
+    cfg.counter_shard_cache = s.is_counter() ? _config.counter_shard_cache : nullptr;
     cfg.enable_incremental_backups = _config.enable_incremental_backups;
     cfg.compaction_scheduling_group = _config.compaction_scheduling_group;
     cfg.memory_compaction_scheduling_group = _config.memory_compaction_scheduling_group;
@@ -1123,6 +1253,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
     cfg.enable_optimized_reversed_reads = db_config.enable_optimized_reversed_reads;
+    cfg.enable_timestamp_ordered_reads = db_config.enable_timestamp_ordered_reads;
+    cfg.memtable_flush_parallelism = db_config.memtable_flush_parallelism;
 
     // avoid self-reporting
     if (is_system_table(s)) {
@@ -1278,6 +1410,11 @@ database::existing_index_names(const sstring& ks_name, const sstring& cf_to_excl
     return names;
 }
 
+static void trace_read_stats(const tracing::trace_state_ptr& trace_state, const reader_permit::read_stats& stats) {
+    tracing::trace(trace_state, "Read {} sstables ({} bytes), {} rows from cache, {} rows missed in cache",
+            stats.sstables_read, stats.sstable_bytes_read, stats.cache_row_hits, stats.cache_row_misses);
+}
+
 future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
 database::query(schema_ptr s, const query::read_command& cmd, query::result_options opts, const dht::partition_range_vector& ranges,
                 tracing::trace_state_ptr trace_state, db::timeout_clock::time_point timeout) {
@@ -1296,14 +1433,17 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
 
     if (cmd.query_uuid != utils::UUID{} && !cmd.is_first_page) {
         querier_opt = _querier_cache.lookup_data_querier(cmd.query_uuid, *s, ranges.front(), cmd.slice, trace_state, timeout);
+        ++(querier_opt ? cf.get_stats().querier_cache_hits : cf.get_stats().querier_cache_misses);
     }
 
     auto read_func = [&, this] (reader_permit permit) {
         reader_permit::used_guard ug{permit};
         permit.set_max_result_size(max_result_size);
-        return cf.query(std::move(s), std::move(permit), cmd, opts, ranges, trace_state, get_result_memory_limiter(),
-                timeout, &querier_opt).then([&result, ug = std::move(ug)] (lw_shared_ptr<query::result> res) {
+        auto stats = permit.get_read_stats();
+        return cf.query(std::move(s), permit, cmd, opts, ranges, trace_state, get_result_memory_limiter(),
+                timeout, &querier_opt).then([&result, &trace_state, permit, stats, ug = std::move(ug)] (lw_shared_ptr<query::result> res) {
             result = std::move(res);
+            trace_read_stats(trace_state, permit.get_read_stats() - stats);
         });
     };
 
@@ -1313,7 +1453,7 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         if (querier_opt) {
             co_await semaphore.with_ready_permit(querier_opt->permit(), read_func);
         } else {
-            co_await semaphore.with_permit(s.get(), "data-query", cf.estimate_read_memory_cost(), timeout, read_func);
+            co_await semaphore.with_permit(s.get(), "data-query", cf.estimate_read_cost(ranges, cmd.slice), timeout, read_func);
         }
 
         if (cmd.query_uuid != utils::UUID{} && querier_opt) {
@@ -1334,6 +1474,7 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
     auto hit_rate = cf.get_global_cache_hit_rate();
     ++semaphore.get_stats().total_successful_reads;
     _stats->short_data_queries += bool(result->is_short_read());
+    cf.get_stats().short_data_reads += bool(result->is_short_read());
     co_return std::tuple(std::move(result), hit_rate);
 }
 
@@ -1357,14 +1498,17 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
 
     if (cmd.query_uuid != utils::UUID{} && !cmd.is_first_page) {
         querier_opt = _querier_cache.lookup_mutation_querier(cmd.query_uuid, *s, range, cmd.slice, trace_state, timeout);
+        ++(querier_opt ? cf.get_stats().querier_cache_hits : cf.get_stats().querier_cache_misses);
     }
 
     auto read_func = [&, this] (reader_permit permit) {
         reader_permit::used_guard ug{permit};
         permit.set_max_result_size(max_result_size);
-        return cf.mutation_query(std::move(s), std::move(permit), cmd, range,
-                std::move(trace_state), std::move(accounter), timeout, &querier_opt).then([&result, ug = std::move(ug)] (reconcilable_result res) {
+        auto stats = permit.get_read_stats();
+        return cf.mutation_query(std::move(s), permit, cmd, range,
+                trace_state, std::move(accounter), timeout, &querier_opt).then([&result, &trace_state, permit, stats, ug = std::move(ug)] (reconcilable_result res) {
             result = std::move(res);
+            trace_read_stats(trace_state, permit.get_read_stats() - stats);
         });
     };
 
@@ -1374,7 +1518,7 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
         if (querier_opt) {
             co_await semaphore.with_ready_permit(querier_opt->permit(), read_func);
         } else {
-            co_await semaphore.with_permit(s.get(), "mutation-query", cf.estimate_read_memory_cost(), timeout, read_func);
+            co_await semaphore.with_permit(s.get(), "mutation-query", cf.estimate_read_cost({range}, cmd.slice), timeout, read_func);
         }
 
         if (cmd.query_uuid != utils::UUID{} && querier_opt) {
@@ -1507,27 +1651,37 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto slice = query::partition_slice(std::move(cr_ranges), std::move(static_columns),
         std::move(regular_columns), { }, { }, cql_serialization_format::internal(), query::max_rows);
 
-    return do_with(std::move(slice), std::move(m), std::vector<locked_cell>(),
-                   [this, &cf, timeout, trace_state = std::move(trace_state), op = cf.write_in_progress()] (const query::partition_slice& slice, mutation& m, std::vector<locked_cell>& locks) mutable {
+    return do_with(std::move(slice), std::move(m), locked_cells(),
+                   [this, &cf, timeout, trace_state = std::move(trace_state), op = cf.write_in_progress()] (const query::partition_slice& slice, mutation& m, locked_cells& locks) mutable {
         tracing::trace(trace_state, "Acquiring counter locks");
-        return cf.lock_counter_cells(m, timeout).then([&, m_schema = cf.schema(), trace_state = std::move(trace_state), timeout, this] (std::vector<locked_cell> lcs) mutable {
+        return cf.lock_counter_cells(m, timeout).then([&, m_schema = cf.schema(), trace_state = std::move(trace_state), timeout, this] (locked_cells lcs) mutable {
             locks = std::move(lcs);
 
             // Before counter update is applied it needs to be transformed from
             // deltas to counter shards. To do that, we need to read the current
-            // counter state for each modified cell...
-
-            tracing::trace(trace_state, "Reading counter values from the CF");
-            auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(m_schema.get(), "counter-read-before-write", timeout);
-            return counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state)
-                    .then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
+            // counter state for each modified cell, unless the local shards of
+            // all of them are in the counter shard cache...
+
+            auto cache_generation = _counter_shard_cache->generation();
+            auto read_current_state = [&] () -> future<mutation_opt> {
+                if (auto cached = _counter_shard_cache->get(m_schema->id(), m)) {
+                    tracing::trace(trace_state, "Found counter shards in the cache");
+                    return make_ready_future<mutation_opt>(std::move(cached));
+                }
+                tracing::trace(trace_state, "Reading counter values from the CF");
+                auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(m_schema.get(), "counter-read-before-write", timeout);
+                return counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state);
+            };
+            return read_current_state().then([this, &cf, &m, m_schema, timeout, trace_state, cache_generation] (auto mopt) {
                 // ...now, that we got existing state of all affected counter
                 // cells we can look for our shard in each of them, increment
                 // its clock and apply the delta.
                 auto local_host_id = db::system_keyspace::get_local_host_id();
                 transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), std::move(local_host_id));
                 tracing::trace(trace_state, "Applying counter update");
-                return this->apply_with_commitlog(cf, m, timeout);
+                return this->apply_with_commitlog(cf, m, timeout).then([this, &m, m_schema, cache_generation] {
+                    _counter_shard_cache->update(m_schema->id(), m, cache_generation);
+                });
             }).then([&m] {
                 return std::move(m);
             });
@@ -1666,6 +1820,48 @@ void dirty_memory_manager::start_reclaiming() noexcept {
     _should_flush.signal();
 }
 
+void dirty_memory_manager::update_flush_bandwidth(clock::time_point now) noexcept {
+    auto elapsed = now - _flush_bandwidth_sampled_at;
+    if (elapsed < flush_bandwidth_sample_period) {
+        return;
+    }
+    auto flushed = _flushed_bytes - _flushed_bytes_at_sample;
+    _flushed_bytes_at_sample = _flushed_bytes;
+    _flush_bandwidth_sampled_at = now;
+    // Periods without flushes, or spanning a time without writes, say nothing about how fast
+    // memtables are flushed.
+    if (!flushed || elapsed > 10 * flush_bandwidth_sample_period) {
+        return;
+    }
+    auto bandwidth = flushed / std::chrono::duration<double>(elapsed).count();
+    _flush_bandwidth = _flush_bandwidth ? 0.75 * _flush_bandwidth + 0.25 * bandwidth : bandwidth;
+}
+
+dirty_memory_manager::clock::duration dirty_memory_manager::write_throttle_delay(size_t size) noexcept {
+    if (!_throttle_limit) {
+        return clock::duration(0);
+    }
+    auto now = clock::now();
+    update_flush_bandwidth(now);
+    double hard_limit = throttle_threshold();
+    double limit = hard_limit * _throttle_limit;
+    double used = virtual_dirty_memory();
+    if (used <= limit || !_flush_bandwidth) {
+        return clock::duration(0);
+    }
+    auto pressure = std::min(1.0, (used - limit) / (hard_limit - limit));
+    auto rate = _flush_bandwidth / pressure;
+    auto cost = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(size / rate));
+    auto start = std::clamp(_next_write_at, now, now + max_write_throttle_delay);
+    _next_write_at = start + cost;
+    auto delay = start - now;
+    if (delay.count()) {
+        ++_throttled_writes;
+        _write_throttle_delays.add(delay);
+    }
+    return delay;
+}
+
 namespace replica {
 
 future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
@@ -1673,6 +1869,10 @@ future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema
 
     data_listeners().on_write(m_schema, m);
 
+    if (auto* cache = cf.get_config().counter_shard_cache) {
+        cache->invalidate(cf.schema()->id(), m, *m_schema);
+    }
+
     return with_gate(cf.async_gate(), [this, &m, m_schema = std::move(m_schema), h = std::move(h), &cf, timeout] () mutable -> future<> {
         return cf.apply(m, std::move(m_schema), std::move(h), timeout);
     });
@@ -1800,6 +2000,56 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
     }
 }
 
+// Holds the first write to a partition for the window, and merges the writes
+// to the partition which arrive meanwhile into it, so that they pay for one
+// commitlog entry, memtable apply and view update check between them. All of
+// them complete when the merged mutation is applied.
+future<> database::apply_coalesced(schema_ptr s, const frozen_mutation& m, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog::force_sync sync) {
+    auto& cf = find_column_family(m.column_family_id());
+    auto key = to_bytes(m.key().representation());
+    auto& writes = cf.coalesced_writes();
+    if (auto it = writes.find(key); it != writes.end()) {
+        auto w = it->second;
+        // A write with another schema version can't be merged without
+        // upgrading one of them, which costs more than it saves.
+        if (w->schema->version() != s->version()) {
+            co_return co_await _apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), timeout, sync);
+        }
+        if (!w->merged) {
+            w->merged.emplace(w->first.unfreeze(w->schema));
+        }
+        w->merged->apply(m.unfreeze(s));
+        w->sync = w->sync || sync;
+        w->timeout = std::min(w->timeout, timeout);
+        ++cf.get_stats().coalesced_writes;
+        tracing::trace(tr_state, "Merged into a write held for coalescing");
+        co_return co_await w->applied.get_shared_future();
+    }
+
+    auto holder = cf.async_gate().hold();
+    auto w = make_lw_shared<table::coalesced_write>(s, m, sync, timeout);
+    writes.emplace(key, w);
+    co_await sleep(s->write_coalescing_window());
+    writes.erase(key);
+
+    std::exception_ptr ex;
+    try {
+        if (w->merged) {
+            auto fm = freeze(*w->merged);
+            co_await _apply_stage(this, std::move(s), seastar::cref(fm), std::move(tr_state), w->timeout, w->sync);
+        } else {
+            co_await _apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), w->timeout, w->sync);
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        w->applied.set_exception(ex);
+        co_return coroutine::exception(std::move(ex));
+    }
+    w->applied.set_value();
+}
+
 template<typename Future>
 Future database::update_write_metrics(Future&& f) {
     return f.then_wrapped([this, s = _stats] (auto f) {
@@ -1830,6 +2080,9 @@ future<> database::apply(schema_ptr s, const frozen_mutation& m, tracing::trace_
         update_write_metrics_for_timed_out_write();
         return make_exception_future<>(timed_out_error{});
     }
+    if (s->write_coalescing_window().count() && !s->is_counter()) {
+        return update_write_metrics(apply_coalesced(std::move(s), m, std::move(tr_state), timeout, sync));
+    }
     return update_write_metrics(_apply_stage(this, std::move(s), seastar::cref(m), std::move(tr_state), timeout, sync));
 }
 
@@ -1864,10 +2117,12 @@ database::make_keyspace_config(const keyspace_metadata& ksm) {
     }
     cfg.enable_dangerous_direct_import_of_cassandra_counters = _cfg.enable_dangerous_direct_import_of_cassandra_counters();
     cfg.compaction_enforce_min_threshold = _cfg.compaction_enforce_min_threshold;
+    cfg.compaction_split_unpurgeable_tombstones = _cfg.compaction_split_unpurgeable_tombstones;
     cfg.dirty_memory_manager = &_dirty_memory_manager;
     cfg.streaming_read_concurrency_semaphore = &_streaming_concurrency_sem;
     cfg.compaction_concurrency_semaphore = &_compaction_concurrency_sem;
     cfg.cf_stats = &_cf_stats;
+    cfg.counter_shard_cache = _counter_shard_cache.get();
     cfg.enable_incremental_backups = _enable_incremental_backups;
 
     cfg.compaction_scheduling_group = _dbcfg.compaction_scheduling_group;
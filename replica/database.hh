@@ -31,6 +31,7 @@
 #include "types.hh"
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/shared_future.hh>
 #include "db/commitlog/replay_position.hh"
 #include "db/commitlog/commitlog_types.hh"
 #include <limits>
@@ -69,7 +70,7 @@
 
 class cell_locker;
 class cell_locker_stats;
-class locked_cell;
+class locked_cells;
 class mutation;
 
 class frozen_mutation;
@@ -116,6 +117,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class hot_partitions_tracker;
 class large_data_handler;
 class system_keyspace;
 
@@ -134,6 +136,8 @@ class database_test;
 
 namespace replica {
 
+class counter_shard_cache;
+
 using shared_memtable = lw_shared_ptr<memtable>;
 
 // We could just add all memtables, regardless of types, to a single list, and
@@ -303,6 +307,8 @@ struct cf_stats {
     int64_t clustering_filter_fast_path_count = 0;
     // how many sstables survived the clustering key checks
     int64_t surviving_sstables_after_clustering_filter = 0;
+    // sstables not read because the row read from newer ones shadowed them
+    int64_t sstables_skipped_by_timestamp = 0;
 
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
@@ -357,6 +363,18 @@ struct table_stats {
     utils::timed_rate_moving_average_and_histogram tombstone_scanned;
     utils::timed_rate_moving_average_and_histogram live_scanned;
     utils::estimated_histogram estimated_coordinator_read;
+    /** Number of data reads which stopped short at the result size limit */
+    int64_t short_data_reads = 0;
+    /** Number of coordinator reads retried because replicas' results reconciled to too few live rows */
+    int64_t coordinator_read_retries = 0;
+    /** Number of reads of this table answered from, and missed in, the coordinator result cache */
+    int64_t coordinator_result_cache_hits = 0;
+    int64_t coordinator_result_cache_misses = 0;
+    /** Number of paged reads of this table which resumed a querier saved by the previous page, and which had to create a new one */
+    int64_t querier_cache_hits = 0;
+    int64_t querier_cache_misses = 0;
+    /** Number of writes merged into a write held for coalescing, see write_coalescing_window() */
+    int64_t coalesced_writes = 0;
 };
 
 class table : public enable_lw_shared_from_this<table> {
@@ -370,11 +388,13 @@ class table : public enable_lw_shared_from_this<table> {
         bool enable_commitlog = true;
         bool enable_incremental_backups = false;
         utils::updateable_value<bool> compaction_enforce_min_threshold{false};
+        utils::updateable_value<bool> compaction_split_unpurgeable_tombstones{false};
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
         ::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         reader_concurrency_semaphore* streaming_read_concurrency_semaphore;
         reader_concurrency_semaphore* compaction_concurrency_semaphore;
         replica::cf_stats* cf_stats = nullptr;
+        replica::counter_shard_cache* counter_shard_cache = nullptr;
         seastar::scheduling_group memtable_scheduling_group;
         seastar::scheduling_group memtable_to_cache_scheduling_group;
         seastar::scheduling_group compaction_scheduling_group;
@@ -390,6 +410,8 @@ class table : public enable_lw_shared_from_this<table> {
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{false};
         utils::updateable_value<bool> enable_optimized_reversed_reads{true};
+        utils::updateable_value<bool> enable_timestamp_ordered_reads{false};
+        utils::updateable_value<unsigned> memtable_flush_parallelism{1};
         // Can be updated by a schema change:
         bool enable_optimized_twcs_queries{true};
     };
@@ -403,6 +425,37 @@ class table : public enable_lw_shared_from_this<table> {
         cache_temperature rate;
         lowres_clock::time_point last_updated;
     };
+    // A decaying estimate of the latency of the reads of the table sent to
+    // a replica, kept like the round-trip time estimate of TCP (RFC 6298).
+    struct replica_read_latency {
+        std::chrono::microseconds mean{0};
+        std::chrono::microseconds deviation{0};
+        lowres_clock::time_point last_updated;
+
+        // A latency the replica rarely exceeds.
+        std::chrono::microseconds high() const {
+            return mean + 4 * deviation;
+        }
+    };
+    // Estimates not updated for this long are ignored, so a replica which
+    // was avoided because it was slow gets tried again.
+    static constexpr std::chrono::seconds replica_read_latency_expiry{10};
+    // A write held for the schema's write_coalescing_window(), with the
+    // writes to the same partition which arrived meanwhile merged into it.
+    struct coalesced_write {
+        schema_ptr schema;
+        // The write which started the window, alive until it is applied.
+        const frozen_mutation& first;
+        // Engaged once another write is merged into the first one.
+        std::optional<mutation> merged;
+        db::commitlog_force_sync sync;
+        db::timeout_clock::time_point timeout;
+        shared_promise<> applied;
+
+        coalesced_write(schema_ptr s, const frozen_mutation& m, db::commitlog_force_sync sync, db::timeout_clock::time_point timeout)
+            : schema(std::move(s)), first(m), sync(sync), timeout(timeout)
+        { }
+    };
 private:
     schema_ptr _schema;
     config _config;
@@ -471,6 +524,13 @@ class table : public enable_lw_shared_from_this<table> {
     // in dynamically
     std::unordered_map<gms::inet_address, cache_hit_rate> _cluster_cache_hit_rates;
 
+    // holds latencies of coordinated reads per each replica, see
+    // replica_read_latency
+    std::unordered_map<gms::inet_address, replica_read_latency> _replica_read_latencies;
+
+    // Writes held for coalescing, by the representation of their partition key.
+    std::unordered_map<bytes, lw_shared_ptr<coalesced_write>> _coalesced_writes;
+
     // Operations like truncate, flush, query, etc, may depend on a column family being alive to
     // complete.  Some of them have their own gate already (like flush), used in specialized wait
     // logic. That is particularly useful if there is a particular
@@ -547,6 +607,7 @@ class table : public enable_lw_shared_from_this<table> {
     }
     void update_stats_for_new_sstable(uint64_t disk_space_used_by_sstable) noexcept;
     future<> do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::offstrategy offstrategy);
+    void invalidate_counter_shard_cache() noexcept;
     // Adds new sstable to the set of sstables
     // Doesn't update the cache. The cache must be synchronized in order for reads to see
     // the writes contained in this sstable.
@@ -755,7 +816,7 @@ class table : public enable_lw_shared_from_this<table> {
         return _cache;
     }
 
-    future<std::vector<locked_cell>> lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout);
+    future<locked_cells> lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout);
 
     logalloc::occupancy_stats occupancy() const;
 private:
@@ -844,7 +905,9 @@ class table : public enable_lw_shared_from_this<table> {
 
     db::replay_position set_low_replay_position_mark();
 
-    future<> snapshot(database& db, sstring name, bool skip_flush = false);
+    // If base_name is given, the manifest of the snapshot also lists the files
+    // that are not in the snapshot named base_name.
+    future<> snapshot(database& db, sstring name, bool skip_flush = false, sstring base_name = {});
     future<std::unordered_map<sstring, snapshot_details>> get_snapshot_details();
 
     /*!
@@ -1015,6 +1078,15 @@ class table : public enable_lw_shared_from_this<table> {
     void add_coordinator_read_latency(utils::estimated_histogram::duration latency);
     std::chrono::milliseconds get_coordinator_read_latency_percentile(double percentile);
 
+    void add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency);
+    // Returns a disengaged optional if there is no recent estimate for the replica.
+    std::optional<replica_read_latency> get_replica_read_latency(gms::inet_address addr) const;
+    void drop_replica_read_latency(gms::inet_address addr);
+
+    std::unordered_map<bytes, lw_shared_ptr<coalesced_write>>& coalesced_writes() noexcept {
+        return _coalesced_writes;
+    }
+
     secondary_index::secondary_index_manager& get_index_manager() {
         return _index_manager;
     }
@@ -1041,6 +1113,11 @@ class table : public enable_lw_shared_from_this<table> {
 
     size_t estimate_read_memory_cost() const;
 
+    // Estimates the cost of reading the ranges, for admission by
+    // reader_concurrency_semaphore, from the sstables which would be read
+    // and the partitions present in cache.
+    reader_concurrency_semaphore::read_cost estimate_read_cost(const dht::partition_range_vector& ranges, const query::partition_slice& slice);
+
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
             tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem, const io_priority_class& io_priority, query::partition_slice::option_set custom_opts) const;
@@ -1108,11 +1185,13 @@ class keyspace {
         bool enable_cache = true;
         bool enable_incremental_backups = false;
         utils::updateable_value<bool> compaction_enforce_min_threshold{false};
+        utils::updateable_value<bool> compaction_split_unpurgeable_tombstones{false};
         bool enable_dangerous_direct_import_of_cassandra_counters = false;
         ::dirty_memory_manager* dirty_memory_manager = &default_dirty_memory_manager;
         reader_concurrency_semaphore* streaming_read_concurrency_semaphore;
         reader_concurrency_semaphore* compaction_concurrency_semaphore;
         replica::cf_stats* cf_stats = nullptr;
+        replica::counter_shard_cache* counter_shard_cache = nullptr;
         seastar::scheduling_group memtable_scheduling_group;
         seastar::scheduling_group memtable_to_cache_scheduling_group;
         seastar::scheduling_group compaction_scheduling_group;
@@ -1205,6 +1284,9 @@ struct database_config {
     seastar::scheduling_group compaction_scheduling_group;
     seastar::scheduling_group memory_compaction_scheduling_group;
     seastar::scheduling_group statement_scheduling_group;
+    // Statements of service levels with the batch workload type. Same as
+    // statement_scheduling_group when the cpu scheduler is disabled.
+    seastar::scheduling_group batch_statement_scheduling_group;
     seastar::scheduling_group streaming_scheduling_group;
     seastar::scheduling_group gossip_scheduling_group;
     size_t available_memory;
@@ -1272,6 +1354,7 @@ class database {
 
     lw_shared_ptr<db_stats> _stats;
     std::unique_ptr<cell_locker_stats> _cl_stats;
+    std::unique_ptr<counter_shard_cache> _counter_shard_cache;
 
     const db::config& _cfg;
 
@@ -1326,6 +1409,8 @@ class database {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    // Installed into _data_listeners unless disabled.
+    std::unique_ptr<db::hot_partitions_tracker> _hot_partitions_tracker;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1367,6 +1452,7 @@ class database {
 
     friend class db_apply_executor;
     future<> do_apply(schema_ptr, const frozen_mutation&, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog_force_sync sync);
+    future<> apply_coalesced(schema_ptr, const frozen_mutation&, tracing::trace_state_ptr tr_state, db::timeout_clock::time_point timeout, db::commitlog_force_sync sync);
     future<> apply_with_commitlog(column_family& cf, const mutation& m, db::timeout_clock::time_point timeout);
 
     future<mutation> do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema, db::timeout_clock::time_point timeout,
@@ -1426,6 +1512,7 @@ class database {
     }
 
     seastar::scheduling_group get_statement_scheduling_group() const { return _dbcfg.statement_scheduling_group; }
+    seastar::scheduling_group get_batch_statement_scheduling_group() const { return _dbcfg.batch_statement_scheduling_group; }
     seastar::scheduling_group get_streaming_scheduling_group() const { return _dbcfg.streaming_scheduling_group; }
 
     compaction_manager& get_compaction_manager() {
@@ -1552,6 +1639,9 @@ class database {
     const db::config& get_config() const {
         return _cfg;
     }
+    const counter_shard_cache& get_counter_shard_cache() const {
+        return *_counter_shard_cache;
+    }
     const db::extensions& extensions() const;
 
     sstables::sstables_manager& get_user_sstables_manager() const noexcept {
@@ -1614,6 +1704,11 @@ class database {
         return *_data_listeners;
     }
 
+    // Null if tracking is disabled.
+    const db::hot_partitions_tracker* hot_partitions_tracker() const {
+        return _hot_partitions_tracker.get();
+    }
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
@@ -85,14 +85,14 @@ class global_column_family_ptr {
 };
 
 future<>
-distributed_loader::process_sstable_dir(sharded<sstables::sstable_directory>& dir, bool sort_sstables_according_to_owner) {
+distributed_loader::process_sstable_dir(sharded<sstables::sstable_directory>& dir, bool sort_sstables_according_to_owner, sstables::sstable_open_config cfg) {
     return dir.invoke_on(0, [] (const sstables::sstable_directory& d) {
         return utils::directories::verify_owner_and_mode(d.sstable_dir());
-    }).then([&dir, sort_sstables_according_to_owner] {
-      return dir.invoke_on_all([&dir, sort_sstables_according_to_owner] (sstables::sstable_directory& d) {
+    }).then([&dir, sort_sstables_according_to_owner, cfg] {
+      return dir.invoke_on_all([&dir, sort_sstables_according_to_owner, cfg] (sstables::sstable_directory& d) {
         // Supposed to be called with the node either down or on behalf of maintenance tasks
         // like nodetool refresh
-        return d.process_sstable_dir(service::get_local_streaming_priority(), sort_sstables_according_to_owner).then([&dir, &d] {
+        return d.process_sstable_dir(service::get_local_streaming_priority(), sort_sstables_according_to_owner, cfg).then([&dir, &d] {
             return d.move_foreign_sstables(dir);
         });
       });
@@ -452,6 +452,29 @@ future<> distributed_loader::handle_sstables_pending_delete(sstring pending_dele
     });
 }
 
+// Time spent in each phase of populating table directories, summed over the
+// directories populated since the last reset. Only used on shard 0, where
+// populate_column_family() runs.
+struct populate_phase_times {
+    using duration = std::chrono::steady_clock::duration;
+    size_t directories = 0;
+    duration open{};
+    duration reshard{};
+    duration reshape{};
+    duration add{};
+};
+
+static thread_local populate_phase_times populate_times;
+
+static void log_populate_times(std::string_view what, std::chrono::steady_clock::time_point start) {
+    auto seconds = [] (std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double>(d).count();
+    };
+    dblog.info("Populated {} in {:.3f}s from {} table directories. Summed over them: open {:.3f}s, reshard {:.3f}s, reshape {:.3f}s, add {:.3f}s",
+            what, seconds(std::chrono::steady_clock::now() - start), populate_times.directories,
+            seconds(populate_times.open), seconds(populate_times.reshard), seconds(populate_times.reshape), seconds(populate_times.add));
+}
+
 future<> distributed_loader::populate_column_family(distributed<replica::database>& db, sstring sstdir, sstring ks, sstring cf, allow_offstrategy_compaction do_allow_offstrategy_compaction, must_exist dir_must_exist) {
     dblog.debug("Populating {}/{}/{} allow_offstrategy_compaction={} must_exist={}", ks, cf, sstdir, do_allow_offstrategy_compaction, dir_must_exist);
     return async([&db, sstdir = std::move(sstdir), ks = std::move(ks), cf = std::move(cf), do_allow_offstrategy_compaction, dir_must_exist] {
@@ -464,6 +487,15 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
             return;
         }
 
+        auto phase_start = std::chrono::steady_clock::now();
+        auto end_phase = [&phase_start] (populate_phase_times::duration& total) {
+            auto now = std::chrono::steady_clock::now();
+            auto d = now - phase_start;
+            total += d;
+            phase_start = now;
+            return std::chrono::duration<double>(d).count();
+        };
+
         // First pass, cleanup temporary sstable directories and sstables pending delete.
         cleanup_column_family_temp_sst_dirs(sstdir).get();
         auto pending_delete_dir = sstdir + "/" + sstables::sstable::pending_delete_dir_basename();
@@ -487,7 +519,14 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
         auto stop = deferred_stop(directory);
 
         lock_table(directory, db, ks, cf).get();
-        process_sstable_dir(directory).get();
+        // Sstables which get resharded or reshaped don't need their filters.
+        // The rest read them once they are added to the table. The compaction
+        // metadata is only needed by compaction, which reads it itself.
+        auto filters_in_background = db.local().get_config().load_sstable_filters_in_background();
+        process_sstable_dir(directory, true, sstables::sstable_open_config{
+            .load_bloom_filter = !filters_in_background,
+            .load_compaction_metadata = false,
+        }).get();
 
         // If we are resharding system tables before we can read them, we will not
         // know which is the highest format we support: this information is itself stored
@@ -502,6 +541,7 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
             global_table->update_sstables_known_generation(generation);
             return global_table->disable_auto_compaction();
         }).get();
+        auto open_time = end_phase(populate_times.open);
 
         reshard(directory, db, ks, cf, [&global_table, sstdir, sst_version] (shard_id shard) mutable {
             auto gen = smp::submit_to(shard, [&global_table] () {
@@ -510,6 +550,7 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
 
             return global_table->make_sstable(sstdir, gen, sst_version, sstables::sstable::format_types::big);
         }).get();
+        auto reshard_time = end_phase(populate_times.reshard);
 
         // The node is offline at this point so we are very lenient with what we consider
         // offstrategy.
@@ -519,18 +560,25 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
         // off-strategy compaction to reshape them. This will allow node to become online
         // ASAP. Given that SSTables with repair origin are disjoint, they can be efficiently
         // read from.
-        auto eligible_for_reshape_on_boot = [] (const sstables::shared_sstable& sst) {
-            return sst->get_origin() != sstables::repair_origin;
+        // With reshape_on_boot disabled, this goes for all sstables of user tables: the node starts
+        // serving once they are resharded, and reshaping continues in the maintenance group.
+        auto reshape_on_boot = !do_allow_offstrategy_compaction || is_system_keyspace(ks) || db.local().get_config().reshape_on_boot();
+        auto eligible_for_reshape_on_boot = [reshape_on_boot] (const sstables::shared_sstable& sst) {
+            return reshape_on_boot && sst->get_origin() != sstables::repair_origin;
         };
 
-        reshape(directory, db, sstables::reshape_mode::relaxed, ks, cf, [global_table, sstdir, sst_version] (shard_id shard) {
-            auto gen = global_table->calculate_generation_for_new_table();
-            return global_table->make_sstable(sstdir, gen, sst_version, sstables::sstable::format_types::big);
-        }, eligible_for_reshape_on_boot).get();
+        if (reshape_on_boot) {
+            reshape(directory, db, sstables::reshape_mode::relaxed, ks, cf, [global_table, sstdir, sst_version] (shard_id shard) {
+                auto gen = global_table->calculate_generation_for_new_table();
+                return global_table->make_sstable(sstdir, gen, sst_version, sstables::sstable::format_types::big);
+            }, eligible_for_reshape_on_boot).get();
+        }
+        auto reshape_time = end_phase(populate_times.reshape);
 
         directory.invoke_on_all([global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::sstable_directory& dir) {
             return dir.do_for_each_sstable([&global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::shared_sstable sst) {
                 auto requires_offstrategy = sstables::offstrategy(do_allow_offstrategy_compaction && !eligible_for_reshape_on_boot(sst));
+                sst->load_filter_in_background(service::get_local_streaming_priority());
                 return global_table->add_sstable_and_update_cache(sst, requires_offstrategy);
             }).then([&global_table, do_allow_offstrategy_compaction] {
               if (do_allow_offstrategy_compaction) {
@@ -538,6 +586,11 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
               }
             });
         }).get();
+        auto add_time = end_phase(populate_times.add);
+        populate_times.directories++;
+
+        dblog.debug("Populated {}: open {:.3f}s, reshard {:.3f}s, reshape {:.3f}s, add {:.3f}s",
+                sstdir, open_time, reshard_time, reshape_time, add_time);
     });
 }
 
@@ -590,6 +643,9 @@ future<> distributed_loader::init_system_keyspace(distributed<replica::database>
             return db::system_keyspace::make(db, ss, g, cfg);
         }).get();
 
+        auto start = std::chrono::steady_clock::now();
+        populate_times = {};
+
         const auto& cfg = db.local().get_config();
         for (auto& data_dir : cfg.data_file_directories()) {
             for (auto ksname : system_keyspaces) {
@@ -613,6 +669,8 @@ future<> distributed_loader::init_system_keyspace(distributed<replica::database>
             }
             return make_ready_future<>();
         }).get();
+
+        log_populate_times("system keyspaces", start);
     });
 }
 
@@ -659,6 +717,8 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
         }).get();
 
         std::vector<future<>> futures;
+        auto start = std::chrono::steady_clock::now();
+        populate_times = {};
 
         // treat "dirs" as immutable to avoid modifying it while still in 
         // a range-iteration. Also to simplify the "finally"
@@ -693,6 +753,8 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
                 return make_ready_future<>();
             });
         }).get();
+
+        log_populate_times("non-system keyspaces", start);
     });
 }
 
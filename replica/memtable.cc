@@ -14,6 +14,7 @@
 #include "mutation_partition_view.hh"
 #include "readers/empty_v2.hh"
 #include "readers/forwardable_v2.hh"
+#include "utils/stall_activity.hh"
 
 namespace replica {
 
@@ -123,6 +124,7 @@ memtable::memtable(schema_ptr schema, dirty_memory_manager& dmm, replica::table_
         , _schema(std::move(schema))
         , partitions(dht::raw_token_less_comparator{})
         , _table_stats(table_stats) {
+    set_owner(format("memtable {}.{}", _schema->ks_name(), _schema->cf_name()));
 }
 
 static thread_local dirty_memory_manager mgr_for_tests;
@@ -616,9 +618,9 @@ class flush_reader final : public flat_mutation_reader_v2::impl, private iterato
     flat_mutation_reader_v2_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -655,6 +657,7 @@ class flush_reader final : public flat_mutation_reader_v2::impl, private iterato
 public:
     virtual future<> fill_buffer() override {
         return do_until([this] { return is_end_of_stream() || is_buffer_full(); }, [this] {
+            utils::stall_activity_scope activity(utils::stall_activity::memtable_flush);
             if (!_partition_reader) {
                 get_next_partition();
                 if (!_partition_reader) {
@@ -741,12 +744,17 @@ memtable::make_flat_reader_opt(schema_ptr s,
 
 flat_mutation_reader_v2
 memtable::make_flush_reader(schema_ptr s, reader_permit permit, const io_priority_class& pc) {
+    return make_flush_reader(std::move(s), std::move(permit), query::full_partition_range, pc);
+}
+
+flat_mutation_reader_v2
+memtable::make_flush_reader(schema_ptr s, reader_permit permit, const dht::partition_range& range, const io_priority_class& pc) {
     if (group()) {
-        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_flat_mutation_reader_v2<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-                      query::full_partition_range, full_slice, pc, mutation_reader::forwarding::no);
+                      range, full_slice, pc, mutation_reader::forwarding::no);
     }
 }
 
@@ -271,6 +271,9 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private loga
     }
 
     flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit, const io_priority_class& pc);
+    // Reads only the partitions in the range, so that disjoint parts of the memtable can be
+    // flushed in parallel. The range must be kept alive by the caller until the reader is closed.
+    flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit, const dht::partition_range& range, const io_priority_class& pc);
 
     mutation_source as_data_source();
 
@@ -10,6 +10,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/util/closeable.hh>
+#include <seastar/util/file.hh>
 
 #include "replica/database.hh"
 #include "sstables/sstables.hh"
@@ -17,6 +18,7 @@
 #include "service/priority_manager.hh"
 #include "db/schema_tables.hh"
 #include "cell_locking.hh"
+#include "replica/counter_shard_cache.hh"
 #include "utils/logalloc.hh"
 #include "checked-file-impl.hh"
 #include "view_info.hh"
@@ -39,6 +41,7 @@
 #include "db/config.hh"
 #include "db/commitlog/commitlog.hh"
 #include "utils/lister.hh"
+#include "utils/rjson.hh"
 
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/algorithm.hpp>
@@ -285,11 +288,17 @@ flat_mutation_reader_v2 table::make_streaming_reader(schema_ptr schema, reader_p
             std::move(trace_state), fwd, fwd_mr);
 }
 
-future<std::vector<locked_cell>> table::lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout) {
+future<locked_cells> table::lock_counter_cells(const mutation& m, db::timeout_clock::time_point timeout) {
     assert(m.schema() == _counter_cell_locks->schema());
     return _counter_cell_locks->lock_cells(m.decorated_key(), partition_cells_range(m.partition()), timeout);
 }
 
+void table::invalidate_counter_shard_cache() noexcept {
+    if (_config.counter_shard_cache) {
+        _config.counter_shard_cache->invalidate(_schema->id());
+    }
+}
+
 api::timestamp_type table::min_memtable_timestamp() const {
     if (_memtables->empty()) {
         return api::max_timestamp;
@@ -453,6 +462,8 @@ table::do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::o
         } else {
             add_maintenance_sstable(sst);
         }
+        // The sstable may bring deletions of counters
+        invalidate_counter_shard_cache();
     }), dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true}));
 }
 
@@ -639,6 +650,9 @@ table::seal_active_memtable(flush_permit&& permit) {
     // FIXME: provide back-pressure to upper layers
 }
 
+// The least memtable memory a range of a split flush covers, see memtable_flush_parallelism.
+static constexpr size_t min_flush_split_size = 32 << 20;
+
 future<stop_iteration>
 table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_permit&& permit) {
     auto try_flush = [this, old = std::move(old), permit = make_lw_shared(std::move(permit))] () mutable -> future<stop_iteration> {
@@ -660,6 +674,14 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
         metadata.max_timestamp = old->get_max_timestamp();
         auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count());
 
+        // A large memtable is split into token ranges, and each is written to sstables of
+        // its own, in parallel, so that one flush isn't limited by a single sequential writer.
+        auto split = std::min<uint64_t>(_config.memtable_flush_parallelism(), old->occupancy().total_space() / min_flush_split_size);
+        auto ranges = split > 1 ? dht::split_ring_uniformly(split) : dht::partition_range_vector{query::full_partition_range};
+        estimated_partitions = std::max<uint64_t>(estimated_partitions / ranges.size(), 1);
+
+        // The strategy may split the flush further. Time window compaction strategy writes the
+        // data of each time window to an sstable of its own, unless the memtable spans one window.
         auto consumer = _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, metadata, estimated_partitions] (flat_mutation_reader_v2 reader) mutable -> future<> {
             auto&& priority = service::get_local_memtable_flush_priority();
             sstables::sstable_writer_config cfg = get_sstables_manager().configure_writer("memtable");
@@ -675,36 +697,54 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
             co_return co_await write_memtable_to_sstable(std::move(reader), *old, newtab, estimated_partitions, monitor, cfg, priority);
         });
 
-        auto reader = old->make_flush_reader(
-            old->schema(),
-            compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout),
-            service::get_local_memtable_flush_priority());
-
-        if (old->has_any_tombstones()) {
-            reader = make_compacting_reader(
-                std::move(reader),
-                gc_clock::now(),
-                [] (const dht::decorated_key&) { return api::min_timestamp; });
-        }
+        auto make_reader = [this, old] (const dht::partition_range& range) {
+            auto reader = old->make_flush_reader(
+                old->schema(),
+                compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout),
+                range,
+                service::get_local_memtable_flush_priority());
+
+            if (old->has_any_tombstones()) {
+                reader = make_compacting_reader(
+                    std::move(reader),
+                    gc_clock::now(),
+                    [] (const dht::decorated_key&) { return api::min_timestamp; });
+            }
+            return reader;
+        };
 
+        std::vector<flat_mutation_reader_v2> readers;
         std::exception_ptr err;
-        try {
-            auto* fragment = co_await reader.peek();
-            if (!fragment) {
-                co_await reader.close();
-                _memtables->erase(old);
-                co_return stop_iteration::yes;
+        for (auto& range : ranges) {
+            auto reader = make_reader(range);
+            try {
+                if (co_await reader.peek()) {
+                    readers.push_back(std::move(reader));
+                    continue;
+                }
+            } catch (...) {
+                err = std::current_exception();
+            }
+            co_await reader.close();
+            if (err) {
+                break;
             }
-        } catch (...) {
-            err = std::current_exception();
         }
         if (err) {
             tlogger.error("failed to flush memtable for {}.{}: {}", old->schema()->ks_name(), old->schema()->cf_name(), err);
-            co_await reader.close();
+            co_await parallel_for_each(readers, [] (flat_mutation_reader_v2& reader) {
+                return reader.close();
+            });
             co_return stop_iteration(_async_gate.is_closed());
         }
+        if (readers.empty()) {
+            _memtables->erase(old);
+            co_return stop_iteration::yes;
+        }
 
-        auto f = consumer(std::move(reader));
+        auto f = parallel_for_each(readers, [&consumer] (flat_mutation_reader_v2& reader) {
+            return consumer(std::move(reader));
+        });
 
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -785,6 +825,13 @@ void table::set_metrics() {
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks),
                 ms::make_counter("memtable_range_tombstone_reads", _stats.memtable_range_tombstone_reads, ms::description("Number of range tombstones read from memtables"))(cf)(ks),
                 ms::make_counter("memtable_row_tombstone_reads", _stats.memtable_row_tombstone_reads, ms::description("Number of row tombstones read from memtables"))(cf)(ks),
+                ms::make_counter("short_data_reads", _stats.short_data_reads, ms::description("Number of data reads which returned a short page, because the result reached the size limit"))(cf)(ks),
+                ms::make_counter("coordinator_read_retries", _stats.coordinator_read_retries, ms::description("Number of reads coordinated by this shard which were retried, because the results of the replicas reconciled to fewer live rows than requested"))(cf)(ks),
+                ms::make_counter("coordinator_result_cache_hits", _stats.coordinator_result_cache_hits, ms::description("Number of single-partition reads of this table answered from the coordinator result cache"))(cf)(ks),
+                ms::make_counter("coordinator_result_cache_misses", _stats.coordinator_result_cache_misses, ms::description("Number of single-partition reads of this table which looked up the coordinator result cache and didn't find a result"))(cf)(ks),
+                ms::make_counter("querier_cache_hits", _stats.querier_cache_hits, ms::description("Number of paged reads of this table which resumed the querier saved by the previous page"))(cf)(ks),
+                ms::make_counter("querier_cache_misses", _stats.querier_cache_misses, ms::description("Number of paged reads of this table which found no usable querier saved by the previous page"))(cf)(ks),
+                ms::make_counter("coalesced_writes", _stats.coalesced_writes, ms::description("Number of writes merged into another write to the same partition, held for the table's write_coalescing_window_in_us"))(cf)(ks),
                 ms::make_gauge("pending_tasks", ms::description("Estimated number of tasks pending for this column family"), _stats.pending_flushes)(cf)(ks),
                 ms::make_gauge("live_disk_space", ms::description("Live disk space used"), _stats.live_disk_space_used)(cf)(ks),
                 ms::make_gauge("total_disk_space", ms::description("Total disk space used"), _stats.total_disk_space_used)(cf)(ks),
@@ -1292,25 +1339,73 @@ struct snapshot_manager {
 };
 static thread_local std::unordered_map<sstring, lw_shared_ptr<snapshot_manager>> pending_snapshots;
 
-static future<>
-seal_snapshot(sstring jsondir) {
-    std::ostringstream ss;
+// Returns the files listed in the manifest of the snapshot in jsondir,
+// or nullopt if the snapshot doesn't exist.
+static future<std::optional<std::unordered_set<sstring>>>
+read_snapshot_manifest(sstring jsondir) {
+    auto jsonfile = jsondir + "/manifest.json";
+    if (!co_await io_check([&jsonfile] { return file_exists(jsonfile); })) {
+        co_return std::nullopt;
+    }
+    auto data = co_await util::read_entire_file_contiguous(std::filesystem::path(jsonfile.c_str()));
+    auto manifest = rjson::parse(std::string_view(data.get(), data.size()));
+    std::unordered_set<sstring> files;
+    if (auto* v = rjson::find(manifest, "files")) {
+        for (const rjson::value& f : v->GetArray()) {
+            files.emplace(rjson::to_string_view(f));
+        }
+    }
+    co_return files;
+}
+
+static void write_manifest_files(std::ostream& ss, const sstring& name, const std::unordered_set<sstring>& files, auto&& filter) {
     int n = 0;
-    ss << "{" << std::endl << "\t\"files\" : [ ";
-    for (auto&& rf: pending_snapshots.at(jsondir)->files) {
+    ss << "\t\"" << name << "\" : [ ";
+    for (auto&& rf: files) {
+        if (!filter(rf)) {
+            continue;
+        }
         if (n++ > 0) {
             ss << ", ";
         }
         ss << "\"" << rf << "\"";
     }
-    ss << " ]" << std::endl << "}" << std::endl;
+    ss << " ]";
+}
+
+// If base_jsondir is given, the manifest also lists under "new_files" the
+// files which are not in the manifest of the snapshot in base_jsondir, so
+// that backups of this snapshot can skip the files already backed up with
+// the base one. SSTable files are immutable, so a file with the same name
+// has the same contents.
+static future<>
+seal_snapshot(sstring jsondir, std::optional<sstring> base_jsondir) {
+    auto snapshot = pending_snapshots.at(jsondir);
+    auto& files = snapshot->files;
+    std::optional<std::unordered_set<sstring>> base_files;
+    if (base_jsondir) {
+        base_files = co_await read_snapshot_manifest(*base_jsondir);
+        if (!base_files) {
+            tlogger.info("Base snapshot {} not found, all files of snapshot {} are new", *base_jsondir, jsondir);
+            base_files.emplace();
+        }
+    }
+
+    std::ostringstream ss;
+    ss << "{" << std::endl;
+    write_manifest_files(ss, "files", files, [] (const sstring&) { return true; });
+    if (base_files) {
+        ss << "," << std::endl;
+        write_manifest_files(ss, "new_files", files, [&] (const sstring& rf) { return !base_files->contains(rf); });
+    }
+    ss << std::endl << "}" << std::endl;
 
     auto json = ss.str();
     auto jsonfile = jsondir + "/manifest.json";
 
     tlogger.debug("Storing manifest {}", jsonfile);
 
-    return io_check([jsondir] { return recursive_touch_directory(jsondir); }).then([jsonfile, json = std::move(json)] {
+    co_await io_check([jsondir] { return recursive_touch_directory(jsondir); }).then([jsonfile, json = std::move(json)] {
         return open_checked_file_dma(general_disk_error_handler, jsonfile, open_flags::wo | open_flags::create | open_flags::truncate).then([json](file f) {
             return make_file_output_stream(std::move(f)).then([json](output_stream<char>&& out) {
                 return do_with(std::move(out), [json] (output_stream<char>& out) {
@@ -1324,9 +1419,6 @@ seal_snapshot(sstring jsondir) {
         });
     }).then([jsondir] {
         return io_check(sync_directory, std::move(jsondir));
-    }).finally([jsondir] {
-        pending_snapshots.erase(jsondir);
-        return make_ready_future<>();
     });
 }
 
@@ -1353,14 +1445,15 @@ future<> table::write_schema_as_cql(database& db, sstring dir) const {
 
 }
 
-future<> table::snapshot(database& db, sstring name, bool skip_flush) {
+future<> table::snapshot(database& db, sstring name, bool skip_flush, sstring base_name) {
     auto jsondir = _config.datadir + "/snapshots/" + name;
-    tlogger.debug("snapshot {}: skip_flush={}", jsondir, skip_flush);
+    auto base_jsondir = base_name.empty() ? std::nullopt : std::make_optional(_config.datadir + "/snapshots/" + base_name);
+    tlogger.debug("snapshot {}: skip_flush={}, base={}", jsondir, skip_flush, base_name);
     auto f = skip_flush ? make_ready_future<>() : flush();
-    return f.then([this, &db, jsondir = std::move(jsondir)]() {
-       return with_semaphore(_sstable_deletion_sem, 1, [this, &db, jsondir = std::move(jsondir)]() {
+    return f.then([this, &db, jsondir = std::move(jsondir), base_jsondir = std::move(base_jsondir)]() mutable {
+       return with_semaphore(_sstable_deletion_sem, 1, [this, &db, jsondir = std::move(jsondir), base_jsondir = std::move(base_jsondir)]() mutable {
         auto tables = boost::copy_range<std::vector<sstables::shared_sstable>>(*_sstables->all());
-        return do_with(std::move(tables), std::move(jsondir), [this, &db] (std::vector<sstables::shared_sstable>& tables, const sstring& jsondir) {
+        return do_with(std::move(tables), std::move(jsondir), std::move(base_jsondir), [this, &db] (std::vector<sstables::shared_sstable>& tables, const sstring& jsondir, const std::optional<sstring>& base_jsondir) {
             return io_check([&jsondir] { return recursive_touch_directory(jsondir); }).then([this, &db, &jsondir, &tables] {
                 return max_concurrent_for_each(tables, db.get_config().initial_sstable_loading_concurrency(), [&db, &jsondir] (sstables::shared_sstable sstable) {
                   return with_semaphore(db.get_sharded_sst_dir_semaphore().local(), 1, [&jsondir, sstable] {
@@ -1371,7 +1464,7 @@ future<> table::snapshot(database& db, sstring name, bool skip_flush) {
                 });
             }).then([&jsondir, &tables] {
                 return io_check(sync_directory, jsondir);
-            }).finally([this, &tables, &db, &jsondir] {
+            }).finally([this, &tables, &db, &jsondir, &base_jsondir] {
                 auto shard = std::hash<sstring>()(jsondir) % smp::count;
                 std::unordered_set<sstring> table_names;
                 for (auto& sst : tables) {
@@ -1379,7 +1472,7 @@ future<> table::snapshot(database& db, sstring name, bool skip_flush) {
                     auto rf = f.substr(sst->get_dir().size() + 1);
                     table_names.insert(std::move(rf));
                 }
-                return smp::submit_to(shard, [requester = this_shard_id(), &jsondir, this, &db,
+                return smp::submit_to(shard, [requester = this_shard_id(), &jsondir, &base_jsondir, this, &db,
                                               tables = std::move(table_names), datadir = _config.datadir] {
 
                     if (!pending_snapshots.contains(jsondir)) {
@@ -1395,7 +1488,7 @@ future<> table::snapshot(database& db, sstring name, bool skip_flush) {
                     auto my_work = make_ready_future<>();
                     if (requester == this_shard_id()) {
                         tlogger.debug("snapshot {}: waiting for all shards", jsondir);
-                        my_work = snapshot->requests.wait(smp::count).then([&jsondir,
+                        my_work = snapshot->requests.wait(smp::count).then([&jsondir, &base_jsondir,
                                                                             &db, snapshot, this] {
                             // this_shard_id() here == requester == this_shard_id() before submit_to() above,
                             // so the db reference is still local
@@ -1403,9 +1496,11 @@ future<> table::snapshot(database& db, sstring name, bool skip_flush) {
                             return write_schema_as_cql(db, jsondir).handle_exception([&jsondir](std::exception_ptr ptr) {
                                 tlogger.error("Failed writing schema file in snapshot in {} with exception {}", jsondir, ptr);
                                 return make_ready_future<>();
-                            }).finally([&jsondir, snapshot] () mutable {
+                            }).finally([&jsondir, &base_jsondir, snapshot] () mutable {
                                 tlogger.debug("snapshot {}: seal_snapshot", jsondir);
-                                return seal_snapshot(jsondir).handle_exception([&jsondir] (std::exception_ptr ex) {
+                                return seal_snapshot(jsondir, base_jsondir).finally([&jsondir] {
+                                    pending_snapshots.erase(jsondir);
+                                }).handle_exception([&jsondir] (std::exception_ptr ex) {
                                     tlogger.error("Failed to seal snapshot in {}: {}. Ignored.", jsondir, ex);
                                 }).then([snapshot, &jsondir] {
                                     tlogger.debug("snapshot {}: done", jsondir);
@@ -1557,8 +1652,9 @@ future<db::replay_position> table::discard_sstables(db_clock::time_point truncat
         }
     };
     auto p = make_lw_shared<pruner>(*this);
-    return _cache.invalidate(row_cache::external_updater([p, truncated_at] {
+    return _cache.invalidate(row_cache::external_updater([this, p, truncated_at] {
         p->prune(truncated_at);
+        invalidate_counter_shard_cache();
         tlogger.debug("cleaning out row cache");
     })).then([this, p]() mutable {
         rebuild_statistics();
@@ -1587,6 +1683,7 @@ void table::set_schema(schema_ptr s) {
     if (_counter_cell_locks) {
         _counter_cell_locks->set_schema(s);
     }
+    invalidate_counter_shard_cache();
     _schema = std::move(s);
 
     for (auto&& v : _views) {
@@ -1850,6 +1947,26 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+// Readers of sstables take memory for their buffers and index, count it for
+// up to this many sstables, so that reads of many sstables aren't refused
+// admission outright.
+static constexpr unsigned max_sstables_in_read_memory_estimate = 8;
+
+reader_concurrency_semaphore::read_cost table::estimate_read_cost(const dht::partition_range_vector& ranges, const query::partition_slice& slice) {
+    const auto bypass_cache = slice.options.contains(query::partition_slice::option::bypass_cache)
+            || (slice.is_reversed() && _config.reversed_reads_auto_bypass_cache());
+    unsigned io = 0;
+    for (auto& pr : ranges) {
+        if (cache_enabled() && !bypass_cache && pr.is_singular() && pr.start()->value().has_key()
+                && _cache.is_fully_cached(pr.start()->value().as_decorated_key())) {
+            continue;
+        }
+        io += _sstables->select(pr).size();
+    }
+    auto memory = new_reader_base_cost * std::clamp(io, 1u, max_sstables_in_read_memory_estimate);
+    return reader_concurrency_semaphore::read_cost{size_t(memory), io};
+}
+
 void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
@@ -1938,9 +2055,16 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
         return (*_virtual_writer)(m);
     }
 
-    return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h)]() mutable {
-        do_apply(std::move(h), m, m_schema);
-    }, timeout);
+    auto apply = [this, &m, m_schema = std::move(m_schema), h = std::move(h), timeout] () mutable {
+        return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h)]() mutable {
+            do_apply(std::move(h), m, m_schema);
+        }, timeout);
+    };
+    auto delay = _config.dirty_memory_manager->write_throttle_delay(m.representation().size());
+    if (!delay.count()) [[likely]] {
+        return apply();
+    }
+    return sleep(delay).then(std::move(apply));
 }
 
 template void table::do_apply(db::rp_handle&&, const frozen_mutation&, const schema_ptr&);
@@ -2162,6 +2286,34 @@ std::chrono::milliseconds table::get_coordinator_read_latency_percentile(double
     return _percentile_cache_value;
 }
 
+void table::add_replica_read_latency(gms::inet_address addr, utils::estimated_histogram::duration latency) {
+    using namespace std::chrono;
+    auto sample = duration_cast<microseconds>(latency);
+    auto [it, inserted] = _replica_read_latencies.try_emplace(addr);
+    auto& e = it->second;
+    if (inserted || lowres_clock::now() - e.last_updated > replica_read_latency_expiry) {
+        e.mean = sample;
+        e.deviation = sample / 2;
+    } else {
+        auto error = sample - e.mean;
+        e.mean += error / 8;
+        e.deviation += (std::chrono::abs(error) - e.deviation) / 4;
+    }
+    e.last_updated = lowres_clock::now();
+}
+
+std::optional<table::replica_read_latency> table::get_replica_read_latency(gms::inet_address addr) const {
+    auto it = _replica_read_latencies.find(addr);
+    if (it == _replica_read_latencies.end() || lowres_clock::now() - it->second.last_updated > replica_read_latency_expiry) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void table::drop_replica_read_latency(gms::inet_address addr) {
+    _replica_read_latencies.erase(addr);
+}
+
 void
 table::enable_auto_compaction() {
     // FIXME: unmute backlog. turn table backlog back on.
@@ -2387,6 +2539,9 @@ class table::table_state : public compaction::table_state {
     bool compaction_enforce_min_threshold() const noexcept override {
         return _t.get_config().compaction_enforce_min_threshold || _t._is_bootstrap_or_replace;
     }
+    bool compaction_split_unpurgeable_tombstones() const noexcept override {
+        return _t.get_config().compaction_split_unpurgeable_tombstones();
+    }
     const sstables::sstable_set& get_sstable_set() const override {
         return _t.get_sstable_set();
     }
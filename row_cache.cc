@@ -14,6 +14,7 @@
 #include <seastar/util/defer.hh>
 #include "replica/memtable.hh"
 #include <chrono>
+#include <random>
 #include <boost/version.hpp>
 #include <sys/sdt.h>
 #include "read_context.hh"
@@ -64,6 +65,7 @@ cache_tracker::cache_tracker(mutation_application_stats& app_stats, register_met
         setup_metrics();
     }
 
+    _region.set_owner("cache");
     _region.make_evictable([this] {
         return with_allocator(_region.allocator(), [this] {
           // Removing a partition may require reading large keys when we rebalance
@@ -138,6 +140,28 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of range tombstones processed during read")),
         sm::make_derive("row_tombstone_reads", _stats.row_tombstone_reads,
             sm::description("total amount of row tombstones processed during read")),
+        sm::make_derive("probationary_reads", _stats.probationary_reads,
+            sm::description("number of reads which populated the probationary segment of the LRU and didn't promote entries from it")),
+        sm::make_derive("probationary_row_insertions", _stats.probationary_row_insertions,
+            sm::description("total number of rows added to the probationary segment of the LRU")),
+        sm::make_derive("row_promotions", _stats.row_promotions,
+            sm::description("total number of rows moved from the probationary to the protected segment of the LRU")),
+        sm::make_derive("probationary_evictions", [this] { return _lru.probationary_evictions(); },
+            sm::description("total number of entries evicted from the probationary segment of the LRU")),
+        sm::make_derive("reserved_row_deferrals", _stats.reserved_row_deferrals,
+            sm::description("number of times the eviction of a row was deferred because its table held less than its reserved fraction of the cache")),
+        sm::make_derive("mvcc_multi_version_reads", _stats.multi_version_reads,
+            sm::description("number of reads of partitions which had more than one version, which readers merge on the fly")),
+        sm::make_derive("mvcc_multi_version_read_versions", _stats.multi_version_read_versions,
+            sm::description("total number of versions of the partitions counted by mvcc_multi_version_reads; divided by it, the average length of their version chains")),
+        sm::make_gauge("mvcc_pending_merges", [this] { return _garbage.pending_merges(); },
+            sm::description("number of released partition snapshots whose versions wait to be merged in the background")),
+        sm::make_derive("mvcc_merges", [this] { return _garbage.get_stats().merges; },
+            sm::description("number of partition snapshots whose versions were merged")),
+        sm::make_derive("mvcc_merge_steps", [this] { return _garbage.get_stats().merge_steps; },
+            sm::description("number of preemptible steps taken to merge partition versions")),
+        sm::make_derive("mvcc_merge_time_us", [this] { return _garbage.get_stats().merge_time.count(); },
+            sm::description("total time spent merging partition versions, in microseconds")),
     });
 }
 
@@ -157,23 +181,121 @@ void cache_tracker::clear() {
     allocator().invalidate_references();
 }
 
-void cache_tracker::touch(rows_entry& e) {
+void cache_tracker::touch(rows_entry& e, bool promote) {
+    // An entry which is not linked (the last dummy, when evicted) goes to
+    // the protected segment, as it may have been in it before.
+    bool probationary = !promote && e.is_probationary() && e.is_linked();
+    if (promote && e.is_probationary()) {
+        ++_stats.row_promotions;
+    }
     // last dummy may not be linked if evicted, but
     // the unlink_from_lru() handles it
     e.unlink_from_lru();
-    _lru.add(e);
+    e.set_probationary(probationary);
+    if (probationary) {
+        _lru.add_probationary(e);
+    } else {
+        _lru.add(e);
+    }
+}
+
+uint64_t cache_tracker::key_hash(const schema& s, const dht::decorated_key& dk) noexcept {
+    // Tokens are already well mixed.
+    return uint64_t(dk.token().raw()) ^ std::hash<utils::UUID>()(s.id());
+}
+
+bool cache_tracker::admit(uint64_t key_hash) noexcept {
+    _read_frequency.increment(key_hash);
+    // The first read in a while doesn't promote, the next one does.
+    return _read_frequency.frequency(key_hash) < 2;
+}
+
+cache_tracker::table_stats* cache_tracker::find_table(const schema& s) noexcept {
+    auto i = _tables.find(s.id());
+    return i == _tables.end() ? nullptr : &i->second;
+}
+
+const cache_tracker::table_stats* cache_tracker::get_table_stats(const utils::UUID& table_id) const noexcept {
+    auto i = _tables.find(table_id);
+    return i == _tables.end() ? nullptr : &i->second;
+}
+
+void cache_tracker::register_table(const schema& s) {
+    ++_tables[s.id()].caches;
+    update_table_quotas(s);
+}
+
+void cache_tracker::unregister_table(const schema& s) noexcept {
+    auto i = _tables.find(s.id());
+    if (i != _tables.end() && --i->second.caches == 0) {
+        _tables_with_reservation -= i->second.min_fraction > 0;
+        _tables.erase(i);
+    }
 }
 
-void cache_tracker::insert(cache_entry& entry) {
-    insert(entry.partition());
+void cache_tracker::update_table_quotas(const schema& s) noexcept {
+    auto t = find_table(s);
+    if (!t) {
+        return;
+    }
+    _tables_with_reservation -= t->min_fraction > 0;
+    t->min_fraction = s.caching_options().min_fraction();
+    t->max_fraction = s.caching_options().max_fraction();
+    _tables_with_reservation += t->min_fraction > 0;
+}
+
+bool cache_tracker::is_probationary(const schema& s, bool probationary) noexcept {
+    auto t = find_table(s);
+    if (!t) {
+        return probationary;
+    }
+    if (t->partitions > t->max_fraction * _stats.partitions) {
+        return true;
+    }
+    if (t->partitions < t->min_fraction * _stats.partitions) {
+        return false;
+    }
+    return probationary;
+}
+
+bool cache_tracker::defer_eviction(rows_entry& e) noexcept {
+    if (!_tables_with_reservation) {
+        return false;
+    }
+    mutation_partition::rows_type::iterator it(&e);
+    partition_version& pv = partition_version::container_of(mutation_partition::container_of(*it.tree_slow()));
+    // Moving the entry ahead of the entries of other versions would break
+    // the order of eviction between versions. Entries of versions which are
+    // only referenced by snapshots are left alone too, their table can't be told.
+    if (pv.next() || !pv.is_referenced_from_entry()) {
+        return false;
+    }
+    cache_entry& ce = cache_entry::container_of(partition_entry::container_of(pv));
+    auto t = find_table(*ce.schema());
+    if (!t || t->partitions >= t->min_fraction * _stats.partitions) {
+        return false;
+    }
+    ++_stats.reserved_row_deferrals;
+    touch(e);
+    return true;
+}
+
+void cache_tracker::insert(cache_entry& entry, bool probationary) {
+    insert(entry.partition(), probationary);
     ++_stats.partition_insertions;
     ++_stats.partitions;
+    if (auto t = find_table(*entry.schema())) {
+        ++t->partitions;
+    }
     // partition_range_cursor depends on this to detect invalidation of _end
     _region.allocator().invalidate_references();
 }
 
-void cache_tracker::on_partition_erase() noexcept {
+void cache_tracker::on_partition_erase(const schema& s) noexcept {
     --_stats.partitions;
+    if (auto t = find_table(s)) {
+        --t->partitions;
+    }
     ++_stats.partition_removals;
     allocator().invalidate_references();
 }
@@ -190,9 +312,13 @@ void cache_tracker::on_partition_miss() noexcept {
     ++_stats.partition_misses;
 }
 
-void cache_tracker::on_partition_eviction() noexcept {
+void cache_tracker::on_partition_eviction(const schema& s) noexcept {
     --_stats.partitions;
     ++_stats.partition_evictions;
+    if (auto t = find_table(s)) {
+        --t->partitions;
+        ++t->partition_evictions;
+    }
 }
 
 void cache_tracker::on_row_eviction() noexcept {
@@ -216,6 +342,13 @@ void cache_tracker::on_mispopulate() noexcept {
     ++_stats.mispopulations;
 }
 
+void cache_tracker::on_partition_snapshot_read(unsigned versions) noexcept {
+    if (versions > 1) {
+        ++_stats.multi_version_reads;
+        _stats.multi_version_read_versions += versions;
+    }
+}
+
 void cache_tracker::on_miss_already_populated() noexcept {
     ++_stats.concurrent_misses_same_key;
 }
@@ -369,7 +502,7 @@ class single_partition_populating_reader final : public flat_mutation_reader::im
             if (!mfopt) {
                 if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                     _cache._read_section(_cache._tracker.region(), [this] {
-                        _cache.find_or_create_missing(_read_context->key());
+                        _cache.find_or_create_missing(_read_context->key(), _read_context->is_probationary());
                     });
                 } else {
                     _cache._tracker.on_mispopulate();
@@ -377,7 +510,8 @@ class single_partition_populating_reader final : public flat_mutation_reader::im
                 _end_of_stream = true;
             } else if (phase == _cache.phase_of(_read_context->range().start()->value())) {
                 _reader = _cache._read_section(_cache._tracker.region(), [&] {
-                    cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase);
+                    cache_entry& e = _cache.find_or_create_incomplete(mfopt->as_partition_start(), phase, nullptr,
+                                                                      _read_context->is_probationary());
                     return e.read(_cache, *_read_context, phase);
                 });
             } else {
@@ -525,7 +659,8 @@ class range_populating_reader {
                 if (_reader.creation_phase() == _cache.phase_of(key)) {
                     return _cache._read_section(_cache._tracker.region(), [&] {
                         cache_entry& e = _cache.find_or_create_incomplete(ps, _reader.creation_phase(),
-                                                               this->can_set_continuity() ? &*_last_key : nullptr);
+                                                               this->can_set_continuity() ? &*_last_key : nullptr,
+                                                               _read_context.is_probationary());
                         _last_key = row_cache::previous_entry_pointer(key);
                         return make_ready_future<read_result>(
                                 read_result(e.read(_cache, _read_context, _reader.creation_phase()), std::nullopt));
@@ -779,17 +914,18 @@ row_cache::~row_cache() {
     with_allocator(_tracker.allocator(), [this] {
         _partitions.clear_and_dispose([this] (cache_entry* p) mutable noexcept {
             if (!p->is_dummy_entry()) {
-                _tracker.on_partition_erase();
+                _tracker.on_partition_erase(*p->schema());
             }
             p->evict(_tracker);
         });
     });
+    _tracker.unregister_table(*_schema);
 }
 
 void row_cache::clear_now() noexcept {
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
-            _tracker.on_partition_erase();
+            _tracker.on_partition_erase(*p->schema());
             p->evict(_tracker);
         });
         _tracker.clear_continuity(*it);
@@ -830,13 +966,14 @@ cache_entry& row_cache::do_find_or_create_entry(const dht::decorated_key& key,
     });
 }
 
-cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous) {
+cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous,
+        bool probationary) {
     return do_find_or_create_entry(ps.key(), previous, [&] (auto i, const partitions_type::bound_hint& hint) { // create
         // Create an fully discontinuous, except for the partition tombstone, entry
         mutation_partition mp = mutation_partition::make_incomplete(*_schema, ps.partition_tombstone());
         partitions_type::iterator entry = _partitions.emplace_before(i, ps.key().token().raw(), hint,
                 _schema, ps.key(), std::move(mp));
-        _tracker.insert(*entry);
+        _tracker.insert(*entry, probationary);
         return entry;
     }, [&] (auto i) { // visit
         _tracker.on_miss_already_populated();
@@ -846,13 +983,13 @@ cache_entry& row_cache::find_or_create_incomplete(const partition_start& ps, row
     });
 }
 
-cache_entry& row_cache::find_or_create_missing(const dht::decorated_key& key) {
+cache_entry& row_cache::find_or_create_missing(const dht::decorated_key& key, bool probationary) {
     return do_find_or_create_entry(key, nullptr, [&] (auto i, const partitions_type::bound_hint& hint) {
         mutation_partition mp(_schema);
         bool cont = i->continuous();
         partitions_type::iterator entry = _partitions.emplace_before(i, key.token().raw(), hint,
                 _schema, key, std::move(mp));
-        _tracker.insert(*entry);
+        _tracker.insert(*entry, probationary);
         entry->set_continuous(cont);
         return entry;
     }, [&] (auto i) {
@@ -968,13 +1105,33 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                           STAP_PROBE(scylla, row_cache_update_partition_start);
                           {
                             if (!update) {
+                                // Partitions whose update has nothing to apply, like those absent
+                                // from cache, are completed in the section which looks them up.
+                                // A run of them, typical of a flush, then shares a single section.
                                 _update_section(_tracker.region(), [&] {
-                                    replica::memtable_entry& mem_e = *m.partitions.begin();
-                                    size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
-                                    partitions_type::bound_hint hint;
-                                    auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
-                                    update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint);
+                                    while (true) {
+                                        replica::memtable_entry& mem_e = *m.partitions.begin();
+                                        size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
+                                        partitions_type::bound_hint hint;
+                                        auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
+                                        update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint);
+                                        if (update) {
+                                            return;
+                                        }
+                                        real_dirty_acc.unpin_memory(size_entry);
+                                        auto i = m.partitions.begin();
+                                        i.erase_and_dispose(dht::raw_token_less_comparator{}, [&] (replica::memtable_entry* e) noexcept {
+                                            m.evict_entry(*e, _tracker.memtable_cleaner());
+                                        });
+                                        ++partition_count;
+                                        if (m.partitions.empty() || need_preempt()) {
+                                            return;
+                                        }
+                                    }
                                 });
+                                if (!update) {
+                                    continue;
+                                }
                             }
                             // We use cooperative deferring instead of futures so that
                             // this layer has a chance to restore invariants before deferring,
@@ -1083,6 +1240,68 @@ void row_cache::touch(const dht::decorated_key& dk) {
  });
 }
 
+bool row_cache::is_fully_cached(const dht::decorated_key& dk) {
+  return _read_section(_tracker.region(), [&] {
+    auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
+    if (i == _partitions.end()) {
+        return false;
+    }
+    // The continuity of the partition is the union of the continuity of its versions.
+    for (partition_version& pv : i->partition().versions_from_oldest()) {
+        if (pv.partition().is_fully_continuous()) {
+            return true;
+        }
+    }
+    return false;
+  });
+}
+
+void row_cache::on_repeated_read(const dht::decorated_key& dk) {
+    if (!_hot_key_sample_size || _hot_key_tokens.contains(dk.token().raw())) {
+        return;
+    }
+    // Reservoir sampling: each read ends up in the sample with equal probability.
+    static thread_local std::default_random_engine random_engine(std::random_device{}());
+    auto i = _hot_key_reads++;
+    if (_hot_keys.size() < _hot_key_sample_size) {
+        _hot_keys.push_back(dk);
+    } else {
+        i = std::uniform_int_distribution<uint64_t>(0, i)(random_engine);
+        if (i >= _hot_key_sample_size) {
+            return;
+        }
+        _hot_key_tokens.erase(_hot_keys[i].token().raw());
+        _hot_keys[i] = dk;
+    }
+    _hot_key_tokens.insert(dk.token().raw());
+}
+
+void row_cache::set_hot_key_sample_size(size_t n) {
+    _hot_key_sample_size = n;
+    if (_hot_keys.size() > n) {
+        for (auto i = n; i < _hot_keys.size(); ++i) {
+            _hot_key_tokens.erase(_hot_keys[i].token().raw());
+        }
+        _hot_keys.erase(_hot_keys.begin() + n, _hot_keys.end());
+    }
+}
+
+std::vector<row_cache::hot_key> row_cache::take_hot_keys() {
+    std::vector<hot_key> ret;
+    ret.reserve(_hot_keys.size());
+    for (auto& dk : _hot_keys) {
+        auto frequency = _tracker.read_frequency(cache_tracker::key_hash(*_schema, dk));
+        ret.push_back(hot_key{std::move(dk), frequency});
+    }
+    std::stable_sort(ret.begin(), ret.end(), [] (const hot_key& a, const hot_key& b) {
+        return a.frequency > b.frequency;
+    });
+    _hot_keys.clear();
+    _hot_key_tokens.clear();
+    _hot_key_reads = 0;
+    return ret;
+}
+
 void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
     _read_section(_tracker.region(), [&] {
         auto i = _partitions.find(dk, dht::ring_position_comparator(*_schema));
@@ -1103,7 +1322,7 @@ void row_cache::invalidate_locked(const dht::decorated_key& dk) {
     } else {
         auto it = pos.erase_and_dispose(dht::raw_token_less_comparator{},
             [this](cache_entry* p) mutable noexcept {
-                _tracker.on_partition_erase();
+                _tracker.on_partition_erase(*p->schema());
                 p->evict(_tracker);
             });
         _tracker.clear_continuity(*it);
@@ -1140,7 +1359,7 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
                             while (it != end) {
                                 it = it.erase_and_dispose(dht::raw_token_less_comparator{},
                                     [&] (cache_entry* p) mutable noexcept {
-                                        _tracker.on_partition_erase();
+                                        _tracker.on_partition_erase(*p->schema());
                                         p->evict(_tracker);
                                     });
                                 // it != end is necessary for correctness. We cannot set _prev_snapshot_pos to end->position()
@@ -1187,6 +1406,7 @@ row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker,
         entry.set_continuous(bool(cont));
         _partitions.insert(entry.position().token().raw(), std::move(entry), dht::ring_position_comparator{*_schema});
     });
+    _tracker.register_table(*_schema);
 }
 
 cache_entry::cache_entry(cache_entry&& o) noexcept
@@ -1206,13 +1426,14 @@ void cache_entry::evict(cache_tracker& tracker) noexcept {
 
 void row_cache::set_schema(schema_ptr new_schema) noexcept {
     _schema = std::move(new_schema);
+    _tracker.update_table_quotas(*_schema);
 }
 
 void cache_entry::on_evicted(cache_tracker& tracker) noexcept {
     row_cache::partitions_type::iterator it(this);
     std::next(it)->set_continuous(false);
     evict(tracker);
-    tracker.on_partition_eviction();
+    tracker.on_partition_eviction(*_schema);
     it.erase(dht::raw_token_less_comparator{});
 }
 
@@ -1255,6 +1476,10 @@ void rows_entry::on_evicted() noexcept {
     on_evicted(*current_tracker);
 }
 
+bool rows_entry::defer_eviction() noexcept {
+    return current_tracker->defer_eviction(*this);
+}
+
 flat_mutation_reader cache_entry::read(row_cache& rc, read_context& reader) {
     auto source_and_phase = rc.snapshot_of(_key);
     reader.enter_partition(_key, source_and_phase.snapshot, source_and_phase.phase);
@@ -1280,6 +1505,7 @@ flat_mutation_reader cache_entry::read(row_cache& rc, std::unique_ptr<read_conte
 // Assumes reader is in the corresponding partition
 flat_mutation_reader cache_entry::do_read(row_cache& rc, read_context& reader) {
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), _schema, &rc._tracker, reader.phase());
+    rc._tracker.on_partition_snapshot_read(snp->version_count());
     auto ckr = query::clustering_key_filter_ranges::get_native_ranges(*_schema, reader.native_slice(), _key.key());
     schema_ptr entry_schema = to_query_domain(reader.slice(), _schema);
     auto r = make_cache_flat_mutation_reader(entry_schema, _key, std::move(ckr), rc, reader, std::move(snp));
@@ -1290,6 +1516,7 @@ flat_mutation_reader cache_entry::do_read(row_cache& rc, read_context& reader) {
 
 flat_mutation_reader cache_entry::do_read(row_cache& rc, std::unique_ptr<read_context> unique_ctx) {
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), _schema, &rc._tracker, unique_ctx->phase());
+    rc._tracker.on_partition_snapshot_read(snp->version_count());
     auto ckr = query::clustering_key_filter_ranges::get_native_ranges(*_schema, unique_ctx->native_slice(), _key.key());
     schema_ptr reader_schema = unique_ctx->schema();
     schema_ptr entry_schema = to_query_domain(unique_ctx->slice(), _schema);
@@ -15,6 +15,8 @@
 #include <seastar/core/memory.hh>
 #include <seastar/util/noncopyable_function.hh>
 
+#include <unordered_set>
+
 #include "mutation_reader.hh"
 #include "mutation_partition.hh"
 #include "utils/phased_barrier.hh"
@@ -257,6 +259,15 @@ class row_cache final {
     logalloc::allocating_section _update_section;
     logalloc::allocating_section _populate_section;
     logalloc::allocating_section _read_section;
+
+    // A uniform sample of the single-partition reads which weren't probationary
+    // (see cache_tracker::admit()), at most one entry per token.
+    std::vector<dht::decorated_key> _hot_keys;
+    std::unordered_set<int64_t> _hot_key_tokens;
+    size_t _hot_key_sample_size = 0;
+    uint64_t _hot_key_reads = 0;
+    void on_repeated_read(const dht::decorated_key&);
+
     flat_mutation_reader create_underlying_reader(cache::read_context&, mutation_source&, const dht::partition_range&);
     flat_mutation_reader make_scanning_reader(const dht::partition_range&, std::unique_ptr<cache::read_context>);
     void on_partition_hit();
@@ -294,11 +305,12 @@ class row_cache final {
     // The entry which is returned will have the tombstone applied to it.
     //
     // Must be run under reclaim lock
-    cache_entry& find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous = nullptr);
+    cache_entry& find_or_create_incomplete(const partition_start& ps, row_cache::phase_type phase, const previous_entry_pointer* previous = nullptr,
+            bool probationary = false);
 
     // Creates (or touches) a cache entry for missing partition so that sstables are not
     // poked again for it.
-    cache_entry& find_or_create_missing(const dht::decorated_key& key);
+    cache_entry& find_or_create_missing(const dht::decorated_key& key, bool probationary = false);
 
     partitions_type::iterator partitions_end() {
         return std::prev(_partitions.end());
@@ -421,6 +433,23 @@ class row_cache final {
     // Moves given partition to the front of LRU if present in cache.
     void touch(const dht::decorated_key&);
 
+    // Returns true if the whole partition is present in cache, so reading it
+    // doesn't go to the underlying source.
+    bool is_fully_cached(const dht::decorated_key&);
+
+    // Sets the number of keys of repeatedly read partitions sampled by the cache.
+    // 0, the default, disables sampling.
+    void set_hot_key_sample_size(size_t);
+
+    struct hot_key {
+        dht::decorated_key key;
+        // See cache_tracker::read_frequency().
+        unsigned frequency;
+    };
+
+    // Returns the hot key sample, hottest first, and starts a new one.
+    std::vector<hot_key> take_hot_keys();
+
     // Detaches current contents of given partition from LRU, so
     // that they are not evicted by memory reclaimer.
     void unlink_from_lru(const dht::decorated_key&);
@@ -29,6 +29,7 @@
 #include "cdc/cdc_extension.hh"
 #include "tombstone_gc_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/write_coalescing_extension.hh"
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 
@@ -506,6 +507,7 @@ bool operator==(const schema& x, const schema& y)
         && x._raw._type == y._raw._type
         && x._raw._gc_grace_seconds == y._raw._gc_grace_seconds
         && x.paxos_grace_seconds() == y.paxos_grace_seconds()
+        && x._raw._write_coalescing_window_in_us == y._raw._write_coalescing_window_in_us
         && x._raw._dc_local_read_repair_chance == y._raw._dc_local_read_repair_chance
         && x._raw._read_repair_chance == y._raw._read_repair_chance
         && x._raw._min_compaction_threshold == y._raw._min_compaction_threshold
@@ -1268,6 +1270,12 @@ schema_ptr schema_builder::build() {
         new_raw._paxos_grace_seconds =
             dynamic_pointer_cast<db::paxos_grace_seconds_extension>(it->second)->get_paxos_grace_seconds();
     }
+    // same for `write_coalescing_window_in_us`, checked on every write
+    if (auto it = new_raw._extensions.find(db::write_coalescing_extension::NAME); it != new_raw._extensions.end()) {
+        if (auto ext = dynamic_pointer_cast<db::write_coalescing_extension>(it->second)) {
+            new_raw._write_coalescing_window_in_us = ext->get_window_in_us();
+        }
+    }
 
     return make_lw_shared<schema>(schema::private_tag{}, new_raw, _view_info);
 }
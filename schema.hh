@@ -618,6 +618,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         cf_type _type = cf_type::standard;
         int32_t _gc_grace_seconds = DEFAULT_GC_GRACE_SECONDS;
         std::optional<int32_t> _paxos_grace_seconds;
+        int32_t _write_coalescing_window_in_us = 0;
         double _dc_local_read_repair_chance = 0.0;
         double _read_repair_chance = 0.0;
         double _crc_check_chance = 1;
@@ -762,6 +763,12 @@ class schema final : public enable_lw_shared_from_this<schema> {
 
     gc_clock::duration paxos_grace_seconds() const;
 
+    // How long replicas hold writes to a partition to merge them with the
+    // following ones, see db::write_coalescing_extension. Zero if they don't.
+    std::chrono::microseconds write_coalescing_window() const {
+        return std::chrono::microseconds(_raw._write_coalescing_window_in_us);
+    }
+
     double dc_local_read_repair_chance() const {
         return _raw._dc_local_read_repair_chance;
     }
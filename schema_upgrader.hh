@@ -11,22 +11,89 @@
 #include "mutation_fragment.hh"
 #include "converting_mutation_partition_applier.hh"
 
+// Maps the cells of rows of one schema version to another.
+//
+// The mapping is computed once per pair of versions, rather than looking up
+// each cell's column by name. Cells of columns which kept their type and have
+// no drop record are moved as is, without conversion. If all cells of a row
+// kind keep their column id too, which is the common case of adding a column
+// that sorts after the others, rows of that kind are passed through
+// untouched.
+class schema_upgrade_mapping {
+    struct column_map_entry {
+        // nullptr if the column is not in the new schema.
+        const column_definition* new_def = nullptr;
+        // True if the cells have to go through
+        // converting_mutation_partition_applier::append_cell().
+        bool convert = false;
+    };
+
+    const schema* _prev;
+    std::vector<column_map_entry> _static_columns;
+    std::vector<column_map_entry> _regular_columns;
+    bool _static_identity = true;
+    bool _regular_identity = true;
+private:
+    static void map_columns(const schema::const_iterator_range_type& prev_columns, const schema& next,
+            std::vector<column_map_entry>& mapping, bool& identity) {
+        mapping.reserve(prev_columns.size());
+        for (const column_definition& col : prev_columns) {
+            auto& m = mapping.emplace_back();
+            m.new_def = next.get_column_definition(col.name());
+            if (!m.new_def) {
+                identity = false;
+                continue;
+            }
+            m.convert = m.new_def->kind != col.kind
+                    || m.new_def->type != col.type
+                    || m.new_def->dropped_at() != api::missing_timestamp;
+            identity &= !m.convert && m.new_def->id == col.id;
+        }
+    }
+    const std::vector<column_map_entry>& columns(column_kind kind) const {
+        return kind == column_kind::static_column ? _static_columns : _regular_columns;
+    }
+    bool is_identity(column_kind kind) const {
+        return kind == column_kind::static_column ? _static_identity : _regular_identity;
+    }
+public:
+    schema_upgrade_mapping(const schema& prev, const schema& next)
+        : _prev(&prev)
+    {
+        map_columns(prev.static_columns(), next, _static_columns, _static_identity);
+        map_columns(prev.regular_columns(), next, _regular_columns, _regular_identity);
+    }
+
+    row transform(row&& r, column_kind kind) const {
+        if (is_identity(kind)) {
+            return std::move(r);
+        }
+        const auto& mapping = columns(kind);
+        row new_row;
+        r.for_each_cell([&] (column_id id, atomic_cell_or_collection& cell) {
+            const column_map_entry& m = mapping[id];
+            if (!m.new_def) {
+                return;
+            }
+            if (m.convert) {
+                converting_mutation_partition_applier::append_cell(new_row, kind, *m.new_def, _prev->column_at(kind, id), std::move(cell));
+            } else {
+                new_row.apply(*m.new_def, std::move(cell));
+            }
+        });
+        return new_row;
+    }
+};
+
 // A StreamedMutationTransformer which transforms the stream to a different schema
 class schema_upgrader {
     schema_ptr _prev;
     schema_ptr _new;
+    std::optional<schema_upgrade_mapping> _mapping;
     std::optional<reader_permit> _permit;
 private:
     row transform(row&& r, column_kind kind) {
-        row new_row;
-        r.for_each_cell([&] (column_id id, atomic_cell_or_collection& cell) {
-            const column_definition& col = _prev->column_at(kind, id);
-            const column_definition* new_col = _new->get_column_definition(col.name());
-            if (new_col) {
-                converting_mutation_partition_applier::append_cell(new_row, kind, *new_col, col, std::move(cell));
-            }
-        });
-        return new_row;
+        return _mapping->transform(std::move(r), kind);
     }
 public:
     schema_upgrader(schema_ptr s)
@@ -34,6 +101,7 @@ class schema_upgrader {
     { }
     schema_ptr operator()(schema_ptr old) {
         _prev = std::move(old);
+        _mapping.emplace(*_prev, *_new);
         return _new;
     }
     mutation_fragment consume(static_row&& row) {
@@ -62,18 +130,11 @@ class schema_upgrader {
 class schema_upgrader_v2 {
     schema_ptr _prev;
     schema_ptr _new;
+    std::optional<schema_upgrade_mapping> _mapping;
     std::optional<reader_permit> _permit;
 private:
     row transform(row&& r, column_kind kind) {
-        row new_row;
-        r.for_each_cell([&] (column_id id, atomic_cell_or_collection& cell) {
-            const column_definition& col = _prev->column_at(kind, id);
-            const column_definition* new_col = _new->get_column_definition(col.name());
-            if (new_col) {
-                converting_mutation_partition_applier::append_cell(new_row, kind, *new_col, col, std::move(cell));
-            }
-        });
-        return new_row;
+        return _mapping->transform(std::move(r), kind);
     }
 public:
     schema_upgrader_v2(schema_ptr s)
@@ -81,6 +142,7 @@ class schema_upgrader_v2 {
     { }
     schema_ptr operator()(schema_ptr old) {
         _prev = std::move(old);
+        _mapping.emplace(*_prev, *_new);
         return _new;
     }
     mutation_fragment_v2 consume(static_row&& row) {
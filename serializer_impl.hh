@@ -499,6 +499,9 @@ class deserialized_bytes_proxy {
     [[gnu::always_inline]]
     operator bytes_ostream() && {
         bytes_ostream v;
+        // The stream is usually made of the many small fragments of an rpc
+        // receive buffer, copy them into as few chunks as possible.
+        v.reserve(_stream.size());
         _stream.copy_to(v);
         return v;
     }
@@ -12,6 +12,7 @@
 #include "utils/UUID.hh"
 #include <seastar/core/timer.hh>
 #include <seastar/core/sharded.hh>
+#include <optional>
 
 using namespace seastar;
 
@@ -38,13 +39,23 @@ class cache_hitrate_calculator : public seastar::async_sharded_service<cache_hit
     std::unordered_map<utils::UUID, stat> _rates;
     size_t _slen = 0;
     std::string _gstate;
+    // When the rates were last gossiped, by whichever shard was the
+    // master then. Handed over to the next master by run_on().
+    std::optional<lowres_clock::time_point> _published_at;
     future<> _done = make_ready_future();
 
     future<lowres_clock::duration> recalculate_hitrates();
     void recalculate_timer();
 public:
+    // Other nodes learn this node's hit rates from its read responses,
+    // and only use the gossiped ones until the first response arrives.
+    // So the rates, which are recalculated every few seconds, are gossiped
+    // much less often, to keep them from churning the gossip state.
+    static constexpr auto gossip_interval = std::chrono::seconds(30);
+
     cache_hitrate_calculator(seastar::sharded<replica::database>& db, gms::gossiper& g);
-    void run_on(size_t master, lowres_clock::duration d = std::chrono::milliseconds(2000));
+    void run_on(size_t master, lowres_clock::duration d = std::chrono::milliseconds(2000),
+            std::optional<lowres_clock::time_point> published_at = std::nullopt);
 
     future<> stop();
 };
@@ -17,6 +17,7 @@
 #include "db/consistency_level.hh"
 #include "dht/i_partitioner.hh"
 #include "dht/sharder.hh"
+#include "exceptions/exceptions.hh"
 #include "gms/gossiper.hh"
 #include "idl/forward_request.dist.hh"
 #include "locator/abstract_replication_strategy.hh"
@@ -34,6 +35,9 @@
 
 #include "cql3/column_identifier.hh"
 #include "cql3/cql_config.hh"
+#include "cql3/expr/expression.hh"
+#include "cql3/functions/aggregate_function.hh"
+#include "cql3/functions/functions.hh"
 #include "cql3/query_options.hh"
 #include "cql3/result_set.hh"
 #include "cql3/selection/raw_selector.hh"
@@ -141,47 +145,152 @@ future<> forward_service::stop() {
     return uninit_messaging_service();
 }
 
+data_type reduction_result_type(query::forward_request::reduction_type type, data_type column_type) {
+    switch (type) {
+        case query::forward_request::reduction_type::count:
+        case query::forward_request::reduction_type::count_column:
+            return long_type;
+        case query::forward_request::reduction_type::sum:
+            if (column_type == byte_type || column_type == short_type || column_type == int32_type || column_type == long_type) {
+                return varint_type;
+            }
+            return column_type;
+        case query::forward_request::reduction_type::min:
+        case query::forward_request::reduction_type::max:
+            return column_type;
+    }
+    throw std::runtime_error("unknown reduction type");
+}
+
+static data_type reduction_column_type(const query::forward_request& req, size_t i, const schema& s) {
+    if (req.reduction_types[i] == query::forward_request::reduction_type::count) {
+        return nullptr;
+    }
+    const sstring& name = req.reduction_columns.at(i);
+    auto def = s.get_column_definition(to_bytes(name));
+    if (!def) {
+        throw exceptions::invalid_request_exception(format("Undefined name {} in selection clause", name));
+    }
+    return def->type->underlying_type();
+}
+
 // Due to `cql3::selection::selection` not being serializable, it cannot be
 // stored in `forward_request`. It has to mocked on the receiving node,
 // based on requested reduction types.
 static shared_ptr<cql3::selection::selection> mock_selection(
-    const std::vector<query::forward_request::reduction_type>& reduction_types,
+    const query::forward_request& req,
     schema_ptr schema,
     replica::database& db
 ) {
     std::vector<shared_ptr<cql3::selection::raw_selector>> raw_selectors;
 
-    auto mock_singular_selection = [&] (const query::forward_request::reduction_type& type) {
-        switch (type) {
+    auto mock_aggregate = [&] (sstring name, size_t i) -> cql3::expr::expression {
+        cql3::expr::expression arg = cql3::expr::unresolved_identifier{
+            ::make_shared<cql3::column_identifier::raw>(req.reduction_columns.at(i), true)
+        };
+        if (req.reduction_types[i] == query::forward_request::reduction_type::sum) {
+            auto column_type = reduction_column_type(req, i, *schema);
+            auto result_type = reduction_result_type(req.reduction_types[i], column_type);
+            if (result_type != column_type) {
+                arg = cql3::expr::cast{std::move(arg), result_type->as_cql3_type()};
+            }
+        }
+        return cql3::expr::function_call{
+            cql3::functions::function_name::native_function(std::move(name)),
+            std::vector<cql3::expr::expression>{std::move(arg)}
+        };
+    };
+
+    auto mock_singular_selection = [&] (size_t i) {
+        switch (req.reduction_types[i]) {
             case query::forward_request::reduction_type::count: {
                 auto selectable = cql3::selection::make_count_rows_function_expression();
                 auto column_identifier = make_shared<cql3::column_identifier>("count", false);
                 return make_shared<cql3::selection::raw_selector>(selectable, column_identifier);
             }
+            case query::forward_request::reduction_type::count_column:
+                return make_shared<cql3::selection::raw_selector>(mock_aggregate("count", i), nullptr);
+            case query::forward_request::reduction_type::sum:
+                return make_shared<cql3::selection::raw_selector>(mock_aggregate("sum", i), nullptr);
+            case query::forward_request::reduction_type::min:
+                return make_shared<cql3::selection::raw_selector>(mock_aggregate("min", i), nullptr);
+            case query::forward_request::reduction_type::max:
+                return make_shared<cql3::selection::raw_selector>(mock_aggregate("max", i), nullptr);
         }
+        throw std::runtime_error("unknown reduction type");
     };
 
-    for (auto const& type : reduction_types) {
-        raw_selectors.emplace_back(mock_singular_selection(type));
+    for (size_t i = 0; i < req.reduction_types.size(); i++) {
+        raw_selectors.emplace_back(mock_singular_selection(i));
     }
 
     return cql3::selection::selection::from_selectors(db.as_data_dictionary(), schema, std::move(raw_selectors));
 }
 
+using reducers = std::vector<::shared_ptr<cql3::functions::aggregate_function>>;
+
+// Partial results of reductions are merged with the aggregate functions which
+// computed them: partial minima and maxima are reduced again, partial counts
+// and sums are summed up.
+static reducers get_reducers(const query::forward_request& req, const schema& s) {
+    reducers res;
+    res.reserve(req.reduction_types.size());
+    for (size_t i = 0; i < req.reduction_types.size(); i++) {
+        auto type = req.reduction_types[i];
+        auto result_type = reduction_result_type(type, reduction_column_type(req, i, s));
+        sstring name = type == query::forward_request::reduction_type::min ? "min"
+                : type == query::forward_request::reduction_type::max ? "max"
+                : "sum";
+        auto fn = cql3::functions::functions::find(cql3::functions::function_name::native_function(name), {result_type});
+        auto reducer = dynamic_pointer_cast<cql3::functions::aggregate_function>(fn);
+        if (!reducer) {
+            throw std::runtime_error(format("no function to merge results of {} of type {}", type, result_type->name()));
+        }
+        res.push_back(std::move(reducer));
+    }
+    return res;
+}
+
+static void merge_results(query::forward_result& res, const query::forward_result& other, const reducers& reducers) {
+    if (res.query_results.empty()) {
+        res.query_results.resize(other.query_results.size());
+    }
+
+    if (res.query_results.size() != other.query_results.size() || res.query_results.size() != reducers.size()) {
+        on_internal_error(
+            flogger,
+            format("merge_results(): operation cannot be completed due to invalid argument sizes. "
+                    "res.query_results.size(): {} "
+                    "other.query_results.size(): {} "
+                    "reducers.size(): {}",
+                    res.query_results.size(), other.query_results.size(), reducers.size())
+        );
+    }
+
+    const auto sf = cql_serialization_format::latest();
+    for (size_t i = 0; i < res.query_results.size(); i++) {
+        auto aggregate = reducers[i]->new_aggregate();
+        aggregate->add_input(sf, {res.query_results[i]});
+        aggregate->add_input(sf, {other.query_results[i]});
+        res.query_results[i] = aggregate->compute(sf);
+    }
+}
+
 future<query::forward_result> forward_service::dispatch_to_shards(
     query::forward_request req,
     std::optional<tracing::trace_info> tr_info
 ) {
     _stats.requests_dispatched_to_own_shards += 1;
 
+    auto reducers = get_reducers(req, *local_schema_registry().get(req.cmd.schema_version));
     auto result = co_await container().map_reduce0(
         [req, tr_info] (auto& fs) {
             return fs.execute_on_this_shard(req, tr_info);
         },
         std::optional<query::forward_result>(),
-        [&req] (std::optional<query::forward_result> partial, query::forward_result mapped) -> std::optional<query::forward_result>{
+        [&reducers] (std::optional<query::forward_result> partial, query::forward_result mapped) -> std::optional<query::forward_result>{
             if (partial) {
-                mapped.merge(*partial, req.reduction_types);
+                merge_results(mapped, *partial, reducers);
             }
             return {mapped};
         }
@@ -211,7 +320,7 @@ future<query::forward_result> forward_service::execute_on_this_shard(
     auto timeout = req.timeout;
     auto now = gc_clock::now();
 
-    auto selection = mock_selection(req.reduction_types, schema, _db.local());
+    auto selection = mock_selection(req, schema, _db.local());
     auto query_state = make_lw_shared<service::query_state>(
         client_state::for_internal_calls(),
         tr_state,
@@ -319,10 +428,11 @@ future<query::forward_result> forward_service::dispatch(query::forward_request r
     tracing::trace(tr_state, "Dispatching forward_request to {} endpoints", vnodes_per_addr.size());
 
     std::optional<tracing::trace_info> tr_info = tracing::make_trace_info(tr_state);
+    auto reducers = get_reducers(req, *schema);
     std::optional<query::forward_result> result;
     // Forward request to each endpoint and merge results.
     co_await parallel_for_each(vnodes_per_addr.begin(), vnodes_per_addr.end(),
-        [this, &req, &result, &tr_state, &tr_info] (auto vnodes_with_addr) -> future<> {
+        [this, &req, &result, &tr_state, &tr_info, &reducers] (auto vnodes_with_addr) -> future<> {
             auto& addr = vnodes_with_addr.first;
             auto& partition_range = vnodes_with_addr.second;
             auto req_with_modified_pr = req;
@@ -351,7 +461,7 @@ future<query::forward_result> forward_service::dispatch(query::forward_request r
             flogger.debug("received forward_result={} from {}", partial_result_printer, addr);
 
             if (result) {
-                result->merge(partial_result, req.reduction_types);
+                merge_results(*result, partial_result, reducers);
             } else {
                 result = partial_result;
             }
@@ -17,11 +17,18 @@
 #include "query-request.hh"
 #include "replica/database_fwd.hh"
 #include "tracing/trace_state.hh"
+#include "types.hh"
 
 namespace service {
 
 class storage_proxy;
 
+// Returns the type of the partial results of a reduction of a column of type
+// `column_type` (null for `count`), as computed by shards and merged by
+// `forward_service`. The final result of the aggregate may have another type,
+// see `forward_request::reduction_type::sum`.
+data_type reduction_result_type(query::forward_request::reduction_type type, data_type column_type);
+
 // `forward_service` is a sharded service responsible for distributing and
 // executing aggregation requests across a cluster.
 //
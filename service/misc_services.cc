@@ -125,14 +125,15 @@ void cache_hitrate_calculator::recalculate_timer() {
         } else {
             d = f.get0();
         }
-        p->run_on((this_shard_id() + 1) % smp::count, d);
+        p->run_on((this_shard_id() + 1) % smp::count, d, p->_published_at);
     });
 }
 
-void cache_hitrate_calculator::run_on(size_t master, lowres_clock::duration d) {
+void cache_hitrate_calculator::run_on(size_t master, lowres_clock::duration d, std::optional<lowres_clock::time_point> published_at) {
     if (!_stopped) {
         // Do it in the background.
-        (void)container().invoke_on(master, [d] (cache_hitrate_calculator& local) {
+        (void)container().invoke_on(master, [d, published_at] (cache_hitrate_calculator& local) {
+            local._published_at = published_at;
             local._timer.arm(d);
         }).handle_exception_type([] (seastar::no_sharded_instance_exception&) { /* ignore */ });
     }
@@ -187,13 +188,15 @@ future<lowres_clock::duration> cache_hitrate_calculator::recalculate_hitrates()
     }).then([this] {
         _slen = _gstate.size();
         using namespace std::chrono_literals;
-        return _gossiper.add_local_application_state(gms::application_state::CACHE_HITRATES, gms::versioned_value::cache_hitrates(_gstate)).then([this] {
-            // if max difference during this round is big schedule next recalculate earlier
-            if (_diff < 0.01) {
-                return lowres_clock::duration(2000ms);
-            } else {
-                return lowres_clock::duration(500ms);
-            }
+        // if max difference during this round is big schedule next recalculate earlier
+        auto next = _diff < 0.01 ? lowres_clock::duration(2000ms) : lowres_clock::duration(500ms);
+        auto now = lowres_clock::now();
+        if (_published_at && now - *_published_at < gossip_interval) {
+            return make_ready_future<lowres_clock::duration>(next);
+        }
+        _published_at = now;
+        return _gossiper.add_local_application_state(gms::application_state::CACHE_HITRATES, gms::versioned_value::cache_hitrates(_gstate)).then([next] {
+            return next;
         });
     }).finally([this] {
         _gstate = std::string(); // free memory, do not trust clear() to do that for string
@@ -224,7 +227,13 @@ future<> view_update_backlog_broker::start() {
             std::optional<db::view::update_backlog> backlog_published;
             while (!_as.abort_requested()) {
                 auto backlog = _sp.local().get_view_update_backlog();
-                if (backlog_published && *backlog_published == backlog) {
+                // Replicas also report their backlog in every write response, so small changes
+                // are not worth a new gossip version. Going back to empty always is.
+                auto published_nearly_equal = [&] {
+                    return std::abs(backlog_published->relative_size() - backlog.relative_size()) < min_relative_backlog_change
+                            && (backlog.current != 0 || backlog_published->current == 0);
+                };
+                if (backlog_published && published_nearly_equal()) {
                     sleep_abortable(gms::gossiper::INTERVAL, _as).get();
                     continue;
                 }
@@ -271,7 +280,10 @@ future<> view_update_backlog_broker::on_change(gms::inet_address endpoint, gms::
             return make_ready_future();
         }
         auto backlog = view_update_backlog_timestamped{db::view::update_backlog{current, max}, ticks};
-        auto[it, inserted] = _sp.local()._view_update_backlogs.try_emplace(endpoint, std::move(backlog));
+        auto[it, inserted] = _sp.local()._view_update_backlogs.try_emplace(endpoint, backlog);
+        if (inserted || it->second.ts < backlog.ts) {
+            _sp.local().update_smoothed_view_backlog_of(endpoint, backlog.backlog);
+        }
         if (!inserted && it->second.ts < backlog.ts) {
             it->second = std::move(backlog);
         }
@@ -281,6 +293,7 @@ future<> view_update_backlog_broker::on_change(gms::inet_address endpoint, gms::
 
 future<> view_update_backlog_broker::on_remove(gms::inet_address endpoint) {
     _sp.local()._view_update_backlogs.erase(endpoint);
+    _sp.local()._smoothed_view_update_backlogs.erase(endpoint);
     return make_ready_future();
 }
 
@@ -310,6 +310,11 @@ class query_pager::query_result_visitor : public Base {
         dropped_rows += dropped;
         last_partition_row_count -= dropped;
     }
+    void accept_counted_rows(uint64_t count) {
+        total_rows += count;
+        last_partition_row_count += count;
+        visitor::accept_counted_rows(count);
+    }
 };
 
     template<typename Visitor>
@@ -334,6 +339,11 @@ class query_pager::query_result_visitor : public Base {
         if constexpr(!std::is_same_v<std::decay_t<Visitor>, noop_visitor>) {
             query_result_visitor<Visitor> v(std::forward<Visitor>(visitor));
             view.consume(_cmd->slice, v);
+            // The replicas sent only the last row of each partition, the
+            // result's row count includes the others.
+            if (_cmd->slice.options.contains(query::partition_slice::option::count_only) && results->row_count()) {
+                v.accept_counted_rows(*results->row_count() - v.total_rows);
+            }
 
             if (_last_pkey) {
                 update_slice(*_last_pkey);
@@ -18,7 +18,13 @@ priority_manager::priority_manager()
     , _mt_flush_priority(::io_priority_class::register_one("memtable_flush", 1000))
     , _streaming_priority(::io_priority_class::register_one("streaming", 200))
     , _sstable_query_read(::io_priority_class::register_one("query", 1000))
+    , _sstable_batch_query_read(::io_priority_class::register_one("query_batch", 200))
     , _compaction_priority(::io_priority_class::register_one("compaction", 1000))
 {}
 
+future<> priority_manager::set_batch_query_group(seastar::scheduling_group sg, uint32_t io_shares) {
+    _batch_query_group = sg;
+    return _sstable_batch_query_read.update_shares(io_shares);
+}
+
 }
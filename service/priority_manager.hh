@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <optional>
+
 #include <seastar/core/file.hh>
+#include <seastar/core/scheduling.hh>
 
 #include "seastarx.hh"
 
@@ -17,7 +20,10 @@ class priority_manager {
     ::io_priority_class _mt_flush_priority;
     ::io_priority_class _streaming_priority;
     ::io_priority_class _sstable_query_read;
+    ::io_priority_class _sstable_batch_query_read;
     ::io_priority_class _compaction_priority;
+    // Reads started in this group use _sstable_batch_query_read.
+    std::optional<seastar::scheduling_group> _batch_query_group;
 
 public:
     const ::io_priority_class&
@@ -37,9 +43,17 @@ class priority_manager {
 
     const ::io_priority_class&
     sstable_query_read_priority() const {
+        if (_batch_query_group && current_scheduling_group() == *_batch_query_group) {
+            return _sstable_batch_query_read;
+        }
         return _sstable_query_read;
     }
 
+    // Makes the reads of the statements executed in the given scheduling
+    // group, those of the service levels with the batch workload type, use
+    // the query_batch I/O class, with the given shares.
+    future<> set_batch_query_group(seastar::scheduling_group sg, uint32_t io_shares);
+
     const ::io_priority_class&
     compaction_priority() const {
         return _compaction_priority;
@@ -33,6 +33,7 @@
 #include "db/hints/manager.hh"
 #include "db/system_keyspace.hh"
 #include "exceptions/exceptions.hh"
+#include <cmath>
 #include <boost/range/algorithm_ext/push_back.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/adaptors.hpp>
@@ -154,6 +155,26 @@ unsigned storage_proxy::cas_shard(const schema& s, dht::token token) {
     return dht::shard_of(s, token);
 }
 
+netw::msg_addr storage_proxy::replica_addr(gms::inet_address ep, dht::token token) const {
+    if (!_messaging.shard_aware_connections()) {
+        return netw::msg_addr(ep, 0);
+    }
+    auto shard_count = _gossiper.get_application_state_ptr(ep, gms::application_state::SHARD_COUNT);
+    auto ignore_msb = _gossiper.get_application_state_ptr(ep, gms::application_state::IGNORE_MSB_BITS);
+    if (!shard_count || !ignore_msb) {
+        return netw::msg_addr(ep, 0);
+    }
+    unsigned shards = std::stoul(shard_count->value);
+    return netw::msg_addr(ep, dht::shard_of(shards, std::stoul(ignore_msb->value), token), shards);
+}
+
+netw::msg_addr storage_proxy::replica_addr(gms::inet_address ep, const schema& s, const frozen_mutation& m) const {
+    if (!_messaging.shard_aware_connections()) {
+        return netw::msg_addr(ep, 0);
+    }
+    return replica_addr(ep, dht::get_token(s, m.key()));
+}
+
 class mutation_holder {
 protected:
     size_t _size = 0;
@@ -221,7 +242,7 @@ class per_destination_mutation : public mutation_holder {
         if (m) {
             tracing::trace(tr_state, "Sending a mutation to /{}", ep);
             return ser::storage_proxy_rpc_verbs::send_mutation(&sp._messaging,
-                                    netw::messaging_service::msg_addr{ep, 0}, timeout, *m,
+                                    sp.replica_addr(ep, _token), timeout, *m,
                                     std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
                                     response_id, tracing::make_trace_info(tr_state));
         }
@@ -268,7 +289,7 @@ class shared_mutation : public mutation_holder {
             tracing::trace_state_ptr tr_state) override {
         tracing::trace(tr_state, "Sending a mutation to /{}", ep);
         return ser::storage_proxy_rpc_verbs::send_mutation(&sp._messaging,
-                netw::messaging_service::msg_addr{ep, 0}, timeout, *_mutation,
+                sp.replica_addr(ep, *_schema, *_mutation), timeout, *_mutation,
                 std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
                 response_id, tracing::make_trace_info(tr_state));
     }
@@ -554,12 +575,22 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
                     return std::max(lhs, rhs);
                 });
     }
-    std::chrono::microseconds calculate_delay(db::view::update_backlog backlog) {
+    float max_flow_control_backlog() {
+        return boost::accumulate(
+                get_targets() | boost::adaptors::transformed([this] (gms::inet_address ep) {
+                    return _proxy->get_flow_control_backlog_of(ep);
+                }),
+                0.0f,
+                [] (float lhs, float rhs) {
+                    return std::max(lhs, rhs);
+                });
+    }
+    std::chrono::microseconds calculate_delay(float relative_backlog) {
         constexpr auto delay_limit_us = 1000000;
         auto adjust = [] (float x) { return x * x * x; };
         auto budget = std::max(storage_proxy::clock_type::duration(0),
             _expire_timer.get_timeout() - storage_proxy::clock_type::now());
-        std::chrono::microseconds ret(uint32_t(adjust(backlog.relative_size()) * delay_limit_us));
+        std::chrono::microseconds ret(uint32_t(adjust(std::min(relative_backlog, 1.0f)) * delay_limit_us));
         // "budget" has millisecond resolution and can potentially be long
         // in the future so converting it to microseconds may overflow.
         // So to compare buget and ret we need to convert both to the lower
@@ -575,15 +606,17 @@ class abstract_write_response_handler : public seastar::enable_shared_from_this<
     template<typename Func>
     void delay(tracing::trace_state_ptr trace, Func&& on_resume) {
         auto backlog = max_backlog();
-        auto delay = calculate_delay(backlog);
+        auto relative_backlog = max_flow_control_backlog();
+        auto delay = calculate_delay(relative_backlog);
         stats().last_mv_flow_control_delay = delay;
+        stats().last_mv_flow_control_backlog = relative_backlog;
         if (delay.count() == 0) {
             tracing::trace(trace, "Delay decision due to throttling: do not delay, resuming now");
             on_resume(this);
         } else {
             ++stats().throttled_base_writes;
-            tracing::trace(trace, "Delaying user write due to view update backlog {}/{} by {}us",
-                          backlog.current, backlog.max, delay.count());
+            tracing::trace(trace, "Delaying user write due to view update backlog {}/{} (flow control backlog {}) by {}us",
+                          backlog.current, backlog.max, relative_backlog, delay.count());
             // Waited on indirectly.
             (void)sleep_abortable<seastar::steady_clock_type>(delay).finally([self = shared_from_this(), on_resume = std::forward<Func>(on_resume)] {
                 --self->stats().throttled_base_writes;
@@ -1406,10 +1439,42 @@ void storage_proxy::got_failure_response(storage_proxy::response_id_type id, gms
 void storage_proxy::maybe_update_view_backlog_of(gms::inet_address replica, std::optional<db::view::update_backlog> backlog) {
     if (backlog) {
         auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        update_smoothed_view_backlog_of(replica, *backlog);
         _view_update_backlogs[replica] = {std::move(*backlog), now};
     }
 }
 
+void storage_proxy::update_smoothed_view_backlog_of(gms::inet_address replica, const db::view::update_backlog& backlog) {
+    auto half_life = std::chrono::milliseconds(_db.local().get_config().view_flow_control_backlog_half_life_in_ms());
+    auto now = clock_type::now();
+    auto [it, inserted] = _smoothed_view_update_backlogs.try_emplace(replica, smoothed_view_update_backlog{backlog.relative_size(), now});
+    if (inserted) {
+        return;
+    }
+    auto& smoothed = it->second;
+    if (half_life.count() == 0) {
+        smoothed = {backlog.relative_size(), now};
+        return;
+    }
+    // Weigh the previous average by the time since it was updated, and not by
+    // the number of updates, which depends on the write rate to the replica.
+    auto elapsed = std::chrono::duration<float>(now - smoothed.last_update) / std::chrono::duration<float>(half_life);
+    auto weight = std::exp2(-elapsed);
+    smoothed.relative_size = weight * smoothed.relative_size + (1 - weight) * backlog.relative_size();
+    smoothed.last_update = now;
+}
+
+float storage_proxy::get_flow_control_backlog_of(gms::inet_address ep) const {
+    if (_db.local().get_config().view_flow_control_backlog_half_life_in_ms() == 0) {
+        return get_backlog_of(ep).relative_size();
+    }
+    auto it = _smoothed_view_update_backlogs.find(ep);
+    if (it == _smoothed_view_update_backlogs.end()) {
+        return 0;
+    }
+    return it->second.relative_size;
+}
+
 db::view::update_backlog storage_proxy::get_view_update_backlog() const {
     return _max_view_update_backlog.add_fetch(this_shard_id(), get_db().local().get_view_update_backlog());
 }
@@ -1502,6 +1567,10 @@ void storage_proxy_stats::write_stats::register_stats() {
                                           sm::description("delay (in seconds) added for MV flow control in the last request"),
                                           {storage_proxy_stats::current_scheduling_group_label()}),
 
+            sm::make_gauge("last_mv_flow_control_backlog", [this] { return last_mv_flow_control_backlog; },
+                                          sm::description("view update backlog, relative to its maximum, of the most backlogged replica of the last request, as used for MV flow control"),
+                                          {storage_proxy_stats::current_scheduling_group_label()}),
+
             sm::make_total_operations("throttled_writes", throttled_writes,
                                       sm::description("number of throttled write requests"),
                                       {storage_proxy_stats::current_scheduling_group_label()}),
@@ -1614,6 +1683,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
 
+        sm::make_total_operations("slow_replicas_avoided", slow_replicas_avoided,
+                       sm::description("number of reads which were sent to the replica they could speculate on, instead of a replica recently much slower than it"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("partition_reads_skipped", partition_reads_skipped,
+                       sm::description("number of partitions of multi-partition queries which were not read, because the partitions before them filled the page"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_histogram("cas_read_latency", sm::description("Transactional read latency histogram"),
                 {storage_proxy_stats::current_scheduling_group_label()},
                 [this]{ return to_metrics_histogram(estimated_cas_read);}),
@@ -1862,6 +1939,7 @@ void storage_proxy::connection_dropped(gms::inet_address addr) {
     slogger.debug("Drop hit rate info for {} because of disconnect", addr);
     for (auto&& cf : _db.local().get_non_system_column_families()) {
         cf->drop_hit_rate(addr);
+        cf->drop_replica_read_latency(addr);
     }
 }
 
@@ -3549,6 +3627,12 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     }
 
 protected:
+    netw::msg_addr replica_addr(gms::inet_address ep) const {
+        if (_partition_range.is_singular()) {
+            return _proxy->replica_addr(ep, _partition_range.start()->value().token());
+        }
+        return netw::msg_addr(ep, 0);
+    }
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>> make_mutation_data_request(lw_shared_ptr<query::read_command> cmd, gms::inet_address ep, clock_type::time_point timeout) {
         ++_proxy->get_stats().mutation_data_read_attempts.get_ep_stat(ep);
         if (fbu::is_me(ep)) {
@@ -3556,7 +3640,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             return _proxy->query_mutations_locally(_schema, cmd, _partition_range, timeout, _trace_state);
         } else {
             tracing::trace(_trace_state, "read_mutation_data: sending a message to /{}", ep);
-            return ser::storage_proxy_rpc_verbs::send_read_mutation_data(&_proxy->_messaging, netw::messaging_service::msg_addr{ep, 0}, timeout, *cmd, _partition_range).then([this, ep](rpc::tuple<reconcilable_result, rpc::optional<cache_temperature>> result_and_hit_rate) {
+            return ser::storage_proxy_rpc_verbs::send_read_mutation_data(&_proxy->_messaging, replica_addr(ep), timeout, *cmd, _partition_range).then([this, ep](rpc::tuple<reconcilable_result, rpc::optional<cache_temperature>> result_and_hit_rate) {
                 auto&& [result, hit_rate] = result_and_hit_rate;
                 tracing::trace(_trace_state, "read_mutation_data: got response from /{}", ep);
                 return make_ready_future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature>>(rpc::tuple(make_foreign(::make_lw_shared<reconcilable_result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())));
@@ -3573,7 +3657,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             return _proxy->query_result_local(_schema, _cmd, _partition_range, opts, _trace_state, timeout);
         } else {
             tracing::trace(_trace_state, "read_data: sending a message to /{}", ep);
-            return ser::storage_proxy_rpc_verbs::send_read_data(&_proxy->_messaging, netw::messaging_service::msg_addr{ep, 0}, timeout, *_cmd, _partition_range, opts.digest_algo).then([this, ep](rpc::tuple<query::result, rpc::optional<cache_temperature>> result_hit_rate) {
+            return ser::storage_proxy_rpc_verbs::send_read_data(&_proxy->_messaging, replica_addr(ep), timeout, *_cmd, _partition_range, opts.digest_algo).then([this, ep](rpc::tuple<query::result, rpc::optional<cache_temperature>> result_hit_rate) {
                 auto&& [result, hit_rate] = result_hit_rate;
                 tracing::trace(_trace_state, "read_data: got response from /{}", ep);
                 return make_ready_future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>(rpc::tuple(make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())));
@@ -3588,7 +3672,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                         timeout, digest_algorithm(*_proxy));
         } else {
             tracing::trace(_trace_state, "read_digest: sending a message to /{}", ep);
-            return ser::storage_proxy_rpc_verbs::send_read_digest(&_proxy->_messaging, netw::messaging_service::msg_addr{ep, 0}, timeout, *_cmd,
+            return ser::storage_proxy_rpc_verbs::send_read_digest(&_proxy->_messaging, replica_addr(ep), timeout, *_cmd,
                         _partition_range, digest_algorithm(*_proxy)).then([this, ep] (
                     rpc::tuple<query::result_digest, rpc::optional<api::timestamp_type>, rpc::optional<cache_temperature>> digest_timestamp_hit_rate) {
                 auto&& [d, t, hit_rate] = digest_timestamp_hit_rate;
@@ -3607,7 +3691,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     _cf->set_hit_rate(ep, std::get<1>(v));
                     resolver->add_mutate_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().mutation_data_read_completed.get_ep_stat(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start);
                 } catch(...) {
                     ++_proxy->get_stats().mutation_data_read_errors.get_ep_stat(ep);
                     resolver->error(ep, std::current_exception());
@@ -3626,7 +3710,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start);
                 } catch(...) {
                     ++_proxy->get_stats().data_read_errors.get_ep_stat(ep);
                     resolver->error(ep, std::current_exception());
@@ -3645,7 +3729,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_digest(ep, std::get<0>(v), std::get<1>(v));
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(ep);
                     _used_targets.push_back(ep);
-                    register_request_latency(latency_clock::now() - start);
+                    register_request_latency(ep, latency_clock::now() - start);
                 } catch(...) {
                     ++_proxy->get_stats().digest_read_errors.get_ep_stat(ep);
                     resolver->error(ep, std::current_exception());
@@ -3721,6 +3805,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     });
                 } else {
                     _proxy->get_stats().read_retries++;
+                    _cf->get_stats().coordinator_read_retries++;
                     _retry_cmd = make_lw_shared<query::read_command>(*cmd);
                     // We asked t (= cmd->get_row_limit()) live columns and got l (=data_resolver->total_live_count) ones.
                     // From that, we can estimate that on this row, for x requested
@@ -3861,8 +3946,9 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
     }
 
 private:
-    void register_request_latency(latency_clock::duration d) {
+    void register_request_latency(gms::inet_address ep, latency_clock::duration d) {
         _max_request_latency = std::max(_max_request_latency, d);
+        _cf->add_replica_read_latency(ep, d);
     }
 
     static constexpr latency_clock::duration NO_LATENCY{-1};
@@ -3917,6 +4003,9 @@ class speculating_read_executor : public abstract_read_executor {
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
             std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
+        if (sr.get_type() == speculative_retry::type::PERCENTILE && _proxy->get_db().local().get_config().latency_aware_read_balancing()) {
+            t = std::min(t, replica_speculation_delay().value_or(t));
+        }
         _speculate_timer.arm(t);
 
         // if CL + RR result in covering all replicas, getReadExecutor forces AlwaysSpeculating.  So we know
@@ -3943,6 +4032,23 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
+private:
+    // The time by which all the replicas we wait for would rarely fail to
+    // answer, judging by their recent reads of the table. Disengaged if
+    // some of them have no recent estimate.
+    std::optional<std::chrono::milliseconds> replica_speculation_delay() const {
+        std::chrono::microseconds delay{0};
+        for (auto& ep : boost::make_iterator_range(_targets.begin(), _targets.end() - 1)) {
+            auto latency = _cf->get_replica_read_latency(ep);
+            if (!latency) {
+                return std::nullopt;
+            }
+            delay = std::max(delay, latency->high());
+        }
+        auto t = std::max(std::chrono::ceil<std::chrono::milliseconds>(delay), std::chrono::milliseconds(1));
+        tracing::trace(_trace_state, "Replica latencies allow speculating after {}ms", t.count());
+        return t;
+    }
 };
 
 db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s) {
@@ -4028,6 +4134,10 @@ ::shared_ptr<abstract_read_executor> storage_proxy::get_read_executor(lw_shared_
         }
     }
 
+    if (target_replicas.size() == block_for + 1 && _db.local().get_config().latency_aware_read_balancing()) {
+        avoid_slow_replica(*cf, target_replicas, trace_state);
+    }
+
     if (retry_type == speculative_retry::type::ALWAYS) {
         return ::make_shared<always_speculating_read_executor>(schema, cf, p, cmd, std::move(pr), cl, block_for, std::move(target_replicas), std::move(trace_state), std::move(permit));
     } else {// PERCENTILE or CUSTOM.
@@ -4035,6 +4145,32 @@ ::shared_ptr<abstract_read_executor> storage_proxy::get_read_executor(lw_shared_
     }
 }
 
+void storage_proxy::avoid_slow_replica(const replica::column_family& cf, inet_address_vector_replica_set& targets, tracing::trace_state_ptr& trace_state) {
+    // The last target is the extra one, which is only asked if a read
+    // speculates. If one of the others recently took more than twice as long
+    // to answer reads of the table, swap them, so a replica stalled by a
+    // compaction burst or a slow disk doesn't hold up reads.
+    auto extra_latency = cf.get_replica_read_latency(targets.back());
+    if (!extra_latency) {
+        return;
+    }
+    auto slowest = targets.end();
+    auto slowest_latency = 2 * extra_latency->mean;
+    for (auto it = targets.begin(); it != targets.end() - 1; ++it) {
+        auto latency = cf.get_replica_read_latency(*it);
+        if (latency && latency->mean > slowest_latency) {
+            slowest = it;
+            slowest_latency = latency->mean;
+        }
+    }
+    if (slowest != targets.end()) {
+        tracing::trace(trace_state, "Replica {} is slow ({}us on average), reading from {} ({}us) instead",
+                *slowest, slowest_latency.count(), targets.back(), extra_latency->mean.count());
+        std::iter_swap(slowest, targets.end() - 1);
+        get_stats().slow_replicas_avoided++;
+    }
+}
+
 future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature>>
 storage_proxy::query_result_local_digest(schema_ptr s, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& pr, tracing::trace_state_ptr trace_state, storage_proxy::clock_type::time_point timeout, query::digest_algorithm da) {
     return query_result_local(std::move(s), std::move(cmd), pr, query::result_options::only_digest(da), std::move(trace_state), timeout).then([] (rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> result_and_hit_rate) {
@@ -4161,18 +4297,54 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
                 handle_completion(exec[0]);
             }
         } else {
-            auto mapper = [timeout, &handle_completion] (
-                    std::pair<::shared_ptr<abstract_read_executor>, dht::token_range>& executor_and_token_range) -> future<::result<foreign_ptr<lw_shared_ptr<query::result>>>> {
-                auto result = co_await executor_and_token_range.first->execute(timeout);
+            // Partitions are read up to `max_concurrent_partition_reads_per_query`
+            // at a time, started in the order their results are merged in.
+            // Once the results merged so far fill the page, the reads which
+            // are not started yet are skipped: the merger would drop their
+            // rows, and the next page starts after the last partition of this
+            // one anyway.
+            const size_t concurrency = std::max<size_t>(1, _db.local().get_config().max_concurrent_partition_reads_per_query());
+            std::vector<std::optional<::result<foreign_ptr<lw_shared_ptr<query::result>>>>> results(exec.size());
+            size_t completed = 0; // results[0, completed) are all available
+            uint64_t rows = 0;
+            uint64_t partitions = 0;
+            bool page_is_full = false;
+            co_await max_concurrent_for_each(boost::irange<size_t>(0, exec.size()), concurrency,
+                    [&] (size_t i) -> future<> {
+                if (page_is_full) {
+                    get_stats().partition_reads_skipped++;
+                    co_return;
+                }
+                auto result = co_await exec[i].first->execute(timeout);
                 // Handle success here. Failure is handled (only once) just outside the try..catch.
                 if (result) {
-                    handle_completion(executor_and_token_range);
+                    handle_completion(exec[i]);
                 }
-                co_return std::move(result);
-            };
+                results[i] = std::move(result);
+                for (; completed < results.size() && results[completed]; ++completed) {
+                    const auto& r = *results[completed];
+                    if (!r) {
+                        // The query fails anyway.
+                        page_is_full = true;
+                        continue;
+                    }
+                    rows += r.value()->row_count().value_or(0);
+                    partitions += r.value()->partition_count().value_or(0);
+                    page_is_full |= r.value()->is_short_read() || rows >= cmd->get_row_limit() || partitions >= cmd->partition_limit;
+                }
+            });
             query::result_merger merger(cmd->get_row_limit(), cmd->partition_limit);
-            merger.reserve(exec.size());
-            result = co_await utils::result_map_reduce(exec.begin(), exec.end(), std::move(mapper), std::move(merger));
+            merger.reserve(completed);
+            for (size_t i = 0; i < completed && result; ++i) {
+                if (*results[i]) {
+                    merger(std::move(*results[i]).value());
+                } else {
+                    result = std::move(*results[i]).as_failure();
+                }
+            }
+            if (result) {
+                result = merger.get();
+            }
         }
     } catch(...) {
         handle_read_error(std::current_exception(), false);
@@ -4188,6 +4360,27 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
     co_return coordinator_query_result(std::move(result).value(), std::move(used_replicas), repair_decision);
 }
 
+// The number of vnode ranges the next round of a range scan reads
+// concurrently. Estimated from the rows and bytes per range the last round
+// found, so that the next one reads the remaining rows, without going past
+// the remaining bytes of the page. A round of a few ranges is a small
+// sample, so the concurrency grows by 16 times at most. Without rows to
+// estimate from, it doubles.
+static int next_range_scan_concurrency(int concurrency, uint64_t rows, uint64_t bytes, uint64_t remaining_rows, std::optional<uint64_t> remaining_bytes) {
+    static constexpr int max_growth = 16;
+    if (!rows) {
+        return concurrency * 2;
+    }
+    const double rows_per_range = double(rows) / concurrency;
+    // Overestimate a little, rows aren't spread evenly over the ranges.
+    double estimate = remaining_rows / rows_per_range * 1.25;
+    if (remaining_bytes && bytes) {
+        const double bytes_per_range = double(bytes) / concurrency;
+        estimate = std::min(estimate, *remaining_bytes / bytes_per_range);
+    }
+    return int(std::clamp(std::ceil(estimate), 1.0, double(concurrency) * max_growth));
+}
+
 future<result<query_partition_key_range_concurrent_result>>
 storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::time_point timeout,
         std::vector<foreign_ptr<lw_shared_ptr<query::result>>>&& results,
@@ -4360,7 +4553,9 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             ranges_per_exec = std::move(ranges_per_exec),
             permit = std::move(permit)] (foreign_ptr<lw_shared_ptr<query::result>>&& result) mutable {
         result->ensure_counts();
-        remaining_row_count -= result->row_count().value();
+        const auto rows = result->row_count().value();
+        const auto bytes = result->buf().size();
+        remaining_row_count -= rows;
         remaining_partition_count -= result->partition_count().value();
         results.emplace_back(std::move(result));
         if (ranges_to_vnodes.empty() || !remaining_row_count || !remaining_partition_count) {
@@ -4380,8 +4575,20 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         } else {
             cmd->set_row_limit(remaining_row_count);
             cmd->partition_limit = remaining_partition_count;
+            std::optional<uint64_t> remaining_bytes;
+            if (cmd->max_result_size) {
+                uint64_t read_bytes = 0;
+                for (auto& r : results) {
+                    read_bytes += r->buf().size();
+                }
+                const auto page_size = cmd->max_result_size->get_page_size();
+                remaining_bytes = page_size > read_bytes ? page_size - read_bytes : 0;
+            }
+            const auto next_concurrency_factor = next_range_scan_concurrency(concurrency_factor, rows, bytes, remaining_row_count, remaining_bytes);
+            tracing::trace(trace_state, "Read {} rows, {} bytes from {} ranges, reading the next {} ranges concurrently",
+                    rows, bytes, concurrency_factor, next_concurrency_factor);
             return p->query_partition_key_range_concurrent(timeout, std::move(results), cmd, cl, std::move(ranges_to_vnodes),
-                    concurrency_factor * 2, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
+                    next_concurrency_factor, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
         }
       }));
     },  utils::result_catch_dots([p] (auto&& handle) {
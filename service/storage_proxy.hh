@@ -269,6 +269,12 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     netw::connection_drop_registration_t _condrop_registration;
     db::view::node_update_backlog& _max_view_update_backlog;
     std::unordered_map<gms::inet_address, view_update_backlog_timestamped> _view_update_backlogs;
+    // Moving averages of the backlogs above, see view_flow_control_backlog_half_life_in_ms.
+    struct smoothed_view_update_backlog {
+        float relative_size;
+        clock_type::time_point last_update;
+    };
+    std::unordered_map<gms::inet_address, smoothed_view_update_backlog> _smoothed_view_update_backlogs;
 
     //NOTICE(sarna): This opaque pointer is here just to avoid moving write handler class definitions from .cc to .hh. It's slow path.
     class view_update_handlers_list;
@@ -328,6 +334,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     static void sort_endpoints_by_proximity(inet_address_vector_replica_set& eps);
     inet_address_vector_replica_set get_live_sorted_endpoints(replica::keyspace& ks, const dht::token& token) const;
     db::read_repair_decision new_read_repair_decision(const schema& s);
+    void avoid_slow_replica(const replica::column_family& cf, inet_address_vector_replica_set& targets, tracing::trace_state_ptr& trace_state);
     ::shared_ptr<abstract_read_executor> get_read_executor(lw_shared_ptr<query::read_command> cmd,
             schema_ptr schema,
             dht::partition_range pr,
@@ -412,8 +419,7 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     db::view::update_backlog get_view_update_backlog() const;
 
     void maybe_update_view_backlog_of(gms::inet_address, std::optional<db::view::update_backlog>);
-
-    db::view::update_backlog get_backlog_of(gms::inet_address) const;
+    void update_smoothed_view_backlog_of(gms::inet_address, const db::view::update_backlog&);
 
     template<typename Range>
     future<> mutate_counters(Range&& mutations, db::consistency_level cl, tracing::trace_state_ptr tr_state, service_permit permit, clock_type::time_point timeout);
@@ -494,6 +500,13 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     future<> mutate_hint(const schema_ptr&, const frozen_mutation& m, tracing::trace_state_ptr tr_state, clock_type::time_point timeout = clock_type::time_point::max());
 
+    // The last view update backlog the node reported in a write response.
+    db::view::update_backlog get_backlog_of(gms::inet_address) const;
+
+    // The relative view update backlog of the node used to delay base writes:
+    // the last one it reported, or their moving average if smoothing is enabled.
+    float get_flow_control_backlog_of(gms::inet_address) const;
+
     /**
     * Use this method to have these Mutations applied
     * across all replicas. This method will take care
@@ -654,6 +667,12 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     static unsigned cas_shard(const schema& s, dht::token token);
 
+    // The address of a replica for a message about the token. With shard-aware
+    // internode connections, it names the replica's shard owning the token,
+    // once gossip tells how the replica is sharded.
+    netw::msg_addr replica_addr(gms::inet_address ep, dht::token token) const;
+    netw::msg_addr replica_addr(gms::inet_address ep, const schema& s, const frozen_mutation& m) const;
+
     virtual void on_join_cluster(const gms::inet_address& endpoint) override;
     virtual void on_leave_cluster(const gms::inet_address& endpoint) override;
     virtual void on_up(const gms::inet_address& endpoint) override;
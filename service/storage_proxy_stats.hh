@@ -111,6 +111,7 @@ struct write_stats {
 
 
     std::chrono::microseconds last_mv_flow_control_delay; // delay added for MV flow control in the last request
+    float last_mv_flow_control_backlog = 0; // relative view update backlog used for MV flow control in the last request
 public:
     write_stats();
     write_stats(const sstring& category, bool auto_register_stats);
@@ -168,6 +169,8 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t slow_replicas_avoided = 0;
+    uint64_t partition_reads_skipped = 0;
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
@@ -2618,6 +2618,11 @@ future<> storage_service::rebuild(sstring source_dc) {
             try {
                 co_await streamer->stream_async();
                 slogger.info("Streaming for rebuild successful");
+                co_await ss._db.invoke_on_all([](replica::database& db) {
+                    for (auto& t : db.get_non_system_column_families()) {
+                        t->trigger_offstrategy_compaction();
+                    }
+                });
             } catch (...) {
                 auto ep = std::current_exception();
                 // This is used exclusively through JMX, so log the full trace but only throw a simple RTE
@@ -2797,6 +2802,12 @@ future<> storage_service::removenode_with_stream(gms::inet_address leaving_node,
             slogger.warn("removenode_with_stream: stream failed: {}", std::current_exception());
             throw;
         }
+        slogger.debug("Triggering off-strategy compaction for all non-system tables on removenode completion");
+        _db.invoke_on_all([](replica::database &db) {
+            for (auto& table : db.get_non_system_column_families()) {
+                table->trigger_offstrategy_compaction();
+            }
+        }).get();
     });
 }
 
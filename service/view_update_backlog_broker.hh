@@ -33,6 +33,9 @@ class view_update_backlog_broker final
     seastar::abort_source _as;
 
 public:
+    // The smallest change of the relative backlog size which is gossiped.
+    static constexpr float min_relative_backlog_change = 0.01;
+
     view_update_backlog_broker(seastar::sharded<storage_proxy>&, gms::gossiper&);
 
     seastar::future<> start();
@@ -25,7 +25,7 @@ concept ChecksumUtils = requires(const char* input, size_t size, uint32_t checks
     { Checksum::prefer_combine() } -> std::same_as<bool>;
 };
 
-struct adler32_utils {
+struct zlib_adler32_checksummer {
     inline static uint32_t init_checksum() {
         return adler32(0, Z_NULL, 0);
     }
@@ -91,6 +91,26 @@ struct libdeflate_crc32_checksummer {
     static constexpr bool prefer_combine() { return false; }
 };
 
+struct libdeflate_adler32_checksummer {
+    static uint32_t init_checksum() {
+        return 1;
+    }
+
+    static uint32_t checksum(const char* input, size_t input_len) {
+        return checksum(init_checksum(), input, input_len);
+    }
+
+    static uint32_t checksum(uint32_t prev, const char* input, size_t input_len) {
+        return libdeflate_adler32(prev, input, input_len);
+    }
+
+    static uint32_t checksum_combine(uint32_t first, uint32_t second, size_t input_len2) {
+        return zlib_adler32_checksummer::checksum_combine(first, second, input_len2);
+    }
+
+    static constexpr bool prefer_combine() { return true; }
+};
+
 template<typename Checksum>
 inline uint32_t checksum_combine_or_feed(uint32_t first, uint32_t second, const char* input, size_t input_len) {
     if constexpr (Checksum::prefer_combine()) {
@@ -119,3 +139,23 @@ struct crc32_utils {
         return fast_crc32_combine_optimized();
     }
 };
+
+// libdeflate selects SIMD kernels for the CPU at runtime, while the
+// zlib adler32() is scalar.
+struct adler32_utils {
+    static uint32_t init_checksum() { return libdeflate_adler32_checksummer::init_checksum(); }
+
+    static uint32_t checksum(const char* input, size_t input_len) {
+        return libdeflate_adler32_checksummer::checksum(input, input_len);
+    }
+
+    static uint32_t checksum(uint32_t prev, const char* input, size_t input_len) {
+        return libdeflate_adler32_checksummer::checksum(prev, input, input_len);
+    }
+
+    static uint32_t checksum_combine(uint32_t first, uint32_t second, size_t input_len2) {
+        return libdeflate_adler32_checksummer::checksum_combine(first, second, input_len2);
+    }
+
+    static constexpr bool prefer_combine() { return libdeflate_adler32_checksummer::prefer_combine(); }
+};
@@ -7,6 +7,7 @@
  */
 
 #include <stdexcept>
+#include <deque>
 #include <cstdlib>
 
 #include <boost/range/algorithm/find_if.hpp>
@@ -14,6 +15,7 @@
 #include <seastar/core/bitops.hh>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/fstream.hh>
+#include <seastar/core/loop.hh>
 
 #include "../compress.hh"
 #include "compress.hh"
@@ -268,7 +270,11 @@ local_compression::local_compression(const compression& c)
             return std::nullopt;
         });
     }())
-{}
+{
+    if (_compressor && !c.dictionary().empty()) {
+        _compressor = _compressor->with_dictionary(c.dictionary());
+    }
+}
 
 size_t local_compression::uncompress(const char* input,
                 size_t input_len, char* output, size_t output_len) const {
@@ -339,9 +345,24 @@ class compressed_file_data_source_impl : public data_source_impl {
     sstables::compression::segmented_offsets::accessor _offsets;
     sstables::local_compression _compression;
     uint64_t _underlying_pos;
+    // Position of the next byte returned to the consumer.
     uint64_t _pos;
+    // Position of the next chunk read from the underlying stream.
+    uint64_t _read_pos;
     uint64_t _beg_pos;
     uint64_t _end_pos;
+
+    // Chunks are decompressed ahead of the consumer when the range spans
+    // enough of them, so that a chunk can be decompressed as soon as it is
+    // read, while the consumer is still parsing the previous one.
+    //
+    // _ahead holds the results of the chunks read ahead, covering
+    // [_pos, _ahead_pos). The reads are chained by _read_chain, since
+    // the underlying stream can only serve one read at a time.
+    size_t _read_ahead_depth = 0;
+    std::deque<future<temporary_buffer<char>>> _ahead;
+    uint64_t _ahead_pos;
+    future<> _read_chain = make_ready_future<>();
 public:
     compressed_file_data_source_impl(file f, sstables::compression* cm,
                 uint64_t pos, size_t len, file_input_stream_options options)
@@ -355,7 +376,7 @@ class compressed_file_data_source_impl : public data_source_impl {
         }
         if (len == 0 || pos == _compression_metadata->uncompressed_file_length()) {
             // Nothing to read
-            _end_pos = _pos = _beg_pos;
+            _end_pos = _pos = _read_pos = _ahead_pos = _beg_pos;
             return;
         }
         if (len <= _compression_metadata->uncompressed_file_length() - pos) {
@@ -363,6 +384,7 @@ class compressed_file_data_source_impl : public data_source_impl {
         } else {
             _end_pos = _compression_metadata->uncompressed_file_length();
         }
+        _read_ahead_depth = read_ahead_depth(options);
         // _beg_pos and _end_pos specify positions in the compressed stream.
         // We need to translate them into a range of uncompressed chunks,
         // and open a file_input_stream to read that range.
@@ -373,16 +395,102 @@ class compressed_file_data_source_impl : public data_source_impl {
                 end.chunk_start + end.chunk_len - start.chunk_start,
                 std::move(options));
         _underlying_pos = start.chunk_start;
-        _pos = _beg_pos;
+        _pos = _read_pos = _ahead_pos = _beg_pos;
     }
     virtual future<temporary_buffer<char>> get() override {
         if (_pos >= _end_pos) {
             return make_ready_future<temporary_buffer<char>>();
         }
-        auto addr = _compression_metadata->locate(_pos, _offsets);
+        if (!_read_ahead_depth) {
+            return read_chunk().then([this] (temporary_buffer<char> out) {
+                _pos += out.size();
+                return out;
+            });
+        }
+        read_ahead();
+        auto f = std::move(_ahead.front());
+        _ahead.pop_front();
+        read_ahead();
+        return f.then([this] (temporary_buffer<char> out) {
+            _pos += out.size();
+            return out;
+        });
+    }
+
+    virtual future<> close() override {
+        auto read_chain = std::exchange(_read_chain, make_ready_future<>());
+        return read_chain.then([this] {
+            // Chunks read ahead and never consumed.
+            for (auto& f : _ahead) {
+                f.ignore_ready_future();
+            }
+            _ahead.clear();
+            if (!_input_stream) {
+                return make_ready_future<>();
+            }
+            return _input_stream->close();
+        });
+    }
+
+    virtual future<temporary_buffer<char>> skip(uint64_t n) override {
+        if (_ahead.empty()) {
+            return skip_underlying(n);
+        }
+        auto read_chain = std::exchange(_read_chain, make_ready_future<>());
+        return read_chain.then([this, n] () mutable {
+            // All chunks read ahead are ready now. Skip over the ones
+            // we can and return the rest of the one we stop in.
+            while (!_ahead.empty()) {
+                auto f = std::move(_ahead.front());
+                _ahead.pop_front();
+                auto out = f.get0();
+                if (n < out.size()) {
+                    out.trim_front(n);
+                    _pos += n + out.size();
+                    return make_ready_future<temporary_buffer<char>>(std::move(out));
+                }
+                n -= out.size();
+                _pos += out.size();
+            }
+            return skip_underlying(n);
+        });
+    }
+private:
+    // Decompressing ahead takes memory and CPU which would be wasted if the
+    // consumer stops early or skips, so only do it for reads spanning more
+    // than a couple of chunks, i.e. scans and compaction rather than most
+    // single-partition reads, and keep at most one read buffer's worth of
+    // decompressed data ahead of the consumer.
+    size_t read_ahead_depth(const file_input_stream_options& options) const {
+        auto chunk_len = _compression_metadata->uncompressed_chunk_length();
+        auto nr_chunks = (_end_pos - 1) / chunk_len - _beg_pos / chunk_len + 1;
+        if (nr_chunks <= 2) {
+            return 0;
+        }
+        return std::clamp<uint64_t>(options.buffer_size / chunk_len, 1, nr_chunks - 1);
+    }
+
+    void read_ahead() {
+        auto chunk_len = _compression_metadata->uncompressed_chunk_length();
+        while (_ahead.size() < _read_ahead_depth && _ahead_pos < _end_pos) {
+            promise<temporary_buffer<char>> pr;
+            _ahead.push_back(pr.get_future());
+            _read_chain = _read_chain.then([this, pr = std::move(pr)] () mutable {
+                return futurize_invoke([this] {
+                    return read_chunk();
+                }).then_wrapped([pr = std::move(pr)] (future<temporary_buffer<char>> f) mutable {
+                    f.forward_to(std::move(pr));
+                });
+            });
+            _ahead_pos = std::min(align_down(_ahead_pos, chunk_len) + chunk_len, _end_pos);
+        }
+    }
+
+    future<temporary_buffer<char>> read_chunk() {
+        auto addr = _compression_metadata->locate(_read_pos, _offsets);
         // Uncompress the next chunk. We need to skip part of the first
         // chunk, but then continue to read from beginning of chunks.
-        if (_pos != _beg_pos && addr.offset != 0) {
+        if (_read_pos != _beg_pos && addr.offset != 0) {
             throw std::runtime_error("compressed reader out of sync");
         }
         return _input_stream->read_exactly(addr.chunk_len).
@@ -409,23 +517,17 @@ class compressed_file_data_source_impl : public data_source_impl {
 
                 out.trim(len);
                 out.trim_front(addr.offset);
-                _pos += out.size();
+                _read_pos += out.size();
                 _underlying_pos += addr.chunk_len;
 
                 return out;
         });
     }
 
-    virtual future<> close() override {
-        if (!_input_stream) {
-            return make_ready_future<>();
-        }
-        return _input_stream->close();
-    }
-
-    virtual future<temporary_buffer<char>> skip(uint64_t n) override {
+    future<temporary_buffer<char>> skip_underlying(uint64_t n) {
         _pos += n;
         assert(_pos <= _end_pos);
+        _read_pos = _ahead_pos = _pos;
         if (_pos == _end_pos) {
             return make_ready_future<temporary_buffer<char>>();
         }
@@ -474,12 +576,24 @@ enum class compressed_checksum_mode {
 template <typename ChecksumType, compressed_checksum_mode mode>
 requires ChecksumUtils<ChecksumType>
 class compressed_file_data_sink_impl : public data_sink_impl {
+    // How much data to sample for training the dictionary, relative to
+    // the requested dictionary size. zstd recommends about 100x.
+    static constexpr size_t dictionary_sample_ratio = 100;
+    // Upper bound on the data held back for sampling.
+    static constexpr size_t max_dictionary_sample_size = 8 << 20;
+
     output_stream<char> _out;
     sstables::compression* _compression_metadata;
     sstables::compression::segmented_offsets::writer _offsets;
     sstables::local_compression _compression;
     size_t _pos = 0;
     uint32_t _full_checksum;
+    // When the compressor wants a dictionary, the first chunks are held back
+    // until enough of them are collected to train it. They are then compressed
+    // with the trained dictionary, like all the chunks that follow.
+    std::vector<temporary_buffer<char>> _samples;
+    size_t _sampled_bytes = 0;
+    size_t _sample_size = 0;
 public:
     compressed_file_data_sink_impl(output_stream<char> out, sstables::compression* cm, sstables::local_compression lc)
             : _out(std::move(out))
@@ -487,10 +601,58 @@ class compressed_file_data_sink_impl : public data_sink_impl {
             , _offsets(_compression_metadata->offsets.get_writer())
             , _compression(lc)
             , _full_checksum(ChecksumType::init_checksum())
-    {}
+    {
+        if (_compression) {
+            _sample_size = std::min(_compression.compressor()->dictionary_size() * dictionary_sample_ratio, max_dictionary_sample_size);
+        }
+    }
 
     virtual future<> put(net::packet data) override { abort(); }
     virtual future<> put(temporary_buffer<char> buf) override {
+        if (_sample_size) {
+            _sampled_bytes += buf.size();
+            _samples.push_back(std::move(buf));
+            if (_sampled_bytes < _sample_size) {
+                return make_ready_future<>();
+            }
+            return flush_samples();
+        }
+        return compress_and_write(std::move(buf));
+    }
+    virtual future<> close() override {
+        return flush_samples().then([this] {
+            return _out.close();
+        });
+    }
+
+    virtual size_t buffer_size() const noexcept override {
+        return _compression_metadata->uncompressed_chunk_length();
+    }
+private:
+    // Trains the dictionary on the chunks sampled so far and writes them out.
+    future<> flush_samples() {
+        if (!_sample_size) {
+            return make_ready_future<>();
+        }
+        _sample_size = 0;
+        std::vector<bytes_view> samples;
+        samples.reserve(_samples.size());
+        for (auto& b : _samples) {
+            samples.emplace_back(reinterpret_cast<const int8_t*>(b.get()), b.size());
+        }
+        auto dict = _compression.compressor()->train_dictionary(samples);
+        if (dict) {
+            _compression = sstables::local_compression(_compression.compressor()->with_dictionary(*dict));
+            _compression_metadata->set_dictionary(std::move(*dict));
+        }
+        return do_with(std::exchange(_samples, {}), [this] (std::vector<temporary_buffer<char>>& samples) {
+            return do_for_each(samples, [this] (temporary_buffer<char>& buf) {
+                return compress_and_write(std::move(buf));
+            });
+        });
+    }
+
+    future<> compress_and_write(temporary_buffer<char> buf) {
         auto output_len = _compression.compress_max_size(buf.size());
 
         // account space for checksum that goes after compressed data.
@@ -530,13 +692,6 @@ class compressed_file_data_sink_impl : public data_sink_impl {
         auto f = _out.write(compressed.get(), compressed.size());
         return f.then([compressed = std::move(compressed)] {});
     }
-    virtual future<> close() override {
-        return _out.close();
-    }
-
-    virtual size_t buffer_size() const noexcept override {
-        return _compression_metadata->uncompressed_chunk_length();
-    }
 };
 
 template <typename ChecksumType, compressed_checksum_mode mode>
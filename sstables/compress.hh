@@ -301,6 +301,9 @@ struct compression {
     // Variables *not* found in the "Compression Info" file (added by update()):
     uint64_t _compressed_file_length = 0;
     uint32_t _full_checksum = 0;
+    // Dictionary the chunks were compressed with, if any.
+    // Stored in the Scylla component (see scylla_metadata_type::CompressionDictionary).
+    bytes _dictionary;
 public:
     // Set the compressor algorithm, please check the definition of enum compressor.
     void set_compressor(compressor_ptr c);
@@ -358,6 +361,14 @@ struct compression {
         _full_checksum = checksum;
     }
 
+    const bytes& dictionary() const noexcept {
+        return _dictionary;
+    }
+
+    void set_dictionary(bytes dict) {
+        _dictionary = std::move(dict);
+    }
+
     friend class sstable;
 };
 
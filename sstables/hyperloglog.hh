@@ -49,6 +49,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <bit>
 #include <seastar/core/byteorder.hh>
 #include <seastar/core/temporary_buffer.hh>
 
@@ -76,6 +77,21 @@ static inline size_t size_unsigned_var_int(unsigned int value) {
     return size;
 }
 
+static inline unsigned int read_unsigned_var_int(const uint8_t*& from, const uint8_t* end) {
+    unsigned int value = 0;
+    for (unsigned shift = 0; shift < 32; shift += 7) {
+        if (from == end) {
+            throw std::invalid_argument("truncated var int");
+        }
+        auto byte = *from++;
+        value |= unsigned(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::invalid_argument("var int too long");
+}
+
 static inline size_t write_unsigned_var_int(unsigned int value, uint8_t* to) {
     size_t size = 0;
     while ((value & 0xFFFFFF80) != 0L) {
@@ -128,11 +144,34 @@ class HyperLogLog {
         alphaMM_ = alpha * m_ * m_;
     }
 
+    /**
+     * Creates a HyperLogLog from the output of get_bytes(), such as the
+     * cardinality data from the compaction metadata.
+     *
+     * @exception std::invalid_argument the bytes are not in the format written
+     *            by get_bytes(). That includes estimators written by Cassandra,
+     *            which packs the registers differently.
+     */
     static HyperLogLog from_bytes(temporary_buffer<uint8_t> bytes) {
-        // FIXME: implement class that creates a HyperLogLog from an array of bytes.
-        // This will useful if we need to work with the cardinality data from the
-        // compaction metadata.
-        abort();
+        static constexpr int version = 2;
+
+        const uint8_t* p = bytes.get();
+        const uint8_t* end = p + bytes.size();
+        if (bytes.size() < sizeof(int32_t) || read_be<int32_t>(reinterpret_cast<const char*>(p)) != -version) {
+            throw std::invalid_argument("unsupported cardinality estimator version");
+        }
+        p += sizeof(int32_t);
+
+        auto b = read_unsigned_var_int(p, end);
+        auto sp = read_unsigned_var_int(p, end);
+        auto type = read_unsigned_var_int(p, end);
+        auto size = read_unsigned_var_int(p, end);
+        if (sp != 0 || type != 0 || b < 4 || b > 16 || size != (1u << b) || size_t(end - p) != size) {
+            throw std::invalid_argument("unsupported cardinality estimator format");
+        }
+        HyperLogLog hll(b);
+        std::copy(p, end, hll.M_.begin());
+        return hll;
     }
 
     /**
@@ -227,9 +266,9 @@ class HyperLogLog {
             if (zeros != 0) {
                 estimate = m_ * log(static_cast<double>(m_)/ zeros);
             }
-        } else if (estimate > (1.0 / 30.0) * pow_2_32) {
-            estimate = neg_pow_2_32 * log(1.0 - (estimate / pow_2_32));
         }
+        // No large range correction: it accounts for collisions of 32-bit
+        // hashes, and offer_hashed() takes 64-bit ones.
         return estimate;
     }
 
@@ -254,6 +293,37 @@ class HyperLogLog {
         }
     }
 
+    /**
+     * Returns an estimator with 2^b registers, b not greater than the bit width
+     * of this one, so that it can be merged with estimators of that width.
+     * The result is the estimator that would have been built with width b
+     * from the same hashes.
+     *
+     * @param[in] b bit width of the result
+     *
+     * @exception std::invalid_argument b is out of range or greater than the
+     *            bit width of this estimator.
+     */
+    HyperLogLog fold(uint8_t b) const {
+        if (b > b_) {
+            throw std::invalid_argument("cannot fold into a wider estimator");
+        }
+        HyperLogLog ret(b);
+        int shift = b_ - b;
+        for (uint32_t r = 0; r < m_; ++r) {
+            if (!M_[r]) {
+                continue;
+            }
+            // The index bits which are dropped come first in the hash bits
+            // the rank is taken from.
+            uint32_t dropped = r & ((1u << shift) - 1);
+            int rank = dropped ? std::countl_zero(dropped) - (32 - shift) + 1 : shift + M_[r];
+            auto& reg = ret.M_[r >> shift];
+            reg = std::max<uint8_t>(reg, rank);
+        }
+        return ret;
+    }
+
     /**
      * Clears all internal registers.
      */
@@ -270,6 +340,15 @@ class HyperLogLog {
         return m_;
     }
 
+    /**
+     * Returns register bit width.
+     *
+     * @return Register bit width
+     */
+    uint8_t bitWidth() const {
+        return b_;
+    }
+
     /**
      * Exchanges the content of the instance
      *
@@ -330,6 +409,10 @@ class HyperLogLog {
         return v;
     }
 
+    // The position of the first set bit among the first b bits of x, or b + 1.
+    static uint8_t rho(uint64_t x, uint8_t b) {
+        return std::min<int>(std::countl_zero(x), b) + 1;
+    }
 };
 
 } // namespace hll
@@ -463,6 +463,9 @@ class index_reader {
     index_bound _lower_bound;
     // Upper bound may remain uninitialized
     std::optional<index_bound> _upper_bound;
+    // Used by prefetch of pages ahead of the lower bound.
+    index_bound _prefetch_bound;
+    future<> _prefetch = make_ready_future<>();
 
 private:
     static future<> reset_clustered_cursor(index_bound& bound) noexcept {
@@ -483,21 +486,9 @@ class index_reader {
         return reset_clustered_cursor(bound);
     }
 
-    // Must be called for non-decreasing summary_idx.
-    future<> advance_to_page(index_bound& bound, uint64_t summary_idx) {
-        sstlog.trace("index {}: advance_to_page({}), bound {}", fmt::ptr(this), summary_idx, fmt::ptr(&bound));
-        assert(!bound.current_list || bound.current_summary_idx <= summary_idx);
-        if (bound.current_list && bound.current_summary_idx == summary_idx) {
-            sstlog.trace("index {}: same page", fmt::ptr(this));
-            return make_ready_future<>();
-        }
-
-        auto& summary = _sstable->get_summary();
-        if (summary_idx >= summary.header.size) {
-            sstlog.trace("index {}: eof", fmt::ptr(this));
-            return advance_to_end(bound);
-        }
-        auto loader = [this, &bound] (uint64_t summary_idx) -> future<index_list> {
+    // Returns the loader of index pages into the cache, which reads them with the context of the bound.
+    auto page_loader(index_bound& bound) {
+        return [this, &bound] (uint64_t summary_idx) -> future<index_list> {
             auto& summary = _sstable->get_summary();
             uint64_t position = summary.entries[summary_idx].position;
             uint64_t quantity = downsampling::get_effective_index_interval_after_index(summary_idx, summary.header.sampling_level,
@@ -530,8 +521,59 @@ class index_reader {
                 });
             });
         };
+    }
+
+    // Whether single partition reads use the sstable enough that its index pages
+    // should be pinned in the cache: on average, each page was looked up at least
+    // once in the last read_heat::half_life.
+    bool is_hot() const noexcept {
+        return _sstable->get_read_heat().recent().index_lookups >= _sstable->get_summary().header.size;
+    }
+
+    // Starts loading the page at summary_idx into the cache in the background, if a range scan
+    // is about to move the lower bound to it. The lower bound and the prefetch bound don't share
+    // a context, so that the prefetch doesn't hold up the advancing of the lower bound.
+    void maybe_prefetch(index_bound& bound, uint64_t summary_idx) {
+        if (&bound != &_lower_bound || _single_page_read || !_use_caching || !_prefetch.available()) {
+            return;
+        }
+        if (summary_idx >= _sstable->get_summary().header.size) {
+            return;
+        }
+        // The upper bound reads its page itself.
+        if (_upper_bound && _upper_bound->current_list && _upper_bound->current_summary_idx <= summary_idx) {
+            return;
+        }
+        sstlog.trace("index {}: prefetch page {}", fmt::ptr(this), summary_idx);
+        _prefetch = _index_cache.prefetch(summary_idx, page_loader(_prefetch_bound)).handle_exception([this, summary_idx] (std::exception_ptr ep) {
+            sstlog.debug("index {}: failed to prefetch page {} of {}: {}", fmt::ptr(this), summary_idx, _sstable->get_filename(), ep);
+        });
+    }
+
+    // Must be called for non-decreasing summary_idx.
+    future<> advance_to_page(index_bound& bound, uint64_t summary_idx) {
+        sstlog.trace("index {}: advance_to_page({}), bound {}", fmt::ptr(this), summary_idx, fmt::ptr(&bound));
+        assert(!bound.current_list || bound.current_summary_idx <= summary_idx);
+        if (bound.current_list && bound.current_summary_idx == summary_idx) {
+            sstlog.trace("index {}: same page", fmt::ptr(this));
+            return make_ready_future<>();
+        }
+
+        auto& summary = _sstable->get_summary();
+        if (summary_idx >= summary.header.size) {
+            sstlog.trace("index {}: eof", fmt::ptr(this));
+            return advance_to_end(bound);
+        }
+
+        if (_use_caching) {
+            _index_cache.set_hot(is_hot());
+        }
+        if (_trace_state) {
+            tracing::trace(_trace_state, "Index page {} of {}: {}", summary_idx, _sstable->get_filename(), _index_cache.classify(summary_idx));
+        }
+        maybe_prefetch(bound, summary_idx + 1);
 
-        return _index_cache.get_or_load(summary_idx, loader).then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
+        return _index_cache.get_or_load(summary_idx, page_loader(bound)).then([this, &bound, summary_idx] (partition_index_cache::entry_ptr ref) {
             bound.current_list = std::move(ref);
             bound.current_summary_idx = summary_idx;
             bound.current_index_idx = 0;
@@ -1077,7 +1119,11 @@ class index_reader {
 
     future<> close() noexcept {
         // index_bound::close must not fail
-        return close(_lower_bound).then([this] {
+        return std::exchange(_prefetch, make_ready_future<>()).then([this] {
+            return close(_prefetch_bound);
+        }).then([this] {
+            return close(_lower_bound);
+        }).then([this] {
             if (_upper_bound) {
                 return close(*_upper_bound);
             }
@@ -1291,6 +1291,7 @@ class sstable_mutation_reader : public mp_row_consumer_reader_k_l {
         assert(end);
 
         if (_single_partition_read) {
+            _sst->get_read_heat().on_partition_found(*end - begin);
             _read_enabled = (begin != *end);
             _context = data_consume_single_partition<DataConsumeRowsContext>(*_schema, _sst, _consumer, { begin, *end });
         } else {
@@ -116,8 +116,8 @@ class metadata_collector {
     static constexpr double NO_COMPRESSION_RATIO = -1.0;
 
     static hll::HyperLogLog hyperloglog(int p, int sp) {
-        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring parameters by the time being.
-        return hll::HyperLogLog();
+        // FIXME: hll::HyperLogLog doesn't support sparse format, so ignoring sp by the time being.
+        return hll::HyperLogLog(p);
     }
 private:
     const schema& _schema;
@@ -143,11 +143,13 @@ class metadata_collector {
 
     /**
      * Default cardinality estimation method is to use HyperLogLog++.
-     * Parameter here(p=13, sp=25) should give reasonable estimation
-     * while lowering bytes required to hold information.
-     * See CASSANDRA-5906 for detail.
+     * Cassandra uses p=13, sp=25 (see CASSANDRA-5906), but without the
+     * sparse format the registers are stored one per byte and kept in
+     * memory with the Statistics of every sstable. p=10 takes 1KiB and
+     * estimates within about 3%, which compaction relies on to size the
+     * bloom filter of its output.
      */
-    hll::HyperLogLog _cardinality = hyperloglog(13, 25);
+    hll::HyperLogLog _cardinality = hyperloglog(10, 25);
 private:
     void convert(disk_array<uint32_t, disk_string<uint16_t>>&to, const std::optional<position_in_partition>& from);
 public:
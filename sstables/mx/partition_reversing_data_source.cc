@@ -350,7 +350,8 @@ static temporary_buffer<char> end_of_partition() {
 //
 // Because vast majority of the data consumed in our parsers is later reused
 // in the sstable reader, we cache the read buffer. The size of the buffer
-// starts at 4KB and is doubled after each read up to 128KB. We set the
+// starts at 4KB, or at the size of the last promoted index block if it was
+// read whole, and is doubled after each read up to 128KB. We set the
 // range of our reads so that the current row that will be returned to the
 // sstable reader is at the end of the buffer. After returning a row, we
 // trim it off the end of the buffer, so that the next row is again at the
@@ -403,7 +404,7 @@ class partition_reversing_data_source_impl final : public data_source_impl {
     } _state = state::RANGE_END;
 private:
     input_stream<char> data_stream(size_t start, size_t end) {
-        return _sst->data_stream(start, end - start, _io_priority, _permit, _trace_state, {});
+        return _sst->data_stream(start, end - start, _io_priority, _permit, _trace_state, {}, sstable::raw_stream::no, sstable::use_data_cache::yes);
     }
     future<temporary_buffer<char>> data_read(uint64_t start, uint64_t end) {
         return _sst->data_read(start, end - start, _io_priority, _permit);
@@ -528,8 +529,17 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                     // no promoted index blocks in the partition, read from the beginning
                     _row_start = _clustering_range_start;
                 }
+                uint64_t block_start = _row_start;
                 uint64_t last_row_start = _row_start;
-                co_await emplace_row_skipping_context(data_stream(_row_start, _partition_end), _row_start, _partition_end);
+                // Rows are returned from the end of the block first, so unless the
+                // block is very large, read all of it at once and parse it from memory.
+                bool cache_block = _partition_end - block_start <= max_read_size;
+                if (cache_block) {
+                    _cached_read = co_await data_read(block_start, _partition_end);
+                    co_await emplace_row_skipping_context(make_buffer_input_stream(_cached_read.share()), _row_start, _partition_end);
+                } else {
+                    co_await emplace_row_skipping_context(data_stream(_row_start, _partition_end), _row_start, _partition_end);
+                }
                 co_await _row_skipping_context->consume_input();
                 while (!_row_skipping_context->end_of_partition()) {
                     last_row_start = _row_start;
@@ -538,6 +548,13 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                 }
                 _row_end = _row_start;
                 _row_start = last_row_start;
+                if (cache_block) {
+                    // Keep the rows, without the end of partition flag, so that the
+                    // cached read ends at _row_end.
+                    _cached_read.trim(_row_end - block_start);
+                    // Earlier blocks are likely of similar size, read them whole too.
+                    _current_read_size = std::clamp(_row_end - block_start, _current_read_size, max_read_size);
+                }
                 if (_row_start == _row_end) {
                     // empty partition
                     _state = state::FINISHED;
@@ -230,6 +230,21 @@ class mp_row_consumer_m {
 
     ~mp_row_consumer_m() {}
 
+    // Returns the columns of the given kind whose values have to be read,
+    // or nullptr if all of them have to.
+    //
+    // Cells of the other columns are still reported, without their values,
+    // since they determine whether the row is live and how it reconciles with
+    // other sources. Only reads which bypass the cache can drop the values:
+    // the cache is populated with what the sstable reader returns and has to
+    // see the full rows regardless of the slice which caused the population.
+    const query::column_id_vector* projected_columns(column_kind kind) const {
+        if (!_slice.options.contains(query::partition_slice::option::bypass_cache) || _treat_static_row_as_regular) {
+            return nullptr;
+        }
+        return kind == column_kind::static_column ? &_slice.static_columns : &_slice.regular_columns;
+    }
+
     // See the RowConsumer concept
     void push_ready_fragments() {
         if (auto rto = std::move(_stored_tombstone)) {
@@ -702,6 +717,10 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
 
         // Represents the subset of _all_columns present in current row
         boost::dynamic_bitset<uint64_t> _columns_selector; // size() == _columns.size()
+
+        // Subset of _all_columns whose cell values are skipped rather than read.
+        // Empty if all values are read.
+        boost::dynamic_bitset<uint64_t> _skipped_values;
     };
 
     row_schema _regular_row;
@@ -746,9 +765,25 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         _row = &rs;
         _row->_columns = _row->_all_columns;
     }
-    void setup_columns(row_schema& rs, const std::vector<column_translation::column_info>& columns) {
+    void setup_columns(row_schema& rs, const std::vector<column_translation::column_info>& columns,
+                       const query::column_id_vector* projected_columns) {
         rs._all_columns = boost::make_iterator_range(columns);
         rs._columns_selector = boost::dynamic_bitset<uint64_t>(columns.size());
+        if (!projected_columns) {
+            return;
+        }
+        boost::dynamic_bitset<uint64_t> skipped(columns.size());
+        for (size_t i = 0; i < columns.size(); ++i) {
+            auto& info = columns[i];
+            // Counter cells are merged by their values, and columns missing
+            // in the current schema go through the usual checks.
+            if (info.id && !info.is_counter && std::find(projected_columns->begin(), projected_columns->end(), *info.id) == projected_columns->end()) {
+                skipped.set(i);
+            }
+        }
+        if (skipped.any()) {
+            rs._skipped_values = std::move(skipped);
+        }
     }
     void skip_absent_columns() {
         size_t pos = _row->_columns_selector.find_first();
@@ -767,6 +802,9 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
     }
     bool is_column_simple() const { return !_row->_columns.front().is_collection; }
     bool is_column_counter() const { return _row->_columns.front().is_counter; }
+    bool is_column_value_skipped() const {
+        return !_row->_skipped_values.empty() && _row->_skipped_values.test(_row->_columns_selector.size() - _row->_columns.size());
+    }
     const column_translation::column_info& get_column_info() const {
         return _row->_columns.front();
     }
@@ -1079,6 +1117,17 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
             }
             if (!_column_flags.has_value()) {
                 _column_value = fragmented_temporary_buffer();
+            } else if (is_column_value_skipped()) {
+                _column_value = fragmented_temporary_buffer();
+                if (auto len = get_column_value_length()) {
+                    _u64 = *len;
+                } else {
+                    co_yield read_unsigned_vint(*_processing_data);
+                }
+                auto maybe_skip_bytes = skip(*_processing_data, _u64);
+                if (std::holds_alternative<skip_bytes>(maybe_skip_bytes)) {
+                    co_yield maybe_skip_bytes;
+                }
             } else {
                 read_status status = read_status::waiting;
                 if (auto len = get_column_value_length()) {
@@ -1177,8 +1226,8 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
         , _has_shadowable_tombstones(sst->has_shadowable_tombstones())
         , _gen(do_process_state())
     {
-        setup_columns(_regular_row, _column_translation.regular_columns());
-        setup_columns(_static_row, _column_translation.static_columns());
+        setup_columns(_regular_row, _column_translation.regular_columns(), _consumer.projected_columns(column_kind::regular_column));
+        setup_columns(_static_row, _column_translation.static_columns(), _consumer.projected_columns(column_kind::static_column));
     }
 
     void verify_end_state() {
@@ -1509,6 +1558,7 @@ class mx_sstable_mutation_reader : public mp_row_consumer_reader_mx {
         assert(end);
 
         if (_single_partition_read) {
+            _sst->get_read_heat().on_partition_found(*end - begin);
             _read_enabled = (begin != *end);
             if (reversed()) {
                 auto reversed_context = data_consume_reversed_partition<DataConsumeRowsContext>(
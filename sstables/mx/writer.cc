@@ -586,6 +586,7 @@ class writer : public sstable_writer::writer_impl {
     utils::UUID _run_identifier;
     bool _write_regular_as_static; // See #4139
     scylla_metadata::large_data_stats _large_data_stats;
+    expiry_index _expiry_index;
 
     void init_file_writers();
 
@@ -784,7 +785,8 @@ class writer : public sstable_writer::writer_impl {
         _sst._shards = { shard };
 
         _cfg.monitor->on_write_started(_data_writer->offset_tracker());
-        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), utils::filter_format::m_format);
+        auto filter_format = _cfg.split_block_bloom_filter ? utils::filter_format::split_block_format : utils::filter_format::m_format;
+        _sst._components->filter = utils::i_filter::get_filter(estimated_partitions, _schema.bloom_filter_fp_chance(), filter_format);
         _pi_write_m.desired_block_size = cfg.promoted_index_block_size;
         _index_sampling_state.summary_byte_cost = _cfg.summary_byte_cost;
         prepare_summary(_sst._components->summary, estimated_partitions, _schema.min_index_interval());
@@ -859,7 +861,7 @@ void writer::init_file_writers() {
     file_output_stream_options options;
     options.io_priority_class = _pc;
     options.buffer_size = _sst.sstable_buffer_size;
-    options.write_behind = 10;
+    options.write_behind = _cfg.write_behind;
 
     if (!_compression_enabled) {
         auto out = make_file_data_sink(std::move(_sst._data_file), options).get0();
@@ -899,6 +901,9 @@ void writer::consume_new_partition(const dht::decorated_key& dk) {
 
     _partition_key = key::from_partition_key(_schema, dk.key());
     maybe_add_summary_entry(dk.token(), bytes_view(*_partition_key));
+    if (_expiry_index.entries.elements.size() < _sst._components->summary.entries.size()) {
+        _expiry_index.entries.elements.push_back(expiry_index_entry{std::numeric_limits<int32_t>::min(), api::min_timestamp});
+    }
 
     _sst._components->filter->add(bytes_view(*_partition_key));
     _collector.add_key(bytes_view(*_partition_key));
@@ -1376,6 +1381,9 @@ stop_iteration writer::consume_end_of_partition() {
 
     maybe_record_large_partitions(_sst, *_partition_key, _c_stats.partition_size, _c_stats.rows_count);
 
+    auto& expiry = _expiry_index.entries.elements.back();
+    expiry.max_local_deletion_time = std::max(expiry.max_local_deletion_time, _c_stats.local_deletion_time_tracker.max());
+    expiry.max_timestamp = std::max(expiry.max_timestamp, _c_stats.timestamp_tracker.max());
 
     // update is about merging column_stats with the data being stored by collector.
     _collector.update(std::move(_c_stats));
@@ -1407,12 +1415,22 @@ void writer::consume_end_of_stream() {
         _sst._schema, _sst.get_first_decorated_key(), _sst.get_last_decorated_key(), _enc_stats);
     close_data_writer();
     _sst.write_summary(_pc);
+    // The filter was sized for the estimated number of partitions.
+    _sst._components->filter->shrink(_index_sampling_state.partition_count, _schema.bloom_filter_fp_chance());
     _sst.write_filter(_pc);
     _sst.write_statistics(_pc);
     _sst.write_compression(_pc);
     auto features = sstable_enabled_features::all();
     run_identifier identifier{_run_identifier};
     std::optional<scylla_metadata::large_data_stats> ld_stats(std::move(_large_data_stats));
+    if (std::ranges::any_of(_expiry_index.entries.elements, [] (const expiry_index_entry& e) {
+            return e.max_local_deletion_time != std::numeric_limits<int32_t>::max();
+        })) {
+        if (!_sst._components->scylla_metadata) {
+            _sst._components->scylla_metadata.emplace();
+        }
+        _sst._components->scylla_metadata->data.set<scylla_metadata_type::ExpiryIndex>(std::move(_expiry_index));
+    }
     _sst.write_scylla_metadata(_pc, _shard, std::move(features), std::move(identifier), std::move(ld_stats), _cfg.origin);
     if (!_cfg.leave_unsealed) {
         _sst.seal_sstable(_cfg.backup).get();
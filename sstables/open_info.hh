@@ -41,6 +41,17 @@ struct entry_descriptor {
         : sstdir(sstdir), ks(ks), cf(cf), generation(generation), version(version), format(format), component(component) {}
 };
 
+// Controls which components sstable::load() reads from disk.
+struct sstable_open_config {
+    // When false, the sstable starts with a filter which reports every key as
+    // present, and the real one is read by sstable::load_filter_in_background().
+    bool load_bloom_filter = true;
+    // When false, the compaction metadata of Statistics, whose cardinality
+    // estimator is only used when the sstable is compacted, stays on disk and
+    // is read by the compaction which needs it.
+    bool load_compaction_metadata = true;
+};
+
 // contains data for loading a sstable using components shared by a single shard;
 // can be moved across shards
 struct foreign_sstable_open_info {
@@ -52,6 +63,7 @@ struct foreign_sstable_open_info {
     sstable_version_types version;
     sstable_format_types format;
     uint64_t uncompressed_data_size;
+    bool filter_deferred = false;
 };
 
 }
@@ -27,6 +27,12 @@ namespace sstables {
 // Supports asynchronous insertion, ensures that only one entry will be loaded.
 // Entries without a live entry_ptr are linked in the LRU.
 // The instance must be destroyed only after all live_ptr:s are gone.
+//
+// The pages of a cache marked hot (see set_hot()) are pinned: the LRU defers
+// their eviction for as long as the pages of all hot caches on the shard fit
+// in the budget set by set_pinned_bytes_budget(). This keeps the index of the
+// sstables most used by single partition reads resident through bursts of
+// eviction caused by other reads.
 class partition_index_cache {
 public:
     using key_type = uint64_t;
@@ -38,6 +44,8 @@ class partition_index_cache {
         key_type _key;
         std::variant<lw_shared_ptr<shared_promise<>>, partition_index_page> _page;
         size_t _size_in_allocator = 0;
+        // Set when the entry was inserted by prefetch() and not looked up since.
+        bool _prefetched = false;
     public:
         entry(partition_index_cache* parent, key_type key)
                 : _parent(parent)
@@ -59,6 +67,7 @@ class partition_index_cache {
         }
 
         void on_evicted() noexcept override;
+        bool defer_eviction() noexcept override;
 
         // Returns the amount of memory owned by this entry.
         // Always returns the same value for a given state of _page.
@@ -78,8 +87,19 @@ class partition_index_cache {
         uint64_t evictions = 0; // Number of times entry was evicted
         uint64_t populations = 0; // Number of times entry was inserted
         uint64_t used_bytes = 0; // Number of bytes entries occupy in memory
+        uint64_t prefetches = 0; // Number of times entry was inserted by prefetch()
+        uint64_t prefetch_hits = 0; // Number of times a prefetched entry was found
+        uint64_t pinned_bytes = 0; // Number of bytes entries of hot caches occupy in memory
+        uint64_t pin_deferrals = 0; // Number of times eviction of a pinned entry was deferred
     } _shard_stats;
 
+    // What get_or_load() would find.
+    enum class lookup_kind {
+        hit,
+        miss,
+        prefetched,
+    };
+
     struct key_less_comparator {
         bool operator()(key_type lhs, key_type rhs) const noexcept {
             return lhs < rhs;
@@ -155,6 +175,56 @@ class partition_index_cache {
     logalloc::region& _region;
     logalloc::allocating_section _as;
     lru& _lru;
+    bool _hot = false;
+    uint64_t _used_bytes = 0;
+    static thread_local uint64_t _pinned_bytes_budget;
+private:
+    void on_populated(entry& e) noexcept {
+        _used_bytes += e.size_in_allocator();
+        _shard_stats.used_bytes += e.size_in_allocator();
+        if (_hot) {
+            _shard_stats.pinned_bytes += e.size_in_allocator();
+        }
+        ++_shard_stats.populations;
+    }
+
+    template<typename Loader>
+    future<entry_ptr> load(const key_type& key, Loader&& loader, bool prefetch) {
+        entry_ptr ptr = _as(_region, [&] {
+            return with_allocator(_region.allocator(), [&] {
+                auto it_and_flag = _cache.emplace(key, this, key);
+                entry &cp = *it_and_flag.first;
+                assert(it_and_flag.second);
+                cp._prefetched = prefetch;
+                try {
+                    return share(cp);
+                } catch (...) {
+                    _cache.erase(key);
+                    throw;
+                }
+            });
+        });
+
+        // No exceptions before then_wrapped() is installed so that ptr will be eventually populated.
+
+        return futurize_invoke(loader, key).then_wrapped([this, key, ptr = std::move(ptr)] (auto&& f) mutable {
+            entry& e = ptr.get_entry();
+            try {
+                partition_index_page&& page = f.get0();
+                e.promise()->set_value();
+                e.set_page(std::move(page));
+                on_populated(e);
+                return ptr;
+            } catch (...) {
+                e.promise()->set_exception(std::current_exception());
+                ptr = {};
+                with_allocator(_region.allocator(), [&] {
+                    _cache.erase(key);
+                });
+                throw;
+            }
+        });
+    }
 public:
 
     // Create a cache with a given LRU attached.
@@ -190,6 +260,10 @@ class partition_index_cache {
         if (i != _cache.end() && i->_key == key) {
             entry& cp = *i;
             auto ptr = share(cp);
+            if (cp._prefetched) {
+                cp._prefetched = false;
+                ++_shard_stats.prefetch_hits;
+            }
             if (cp.ready()) {
                 ++_shard_stats.hits;
                 return make_ready_future<entry_ptr>(std::move(ptr));
@@ -203,48 +277,72 @@ class partition_index_cache {
 
         ++_shard_stats.misses;
         ++_shard_stats.blocks;
+        return load(key, std::forward<Loader>(loader), false);
+    }
 
-        entry_ptr ptr = _as(_region, [&] {
-            return with_allocator(_region.allocator(), [&] {
-                auto it_and_flag = _cache.emplace(key, this, key);
-                entry &cp = *it_and_flag.first;
-                assert(it_and_flag.second);
-                try {
-                    return share(cp);
-                } catch (...) {
-                    _cache.erase(key);
-                    throw;
-                }
-            });
-        });
+    // Loads the entry for the key in the background, unless it is already present,
+    // so that a later get_or_load() finds it.
+    //
+    // The loader object does not survive deferring, so the caller must deal with its liveness.
+    //
+    // The returned future must be waited on before destroying this instance.
+    template<typename Loader>
+    future<> prefetch(const key_type& key, Loader&& loader) {
+        auto i = _cache.lower_bound(key);
+        if (i != _cache.end() && i->_key == key) {
+            return make_ready_future<>();
+        }
+        ++_shard_stats.prefetches;
+        return load(key, std::forward<Loader>(loader), true).discard_result();
+    }
 
-        // No exceptions before then_wrapped() is installed so that ptr will be eventually populated.
+    lookup_kind classify(const key_type& key) const noexcept {
+        auto i = _cache.lower_bound(key);
+        if (i == _cache.end() || i->_key != key) {
+            return lookup_kind::miss;
+        }
+        return i->_prefetched ? lookup_kind::prefetched : lookup_kind::hit;
+    }
 
-        return futurize_invoke(loader, key).then_wrapped([this, key, ptr = std::move(ptr)] (auto&& f) mutable {
-            entry& e = ptr.get_entry();
-            try {
-                partition_index_page&& page = f.get0();
-                e.promise()->set_value();
-                e.set_page(std::move(page));
-                _shard_stats.used_bytes += e.size_in_allocator();
-                ++_shard_stats.populations;
-                return ptr;
-            } catch (...) {
-                e.promise()->set_exception(std::current_exception());
-                ptr = {};
-                with_allocator(_region.allocator(), [&] {
-                    _cache.erase(key);
-                });
-                throw;
-            }
-        });
+    // Marks the cache as hot, pinning its pages, or as cold.
+    void set_hot(bool hot) noexcept {
+        if (hot == _hot) {
+            return;
+        }
+        _hot = hot;
+        if (hot) {
+            _shard_stats.pinned_bytes += _used_bytes;
+        } else {
+            _shard_stats.pinned_bytes -= _used_bytes;
+        }
+    }
+
+    bool hot() const noexcept { return _hot; }
+
+    // Sets how many bytes the pages of hot caches may occupy on this shard
+    // before their eviction is no longer deferred.
+    static void set_pinned_bytes_budget(uint64_t budget) noexcept {
+        _pinned_bytes_budget = budget;
     }
 
     void on_evicted(entry& p) {
+        _used_bytes -= p.size_in_allocator();
         _shard_stats.used_bytes -= p.size_in_allocator();
+        if (_hot) {
+            _shard_stats.pinned_bytes -= p.size_in_allocator();
+        }
         ++_shard_stats.evictions;
     }
 
+    bool defer_eviction(entry& e) noexcept {
+        if (!_hot || _shard_stats.pinned_bytes > _pinned_bytes_budget) {
+            return false;
+        }
+        ++_shard_stats.pin_deferrals;
+        _lru.touch(e);
+        return true;
+    }
+
     static const stats& shard_stats() { return _shard_stats; }
 
     // Evicts all unreferenced entries.
@@ -275,4 +373,19 @@ void partition_index_cache::entry::on_evicted() noexcept {
     it.erase(key_less_comparator());
 }
 
+inline
+std::ostream& operator<<(std::ostream& os, partition_index_cache::lookup_kind k) {
+    switch (k) {
+    case partition_index_cache::lookup_kind::hit: return os << "hit";
+    case partition_index_cache::lookup_kind::miss: return os << "miss";
+    case partition_index_cache::lookup_kind::prefetched: return os << "prefetched";
+    }
+    abort();
+}
+
+inline
+bool partition_index_cache::entry::defer_eviction() noexcept {
+    return _parent->defer_eviction(*this);
+}
+
 }
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include <seastar/core/byteorder.hh>
+
+#include "sstables/partition_trie.hh"
+#include "schema.hh"
+
+namespace sstables {
+
+bytes byte_comparable_key(const dht::token& t, key_view k) {
+    assert(t._kind == dht::token_kind::key);
+    return k.with_linearized([&] (bytes_view kv) {
+        bytes ret(bytes::initialized_later(), sizeof(uint64_t) + kv.size());
+        // Flipping the sign bit makes the two's complement token order
+        // match the unsigned byte order.
+        write_be<uint64_t>(reinterpret_cast<char*>(ret.begin()), uint64_t(t._data) ^ (uint64_t(1) << 63));
+        std::copy(kv.begin(), kv.end(), ret.begin() + sizeof(uint64_t));
+        return ret;
+    });
+}
+
+bytes byte_comparable_key(const schema& s, const dht::decorated_key& dk) {
+    auto k = key::from_partition_key(s, dk.key());
+    return byte_comparable_key(dk.token(), key_view(k));
+}
+
+partition_trie::partition_trie() {
+    _nodes.emplace_back();
+}
+
+void partition_trie::insert(bytes_view prefix, key_index idx) {
+    // Keys come in increasing order, so the new path can only share
+    // the rightmost path of the trie.
+    uint32_t n = 0;
+    for (auto b : prefix) {
+        _nodes[n].last = idx;
+        auto& children = _nodes[n].children;
+        if (!children.empty() && children.back().first == uint8_t(b)) {
+            n = children.back().second;
+            continue;
+        }
+        auto child = uint32_t(_nodes.size());
+        _nodes[n].children.emplace_back(uint8_t(b), child);
+        _nodes.emplace_back();
+        n = child;
+    }
+    _nodes[n].last = idx;
+    _nodes[n].key = idx;
+    _bytes += prefix.size();
+    ++_size;
+}
+
+std::optional<partition_trie::key_index> partition_trie::floor(bytes_view k) const {
+    std::optional<key_index> best;
+    uint32_t n = 0;
+    for (auto b : k) {
+        auto& nd = _nodes[n];
+        if (nd.key) {
+            // A proper prefix of k.
+            best = nd.key;
+        }
+        auto it = std::lower_bound(nd.children.begin(), nd.children.end(), uint8_t(b), [] (const std::pair<uint8_t, uint32_t>& c, uint8_t b) {
+            return c.first < b;
+        });
+        if (it != nd.children.begin()) {
+            best = _nodes[std::prev(it)->second].last;
+        }
+        if (it == nd.children.end() || it->first != uint8_t(b)) {
+            return best;
+        }
+        n = it->second;
+    }
+    if (_nodes[n].key) {
+        best = _nodes[n].key;
+    }
+    return best;
+}
+
+static size_t common_prefix_length(bytes_view a, bytes_view b) {
+    return std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin();
+}
+
+void partition_trie::builder::add(bytes_view key) {
+    if (!_has_pending) {
+        _pending = bytes(key.begin(), key.end());
+        _has_pending = true;
+        return;
+    }
+    auto lcp = common_prefix_length(_pending, key);
+    assert(lcp < key.size() && (lcp == _pending.size() || uint8_t(_pending[lcp]) < uint8_t(key[lcp])));
+    // The pending key has to differ from both of its neighbours.
+    auto len = std::min(std::max(_pending_lcp, lcp) + 1, _pending.size());
+    _trie.insert(bytes_view(_pending).substr(0, len), _trie.size());
+    _pending = bytes(key.begin(), key.end());
+    _pending_lcp = lcp;
+}
+
+partition_trie partition_trie::builder::build() && {
+    if (_has_pending) {
+        auto len = std::min(_pending_lcp + 1, _pending.size());
+        _trie.insert(bytes_view(_pending).substr(0, len), _trie.size());
+        _has_pending = false;
+    }
+    return std::move(_trie);
+}
+
+}
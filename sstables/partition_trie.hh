@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "bytes.hh"
+#include "dht/token.hh"
+#include "sstables/key.hh"
+
+namespace sstables {
+
+// Returns a byte-comparable encoding of a partition position in an sstable.
+//
+// Comparing two encodings with compare_unsigned() gives the same result as
+// comparing the positions with ring_position_comparator_for_sstables:
+// an 8-byte big-endian token with the sign bit flipped, followed by the
+// key in its legacy (Origin-compatible) form.
+//
+// The token must be of kind token_kind::key.
+bytes byte_comparable_key(const dht::token& t, key_view k);
+bytes byte_comparable_key(const schema& s, const dht::decorated_key& dk);
+
+// In-memory trie over byte-comparable partition keys.
+//
+// Each key is stored only up to the shortest prefix which distinguishes it
+// from its neighbours, so the trie size depends on how much the keys differ
+// rather than on their length. In exchange, lookups return a candidate which
+// needs to be verified against the full key (e.g. the one in the Data or Index
+// file), in the same way the page-based index verifies the keys it finds.
+//
+// Keys are numbered in the order they were added.
+class partition_trie {
+public:
+    using key_index = uint32_t;
+private:
+    struct node {
+        // Children sorted by label.
+        std::vector<std::pair<uint8_t, uint32_t>> children;
+        // Index of the greatest key in this subtree.
+        key_index last;
+        std::optional<key_index> key;
+    };
+    std::vector<node> _nodes;
+    key_index _size = 0;
+    size_t _bytes = 0;
+public:
+    class builder;
+
+    partition_trie();
+
+    key_index size() const noexcept { return _size; }
+    bool empty() const noexcept { return _size == 0; }
+
+    // Returns the index of the greatest key whose stored prefix is not greater
+    // than k, or std::nullopt if there is no such key.
+    //
+    // The first key which is not less than k is either the returned one or the
+    // one following it (the first one if std::nullopt was returned). In
+    // particular, if k is present in the trie, its index is returned.
+    std::optional<key_index> floor(bytes_view k) const;
+
+    // Number of trie nodes, for memory accounting.
+    size_t node_count() const noexcept { return _nodes.size(); }
+    // Total length of the stored key prefixes.
+    size_t stored_bytes() const noexcept { return _bytes; }
+private:
+    void insert(bytes_view prefix, key_index idx);
+};
+
+// Builds a partition_trie from keys added in increasing order.
+// Only two keys are held at a time, so the trie can be built on the fly
+// while the keys are written.
+class partition_trie::builder {
+    partition_trie _trie;
+    bytes _pending;
+    size_t _pending_lcp = 0;
+    bool _has_pending = false;
+public:
+    // Keys must be added in strictly increasing compare_unsigned() order.
+    void add(bytes_view key);
+    partition_trie build() &&;
+};
+
+}
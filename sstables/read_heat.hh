@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "seastarx.hh"
+
+namespace sstables {
+
+// How much single partition reads use an sstable.
+//
+// Each counter is kept as a total, and as a recent value which is halved
+// every half_life, so that it follows changes of the workload. Decay is
+// applied lazily, when the counters are updated or read.
+class read_heat {
+public:
+    static constexpr lowres_clock::duration half_life = std::chrono::minutes(10);
+
+    struct counters {
+        // Lookups of partition keys in the bloom filter, and how many of
+        // them the filter didn't rule out.
+        uint64_t filter_probes = 0;
+        uint64_t filter_positives = 0;
+        // Lookups which found the partition in the index.
+        uint64_t index_lookups = 0;
+        // Size in the data file of the partitions found. Reads which
+        // are sliced or stop early read less.
+        uint64_t bytes_read = 0;
+    };
+private:
+    counters _total;
+    counters _recent;
+    lowres_clock::time_point _last_decay = lowres_clock::now();
+
+    void maybe_decay() noexcept {
+        auto periods = (lowres_clock::now() - _last_decay) / half_life;
+        if (!periods) [[likely]] {
+            return;
+        }
+        auto shift = std::min<int64_t>(periods, 63);
+        _recent.filter_probes >>= shift;
+        _recent.filter_positives >>= shift;
+        _recent.index_lookups >>= shift;
+        _recent.bytes_read >>= shift;
+        _last_decay += periods * half_life;
+    }
+public:
+    void on_filter_probe(bool positive) noexcept {
+        maybe_decay();
+        ++_total.filter_probes;
+        ++_recent.filter_probes;
+        _total.filter_positives += positive;
+        _recent.filter_positives += positive;
+    }
+
+    void on_partition_found(uint64_t size) noexcept {
+        maybe_decay();
+        ++_total.index_lookups;
+        ++_recent.index_lookups;
+        _total.bytes_read += size;
+        _recent.bytes_read += size;
+    }
+
+    const counters& total() const noexcept {
+        return _total;
+    }
+
+    const counters& recent() noexcept {
+        maybe_decay();
+        return _recent;
+    }
+};
+
+} // namespace sstables
@@ -98,13 +98,13 @@ void sstable_directory::validate(sstables::shared_sstable sst) const {
 }
 
 future<>
-sstable_directory::process_descriptor(sstables::entry_descriptor desc, const ::io_priority_class& iop, bool sort_sstables_according_to_owner) {
+sstable_directory::process_descriptor(sstables::entry_descriptor desc, const ::io_priority_class& iop, bool sort_sstables_according_to_owner, sstable_open_config cfg) {
     if (desc.version > _max_version_seen) {
         _max_version_seen = desc.version;
     }
 
     auto sst = _sstable_object_from_existing_sstable(_sstable_dir, desc.generation, desc.version, desc.format);
-    return sst->load(iop).then([this, sst] {
+    return sst->load(iop, cfg).then([this, sst] {
         validate(sst);
         if (_need_mutate_level) {
             dirlog.trace("Mutating {} to level 0\n", sst->get_filename());
@@ -154,7 +154,7 @@ sstable_directory::highest_version_seen() const {
 }
 
 future<>
-sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort_sstables_according_to_owner) {
+sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort_sstables_according_to_owner, sstable_open_config cfg) {
     dirlog.debug("Start processing directory {} for SSTables", _sstable_dir);
 
     // It seems wasteful that each shard is repeating this scan, and to some extent it is.
@@ -200,11 +200,11 @@ sstable_directory::process_sstable_dir(const ::io_priority_class& iop, bool sort
 
     // _descriptors is everything with a TOC. So after we remove this, what's left is
     // SSTables for which a TOC was not found.
-    co_await parallel_for_each_restricted(state.descriptors, [this, sort_sstables_according_to_owner, &state, &iop] (std::tuple<int64_t, sstables::entry_descriptor>&& t) {
+    co_await parallel_for_each_restricted(state.descriptors, [this, sort_sstables_according_to_owner, cfg, &state, &iop] (std::tuple<int64_t, sstables::entry_descriptor>&& t) {
         auto& desc = std::get<1>(t);
         state.generations_found.erase(desc.generation);
         // This will try to pre-load this file and throw an exception if it is invalid
-        return process_descriptor(std::move(desc), iop, sort_sstables_according_to_owner);
+        return process_descriptor(std::move(desc), iop, sort_sstables_according_to_owner, cfg);
     });
 
     // For files missing TOC, it depends on where this is coming from.
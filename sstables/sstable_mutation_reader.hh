@@ -166,7 +166,7 @@ inline reversed_context<DataConsumeRowsContext> data_consume_reversed_partition(
 template <typename DataConsumeRowsContext>
 inline std::unique_ptr<DataConsumeRowsContext> data_consume_single_partition(const schema& s, shared_sstable sst, typename DataConsumeRowsContext::consumer& consumer, sstable::disk_read_range toread) {
     auto input = sst->data_stream(toread.start, toread.end - toread.start, consumer.io_priority(),
-            consumer.permit(), consumer.trace_state(), sst->_single_partition_history);
+            consumer.permit(), consumer.trace_state(), sst->_single_partition_history, sstable::raw_stream::no, sstable::use_data_cache::yes);
     return std::make_unique<DataConsumeRowsContext>(s, std::move(sst), consumer, std::move(input), toread.start, toread.end - toread.start);
 }
 
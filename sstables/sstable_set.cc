@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/util/defer.hh>
 
 #include <boost/icl/interval_map.hpp>
@@ -701,13 +702,20 @@ class incremental_reader_selector : public reader_selector {
 // Returning `false` means the sstable doesn't have such a partition.
 // Returning `true` means it may, i.e. we don't know whether or not it does.
 //
+// The key is hashed once, so that checking many sstables only costs a
+// lookup in each filter.
+//
 // Assumes the given `pos` and `schema` are alive during the function's lifetime.
 static std::predicate<const sstable&> auto
 make_pk_filter(const dht::ring_position& pos, const schema& schema) {
-    return [&pos, key = key::from_partition_key(schema, *pos.key()), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
-        return cmp(pos, sst.get_first_decorated_key()) >= 0 &&
-               cmp(pos, sst.get_last_decorated_key()) <= 0 &&
-               sst.filter_has_key(key);
+    auto hk = utils::make_hashed_key(bytes_view(key::from_partition_key(schema, *pos.key())));
+    return [&pos, hk, cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
+        if (cmp(pos, sst.get_first_decorated_key()) < 0 || cmp(pos, sst.get_last_decorated_key()) > 0) {
+            return false;
+        }
+        auto present = sst.filter_has_key(hk);
+        sst.get_read_heat().on_filter_probe(present);
+        return present;
     };
 }
 
@@ -758,6 +766,147 @@ sstable_set_impl::select_sstable_runs(const std::vector<shared_sstable>& sstable
     throw_with_backtrace<std::bad_function_call>();
 }
 
+// Whether a single-partition read can visit sstables in timestamp order and
+// stop early. This requires that the read selects a single row and only
+// cells which are reconciled by timestamp alone.
+static bool can_read_in_timestamp_order(const replica::column_family& cf, const schema& s, const partition_key& pk,
+        const query::partition_slice& slice, streamed_mutation::forwarding fwd, mutation_reader::forwarding fwd_mr) {
+    if (!cf.get_config().enable_timestamp_ordered_reads() || fwd || fwd_mr || slice.is_reversed() || s.is_counter()
+            || !slice.static_columns.empty() || slice.regular_columns.empty()) {
+        return false;
+    }
+    if (s.clustering_key_size()) {
+        auto& ranges = slice.row_ranges(s, pk);
+        if (ranges.size() != 1 || !ranges.front().is_singular() || !ranges.front().start()->value().is_full(s)) {
+            return false;
+        }
+    }
+    return std::all_of(slice.regular_columns.begin(), slice.regular_columns.end(), [&s] (column_id id) {
+        return s.regular_column_at(id).is_atomic();
+    });
+}
+
+// Reads a single row from sstables in descending order of their maximum
+// timestamp, and stops once the data read so far shadows anything the
+// remaining sstables could hold for the row: a row marker and a cell for
+// every selected column, all newer than the remaining sstables.
+//
+// Skipped sstables may hold older tombstones, which don't affect the row.
+// For tables with clustering keys, they must not hold partition tombstones,
+// so that the partition returned matches the one a full merge would return.
+class timestamp_ordered_reader : public flat_mutation_reader_v2::impl {
+    // Ordered by descending maximum timestamp.
+    std::vector<shared_sstable> _sstables;
+    std::function<flat_mutation_reader_v2(sstable&)> _create_reader;
+    const query::partition_slice& _slice;
+    partition_key _pk;
+    // Some sstables holding the partition were filtered out by clustering,
+    // so the partition has to be emitted even if no rows are found.
+    bool _emit_partition;
+    replica::cf_stats& _stats;
+    tracing::trace_state_ptr _trace_state;
+    std::optional<flat_mutation_reader_v2> _reader;
+private:
+    bool shadows_remaining(const mutation& m, size_t next) const {
+        if (_schema->clustering_key_size() && std::any_of(_sstables.begin() + next, _sstables.end(), [] (const shared_sstable& sst) {
+                return sst->may_have_partition_tombstones();
+        })) {
+            return false;
+        }
+        auto bound = _sstables[next]->get_stats_metadata().max_timestamp;
+        auto& rows = m.partition().clustered_rows();
+        if (rows.empty() || std::next(rows.begin()) != rows.end()) {
+            return false;
+        }
+        auto& row = rows.begin()->row();
+        if (row.marker().is_missing() || row.marker().timestamp() <= bound) {
+            return false;
+        }
+        return std::all_of(_slice.regular_columns.begin(), _slice.regular_columns.end(), [&] (column_id id) {
+            auto* cell = row.cells().find_cell(id);
+            return cell && cell->as_atomic_cell(_schema->regular_column_at(id)).timestamp() > bound;
+        });
+    }
+
+    future<std::vector<mutation>> read() {
+        mutation_opt result;
+        if (_emit_partition) {
+            result = mutation(_schema, _pk);
+        }
+        for (size_t i = 0; i < _sstables.size(); ++i) {
+            auto rd = _create_reader(*_sstables[i]);
+            auto mo = co_await read_mutation_from_flat_mutation_reader(rd).finally([&rd] {
+                return rd.close();
+            });
+            if (mo) {
+                if (result) {
+                    result->apply(std::move(*mo));
+                } else {
+                    result = std::move(mo);
+                }
+            }
+            auto next = i + 1;
+            if (next < _sstables.size() && result && shadows_remaining(*result, next)) {
+                tracing::trace(_trace_state, "Row is newer than the remaining {} sstables, skipping them", _sstables.size() - next);
+                _stats.sstables_skipped_by_timestamp += _sstables.size() - next;
+                break;
+            }
+        }
+        std::vector<mutation> ret;
+        if (result) {
+            ret.push_back(std::move(*result));
+        }
+        co_return ret;
+    }
+public:
+    timestamp_ordered_reader(schema_ptr s, reader_permit permit, std::vector<shared_sstable> sstables,
+            std::function<flat_mutation_reader_v2(sstable&)> create_reader, const query::partition_slice& slice,
+            partition_key pk, bool emit_partition, replica::cf_stats& stats, tracing::trace_state_ptr trace_state)
+        : impl(std::move(s), std::move(permit))
+        , _sstables(std::move(sstables))
+        , _create_reader(std::move(create_reader))
+        , _slice(slice)
+        , _pk(std::move(pk))
+        , _emit_partition(emit_partition)
+        , _stats(stats)
+        , _trace_state(std::move(trace_state))
+    {
+        std::sort(_sstables.begin(), _sstables.end(), [] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_stats_metadata().max_timestamp > b->get_stats_metadata().max_timestamp;
+        });
+    }
+
+    virtual future<> fill_buffer() override {
+        if (!_reader) {
+            _reader = make_flat_mutation_reader_from_mutations_v2(_schema, _permit, co_await read(), _slice);
+        }
+        co_await _reader->fill_buffer();
+        _reader->move_buffer_content_to(*this);
+        _end_of_stream = _reader->is_end_of_stream() && _reader->is_buffer_empty();
+    }
+
+    virtual future<> next_partition() override {
+        // There is a single partition.
+        clear_buffer_to_next_partition();
+        if (is_buffer_empty() && _reader) {
+            _end_of_stream = true;
+        }
+        return make_ready_future<>();
+    }
+
+    virtual future<> fast_forward_to(const dht::partition_range&) override {
+        return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+    }
+
+    virtual future<> fast_forward_to(position_range) override {
+        return make_exception_future<>(make_backtraced_exception_ptr<std::bad_function_call>());
+    }
+
+    virtual future<> close() noexcept override {
+        return _reader ? _reader->close() : make_ready_future<>();
+    }
+};
+
 flat_mutation_reader_v2
 sstable_set_impl::create_single_key_sstable_reader(
         replica::column_family* cf,
@@ -777,8 +926,19 @@ sstable_set_impl::create_single_key_sstable_reader(
     if (!num_sstables) {
         return make_empty_flat_reader_v2(schema, permit);
     }
+    auto filtered_sstables = filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice);
+    if (filtered_sstables.size() > 1 && can_read_in_timestamp_order(*cf, *schema, *pos.key(), slice, fwd, fwd_mr)) {
+        sstable_histogram.add(filtered_sstables.size());
+        bool emit_partition = filtered_sstables.size() != num_sstables;
+        auto create_reader = [schema, permit, &pr, &slice, &pc, trace_state, fwd] (sstable& sst) {
+            tracing::trace(trace_state, "Reading key {} from sstable {}", pr.start()->value(), seastar::value_of([&sst] { return sst.get_filename(); }));
+            return sst.make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
+        };
+        return make_flat_mutation_reader_v2<timestamp_ordered_reader>(schema, permit, std::move(filtered_sstables), std::move(create_reader), slice,
+                *pos.key(), emit_partition, *cf->cf_stats(), std::move(trace_state));
+    }
     auto readers = boost::copy_range<std::vector<flat_mutation_reader_v2>>(
-        filter_sstable_for_reader_by_ck(std::move(selected_sstables), *cf, schema, slice)
+        filtered_sstables
         | boost::adaptors::transformed([&] (const shared_sstable& sstable) {
             tracing::trace(trace_state, "Reading key {} from sstable {}", pos, seastar::value_of([&sstable] { return sstable->get_filename(); }));
             return sstable->make_reader(schema, permit, pr, slice, pc, trace_state, fwd);
@@ -1091,13 +1251,16 @@ sstable_set::make_range_sstable_reader(
             (shared_sstable& sst, const dht::partition_range& pr) mutable {
         return sst->make_reader(s, permit, pr, slice, pc, trace_state, fwd, fwd_mr, monitor_generator(sst));
     };
+    // Scans read many partitions from each sstable, so have all of them
+    // reading ahead rather than only those the merge is at.
     return make_combined_reader(s, std::move(permit), std::make_unique<incremental_reader_selector>(s,
                     shared_from_this(),
                     pr,
                     std::move(trace_state),
                     std::move(reader_factory_fn)),
             fwd,
-            fwd_mr);
+            fwd_mr,
+            combined_reader_lookahead::yes);
 }
 
 flat_mutation_reader_v2
@@ -84,6 +84,8 @@ namespace sstables {
 
 logging::logger sstlog("sstable");
 
+extern thread_local cached_file::metrics data_page_cache_metrics;
+
 // Because this is a noop and won't hold any state, it is better to use a global than a
 // thread_local. It will be faster, specially on non-x86.
 struct noop_write_monitor final : public write_monitor {
@@ -571,7 +573,9 @@ inline void write(sstable_version_types v, file_writer& out, const std::unique_p
     write(v, out, *static_cast<Child *>(p.get()));
 }
 
-future<> parse(const schema& schema, sstable_version_types v, random_access_reader& in, statistics& s) {
+// Reads Statistics, skipping the compaction metadata when skip_compaction is set.
+// Its offset stays in s.offsets, so that it can be read later (see read_compaction_metadata()).
+static future<> parse_statistics(const schema& schema, sstable_version_types v, random_access_reader& in, statistics& s, bool skip_compaction) {
     try {
         co_await parse(schema, v, in, s.offsets);
         // Old versions of Scylla do not respect the order.
@@ -585,7 +589,9 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
                 co_await parse<validation_metadata>(schema, v, in, s.contents[type]);
                 break;
             case metadata_type::Compaction:
-                co_await parse<compaction_metadata>(schema, v, in, s.contents[type]);
+                if (!skip_compaction) {
+                    co_await parse<compaction_metadata>(schema, v, in, s.contents[type]);
+                }
                 break;
             case metadata_type::Stats:
                 co_await parse<stats_metadata>(schema, v, in, s.contents[type]);
@@ -609,6 +615,14 @@ future<> parse(const schema& schema, sstable_version_types v, random_access_read
     }
 }
 
+future<> parse(const schema& schema, sstable_version_types v, random_access_reader& in, statistics& s) {
+    return parse_statistics(schema, v, in, s, false);
+}
+
+future<> parse(const schema& schema, sstable_version_types v, random_access_reader& in, statistics_without_compaction_metadata& s) {
+    return parse_statistics(schema, v, in, s.target, true);
+}
+
 inline void write(sstable_version_types v, file_writer& out, const statistics& s) {
     write(v, out, s.offsets);
     for (auto&& e : s.offsets.elements) {
@@ -1061,7 +1075,13 @@ future<> sstable::read_compression(const io_priority_class& pc) {
         return make_ready_future<>();
     }
 
-    return read_simple<component_type::CompressionInfo>(_components->compression, pc);
+    return read_simple<component_type::CompressionInfo>(_components->compression, pc).then([this] {
+        if (_components->scylla_metadata) {
+            if (auto* dict = _components->scylla_metadata->get_compression_dictionary()) {
+                _components->compression.set_dictionary(dict->data.value);
+            }
+        }
+    });
 }
 
 void sstable::write_compression(const io_priority_class& pc) {
@@ -1176,8 +1196,38 @@ double sstable::estimate_droppable_tombstone_ratio(gc_clock::time_point gc_befor
     return 0.0f;
 }
 
-future<> sstable::read_statistics(const io_priority_class& pc) {
-    return read_simple<component_type::Statistics>(_components->statistics, pc);
+future<> sstable::read_statistics(const io_priority_class& pc, bool load_compaction_metadata) {
+    if (!load_compaction_metadata) {
+        statistics_without_compaction_metadata s{_components->statistics};
+        co_await read_simple<component_type::Statistics>(s, pc);
+        co_return;
+    }
+    co_await read_simple<component_type::Statistics>(_components->statistics, pc);
+}
+
+future<std::unique_ptr<metadata>> sstable::read_compaction_metadata(const io_priority_class& pc) {
+    auto& offsets = _components->statistics.offsets.elements;
+    auto it = std::find_if(offsets.begin(), offsets.end(), [] (auto& e) { return e.first == metadata_type::Compaction; });
+    if (it == offsets.end()) {
+        co_return nullptr;
+    }
+    sstlog.debug("Reading the compaction metadata of {}", get_filename());
+    auto f = co_await new_sstable_component_file(_read_error_handler, component_type::Statistics, open_flags::ro);
+    auto size = co_await f.size();
+    file_random_access_reader r(std::move(f), size, sstable_buffer_size);
+    std::unique_ptr<metadata> m;
+    std::exception_ptr ex;
+    try {
+        co_await r.seek(it->second);
+        co_await parse<compaction_metadata>(*_schema, _version, r, m);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await r.close();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+    co_return m;
 }
 
 void sstable::write_statistics(const io_priority_class& pc) {
@@ -1191,6 +1241,13 @@ void sstable::rewrite_statistics(const io_priority_class& pc) {
     file_output_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
+    auto& contents = _components->statistics.contents;
+    if (!contents.contains(metadata_type::Compaction)) {
+        // Left on disk when the sstable was loaded, see sstable_open_config.
+        if (auto m = read_compaction_metadata(pc).get0()) {
+            contents[metadata_type::Compaction] = std::move(m);
+        }
+    }
     auto w = make_component_file_writer(component_type::TemporaryStatistics, std::move(options),
             open_flags::wo | open_flags::create | open_flags::truncate).get0();
     write(_version, w, _components->statistics);
@@ -1272,6 +1329,13 @@ future<> sstable::update_info_for_opened_data() {
         }
         _data_file_size = st.st_size;
         _data_file_write_time = db_clock::from_time_t(st.st_mtime);
+        if (this->has_component(component_type::CompressionInfo) && _manager.config().enable_compressed_data_cache()) {
+            _cached_data_file = seastar::make_shared<cached_file>(_data_file,
+                                                                  data_page_cache_metrics,
+                                                                  _manager.get_cache_tracker().get_lru(),
+                                                                  _manager.get_cache_tracker().region(),
+                                                                  _data_file_size);
+        }
     }).then([this] {
         return _index_file.size().then([this] (auto size) {
             _index_file_size = size;
@@ -1335,6 +1399,8 @@ future<> sstable::create_data() noexcept {
 future<> sstable::drop_caches() {
     return _cached_index_file->evict_gently().then([this] {
         return _index_cache->evict_gently();
+    }).then([this] {
+        return _cached_data_file ? _cached_data_file->evict_gently() : make_ready_future<>();
     });
 }
 
@@ -1347,6 +1413,11 @@ future<> sstable::read_filter(const io_priority_class& pc) {
     return seastar::async([this, &pc] () mutable {
         sstables::filter filter;
         read_simple<component_type::Filter>(filter, pc).get();
+        auto* ff = _components->scylla_metadata ? _components->scylla_metadata->get_filter_format() : nullptr;
+        if (ff && ff->layout == filter_layout::split_block) {
+            _components->filter = utils::filter::create_split_block_filter(std::move(filter.buckets.elements));
+            return;
+        }
         auto nr_bits = filter.buckets.elements.size() * std::numeric_limits<typename decltype(filter.buckets.elements)::value_type>::digits;
         large_bitset bs(nr_bits, std::move(filter.buckets.elements));
         utils::filter_format format = (_version >= sstable_version_types::mc)
@@ -1361,6 +1432,14 @@ void sstable::write_filter(const io_priority_class& pc) {
         return;
     }
 
+    if (auto* sbf = dynamic_cast<utils::filter::split_block_bloom_filter*>(_components->filter.get())) {
+        // Versions which don't know the split-block layout see a filter
+        // with no hash functions, which treats every key as present.
+        auto filter_ref = sstables::filter_ref(0, sbf->get_storage());
+        write_simple<component_type::Filter>(filter_ref, pc);
+        return;
+    }
+
     auto f = static_cast<utils::filter::murmur3_bloom_filter *>(_components->filter.get());
 
     auto&& bs = f->bits();
@@ -1370,17 +1449,24 @@ void sstable::write_filter(const io_priority_class& pc) {
 
 // This interface is only used during tests, snapshot loading and early initialization.
 // No need to set tunable priorities for it.
-future<> sstable::load(const io_priority_class& pc) noexcept {
-    return read_toc().then([this, &pc] {
+future<> sstable::load(const io_priority_class& pc, sstable_open_config cfg) noexcept {
+    return read_toc().then([this, &pc, cfg] {
         // read scylla-meta after toc. Might need it to parse
         // rest (hint extensions)
-        return read_scylla_metadata(pc).then([this, &pc] {
+        return read_scylla_metadata(pc).then([this, &pc, cfg] {
             // Read statistics ahead of others - if summary is missing
             // we'll attempt to re-generate it and we need statistics for that
-            return read_statistics(pc).then([this, &pc] {
+            return read_statistics(pc, cfg.load_compaction_metadata).then([this, &pc, cfg] {
+                auto filter_read = make_ready_future<>();
+                if (cfg.load_bloom_filter) {
+                    filter_read = read_filter(pc);
+                } else {
+                    _components->filter = std::make_unique<utils::filter::always_present_filter>();
+                    _filter_deferred = has_component(component_type::Filter);
+                }
                 return seastar::when_all_succeed(
                         read_compression(pc),
-                        read_filter(pc),
+                        std::move(filter_read),
                         read_summary(pc)).then_unpack([this] {
                             validate_min_max_metadata();
                             validate_max_local_deletion_time();
@@ -1399,6 +1485,7 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
         _data_file = make_checked_file(_read_error_handler, info.data.to_file());
         _index_file = make_checked_file(_read_error_handler, info.index.to_file());
         _shards = std::move(info.owners);
+        _filter_deferred = info.filter_deferred;
         validate_min_max_metadata();
         validate_max_local_deletion_time();
         validate_partitioner();
@@ -1409,7 +1496,16 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
 future<foreign_sstable_open_info> sstable::get_open_info() & {
     return _components.copy().then([this] (auto c) mutable {
         return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
-            _generation, _version, _format, data_size()};
+            _generation, _version, _format, data_size(), _filter_deferred};
+    });
+}
+
+void sstable::load_filter_in_background(const io_priority_class& pc) {
+    if (!std::exchange(_filter_deferred, false)) {
+        return;
+    }
+    _filter_load = read_filter(pc).handle_exception([this] (std::exception_ptr ep) {
+        sstlog.warn("Failed to load the filter of {}, all keys will be treated as present: {}", get_filename(), ep);
     });
 }
 
@@ -1589,6 +1685,14 @@ sstable::write_scylla_metadata(const io_priority_class& pc, shard_id shard, ssta
         o.value = bytes(to_bytes_view(sstring_view(origin)));
         _components->scylla_metadata->data.set<scylla_metadata_type::SSTableOrigin>(std::move(o));
     }
+    if (!_components->compression.dictionary().empty()) {
+        compression_dictionary dict;
+        dict.data.value = _components->compression.dictionary();
+        _components->scylla_metadata->data.set<scylla_metadata_type::CompressionDictionary>(std::move(dict));
+    }
+    if (dynamic_cast<const utils::filter::split_block_bloom_filter*>(_components->filter.get())) {
+        _components->scylla_metadata->data.set<scylla_metadata_type::FilterFormat>(filter_format_metadata{filter_layout::split_block});
+    }
 
     write_simple<component_type::Scylla>(*_components->scylla_metadata, pc);
 }
@@ -2140,6 +2244,7 @@ sstable::make_reader(
         read_monitor& mon) {
     const auto reversed = slice.is_reversed();
     if (_version >= version_types::mc && (!reversed || range.is_singular())) {
+        ++permit.get_read_stats().sstables_read;
         return mx::make_reader(shared_from_this(), std::move(schema), std::move(permit), range, slice, pc, std::move(trace_state), fwd, fwd_mr, mon);
     }
 
@@ -2164,6 +2269,7 @@ sstable::make_reader_v1(
         read_monitor& mon) {
     const auto reversed = slice.options.contains(query::partition_slice::option::reversed);
     auto max_result_size = permit.max_result_size();
+    ++permit.get_read_stats().sstables_read;
 
     if (_version >= version_types::mc) {
         if (reversed && !range.is_singular()) {
@@ -2310,14 +2416,16 @@ component_type sstable::component_from_sstring(version_types v, sstring &s) {
 }
 
 input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw) {
+        reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw,
+        use_data_cache cache) {
     file_input_stream_options options;
     options.buffer_size = sstable_buffer_size;
     options.io_priority_class = pc;
     options.read_ahead = 4;
     options.dynamic_adjustments = std::move(history);
 
-    file f = make_tracked_file(_data_file, std::move(permit));
+    file f = make_tracked_file(cache && _cached_data_file && raw == raw_stream::no ? make_cached_seastar_file(*_cached_data_file) : _data_file,
+            std::move(permit));
     if (trace_state) {
         f = tracing::make_traced_file(std::move(f), std::move(trace_state), format("{}:", get_filename()));
     }
@@ -2858,6 +2966,34 @@ std::vector<dht::decorated_key> sstable::get_key_samples(const schema& s, const
     return res;
 }
 
+future<std::optional<hll::HyperLogLog>> sstable::get_cardinality_estimator(const io_priority_class& pc) {
+    std::unique_ptr<metadata> loaded;
+    const metadata* m = nullptr;
+    auto entry = _components->statistics.contents.find(metadata_type::Compaction);
+    if (entry != _components->statistics.contents.end()) {
+        m = entry->second.get();
+    } else {
+        try {
+            loaded = co_await read_compaction_metadata(pc);
+        } catch (...) {
+            sstlog.warn("Failed to read the compaction metadata of {}: {}", get_filename(), std::current_exception());
+        }
+        m = loaded.get();
+    }
+    if (!m) {
+        co_return std::nullopt;
+    }
+    auto& cardinality = static_cast<const compaction_metadata&>(*m).cardinality.elements;
+    temporary_buffer<uint8_t> bytes(cardinality.size());
+    std::copy(cardinality.begin(), cardinality.end(), bytes.get_write());
+    try {
+        co_return hll::HyperLogLog::from_bytes(std::move(bytes));
+    } catch (const std::invalid_argument& e) {
+        sstlog.debug("Cannot use the cardinality estimator of {}: {}", get_filename(), e.what());
+    }
+    co_return std::nullopt;
+}
+
 uint64_t sstable::estimated_keys_for_range(const dht::token_range& range) {
     auto page_range = get_index_pages_for_range(range);
     if (!page_range) {
@@ -3075,7 +3211,9 @@ future<> replay_pending_delete_log(sstring pending_delete_log) {
 
 thread_local sstables_stats::stats sstables_stats::_shard_stats;
 thread_local partition_index_cache::stats partition_index_cache::_shard_stats;
+thread_local uint64_t partition_index_cache::_pinned_bytes_budget = 0;
 thread_local cached_file::metrics index_page_cache_metrics;
+thread_local cached_file::metrics data_page_cache_metrics;
 thread_local mc::cached_promoted_index::metrics promoted_index_cache_metrics;
 static thread_local seastar::metrics::metric_groups metrics;
 
@@ -3095,6 +3233,14 @@ future<> init_metrics() {
             sm::description("Index pages which got populated into memory")),
         sm::make_gauge("index_page_used_bytes", [] { return partition_index_cache::shard_stats().used_bytes; },
             sm::description("Amount of bytes used by index pages in memory")),
+        sm::make_derive("index_page_prefetches", [] { return partition_index_cache::shard_stats().prefetches; },
+            sm::description("Index pages which got prefetched into memory by range scans")),
+        sm::make_derive("index_page_prefetch_hits", [] { return partition_index_cache::shard_stats().prefetch_hits; },
+            sm::description("Index page requests which found a prefetched page")),
+        sm::make_gauge("index_page_pinned_bytes", [] { return partition_index_cache::shard_stats().pinned_bytes; },
+            sm::description("Amount of bytes used by index pages of hot sstables in memory")),
+        sm::make_derive("index_page_pin_deferrals", [] { return partition_index_cache::shard_stats().pin_deferrals; },
+            sm::description("Evictions of index pages of hot sstables which were deferred")),
 
         sm::make_derive("index_page_cache_hits", [] { return index_page_cache_metrics.page_hits; },
             sm::description("Index page cache requests which were served from cache")),
@@ -3109,6 +3255,17 @@ future<> init_metrics() {
         sm::make_gauge("index_page_cache_bytes_in_std", [] { return index_page_cache_metrics.bytes_in_std; },
             sm::description("Total number of bytes in temporary buffers which live in the std allocator")),
 
+        sm::make_derive("data_page_cache_hits", [] { return data_page_cache_metrics.page_hits; },
+            sm::description("Compressed data cache requests which were served from cache")),
+        sm::make_derive("data_page_cache_misses", [] { return data_page_cache_metrics.page_misses; },
+            sm::description("Compressed data cache requests which had to perform I/O")),
+        sm::make_derive("data_page_cache_evictions", [] { return data_page_cache_metrics.page_evictions; },
+            sm::description("Total number of compressed data cache pages which have been evicted")),
+        sm::make_derive("data_page_cache_populations", [] { return data_page_cache_metrics.page_populations; },
+            sm::description("Total number of compressed data cache pages which were inserted into the cache")),
+        sm::make_gauge("data_page_cache_bytes", [] { return data_page_cache_metrics.cached_bytes; },
+            sm::description("Total number of bytes cached in the compressed data cache")),
+
         sm::make_derive("pi_cache_hits_l0", [] { return promoted_index_cache_metrics.hits_l0; },
             sm::description("Number of requests for promoted index block in state l0 which didn't have to go to the page cache")),
         sm::make_derive("pi_cache_hits_l1", [] { return promoted_index_cache_metrics.hits_l1; },
@@ -3181,7 +3338,9 @@ future<> init_metrics() {
         sm::make_derive("total_deleted", [] { return sstables_stats::get_shard_stats().deleted; },
             sm::description("Counter of deleted sstables")),
 
-        sm::make_gauge("bloom_filter_memory_size", [] { return utils::filter::bloom_filter::get_shard_stats().memory_size; },
+        sm::make_gauge("bloom_filter_memory_size", [] {
+                return utils::filter::bloom_filter::get_shard_stats().memory_size + utils::filter::split_block_bloom_filter::get_shard_stats().memory_size;
+            },
             sm::description("Bloom filter memory usage in bytes.")),
     });
   });
@@ -3241,13 +3400,17 @@ void sstable::unused() {
 }
 
 future<> sstable::destroy() {
-    return close_files().finally([this] {
+    return std::exchange(_filter_load, make_ready_future<>()).then([this] {
+        return close_files();
+    }).finally([this] {
         return _index_cache->evict_gently().then([this] {
             if (_cached_index_file) {
                 return _cached_index_file->evict_gently();
             } else {
                 return make_ready_future<>();
             }
+        }).then([this] {
+            return _cached_data_file ? _cached_data_file->evict_gently() : make_ready_future<>();
         });
     });
 }
@@ -3334,6 +3497,53 @@ gc_clock::time_point sstable::get_gc_before_for_fully_expire(const gc_clock::tim
     return res.knows_entire_range ? res.min_gc_before : gc_clock::time_point::min();
 }
 
+std::optional<dht::partition_range_vector>
+sstable::get_unexpired_partition_ranges(gc_clock::time_point compaction_time, api::timestamp_type max_purgeable) const {
+    auto* index = _components->scylla_metadata ? _components->scylla_metadata->get_expiry_index() : nullptr;
+    auto& summary_entries = _components->summary.entries;
+    // The Summary is rebuilt from the Index when missing, and may then be
+    // sampled differently.
+    if (!index || index->entries.elements.size() != summary_entries.size()) {
+        return std::nullopt;
+    }
+    auto s = get_schema();
+    auto range = dht::token_range(dht::token_range::bound(get_first_decorated_key().token(), true),
+            dht::token_range::bound(get_last_decorated_key().token(), true));
+    auto res = ::get_gc_before_for_range(s, range, compaction_time);
+    if (!res.knows_entire_range) {
+        return std::nullopt;
+    }
+    auto is_expired = [&] (const expiry_index_entry& e) {
+        return gc_clock::time_point(gc_clock::duration(e.max_local_deletion_time)) < res.min_gc_before
+            && e.max_timestamp < max_purgeable;
+    };
+    auto& entries = index->entries.elements;
+    if (std::ranges::none_of(entries, is_expired)) {
+        return std::nullopt;
+    }
+    auto entry_key = [&] (size_t i) {
+        return dht::decorate_key(*s, summary_entries[i].get_key().to_partition_key(*s));
+    };
+    dht::partition_range_vector ranges;
+    size_t i = 0;
+    while (i < entries.size()) {
+        if (is_expired(entries[i])) {
+            ++i;
+            continue;
+        }
+        auto start = i;
+        while (i < entries.size() && !is_expired(entries[i])) {
+            ++i;
+        }
+        auto start_bound = start == 0 ? std::nullopt : std::make_optional(dht::partition_range::bound(entry_key(start), true));
+        auto end_bound = i == entries.size() ? std::nullopt : std::make_optional(dht::partition_range::bound(entry_key(i), false));
+        ranges.emplace_back(std::move(start_bound), std::move(end_bound));
+    }
+    sstlog.debug("Leaving out {} of {} summary entries of {} as expired",
+            std::ranges::count_if(entries, is_expired), entries.size(), get_filename());
+    return ranges;
+}
+
 }
 
 namespace seastar {
@@ -31,6 +31,7 @@
 #include <seastar/core/stream.hh>
 #include "encoding_stats.hh"
 #include "filter.hh"
+#include "read_heat.hh"
 #include "exceptions.hh"
 #include "mutation_reader.hh"
 #include "query-request.hh"
@@ -55,6 +56,10 @@ class sstable_assertions;
 class flat_mutation_reader;
 class cached_file;
 
+namespace hll {
+class HyperLogLog;
+}
+
 namespace sstables {
 
 namespace mc {
@@ -108,7 +113,10 @@ struct sstable_writer_config {
     write_monitor* monitor = &default_write_monitor();
     utils::UUID run_identifier = utils::make_random_uuid();
     size_t summary_byte_cost;
+    // Number of buffers each component writer may have in flight.
+    unsigned write_behind = 10;
     sstring origin;
+    bool split_block_bloom_filter = false;
 
 private:
     explicit sstable_writer_config() {}
@@ -178,7 +186,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // load all components from disk
     // this variant will be useful for testing purposes and also when loading
     // a new sstable from scratch for sharing its components.
-    future<> load(const io_priority_class& pc = default_priority_class()) noexcept;
+    future<> load(const io_priority_class& pc = default_priority_class(), sstable_open_config cfg = {}) noexcept;
+    // Reads the filter of an sstable loaded with load_bloom_filter = false,
+    // without waiting for it. Until it is read, every key is reported as
+    // present. destroy() waits for the read to finish.
+    //
+    // pc must outlive the read.
+    void load_filter_in_background(const io_priority_class& pc);
     future<> open_data() noexcept;
     future<> update_info_for_opened_data();
 
@@ -283,6 +297,14 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return get_estimated_key_count(_components->summary.header.size_at_full_sampling, _components->summary.header.min_index_interval);
     }
 
+    // The estimator of the number of distinct partition keys, from the
+    // compaction metadata. Disengaged if the sstable has none that we can
+    // read, e.g. if it was written by Cassandra.
+    //
+    // Reads the compaction metadata from disk if the sstable was loaded
+    // without it, see sstable_open_config.
+    future<std::optional<hll::HyperLogLog>> get_cardinality_estimator(const io_priority_class& pc);
+
     uint64_t estimated_keys_for_range(const dht::token_range& range);
 
     std::vector<dht::decorated_key> get_key_samples(const schema& s, const dht::token_range& range);
@@ -504,9 +526,15 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     file _index_file;
     seastar::shared_ptr<cached_file> _cached_index_file;
     file _data_file;
+    // Pages of the Data file read by single-partition reads, for compressed
+    // sstables when enable_compressed_data_cache is set.
+    seastar::shared_ptr<cached_file> _cached_data_file;
     uint64_t _data_file_size;
     uint64_t _index_file_size;
     uint64_t _filter_file_size = 0;
+    // The filter was not read by load() yet.
+    bool _filter_deferred = false;
+    future<> _filter_load = make_ready_future<>();
     uint64_t _bytes_on_disk = 0;
     db_clock::time_point _data_file_write_time;
     position_range _position_range = position_range::all_clustered_rows();
@@ -528,6 +556,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     format_types _format;
 
     filter_tracker _filter_tracker;
+    // Updated by reads, which may only have a const sstable.
+    mutable read_heat _read_heat;
     std::unique_ptr<partition_index_cache> _index_cache;
 
     enum class mark_for_deletion {
@@ -608,7 +638,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // happen if old tools are being used.
     future<> generate_summary(const io_priority_class& pc);
 
-    future<> read_statistics(const io_priority_class& pc);
+    future<> read_statistics(const io_priority_class& pc, bool load_compaction_metadata = true);
+    // Reads the compaction metadata of Statistics, for sstables loaded without it.
+    // Returns nullptr if Statistics has none.
+    future<std::unique_ptr<metadata>> read_compaction_metadata(const io_priority_class& pc);
     void write_statistics(const io_priority_class& pc);
     // Rewrite statistics component by creating a temporary Statistics and
     // renaming it into place of existing one.
@@ -645,9 +678,16 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     //
     // When created with `raw_stream::yes`, the sstable data file will be
     // streamed as-is, without decompressing (if compressed).
+    //
+    // When created with `use_data_cache::yes`, the data file is read through
+    // the compressed data cache, if the sstable has one. Only reads which are
+    // likely to be repeated should use it, so that scans and compaction don't
+    // push the rest of the cache out.
     using raw_stream = bool_class<class raw_stream_tag>;
+    using use_data_cache = bool_class<class use_data_cache_tag>;
     input_stream<char> data_stream(uint64_t pos, size_t len, const io_priority_class& pc,
-            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no);
+            reader_permit permit, tracing::trace_state_ptr trace_state, lw_shared_ptr<file_input_stream_history> history, raw_stream raw = raw_stream::no,
+            use_data_cache cache = use_data_cache::no);
 
     // Read exactly the specific byte range from the data file (after
     // uncompression, if the file is compressed). This can be used to read
@@ -771,6 +811,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return t;
     }
 
+    read_heat& get_read_heat() const noexcept {
+        return _read_heat;
+    }
+
     const statistics& get_statistics() const {
         return _components->statistics;
     }
@@ -813,6 +857,13 @@ class sstable : public enable_lw_shared_from_this<sstable> {
         return gc_clock::time_point(gc_clock::duration(get_stats_metadata().max_local_deletion_time));
     }
 
+    // Returns the ranges of partitions a compaction has to read, leaving out
+    // the runs of partitions which the expiry index shows to hold only data
+    // expired past gc grace, all of it older than max_purgeable. Returns
+    // std::nullopt when no partition can be left out.
+    std::optional<dht::partition_range_vector> get_unexpired_partition_ranges(gc_clock::time_point compaction_time,
+            api::timestamp_type max_purgeable) const;
+
     uint32_t get_sstable_level() const {
         return get_stats_metadata().sstable_level;
     }
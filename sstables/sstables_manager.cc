@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/memory.hh>
+
 #include "log.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
@@ -21,6 +23,7 @@ logging::logger smlogger("sstables_manager");
 sstables_manager::sstables_manager(
     db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker& ct)
     : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct) {
+    partition_index_cache::set_pinned_bytes_budget(dbcfg.index_cache_pinned_memory_fraction() * memory::stats().total_memory());
 }
 
 sstables_manager::~sstables_manager() {
@@ -52,6 +55,8 @@ sstable_writer_config sstables_manager::configure_writer(sstring origin) const {
             ? mutation_fragment_stream_validation_level::clustering_key
             : mutation_fragment_stream_validation_level::token;
     cfg.summary_byte_cost = summary_byte_cost(_db_config.sstable_summary_ratio());
+    cfg.write_behind = std::max(_db_config.sstable_write_behind(), 1u);
+    cfg.split_block_bloom_filter = _db_config.enable_sstable_split_block_bloom_filter();
 
     cfg.origin = std::move(origin);
 
@@ -525,6 +525,9 @@ enum class scylla_metadata_type : uint32_t {
     RunIdentifier = 4,
     LargeDataStats = 5,
     SSTableOrigin = 6,
+    CompressionDictionary = 7,
+    FilterFormat = 8,
+    ExpiryIndex = 9,
 };
 
 struct run_identifier {
@@ -556,6 +559,48 @@ struct large_data_stats_entry {
     auto describe_type(sstable_version_types v, Describer f) { return f(max_value, threshold, above_threshold); }
 };
 
+// Dictionary the Data component was compressed with.
+struct compression_dictionary {
+    disk_string<uint32_t> data;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(data); }
+};
+
+// Layout of the Filter component, when it is not the one implied
+// by the sstable version.
+//
+// Note: never reuse an identifier, since these are stored on stable storage.
+enum class filter_layout : uint32_t {
+    split_block = 1,
+};
+
+struct filter_format_metadata {
+    filter_layout layout;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(layout); }
+};
+
+struct expiry_index_entry {
+    int32_t max_local_deletion_time;
+    int64_t max_timestamp;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(max_local_deletion_time, max_timestamp); }
+};
+
+// The greatest local deletion time and timestamp of the partitions sampled
+// by each Summary entry, that is those from the entry's key up to the next
+// entry's. Only written when some of the entries hold no live data which
+// doesn't expire.
+struct expiry_index {
+    disk_array<uint32_t, expiry_index_entry> entries;
+
+    template <typename Describer>
+    auto describe_type(sstable_version_types v, Describer f) { return f(entries); }
+};
+
 struct scylla_metadata {
     using extension_attributes = disk_hash<uint32_t, disk_string<uint32_t>, disk_string<uint32_t>>;
     using large_data_stats = disk_hash<uint32_t, large_data_type, large_data_stats_entry>;
@@ -567,7 +612,10 @@ struct scylla_metadata {
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExtensionAttributes, extension_attributes>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::RunIdentifier, run_identifier>,
             disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::LargeDataStats, large_data_stats>,
-            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::SSTableOrigin, sstable_origin>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::CompressionDictionary, compression_dictionary>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::FilterFormat, filter_format_metadata>,
+            disk_tagged_union_member<scylla_metadata_type, scylla_metadata_type::ExpiryIndex, expiry_index>
             > data;
 
     sstable_enabled_features get_features() const {
@@ -591,6 +639,15 @@ struct scylla_metadata {
         }
         return *ext;
     }
+    const compression_dictionary* get_compression_dictionary() const {
+        return data.get<scylla_metadata_type::CompressionDictionary, compression_dictionary>();
+    }
+    const filter_format_metadata* get_filter_format() const {
+        return data.get<scylla_metadata_type::FilterFormat, filter_format_metadata>();
+    }
+    const expiry_index* get_expiry_index() const {
+        return data.get<scylla_metadata_type::ExpiryIndex, expiry_index>();
+    }
     std::optional<utils::UUID> get_optional_run_identifier() const {
         auto* m = data.get<scylla_metadata_type::RunIdentifier, run_identifier>();
         return m ? std::make_optional(m->id) : std::nullopt;
@@ -654,6 +711,12 @@ struct statistics {
     std::unordered_map<metadata_type, std::unique_ptr<metadata>> contents;
 };
 
+// Parses into statistics all but the compaction metadata, whose entry in
+// offsets is kept so that it can be read when needed.
+struct statistics_without_compaction_metadata {
+    statistics& target;
+};
+
 enum class column_mask : uint8_t {
     none = 0x0,
     deletion = 0x01,
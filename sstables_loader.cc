@@ -8,6 +8,7 @@
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/rpc/rpc.hh>
+#include <seastar/util/defer.hh>
 #include "sstables_loader.hh"
 #include "replica/distributed_loader.hh"
 #include "replica/database.hh"
@@ -123,6 +124,17 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
 
     size_t nr_sst_total = sstables.size();
     size_t nr_sst_current = 0;
+    _progress = load_and_stream_progress{};
+    _progress.sstables_total = nr_sst_total;
+    for (auto& sst : sstables) {
+        _progress.partitions_total += sst->estimated_keys_for_range(full_token_range);
+    }
+    _progress_start = std::chrono::steady_clock::now();
+    _streaming = true;
+    auto stop_progress = defer([this] () noexcept {
+        _progress.duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - _progress_start).count();
+        _streaming = false;
+    });
     while (!sstables.empty()) {
         auto ops_uuid = utils::make_random_uuid();
         auto sst_set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s,
@@ -159,6 +171,7 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
                 bool is_partition_start = mf->is_partition_start();
                 if (is_partition_start) {
                     ++num_partitions_processed;
+                    ++_progress.partitions_streamed;
                     auto& start = mf->as_partition_start();
                     const auto& current_dk = start.key();
 
@@ -180,6 +193,7 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
                 }
                 frozen_mutation_fragment fmf = freeze(*s, *mf);
                 num_bytes_read += fmf.representation().size();
+                _progress.bytes_streamed += fmf.representation().size();
                 co_await parallel_for_each(current_targets, [&metas, &fmf, is_partition_start] (const gms::inet_address& node) {
                     return metas.at(node).send(fmf, is_partition_start);
                 });
@@ -229,10 +243,29 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
         if (failed) {
             std::rethrow_exception(eptr);
         }
+        _progress.sstables_streamed += sst_processed.size();
     }
     co_return;
 }
 
+future<load_and_stream_progress> sstables_loader::get_load_and_stream_progress() {
+    return container().map_reduce0([] (sstables_loader& loader) {
+        auto progress = loader._progress;
+        if (loader._streaming) {
+            progress.duration = std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::steady_clock::now() - loader._progress_start).count();
+        }
+        return progress;
+    }, load_and_stream_progress{}, [] (load_and_stream_progress a, const load_and_stream_progress& b) {
+        a.sstables_total += b.sstables_total;
+        a.sstables_streamed += b.sstables_streamed;
+        a.partitions_total += b.partitions_total;
+        a.partitions_streamed += b.partitions_streamed;
+        a.bytes_streamed += b.bytes_streamed;
+        a.duration = std::max(a.duration, b.duration);
+        return a;
+    });
+}
+
 // For more details, see the commends on column_family::load_new_sstables
 // All the global operations are going to happen here, and just the reloading happens
 // in there.
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <seastar/core/sharded.hh>
 #include "utils/UUID.hh"
 #include "sstables/shared_sstable.hh"
@@ -26,6 +27,21 @@ class view_update_generator;
 }
 }
 
+// Progress of load_and_stream, of one shard or summed over all shards.
+struct load_and_stream_progress {
+    // The number of sstables to stream, and of those streamed so far
+    uint64_t sstables_total = 0;
+    uint64_t sstables_streamed = 0;
+    // The estimated number of partitions in the sstables to stream, and
+    // the number of partitions streamed so far
+    uint64_t partitions_total = 0;
+    uint64_t partitions_streamed = 0;
+    // The size of the mutation fragments streamed so far
+    uint64_t bytes_streamed = 0;
+    // Seconds since streaming started, the longest of all shards
+    float duration = 0;
+};
+
 // The handler of the 'storage_service/load_new_ss_tables' endpoint which, in
 // turn, is the target of the 'nodetool refresh' command.
 // Gets sstables from the upload directory and makes them available in the
@@ -44,6 +60,10 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
     // ever arise.
     bool _loading_new_sstables = false;
 
+    load_and_stream_progress _progress;
+    std::chrono::steady_clock::time_point _progress_start;
+    bool _streaming = false;
+
     future<> load_and_stream(sstring ks_name, sstring cf_name,
             utils::UUID table_id, std::vector<sstables::shared_sstable> sstables,
             bool primary_replica_only);
@@ -74,4 +94,7 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
      */
     future<> load_new_sstables(sstring ks_name, sstring cf_name,
             bool load_and_stream, bool primary_replica_only);
+
+    // Returns the progress of the last load_and_stream, summed over all shards.
+    future<load_and_stream_progress> get_load_and_stream_progress();
 };
@@ -60,7 +60,10 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
                                              encoding_stats{}, pc).then([sst] {
                     return sst->open_data();
                 }).then([cf, sst, offstrategy, reason] {
-                    if (offstrategy && (reason == stream_reason::repair)) {
+                    // Bootstrap and replace trigger off-strategy compaction when they end.
+                    // For the other reasons, the received sstables are reshaped once no
+                    // more of them have arrived for a while.
+                    if (offstrategy && reason != stream_reason::bootstrap && reason != stream_reason::replace) {
                         sstables::sstlog.debug("Enabled automatic off-strategy trigger for table {}.{}",
                                 cf->schema()->ks_name(), cf->schema()->cf_name());
                         cf->enable_off_strategy_trigger();
@@ -151,6 +151,11 @@ future<> send_mutation_fragments(lw_shared_ptr<send_info> si) {
                                 return make_exception_future<stop_iteration>(std::runtime_error(format("Stream reader mutation_fragment validator failed, previous={}, current={}",
                                         validator.previous_mutation_fragment_kind(), mf->mutation_fragment_kind())));
                             }
+                            // Checking the token rather than the key keeps the validation cheap enough to be always on.
+                            if (mf->is_partition_start() && !validator(mf->as_partition_start().key().token())) {
+                                return make_exception_future<stop_iteration>(std::runtime_error(format("Stream reader mutation_fragment validator failed, previous token={}, current token={}",
+                                        validator.previous_token(), mf->as_partition_start().key().token())));
+                            }
                             frozen_mutation_fragment fmf = freeze(*s, *mf);
                             auto size = fmf.representation().size();
                             si->update(size);
@@ -249,6 +249,21 @@ def test_batch_get_item_hash(test_table_s):
     got_items = reply['Responses'][test_table_s.name]
     assert multiset(got_items) == multiset(items)
 
+# Test BatchGetItem reading several items of the same partition, requested
+# in an order different from their sort key order, interleaved with items of
+# another partition and with the key of an item which does not exist.
+def test_batch_get_item_same_partition(test_table_sn):
+    p1 = random_string()
+    p2 = random_string()
+    items = [{'p': p, 'c': c, 'val': random_string()} for p in (p1, p2) for c in range(5)]
+    with test_table_sn.batch_writer() as batch:
+        for item in items:
+            batch.put_item(item)
+    keys = [{'p': p, 'c': c} for c in (3, 0, 7, 4, 1, 2) for p in (p1, p2)]
+    reply = test_table_sn.meta.client.batch_get_item(RequestItems = {test_table_sn.name: {'Keys': keys, 'ConsistentRead': True}})
+    got_items = reply['Responses'][test_table_sn.name]
+    assert multiset(got_items) == multiset(items)
+
 # Test what do we get if we try to read two *missing* values in addition to
 # an existing one. It turns out the missing items are simply not returned,
 # with no sign they are missing.
@@ -378,16 +393,20 @@ def test_batch_get_item_large(test_table_sn):
 # is properly handled. This test relies on error injection available
 # only in Scylla compiled with appropriate flags (present in dev/debug/sanitize
 # modes) and is skipped otherwise.
+# Alternator reads all the requested keys of one partition with a single
+# query, so the keys are spread over several partitions for the one-shot
+# failure to leave some of them processed.
 def test_batch_get_item_partial(scylla_only, dynamodb, test_table_sn):
-    p = random_string()
+    ps = [random_string() for i in range(2)]
     content = random_string()
-    count = 10
+    count = 5
     with test_table_sn.batch_writer() as batch:
-        for i in range(count):
-            batch.put_item(Item={
-                'p': p, 'c': i, 'content': content})
+        for p in ps:
+            for i in range(count):
+                batch.put_item(Item={
+                    'p': p, 'c': i, 'content': content})
     responses = []
-    to_read = { test_table_sn.name: {'Keys': [{'p': p, 'c': c} for c in range(count)], 'ConsistentRead': True } }
+    to_read = { test_table_sn.name: {'Keys': [{'p': p, 'c': c} for p in ps for c in range(count)], 'ConsistentRead': True } }
     with scylla_inject_error(dynamodb, "alternator_batch_get_item", one_shot=True):
         some_keys_were_unprocessed = False
         while to_read:
@@ -400,7 +419,7 @@ def test_batch_get_item_partial(scylla_only, dynamodb, test_table_sn):
             assert test_table_sn.name in reply['Responses']
             responses.extend(reply['Responses'][test_table_sn.name])
         assert multiset(responses) == multiset(
-            [{'p': p, 'c': i, 'content': content} for i in range(count)])
+            [{'p': p, 'c': i, 'content': content} for p in ps for i in range(count)])
         assert some_keys_were_unprocessed
 
 # Test that if the batch read failure is total, i.e. all read requests
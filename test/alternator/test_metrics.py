@@ -226,6 +226,21 @@ def test_total_operations(dynamodb, metrics):
     with check_increases_metric(metrics, ['scylla_alternator_total_operations']):
         dynamodb.meta.client.describe_endpoints()
 
+# Test that repeating the same expression is counted as hits of the cache
+# of parsed expressions. The expression includes a random attribute name so
+# that it isn't cached already by previous tests. Each shard has its own
+# cache, so the requests are repeated more times than there are shards. The
+# cached expression is resolved again on each request, with its own values.
+def test_expression_cache(test_table_s, metrics):
+    with check_increases_metric(metrics, ['scylla_alternator_expression_cache_hits', 'scylla_alternator_expression_cache_misses']):
+        p = random_string()
+        a = 'a' + random_string()
+        for i in range(20):
+            test_table_s.update_item(Key={'p': p},
+                UpdateExpression=f'SET {a} = :val',
+                ExpressionAttributeValues={':val': i})
+        assert test_table_s.get_item(Key={'p': p}, ConsistentRead=True)['Item'][a] == 19
+
 # TODO: there are additional metrics which we don't yet test here. At the
 # time of this writing they are: latency histograms
 # ({put,get,delete,update}_item_latency, get_records_latency),
@@ -84,6 +84,23 @@ BOOST_AUTO_TEST_CASE(test_get_time_uuid) {
     BOOST_CHECK(unix_timestamp == millis);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_time_uuids) {
+    using utils::UUID, utils::UUID_gen;
+
+    auto before = UUID_gen::get_time_UUID();
+    std::vector<UUID> uuids(1000);
+    UUID_gen::get_time_UUIDs(uuids);
+    auto after = UUID_gen::get_time_UUID();
+
+    auto prev = before;
+    for (auto& uuid : uuids) {
+        BOOST_REQUIRE(uuid.is_timestamp());
+        BOOST_REQUIRE_LT(prev.timestamp(), uuid.timestamp());
+        prev = uuid;
+    }
+    BOOST_REQUIRE_LT(prev.timestamp(), after.timestamp());
+}
+
 std::strong_ordering timeuuid_legacy_tri_compare(bytes_view o1, bytes_view o2) {
     auto compare_pos = [&] (unsigned pos, int mask, std::strong_ordering ifequal) {
         auto d = (o1[pos] & mask) <=> (o2[pos] & mask);
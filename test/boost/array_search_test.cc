@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "utils/array-search.hh"
+
+// Checks whichever variant of array_search_gt() the CPU selects against
+// std::upper_bound(), for capacities which are and aren't multiples of 8.
+BOOST_AUTO_TEST_CASE(test_array_search_gt) {
+    std::mt19937_64 rnd(0);
+    for (int capacity : {4, 8, 12, 16, 20, 32}) {
+        for (int size = 0; size <= capacity; ++size) {
+            for (int i = 0; i < 100; ++i) {
+                std::vector<int64_t> array(capacity, utils::simple_key_unused_value);
+                // A small range of values gives duplicates.
+                for (int j = 0; j < size; ++j) {
+                    array[j] = int64_t(rnd() % 100) - 50;
+                }
+                std::sort(array.begin(), array.begin() + size);
+                auto val = int64_t(rnd() % 120) - 60;
+                auto expected = std::upper_bound(array.begin(), array.begin() + size, val) - array.begin();
+                BOOST_REQUIRE_EQUAL(utils::array_search_gt(val, array.data(), capacity, size), expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_array_search_gt_extremes) {
+    constexpr auto min = std::numeric_limits<int64_t>::min() + 1;
+    constexpr auto max = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> array(16, utils::simple_key_unused_value);
+    int size = 0;
+    for (auto v : {min, int64_t(-1), int64_t(0), int64_t(1), max}) {
+        array[size++] = v;
+    }
+    BOOST_REQUIRE_EQUAL(utils::array_search_gt(min - 1, array.data(), 16, size), 0);
+    BOOST_REQUIRE_EQUAL(utils::array_search_gt(min, array.data(), 16, size), 1);
+    BOOST_REQUIRE_EQUAL(utils::array_search_gt(0, array.data(), 16, size), 3);
+    BOOST_REQUIRE_EQUAL(utils::array_search_gt(max - 1, array.data(), 16, size), 4);
+    BOOST_REQUIRE_EQUAL(utils::array_search_gt(max, array.data(), 16, size), size);
+}
+
+// Checks whichever variant of array_search_N_min_gt() the CPU selects against
+// the scalar search, on arrays of unique values mixed with unused elements,
+// like the compact radix tree's indirect nodes keep.
+BOOST_AUTO_TEST_CASE(test_array_search_min_gt) {
+    std::mt19937 rnd(0);
+    auto check = [&rnd] (unsigned len, auto search) {
+        for (int i = 0; i < 1000; ++i) {
+            std::vector<uint8_t> values(128);
+            std::iota(values.begin(), values.end(), 0);
+            std::shuffle(values.begin(), values.end(), rnd);
+            std::vector<uint8_t> array(len);
+            for (unsigned j = 0; j < len; ++j) {
+                array[j] = rnd() % 4 == 0 ? 128 : values[j];
+            }
+            auto val = uint8_t(rnd() % 128);
+            BOOST_REQUIRE_EQUAL(search(val, array.data()), utils::array_search_min_gt(val, array.data(), len));
+        }
+    };
+    check(4, utils::array_search_4_min_gt);
+    check(8, utils::array_search_8_min_gt);
+    check(16, utils::array_search_16_min_gt);
+    check(32, utils::array_search_32_min_gt);
+
+    std::vector<uint8_t> array(16, 128);
+    BOOST_REQUIRE_EQUAL(utils::array_search_16_min_gt(0, array.data()), 16u);
+    array[3] = 127;
+    array[7] = 0;
+    BOOST_REQUIRE_EQUAL(utils::array_search_16_min_gt(0, array.data()), 3u);
+    BOOST_REQUIRE_EQUAL(utils::array_search_16_min_gt(127, array.data()), 16u);
+}
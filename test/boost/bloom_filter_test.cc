@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+#include "utils/bloom_filter.hh"
+#include "utils/bloom_calculations.hh"
+
+using namespace utils;
+
+namespace {
+
+bytes random_key(std::mt19937_64& rng) {
+    bytes b(bytes::initialized_later(), 16);
+    for (auto& c : b) {
+        c = int8_t(rng());
+    }
+    return b;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(split_block_bits_per_element_meets_target) {
+    for (double fp : {0.1, 0.01, 0.001, 0.0001}) {
+        auto bits = bloom_calculations::split_block_bits_per_element(fp);
+        BOOST_REQUIRE_LE(bloom_calculations::split_block_false_positive_rate(bits), fp);
+        BOOST_REQUIRE_GT(bloom_calculations::split_block_false_positive_rate(bits * 0.95), fp);
+    }
+    BOOST_REQUIRE_THROW(bloom_calculations::split_block_bits_per_element(1e-12), exceptions::unsupported_operation_exception);
+}
+
+BOOST_AUTO_TEST_CASE(split_block_filter_false_positive_rate) {
+    constexpr int64_t nr_keys = 100000;
+    constexpr double target_fp = 0.01;
+    std::mt19937_64 rng(42);
+
+    auto f = filter::create_split_block_filter(nr_keys, bloom_calculations::split_block_bits_per_element(target_fp));
+    std::vector<bytes> keys;
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        keys.push_back(random_key(rng));
+        f->add(keys.back());
+    }
+    for (auto& k : keys) {
+        BOOST_REQUIRE(f->is_present(k));
+        BOOST_REQUIRE(f->is_present(make_hashed_key(k)));
+    }
+
+    int64_t false_positives = 0;
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        false_positives += f->is_present(random_key(rng));
+    }
+    // Allow for the statistical noise of the sample.
+    BOOST_REQUIRE_LT(double(false_positives) / nr_keys, target_fp * 1.3);
+}
+
+BOOST_AUTO_TEST_CASE(split_block_filter_storage_round_trip) {
+    std::mt19937_64 rng(7);
+    auto f = filter::create_split_block_filter(1000, 10);
+    std::vector<bytes> keys;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back(random_key(rng));
+        f->add(keys.back());
+    }
+
+    auto& sbf = dynamic_cast<filter::split_block_bloom_filter&>(*f);
+    auto storage = sbf.get_storage();
+    auto copy = filter::create_split_block_filter(std::move(storage));
+    for (auto& k : keys) {
+        BOOST_REQUIRE(copy->is_present(k));
+    }
+
+    copy->clear();
+    BOOST_REQUIRE(!copy->is_present(keys.front()));
+
+    BOOST_REQUIRE_THROW(filter::create_split_block_filter(filter::split_block_bloom_filter::storage_type{}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(split_block_filter_shrink) {
+    constexpr int64_t nr_keys = 10000;
+    constexpr double target_fp = 0.01;
+    std::mt19937_64 rng(11);
+
+    // Created for eight times as many keys as are added.
+    auto f = filter::create_split_block_filter(8 * nr_keys, bloom_calculations::split_block_bits_per_element(target_fp));
+    auto& sbf = dynamic_cast<filter::split_block_bloom_filter&>(*f);
+    auto created_blocks = sbf.num_blocks();
+    BOOST_REQUIRE_EQUAL(created_blocks % 8, 0);
+
+    std::vector<bytes> keys;
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        keys.push_back(random_key(rng));
+        f->add(keys.back());
+    }
+    f->shrink(nr_keys, target_fp);
+    BOOST_REQUIRE_EQUAL(sbf.num_blocks(), created_blocks / 8);
+    BOOST_REQUIRE_EQUAL(sbf.get_storage().size(), sbf.num_blocks() * filter::split_block_bloom_filter::storage_words_per_block);
+    for (auto& k : keys) {
+        BOOST_REQUIRE(f->is_present(k));
+    }
+
+    int64_t false_positives = 0;
+    for (int64_t i = 0; i < nr_keys; ++i) {
+        false_positives += f->is_present(random_key(rng));
+    }
+    BOOST_REQUIRE_LT(double(false_positives) / nr_keys, target_fp * 1.5);
+
+    // Shrinking for more keys than the filter holds room for does nothing.
+    f->shrink(8 * nr_keys, target_fp);
+    BOOST_REQUIRE_EQUAL(sbf.num_blocks(), created_blocks / 8);
+}
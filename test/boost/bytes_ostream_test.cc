@@ -285,6 +285,28 @@ BOOST_AUTO_TEST_CASE(test_append_big_and_small_chunks) {
     buf.append(small);
 }
 
+BOOST_AUTO_TEST_CASE(test_reserve) {
+    auto data = tests::random::get_bytes(64 * 1024);
+
+    bytes_ostream buf;
+    buf.reserve(data.size());
+    BOOST_REQUIRE(buf.empty());
+    for (size_t pos = 0; pos < data.size(); pos += 1000) {
+        buf.write(bytes_view(data).substr(pos, 1000));
+    }
+    BOOST_REQUIRE(buf.is_linearized());
+    BOOST_REQUIRE(buf.view() == bytes_view(data));
+
+    // A stream which was written to keeps its chunks.
+    buf.reserve(1024 * 1024);
+    BOOST_REQUIRE_EQUAL(buf.size(), data.size());
+
+    bytes_ostream unused;
+    unused.reserve(1024);
+    BOOST_REQUIRE(unused.empty());
+    BOOST_REQUIRE_EQUAL(unused.linearize().size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(test_remove_suffix) {
     auto test = [] (size_t length, size_t suffix) {
         testlog.info("Testing buffer size {}  and suffix size {}", length, suffix);
@@ -35,3 +35,41 @@ BOOST_AUTO_TEST_CASE(test_caching_options) {
         BOOST_REQUIRE_THROW(caching_options::from_sstring(in_str), std::exception);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_caching_options_fractions) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        string_map in_map = { {"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"min_fraction", "0.1"}, {"max_fraction", "0.5"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE_EQUAL(co.min_fraction(), 0.1);
+        BOOST_REQUIRE_EQUAL(co.max_fraction(), 0.5);
+        BOOST_REQUIRE(co.to_map() == in_map);
+        BOOST_REQUIRE(caching_options::from_sstring(co.to_sstring()) == co);
+    }
+    {
+        caching_options co = caching_options::from_map({});
+        BOOST_REQUIRE_EQUAL(co.min_fraction(), 0);
+        BOOST_REQUIRE_EQUAL(co.max_fraction(), 1);
+        BOOST_REQUIRE(!co.to_map().contains("min_fraction"));
+        BOOST_REQUIRE(!co.to_map().contains("max_fraction"));
+    }
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"min_fraction", "0.6"}, {"max_fraction", "0.5"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"max_fraction", "1.5"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"min_fraction", "-0.1"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"min_fraction", "half"}}), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_caching_options_result_cache_ttl) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        string_map in_map = { {"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"result_cache_ttl_in_ms", "500"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE(co.result_cache_ttl() == std::chrono::milliseconds(500));
+        BOOST_REQUIRE(co.to_map() == in_map);
+        BOOST_REQUIRE(caching_options::from_sstring(co.to_sstring()) == co);
+    }
+    BOOST_REQUIRE(caching_options::from_map({}).result_cache_ttl() == std::chrono::milliseconds(0));
+    BOOST_REQUIRE(!caching_options::from_map({}).to_map().contains("result_cache_ttl_in_ms"));
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"result_cache_ttl_in_ms", "-1"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({{"result_cache_ttl_in_ms", "soon"}}), std::exception);
+}
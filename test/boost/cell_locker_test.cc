@@ -58,6 +58,9 @@ static schema_ptr make_schema_disjoint_with_others()
             .build();
 }
 
+// Enough stripes for the unrelated cells of the tests not to share any.
+static constexpr size_t stripe_count = 64 * 1024;
+
 static thread_local data_value empty_value = data_value(to_bytes(""));
 
 static db::timeout_clock::time_point no_timeout {
@@ -90,7 +93,7 @@ SEASTAR_TEST_CASE(test_simple_locking_cells) {
 
         auto s = make_schema();
         cell_locker_stats cl_stats;
-        cell_locker cl(s, cl_stats);
+        cell_locker cl(s, cl_stats, stripe_count);
 
         auto m = make_mutation(s, "0", { "s1", "s3" }, {
             make_row("one", { "r1", "r2" }),
@@ -110,7 +113,7 @@ SEASTAR_TEST_CASE(test_disjoint_mutations) {
     return seastar::async([&] {
         auto s = make_schema();
         cell_locker_stats cl_stats;
-        cell_locker cl(s, cl_stats);
+        cell_locker cl(s, cl_stats, stripe_count);
 
         auto m1 = make_mutation(s, "0", { "s1" }, {
                 make_row("one", { "r1", "r2" }),
@@ -136,7 +139,7 @@ SEASTAR_TEST_CASE(test_single_cell_overlap) {
 
         auto s = make_schema();
         cell_locker_stats cl_stats;
-        cell_locker cl(s, cl_stats);
+        cell_locker cl(s, cl_stats, stripe_count);
 
         auto m1 = make_mutation(s, "0", { "s1" }, {
                 make_row("one", { "r1", "r2" }),
@@ -170,7 +173,7 @@ SEASTAR_TEST_CASE(test_schema_change) {
         auto s1 = make_schema();
         auto s2 = make_alternative_schema();
         cell_locker_stats cl_stats;
-        cell_locker cl(s1, cl_stats);
+        cell_locker cl(s1, cl_stats, stripe_count);
 
         auto m1 = make_mutation(s1, "0", { "s1", "s2", "s3"}, {
             make_row("one", { "r1", "r2", "r3" }),
@@ -216,7 +219,7 @@ SEASTAR_TEST_CASE(test_timed_out) {
 
             auto s = make_schema();
             cell_locker_stats cl_stats;
-            cell_locker cl(s, cl_stats);
+            cell_locker cl(s, cl_stats, stripe_count);
 
             auto m1 = make_mutation(s, "0", { "s1", "s2", "s3"}, {
                     make_row("one", { "r2", "r3" }),
@@ -245,7 +248,7 @@ SEASTAR_TEST_CASE(test_locker_stats) {
 
         auto s = make_schema();
         cell_locker_stats cl_stats;
-        cell_locker cl(s, cl_stats);
+        cell_locker cl(s, cl_stats, stripe_count);
 
         auto m1 = make_mutation(s, "0", { "s2", "s3" }, {
                 make_row("one", { "r1", "r2" }),
@@ -259,8 +262,9 @@ SEASTAR_TEST_CASE(test_locker_stats) {
         BOOST_REQUIRE_EQUAL(cl_stats.lock_acquisitions, 4);
         BOOST_REQUIRE_EQUAL(cl_stats.operations_waiting_for_lock, 0);
 
+        // Cells are counted as acquired once all of the write's are.
         auto f2 = cl.lock_cells(m2.decorated_key(), partition_cells_range(m2.partition()), no_timeout);
-        BOOST_REQUIRE_EQUAL(cl_stats.lock_acquisitions, 5);
+        BOOST_REQUIRE_EQUAL(cl_stats.lock_acquisitions, 4);
         BOOST_REQUIRE_EQUAL(cl_stats.operations_waiting_for_lock, 1);
         BOOST_REQUIRE(!f2.available());
 
@@ -270,3 +274,31 @@ SEASTAR_TEST_CASE(test_locker_stats) {
         BOOST_REQUIRE_EQUAL(cl_stats.operations_waiting_for_lock, 0);
     });
 }
+
+SEASTAR_TEST_CASE(test_shared_stripe) {
+    return seastar::async([&] {
+        auto destroy = [] (auto) { };
+
+        auto s = make_schema();
+        cell_locker_stats cl_stats;
+        // All cells share the only stripe.
+        cell_locker cl(s, cl_stats, 1);
+
+        auto m1 = make_mutation(s, "0", { "s1", "s2" }, {
+                make_row("one", { "r1", "r2" }),
+        });
+        auto m2 = make_mutation(s, "1", { }, {
+                make_row("two", { "r3" }),
+        });
+
+        auto l1 = cl.lock_cells(m1.decorated_key(), partition_cells_range(m1.partition()), no_timeout).get0();
+        BOOST_REQUIRE_EQUAL(cl_stats.lock_acquisitions, 4);
+
+        auto f2 = cl.lock_cells(m2.decorated_key(), partition_cells_range(m2.partition()), no_timeout);
+        BOOST_REQUIRE(!f2.available());
+        destroy(std::move(l1));
+        destroy(f2.get0());
+        BOOST_REQUIRE_EQUAL(cl_stats.lock_acquisitions, 5);
+        BOOST_REQUIRE_EQUAL(cl_stats.operations_waiting_for_lock, 0);
+    });
+}
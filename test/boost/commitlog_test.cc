@@ -9,6 +9,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include <stdlib.h>
 #include <iostream>
@@ -148,6 +149,42 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_periodic){
         });
 }
 
+// check that concurrent writes in batch mode with group commit are all
+// written and synced before they complete
+SEASTAR_TEST_CASE(test_commitlog_group_commit){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::BATCH;
+    cfg.max_group_commit_window = std::chrono::milliseconds(1);
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        auto uuid = utils::UUID_gen::get_time_UUID();
+        constexpr size_t rounds = 5;
+        constexpr size_t writes = 100;
+        // Later rounds wait for the group commit window, once the latency
+        // of syncs is known.
+        for (size_t round = 0; round < rounds; ++round) {
+            co_await parallel_for_each(boost::irange<size_t>(0, writes), [&log, uuid] (size_t) {
+                sstring tmp = "hej bubba cow";
+                return log.add_mutation(uuid, tmp.size(), db::commitlog::force_sync::no, [tmp](db::commitlog::output& dst) {
+                    dst.write(tmp.data(), tmp.size());
+                }).then([] (rp_handle h) {
+                    BOOST_CHECK_NE(h.rp(), db::replay_position());
+                });
+            });
+        }
+        BOOST_REQUIRE_GT(log.get_flush_count(), 0);
+        BOOST_REQUIRE_LE(log.get_flush_count(), rounds * writes);
+
+        size_t count = 0;
+        for (auto& name : log.get_active_segment_names()) {
+            co_await db::commitlog::read_log_file(name, db::commitlog::descriptor::FILENAME_PREFIX, service::get_local_commitlog_priority(), [&count] (db::commitlog::buffer_and_replay_position buf_rp) {
+                ++count;
+                return make_ready_future<>();
+            });
+        }
+        BOOST_REQUIRE_EQUAL(count, rounds * writes);
+    });
+}
+
 SEASTAR_TEST_CASE(test_commitlog_new_segment){
     commitlog::config cfg;
     cfg.commitlog_segment_size_in_mb = 1;
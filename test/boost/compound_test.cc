@@ -387,3 +387,35 @@ SEASTAR_THREAD_TEST_CASE(test_prefix_compound_validity) {
     BOOST_REQUIRE_THROW(validate({'\x00', '\x01', 0, '\x00', '\x02', 'a', 'b', '\x00', '\x01', 'a'}), marshal_exception); // to many components
     BOOST_REQUIRE_THROW(validate({'\x00', '\x02', 'a', 'b', '\x00', '\x01', 0}), marshal_exception); // wrong order of components
 }
+
+SEASTAR_THREAD_TEST_CASE(test_component_comparator_matches_type_compare) {
+    const std::vector<std::pair<data_type, size_t>> types_and_sizes = {
+        {byte_type, 1},
+        {short_type, 2},
+        {int32_type, 4},
+        {long_type, 8},
+        {timestamp_type, 8},
+        {time_type, 8},
+        {simple_date_type, 4},
+        {timeuuid_type, 16},
+        {utf8_type, 3},
+        {bytes_type, 3},
+        {double_type, 8},
+        {reversed_type_impl::get_instance(int32_type), 4},
+        {reversed_type_impl::get_instance(timeuuid_type), 16},
+    };
+
+    for (auto&& [type, size] : types_and_sizes) {
+        const auto c = compound_component_comparator(type);
+        std::vector<bytes> values = {bytes()};
+        for (int i = 0; i < 32; ++i) {
+            values.push_back(tests::random::get_bytes(size));
+        }
+        for (auto&& v1 : values) {
+            for (auto&& v2 : values) {
+                BOOST_REQUIRE(c.compare(bytes_view(v1), bytes_view(v2)) == type->compare(v1, v2));
+                BOOST_REQUIRE(c.compare(managed_bytes_view(bytes_view(v1)), managed_bytes_view(bytes_view(v2))) == type->compare(v1, v2));
+            }
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "sstables/compress.hh"
+#include "utils/class_registrator.hh"
 
 BOOST_AUTO_TEST_CASE(segmented_offsets_basic_functionality) {
     sstables::compression::segmented_offsets offsets;
@@ -143,3 +144,46 @@ BOOST_AUTO_TEST_CASE(segmented_offsets_corner_cases) {
     BOOST_REQUIRE(accessor.at(4079) == 4079);
     BOOST_REQUIRE(accessor.at(4080) == 4080);
 }
+
+BOOST_AUTO_TEST_CASE(zstd_dictionary_round_trip) {
+    const std::map<sstring, sstring> options = {
+        {compression_parameters::SSTABLE_COMPRESSION, "org.apache.cassandra.io.compress.ZstdCompressor"},
+        {"dictionary_size_in_kb", "4"},
+    };
+    auto c = compressor::create(options);
+    BOOST_REQUIRE_EQUAL(c->dictionary_size(), 4 * 1024);
+
+    std::vector<bytes> blobs;
+    for (int i = 0; i < 2000; ++i) {
+        auto s = format("{{\"id\": {}, \"name\": \"user-{}\", \"active\": {}, \"tags\": [\"alpha\", \"beta\"]}}", i, i * 7, i % 2 ? "true" : "false");
+        blobs.emplace_back(s.begin(), s.end());
+    }
+    std::vector<bytes_view> samples(blobs.begin(), blobs.end());
+    auto dict = c->train_dictionary(samples);
+    BOOST_REQUIRE(dict);
+    BOOST_REQUIRE_LE(dict->size(), c->dictionary_size());
+
+    auto dc = c->with_dictionary(*dict);
+    // A reader creates its own compressor from the options and the stored dictionary.
+    auto dd = compressor::create(options)->with_dictionary(*dict);
+
+    for (auto& blob : blobs) {
+        auto input = reinterpret_cast<const char*>(blob.data());
+        std::vector<char> compressed(dc->compress_max_size(blob.size()));
+        auto clen = dc->compress(input, blob.size(), compressed.data(), compressed.size());
+        BOOST_REQUIRE_LT(clen, c->compress_max_size(blob.size()));
+
+        std::vector<char> uncompressed(blob.size());
+        auto ulen = dd->uncompress(compressed.data(), clen, uncompressed.data(), uncompressed.size());
+        BOOST_REQUIRE_EQUAL(ulen, blob.size());
+        BOOST_REQUIRE(std::equal(uncompressed.begin(), uncompressed.end(), input));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(zstd_dictionary_disabled_by_default) {
+    auto c = compressor::create({{compression_parameters::SSTABLE_COMPRESSION, "org.apache.cassandra.io.compress.ZstdCompressor"}});
+    BOOST_REQUIRE_EQUAL(c->dictionary_size(), 0);
+    auto sample = to_bytes_view("abc");
+    BOOST_REQUIRE(!c->train_dictionary({sample}));
+    BOOST_REQUIRE(!compressor::lz4->dictionary_size());
+}
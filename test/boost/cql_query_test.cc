@@ -44,6 +44,7 @@
 #include "db/query_context.hh"
 #include "service/qos/qos_common.hh"
 #include "utils/UUID_gen.hh"
+#include "replica/counter_shard_cache.hh"
 
 using namespace std::literals::chrono_literals;
 
@@ -4784,6 +4785,36 @@ SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     });
 }
 
+SEASTAR_TEST_CASE(test_counter_shard_cache) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int, ck int, c counter, PRIMARY KEY (pk, ck))");
+
+        auto hits = [&e] {
+            return e.db().map_reduce0([] (const replica::database& db) {
+                return db.get_counter_shard_cache().get_stats().hits;
+            }, uint64_t(0), std::plus<uint64_t>()).get0();
+        };
+        auto update_and_check = [&e] (int64_t expected) {
+            cquery_nofail(e, "UPDATE t SET c = c + 1 WHERE pk = 0 AND ck = 0");
+            require_rows(e, "SELECT c FROM t WHERE pk = 0 AND ck = 0", {{long_type->decompose(expected)}});
+        };
+
+        auto hits_before = hits();
+        for (int64_t i = 1; i <= 10; ++i) {
+            update_and_check(i);
+        }
+        // All but the first update find the counter in the cache.
+        BOOST_REQUIRE_EQUAL(hits() - hits_before, 9);
+
+        // Deleted and truncated counters are read again rather than taken from the cache.
+        cquery_nofail(e, "DELETE c FROM t WHERE pk = 0 AND ck = 0");
+        update_and_check(1);
+        update_and_check(2);
+        cquery_nofail(e, "TRUNCATE t");
+        update_and_check(1);
+    });
+}
+
 SEASTAR_THREAD_TEST_CASE(test_invalid_using_timestamps) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         auto now_nano = std::chrono::duration_cast<std::chrono::nanoseconds>(db_clock::now().time_since_epoch()).count();
@@ -5017,3 +5048,117 @@ SEASTAR_TEST_CASE(test_parallelized_select_count) {
         BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
     });
 }
+
+SEASTAR_TEST_CASE(test_parallelized_select_native_aggregates) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+        auto stat_parallelized = qp.get_cql_stats().select_parallelized;
+
+        e.execute_cql("CREATE TABLE tbl (k int, v int, d double, t text, PRIMARY KEY (k));").get();
+        auto msg = e.execute_cql("SELECT min(v), max(t), sum(v), avg(d), count(v) FROM tbl;").get();
+        assert_that(msg).is_rows().with_rows({
+            {{}, {}, int32_type->decompose(int32_t(0)), double_type->decompose(0.0), long_type->decompose(int64_t(0))}
+        });
+
+        for (int i = 0; i < 10; i++) {
+            e.execute_cql(format("INSERT INTO tbl (k, v, d, t) VALUES ({:d}, {:d}, {:d}.5, 't{:d}');", i, i, i, i)).get();
+        }
+        // Nulls are not aggregated.
+        e.execute_cql("INSERT INTO tbl (k) VALUES (10);").get();
+
+        msg = e.execute_cql("SELECT count(*), count(v), sum(v), avg(v), min(v), max(v) FROM tbl;").get();
+        assert_that(msg).is_rows().with_rows({{
+            long_type->decompose(int64_t(11)),
+            long_type->decompose(int64_t(10)),
+            int32_type->decompose(int32_t(45)),
+            int32_type->decompose(int32_t(4)),
+            int32_type->decompose(int32_t(0)),
+            int32_type->decompose(int32_t(9)),
+        }});
+        msg = e.execute_cql("SELECT sum(d), avg(d), min(t), max(t) FROM tbl;").get();
+        assert_that(msg).is_rows().with_rows({{
+            double_type->decompose(50.0),
+            double_type->decompose(5.0),
+            utf8_type->decompose("t0"),
+            utf8_type->decompose("t9"),
+        }});
+
+        BOOST_CHECK_EQUAL(stat_parallelized + 3, qp.get_cql_stats().select_parallelized);
+
+        // Integers are summed up without overflowing the type of the column
+        // in partial results.
+        e.execute_cql("CREATE TABLE big (k int, v int, PRIMARY KEY (k));").get();
+        for (int i = 0; i < 4; i++) {
+            e.execute_cql(format("INSERT INTO big (k, v) VALUES ({:d}, 2000000000);", i)).get();
+        }
+        msg = e.execute_cql("SELECT avg(v) FROM big;").get();
+        assert_that(msg).is_rows().with_rows({{int32_type->decompose(int32_t(2000000000))}});
+        BOOST_REQUIRE_THROW(e.execute_cql("SELECT sum(v) FROM big;").get(), exceptions::overflow_error_exception);
+        e.execute_cql("INSERT INTO big (k, v) VALUES (4, -2000000000);").get();
+        e.execute_cql("INSERT INTO big (k, v) VALUES (5, -2000000000);").get();
+        e.execute_cql("INSERT INTO big (k, v) VALUES (6, -2000000000);").get();
+        msg = e.execute_cql("SELECT sum(v) FROM big;").get();
+        assert_that(msg).is_rows().with_rows({{int32_type->decompose(int32_t(2000000000))}});
+
+        BOOST_CHECK_EQUAL(stat_parallelized + 6, qp.get_cql_stats().select_parallelized);
+    });
+}
+
+SEASTAR_TEST_CASE(test_coordinator_result_cache) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("CREATE TABLE tbl (p int, c int, v int, PRIMARY KEY (p, c)) "
+                "WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL', 'result_cache_ttl_in_ms': '3600000'};").get();
+        auto s = e.local_db().find_schema("ks", "tbl");
+        auto& stats = e.local_db().find_column_family(s).get_stats();
+
+        // Only the shard owning a partition caches its results.
+        auto local_keys = boost::copy_range<std::vector<int32_t>>(boost::irange(0, 1000)
+                | boost::adaptors::filtered([&] (int32_t p) {
+                    auto dk = dht::decorate_key(*s, partition_key::from_singular(*s, p));
+                    return dht::shard_of(*s, dk.token()) == this_shard_id();
+                }));
+        BOOST_REQUIRE_GE(local_keys.size(), 2);
+        auto p1 = local_keys[0];
+        auto p2 = local_keys[1];
+
+        e.execute_cql(format("INSERT INTO tbl (p, c, v) VALUES ({:d}, 1, 1);", p1)).get();
+        auto id = e.prepare("SELECT v FROM tbl WHERE p = ?;").get0();
+        auto select = [&] (int32_t p, db::consistency_level cl = db::consistency_level::ONE) {
+            return e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(p))}, cl).get0();
+        };
+
+        assert_that(select(p1)).is_rows().with_rows({{int32_type->decompose(1)}});
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 0);
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_misses, 1);
+        assert_that(select(p1)).is_rows().with_rows({{int32_type->decompose(1)}});
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 1);
+
+        // Other bound values and consistency levels are cached separately.
+        assert_that(select(p2)).is_rows().is_empty();
+        assert_that(select(p1, db::consistency_level::ALL)).is_rows().with_rows({{int32_type->decompose(1)}});
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 1);
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_misses, 3);
+
+        // Writes coordinated by this node drop the cached results of their partitions.
+        e.execute_cql(format("UPDATE tbl SET v = 2 WHERE p = {:d} AND c = 1;", p1)).get();
+        assert_that(select(p1)).is_rows().with_rows({{int32_type->decompose(2)}});
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_misses, 4);
+        assert_that(select(p2)).is_rows().is_empty();
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 2);
+
+        e.execute_cql(format("BEGIN BATCH INSERT INTO tbl (p, c, v) VALUES ({:d}, 2, 3); APPLY BATCH;", p2)).get();
+        assert_that(select(p2)).is_rows().with_rows({{int32_type->decompose(3)}});
+        e.execute_cql(format("UPDATE tbl SET v = 4 WHERE p = {:d} AND c = 2 IF v = 3;", p2)).get();
+        assert_that(select(p2)).is_rows().with_rows({{int32_type->decompose(4)}});
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 2);
+
+        // Tables which don't set a TTL aren't cached.
+        e.execute_cql("ALTER TABLE tbl WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL'};").get();
+        id = e.prepare("SELECT v FROM tbl WHERE p = ?;").get0();
+        for (int i = 0; i < 2; i++) {
+            assert_that(select(p1)).is_rows().with_rows({{int32_type->decompose(2)}});
+        }
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_hits, 2);
+        BOOST_REQUIRE_EQUAL(stats.coordinator_result_cache_misses, 6);
+    });
+}
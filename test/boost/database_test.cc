@@ -10,6 +10,7 @@
 #include <seastar/core/seastar.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/util/file.hh>
 
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
@@ -35,6 +36,7 @@
 #include "multishard_mutation_query.hh"
 #include "transport/messages/result_message.hh"
 #include "db/snapshot-ctl.hh"
+#include "utils/rjson.hh"
 
 using namespace std::chrono_literals;
 
@@ -440,6 +442,45 @@ SEASTAR_TEST_CASE(snapshot_works) {
     });
 }
 
+static std::set<sstring> read_manifest_files(const replica::column_family& cf, sstring snapshot_name, const char* key) {
+    auto path = fs::path(cf.dir()) / sstables::snapshots_dir / snapshot_name.c_str() / "manifest.json";
+    auto data = util::read_entire_file_contiguous(path).get0();
+    auto manifest = rjson::parse(std::string_view(data.get(), data.size()));
+    std::set<sstring> files;
+    auto* v = rjson::find(manifest, key);
+    BOOST_REQUIRE(v);
+    for (const rjson::value& f : v->GetArray()) {
+        files.emplace(rjson::to_string_view(f));
+    }
+    return files;
+}
+
+SEASTAR_TEST_CASE(snapshot_with_base_lists_new_files) {
+    return do_with_some_data({"cf"}, [] (cql_test_env& e) {
+        take_snapshot(e, "ks", "cf", "base").get();
+        e.execute_cql("insert into cf (p1, c1, c2, r1) values ('key3', 7, 8, 9);").get();
+        e.db().invoke_on_all([] (replica::database& db) {
+            auto& cf = db.find_column_family("ks", "cf");
+            return cf.snapshot(db, "incremental", false, "base");
+        }).get();
+
+        auto& cf = e.local_db().find_column_family("ks", "cf");
+        auto base_files = read_manifest_files(cf, "base", "files");
+        auto files = read_manifest_files(cf, "incremental", "files");
+        auto new_files = read_manifest_files(cf, "incremental", "new_files");
+
+        // The flush before the second snapshot wrote new sstables
+        BOOST_REQUIRE(!new_files.empty());
+        for (auto& f : files) {
+            BOOST_REQUIRE_EQUAL(new_files.contains(f), !base_files.contains(f));
+        }
+        for (auto& f : new_files) {
+            BOOST_REQUIRE(files.contains(f));
+        }
+        return make_ready_future<>();
+    });
+}
+
 SEASTAR_TEST_CASE(snapshot_skip_flush_works) {
     return do_with_some_data({"cf"}, [] (cql_test_env& e) {
         take_snapshot(e, true /* skip_flush */).get();
@@ -926,6 +967,32 @@ SEASTAR_TEST_CASE(upgrade_sstables) {
     });
 }
 
+SEASTAR_TEST_CASE(tombstone_gc_compaction) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int primary key, v int) with gc_grace_seconds = 0").get();
+        for (int i = 0; i < 10; ++i) {
+            e.execute_cql(format("delete from ks.cf where pk = {}", i)).get();
+        }
+        e.db().invoke_on_all([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").flush();
+        }).get();
+        // Make sure the deletion times are before gc_before.
+        forward_jump_clocks(std::chrono::seconds(10));
+
+        e.db().invoke_on_all([] (replica::database& db) -> future<> {
+            auto& cf = db.find_column_family("ks", "cf");
+            auto& cm = db.get_compaction_manager();
+            for (auto& est : cm.estimate_droppable_tombstones(cf, 0.5)) {
+                BOOST_REQUIRE(est.selected);
+                BOOST_REQUIRE_GT(est.droppable_bytes, 0);
+            }
+            co_await cm.perform_tombstone_gc_compaction(&cf, 0.5);
+            // The sstables held nothing but droppable tombstones.
+            BOOST_REQUIRE(cm.estimate_droppable_tombstones(cf, 0.5).empty());
+        }).get();
+    });
+}
+
 SEASTAR_TEST_CASE(populate_from_quarantine_works) {
     auto tmpdir_for_data = make_lw_shared<tmpdir>();
     utils::UUID host_id;
@@ -3,6 +3,9 @@
 #include <boost/test/unit_test.hpp>
 #include <utility>
 #include "cql3/expr/expression.hh"
+#include "cql3/column_specification.hh"
+#include "cql3/query_options.hh"
+#include "types.hh"
 #include "utils/overloaded_functor.hh"
 #include <cassert>
 
@@ -84,4 +87,30 @@ BOOST_AUTO_TEST_CASE(expr_visit_visitor_rvalue) {
     bind_variable& ref2 = visit(std::move(visitor), e);
 
     BOOST_REQUIRE_EQUAL(ref2.bind_index, 456);
-}
\ No newline at end of file
+}
+BOOST_AUTO_TEST_CASE(expr_fold_constants) {
+    column_definition cdef(to_bytes("v"), int32_type, column_kind::regular_column);
+    auto receiver = make_lw_shared<cql3::column_specification>("ks", "cf", ::make_shared<cql3::column_identifier>("v", true), int32_type);
+    auto bind_var = bind_variable{
+        .shape = bind_variable::shape_type::scalar,
+        .bind_index = 0,
+        .receiver = receiver
+    };
+    cql3::query_options options({cql3::raw_value::make_value(int32_type->decompose(7))});
+
+    // The bind variable on the right-hand side is replaced by its value.
+    auto folded = fold_constants(binary_operator(column_value(&cdef), oper_t::LT, bind_var), options);
+    auto& binop = as<binary_operator>(folded);
+    BOOST_REQUIRE(is<column_value>(binop.lhs));
+    BOOST_REQUIRE_EQUAL(binop.op, oper_t::LT);
+    BOOST_REQUIRE(to_bytes_opt(as<constant>(binop.rhs).view()) == bytes_opt(int32_type->decompose(7)));
+
+    // Folding goes through conjunctions, and leaves what depends on the row alone.
+    auto conj = fold_constants(make_conjunction(
+            binary_operator(column_value(&cdef), oper_t::EQ, bind_var),
+            binary_operator(column_value(&cdef), oper_t::EQ, column_value(&cdef))), options);
+    auto& children = as<conjunction>(conj).children;
+    BOOST_REQUIRE_EQUAL(children.size(), 2);
+    BOOST_REQUIRE(is<constant>(as<binary_operator>(children[0]).rhs));
+    BOOST_REQUIRE(is<column_value>(as<binary_operator>(children[1]).rhs));
+}
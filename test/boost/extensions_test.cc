@@ -11,6 +11,7 @@
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/sleep.hh>
+#include <boost/range/irange.hpp>
 
 #include <seastar/testing/test_case.hh>
 #include "test/lib/cql_test_env.hh"
@@ -23,6 +24,8 @@
 #include "sstables/sstables.hh"
 #include "cdc/cdc_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/write_coalescing_extension.hh"
+#include "replica/database.hh"
 #include "transport/messages/result_message.hh"
 #include "utils/overloaded_functor.hh"
 
@@ -162,6 +165,41 @@ SEASTAR_TEST_CASE(paxos_grace_seconds_extension) {
     }, cfg);
 }
 
+SEASTAR_TEST_CASE(write_coalescing_extension) {
+    auto ext = std::make_shared<db::extensions>();
+    ext->add_schema_extension<db::write_coalescing_extension>(db::write_coalescing_extension::NAME);
+    auto cfg = ::make_shared<db::config>(ext);
+
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        BOOST_REQUIRE_THROW(e.execute_cql("CREATE TABLE cf (pk int, ck int, PRIMARY KEY (pk, ck)) WITH write_coalescing_window_in_us=20000").get(),
+                exceptions::configuration_exception);
+
+        e.execute_cql("CREATE TABLE cf (pk int, ck int, v int, PRIMARY KEY (pk, ck)) WITH write_coalescing_window_in_us=10000").get();
+        BOOST_REQUIRE_EQUAL(e.local_db().find_schema("ks", "cf")->write_coalescing_window(), std::chrono::microseconds(10000));
+
+        // Concurrent writes to the same partition are merged, and each of
+        // them is applied.
+        parallel_for_each(boost::irange(0, 10), [&e] (int ck) {
+            return e.execute_cql(format("INSERT INTO cf (pk, ck, v) VALUES (0, {}, {})", ck, ck)).discard_result();
+        }).get();
+        parallel_for_each(boost::irange(0, 10), [&e] (int ck) {
+            return e.execute_cql(format("UPDATE cf SET v = {} WHERE pk = 0 AND ck = {}", ck + 1, ck)).discard_result();
+        }).get();
+
+        auto coalesced = e.db().map_reduce0([] (replica::database& db) {
+            return db.find_column_family("ks", "cf").get_stats().coalesced_writes;
+        }, int64_t(0), std::plus<int64_t>()).get0();
+        BOOST_REQUIRE_GT(coalesced, 0);
+
+        auto msg = e.execute_cql("SELECT ck, v FROM cf WHERE pk = 0").get0();
+        std::vector<std::vector<bytes_opt>> rows;
+        for (auto ck : boost::irange(0, 10)) {
+            rows.push_back({int32_type->decompose(ck), int32_type->decompose(ck + 1)});
+        }
+        assert_that(msg).is_rows().with_rows(rows);
+    }, cfg);
+}
+
 SEASTAR_TEST_CASE(test_extension_remove) {
     auto ext = std::make_shared<db::extensions>();
     ext->add_schema_extension("knas", [](db::extensions::schema_ext_config args) {
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+
+#include "sstables/hyperloglog.hh"
+
+namespace {
+
+hll::HyperLogLog make_estimator(uint8_t b, uint64_t first, uint64_t count) {
+    hll::HyperLogLog e(b);
+    for (uint64_t i = 0; i < count; ++i) {
+        // Distinct seeds give distinct keys, equal seeds equal ones.
+        e.offer_hashed(std::mt19937_64(first + i)());
+    }
+    return e;
+}
+
+void require_close(double estimate, double expected, double tolerance) {
+    BOOST_TEST_MESSAGE("estimate " << estimate << " expected " << expected);
+    BOOST_REQUIRE_LT(std::abs(estimate - expected), expected * tolerance);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(test_bytes_round_trip) {
+    auto e = make_estimator(10, 0, 50000);
+    auto copy = hll::HyperLogLog::from_bytes(e.get_bytes());
+    BOOST_REQUIRE_EQUAL(int(copy.bitWidth()), 10);
+    BOOST_REQUIRE_EQUAL(copy.estimate(), e.estimate());
+    require_close(copy.estimate(), 50000, 0.1);
+
+    auto bytes = e.get_bytes();
+    bytes.trim(bytes.size() - 1);
+    BOOST_REQUIRE_THROW(hll::HyperLogLog::from_bytes(std::move(bytes)), std::invalid_argument);
+
+    // Sparse estimators, which Cassandra writes, are not supported.
+    bytes = e.get_bytes();
+    bytes.get_write()[6] = 0x1;
+    BOOST_REQUIRE_THROW(hll::HyperLogLog::from_bytes(std::move(bytes)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_merge_counts_overlap_once) {
+    auto a = make_estimator(10, 0, 60000);
+    auto b = make_estimator(10, 20000, 60000);
+    a.merge(b);
+    require_close(a.estimate(), 80000, 0.1);
+}
+
+BOOST_AUTO_TEST_CASE(test_fold) {
+    auto wide = make_estimator(10, 0, 60000);
+    auto narrow = make_estimator(6, 20000, 60000);
+    auto folded = wide.fold(6);
+    BOOST_REQUIRE_EQUAL(int(folded.bitWidth()), 6);
+    BOOST_REQUIRE(folded.get_bytes() == make_estimator(6, 0, 60000).get_bytes());
+    require_close(folded.estimate(), 60000, 0.3);
+    folded.merge(narrow);
+    require_close(folded.estimate(), 80000, 0.3);
+
+    BOOST_REQUIRE_THROW(narrow.fold(10), std::invalid_argument);
+}
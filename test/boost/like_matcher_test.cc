@@ -443,3 +443,31 @@ BOOST_AUTO_TEST_CASE(test_reset) {
     BOOST_TEST(matches(m, u8"alpha"));
     BOOST_TEST(!matches(m, u8"omega"));
 }
+
+BOOST_AUTO_TEST_CASE(test_literal_with_percents) {
+    auto any = matcher(u8"%%");
+    BOOST_TEST(matches(any, u8""));
+    BOOST_TEST(matches(any, u8"abc"));
+
+    auto contains = matcher(u8"%error%");
+    BOOST_TEST(matches(contains, u8"error"));
+    BOOST_TEST(matches(contains, u8"an error occurred"));
+    BOOST_TEST(matches(contains, u8"ШШШerror"));
+    BOOST_TEST(!matches(contains, u8"erro"));
+    BOOST_TEST(!matches(contains, u8"an err or"));
+
+    auto escaped = matcher(u8R"(%\_\%%%)");
+    BOOST_TEST(matches(escaped, u8"_%"));
+    BOOST_TEST(matches(escaped, u8"a_%b"));
+    BOOST_TEST(!matches(escaped, u8"a%_b"));
+
+    auto prefix = matcher(u8"Шabc%%");
+    BOOST_TEST(matches(prefix, u8"Шabc"));
+    BOOST_TEST(matches(prefix, u8"Шabcd"));
+    BOOST_TEST(!matches(prefix, u8"abcd"));
+
+    auto not_literal = matcher(u8"a%b%");
+    BOOST_TEST(matches(not_literal, u8"ab"));
+    BOOST_TEST(matches(not_literal, u8"axxbxx"));
+    BOOST_TEST(!matches(not_literal, u8"axx"));
+}
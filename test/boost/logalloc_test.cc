@@ -95,6 +95,49 @@ SEASTAR_TEST_CASE(test_compaction) {
     });
 }
 
+SEASTAR_TEST_CASE(test_region_stats) {
+    return seastar::async([] {
+        region reg;
+        reg.set_owner("test");
+
+        auto find_stats = [] {
+            for (auto& st : shard_tracker().get_region_stats()) {
+                if (st.owner == "test") {
+                    return st;
+                }
+            }
+            BOOST_FAIL("region not found");
+            return region_stats{};
+        };
+
+        with_allocator(reg.allocator(), [&] {
+            std::vector<managed_ref<int>> allocated;
+            for (int i = 0; i < 32 * 1024 * 8; i++) {
+                allocated.push_back(make_managed<int>());
+            }
+
+            auto st = find_stats();
+            BOOST_REQUIRE(!st.evictable);
+            BOOST_REQUIRE_EQUAL(st.occupancy.used_space(), reg.occupancy().used_space());
+            BOOST_REQUIRE_EQUAL(st.segments_compacted, 0);
+            // Closed segments are full.
+            BOOST_REQUIRE_GT(st.occupancy_histogram.back(), 0);
+
+            // Free every other object, which leaves the segments half full.
+            for (size_t i = 0; i < allocated.size(); i += 2) {
+                allocated[i] = {};
+            }
+            st = find_stats();
+            BOOST_REQUIRE_EQUAL(st.occupancy_histogram.back(), 0);
+
+            reg.full_compaction();
+            st = find_stats();
+            BOOST_REQUIRE_GT(st.segments_compacted, 0);
+            BOOST_REQUIRE_GT(st.memory_compacted, 0);
+        });
+    });
+}
+
 SEASTAR_TEST_CASE(test_occupancy) {
     return seastar::async([] {
         region reg;
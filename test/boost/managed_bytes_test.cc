@@ -44,6 +44,7 @@ struct fragmenting_allocation_strategy : standard_allocation_strategy {
 constexpr size_t alloc_size = 63;
 const std::vector<size_t> sizes = {
     0, 1, 15, 16,
+    managed_bytes::max_inline_size, managed_bytes::max_inline_size + 1,
     alloc_size - 1, alloc_size, alloc_size + 1,
     alloc_size * 4 - 1, alloc_size * 4, alloc_size * 4 + 1,
 };
@@ -181,6 +182,18 @@ BOOST_AUTO_TEST_CASE(test_external_memory_usage) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_inline_values_do_not_allocate) {
+    for (size_t size : sizes) {
+        fragmenting_allocation_strategy fragmenting_allocator(alloc_size);
+        with_allocator(fragmenting_allocator, [&] {
+            auto b = tests::random::get_bytes(size);
+            auto m = managed_bytes(b);
+            BOOST_CHECK_EQUAL(fragmenting_allocator.allocations.empty(), size <= managed_bytes::max_inline_size);
+            BOOST_CHECK_EQUAL(to_bytes(m), b);
+        });
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_with_linearized) {
     fragmenting_allocation_strategy fragmenting_allocator(alloc_size);
     for (size_t size : sizes) {
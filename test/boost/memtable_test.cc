@@ -194,6 +194,42 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
     });
 }
 
+SEASTAR_TEST_CASE(test_memtable_flush_reader_of_ranges) {
+    return seastar::async([] {
+        schema_ptr s = schema_builder("ks", "cf")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("col", bytes_type, column_kind::regular_column)
+                .build();
+
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+
+        dirty_memory_manager mgr;
+        replica::table_stats tbl_stats;
+
+        auto mt = make_lw_shared<replica::memtable>(s, mgr, tbl_stats);
+
+        std::vector<mutation> ring = make_ring(s, 32);
+        for (auto&& m : ring) {
+            set_column(m, "col");
+            mt->apply(m);
+        }
+
+        // The ranges of a split flush have to cover every partition exactly once.
+        auto ranges = dht::split_ring_uniformly(4);
+        BOOST_REQUIRE_EQUAL(ranges.size(), 4);
+        auto cmp = dht::ring_position_comparator(*s);
+        auto it = ring.begin();
+        for (auto& range : ranges) {
+            auto rd = assert_that(mt->make_flush_reader(s, semaphore.make_permit(), range, default_priority_class()));
+            while (it != ring.end() && range.contains(dht::ring_position(it->decorated_key()), cmp)) {
+                rd.produces(*it++);
+            }
+            rd.produces_end_of_stream();
+        }
+        BOOST_REQUIRE(it == ring.end());
+    });
+}
+
 SEASTAR_TEST_CASE(test_adding_a_column_during_reading_doesnt_affect_read_result) {
     return seastar::async([] {
         auto common_builder = schema_builder("ks", "cf")
@@ -109,3 +109,23 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_batch_hash_output) {
+    // Prefixes of mixed lengths, so that lanes leave the interleaved loop at
+    // different points, and a count which is not a multiple of the lanes.
+    std::vector<bytes_view> keys;
+    for (size_t i = 0; i < full_sequence.size(); ++i) {
+        keys.push_back(bytes_view(full_sequence.begin(), (i * 7) % full_sequence.size()));
+    }
+    std::vector<std::array<uint64_t, 2>> results(keys.size());
+    utils::murmur_hash::hash3_x64_128(keys, seed, results);
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::array<uint64_t, 2> expected;
+        utils::murmur_hash::hash3_x64_128(keys[i], seed, expected);
+        if (results[i] != expected) {
+            BOOST_FAIL(format("Batch hash differs for {} (got {{0x{:x}, 0x{:x}}}, expected {{0x{:x}, 0x{:x}}})", to_hex(keys[i]),
+                results[i][0], results[i][1], expected[0], expected[1]));
+        }
+    }
+}
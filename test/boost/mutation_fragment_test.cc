@@ -14,6 +14,7 @@
 
 #include "test/lib/mutation_source_test.hh"
 #include "mutation_fragment.hh"
+#include "mutation_fragment_v2.hh"
 #include "frozen_mutation.hh"
 #include "test/lib/test_services.hh"
 #include "schema_builder.hh"
@@ -468,3 +469,42 @@ SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_mutate_exception_safety) {
         BOOST_REQUIRE(available_res == sem.available_resources());
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_mutation_fragment_v2_storage_is_recycled_by_permit) {
+    simple_schema s;
+
+    reader_concurrency_semaphore sem(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 1024 * 1024);
+    auto stop_sem = deferred_stop(sem);
+    const auto initial_res = sem.available_resources();
+
+    {
+        auto permit = sem.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout);
+
+        const void* storage;
+        {
+            auto mf = mutation_fragment_v2(*s.schema(), permit, partition_end());
+            storage = &mf.as_end_of_partition();
+        }
+        // The storage is kept by the permit, and its memory is consumed from it.
+        const auto block_res = permit.consumed_resources();
+        BOOST_REQUIRE_GT(block_res.memory, 0);
+
+        {
+            auto mf = mutation_fragment_v2(*s.schema(), permit, partition_end());
+            BOOST_REQUIRE_EQUAL(static_cast<const void*>(&mf.as_end_of_partition()), storage);
+            BOOST_REQUIRE_EQUAL(permit.consumed_resources().memory, mf.memory_usage());
+        }
+        BOOST_REQUIRE(permit.consumed_resources() == block_res);
+
+        {
+            std::vector<mutation_fragment_v2> mfs;
+            for (size_t i = 0; i < reader_permit::max_free_fragment_blocks + 10; ++i) {
+                mfs.emplace_back(*s.schema(), permit, partition_end());
+            }
+        }
+        BOOST_REQUIRE_EQUAL(permit.consumed_resources().memory, block_res.memory * reader_permit::max_free_fragment_blocks);
+    }
+
+    // Destroying the permit frees the kept storage.
+    BOOST_REQUIRE(sem.available_resources() == initial_res);
+}
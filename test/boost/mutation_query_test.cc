@@ -485,6 +485,33 @@ SEASTAR_TEST_CASE(test_result_row_count) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_count_only_result) {
+    auto s = make_schema();
+
+    mutation m(s, partition_key::from_single_value(*s, "key1"));
+    for (auto ck : {"A", "B", "C", "D"}) {
+        m.set_clustered_cell(clustering_key::from_single_value(*s, bytes(ck)), "v1", data_value(bytes(ck)), 1);
+    }
+
+    auto slice = make_full_slice(*s);
+    auto count_slice = make_full_slice(*s);
+    count_slice.options.set<query::partition_slice::option::count_only>();
+    const auto opts = query::result_options{query::result_request::result_and_digest, query::digest_algorithm::xxHash};
+
+    auto r = query_mutation(mutation(m), slice, query::max_rows, gc_clock::now(), opts);
+    auto count_r = query_mutation(mutation(m), count_slice, query::max_rows, gc_clock::now(), opts);
+
+    // All rows are counted, but only the last one is sent.
+    BOOST_REQUIRE_EQUAL(count_r.row_count().value(), 4);
+    BOOST_REQUIRE(count_r.buf().size() < r.buf().size());
+    BOOST_REQUIRE(count_r.digest() == r.digest());
+    assert_that(query::result_set::from_raw_result(s, count_slice, count_r))
+        .has_size(1)
+        .has(a_row()
+            .with_column("pk", data_value(bytes("key1")))
+            .with_column("ck", data_value(bytes("D"))));
+}
+
 SEASTAR_TEST_CASE(test_partition_limit) {
     return seastar::async([] {
         auto s = make_schema();
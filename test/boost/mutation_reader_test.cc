@@ -949,6 +949,49 @@ SEASTAR_TEST_CASE(reader_selector_overlapping_readers_test) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(combined_reader_lookahead_test) {
+    simple_schema s;
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto pkeys = s.make_pkeys(6);
+
+    std::ranges::sort(pkeys, [&s] (const dht::decorated_key& a, const dht::decorated_key& b) {
+        return a.less_compare(*s.schema(), b);
+    });
+
+    // Every reader has partitions the merge reaches only after reading
+    // others, which are the ones looked ahead.
+    std::vector<mutation> muts_a, muts_b;
+    for (auto& pk : pkeys) {
+        muts_a.push_back(make_mutation_with_key(s, pk));
+        muts_b.push_back(make_mutation_with_key(s, pk));
+        s.add_row(muts_a.back(), s.make_ckey(1), "a");
+        s.add_row(muts_b.back(), s.make_ckey(2), "b");
+    }
+
+    std::vector<std::vector<mutation>> readers_mutations{
+        {muts_a[0], muts_a[2], muts_a[3], muts_a[5]},
+        {muts_b[0], muts_a[1], muts_b[3], muts_b[5]},
+        {muts_b[1], muts_b[2], muts_a[4]},
+        {muts_b[4]},
+    };
+
+    auto permit = semaphore.make_permit();
+    auto reader = make_combined_reader(s.schema(), permit,
+            std::make_unique<dummy_incremental_selector>(s.schema(), permit, std::move(readers_mutations)),
+            streamed_mutation::forwarding::no,
+            mutation_reader::forwarding::yes,
+            combined_reader_lookahead::yes);
+
+    assert_that(std::move(reader))
+        .produces_partition(muts_a[0] + muts_b[0])
+        .produces(pkeys[1])
+        .produces_partition(muts_a[2] + muts_b[2])
+        .fast_forward_to(dht::partition_range::make_starting_with(dht::partition_range::bound(pkeys[4], true)))
+        .produces_partition(muts_a[4] + muts_b[4])
+        .produces_partition(muts_a[5] + muts_b[5])
+        .produces_end_of_stream();
+}
+
 SEASTAR_TEST_CASE(reader_selector_fast_forwarding_test) {
     return seastar::async([] {
         simple_schema s;
@@ -4219,3 +4262,40 @@ SEASTAR_THREAD_TEST_CASE(test_generating_reader_v2) {
     };
     run_mutation_source_tests(populator_v2, false);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_upgrade_schema_column_mappings) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto permit = semaphore.make_permit();
+
+    auto s1 = schema_builder("ks", "cf")
+        .with_column("pk", bytes_type, column_kind::partition_key)
+        .with_column("ck", bytes_type, column_kind::clustering_key)
+        .with_column("s1", bytes_type, column_kind::static_column)
+        .with_column("v1", bytes_type)
+        .with_column("v3", bytes_type)
+        .build();
+
+    mutation m(s1, partition_key::from_single_value(*s1, "pk"));
+    m.set_static_cell("s1", data_value(bytes("s")), 1);
+    m.set_clustered_cell(clustering_key::from_single_value(*s1, "ck"), "v1", data_value(bytes("a")), 1);
+    m.set_clustered_cell(clustering_key::from_single_value(*s1, "ck"), "v3", data_value(bytes("b")), 1);
+
+    auto check = [&] (schema_ptr s) {
+        auto expected = m;
+        expected.upgrade(s);
+        auto rd = make_flat_mutation_reader_from_mutations_v2(s1, permit, {m});
+        rd.upgrade_schema(s);
+        assert_that(std::move(rd))
+            .produces(expected)
+            .produces_end_of_stream();
+    };
+
+    // Keeps the column ids.
+    check(schema_builder(s1).with_column("v4", bytes_type).build());
+    // Shifts the column ids.
+    check(schema_builder(s1).with_column("v0", bytes_type).with_column("s0", bytes_type, column_kind::static_column).build());
+    // Drops a column.
+    check(schema_builder(s1).without_column("v1", 2).build());
+    // Drops a column, then adds it back.
+    check(schema_builder(schema_builder(s1).without_column("v3", 2).build()).with_column("v3", bytes_type).build());
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <set>
+
+#include "sstables/partition_trie.hh"
+
+namespace {
+
+bytes random_key(std::mt19937& rng) {
+    std::uniform_int_distribution<int> len_dist(0, 6);
+    std::uniform_int_distribution<int> byte_dist(0, 3);
+    bytes b(bytes::initialized_later(), len_dist(rng));
+    for (auto& c : b) {
+        // Include bytes with the high bit set to check unsigned ordering.
+        c = int8_t(std::array<uint8_t, 4>{0x00, 0x41, 0x80, 0xff}[byte_dist(rng)]);
+    }
+    return b;
+}
+
+struct bytes_unsigned_less {
+    bool operator()(const bytes& a, const bytes& b) const {
+        return compare_unsigned(a, b) < 0;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(test_byte_comparable_token_order) {
+    std::vector<int64_t> tokens = {std::numeric_limits<int64_t>::min() + 1, -1000, -1, 0, 1, 1000, std::numeric_limits<int64_t>::max()};
+    const bytes key_a = bytes(1, int8_t(1));
+    const bytes key_b = bytes(1, int8_t(2));
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        auto t = dht::token(dht::token_kind::key, tokens[i]);
+        auto a = sstables::byte_comparable_key(t, sstables::key_view(bytes_view(key_a)));
+        auto b = sstables::byte_comparable_key(t, sstables::key_view(bytes_view(key_b)));
+        BOOST_REQUIRE(compare_unsigned(a, b) < 0);
+        if (i + 1 < tokens.size()) {
+            auto next = sstables::byte_comparable_key(dht::token(dht::token_kind::key, tokens[i + 1]), sstables::key_view(bytes_view(key_a)));
+            BOOST_REQUIRE(compare_unsigned(b, next) < 0);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_partition_trie_lookup) {
+    std::mt19937 rng(42);
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        std::set<bytes, bytes_unsigned_less> key_set;
+        auto n = std::uniform_int_distribution<int>(0, 40)(rng);
+        for (int i = 0; i < n; ++i) {
+            key_set.insert(random_key(rng));
+        }
+        std::vector<bytes> keys(key_set.begin(), key_set.end());
+
+        sstables::partition_trie::builder builder;
+        for (auto& k : keys) {
+            builder.add(k);
+        }
+        auto trie = std::move(builder).build();
+        BOOST_REQUIRE_EQUAL(trie.size(), keys.size());
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            BOOST_REQUIRE(trie.floor(keys[i]) == std::optional<sstables::partition_trie::key_index>(i));
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            auto probe = random_key(rng);
+            auto lb = size_t(std::lower_bound(keys.begin(), keys.end(), probe, bytes_unsigned_less{}) - keys.begin());
+            auto f = trie.floor(probe);
+            if (!f) {
+                BOOST_REQUIRE_EQUAL(lb, 0);
+            } else {
+                BOOST_REQUIRE(lb == *f || lb == *f + 1);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_partition_trie_stores_distinguishing_prefixes) {
+    sstables::partition_trie::builder builder;
+    const auto long_suffix = bytes(bytes::initialized_later(), 1000);
+    for (int8_t c : {1, 2, 3}) {
+        bytes k = bytes(1, c) + long_suffix;
+        builder.add(k);
+    }
+    auto trie = std::move(builder).build();
+    BOOST_REQUIRE_EQUAL(trie.size(), 3);
+    BOOST_REQUIRE_EQUAL(trie.stored_bytes(), 3);
+}
@@ -187,6 +187,10 @@ class test_querier_cache {
         return _sem;
     }
 
+    query::querier_cache& get_cache() {
+        return _cache;
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -612,6 +616,27 @@ SEASTAR_THREAD_TEST_CASE(test_memory_based_cache_eviction) {
     BOOST_REQUIRE_EQUAL(t.get_semaphore().get_stats().inactive_reads, pop_before);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_max_memory_usage) {
+    test_querier_cache t;
+
+    const auto entry = t.produce_first_page_and_save_data_querier(1);
+    const auto entry_size = t.get_cache().get_stats().memory_usage;
+    BOOST_REQUIRE_GT(entry_size, 0);
+
+    // Room for the cached querier but not for another one like it.
+    t.get_cache().set_max_memory_usage(entry_size * 3 / 2);
+    t.produce_first_page_and_save_data_querier(2);
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().memory_based_drops, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().population, 1);
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().memory_usage, entry_size);
+
+    t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .no_misses()
+        .no_drops()
+        .no_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache().get_stats().memory_usage, 0);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_resources_based_cache_eviction) {
     auto db_cfg_ptr = make_shared<db::config>();
     auto& db_cfg = *db_cfg_ptr;
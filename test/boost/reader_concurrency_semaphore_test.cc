@@ -103,6 +103,31 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_abandoned_handle_clos
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_evicts_cheapest_inactive_read) {
+    simple_schema s;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
+    auto stop_sem = deferred_stop(semaphore);
+
+    const unsigned ios[] = {5, 0, 2};
+    std::vector<reader_concurrency_semaphore::inactive_read_handle> handles;
+    for (auto io : ios) {
+        auto permit = semaphore.obtain_permit(s.schema().get(), get_name(), reader_concurrency_semaphore::read_cost{1024, io}, db::no_timeout).get0();
+        handles.emplace_back(semaphore.register_inactive_read(make_empty_flat_reader_v2(s.schema(), permit)));
+        BOOST_REQUIRE_EQUAL(semaphore.get_resumption_cost(handles.back()), io * reader_concurrency_semaphore::inactive_read_sstable_cost);
+    }
+    auto permit = semaphore.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout);
+    handles.emplace_back(semaphore.register_inactive_read(make_empty_flat_reader_v2(s.schema(), permit)));
+    // Reads without an estimate count as reading from one sstable.
+    BOOST_REQUIRE_EQUAL(semaphore.get_resumption_cost(handles.back()), reader_concurrency_semaphore::inactive_read_sstable_cost);
+
+    for (auto i : {1, 3, 2, 0}) {
+        BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+        BOOST_REQUIRE(!handles[i]);
+        BOOST_REQUIRE_EQUAL(semaphore.get_resumption_cost(handles[i]), 0);
+    }
+    BOOST_REQUIRE(!semaphore.try_evict_one_inactive_read());
+}
+
 // This unit test passes a read through admission again-and-again, just
 // like an evictable reader would be during its lifetime. When readmitted
 // the read sometimes has to wait and sometimes not. This is to check that
@@ -489,6 +514,61 @@ SEASTAR_TEST_CASE(reader_concurrency_semaphore_timeout) {
     });
 }
 
+SEASTAR_TEST_CASE(reader_concurrency_semaphore_cheap_reads_go_ahead) {
+    return async([&] () {
+        reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, 10 * replica::new_reader_base_cost);
+        auto stop_sem = deferred_stop(semaphore);
+        semaphore.set_cheap_read_io_threshold(2);
+
+        const auto cheap = reader_concurrency_semaphore::read_cost{size_t(replica::new_reader_base_cost), 0};
+        const auto expensive = reader_concurrency_semaphore::read_cost{size_t(replica::new_reader_base_cost), 10};
+        const unsigned cheap_reads = reader_concurrency_semaphore::cheap_reads_per_expensive_read + 1;
+
+        reader_permit_opt permit = semaphore.obtain_permit(nullptr, "permit", expensive, db::no_timeout).get();
+
+        auto expensive_fut = semaphore.obtain_permit(nullptr, "expensive", expensive, db::no_timeout);
+        std::vector<future<reader_permit>> cheap_futs;
+        for (unsigned i = 0; i < cheap_reads; ++i) {
+            cheap_futs.push_back(semaphore.obtain_permit(nullptr, "cheap", cheap, db::no_timeout));
+        }
+        BOOST_REQUIRE_EQUAL(semaphore.waiters(), cheap_reads + 1);
+        BOOST_REQUIRE_EQUAL(semaphore.cheap_waiters(), cheap_reads);
+
+        // Cheap reads are admitted ahead of the expensive one, up to the limit.
+        permit = {};
+        for (unsigned i = 0; i < cheap_reads - 1; ++i) {
+            BOOST_REQUIRE_EQUAL(semaphore.waiters(), cheap_reads - i);
+            BOOST_REQUIRE_EQUAL(semaphore.cheap_waiters(), cheap_reads - i - 1);
+            permit = cheap_futs[i].get();
+            permit = {};
+        }
+
+        // Then the expensive one.
+        BOOST_REQUIRE_EQUAL(semaphore.waiters(), 1);
+        BOOST_REQUIRE_EQUAL(semaphore.cheap_waiters(), 1);
+        permit = expensive_fut.get();
+        permit = {};
+
+        BOOST_REQUIRE_EQUAL(semaphore.waiters(), 0);
+        permit = cheap_futs.back().get();
+        permit = {};
+
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().cheap_reads_enqueued, cheap_reads);
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().cheap_reads_admitted, cheap_reads);
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().reads_admitted, cheap_reads + 2);
+        // All but the first permit waited.
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().admission_wait_time.count(), cheap_reads + 1);
+
+        // Reads without a cost estimate are never cheap.
+        permit = semaphore.obtain_permit(nullptr, "permit", replica::new_reader_base_cost, db::no_timeout).get();
+        auto unknown_fut = semaphore.obtain_permit(nullptr, "unknown", replica::new_reader_base_cost, db::no_timeout);
+        BOOST_REQUIRE_EQUAL(semaphore.cheap_waiters(), 0);
+        permit = {};
+        unknown_fut.get();
+        BOOST_REQUIRE_EQUAL(semaphore.get_stats().cheap_reads_admitted, cheap_reads);
+    });
+}
+
 SEASTAR_TEST_CASE(reader_concurrency_semaphore_max_queue_length) {
     return async([&] () {
         reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost, 2);
@@ -2249,6 +2249,175 @@ static void apply(row_cache& cache, memtable_snapshot_source& underlying, replic
     cache.update(row_cache::external_updater([&] { underlying.apply(std::move(mt1)); }), m).get();
 }
 
+SEASTAR_TEST_CASE(test_scans_do_not_evict_repeatedly_read_partitions) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto cache_mt = make_lw_shared<replica::memtable>(s);
+        std::vector<mutation> partitions = make_ring(s, 10);
+        for (auto&& m : partitions) {
+            cache_mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        // The first read of a partition is probationary, the second one promotes it.
+        auto hot = dht::partition_range::make_singular(partitions[3].decorated_key());
+        populate_range(cache, hot);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().row_promotions, 0);
+        populate_range(cache, hot);
+        BOOST_REQUIRE_GT(tracker.get_stats().row_promotions, 0);
+
+        auto insertions = tracker.get_stats().probationary_row_insertions;
+        populate_range(cache);
+        BOOST_REQUIRE_EQUAL(tracker.partitions(), partitions.size());
+        BOOST_REQUIRE_GT(tracker.get_stats().probationary_row_insertions, insertions);
+
+        while (tracker.partitions() > 1) {
+            evict_one_partition(tracker);
+        }
+        BOOST_REQUIRE_GT(tracker.get_lru().probationary_evictions(), 0);
+
+        auto misses = tracker.get_stats().partition_misses;
+        populate_range(cache, hot);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_misses, misses);
+    });
+}
+
+SEASTAR_TEST_CASE(test_hot_key_sampling) {
+    return seastar::async([] {
+        auto s = make_schema();
+        auto cache_mt = make_lw_shared<replica::memtable>(s);
+        std::vector<mutation> partitions = make_ring(s, 10);
+        for (auto&& m : partitions) {
+            cache_mt->apply(m);
+        }
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+        cache.set_hot_key_sample_size(2);
+
+        auto read = [&] (int i, int times) {
+            for (int n = 0; n < times; ++n) {
+                populate_range(cache, dht::partition_range::make_singular(partitions[i].decorated_key()));
+            }
+        };
+
+        // Scans and first reads are not sampled.
+        populate_range(cache);
+        read(0, 1);
+        BOOST_REQUIRE(cache.take_hot_keys().empty());
+
+        read(1, 2);
+        read(2, 4);
+        auto keys = cache.take_hot_keys();
+        BOOST_REQUIRE_EQUAL(keys.size(), 2);
+        BOOST_REQUIRE(keys[0].key.equal(*s, partitions[2].decorated_key()));
+        BOOST_REQUIRE_EQUAL(keys[0].frequency, 4);
+        BOOST_REQUIRE(keys[1].key.equal(*s, partitions[1].decorated_key()));
+        BOOST_REQUIRE_EQUAL(keys[1].frequency, 2);
+        BOOST_REQUIRE(cache.take_hot_keys().empty());
+
+        cache.set_hot_key_sample_size(0);
+        read(3, 3);
+        BOOST_REQUIRE(cache.take_hot_keys().empty());
+    });
+}
+
+SEASTAR_TEST_CASE(test_reserved_fraction_defers_eviction) {
+    return seastar::async([] {
+        auto big_s = make_schema();
+        auto small_s = schema_builder("ks", "small")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("v", bytes_type, column_kind::regular_column)
+            .set_caching_options(caching_options::from_map({{"min_fraction", "0.5"}}))
+            .build();
+
+        auto make_source = [] (schema_ptr s, const std::vector<mutation>& partitions) {
+            auto mt = make_lw_shared<replica::memtable>(s);
+            for (auto&& m : partitions) {
+                mt->apply(m);
+            }
+            return snapshot_source_from_snapshot(mt->as_data_source());
+        };
+        std::vector<mutation> big_partitions = make_ring(big_s, 10);
+        std::vector<mutation> small_partitions = make_ring(small_s, 2);
+
+        cache_tracker tracker;
+        row_cache big(big_s, make_source(big_s, big_partitions), tracker);
+        row_cache small(small_s, make_source(small_s, small_partitions), tracker);
+
+        // The partitions of the small table are read once, so they are in
+        // the probationary segment, and those of the big one twice.
+        for (auto&& m : small_partitions) {
+            populate_range(small, dht::partition_range::make_singular(m.decorated_key()));
+        }
+        for (auto&& m : big_partitions) {
+            populate_range(big, dht::partition_range::make_singular(m.decorated_key()));
+            populate_range(big, dht::partition_range::make_singular(m.decorated_key()));
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_table_stats(small_s->id())->partitions, 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_table_stats(big_s->id())->partitions, 10);
+
+        // The small table holds less than half of the cache until there are 4 partitions left.
+        while (tracker.partitions() > 4) {
+            evict_one_partition(tracker);
+        }
+        BOOST_REQUIRE_EQUAL(tracker.get_table_stats(small_s->id())->partitions, 2);
+        BOOST_REQUIRE_EQUAL(tracker.get_table_stats(small_s->id())->partition_evictions, 0);
+        BOOST_REQUIRE_EQUAL(tracker.get_table_stats(big_s->id())->partition_evictions, 8);
+        BOOST_REQUIRE_GT(tracker.get_stats().reserved_row_deferrals, 0);
+    });
+}
+
+SEASTAR_TEST_CASE(test_mvcc_stats) {
+    return seastar::async([] {
+        simple_schema table;
+        schema_ptr s = table.schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        memtable_snapshot_source underlying(s);
+
+        auto m1 = table.new_mutation("pk");
+        table.add_row(m1, table.make_ckey(1), "v1");
+        auto m2 = table.new_mutation("pk");
+        table.add_row(m2, table.make_ckey(2), "v2");
+
+        underlying.apply(m1);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source([&] { return underlying(); }), tracker);
+        cache.populate(m1);
+
+        auto make_reader = [&] {
+            auto rd = cache.make_reader(s, semaphore.make_permit());
+            rd.set_max_buffer_size(1);
+            rd.fill_buffer().get();
+            return assert_that(std::move(rd));
+        };
+
+        {
+            // The first reader keeps the old version alive, so the update adds a new one,
+            // which the second reader has to merge with it.
+            auto rd1 = make_reader();
+            BOOST_REQUIRE_EQUAL(tracker.get_stats().multi_version_reads, 0);
+            ::apply(cache, underlying, m2);
+            auto rd2 = make_reader();
+            BOOST_REQUIRE_EQUAL(tracker.get_stats().multi_version_reads, 1);
+            BOOST_REQUIRE_EQUAL(tracker.get_stats().multi_version_read_versions, 2);
+
+            rd1.produces(m1).produces_end_of_stream();
+            rd2.produces(m1 + m2).produces_end_of_stream();
+        }
+        // Releasing the snapshots merges the versions.
+        tracker.cleaner().drain().get();
+        BOOST_REQUIRE_GE(tracker.cleaner().get_stats().merges, 1);
+        BOOST_REQUIRE_EQUAL(tracker.cleaner().pending_merges(), 0);
+
+        make_reader().produces(m1 + m2).produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().multi_version_reads, 1);
+    });
+}
+
 SEASTAR_TEST_CASE(test_readers_get_all_data_after_eviction) {
     return seastar::async([] {
         simple_schema table;
@@ -5144,23 +5144,20 @@ struct large_row_handler : public db::large_data_handler {
         start();
     }
 
-    virtual future<> record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual void record_large_rows(const sstables::sstable& sst, const sstables::key& partition_key,
             const clustering_key_prefix* clustering_key, uint64_t row_size) const override {
         const schema_ptr s = sst.get_schema();
         callback(*s, partition_key, clustering_key, row_size);
-        return make_ready_future<>();
     }
 
-    virtual future<> record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
+    virtual void record_large_cells(const sstables::sstable& sst, const sstables::key& partition_key,
         const clustering_key_prefix* clustering_key, const column_definition& cdef, uint64_t cell_size) const override {
-        return make_ready_future<>();
     }
 
-    virtual future<> record_large_partitions(const sstables::sstable& sst,
+    virtual void record_large_partitions(const sstables::sstable& sst,
         const sstables::key& partition_key, uint64_t partition_size, uint64_t rows_count) const override {
         const schema_ptr s = sst.get_schema();
         callback(*s, partition_key, nullptr, rows_count);
-        return make_ready_future<>();
     }
 
     virtual future<> delete_large_data_entries(const schema& s, sstring sstable_name, std::string_view) const override {
@@ -60,6 +60,7 @@
 #include <unistd.h>
 #include <boost/range/algorithm/find_if.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/cxx11/is_sorted.hpp>
 #include <boost/icl/interval_map.hpp>
 #include "test/lib/test_services.hh"
@@ -67,6 +68,7 @@
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
+#include "test/lib/eventually.hh"
 #include "readers/from_mutations_v2.hh"
 #include "readers/from_fragments_v2.hh"
 
@@ -137,6 +139,9 @@ class table_state_for_test : public table_state {
     bool compaction_enforce_min_threshold() const noexcept override {
         return true;
     }
+    bool compaction_split_unpurgeable_tombstones() const noexcept override {
+        return false;
+    }
     const sstables::sstable_set& get_sstable_set() const override {
         return _t->get_sstable_set();
     }
@@ -896,6 +901,43 @@ SEASTAR_TEST_CASE(leveled_07) {
   });
 }
 
+SEASTAR_TEST_CASE(leveled_l0_candidates_aligned_to_l1) {
+  BOOST_REQUIRE_EQUAL(smp::count, 1);
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+
+    auto keys = token_generation_for_current_shard(50);
+    // Two L1 sstables, splitting the ring in two.
+    add_sstable_for_leveled_test(env, cf, 1, 1024*1024, /*level*/1, keys[0].first, keys[20].first);
+    add_sstable_for_leveled_test(env, cf, 2, 1024*1024, /*level*/1, keys[21].first, keys[49].first);
+    // L0 sstables alternating between the two halves, the oldest one in the first.
+    for (auto i = 0; i < leveled_manifest::MAX_COMPACTING_L0*2; i++) {
+        auto lower = i % 2 == 0;
+        add_sstable_for_leveled_test(env, cf, 3 + i, 1024*1024, /*level*/0,
+                keys[lower ? 5 : 30].first, keys[lower ? 10 : 40].first, i /* max timestamp */);
+    }
+    auto candidates = get_candidates_for_leveled_strategy(*cf);
+    sstables::size_tiered_compaction_strategy_options stcs_options;
+    auto table_s = make_table_state_for_test(cf, env);
+    leveled_manifest manifest = leveled_manifest::create(*table_s, candidates, 1, stcs_options);
+    std::vector<std::optional<dht::decorated_key>> last_compacted_keys(leveled_manifest::MAX_LEVELS);
+    std::vector<int> compaction_counter(leveled_manifest::MAX_LEVELS);
+    auto desc = manifest.get_compaction_candidates(last_compacted_keys, compaction_counter);
+    BOOST_REQUIRE(desc.level == 1);
+    // All the L0 sstables of the first half, and only the L1 sstable they overlap.
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), leveled_manifest::MAX_COMPACTING_L0 + 1);
+    for (auto& sst : desc.sstables) {
+        if (sst->get_sstable_level() == 1) {
+            BOOST_REQUIRE(sst->generation() == 1);
+        } else {
+            BOOST_REQUIRE_EQUAL(sst->get_stats_metadata().max_timestamp % 2, 0);
+        }
+    }
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(leveled_invariant_fix) {
   return test_env::do_with([] (test_env& env) {
     column_family_for_tests cf(env.manager());
@@ -1449,6 +1491,73 @@ SEASTAR_TEST_CASE(compaction_with_fully_expired_table) {
     });
 }
 
+SEASTAR_TEST_CASE(compaction_skips_expired_partitions_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "expired_partitions")
+            .with_column("pk", utf8_type, column_kind::partition_key)
+            .with_column("ck", utf8_type, column_kind::clustering_key)
+            .with_column("r1", utf8_type);
+        builder.set_gc_grace_seconds(0);
+        auto s = builder.build();
+        auto tmp = tmpdir();
+
+        std::vector<dht::decorated_key> keys;
+        for (int i = 0; i < 4; ++i) {
+            keys.push_back(dht::decorate_key(*s, partition_key::from_exploded(*s, {to_bytes(format("key{}", i))})));
+        }
+        std::ranges::sort(keys, [&s] (const dht::decorated_key& a, const dht::decorated_key& b) {
+            return a.less_compare(*s, b);
+        });
+
+        // The first two partitions hold only expired cells, the others only live ones.
+        auto c_key = clustering_key::from_exploded(*s, {to_bytes("c1")});
+        auto& r1_col = *s->get_column_definition("r1");
+        auto expiration_time = (gc_clock::now() - std::chrono::hours(1)).time_since_epoch().count();
+        auto mt = make_lw_shared<replica::memtable>(s);
+        std::vector<mutation> live;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            mutation m(s, keys[i]);
+            if (i < 2) {
+                m.set_clustered_cell(c_key, r1_col, make_atomic_cell(utf8_type, bytes(256, 'a'), 1, expiration_time));
+            } else {
+                m.set_clustered_cell(c_key, r1_col, make_atomic_cell(utf8_type, bytes(256, 'a')));
+                live.push_back(m);
+            }
+            mt->apply(std::move(m));
+        }
+
+        // A Summary entry for every partition.
+        auto cfg = env.manager().configure_writer();
+        cfg.summary_byte_cost = 1;
+        auto sst = make_sstable_easy(env, tmp.path(), mt, cfg, 1, sstables::get_highest_sstable_version(), keys.size());
+        BOOST_REQUIRE(sst->get_scylla_metadata() && sst->get_scylla_metadata()->get_expiry_index());
+
+        auto ranges = sst->get_unexpired_partition_ranges(gc_clock::now(), api::max_timestamp);
+        BOOST_REQUIRE(ranges);
+        auto is_read = [&] (const dht::decorated_key& dk) {
+            return std::ranges::any_of(*ranges, [&] (const dht::partition_range& r) {
+                return r.contains(dht::ring_position(dk), dht::ring_position_comparator(*s));
+            });
+        };
+        BOOST_REQUIRE(!is_read(keys[0]) && !is_read(keys[1]));
+        BOOST_REQUIRE(is_read(keys[2]) && is_read(keys[3]));
+        // The expired cells may shadow data as old as them.
+        BOOST_REQUIRE(!sst->get_unexpired_partition_ranges(gc_clock::now(), api::timestamp_type(0)));
+
+        column_family_for_tests cf(env.manager(), s);
+        auto close_cf = deferred_stop(cf);
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(2)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+        auto ret = compact_sstables(sstables::compaction_descriptor({ sst }, cf->get_sstable_set(), default_priority_class()), *cf, sst_gen).get0();
+        BOOST_REQUIRE_EQUAL(ret.new_sstables.size(), 1);
+        assert_that(sstable_reader(ret.new_sstables.front(), s, env.make_reader_permit()))
+                .produces(live[0])
+                .produces(live[1])
+                .produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(basic_date_tiered_strategy_test) {
   return test_env::do_with([] (test_env& env) {
     schema_builder builder(make_shared_schema({}, some_keyspace, some_column_family,
@@ -1875,6 +1984,70 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(size_tiered_trims_coldest_beyond_max_threshold_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, cf.schema()->compaction_strategy_options());
+
+    std::vector<sstables::shared_sstable> candidates;
+    int max_threshold = cf->schema()->max_compaction_threshold();
+    candidates.reserve(max_threshold+1);
+    for (auto i = 0; i < (max_threshold+1); i++) { // (max_threshold+1) sstables of similar size
+        auto sst = env.make_sstable(cf.schema(), "", i, la, big);
+        sstables::test(sst).set_data_file_size(1);
+        candidates.push_back(std::move(sst));
+    }
+    // Only the last one is read, so it must not be the one left out.
+    auto hot = candidates.back();
+    hot->get_read_heat().on_partition_found(1);
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, std::move(candidates));
+    BOOST_REQUIRE(desc.sstables.size() == size_t(max_threshold));
+    BOOST_REQUIRE(boost::algorithm::any_of_equal(desc.sstables, hot));
+    return cf.stop_and_keep_alive();
+  });
+}
+
+SEASTAR_TEST_CASE(incremental_compaction_strategy_buckets_runs_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, {{"sstable_size_in_mb", "1"}});
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+    auto max_threshold = cf->schema()->max_compaction_threshold();
+    unsigned gen = 1;
+
+    auto make_run = [&] (unsigned fragments) {
+        auto run_id = utils::make_random_uuid();
+        std::vector<sstables::shared_sstable> run;
+        for (unsigned i = 0; i < fragments; i++) {
+            auto sst = env.make_sstable(cf.schema(), "", gen++, la, big);
+            sstables::test(sst).set_data_file_size(1);
+            sstables::test(sst).set_run_identifier(run_id);
+            run.push_back(std::move(sst));
+        }
+        return run;
+    };
+
+    // Fragments of the same run count as a single candidate, so max_threshold runs
+    // are compacted together even though they have more than max_threshold fragments,
+    // and no run is compacted partially.
+    std::vector<sstables::shared_sstable> candidates;
+    for (auto i = 0; i < max_threshold; i++) {
+        auto run = make_run(3);
+        candidates.insert(candidates.end(), run.begin(), run.end());
+    }
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), candidates.size());
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, uint64_t(1024 * 1024));
+
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, {{"sstable_size_in_mb", "0"}}),
+            exceptions::configuration_exception);
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto tmp = tmpdir();
@@ -4466,6 +4639,78 @@ SEASTAR_TEST_CASE(test_twcs_single_key_reader_filtering) {
     });
 }
 
+SEASTAR_TEST_CASE(test_timestamp_ordered_single_row_reads) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "timestamp_ordered_single_row_reads")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v", int32_type)
+                .build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)]() {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+
+        auto pk = partition_key::from_single_value(*s, int32_type->decompose(0));
+        auto ck = clustering_key::from_single_value(*s, int32_type->decompose(0));
+        auto make_row = [&] (int32_t v, api::timestamp_type ts, bool with_marker) {
+            mutation m(s, pk);
+            m.set_clustered_cell(ck, to_bytes("v"), v, ts);
+            if (with_marker) {
+                m.partition().clustered_row(*s, ck).apply(row_marker(ts));
+            }
+            return m;
+        };
+
+        auto cm = make_lw_shared<compaction_manager>();
+        replica::column_family::config cfg = column_family_test_config(env.manager(), env.semaphore());
+        replica::cf_stats cf_stats{0};
+        cfg.cf_stats = &cf_stats;
+        cfg.datadir = tmp.path().string();
+        cfg.enable_timestamp_ordered_reads = utils::updateable_value<bool>(true);
+        auto tracker = make_lw_shared<cache_tracker>();
+        cell_locker_stats cl_stats;
+        replica::column_family cf(s, cfg, replica::column_family::no_commitlog(), *cm, cl_stats, *tracker);
+        cf.mark_ready_for_writes();
+        cf.start();
+        auto stop_cf = deferred_stop(cf);
+
+        auto slice = partition_slice_builder(*s)
+                .with_range(query::clustering_range::make_singular(ck))
+                .build();
+
+        auto check = [&] (std::vector<mutation> muts, int64_t expected_skipped) {
+            auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {});
+            auto set = cs.make_sstable_set(s);
+            for (auto& m : muts) {
+                set.insert(make_sstable_containing(sst_gen, {m}));
+            }
+            auto expected = muts.front();
+            for (size_t i = 1; i < muts.size(); ++i) {
+                expected.apply(muts[i]);
+            }
+
+            auto skipped = cf_stats.sstables_skipped_by_timestamp;
+            utils::estimated_histogram eh;
+            auto pr = dht::partition_range::make_singular(expected.decorated_key());
+            assert_that(set.create_single_key_sstable_reader(&cf, s, env.make_reader_permit(), eh, pr, slice, default_priority_class(),
+                    tracing::trace_state_ptr(), ::streamed_mutation::forwarding::no, ::mutation_reader::forwarding::no))
+                .produces(expected)
+                .produces_end_of_stream();
+            BOOST_REQUIRE_EQUAL(cf_stats.sstables_skipped_by_timestamp - skipped, expected_skipped);
+        };
+
+        // The newest row has a marker and a value newer than both older sstables.
+        check({make_row(1, 1, true), make_row(2, 2, false), make_row(3, 3, true)}, 2);
+        // Without a row marker, older sstables may still make the row live.
+        check({make_row(1, 1, true), make_row(2, 2, false), make_row(3, 3, false)}, 0);
+        // The second newest sstable holds data as new as the newest one, so it
+        // has to be read too.
+        check({make_row(1, 1, true), make_row(2, 3, true), make_row(3, 3, true)}, 1);
+    });
+}
+
 SEASTAR_TEST_CASE(max_ongoing_compaction_test) {
     return test_env::do_with_async([] (test_env& env) {
         BOOST_REQUIRE(smp::count == 1);
@@ -4921,3 +5166,41 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test) {
        run_controller_test(sstables::compaction_strategy_type::leveled, env);
     });
 }
+
+SEASTAR_THREAD_TEST_CASE(compaction_controller_latency_feedback_test) {
+    using namespace std::chrono_literals;
+    bool slow_reads = true;
+    utils::time_estimated_histogram latencies;
+    auto feedback = compaction_controller::latency_feedback{
+        .read_latency = [&] {
+            // Every adjustment sees a new batch of reads.
+            for (int i = 0; i < 200; ++i) {
+                latencies.add(slow_reads ? 20ms : 1ms);
+            }
+            return latencies;
+        },
+        .read_latency_slo = [] { return std::chrono::microseconds(5ms); },
+    };
+    // The backlog maps to 100 shares.
+    compaction_controller controller(default_scheduling_group(), default_priority_class(), 1ms, [] { return 1.5f; }, std::move(feedback));
+    auto stop_controller = defer([&] { controller.shutdown().get(); });
+
+    BOOST_REQUIRE(eventually_true([&] { return controller.latency_factor() < 0.5; }));
+    BOOST_REQUIRE_LT(controller.shares(), 50);
+    BOOST_REQUIRE_GT(controller.read_latency_p99(), 5ms);
+
+    slow_reads = false;
+    auto factor = controller.latency_factor();
+    BOOST_REQUIRE(eventually_true([&] { return controller.latency_factor() > factor; }));
+    BOOST_REQUIRE_LT(controller.read_latency_p99(), 5ms);
+    // With slack, the shares grow past those given by the backlog.
+    BOOST_REQUIRE(eventually_true([&] { return controller.latency_factor() > 1.5; }));
+    BOOST_REQUIRE_GT(controller.shares(), 100);
+}
+
+SEASTAR_TEST_CASE(backlog_priority_option_test) {
+    BOOST_REQUIRE_NO_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {{"backlog_priority", "2.5"}}));
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {{"backlog_priority", "0"}}),
+            exceptions::configuration_exception);
+    return make_ready_future<>();
+}
@@ -34,6 +34,7 @@
 #include "test/lib/data_model.hh"
 #include "test/lib/random_utils.hh"
 #include "test/lib/log.hh"
+#include "test/lib/eventually.hh"
 
 #include <boost/range/algorithm/sort.hpp>
 
@@ -1584,3 +1585,179 @@ SEASTAR_TEST_CASE(test_static_compact_tables_are_read) {
         }
     });
 }
+
+// Reads which bypass the cache skip the values of the columns the slice
+// doesn't select, but keep their cells so that the rows stay live.
+SEASTAR_TEST_CASE(test_column_projection_skips_unselected_values) {
+    return test_env::do_with_async([] (test_env& env) {
+        auto map_type = map_type_impl::get_instance(int32_type, int32_type, true);
+        auto s = schema_builder("ks", "cf")
+                .with_column("p", int32_type, column_kind::partition_key)
+                .with_column("c", int32_type, column_kind::clustering_key)
+                .with_column("s", utf8_type, column_kind::static_column)
+                .with_column("v1", int32_type)
+                .with_column("v2", utf8_type)
+                .with_column("m", map_type)
+                .build();
+        auto& v1 = *s->get_column_definition("v1");
+        auto& v2 = *s->get_column_definition("v2");
+        auto& m_def = *s->get_column_definition("m");
+        auto& s_def = *s->get_column_definition("s");
+
+        auto dk = dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(0)));
+        auto ck1 = clustering_key::from_single_value(*s, int32_type->decompose(1));
+        auto ck2 = clustering_key::from_single_value(*s, int32_type->decompose(2));
+        const api::timestamp_type ts = 1;
+
+        // Builds the partition, with the values of the unselected columns or without them.
+        auto make_mutation = [&] (bool with_values) {
+            auto cell = [&] (const column_definition& def, data_value v) {
+                return with_values ? atomic_cell::make_live(*def.type, ts, def.type->decompose(v))
+                                   : atomic_cell::make_live(*def.type, ts, bytes_view());
+            };
+            mutation m(s, dk);
+            m.set_static_cell(s_def, atomic_cell_or_collection(cell(s_def, sstring("static"))));
+            m.set_clustered_cell(ck1, v1, atomic_cell::make_live(*int32_type, ts, int32_type->decompose(11)));
+            m.set_clustered_cell(ck1, v2, atomic_cell_or_collection(cell(v2, sstring("eleven"))));
+            collection_mutation_description md;
+            for (int i : {1, 2}) {
+                auto value = with_values ? int32_type->decompose(i * 10) : bytes();
+                md.cells.emplace_back(int32_type->decompose(i), atomic_cell::make_live(*int32_type, ts, value, atomic_cell::collection_member::yes));
+            }
+            m.set_clustered_cell(ck1, m_def, md.serialize(*map_type));
+            // A row without a marker, kept alive by an unselected column only.
+            m.set_clustered_cell(ck2, v2, atomic_cell_or_collection(cell(v2, sstring("twelve"))));
+            return m;
+        };
+
+        auto m = make_mutation(true);
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m);
+        for (const auto version : writable_sstable_versions) {
+            auto dir = tmpdir();
+            auto sst = make_sstable_easy(env, dir.path(), mt, env.manager().configure_writer(), 1, version);
+            auto ms = sst->as_mutation_source();
+            auto pr = dht::partition_range::make_singular(dk);
+
+            auto slice = partition_slice_builder(*s).with_regular_column("v1").with_no_static_columns().build();
+            assert_that(ms.make_reader(s, env.make_reader_permit(), pr, slice))
+                    .produces(m)
+                    .produces_end_of_stream();
+
+            auto bypass_slice = partition_slice_builder(*s)
+                    .with_regular_column("v1")
+                    .with_no_static_columns()
+                    .with_option<query::partition_slice::option::bypass_cache>()
+                    .build();
+            assert_that(ms.make_reader(s, env.make_reader_permit(), pr, bypass_slice))
+                    .produces(make_mutation(false))
+                    .produces_end_of_stream();
+
+            auto full_bypass_slice = partition_slice_builder(*s)
+                    .with_option<query::partition_slice::option::bypass_cache>()
+                    .build();
+            assert_that(ms.make_reader(s, env.make_reader_permit(), pr, full_bypass_slice))
+                    .produces(m)
+                    .produces_end_of_stream();
+        }
+    });
+}
+
+namespace sstables {
+extern thread_local cached_file::metrics data_page_cache_metrics;
+}
+
+SEASTAR_TEST_CASE(test_compressed_data_cache_serves_repeated_single_partition_reads) {
+    return test_env::do_with_async([] (test_env& env) {
+        test_db_config.enable_compressed_data_cache.set(true);
+        auto reset_config = defer([] { test_db_config.enable_compressed_data_cache.set(false); });
+
+        simple_schema ss;
+        auto s = ss.schema();
+        auto pk = ss.make_pkey();
+        mutation m(s, pk);
+        for (int i = 0; i < 100; ++i) {
+            ss.add_row(m, ss.make_ckey(i), format("value{}", i));
+        }
+        auto mt = make_lw_shared<replica::memtable>(s);
+        mt->apply(m);
+
+        auto dir = tmpdir();
+        auto sst = make_sstable_easy(env, dir.path(), mt, env.manager().configure_writer(), 1, sstables::get_highest_sstable_version());
+        BOOST_REQUIRE(sst->has_component(component_type::CompressionInfo));
+
+        auto read = [&] {
+            assert_that(sst->as_mutation_source().make_reader(s, env.make_reader_permit(), dht::partition_range::make_singular(pk), s->full_slice()))
+                    .produces(m)
+                    .produces_end_of_stream();
+        };
+
+        read();
+        auto populations = sstables::data_page_cache_metrics.page_populations;
+        auto hits = sstables::data_page_cache_metrics.page_hits;
+        BOOST_REQUIRE_GT(populations, 0);
+
+        read();
+        BOOST_REQUIRE_EQUAL(sstables::data_page_cache_metrics.page_populations, populations);
+        BOOST_REQUIRE_GT(sstables::data_page_cache_metrics.page_hits, hits);
+    });
+}
+
+SEASTAR_TEST_CASE(test_deferred_filter_loading) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto mt = make_lw_shared<replica::memtable>(s);
+        auto pks = ss.make_pkeys(2);
+        mutation m(s, pks[0]);
+        ss.add_row(m, ss.make_ckey(0), "v");
+        mt->apply(m);
+
+        auto dir = tmpdir();
+        auto written = make_sstable_easy(env, dir.path(), mt, env.manager().configure_writer(), 1, sstables::get_highest_sstable_version());
+        auto absent_key = sstables::key::from_partition_key(*s, pks[1].key());
+        BOOST_REQUIRE(!written->filter_has_key(absent_key));
+
+        auto sst = env.make_sstable(s, dir.path().native(), 1, sstables::get_highest_sstable_version(), sstable::format_types::big);
+        sst->load(default_priority_class(), sstable_open_config{.load_bloom_filter = false}).get();
+        BOOST_REQUIRE(sst->filter_has_key(absent_key));
+
+        sst->load_filter_in_background(default_priority_class());
+        BOOST_REQUIRE(eventually_true([&] { return !sst->filter_has_key(absent_key); }));
+        assert_that(sst->as_mutation_source().make_reader(s, env.make_reader_permit()))
+                .produces(m)
+                .produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(test_deferred_compaction_metadata_loading) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto mt = make_lw_shared<replica::memtable>(s);
+        for (auto& pk : ss.make_pkeys(10)) {
+            mutation m(s, pk);
+            ss.add_row(m, ss.make_ckey(0), "v");
+            mt->apply(m);
+        }
+
+        auto dir = tmpdir();
+        auto written = make_sstable_easy(env, dir.path(), mt, env.manager().configure_writer(), 1, sstables::get_highest_sstable_version());
+        auto expected = written->get_cardinality_estimator(default_priority_class()).get0();
+        BOOST_REQUIRE(expected);
+
+        auto sst = env.make_sstable(s, dir.path().native(), 1, sstables::get_highest_sstable_version(), sstable::format_types::big);
+        sst->load(default_priority_class(), sstable_open_config{.load_compaction_metadata = false}).get();
+        BOOST_REQUIRE_THROW(sst->get_compaction_metadata(), std::runtime_error);
+
+        auto estimator = sst->get_cardinality_estimator(default_priority_class()).get0();
+        BOOST_REQUIRE(estimator);
+        BOOST_REQUIRE_EQUAL(estimator->estimate(), expected->estimate());
+
+        // Rewriting Statistics keeps the compaction metadata.
+        sst->mutate_sstable_level(1).get();
+        auto reloaded = env.reusable_sst(s, dir.path().native(), 1).get0();
+        BOOST_REQUIRE_EQUAL(reloaded->get_sstable_level(), 1);
+        BOOST_REQUIRE_EQUAL(reloaded->get_cardinality_estimator(default_priority_class()).get0()->estimate(), expected->estimate());
+    });
+}
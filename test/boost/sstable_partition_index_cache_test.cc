@@ -10,6 +10,7 @@
 
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
 
 #include "sstables/partition_index_cache.hh"
 #include "test/lib/simple_schema.hh"
@@ -223,3 +224,79 @@ SEASTAR_THREAD_TEST_CASE(test_evict_gently) {
 
     cache.evict_gently().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_hot_pages_are_pinned) {
+    ::lru lru;
+    simple_schema s;
+    logalloc::region r;
+
+    auto page0_loader = [&] (partition_index_cache::key_type k) {
+        return make_page0(r, s);
+    };
+
+    partition_index_cache hot(lru, r);
+    partition_index_cache cold(lru, r);
+    hot.set_hot(true);
+    auto reset_budget = defer([] { partition_index_cache::set_pinned_bytes_budget(0); });
+    partition_index_cache::set_pinned_bytes_budget(std::numeric_limits<uint64_t>::max());
+
+    // The page of the hot cache is at the front of the LRU.
+    hot.get_or_load(0, page0_loader).get();
+    cold.get_or_load(0, page0_loader).get();
+    BOOST_REQUIRE_EQUAL(hot.classify(0), partition_index_cache::lookup_kind::hit);
+    BOOST_REQUIRE(partition_index_cache::shard_stats().pinned_bytes > 0);
+
+    auto old_stats = partition_index_cache::shard_stats();
+    with_allocator(r.allocator(), [&] {
+        lru.evict();
+    });
+    BOOST_REQUIRE_EQUAL(partition_index_cache::shard_stats().evictions, old_stats.evictions + 1);
+    BOOST_REQUIRE_EQUAL(partition_index_cache::shard_stats().pin_deferrals, old_stats.pin_deferrals + 1);
+    BOOST_REQUIRE_EQUAL(hot.classify(0), partition_index_cache::lookup_kind::hit);
+    BOOST_REQUIRE_EQUAL(cold.classify(0), partition_index_cache::lookup_kind::miss);
+
+    // Over the budget, the pages of hot caches are evicted like the others.
+    partition_index_cache::set_pinned_bytes_budget(0);
+    with_allocator(r.allocator(), [&] {
+        lru.evict();
+    });
+    BOOST_REQUIRE_EQUAL(hot.classify(0), partition_index_cache::lookup_kind::miss);
+    BOOST_REQUIRE_EQUAL(partition_index_cache::shard_stats().pinned_bytes, 0);
+
+    hot.get_or_load(0, page0_loader).get();
+    BOOST_REQUIRE(partition_index_cache::shard_stats().pinned_bytes > 0);
+    hot.set_hot(false);
+    BOOST_REQUIRE_EQUAL(partition_index_cache::shard_stats().pinned_bytes, 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_prefetch) {
+    ::lru lru;
+    simple_schema s;
+    logalloc::region r;
+    partition_index_cache cache(lru, r);
+
+    auto page0_loader = [&] (partition_index_cache::key_type k) {
+        return make_page0(r, s);
+    };
+    auto no_loader = [&] (partition_index_cache::key_type k) -> future<partition_index_page> {
+        throw std::runtime_error("should not have been invoked");
+    };
+
+    auto old_stats = cache.shard_stats();
+
+    BOOST_REQUIRE_EQUAL(cache.classify(1), partition_index_cache::lookup_kind::miss);
+    cache.prefetch(1, page0_loader).get();
+    BOOST_REQUIRE_EQUAL(cache.classify(1), partition_index_cache::lookup_kind::prefetched);
+    // Already present.
+    cache.prefetch(1, no_loader).get();
+    BOOST_REQUIRE_EQUAL(cache.shard_stats().prefetches, old_stats.prefetches + 1);
+    BOOST_REQUIRE_EQUAL(cache.shard_stats().misses, old_stats.misses);
+
+    has_page0(cache.get_or_load(1, no_loader).get0());
+    BOOST_REQUIRE_EQUAL(cache.shard_stats().prefetch_hits, old_stats.prefetch_hits + 1);
+    BOOST_REQUIRE_EQUAL(cache.shard_stats().hits, old_stats.hits + 1);
+    BOOST_REQUIRE_EQUAL(cache.classify(1), partition_index_cache::lookup_kind::hit);
+
+    cache.get_or_load(1, no_loader).get();
+    BOOST_REQUIRE_EQUAL(cache.shard_stats().prefetch_hits, old_stats.prefetch_hits + 1);
+}
@@ -833,6 +833,60 @@ SEASTAR_TEST_CASE(test_skipping_in_compressed_stream) {
     });
 }
 
+// Reads spanning many chunks decompress them ahead of the consumer.
+// Check that reading and skipping see the same data as with plain reads.
+SEASTAR_TEST_CASE(test_read_ahead_in_compressed_stream) {
+    return seastar::async([] {
+        tmpdir tmp;
+        auto file_path = (tmp.path() / "test").string();
+        file f = open_file_dma(file_path, open_flags::create | open_flags::wo).get0();
+
+        compression_parameters cp({
+            { compression_parameters::SSTABLE_COMPRESSION, "LZ4Compressor" },
+            { compression_parameters::CHUNK_LENGTH_KB, "4" },
+        });
+
+        sstables::compression c;
+        auto os = make_file_output_stream(f, file_output_stream_options()).get0();
+        auto out = make_compressed_file_m_format_output_stream(std::move(os), &c, cp);
+
+        const size_t nr_chunks = 16;
+        const size_t uncompressed_size = nr_chunks * c.uncompressed_chunk_length() - 100;
+        temporary_buffer<char> data(uncompressed_size);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data.get_write()[i] = char(i * 7 + i / 1000);
+        }
+        out.write(data.get(), data.size()).get();
+        out.close().get();
+        c.update(seastar::file_size(file_path).get0());
+
+        f = open_file_dma(file_path, open_flags::ro).get0();
+        auto close_f = deferred_close(f);
+
+        auto check_read = [&] (uint64_t pos, size_t len, std::vector<std::pair<size_t, size_t>> reads_and_skips) {
+            file_input_stream_options opts;
+            opts.buffer_size = 4 * c.uncompressed_chunk_length();
+            auto in = make_compressed_file_m_format_input_stream(f, &c, pos, len, opts);
+            auto close_in = deferred_close(in);
+            for (auto [read, skip] : reads_and_skips) {
+                auto b = in.read_exactly(read).get0();
+                BOOST_REQUIRE_EQUAL(b.size(), std::min(read, size_t(uncompressed_size - pos)));
+                BOOST_REQUIRE(std::equal(b.begin(), b.end(), data.get() + pos));
+                pos += b.size();
+                in.skip(skip).get();
+                pos += skip;
+            }
+        };
+
+        check_read(0, uncompressed_size, {{uncompressed_size, 0}});
+        check_read(1000, uncompressed_size - 1000, {{uncompressed_size - 1000, 0}});
+        check_read(0, uncompressed_size, {{100, 100}, {5000, 4096}, {1, 20000}, {10000, 0}});
+        check_read(3, uncompressed_size - 3, {{4093, 4096 * 3}, {4096, 4096 * 5}, {uncompressed_size, 0}});
+        // Skipping to the end of the range.
+        check_read(0, uncompressed_size, {{10, uncompressed_size - 10}, {1, 0}});
+    });
+}
+
 // Test that sstables::key_view::tri_compare(const schema& s, partition_key_view other)
 // should correctly compare empty keys. The fact we did this incorrectly was
 // noticed while fixing #9375, and a separate issue on it is #10178.
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#define BOOST_TEST_MODULE core
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <compare>
+#include <map>
+#include <random>
+
+#include "utils/tournament_tree.hh"
+
+namespace {
+
+struct value {
+    int key;
+    int id;
+};
+
+struct key_tri_compare {
+    unsigned* comparisons;
+
+    std::strong_ordering operator()(const value& a, const value& b) const {
+        ++*comparisons;
+        return a.key <=> b.key;
+    }
+};
+
+using tree_type = utils::tournament_tree<value, key_tri_compare>;
+
+}
+
+BOOST_AUTO_TEST_CASE(test_random_walk) {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> key_dist(0, 20);
+    unsigned comparisons = 0;
+    tree_type tree(key_tri_compare{&comparisons});
+    std::multimap<int, int> reference;
+    int next_id = 0;
+
+    for (int i = 0; i < 100000; ++i) {
+        auto op = rng() % 8;
+        if (op == 0 && !reference.empty() && (rng() % 64) == 0) {
+            tree.clear();
+            reference.clear();
+        } else if (op < 4 || reference.empty()) {
+            auto k = key_dist(rng);
+            tree.push(value{k, next_id});
+            reference.emplace(k, next_id++);
+        } else {
+            BOOST_REQUIRE_EQUAL(tree.top().key, reference.begin()->first);
+            BOOST_REQUIRE_EQUAL(tree.top_has_equal(), reference.count(reference.begin()->first) > 1);
+            auto v = tree.pop();
+            BOOST_REQUIRE_EQUAL(v.key, reference.begin()->first);
+            auto range = reference.equal_range(v.key);
+            auto it = std::find_if(range.first, range.second, [&] (auto& e) { return e.second == v.id; });
+            BOOST_REQUIRE(it != range.second);
+            reference.erase(it);
+        }
+        BOOST_REQUIRE_EQUAL(tree.size(), reference.size());
+        BOOST_REQUIRE_EQUAL(tree.empty(), reference.empty());
+    }
+
+    size_t n = 0;
+    tree.for_each([&] (value&) { ++n; });
+    BOOST_REQUIRE_EQUAL(n, reference.size());
+}
+
+BOOST_AUTO_TEST_CASE(test_replacing_the_minimum_takes_one_comparison_per_level) {
+    unsigned comparisons = 0;
+    tree_type tree(key_tri_compare{&comparisons});
+    for (int i = 0; i < 64; ++i) {
+        tree.push(value{i, i});
+    }
+    for (int i = 0; i < 256; ++i) {
+        comparisons = 0;
+        auto v = tree.pop();
+        BOOST_REQUIRE_EQUAL(v.key, i);
+        tree.push(value{v.key + 64, v.id});
+        BOOST_REQUIRE_EQUAL(comparisons, 6u);
+        BOOST_REQUIRE(!tree.top_has_equal());
+    }
+    BOOST_REQUIRE_EQUAL(tree.size(), 64u);
+}
@@ -94,3 +94,39 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_slow_query_recent) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+
+        // keep every session as a slow query, without writing any
+        t.set_slow_query_threshold(std::chrono::microseconds(0));
+        t.set_slow_query_persist_ratio(0);
+        const auto slow_queries = t.stats.slow_queries;
+        const auto persisted_slow_queries = t.stats.persisted_slow_queries;
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::log_slow_query);
+
+        tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+        tracing::begin(trace_state, "begin", gms::inet_address());
+        tracing::add_query(trace_state, "SELECT * FROM ks.cf");
+        tracing::stop_foreground(trace_state);
+
+        // the query is kept in memory even though its records are not written
+        BOOST_CHECK_EQUAL(t.stats.slow_queries, slow_queries + 1);
+        BOOST_CHECK_EQUAL(t.stats.persisted_slow_queries, persisted_slow_queries);
+        BOOST_REQUIRE(!t.recent_slow_queries().empty());
+        auto& q = t.recent_slow_queries().back();
+        BOOST_CHECK_EQUAL(q.session_id, trace_state->session_id());
+        BOOST_CHECK_EQUAL(q.session.request, "begin");
+        BOOST_CHECK_EQUAL(q.session.parameters.at("query"), "SELECT * FROM ks.cf");
+
+        BOOST_CHECK(!t.should_persist_slow_query(trace_state->session_id()));
+        t.set_slow_query_persist_ratio(1);
+        BOOST_CHECK(t.should_persist_slow_query(trace_state->session_id()));
+        BOOST_CHECK_THROW(t.set_slow_query_persist_ratio(2), std::out_of_range);
+
+        return make_ready_future<>();
+    });
+}
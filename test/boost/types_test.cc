@@ -842,6 +842,19 @@ BOOST_AUTO_TEST_CASE(test_map_to_json) {
     BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), "{\"42\": \"abc\", \"42\": \"abc\"}");
 }
 
+BOOST_AUTO_TEST_CASE(test_string_to_json_escaping) {
+    auto json = [] (std::string_view s) {
+        return to_json_string(*utf8_type, bytes(reinterpret_cast<const int8_t*>(s.data()), s.size()));
+    };
+    BOOST_REQUIRE_EQUAL(json(""), "\"\"");
+    BOOST_REQUIRE_EQUAL(json("abc"), "\"abc\"");
+    BOOST_REQUIRE_EQUAL(json("a long string with no characters to escape"), "\"a long string with no characters to escape\"");
+    BOOST_REQUIRE_EQUAL(json("zażółć gęślą jaźń"), "\"zażółć gęślą jaźń\"");
+    BOOST_REQUIRE_EQUAL(json("12345678\"12345678\\"), "\"12345678\\\"12345678\\\\\"");
+    BOOST_REQUIRE_EQUAL(json("tab\there, newline\nhere\r\b\f"), "\"tab\\there, newline\\nhere\\r\\b\\f\"");
+    BOOST_REQUIRE_EQUAL(json(std::string_view("0123456789\x01\x1f", 12)), "\"0123456789\\u0001\\u001F\"");
+}
+
 BOOST_AUTO_TEST_CASE(test_set_to_string) {
     auto m = set_type_impl::get_instance(int32_type, true);
     using native_type = std::vector<data_value>;
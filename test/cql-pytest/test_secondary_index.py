@@ -344,3 +344,31 @@ def test_index_weird_chars_in_col_name(cql, test_keyspace):
             iswordchar = lambda x: str.isalnum(x) or x == '_'
             cleaned_up_column_name = ''.join(filter(iswordchar, magic_path))
             assert index_name == cf + '_' + cleaned_up_column_name + '_idx'
+
+# CREATE INDEX ... INCLUDE (...) copies the listed columns into the index
+# table. Queries which select only them and key columns are then answered
+# from the index table alone, and must return the same rows as the other
+# queries using the index. Included columns are a Scylla extension.
+def test_index_included_columns(scylla_only, cql, test_keyspace):
+    schema = 'p int, c int, v int, a int, b int, PRIMARY KEY (p, c)'
+    with new_test_table(cql, test_keyspace, schema) as table:
+        cql.execute(f'CREATE INDEX ON {table}(v) INCLUDE (a)')
+        for p in range(3):
+            for c in range(3):
+                cql.execute(f'INSERT INTO {table} (p, c, v, a, b) VALUES ({p}, {c}, {c}, {p*10+c}, 0)')
+        assert sorted(cql.execute(f'SELECT p, a FROM {table} WHERE v = 1')) == [(0, 1), (1, 11), (2, 21)]
+        # Updates of an included column reach the index table
+        cql.execute(f'UPDATE {table} SET a = 100 WHERE p = 1 AND c = 1')
+        assert sorted(cql.execute(f'SELECT p, a FROM {table} WHERE v = 1')) == [(0, 1), (1, 100), (2, 21)]
+        # A column which isn't included is read from the base table
+        assert sorted(cql.execute(f'SELECT p, a, b FROM {table} WHERE v = 1')) == [(0, 1, 0), (1, 100, 0), (2, 21, 0)]
+        # An included column can't be dropped from the base table
+        with pytest.raises(InvalidRequest):
+            cql.execute(f'ALTER TABLE {table} DROP a')
+
+def test_index_included_columns_validation(scylla_only, cql, test_keyspace):
+    schema = 'p int, c int, s int static, v int, a int, PRIMARY KEY (p, c)'
+    with new_test_table(cql, test_keyspace, schema) as table:
+        for included in ['p', 'c', 's', 'v', 'a, a', 'nonexistent']:
+            with pytest.raises(InvalidRequest):
+                cql.execute(f'CREATE INDEX ON {table}(v) INCLUDE ({included})')
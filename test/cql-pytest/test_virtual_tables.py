@@ -55,6 +55,19 @@ def test_runtime_info(scylla_only, cql):
 def test_versions(scylla_only, cql):
     _check_exists(cql, "versions", ("key", "build_id", "build_mode", "version"))
 
+# One in hot_partitions_sample_period (100 by default) writes is sampled, so
+# writing a partition many more times than that gets it listed.
+def test_hot_partitions(scylla_only, cql, test_keyspace):
+    with util.new_test_table(cql, test_keyspace, 'pk int, ck int, v int, PRIMARY KEY (pk, ck)') as table:
+        stmt = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (7, ?, 0)")
+        for ck in range(1000):
+            cql.execute(stmt, [ck])
+        ks, tbl = table.split('.')
+        res = list(cql.execute(f"SELECT partition_key, writes FROM system.hot_partitions WHERE keyspace_name = '{ks}' AND table_name = '{tbl}'"))
+        assert len(res) == 1
+        assert res[0].partition_key == '7'
+        assert res[0].writes > 0
+
 # Check reading the system.config table, which should list all configuration
 # parameters. As we noticed in issue #10047, each type of configuration
 # parameter can have a different function for printing it out, and some of
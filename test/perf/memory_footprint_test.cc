@@ -75,6 +75,9 @@ class size_calculator {
         std::cout << "\n";
 
         std::cout << prefix() << "sizeof(atomic_cell_or_collection) = " << sizeof(atomic_cell_or_collection) << "\n";
+        std::cout << prefix() << "sizeof(cell_and_hash) = " << sizeof(cell_and_hash) << "\n";
+        std::cout << prefix() << "sizeof(blob_storage) = " << sizeof(blob_storage) << "\n";
+        std::cout << prefix() << "sizeof(managed_bytes) = " << sizeof(managed_bytes) << ", max_inline_size = " << managed_bytes::max_inline_size << "\n";
         std::cout << prefix() << "btree::linear_node_size(1) = " << mutation_partition::rows_type::node::linear_node_size(1) << "\n";
         std::cout << prefix() << "btree::inner_node_size = " << mutation_partition::rows_type::node::inner_node_size << "\n";
         std::cout << prefix() << "btree::leaf_node_size = " << mutation_partition::rows_type::node::leaf_node_size << "\n";
@@ -141,15 +144,38 @@ struct mutation_settings {
     size_t partition_key_size;
     size_t clustering_key_size;
     size_t data_size;
+    // The type of the regular columns, see column_types.
+    sstring column_type;
 };
 
+// Regular columns can be blobs of data_size bytes, or of a fixed-width type,
+// for which data_size is ignored.
+static const std::map<sstring, data_type> column_types = {
+    {"blob", bytes_type},
+    {"int", int32_type},
+    {"bigint", long_type},
+    {"double", double_type},
+};
+
+static data_value random_value(const mutation_settings& settings) {
+    auto& type = column_types.at(settings.column_type);
+    if (type == int32_type) {
+        return data_value(int32_t(std::rand()));
+    } else if (type == long_type) {
+        return data_value((int64_t(std::rand()) << 32) | std::rand());
+    } else if (type == double_type) {
+        return data_value(double(std::rand()) / RAND_MAX);
+    }
+    return data_value(random_bytes(settings.data_size));
+}
+
 static schema_ptr make_schema(const mutation_settings& settings) {
     auto builder = schema_builder("ks", "cf")
         .with_column("pk", bytes_type, column_kind::partition_key)
         .with_column("ck", bytes_type, column_kind::clustering_key);
 
     for (size_t i = 0; i < settings.column_count; ++i) {
-        builder.with_column(to_bytes(random_name(settings.column_name_size)), bytes_type);
+        builder.with_column(to_bytes(random_name(settings.column_name_size)), column_types.at(settings.column_type));
     }
 
     return builder.build();
@@ -162,8 +188,7 @@ static mutation make_mutation(schema_ptr s, mutation_settings settings) {
         auto ck = clustering_key::from_single_value(*s, bytes_type->decompose(data_value(random_bytes(settings.clustering_key_size))));
         for (auto&& col : s->regular_columns()) {
             m.set_clustered_cell(ck, col,
-                atomic_cell::make_live(*bytes_type, 1,
-                    bytes_type->decompose(data_value(random_bytes(settings.data_size)))));
+                atomic_cell::make_live(*col.type, 1, col.type->decompose(random_value(settings))));
         }
     }
     return m;
@@ -232,7 +257,8 @@ int main(int argc, char** argv) {
         ("partition-count", bpo::value<size_t>()->default_value(1), "partition count")
         ("partition-key-size", bpo::value<size_t>()->default_value(10), "partition key size")
         ("clustering-key-size", bpo::value<size_t>()->default_value(10), "clustering key size")
-        ("data-size", bpo::value<size_t>()->default_value(32), "cell data size");
+        ("data-size", bpo::value<size_t>()->default_value(32), "cell data size")
+        ("column-type", bpo::value<sstring>()->default_value("blob"), "type of the regular columns: blob, int, bigint or double");
 
     return app.run(argc, argv, [&] {
         if (smp::count != 1) {
@@ -252,6 +278,10 @@ int main(int argc, char** argv) {
             settings.partition_key_size = app.configuration()["partition-key-size"].as<size_t>();
             settings.clustering_key_size = app.configuration()["clustering-key-size"].as<size_t>();
             settings.data_size = app.configuration()["data-size"].as<size_t>();
+            settings.column_type = app.configuration()["column-type"].as<sstring>();
+            if (!column_types.contains(settings.column_type)) {
+                throw std::runtime_error(format("Unknown column type: {}", settings.column_type));
+            }
 
             auto& tracker = env.local_db().find_column_family("system", "local").get_row_cache().get_cache_tracker();
             auto sizes = calculate_sizes(tracker, settings);
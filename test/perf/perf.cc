@@ -51,6 +51,10 @@ std::ostream&
 operator<<(std::ostream& os, const perf_result& result) {
     fmt::print(os, "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} tasks/op, {:7.0f} insns/op)",
             result.throughput, result.mallocs_per_op, result.tasks_per_op, result.instructions_per_op);
+    if (result.latency_max) {
+        fmt::print(os, " latency: p50 {:.0f}us, p99 {:.0f}us, p999 {:.0f}us, max {:.0f}us",
+                result.latency_p50, result.latency_p99, result.latency_p999, result.latency_max);
+    }
     return os;
 }
 
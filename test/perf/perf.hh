@@ -12,10 +12,12 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/sleep.hh>
 #include "seastarx.hh"
 #include "utils/extremum_tracking.hh"
 #include "utils/estimated_histogram.hh"
-#include "linux-perf-event.hh"
+#include "utils/linux-perf-event.hh"
 #include "reader_permit.hh"
 
 #include <chrono>
@@ -135,11 +137,122 @@ executor<Func>::executor_shard_stats_snapshot() {
     };
 }
 
+// Latencies in microseconds, from 16us to 64s, with a relative error of
+// about 1/16.
+using latency_histogram = utils::approx_exponential_histogram<16, 67108864, 16>;
+
+struct rate_executor_shard_stats {
+    executor_shard_stats stats;
+    latency_histogram latencies;
+    std::chrono::steady_clock::duration max_latency{0};
+};
+
+inline
+rate_executor_shard_stats
+operator+(rate_executor_shard_stats a, const rate_executor_shard_stats& b) {
+    a.stats = a.stats + b.stats;
+    a.latencies.merge(b.latencies);
+    a.max_latency = std::max(a.max_latency, b.max_latency);
+    return a;
+}
+
+// Drives execution of given asynchronous action at a fixed rate until a
+// deadline, without waiting for earlier invocations to complete, with at
+// most max_in_flight of them running at a time. The latency of an
+// invocation is measured from the time it was due to start, not from the
+// time it started, so that invocations delayed by slow earlier ones, or by
+// max_in_flight, are accounted for (no coordinated omission).
+template <typename Func>
+class rate_executor {
+    using clk = std::chrono::steady_clock;
+    const Func _func;
+    const clk::duration _interval;
+    const lowres_clock::time_point _end_at;
+    const uint64_t _end_at_count;
+    const unsigned _max_in_flight;
+    semaphore _in_flight;
+    uint64_t _count = 0;
+    latency_histogram _latencies;
+    clk::duration _max_latency{0};
+    std::exception_ptr _ex;
+    linux_perf_event _instructions_retired_counter = linux_perf_event::user_instructions_retired();
+private:
+    executor_shard_stats executor_shard_stats_snapshot() {
+        return executor_shard_stats{
+            .invocations = _count,
+            .allocations = perf_mallocs(),
+            .tasks_executed = perf_tasks_processed(),
+            .instructions_retired = _instructions_retired_counter.read(),
+        };
+    }
+    bool done() const {
+        return _ex || (_end_at_count ? _count == _end_at_count : lowres_clock::now() >= _end_at);
+    }
+    void invoke(clk::time_point due, semaphore_units<> units) {
+        (void)futurize_invoke(_func).then_wrapped([this, due, units = std::move(units)] (future<> f) {
+            if (f.failed()) {
+                _ex = f.get_exception();
+                return;
+            }
+            auto latency = clk::now() - due;
+            _latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+            _max_latency = std::max(_max_latency, latency);
+        });
+    }
+public:
+    rate_executor(double rate, unsigned max_in_flight, Func func, lowres_clock::time_point end_at, uint64_t end_at_count = 0)
+            : _func(std::move(func))
+            , _interval(std::chrono::duration_cast<clk::duration>(std::chrono::duration<double>(1 / rate)))
+            , _end_at(end_at)
+            , _end_at_count(end_at_count)
+            , _max_in_flight(max_in_flight)
+            , _in_flight(max_in_flight)
+    { }
+
+    future<rate_executor_shard_stats> run() {
+        auto stats_start = executor_shard_stats_snapshot();
+        _instructions_retired_counter.enable();
+        auto start = clk::now();
+        return do_until([this] { return done(); }, [this, start] {
+            auto due = start + _interval * static_cast<clk::rep>(_count);
+            ++_count;
+            auto now = clk::now();
+            auto f = due > now ? seastar::sleep(due - now) : make_ready_future<>();
+            return f.then([this] {
+                return get_units(_in_flight, 1);
+            }).then([this, due] (semaphore_units<> units) {
+                invoke(due, std::move(units));
+            });
+        }).then([this] {
+            return _in_flight.wait(_max_in_flight);
+        }).then([this, stats_start] {
+            _instructions_retired_counter.disable();
+            if (_ex) {
+                return make_exception_future<rate_executor_shard_stats>(_ex);
+            }
+            return make_ready_future<rate_executor_shard_stats>(rate_executor_shard_stats{
+                .stats = executor_shard_stats_snapshot() - stats_start,
+                .latencies = _latencies,
+                .max_latency = _max_latency,
+            });
+        });
+    }
+
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
 struct perf_result {
     double throughput;
     double mallocs_per_op;
     double tasks_per_op;
     double instructions_per_op;
+    // Latencies in microseconds, only measured by time_parallel_rate().
+    double latency_p50 = 0;
+    double latency_p99 = 0;
+    double latency_p999 = 0;
+    double latency_max = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const perf_result& result);
@@ -182,6 +295,46 @@ std::vector<perf_result> time_parallel(Func func, unsigned concurrency_per_core,
     return results;
 }
 
+/**
+ * Like time_parallel(), but starts the action on each core at the given rate
+ * per second, whether or not earlier executions completed, with at most
+ * max_in_flight_per_core of them at a time. Also measures their latencies.
+ */
+template <typename Func>
+static
+std::vector<perf_result> time_parallel_rate(Func func, double rate_per_core, unsigned max_in_flight_per_core, int iterations = 5, unsigned operations_per_shard = 0) {
+    using clk = std::chrono::steady_clock;
+    if (operations_per_shard) {
+        iterations = 1;
+    }
+    std::vector<perf_result> results;
+    for (int i = 0; i < iterations; ++i) {
+        auto start = clk::now();
+        auto end_at = lowres_clock::now() + std::chrono::seconds(1);
+        distributed<rate_executor<Func>> exec;
+        exec.start(rate_per_core, max_in_flight_per_core, func, std::move(end_at), operations_per_shard).get();
+        auto res = exec.map_reduce0(std::mem_fn(&rate_executor<Func>::run),
+                rate_executor_shard_stats(), std::plus<rate_executor_shard_stats>()).get0();
+        auto end = clk::now();
+        auto duration = std::chrono::duration<double>(end - start).count();
+        const auto& stats = res.stats;
+        auto result = perf_result{
+            .throughput = static_cast<double>(stats.invocations) / duration,
+            .mallocs_per_op = double(stats.allocations) / stats.invocations,
+            .tasks_per_op = double(stats.tasks_executed) / stats.invocations,
+            .instructions_per_op = double(stats.instructions_retired) / stats.invocations,
+            .latency_p50 = double(res.latencies.quantile(0.5)),
+            .latency_p99 = double(res.latencies.quantile(0.99)),
+            .latency_p999 = double(res.latencies.quantile(0.999)),
+            .latency_max = double(std::chrono::duration_cast<std::chrono::microseconds>(res.max_latency).count()),
+        };
+        std::cout << result << "\n";
+        results.emplace_back(result);
+        exec.stop().get();
+    }
+    return results;
+}
+
 template<typename Func>
 auto duration_in_seconds(Func&& f) {
     using clk = std::chrono::steady_clock;
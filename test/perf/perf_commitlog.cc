@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/distributed.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/memory.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+
+#include "db/commitlog/commitlog.hh"
+#include "db/commitlog/commitlog_entry.hh"
+#include "frozen_mutation.hh"
+#include "replica/memtable.hh"
+#include "schema_builder.hh"
+#include "test/lib/random_utils.hh"
+#include "test/perf/perf.hh"
+
+// Drives db::commitlog::add() from a number of concurrent writers per
+// shard, and reports throughput, add() latencies, syncs and segment
+// turnover. With --memtable, each write is also applied to a memtable, as
+// the local write path does, and the memtable is dropped once it grows
+// past --memtable-size, releasing its segments.
+
+struct test_config {
+    sstring directory;
+    unsigned duration_in_seconds;
+    unsigned concurrency;
+    size_t mutation_size;
+    db::commitlog::sync_mode mode;
+    uint64_t segment_size_in_mb;
+    uint64_t total_space_in_mb;
+    uint64_t sync_period_in_ms;
+    uint64_t max_active_writes;
+    bool memtable;
+    size_t memtable_size;
+};
+
+struct shard_result {
+    uint64_t writes = 0;
+    uint64_t bytes = 0;
+    uint64_t syncs = 0;
+    uint64_t segments_created = 0;
+    uint64_t segments_destroyed = 0;
+    latency_histogram latencies;
+    std::chrono::steady_clock::duration max_latency{0};
+};
+
+static shard_result operator+(shard_result a, const shard_result& b) {
+    a.writes += b.writes;
+    a.bytes += b.bytes;
+    a.syncs += b.syncs;
+    a.segments_created += b.segments_created;
+    a.segments_destroyed += b.segments_destroyed;
+    a.latencies.merge(b.latencies);
+    a.max_latency = std::max(a.max_latency, b.max_latency);
+    return a;
+}
+
+static schema_ptr make_schema() {
+    return schema_builder("ks", "cf")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("v", bytes_type)
+            .build();
+}
+
+static future<shard_result> run_shard(const test_config& cfg) {
+    return seastar::async([&cfg] {
+        using clk = std::chrono::steady_clock;
+
+        db::commitlog::config cl_cfg;
+        cl_cfg.commit_log_location = format("{}/{}", cfg.directory, this_shard_id());
+        cl_cfg.mode = cfg.mode;
+        cl_cfg.commitlog_segment_size_in_mb = cfg.segment_size_in_mb;
+        cl_cfg.commitlog_total_space_in_mb = cfg.total_space_in_mb;
+        cl_cfg.commitlog_sync_period_in_ms = cfg.sync_period_in_ms;
+        cl_cfg.max_active_writes = cfg.max_active_writes;
+        cl_cfg.warn_about_segments_left_on_disk_after_shutdown = false;
+        recursive_touch_directory(cl_cfg.commit_log_location).get();
+
+        auto log = db::commitlog::create_commitlog(cl_cfg).get0();
+        auto stop_log = defer([&log] {
+            log.shutdown().get();
+            log.clear().get();
+        });
+
+        auto s = make_schema();
+        auto mt = make_lw_shared<replica::memtable>(s);
+        const auto value = tests::random::get_bytes(cfg.mutation_size);
+
+        shard_result res;
+        const auto syncs = log.get_flush_count();
+        const auto segments_created = log.get_num_segments_created();
+        const auto segments_destroyed = log.get_num_segments_destroyed();
+        const auto end_at = lowres_clock::now() + std::chrono::seconds(cfg.duration_in_seconds);
+
+        auto write = [&] () -> future<> {
+            if (!cfg.memtable) {
+                auto start = clk::now();
+                return log.add_mutation(s->id(), value.size(), db::commitlog::force_sync::no, [&value] (db::commitlog::output& out) {
+                    out.write(reinterpret_cast<const char*>(value.begin()), value.size());
+                }).then([&res, start, size = value.size()] (db::rp_handle h) {
+                    // Dropping the handle marks the entry as flushed.
+                    auto latency = clk::now() - start;
+                    res.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+                    res.max_latency = std::max(res.max_latency, latency);
+                    res.bytes += size;
+                });
+            }
+
+            mutation m(s, partition_key::from_single_value(*s, tests::random::get_bytes(16)));
+            m.set_clustered_cell(clustering_key::make_empty(), to_bytes("v"), data_value(value), api::new_timestamp());
+            auto fm = make_lw_shared<frozen_mutation>(freeze(m));
+            auto start = clk::now();
+            return do_with(commitlog_entry_writer(s, *fm, db::commitlog::force_sync::no), [&, fm, start] (commitlog_entry_writer& cew) {
+                return log.add_entry(s->id(), cew, db::timeout_clock::time_point::max()).then([&, fm, start] (db::rp_handle h) {
+                    auto latency = clk::now() - start;
+                    mt->apply(*fm, s, std::move(h));
+                    res.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+                    res.max_latency = std::max(res.max_latency, latency);
+                    res.bytes += fm->representation().size();
+                    if (mt->occupancy().used_space() > cfg.memtable_size) {
+                        // Stands in for a flush: the handles go with the memtable.
+                        mt = make_lw_shared<replica::memtable>(s);
+                    }
+                });
+            });
+        };
+
+        auto idx = boost::irange(0u, cfg.concurrency);
+        parallel_for_each(idx.begin(), idx.end(), [&] (unsigned) {
+            return do_until([end_at] { return lowres_clock::now() >= end_at; }, [&] {
+                ++res.writes;
+                return write();
+            });
+        }).get();
+        log.sync_all_segments().get();
+
+        res.syncs = log.get_flush_count() - syncs;
+        res.segments_created = log.get_num_segments_created() - segments_created;
+        res.segments_destroyed = log.get_num_segments_destroyed() - segments_destroyed;
+        mt = {};
+        return res;
+    });
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("directory", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-commitlog"), "directory in which to create the commitlog segments")
+        ("duration", bpo::value<unsigned>()->default_value(10), "test duration in seconds")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "concurrent writes per shard")
+        ("mutation-size", bpo::value<size_t>()->default_value(1024), "size in bytes of each written value")
+        ("sync", bpo::value<sstring>()->default_value("periodic"), "commitlog sync mode, periodic or batch")
+        ("sync-period", bpo::value<uint64_t>()->default_value(10000), "sync period in ms, in periodic mode")
+        ("segment-size", bpo::value<uint64_t>()->default_value(32), "segment size in MB")
+        ("total-space", bpo::value<uint64_t>()->default_value(0), "commitlog space per node in MB, 0 for the size of memory")
+        ("max-active-writes", bpo::value<uint64_t>()->default_value(0), "max concurrent segment writes per shard, 0 for the default")
+        ("memtable", "also apply each write to a memtable")
+        ("memtable-size", bpo::value<size_t>()->default_value(64), "size in MB at which the memtable is dropped, with --memtable")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return seastar::async([&app] {
+            auto& opts = app.configuration();
+            test_config cfg;
+            cfg.directory = opts["directory"].as<sstring>();
+            cfg.duration_in_seconds = opts["duration"].as<unsigned>();
+            cfg.concurrency = opts["concurrency"].as<unsigned>();
+            cfg.mutation_size = opts["mutation-size"].as<size_t>();
+            auto sync = opts["sync"].as<sstring>();
+            if (sync == "periodic") {
+                cfg.mode = db::commitlog::sync_mode::PERIODIC;
+            } else if (sync == "batch") {
+                cfg.mode = db::commitlog::sync_mode::BATCH;
+            } else {
+                throw std::invalid_argument(format("Invalid sync mode: {}", sync));
+            }
+            cfg.sync_period_in_ms = opts["sync-period"].as<uint64_t>();
+            cfg.segment_size_in_mb = opts["segment-size"].as<uint64_t>();
+            cfg.total_space_in_mb = opts["total-space"].as<uint64_t>();
+            if (!cfg.total_space_in_mb) {
+                // As commitlog::config::from_db_config() does by default.
+                cfg.total_space_in_mb = (memory::stats().total_memory() * smp::count) >> 20;
+            }
+            cfg.max_active_writes = opts["max-active-writes"].as<uint64_t>();
+            cfg.memtable = opts.contains("memtable");
+            cfg.memtable_size = opts["memtable-size"].as<size_t>() << 20;
+
+            std::cout << format("Running {} writes of {} bytes, {} concurrent per shard, for {}s, sync {}\n",
+                    cfg.memtable ? "memtable and commitlog" : "commitlog", cfg.mutation_size, cfg.concurrency,
+                    cfg.duration_in_seconds, sync);
+
+            auto start = std::chrono::steady_clock::now();
+            auto res = map_reduce(boost::irange(0u, smp::count), [&cfg] (unsigned shard) {
+                return smp::submit_to(shard, [&cfg] {
+                    return run_shard(cfg);
+                });
+            }, shard_result(), std::plus<shard_result>()).get0();
+            auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << format("{:.0f} writes/s, {:.2f} MB/s\n", res.writes / seconds, res.bytes / seconds / (1 << 20));
+            std::cout << format("add() latency: p50 {}us, p99 {}us, p999 {}us, max {}us\n",
+                    res.latencies.quantile(0.5), res.latencies.quantile(0.99), res.latencies.quantile(0.999),
+                    std::chrono::duration_cast<std::chrono::microseconds>(res.max_latency).count());
+            std::cout << format("{:.1f} syncs/s, {:.2f} segments created/s, {:.2f} segments destroyed/s\n",
+                    res.syncs / seconds, res.segments_created / seconds, res.segments_destroyed / seconds);
+        });
+    });
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "seastar/include/seastar/testing/perf_tests.hh"
+
+#include "cql3/expr/expression.hh"
+#include "cql3/query_options.hh"
+#include "cql3/selection/selection.hh"
+#include "schema_builder.hh"
+
+using namespace cql3::expr;
+
+// Checks a filtering restriction on the regular columns of a row, the way
+// restrictions_filter does for every row a query with ALLOW FILTERING reads,
+// with and without the restriction folded by fold_constants() first.
+class expr_filter {
+public:
+    static constexpr size_t count = 1000;
+private:
+    schema_ptr _schema = schema_builder("ks", "cf")
+            .with_column("pk", int32_type, column_kind::partition_key)
+            .with_column("ck", int32_type, column_kind::clustering_key)
+            .with_column("v1", int32_type)
+            .with_column("v2", utf8_type)
+            .build();
+    const column_definition& _v1 = *_schema->get_column_definition(to_bytes("v1"));
+    const column_definition& _v2 = *_schema->get_column_definition(to_bytes("v2"));
+    ::shared_ptr<cql3::selection::selection> _selection = cql3::selection::selection::for_columns(_schema, {&_v1, &_v2});
+    cql3::query_options _options{std::vector<cql3::raw_value>{
+        cql3::raw_value::make_value(int32_type->decompose(int32_t(count / 2))),
+        cql3::raw_value::make_value(utf8_type->decompose("value")),
+    }};
+    expression _restriction = make_conjunction(
+            binary_operator(column_value(&_v1), oper_t::LT,
+                    bind_variable{bind_variable::shape_type::scalar, 0, _v1.column_specification}),
+            binary_operator(column_value(&_v2), oper_t::EQ,
+                    bind_variable{bind_variable::shape_type::scalar, 1, _v2.column_specification}));
+    expression _folded = fold_constants(_restriction, _options);
+    std::vector<bytes> _partition_key{int32_type->decompose(0)};
+    std::vector<bytes> _clustering_key{int32_type->decompose(0)};
+    std::vector<std::vector<managed_bytes_opt>> _rows;
+public:
+    expr_filter() {
+        for (size_t i = 0; i < count; ++i) {
+            _rows.push_back({managed_bytes(int32_type->decompose(int32_t(i))), managed_bytes(utf8_type->decompose("value"))});
+        }
+    }
+
+    size_t filter(const expression& restriction) const {
+        for (auto& row : _rows) {
+            perf_tests::do_not_optimize(is_satisfied_by(restriction, _partition_key, _clustering_key, row, *_selection, _options));
+        }
+        return count;
+    }
+
+    const expression& restriction() const { return _restriction; }
+    const expression& folded() const { return _folded; }
+};
+
+PERF_TEST_F(expr_filter, interpreted) {
+    return filter(restriction());
+}
+
+PERF_TEST_F(expr_filter, folded) {
+    return filter(folded());
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <sys/resource.h>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/distributed.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+
+#include "message/messaging_service.hh"
+#include "locator/snitch_base.hh"
+#include "utils/fb_utilities.hh"
+#include "frozen_mutation.hh"
+#include "query-request.hh"
+#include "query-result.hh"
+#include "schema_builder.hh"
+#include "serializer_impl.hh"
+#include "idl/storage_proxy.dist.hh"
+#include "test/lib/random_utils.hh"
+#include "test/perf/perf.hh"
+
+// Sends storage_proxy verbs over a loopback connection to the node itself,
+// with handlers that do no work, to measure the cost of the messaging
+// layer alone: serialization, compression and the rpc connections.
+// Each shard runs --concurrency senders to its own shard of the node.
+//
+// The write verb is COUNTER_MUTATION, which carries frozen mutations like
+// MUTATION does but gets a response, so it can be timed. The read verb is
+// READ_DATA, whose response carries a query::result of --payload-size bytes.
+
+struct test_config {
+    sstring verb;
+    unsigned duration_in_seconds;
+    unsigned concurrency;
+    size_t payload_size;
+};
+
+struct shard_result {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    std::chrono::microseconds cpu_time{0};
+    latency_histogram latencies;
+    std::chrono::steady_clock::duration max_latency{0};
+};
+
+static shard_result operator+(shard_result a, const shard_result& b) {
+    a.messages += b.messages;
+    a.bytes += b.bytes;
+    a.errors += b.errors;
+    a.cpu_time += b.cpu_time;
+    a.latencies.merge(b.latencies);
+    a.max_latency = std::max(a.max_latency, b.max_latency);
+    return a;
+}
+
+static std::chrono::microseconds thread_cpu_time() {
+    struct rusage ru;
+    ::getrusage(RUSAGE_THREAD, &ru);
+    auto tv = [] (const struct timeval& t) {
+        return std::chrono::seconds(t.tv_sec) + std::chrono::microseconds(t.tv_usec);
+    };
+    return tv(ru.ru_utime) + tv(ru.ru_stime);
+}
+
+static schema_ptr make_schema() {
+    return schema_builder("ks", "cf")
+            .with_column("pk", bytes_type, column_kind::partition_key)
+            .with_column("v", bytes_type)
+            .build();
+}
+
+static void register_handlers(netw::messaging_service& ms, size_t payload_size) {
+    ser::storage_proxy_rpc_verbs::register_counter_mutation(&ms, [] (const rpc::client_info&, rpc::opt_time_point, std::vector<frozen_mutation>, db::consistency_level, std::optional<tracing::trace_info>) {
+        return make_ready_future<>();
+    });
+    ser::storage_proxy_rpc_verbs::register_read_data(&ms, [payload_size] (const rpc::client_info&, rpc::opt_time_point, query::read_command, ::compat::wrapping_partition_range, rpc::optional<query::digest_algorithm>) {
+        bytes_ostream out;
+        out.write(tests::random::get_bytes(payload_size));
+        auto res = make_lw_shared<query::result>(std::move(out), query::short_read::no, 1, 1, 0);
+        return make_ready_future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>(
+                rpc::tuple(make_foreign(std::move(res)), cache_temperature(1.0f)));
+    });
+}
+
+static future<shard_result> run_shard(netw::messaging_service& ms, const test_config& cfg) {
+    return seastar::async([&ms, &cfg] {
+        using clk = std::chrono::steady_clock;
+
+        auto s = make_schema();
+        auto addr = netw::msg_addr{utils::fb_utilities::get_broadcast_address(), this_shard_id(), smp::count};
+        const auto timeout = [] { return db::timeout_clock::now() + std::chrono::seconds(10); };
+
+        mutation m(s, partition_key::from_single_value(*s, tests::random::get_bytes(16)));
+        m.set_clustered_cell(clustering_key::make_empty(), to_bytes("v"), data_value(tests::random::get_bytes(cfg.payload_size)), api::new_timestamp());
+        const std::vector<frozen_mutation> fms{freeze(m)};
+        const auto write_size = fms.front().representation().size();
+
+        const auto cmd = query::read_command(s->id(), s->version(), s->full_slice(), query::max_result_size(query::result_memory_limiter::unlimited_result_size));
+        const auto pr = ::compat::wrapping_partition_range(dht::partition_range::make_singular(dht::decorate_key(*s, m.key())));
+
+        auto send = [&] () -> future<size_t> {
+            if (cfg.verb == "write") {
+                return ser::storage_proxy_rpc_verbs::send_counter_mutation(&ms, addr, timeout(), fms, db::consistency_level::ONE, std::nullopt).then([write_size] {
+                    return write_size;
+                });
+            }
+            return ser::storage_proxy_rpc_verbs::send_read_data(&ms, addr, timeout(), cmd, pr, query::digest_algorithm::none).then([] (rpc::tuple<query::result, rpc::optional<cache_temperature>> res) {
+                return std::get<0>(res).buf().size();
+            });
+        };
+
+        // Opens the connection, so that its setup isn't measured.
+        send().get();
+
+        shard_result res;
+        const auto cpu_start = thread_cpu_time();
+        const auto end_at = lowres_clock::now() + std::chrono::seconds(cfg.duration_in_seconds);
+        auto idx = boost::irange(0u, cfg.concurrency);
+        parallel_for_each(idx.begin(), idx.end(), [&] (unsigned) {
+            return do_until([end_at] { return lowres_clock::now() >= end_at; }, [&] {
+                auto start = clk::now();
+                return send().then_wrapped([&res, start] (future<size_t> f) {
+                    if (f.failed()) {
+                        f.ignore_ready_future();
+                        ++res.errors;
+                        return;
+                    }
+                    auto latency = clk::now() - start;
+                    ++res.messages;
+                    res.bytes += f.get0();
+                    res.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+                    res.max_latency = std::max(res.max_latency, latency);
+                });
+            });
+        }).get();
+        res.cpu_time = thread_cpu_time() - cpu_start;
+        return res;
+    });
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("verb", bpo::value<sstring>()->default_value("write"), "verb to send: write (COUNTER_MUTATION) or read (READ_DATA)")
+        ("duration", bpo::value<unsigned>()->default_value(10), "test duration in seconds")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "concurrent messages per shard")
+        ("payload-size", bpo::value<size_t>()->default_value(1024), "size in bytes of the mutation value, or of the read result")
+        ("compress", bpo::value<sstring>()->default_value("none"), "internode compression, none or all")
+        ("shard-aware", "open a connection per shard, as internode_shard_aware_connections does")
+        ("listen-address", bpo::value<sstring>()->default_value("127.0.0.1"), "address to listen on and send to")
+        ("port", bpo::value<uint16_t>()->default_value(7000), "port to listen on")
+        ;
+
+    return app.run(argc, argv, [&app] {
+        return seastar::async([&app] {
+            auto& opts = app.configuration();
+            test_config cfg;
+            cfg.verb = opts["verb"].as<sstring>();
+            if (cfg.verb != "write" && cfg.verb != "read") {
+                throw std::invalid_argument(format("Invalid verb: {}", cfg.verb));
+            }
+            cfg.duration_in_seconds = opts["duration"].as<unsigned>();
+            cfg.concurrency = opts["concurrency"].as<unsigned>();
+            cfg.payload_size = opts["payload-size"].as<size_t>();
+
+            netw::messaging_service::config mscfg;
+            mscfg.ip = gms::inet_address(opts["listen-address"].as<sstring>());
+            mscfg.port = opts["port"].as<uint16_t>();
+            auto compress = opts["compress"].as<sstring>();
+            if (compress == "all") {
+                mscfg.compress = netw::messaging_service::compress_what::all;
+            } else if (compress != "none") {
+                throw std::invalid_argument(format("Invalid compression: {}", compress));
+            }
+            mscfg.shard_aware_connections = opts.contains("shard-aware");
+            mscfg.rpc_memory_limit = std::max<size_t>(0.08 * memory::stats().total_memory(), mscfg.rpc_memory_limit);
+
+            netw::messaging_service::scheduling_config scfg;
+            scfg.statement_tenants = {{default_scheduling_group(), "$user"}};
+            scfg.streaming = default_scheduling_group();
+            scfg.gossip = default_scheduling_group();
+
+            utils::fb_utilities::set_broadcast_address(mscfg.ip);
+            utils::fb_utilities::set_broadcast_rpc_address(mscfg.ip);
+            locator::i_endpoint_snitch::create_snitch("SimpleSnitch").get();
+            auto stop_snitch = defer([] { locator::i_endpoint_snitch::stop_snitch().get(); });
+
+            sharded<netw::messaging_service> ms;
+            ms.start(mscfg, scfg, nullptr).get();
+            auto stop_ms = defer([&ms] { ms.stop().get(); });
+            ms.invoke_on_all([&cfg] (netw::messaging_service& ms) {
+                register_handlers(ms, cfg.payload_size);
+            }).get();
+            ms.invoke_on_all(&netw::messaging_service::start_listen).get();
+
+            std::cout << format("Sending {} messages of {} bytes, {} concurrent per shard, for {}s, compression {}{}\n",
+                    cfg.verb, cfg.payload_size, cfg.concurrency, cfg.duration_in_seconds, compress,
+                    mscfg.shard_aware_connections ? ", shard-aware connections" : "");
+
+            auto start = std::chrono::steady_clock::now();
+            auto res = map_reduce(boost::irange(0u, smp::count), [&ms, &cfg] (unsigned shard) {
+                return smp::submit_to(shard, [&ms, &cfg] {
+                    return run_shard(ms.local(), cfg);
+                });
+            }, shard_result(), std::plus<shard_result>()).get0();
+            auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << format("{:.0f} msgs/s, {:.2f} MB/s of payload, {} errors\n",
+                    res.messages / seconds, res.bytes / seconds / (1 << 20), res.errors);
+            std::cout << format("latency: p50 {}us, p99 {}us, p999 {}us, max {}us\n",
+                    res.latencies.quantile(0.5), res.latencies.quantile(0.99), res.latencies.quantile(0.999),
+                    std::chrono::duration_cast<std::chrono::microseconds>(res.max_latency).count());
+            // Both ends run on the same reactors, so this is the cost of sending and receiving a message.
+            std::cout << format("{:.2f}us of CPU per message\n",
+                    res.messages ? double(res.cpu_time.count()) / res.messages : 0.0);
+        });
+    });
+}
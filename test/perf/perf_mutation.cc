@@ -21,9 +21,11 @@ int main(int argc, char* argv[]) {
     namespace bpo = boost::program_options;
     app_template app;
     app.add_options()
-        ("column-count", bpo::value<size_t>()->default_value(1), "column count");
+        ("column-count", bpo::value<size_t>()->default_value(1), "column count")
+        ("range-tombstones", bpo::value<size_t>()->default_value(10000), "number of overlapping range tombstones in the partition of the range deletion test, 0 to skip it");
     return app.run_deprecated(argc, argv, [&] {
         size_t column_count = app.configuration()["column-count"].as<size_t>();
+        size_t range_tombstone_count = app.configuration()["range-tombstones"].as<size_t>();
         auto builder = schema_builder("ks", "cf")
             .with_column("p1", utf8_type, column_kind::partition_key)
             .with_column("c1", int32_type, column_kind::clustering_key);
@@ -49,6 +51,31 @@ int main(int argc, char* argv[]) {
             m.set_clustered_cell(c_key, col, make_atomic_cell(col.type, value));
             mt.apply(std::move(m));
         });
+
+        if (range_tombstone_count) {
+            std::cout << format("Timing range deletions within a partition with {} overlapping range tombstones...\n", range_tombstone_count);
+
+            // Queue-like usage: every deletion covers a window of keys which
+            // overlaps the previous ones, with a newer timestamp.
+            const int32_t window = 100;
+            auto ckey = [&] (int32_t v) {
+                return clustering_key::from_exploded(*s, {int32_type->decompose(v)});
+            };
+            auto delete_range = [&] (int32_t start, api::timestamp_type ts) {
+                mutation m(s, key);
+                m.partition().apply_delete(*s, range_tombstone(ckey(start), bound_kind::incl_start,
+                        ckey(start + window), bound_kind::excl_end, tombstone(ts, gc_clock::now())));
+                mt.apply(std::move(m));
+            };
+            api::timestamp_type ts = 0;
+            for (size_t i = 0; i < range_tombstone_count; ++i) {
+                delete_range(int32_t(std::rand() % (range_tombstone_count * 2)), ++ts);
+            }
+
+            time_it([&] {
+                delete_range(int32_t(std::rand() % (range_tombstone_count * 2)), ++ts);
+            });
+        }
         engine().exit(0);
     });
 }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "seastar/include/seastar/testing/perf_tests.hh"
+#include <seastar/testing/test_runner.hh>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "utils/compact-radix-tree.hh"
+
+// Looks up keys in trees shaped like the cells array of a row, whose keys
+// are column ids. Sparse trees are made of the indirect nodes, which are
+// searched with the array_search helpers, dense ones of the direct nodes.
+
+template <unsigned Count, unsigned Stride>
+class radix_tree_fixture {
+public:
+    static constexpr unsigned lookups = 1000;
+private:
+    compact_radix_tree::tree<unsigned long> _tree;
+    std::vector<unsigned> _keys;
+public:
+    radix_tree_fixture() {
+        for (unsigned i = 0; i < Count; i++) {
+            _tree.emplace(i * Stride, i);
+        }
+        auto eng = seastar::testing::local_random_engine;
+        auto dist = std::uniform_int_distribution<unsigned>(0, Count * Stride);
+        _keys.resize(lookups);
+        std::generate(_keys.begin(), _keys.end(), [&] { return dist(eng); });
+    }
+    const compact_radix_tree::tree<unsigned long>& tree() const { return _tree; }
+    const std::vector<unsigned>& keys() const { return _keys; }
+};
+
+using sparse_small = radix_tree_fixture<6, 5>;
+using sparse_large = radix_tree_fixture<30, 4>;
+using dense = radix_tree_fixture<100, 1>;
+
+#define RADIX_TREE_PERF_TESTS(fixture) \
+PERF_TEST_F(fixture, get) { \
+    for (auto k : keys()) { \
+        perf_tests::do_not_optimize(tree().get(k)); \
+    } \
+    return lookups; \
+} \
+PERF_TEST_F(fixture, lower_bound) { \
+    for (auto k : keys()) { \
+        perf_tests::do_not_optimize(tree().lower_bound(k)); \
+    } \
+    return lookups; \
+}
+
+RADIX_TREE_PERF_TESTS(sparse_small)
+RADIX_TREE_PERF_TESTS(sparse_large)
+RADIX_TREE_PERF_TESTS(dense)
@@ -59,7 +59,7 @@ static void execute_counter_update_for_key(cql_test_env& env, const bytes& key)
 };
 
 struct test_config {
-    enum class run_mode { read, write, del };
+    enum class run_mode { read, write, del, mixed };
     enum class frontend_type { cql, alternator };
 
     run_mode mode;
@@ -71,6 +71,10 @@ struct test_config {
     bool counters;
     bool flush_memtables;
     unsigned operations_per_shard = 0;
+    // Total operations per second of an open-loop test, 0 for a closed loop.
+    double rate = 0;
+    // Fraction of writes among the operations of a mixed test.
+    double write_ratio = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
@@ -78,6 +82,7 @@ std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
         case test_config::run_mode::write: return os << "write";
         case test_config::run_mode::read: return os << "read";
         case test_config::run_mode::del: return os << "delete";
+        case test_config::run_mode::mixed: return os << "mixed";
     }
     abort();
 }
@@ -97,6 +102,8 @@ std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
            << ", frontend=" << cfg.frontend
            << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
            << ", counters=" << (cfg.counters ? "yes" : "no")
+           << ", rate=" << cfg.rate
+           << ", write_ratio=" << cfg.write_ratio
            << "}";
 }
 
@@ -124,50 +131,75 @@ static bytes make_random_key(test_config& cfg) {
     return make_key(make_random_seq(cfg));
 }
 
-static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
-    create_partitions(env, cfg);
-    auto id = env.prepare("select \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" from cf where \"KEY\" = ?").get0();
-    return time_parallel([&env, &cfg, id] {
-            bytes key = make_random_key(cfg);
-            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+template <typename Func>
+static std::vector<perf_result> run_test(Func func, const test_config& cfg) {
+    if (cfg.rate) {
+        return time_parallel_rate(std::move(func), cfg.rate / smp::count, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+    }
+    return time_parallel(std::move(func), cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
 }
 
-static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
-    auto id = env.prepare("UPDATE cf SET "
+static const char* const read_query = "select \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" from cf where \"KEY\" = ?";
+
+static const char* const write_query = "UPDATE cf SET "
                            "\"C0\" = 0x8f75da6b3dcec90c8a404fb9a5f6b0621e62d39c69ba5758e5f41b78311fbb26cc7a,"
                            "\"C1\" = 0xa8761a2127160003033a8f4f3d1069b7833ebe24ef56b3beee728c2b686ca516fa51,"
                            "\"C2\" = 0x583449ce81bfebc2e1a695eb59aad5fcc74d6d7311fc6197b10693e1a161ca2e1c64,"
                            "\"C3\" = 0x62bcb1dbc0ff953abc703bcb63ea954f437064c0c45366799658bd6b91d0f92908d7,"
                            "\"C4\" = 0x222fcbe31ffa1e689540e1499b87fa3f9c781065fccd10e4772b4c7039c2efd0fb27 "
-                           "WHERE \"KEY\" = ?;").get0();
-    return time_parallel([&env, &cfg, id] {
+                           "WHERE \"KEY\" = ?;";
+
+static const char* const counter_update_query = "UPDATE cf SET "
+                           "\"C0\" = \"C0\" + 1,"
+                           "\"C1\" = \"C1\" + 2,"
+                           "\"C2\" = \"C2\" + 3,"
+                           "\"C3\" = \"C3\" + 4,"
+                           "\"C4\" = \"C4\" + 5 "
+                           "WHERE \"KEY\" = ?;";
+
+static std::vector<perf_result> test_read(cql_test_env& env, test_config& cfg) {
+    create_partitions(env, cfg);
+    auto id = env.prepare(read_query).get0();
+    return run_test([&env, &cfg, id] {
+            bytes key = make_random_key(cfg);
+            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
+        }, cfg);
+}
+
+static std::vector<perf_result> test_write(cql_test_env& env, test_config& cfg) {
+    auto id = env.prepare(write_query).get0();
+    return run_test([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+        }, cfg);
 }
 
 static std::vector<perf_result> test_delete(cql_test_env& env, test_config& cfg) {
     create_partitions(env, cfg);
     auto id = env.prepare("DELETE \"C0\", \"C1\", \"C2\", \"C3\", \"C4\" FROM cf WHERE \"KEY\" = ?").get0();
-    return time_parallel([&env, &cfg, id] {
+    return run_test([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+        }, cfg);
 }
 
 static std::vector<perf_result> test_counter_update(cql_test_env& env, test_config& cfg) {
-    auto id = env.prepare("UPDATE cf SET "
-                           "\"C0\" = \"C0\" + 1,"
-                           "\"C1\" = \"C1\" + 2,"
-                           "\"C2\" = \"C2\" + 3,"
-                           "\"C3\" = \"C3\" + 4,"
-                           "\"C4\" = \"C4\" + 5 "
-                           "WHERE \"KEY\" = ?;").get0();
-    return time_parallel([&env, &cfg, id] {
+    auto id = env.prepare(counter_update_query).get0();
+    return run_test([&env, &cfg, id] {
             bytes key = make_random_key(cfg);
             return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
-        }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+        }, cfg);
+}
+
+static std::vector<perf_result> test_mixed(cql_test_env& env, test_config& cfg) {
+    create_partitions(env, cfg);
+    auto read_id = env.prepare(read_query).get0();
+    auto write_id = env.prepare(cfg.counters ? counter_update_query : write_query).get0();
+    return run_test([&env, &cfg, read_id, write_id] {
+            bytes key = make_random_key(cfg);
+            auto id = tests::random::get_real<double>(1) < cfg.write_ratio ? write_id : read_id;
+            return env.execute_prepared(id, {{cql3::raw_value::make_value(std::move(key))}}).discard_result();
+        }, cfg);
 }
 
 static schema_ptr make_counter_schema(std::string_view ks_name) {
@@ -271,7 +303,7 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
                 "ReturnConsumedCapacity": "TOTAL"
             }
         )";
-    return time_parallel([&] {
+    return run_test([&] {
         auto key = std::to_string(make_random_seq(cfg));
         // Chunked content is used to minimize string copying, and thus extra allocations
         rjson::chunked_content content;
@@ -280,11 +312,11 @@ static std::vector<perf_result> test_alternator_read(service::client_state& stat
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.get_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+    }, cfg);
 }
 
 static std::vector<perf_result> test_alternator_write(service::client_state& state, alternator::executor& executor, test_config& cfg) {
-    return time_parallel([&] {
+    return run_test([&] {
         std::string prefix = R"(
             {
                 "TableName": "alternator_table",
@@ -323,13 +355,13 @@ static std::vector<perf_result> test_alternator_write(service::client_state& sta
         content.emplace_back(key.data(), key.size(), deleter{});
         content.emplace_back(postfix.data(), postfix.size(), deleter{});
         return executor.update_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(std::move(content))).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+    }, cfg);
 }
 
 static std::vector<perf_result> test_alternator_delete(service::client_state& state, noncopyable_function<void()> flush_memtables,
         alternator::executor& executor, test_config& cfg) {
     create_alternator_partitions(state, std::move(flush_memtables), executor, cfg);
-    return time_parallel([&] {
+    return run_test([&] {
         std::string json = R"(
             {
                 "TableName": "alternator_table",
@@ -342,7 +374,7 @@ static std::vector<perf_result> test_alternator_delete(service::client_state& st
             }
         )";
         return executor.delete_item(state, tracing::trace_state_ptr(), empty_service_permit(), rjson::parse(json)).discard_result();
-    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard);
+    }, cfg);
 }
 
 static std::vector<perf_result> do_alternator_test(std::string isolation_level,
@@ -374,6 +406,8 @@ static std::vector<perf_result> do_alternator_test(std::string isolation_level,
             return test_alternator_write(state, executor, cfg);
         case test_config::run_mode::del:
             return test_alternator_delete(state, std::move(flush_memtables), executor, cfg);
+        case test_config::run_mode::mixed:
+            throw std::runtime_error("mixed workloads are not supported with alternator");
         };
     } catch (const alternator::api_error& e) {
         std::cout << "Alternator API error: " << e._msg << std::endl;
@@ -411,6 +445,8 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
         }
     case test_config::run_mode::del:
         return test_delete(env, cfg);
+    case test_config::run_mode::mixed:
+        return test_mixed(env, cfg);
     };
     abort();
 }
@@ -423,6 +459,8 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     params["partitions"] = cfg.partitions;
     params["cpus"] = smp::count;
     params["duration"] = cfg.duration_in_seconds;
+    params["rate"] = cfg.rate;
+    params["write_ratio"] = cfg.write_ratio;
     params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
     results["parameters"] = std::move(params);
 
@@ -434,6 +472,12 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     stats["mad tps"] = mad;
     stats["max tps"] = max;
     stats["min tps"] = min;
+    if (cfg.rate) {
+        stats["latency p50 us"] = median.latency_p50;
+        stats["latency p99 us"] = median.latency_p99;
+        stats["latency p999 us"] = median.latency_p999;
+        stats["latency max us"] = median.latency_max;
+    }
     results["stats"] = std::move(stats);
 
     std::string test_type;
@@ -441,6 +485,7 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     case test_config::run_mode::read: test_type = "read"; break;
     case test_config::run_mode::write: test_type = "write"; break;
     case test_config::run_mode::del: test_type = "delete"; break;
+    case test_config::run_mode::mixed: test_type = "mixed"; break;
     }
     if (cfg.counters) {
         test_type += "_counters";
@@ -483,7 +528,9 @@ int main(int argc, char** argv) {
         ("delete", "test delete path instead of read path")
         ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
         ("query-single-key", "test reading with a single key instead of random keys")
-        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core")
+        ("concurrency", bpo::value<unsigned>()->default_value(100), "workers per core, or operations in flight per core with --rate")
+        ("rate", bpo::value<double>(), "start this many operations per second in total, without waiting for earlier ones to complete, and report their latencies")
+        ("write-ratio", bpo::value<double>(), "test a mix of reads and writes, with this fraction of writes")
         ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
         ("counters", "test counters")
         ("flush", "flush memtables before test")
@@ -522,6 +569,9 @@ int main(int argc, char** argv) {
                 cfg.mode = test_config::run_mode::write;
             } else if (app.configuration().contains("delete")) {
                 cfg.mode = test_config::run_mode::del;
+            } else if (app.configuration().contains("write-ratio")) {
+                cfg.mode = test_config::run_mode::mixed;
+                cfg.write_ratio = app.configuration()["write-ratio"].as<double>();
             } else {
                 cfg.mode = test_config::run_mode::read;
             };
@@ -533,6 +583,12 @@ int main(int argc, char** argv) {
             if (app.configuration().contains("operations-per-shard")) {
                 cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
             }
+            if (app.configuration().contains("rate")) {
+                cfg.rate = app.configuration()["rate"].as<double>();
+                if (cfg.rate <= 0) {
+                    throw std::invalid_argument("--rate must be positive");
+                }
+            }
             auto results = cfg.frontend == test_config::frontend_type::cql
                     ? do_cql_test(env, cfg)
                     : do_alternator_test(app.configuration()["alternator"].as<std::string>(),
@@ -37,10 +37,25 @@ future<> test_write(distributed<perf_sstable_test_env>& dt) {
 future<> test_compaction(distributed<perf_sstable_test_env>& dt) {
     return seastar::async([&dt] {
         dt.invoke_on_all([] (perf_sstable_test_env &t) {
-            return t.fill_memtable();
+            return t.fill_compaction_memtables();
         }).then([&dt] {
             return time_runs(iterations, parallelism, dt, &perf_sstable_test_env::compaction);
         }).get();
+
+        auto stats = dt.map_reduce0([] (perf_sstable_test_env& t) {
+            return t.get_compaction_stats();
+        }, perf_sstable_test_env::compaction_stats(), [] (auto a, const auto& b) {
+            return a += b;
+        }).get0();
+        // The shards compact in parallel, so their throughputs add up.
+        auto seconds = stats.seconds / smp::count;
+        std::cout << format("{:.2f} MB/s of input data, {:.0f} cycles/partition, {:.0f} instructions/partition, "
+                "{:.1f} allocations/fragment, output/input size on disk: {:.2f}\n",
+                stats.input_data_bytes / seconds / (1 << 20),
+                double(stats.cycles) / stats.partitions,
+                double(stats.instructions) / stats.partitions,
+                double(stats.allocations) / stats.fragments,
+                double(stats.output_disk_bytes) / stats.input_disk_bytes);
     });
 }
 
@@ -84,7 +99,10 @@ int main(int argc, char** argv) {
         ("testdir", bpo::value<sstring>()->default_value("/var/lib/scylla/perf-tests"), "directory in which to store the sstables")
         ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to use, one of "
              "(SizeTieredCompactionStrategy, LeveledCompactionStrategy, DateTieredCompactionStrategy, TimeWindowCompactionStrategy)")
-        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]");
+        ("timestamp-range", bpo::value<api::timestamp_type>()->default_value(0), "Timestamp values to use, chosen uniformly from: [-x, +x]")
+        ("overlap", bpo::value<double>()->default_value(1), "fraction of each sstable's partitions present in all sstables (valid only for compaction mode)")
+        ("tombstone-ratio", bpo::value<double>()->default_value(0), "fraction of partitions written as partition tombstones (valid only for compaction mode)")
+        ("compression", bpo::value<sstring>()->default_value(""), "sstable compressor class, or none (default: the default compressor)");
 
     return app.run_deprecated(argc, argv, [&app] {
         auto test = make_lw_shared<distributed<perf_sstable_test_env>>();
@@ -108,6 +126,9 @@ int main(int argc, char** argv) {
         }
         cfg.compaction_strategy = sstables::compaction_strategy::type(app.configuration()["compaction-strategy"].as<sstring>());
         cfg.timestamp_range = app.configuration()["timestamp-range"].as<api::timestamp_type>();
+        cfg.overlap = app.configuration()["overlap"].as<double>();
+        cfg.tombstone_ratio = app.configuration()["tombstone-ratio"].as<double>();
+        cfg.compression = app.configuration()["compression"].as<sstring>();
         return test->start(std::move(cfg)).then([mode, dir, test] {
             engine().at_exit([test] { return test->stop(); });
             if ((mode == test_modes::index_read) ||
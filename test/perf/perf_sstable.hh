@@ -18,6 +18,9 @@
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/test_services.hh"
 #include "test/lib/random_utils.hh"
+#include "utils/linux-perf-event.hh"
+#include <seastar/core/memory.hh>
+#include <seastar/core/thread.hh>
 #include <boost/accumulators/framework/accumulator_set.hpp>
 #include <boost/accumulators/framework/features.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -40,6 +43,39 @@ class perf_sstable_test_env {
         sstring dir;
         sstables::compaction_strategy_type compaction_strategy;
         api::timestamp_type timestamp_range;
+        // Compaction mode only: the fraction of each sstable's partitions
+        // that are also in all the other sstables, and the fraction of
+        // partitions written as partition tombstones.
+        double overlap = 1;
+        double tombstone_ratio = 0;
+        // A compressor class name, "none", or empty for the default one.
+        sstring compression;
+    };
+
+    // Accumulated over the compaction runs of a shard.
+    struct compaction_stats {
+        uint64_t input_data_bytes = 0;
+        uint64_t input_disk_bytes = 0;
+        uint64_t output_disk_bytes = 0;
+        uint64_t partitions = 0;
+        uint64_t fragments = 0;
+        uint64_t allocations = 0;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        double seconds = 0;
+
+        compaction_stats& operator+=(const compaction_stats& o) {
+            input_data_bytes += o.input_data_bytes;
+            input_disk_bytes += o.input_disk_bytes;
+            output_disk_bytes += o.output_disk_bytes;
+            partitions += o.partitions;
+            fragments += o.fragments;
+            allocations += o.allocations;
+            cycles += o.cycles;
+            instructions += o.instructions;
+            seconds += o.seconds;
+            return *this;
+        }
     };
 
 private:
@@ -69,6 +105,11 @@ class perf_sstable_test_env {
     std::uniform_int_distribution<char> _distribution;
     lw_shared_ptr<replica::memtable> _mt;
     std::vector<shared_sstable> _sst;
+    // Compaction mode: one memtable per input sstable, and the number of
+    // fragments they hold.
+    std::vector<lw_shared_ptr<replica::memtable>> _compaction_mts;
+    uint64_t _compaction_fragments = 0;
+    compaction_stats _compaction_stats;
 
     schema_ptr create_schema(sstables::compaction_strategy_type type) {
         std::vector<schema::column> columns;
@@ -92,6 +133,11 @@ class perf_sstable_test_env {
             "Perf tests"
         ));
         builder.set_compaction_strategy(type);
+        if (_cfg.compression == "none") {
+            builder.set_compressor_params(compression_parameters::no_compression());
+        } else if (!_cfg.compression.empty()) {
+            builder.set_compressor_params(compression_parameters({{compression_parameters::SSTABLE_COMPRESSION, _cfg.compression}}));
+        }
         return builder.build(schema_builder::compact_storage::no);
     }
 
@@ -107,21 +153,65 @@ class perf_sstable_test_env {
         return _env.stop();
     }
 
+    api::timestamp_type random_timestamp() {
+        return _cfg.timestamp_range ? tests::random::get_int<api::timestamp_type>(-_cfg.timestamp_range, _cfg.timestamp_range) : 0;
+    }
+
+    mutation make_mutation(const sstring& key) {
+        auto mut = mutation(s, partition_key::from_deeply_exploded(*s, { key }));
+        for (auto& cdef: s->regular_columns()) {
+            mut.set_clustered_cell(clustering_key::make_empty(), cdef, atomic_cell::make_live(*utf8_type, random_timestamp(), utf8_type->decompose(random_column())));
+        }
+        return mut;
+    }
+
     future<> fill_memtable() {
         auto idx = boost::irange(0, int(_cfg.partitions / _cfg.sstables));
         auto local_keys = make_local_keys(int(_cfg.partitions / _cfg.sstables), s, _cfg.key_size);
         return do_for_each(idx.begin(), idx.end(), [this, local_keys = std::move(local_keys)] (auto iteration) {
-            auto key = partition_key::from_deeply_exploded(*s, { local_keys.at(iteration) });
-            auto mut = mutation(this->s, key);
-            for (auto& cdef: this->s->regular_columns()) {
-                const auto ts = _cfg.timestamp_range ? tests::random::get_int<api::timestamp_type>(-_cfg.timestamp_range, _cfg.timestamp_range) : 0;
-                mut.set_clustered_cell(clustering_key::make_empty(), cdef, atomic_cell::make_live(*utf8_type, ts, utf8_type->decompose(this->random_column())));
-            }
-            this->_mt->apply(std::move(mut));
+            this->_mt->apply(make_mutation(local_keys.at(iteration)));
             return make_ready_future<>();
         });
     }
 
+    // Fills one memtable for each sstable to compact, with partitions / sstables
+    // partitions each. The first overlap of them have the same keys in all
+    // memtables, the others are only in one memtable.
+    future<> fill_compaction_memtables() {
+        return seastar::async([this] {
+            const unsigned per_sstable = _cfg.partitions / _cfg.sstables;
+            const unsigned shared = per_sstable * _cfg.overlap;
+            const unsigned unique = per_sstable - shared;
+            const auto local_keys = make_local_keys(shared + unique * _cfg.sstables, s, _cfg.key_size);
+            for (unsigned i = 0; i < _cfg.sstables; ++i) {
+                auto mt = make_lw_shared<replica::memtable>(s);
+                auto add = [&] (const sstring& key) {
+                    if (tests::random::get_real<double>(1) < _cfg.tombstone_ratio) {
+                        auto mut = mutation(s, partition_key::from_deeply_exploded(*s, { key }));
+                        mut.partition().apply(tombstone(random_timestamp(), gc_clock::now()));
+                        mt->apply(std::move(mut));
+                        _compaction_fragments += 2;
+                    } else {
+                        mt->apply(make_mutation(key));
+                        _compaction_fragments += 3;
+                    }
+                    thread::maybe_yield();
+                };
+                for (unsigned k = 0; k < shared; ++k) {
+                    add(local_keys[k]);
+                }
+                for (unsigned k = 0; k < unique; ++k) {
+                    add(local_keys[shared + i * unique + k]);
+                }
+                _compaction_mts.push_back(std::move(mt));
+            }
+        });
+    }
+
+    const compaction_stats& get_compaction_stats() const {
+        return _compaction_stats;
+    }
+
     future<> load_sstables(unsigned iterations) {
         _sst.push_back(_env.make_sstable(s, this->dir(), 0, sstables::get_highest_sstable_version(), sstable::format_types::big));
         return _sst.back()->load();
@@ -159,12 +249,16 @@ class perf_sstable_test_env {
                     return _env.make_sstable(s, dir(), (*gen)++, sstables::get_highest_sstable_version(), sstable::format_types::big, _cfg.buffer_size);
                 };
 
+                compaction_stats stats;
                 std::vector<shared_sstable> ssts;
                 for (auto i = 0u; i < _cfg.sstables; i++) {
                     auto sst = sst_gen();
-                    write_memtable_to_sstable_for_test(*_mt, sst).get();
+                    auto& mt = *_compaction_mts[i];
+                    write_memtable_to_sstable_for_test(mt, sst).get();
                     sst->open_data().get();
-                    _mt->revert_flushed_memory();
+                    mt.revert_flushed_memory();
+                    stats.input_data_bytes += sst->data_size();
+                    stats.input_disk_bytes += sst->bytes_on_disk();
                     ssts.push_back(std::move(sst));
                 }
 
@@ -173,6 +267,11 @@ class perf_sstable_test_env {
                 auto cm = make_lw_shared<compaction_manager>();
                 auto cf = make_lw_shared<replica::column_family>(s, column_family_test_config(env.manager(), env.semaphore()), replica::column_family::no_commitlog(), *cm, cl_stats, tracker);
 
+                auto cycles = linux_perf_event::user_cpu_cycles();
+                auto instructions = linux_perf_event::user_instructions_retired();
+                const auto allocations = memory::stats().mallocs();
+                cycles.enable();
+                instructions.enable();
                 auto start = perf_sstable_test_env::now();
 
                 auto descriptor = sstables::compaction_descriptor(std::move(ssts), cf->get_sstable_set(), default_priority_class());
@@ -183,6 +282,11 @@ class perf_sstable_test_env {
                 auto cdata = compaction_manager::create_compaction_data();
                 auto ret = sstables::compact_sstables(std::move(descriptor), cdata, cf->as_table_state()).get0();
                 auto end = perf_sstable_test_env::now();
+                cycles.disable();
+                instructions.disable();
+                stats.allocations = memory::stats().mallocs() - allocations;
+                stats.cycles = cycles.read();
+                stats.instructions = instructions.read();
 
                 auto partitions_per_sstable = _cfg.partitions / _cfg.sstables;
                 if (_cfg.compaction_strategy != sstables::compaction_strategy_type::time_window) {
@@ -194,6 +298,13 @@ class perf_sstable_test_env {
                 assert(total_keys_written >= partitions_per_sstable);
 
                 auto duration = std::chrono::duration<double>(end - start).count();
+                for (auto& sst : ret.new_sstables) {
+                    stats.output_disk_bytes += sst->bytes_on_disk();
+                }
+                stats.partitions = total_keys_written;
+                stats.fragments = _compaction_fragments;
+                stats.seconds = duration;
+                _compaction_stats += stats;
                 return total_keys_written / duration;
             });
         });
@@ -2270,3 +2270,40 @@ BOOST_AUTO_TEST_CASE(test_append_entry_inside_snapshot) {
     communicate(A, B, C);
     BOOST_CHECK(!C.get_log().empty());
 }
+
+BOOST_AUTO_TEST_CASE(test_max_append_requests_in_flight) {
+    server_id id1 = id(), id2 = id();
+    raft::configuration cfg({id1, id2});
+    raft::log log{raft::snapshot_descriptor{.config = cfg}};
+
+    // One entry per request, at most two requests un-acked
+    raft::fsm_config fsm_cfg_window{.append_request_threshold = 1, .max_append_requests_in_flight = 2};
+    fsm_debug fsm(id1, term_t{}, server_id{}, std::move(log), trivial_failure_detector, fsm_cfg_window);
+
+    election_timeout(fsm);
+    auto output = fsm.get_output();
+    auto current_term = output.term_and_vote->first;
+    fsm.step(id2, raft::vote_reply{current_term, true});
+    BOOST_CHECK(fsm.is_leader());
+
+    for (auto i = 0; i < 5; ++i) {
+        fsm.add_entry(create_command(i));
+    }
+    output = fsm.get_output();
+    // The follower is probed with the leader's dummy entry first
+    BOOST_CHECK_EQUAL(output.messages.size(), 1);
+    auto msg = std::get<raft::append_request>(output.messages.back().second);
+    auto idx = msg.entries.back()->idx;
+
+    fsm.step(id2, raft::append_reply{msg.current_term, idx, raft::append_reply::accepted{idx}});
+    BOOST_CHECK(fsm.get_progress(id2).state == raft::follower_progress::state::PIPELINE);
+    output = fsm.get_output();
+    BOOST_CHECK_EQUAL(output.messages.size(), 2);
+
+    // Each ack lets one more request go
+    msg = std::get<raft::append_request>(output.messages.front().second);
+    idx = msg.entries.back()->idx;
+    fsm.step(id2, raft::append_reply{msg.current_term, idx, raft::append_reply::accepted{idx}});
+    output = fsm.get_output();
+    BOOST_CHECK_EQUAL(output.messages.size(), 1);
+}
@@ -231,3 +231,13 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    keys = [random_string(10) for i in range(3)]
+    vals = [random_string(10) for i in range(3)]
+
+    assert r.mset({keys[0]: vals[0], keys[1]: vals[1]}) == True
+    assert r.mget(keys) == [vals[0], vals[1], None]
+    assert r.mset({keys[1]: vals[2], keys[2]: vals[2]}) == True
+    assert r.mget(keys[2], keys[1], keys[0]) == [vals[2], vals[2], vals[0]]
@@ -152,3 +152,35 @@ def test_storage_service_keyspace_bad_param(cql, this_dc, rest_api):
         resp = rest_api.send("GET", f"storage_service/keyspace_scrub/{keyspace}", { "foo": "bar" })
         assert resp.status_code == requests.codes.bad_request
 
+def test_storage_service_repair_parallelism(rest_api):
+    resp = rest_api.send("GET", "storage_service/repair_parallelism")
+    resp.raise_for_status()
+    orig = resp.json()
+    assert orig["max_ranges_in_parallel"] >= 1
+    assert orig["ranges_in_parallel"] == 0
+
+    # The limit is set for each shard, and reported summed over all shards
+    resp = rest_api.send("POST", "storage_service/repair_parallelism", { "value": "1" })
+    resp.raise_for_status()
+    resp = rest_api.send("GET", "storage_service/repair_parallelism")
+    resp.raise_for_status()
+    shards = resp.json()["max_ranges_in_parallel"]
+    assert shards >= 1
+    assert orig["max_ranges_in_parallel"] % shards == 0
+
+    try:
+        resp = rest_api.send("POST", "storage_service/repair_parallelism", { "value": "0" })
+        assert resp.status_code == requests.codes.bad_request
+        resp = rest_api.send("POST", "storage_service/repair_parallelism", { "value": "XXX" })
+        assert resp.status_code == requests.codes.bad_request
+    finally:
+        resp = rest_api.send("POST", "storage_service/repair_parallelism", { "value": str(orig["max_ranges_in_parallel"] // shards) })
+        resp.raise_for_status()
+
+def test_storage_service_load_and_stream_progress(rest_api):
+    resp = rest_api.send("GET", "storage_service/load_and_stream_progress")
+    resp.raise_for_status()
+    progress = resp.json()
+    assert progress["sstables_streamed"] <= progress["sstables_total"]
+    assert progress["partitions_streamed"] >= 0
+    assert progress["eta"] >= -1
@@ -603,8 +603,7 @@ class thrift_handler : public CassandraCobSvIf {
             return parallel_for_each(std::move(p.second), [this](auto&& schema) {
                 return _query_state.get_client_state().has_schema_access(_db, *schema, auth::permission::MODIFY);
             }).then([this, muts = std::move(p.first), consistency_level, permit = std::move(permit)] () mutable {
-                auto timeout = db::timeout_clock::now() + _timeout_config.write_timeout;
-                return _proxy.local().mutate(std::move(muts), cl_from_thrift(consistency_level), timeout, nullptr, std::move(permit));
+                return apply_batch(std::move(muts), consistency_level, false, std::move(permit));
             });
         });
     }
@@ -616,8 +615,7 @@ class thrift_handler : public CassandraCobSvIf {
             return parallel_for_each(std::move(p.second), [this](auto&& schema) {
                 return _query_state.get_client_state().has_schema_access(_db, *schema, auth::permission::MODIFY);
             }).then([this, muts = std::move(p.first), consistency_level, permit = std::move(permit)] () mutable {
-                auto timeout = db::timeout_clock::now() + _timeout_config.write_timeout;
-                return _proxy.local().mutate_atomically(std::move(muts), cl_from_thrift(consistency_level), timeout, nullptr, std::move(permit));
+                return apply_batch(std::move(muts), consistency_level, true, std::move(permit));
             });
         });
     }
@@ -2006,30 +2004,25 @@ class thrift_handler : public CassandraCobSvIf {
         }
     }
     using mutation_map = std::map<std::string, std::map<std::string, std::vector<Mutation>>>;
-    using mutation_map_by_cf = std::unordered_map<std::string, std::unordered_map<std::string, std::vector<Mutation>>>;
-    static mutation_map_by_cf group_by_cf(mutation_map& m) {
-        mutation_map_by_cf ret;
-        for (auto&& key_cf : m) {
-            for (auto&& cf_mutations : key_cf.second) {
-                auto& mutations = ret[std::move(cf_mutations.first)][std::move(key_cf.first)];
-                std::move(cf_mutations.second.begin(), cf_mutations.second.end(), std::back_inserter(mutations));
-            }
-        }
-        return ret;
-    }
+    // The map holds a single entry per key and column family, so each
+    // yields exactly one mutation, with all of its changes merged.
     static std::pair<std::vector<mutation>, std::vector<schema_ptr>> prepare_mutations(data_dictionary::database db, const sstring& ks_name, const mutation_map& m) {
         std::vector<mutation> muts;
         std::vector<schema_ptr> schemas;
-        auto m_by_cf = group_by_cf(const_cast<mutation_map&>(m));
-        for (auto&& cf_key : m_by_cf) {
-            auto schema = lookup_schema(db, ks_name, cf_key.first);
-            if (schema->is_view()) {
-                throw make_exception<InvalidRequestException>("Cannot modify Materialized Views directly");
-            }
-            schemas.emplace_back(schema);
-            for (auto&& key_mutations : cf_key.second) {
-                mutation m_to_apply(schema, key_from_thrift(*schema, to_bytes_view(key_mutations.first)));
-                for (auto&& m : key_mutations.second) {
+        // Batches write many keys of few column families, look each up once.
+        std::unordered_map<std::string_view, schema_ptr> schema_by_cf;
+        for (auto&& [key, mutations_by_cf] : m) {
+            for (auto&& [cf_name, mutations] : mutations_by_cf) {
+                auto& schema = schema_by_cf[cf_name];
+                if (!schema) {
+                    schema = lookup_schema(db, ks_name, cf_name);
+                    if (schema->is_view()) {
+                        throw make_exception<InvalidRequestException>("Cannot modify Materialized Views directly");
+                    }
+                    schemas.emplace_back(schema);
+                }
+                mutation m_to_apply(schema, key_from_thrift(*schema, to_bytes_view(key)));
+                for (auto&& m : mutations) {
                     add_to_mutation(*schema, m, m_to_apply);
                 }
                 muts.emplace_back(std::move(m_to_apply));
@@ -2037,6 +2030,22 @@ class thrift_handler : public CassandraCobSvIf {
         }
         return {std::move(muts), std::move(schemas)};
     }
+    // Applies a batch the way CQL batches are applied: in token order, so
+    // that writes to the same replicas are started back to back, and
+    // invalidating the results cached for the written partitions.
+    future<> apply_batch(std::vector<mutation> muts, const ConsistencyLevel::type consistency_level, bool atomic, service_permit permit) {
+        std::sort(muts.begin(), muts.end(), [] (const mutation& a, const mutation& b) {
+            return a.token() < b.token();
+        });
+        auto cached = cql3::result_cache::cached_partitions(muts);
+        auto timeout = db::timeout_clock::now() + _timeout_config.write_timeout;
+        auto f = atomic
+                ? _proxy.local().mutate_atomically(std::move(muts), cl_from_thrift(consistency_level), timeout, nullptr, std::move(permit))
+                : _proxy.local().mutate(std::move(muts), cl_from_thrift(consistency_level), timeout, nullptr, std::move(permit));
+        return f.finally([this, cached = std::move(cached)] () mutable {
+            return _query_processor.local().invalidate_cached_results(std::move(cached));
+        });
+    }
 protected:
     service_permit obtain_permit() {
         return std::move(_current_permit);
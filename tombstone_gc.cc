@@ -157,6 +157,22 @@ void update_repair_time(schema_ptr s, const dht::token_range& range, gc_clock::t
     m->map += std::make_pair(locator::token_metadata::range_to_interval(range), repair_time);
 }
 
+gc_clock::time_point get_repair_time_for_range(schema_ptr s, const dht::token_range& range) {
+    auto m = get_repair_history_map_for_table(s->id());
+    if (!m) {
+        return gc_clock::time_point::min();
+    }
+    auto interval = locator::token_metadata::range_to_interval(range);
+    if (!boost::icl::contains(m->map, interval)) {
+        return gc_clock::time_point::min();
+    }
+    auto repair_time = gc_clock::time_point::max();
+    for (auto& x : boost::make_iterator_range(m->map.equal_range(interval))) {
+        repair_time = std::min(repair_time, x.second);
+    }
+    return repair_time;
+}
+
 static bool needs_repair_before_gc(const replica::database& db, sstring ks_name) {
     // If a table uses local replication strategy or rf one, there is no
     // need to run repair even if tombstone_gc mode = repair.
@@ -35,4 +35,9 @@ gc_clock::time_point get_gc_before_for_key(schema_ptr s, const dht::decorated_ke
 
 void update_repair_time(schema_ptr s, const dht::token_range& range, gc_clock::time_point repair_time);
 
+// Returns the oldest repair time of the tokens in the range, as recorded in
+// the repair history. Returns gc_clock::time_point::min() if some token in the
+// range was never repaired.
+gc_clock::time_point get_repair_time_for_range(schema_ptr s, const dht::token_range& range);
+
 void validate_tombstone_gc_options(const tombstone_gc_options* options, const replica::database& db, sstring ks_name);
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <atomic>
+#include <bit>
 #include <boost/algorithm/string/join.hpp>
 #include <filesystem>
 #include <fmt/chrono.h>
@@ -758,6 +760,204 @@ class writetime_histogram_collecting_consumer : public sstable_consumer {
     }
 };
 
+// Histogram with power of two buckets: bucket 0 counts the zeros, bucket n
+// the values in [2^(n-1), 2^n).
+class log2_histogram {
+    std::array<uint64_t, 65> _buckets{};
+public:
+    void add(uint64_t v) {
+        ++_buckets[std::bit_width(v)];
+    }
+    log2_histogram& operator+=(const log2_histogram& o) {
+        for (size_t b = 0; b < _buckets.size(); ++b) {
+            _buckets[b] += o._buckets[b];
+        }
+        return *this;
+    }
+    // Writes the non-empty buckets, keyed by their lower bound.
+    void write(json_writer& writer) const {
+        writer.StartObject();
+        for (size_t b = 0; b < _buckets.size(); ++b) {
+            if (_buckets[b]) {
+                writer.Key(fmt::format("{}", b ? uint64_t(1) << (b - 1) : 0));
+                writer.Uint64(_buckets[b]);
+            }
+        }
+        writer.EndObject();
+    }
+};
+
+struct sstable_analysis {
+    uint64_t partitions = 0;
+    uint64_t rows = 0;
+    uint64_t live_cells = 0;
+    uint64_t expiring_cells = 0;
+    uint64_t dead_cells = 0;
+    uint64_t partition_tombstones = 0;
+    uint64_t row_tombstones = 0;
+    uint64_t range_tombstone_changes = 0;
+    uint64_t collection_tombstones = 0;
+    // Bytes of the keys and cell values of the partition.
+    log2_histogram partition_size;
+    log2_histogram partition_rows;
+    // Tombstones of all kinds, including dead cells, in the partition.
+    log2_histogram partition_tombstone_count;
+    // TTL of expiring cells and row markers, in seconds.
+    log2_histogram ttl;
+
+    sstable_analysis& operator+=(const sstable_analysis& o) {
+        partitions += o.partitions;
+        rows += o.rows;
+        live_cells += o.live_cells;
+        expiring_cells += o.expiring_cells;
+        dead_cells += o.dead_cells;
+        partition_tombstones += o.partition_tombstones;
+        row_tombstones += o.row_tombstones;
+        range_tombstone_changes += o.range_tombstone_changes;
+        collection_tombstones += o.collection_tombstones;
+        partition_size += o.partition_size;
+        partition_rows += o.partition_rows;
+        partition_tombstone_count += o.partition_tombstone_count;
+        ttl += o.ttl;
+        return *this;
+    }
+
+    void write(json_writer& writer) const {
+        writer.StartObject();
+        writer.Key("partitions");
+        writer.Uint64(partitions);
+        writer.Key("rows");
+        writer.Uint64(rows);
+        writer.Key("live_cells");
+        writer.Uint64(live_cells);
+        writer.Key("expiring_cells");
+        writer.Uint64(expiring_cells);
+        writer.Key("dead_cells");
+        writer.Uint64(dead_cells);
+        writer.Key("partition_tombstones");
+        writer.Uint64(partition_tombstones);
+        writer.Key("row_tombstones");
+        writer.Uint64(row_tombstones);
+        writer.Key("range_tombstone_changes");
+        writer.Uint64(range_tombstone_changes);
+        writer.Key("collection_tombstones");
+        writer.Uint64(collection_tombstones);
+        writer.Key("partition_size");
+        partition_size.write(writer);
+        writer.Key("partition_rows");
+        partition_rows.write(writer);
+        writer.Key("partition_tombstones_histogram");
+        partition_tombstone_count.write(writer);
+        writer.Key("ttl");
+        ttl.write(writer);
+        writer.EndObject();
+    }
+};
+
+class analyzing_consumer : public sstable_consumer {
+    schema_ptr _schema;
+    sstable_analysis _analysis;
+    uint64_t _partition_size = 0;
+    uint64_t _partition_rows = 0;
+    uint64_t _partition_tombstones = 0;
+
+private:
+    void collect_cell(atomic_cell_view cell) {
+        if (!cell.is_live()) {
+            ++_analysis.dead_cells;
+            ++_partition_tombstones;
+            return;
+        }
+        ++_analysis.live_cells;
+        _partition_size += cell.value_size();
+        if (cell.is_live_and_has_ttl()) {
+            ++_analysis.expiring_cells;
+            _analysis.ttl.add(std::chrono::duration_cast<std::chrono::seconds>(cell.ttl()).count());
+        }
+    }
+    void collect_row(const row& r, column_kind kind) {
+        r.for_each_cell([this, kind] (column_id id, const atomic_cell_or_collection& cell) {
+            const auto& cdef = _schema->column_at(kind, id);
+            if (cdef.is_atomic()) {
+                collect_cell(cell.as_atomic_cell(cdef));
+                return;
+            }
+            cell.as_collection_mutation().with_deserialized(*cdef.type, [this] (collection_mutation_view_description mv) {
+                if (mv.tomb) {
+                    ++_analysis.collection_tombstones;
+                    ++_partition_tombstones;
+                }
+                for (auto&& [key, c] : mv.cells) {
+                    _partition_size += key.size();
+                    collect_cell(c);
+                }
+            });
+        });
+    }
+
+public:
+    explicit analyzing_consumer(schema_ptr s) : _schema(std::move(s)) { }
+
+    const sstable_analysis& analysis() const {
+        return _analysis;
+    }
+
+    virtual future<> on_start_of_stream() override {
+        return make_ready_future<>();
+    }
+    virtual future<stop_iteration> on_new_sstable(const sstables::sstable* const) override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        ++_analysis.partitions;
+        _partition_size = ps.key().key().representation().size();
+        _partition_rows = 0;
+        _partition_tombstones = 0;
+        if (ps.partition_tombstone()) {
+            ++_analysis.partition_tombstones;
+            ++_partition_tombstones;
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        collect_row(sr.cells(), column_kind::static_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        ++_analysis.rows;
+        ++_partition_rows;
+        _partition_size += cr.key().representation().size();
+        if (cr.tomb()) {
+            ++_analysis.row_tombstones;
+            ++_partition_tombstones;
+        }
+        if (cr.marker().is_live() && cr.marker().is_expiring()) {
+            _analysis.ttl.add(std::chrono::duration_cast<std::chrono::seconds>(cr.marker().ttl()).count());
+        }
+        collect_row(cr.cells(), column_kind::regular_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&& rtc) override {
+        ++_analysis.range_tombstone_changes;
+        if (rtc.tombstone()) {
+            ++_partition_tombstones;
+        }
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&&) override {
+        _analysis.partition_size.add(_partition_size);
+        _analysis.partition_rows.add(_partition_rows);
+        _analysis.partition_tombstone_count.add(_partition_tombstones);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> on_end_of_sstable() override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<> on_end_of_stream() override {
+        return make_ready_future<>();
+    }
+};
+
 // scribble here, then call with --operation=custom
 class custom_consumer : public sstable_consumer {
     schema_ptr _schema;
@@ -866,6 +1066,102 @@ void consume_sstables(schema_ptr schema, reader_permit permit, std::vector<sstab
     }
 }
 
+// A part of the work of an operation which is run on all shards: an sstable,
+// or a token range of it.
+struct work_item {
+    size_t sstable; // index into the sstables of the operation
+    dht::partition_range range;
+};
+
+// One work item per sstable, covering all of it.
+std::vector<work_item> make_work_items(const std::vector<sstables::shared_sstable>& sstables) {
+    std::vector<work_item> work;
+    work.reserve(sstables.size());
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        work.push_back({i, query::full_partition_range});
+    }
+    return work;
+}
+
+// Splits the sstables with more than chunk_size bytes of data into token
+// ranges, assuming the data is spread evenly over the tokens between the first
+// and last partition of the sstable, so that a large sstable keeps several
+// shards busy.
+std::vector<work_item> make_chunked_work_items(const std::vector<sstables::shared_sstable>& sstables, uint64_t chunk_size) {
+    std::vector<work_item> work;
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        const auto& sst = sstables[i];
+        const auto chunks = chunk_size ? std::max<uint64_t>(1, (sst->data_size() + chunk_size - 1) / chunk_size) : 1;
+        const auto first = dht::token::to_int64(sst->get_first_decorated_key().token());
+        const auto last = dht::token::to_int64(sst->get_last_decorated_key().token());
+        if (chunks == 1 || first == last) {
+            work.push_back({i, query::full_partition_range});
+            continue;
+        }
+        const auto span = __int128(last) - first;
+        auto start = dht::ring_position::starting_at(dht::token::from_int64(first));
+        for (uint64_t c = 1; c < chunks; ++c) {
+            auto end = dht::ring_position::starting_at(dht::token::from_int64(int64_t(first + span * c / chunks)));
+            work.push_back({i, dht::partition_range::make({start, true}, {end, false})});
+            start = std::move(end);
+        }
+        work.push_back({i, dht::partition_range::make({start, true}, {dht::ring_position::ending_at(dht::token::from_int64(last)), true})});
+    }
+    sst_log.debug("{} sstables split into {} work items of up to {} bytes", sstables.size(), work.size(), chunk_size);
+    return work;
+}
+
+// Runs func on every work item, spreading them over all shards, and returns
+// the results in the order of the work items.
+//
+// Each shard loads the schema and the sstables it works on itself, with its
+// own sstables_manager, and takes the next work item when it is done with the
+// previous one, so that the shards which get the large items don't hold up
+// the others.
+//
+// func is invoked in a seastar thread, as
+//     Result func(schema_ptr, reader_permit, const sstables::shared_sstable&, const dht::partition_range&)
+// concurrently on several shards.
+template <typename Result, typename Func>
+std::vector<Result> run_on_all_shards(const bpo::variables_map& vm, const std::vector<work_item>& work, Func func) {
+    static_assert(!std::is_same_v<Result, bool>, "the elements of std::vector<bool> can't be written concurrently");
+    const auto schema_file = std::filesystem::path(vm["schema-file"].as<sstring>());
+    const auto& sstable_names = vm["sstables"].as<std::vector<sstring>>();
+    std::vector<Result> results(work.size());
+    std::atomic<size_t> next = 0;
+
+    smp::invoke_on_all([&] {
+        return async([&] {
+            auto schema = tools::load_one_schema_from_file(schema_file).get0();
+
+            db::nop_large_data_handler large_data_handler;
+            db::config dbcfg;
+            gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
+            cache_tracker tracker;
+            dbcfg.host_id = ::utils::make_random_uuid();
+            sstables::sstables_manager sst_man(large_data_handler, dbcfg, feature_service, tracker);
+            auto close_sst_man = deferred_close(sst_man);
+
+            reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name);
+            auto stop_semaphore = deferred_stop(rcs_sem);
+
+            std::unordered_map<size_t, sstables::shared_sstable> loaded;
+            for (auto i = next++; i < work.size(); i = next++) {
+                auto& item = work[i];
+                auto it = loaded.find(item.sstable);
+                if (it == loaded.end()) {
+                    it = loaded.emplace(item.sstable, load_sstables(schema, sst_man, {sstable_names[item.sstable]}).front()).first;
+                }
+                const auto range = item.range;
+                auto permit = rcs_sem.make_tracking_only_permit(schema.get(), app_name, db::no_timeout);
+                results[i] = func(schema, std::move(permit), it->second, range);
+            }
+        });
+    }).get();
+
+    return results;
+}
+
 using operation_func = void(*)(schema_ptr, reader_permit, const std::vector<sstables::shared_sstable>&, const bpo::variables_map&);
 
 class operation {
@@ -893,17 +1189,38 @@ class operation {
     }
 };
 
+struct validation_result {
+    bool valid = false;
+};
+
+// The results of the sstables are logged as they are validated, on the shards
+// they are validated on, so they are interleaved. Sum them up at the end.
+void log_validation_results(const std::vector<validation_result>& results) {
+    const auto invalid = std::count_if(results.begin(), results.end(), [] (const validation_result& r) { return !r.valid; });
+    sst_log.info("{} out of {} sstables are invalid", invalid, results.size());
+}
+
 void validate_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map& vm) {
     const auto merge = vm.count("merge");
-    sstables::compaction_data info;
-    consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
-        if (sst) {
-            sst_log.info("validating {}", sst->get_filename());
-        }
-        const auto valid = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
-        sst_log.info("validated {}: {}", sst ? sst->get_filename() : "the stream", valid ? "valid" : "invalid");
-        return stop_iteration::no;
+    if (merge) {
+        sstables::compaction_data info;
+        consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
+            const auto valid = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
+            sst_log.info("validated the stream: {}", valid ? "valid" : "invalid");
+            return stop_iteration::no;
+        });
+        return;
+    }
+    // The crawling reader reads the whole sstable regardless of the range,
+    // so that a corrupt index doesn't get in the way, hence sstables are not split.
+    auto results = run_on_all_shards<validation_result>(vm, make_work_items(sstables), [] (schema_ptr schema, reader_permit permit, const sstables::shared_sstable& sst, const dht::partition_range&) {
+        sst_log.info("validating {}", sst->get_filename());
+        sstables::compaction_data info;
+        const auto valid = sstables::scrub_validate_mode_validate_reader(sst->make_crawling_reader(schema, permit), info).get();
+        sst_log.info("validated {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
+        return validation_result{valid};
     });
+    log_validation_results(results);
 }
 
 void dump_index_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map&) {
@@ -1293,6 +1610,9 @@ const char* to_string(sstables::scylla_metadata_type t) {
         case sstables::scylla_metadata_type::RunIdentifier: return "run_identifier";
         case sstables::scylla_metadata_type::LargeDataStats: return "large_data_stats";
         case sstables::scylla_metadata_type::SSTableOrigin: return "sstable_origin";
+        case sstables::scylla_metadata_type::CompressionDictionary: return "compression_dictionary";
+        case sstables::scylla_metadata_type::FilterFormat: return "filter_format";
+        case sstables::scylla_metadata_type::ExpiryIndex: return "expiry_index";
     }
     std::abort();
 }
@@ -1389,6 +1709,30 @@ class scylla_metadata_visitor : public boost::static_visitor<> {
     void operator()(const sstables::scylla_metadata::sstable_origin& val) const {
         _writer.String(disk_string_to_string(val));
     }
+    void operator()(const sstables::compression_dictionary& val) const {
+        _writer.StartObject();
+        _writer.Key("size");
+        _writer.Uint64(val.data.value.size());
+        _writer.EndObject();
+    }
+    void operator()(const sstables::filter_format_metadata& val) const {
+        switch (val.layout) {
+            case sstables::filter_layout::split_block: _writer.String("split_block"); return;
+        }
+        _writer.String(fmt::format("unknown({})", static_cast<uint32_t>(val.layout)));
+    }
+    void operator()(const sstables::expiry_index& val) const {
+        _writer.StartArray();
+        for (const auto& e : val.entries.elements) {
+            _writer.StartObject();
+            _writer.Key("max_local_deletion_time");
+            _writer.Int(e.max_local_deletion_time);
+            _writer.Key("max_timestamp");
+            _writer.Int64(e.max_timestamp);
+            _writer.EndObject();
+        }
+        _writer.EndArray();
+    }
 
     template <sstables::scylla_metadata_type E, typename T>
     void operator()(const sstables::disk_tagged_union_member<sstables::scylla_metadata_type, E, T>& m) const {
@@ -1416,11 +1760,41 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
     writer.EndStream();
 }
 
-void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map&) {
-    for (auto& sst : sstables) {
+void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map& vm) {
+    auto results = run_on_all_shards<validation_result>(vm, make_work_items(sstables), [] (schema_ptr, reader_permit permit, const sstables::shared_sstable& sst, const dht::partition_range&) {
         const auto valid = sstables::validate_checksums(sst, permit, default_priority_class()).get();
         sst_log.info("validated the checksums of {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
+        return validation_result{valid};
+    });
+    log_validation_results(results);
+}
+
+void analyze_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map& vm) {
+    const auto work = make_chunked_work_items(sstables, vm["chunk-size"].as<uint64_t>() << 20);
+    auto results = run_on_all_shards<sstable_analysis>(vm, work, [] (schema_ptr schema, reader_permit permit, const sstables::shared_sstable& sst, const dht::partition_range& range) {
+        analyzing_consumer consumer(schema);
+        const partition_set no_partitions(0, {}, decorated_key_equal(*schema));
+        consume_reader(sst->make_reader(schema, permit, range, schema->full_slice()), consumer, sst.get(), no_partitions, false);
+        return consumer.analysis();
+    });
+
+    std::vector<sstable_analysis> per_sstable(sstables.size());
+    sstable_analysis total;
+    for (size_t i = 0; i < work.size(); ++i) {
+        per_sstable[work[i].sstable] += results[i];
+        total += results[i];
     }
+
+    json_writer writer;
+    writer.StartStream();
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        writer.SstableKey(*sstables[i]);
+        per_sstable[i].write(writer);
+    }
+    writer.EndObject();
+    writer.Key("total");
+    total.write(writer);
+    writer.EndObject();
 }
 
 void decompress_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, const bpo::variables_map& vm) {
@@ -1523,6 +1897,7 @@ const std::vector<option> all_options {
     typed_option<>("no-skips", "don't use skips to skip to next partition when the partition filter rejects one, this is slower but works with corrupt index"),
     typed_option<std::string>("bucket", "months", "the unit of time to use as bucket, one of (years, months, weeks, days, hours)"),
     typed_option<std::string>("output-format", "json", "the output-format, one of (text, json)"),
+    typed_option<uint64_t>("chunk-size", 1024, "size in MB of the data of sstables above which they are split into token ranges processed in parallel"),
 };
 
 const std::vector<operation> operations{
@@ -1970,6 +2345,10 @@ data type of the key components. Partitions are ordered according to their token
 (hashes), so partitions are unordered in the sense that a hash-table is
 unordered: they have a random order as perceived by they user but they have a
 well defined internal order.
+
+Without --merge, the sstables are validated in parallel, on all shards (see
+--smp). The validity of each sstable is logged, then the number of invalid
+ones.
 )",
             {"merge"},
             validate_operation},
@@ -1991,12 +2370,56 @@ This operation reads the entire Data.db and validates both kind of checksums
 against the data. Errors found are logged to stderr. The output just contains a
 bool for each sstable that is true if the sstable matches all checksums.
 
+The sstables are validated in parallel, on all shards (see --smp).
+
 The content is dumped in JSON, using the following schema:
 
 $ROOT := { "$sstable_path": Bool, ... }
 
 )",
             validate_checksums_operation},
+    {"analyze",
+            "Analyze the distribution of partition sizes, tombstones and TTLs of the sstable(s)",
+R"(
+Read all the data of the sstables and report, for each of them and in total, the
+number of partitions, rows and cells, the tombstones of each kind, and
+histograms of:
+* the size of partitions, as the bytes of their keys and cell values, which
+  is less than their size on disk;
+* the number of rows in partitions;
+* the number of tombstones (of any kind, including dead cells) in partitions;
+* the TTL of expiring cells and row markers, in seconds.
+
+The sstables are processed in parallel, on all shards (see --smp). Sstables
+with more than --chunk-size MB of data are split into token ranges, which are
+processed in parallel too.
+
+The histograms have power of two buckets, keyed by their lower bound. Only
+non-empty buckets are listed. The content is dumped in JSON, using the
+following schema:
+
+$ROOT := { "sstables": { "$sstable_path": $ANALYSIS, ... }, "total": $ANALYSIS }
+
+$ANALYSIS := {
+    "partitions": Uint64,
+    "rows": Uint64,
+    "live_cells": Uint64,
+    "expiring_cells": Uint64,
+    "dead_cells": Uint64,
+    "partition_tombstones": Uint64,
+    "row_tombstones": Uint64,
+    "range_tombstone_changes": Uint64,
+    "collection_tombstones": Uint64,
+    "partition_size": $HISTOGRAM,
+    "partition_rows": $HISTOGRAM,
+    "partition_tombstones_histogram": $HISTOGRAM,
+    "ttl": $HISTOGRAM
+}
+
+$HISTOGRAM := { "$lower_bound": Uint64, ... }
+)",
+            {"chunk-size"},
+            analyze_operation},
     {"decompress",
             "Decompress sstable(s)",
 R"(
@@ -2033,8 +2456,9 @@ Usage: scylla sstable {{operation}} [--option1] [--option2] ... {{sstable_path1}
 Allows examining the contents of sstables with various built-in tools
 (operations). The sstables to-be-examined are passed as positional
 command line arguments. Sstables will be processed by the selected
-operation one-by-one. Any number of sstables can be passed but mind the
-open file limits. Always pass the path to the data component of the
+operation one-by-one, except by the operations which process them in
+parallel on all shards, as their description says. Any number of sstables
+can be passed but mind the open file limits. Always pass the path to the data component of the
 sstables (*-Data.db) even if you want to examine another component.
 The schema to read the sstables is read from a schema.cql file. This
 should contain the keyspace and table definitions, any UDTs used and
@@ -2079,6 +2503,9 @@ For more details on an operation, run: scylla sstable {{operation}} --help
 
 # validate the specified sstables
 $ scylla sstable validate /path/to/md-123456-big-Data.db /path/to/md-123457-big-Data.db
+
+# analyze all the sstables of a table, on 8 shards
+$ scylla sstable analyze --smp=8 /path/to/table/*-Data.db
 )";
 
     if (found_op) {
@@ -239,7 +239,8 @@ void trace_state::stop_foreground_and_write() noexcept {
 
     if (is_in_state(state::foreground)) {
         auto e = elapsed();
-        _records->do_log_slow_query = should_log_slow_query(e);
+        const bool slow = should_log_slow_query(e);
+        _records->do_log_slow_query = slow && _local_tracing_ptr->should_persist_slow_query(session_id());
 
         if (is_primary()) {
             // We don't account the session_record event when checking a limit
@@ -260,9 +261,14 @@ void trace_state::stop_foreground_and_write() noexcept {
             // These events should be really rare however, therefore we don't
             // want to optimize this flow (e.g. rollback the corresponding
             // events' records that have already been sent to I/O).
-            if (should_write_records()) {
+            if (should_write_records() || slow) {
                 try {
                     build_parameters_map();
+                    if (slow) {
+                        ++_local_tracing_ptr->stats.slow_queries;
+                        _local_tracing_ptr->stats.persisted_slow_queries += _records->do_log_slow_query;
+                        _local_tracing_ptr->record_slow_query(session_id(), _records->session_rec);
+                    }
                 } catch (...) {
                     // Bump up an error counter, drop any pending records and
                     // continue
@@ -560,7 +560,8 @@ inline void trace_state::trace_internal(sstring message) {
         // We don't want to write records of a tracing session if we trace only
         // slow queries and the elapsed time is still below the slow query
         // logging threshold.
-        if (_records->events_recs.size() >= tracing::exp_trace_events_per_session && (full_tracing() || should_log_slow_query(e))) {
+        if (_records->events_recs.size() >= tracing::exp_trace_events_per_session
+                && (full_tracing() || (should_log_slow_query(e) && _local_tracing_ptr->should_persist_slow_query(session_id())))) {
             _local_tracing_ptr->schedule_for_write(_records);
             _local_tracing_ptr->write_maybe();
         }
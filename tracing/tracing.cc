@@ -53,6 +53,12 @@ tracing::tracing(const backend_registry& br, sstring tracing_backend_helper_clas
         sm::make_derive("trace_errors", stats.trace_errors,
                         sm::description("Counts a number of trace records dropped due to an error (e.g. OOM).")),
 
+        sm::make_derive("slow_queries", stats.slow_queries,
+                        sm::description("Counts a number of queries that took longer than the slow query threshold.")),
+
+        sm::make_derive("persisted_slow_queries", stats.persisted_slow_queries,
+                        sm::description("Counts a number of slow queries whose records were written to the tracing backend.")),
+
         sm::make_gauge("active_sessions", _active_sessions,
                         sm::description("Holds a number of a currently active tracing sessions.")),
 
@@ -187,6 +193,32 @@ void tracing::set_trace_probability(double p) {
     tracing_logger.info("Setting tracing probability to {} (normalized {})", _trace_probability, _normalized_trace_probability);
 }
 
+void tracing::set_slow_query_persist_ratio(double ratio) {
+    if (ratio < 0 || ratio > 1) {
+        throw std::out_of_range("slow query persist ratio must be in a [0,1] range");
+    }
+
+    _slow_query_persist_ratio = ratio;
+
+    tracing_logger.info("Setting slow query persist ratio to {}", _slow_query_persist_ratio);
+}
+
+bool tracing::should_persist_slow_query(const utils::UUID& session_id) const {
+    if (_slow_query_persist_ratio >= 1) {
+        return true;
+    }
+    // Session IDs are timeuuids, so spread their bits before mapping them to [0, 1).
+    uint64_t h = std::hash<utils::UUID>()(session_id) * 0x9e3779b97f4a7c15ull;
+    return (h >> 11) * 0x1p-53 < _slow_query_persist_ratio;
+}
+
+void tracing::record_slow_query(const utils::UUID& session_id, const session_record& rec) {
+    if (_recent_slow_queries.size() >= max_recent_slow_queries) {
+        _recent_slow_queries.pop_front();
+    }
+    _recent_slow_queries.push_back(slow_query_summary{session_id, rec});
+}
+
 one_session_records::one_session_records()
     : _local_tracing_ptr(tracing::get_local_tracing_instance().shared_from_this())
     , backend_state_ptr(_local_tracing_ptr->allocate_backend_session_state())
@@ -15,6 +15,7 @@
 #include <vector>
 #include <atomic>
 #include <random>
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/metrics_registration.hh>
@@ -218,6 +219,13 @@ struct session_record {
     }
 };
 
+// A slow query kept in memory by tracing::record_slow_query(), whether or
+// not its records were written to the backend.
+struct slow_query_summary {
+    utils::UUID session_id;
+    session_record session;
+};
+
 class one_session_records {
 private:
     shared_ptr<tracing> _local_tracing_ptr;
@@ -304,12 +312,16 @@ class tracing : public seastar::async_sharded_service<tracing> {
 
     static const std::chrono::microseconds default_slow_query_duraion_threshold;
     static const std::chrono::seconds default_slow_query_record_ttl;
+    // Number of the most recent slow queries kept in memory per-shard
+    static constexpr size_t max_recent_slow_queries = 256;
 
     struct stats {
         uint64_t dropped_sessions = 0;
         uint64_t dropped_records = 0;
         uint64_t trace_records_count = 0;
         uint64_t trace_errors = 0;
+        uint64_t slow_queries = 0;
+        uint64_t persisted_slow_queries = 0;
     } stats;
 
 private:
@@ -388,6 +400,10 @@ class tracing : public seastar::async_sharded_service<tracing> {
     std::ranlux48_base _gen;
     std::chrono::microseconds _slow_query_duration_threshold;
     std::chrono::seconds _slow_query_record_ttl;
+    // Fraction of the slow queries whose records are written to the backend.
+    // All of them are kept in _recent_slow_queries.
+    double _slow_query_persist_ratio = 1.0;
+    circular_buffer<slow_query_summary> _recent_slow_queries;
 
 public:
     uint64_t get_next_rand_uint64() {
@@ -632,6 +648,31 @@ class tracing : public seastar::async_sharded_service<tracing> {
         return _slow_query_record_ttl;
     }
 
+    /**
+     * Set the fraction of slow queries whose records are written
+     *
+     * Slow queries are always kept in the in-memory list returned by
+     * recent_slow_queries(). Only this fraction of them, chosen by their
+     * session ID so that the coordinator and the replicas of a query agree,
+     * is written to the backend.
+     *
+     * @param ratio a value in the [0, 1] range
+     */
+    void set_slow_query_persist_ratio(double ratio);
+
+    double slow_query_persist_ratio() const {
+        return _slow_query_persist_ratio;
+    }
+
+    bool should_persist_slow_query(const utils::UUID& session_id) const;
+
+    void record_slow_query(const utils::UUID& session_id, const session_record& rec);
+
+    // The most recent slow queries on this shard, oldest first.
+    const circular_buffer<slow_query_summary>& recent_slow_queries() const {
+        return _recent_slow_queries;
+    }
+
 private:
     void write_timer_callback();
 
@@ -13,6 +13,8 @@
 #include "gms/gossiper.hh"
 #include "log.hh"
 #include "cql3/query_processor.hh"
+#include "service/storage_proxy.hh"
+#include "replica/database.hh"
 
 using namespace seastar;
 
@@ -87,6 +89,10 @@ future<> controller::do_start_server() {
             cql_server_config.shard_aware_transport_port_ssl = cfg.native_shard_aware_transport_port_ssl();
         }
         cql_server_config.partitioner_name = cfg.partitioner();
+        auto& db = _qp.local().proxy().get_db().local();
+        if (db.get_batch_statement_scheduling_group() != db.get_statement_scheduling_group()) {
+            cql_server_config.batch_workload_scheduling_group = db.get_batch_statement_scheduling_group();
+        }
         smp_service_group_config cql_server_smp_service_group_config;
         cql_server_smp_service_group_config.max_nonlocal_requests = 5000;
         cql_server_config.bounce_request_smp_service_group = create_smp_service_group(cql_server_smp_service_group_config).get0();
@@ -16,6 +16,7 @@
 
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
 #include "types/collection.hh"
 #include "types/list.hh"
 #include "types/set.hh"
@@ -35,6 +36,7 @@
 #include <seastar/net/byteorder.hh>
 #include <seastar/util/lazy.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/with_scheduling_group.hh>
 #include "utils/result_try.hh"
 #include "utils/result_combinators.hh"
 
@@ -51,6 +53,7 @@
 
 #include <snappy-c.h>
 #include <lz4.h>
+#include <zstd.h>
 
 #include "response.hh"
 #include "request.hh"
@@ -60,6 +63,8 @@
 #include "transport/cql_protocol_extension.hh"
 #include "utils/bit_cast.hh"
 #include "db/config.hh"
+#include "replica/database.hh"
+#include "utils/fb_utilities.hh"
 
 template<typename T = void>
 using coordinator_result = exceptions::coordinator_result<T>;
@@ -194,6 +199,10 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
         sm::make_derive("requests_served", _stats.requests_served,
                         sm::description("Counts a number of served requests.")),
 
+        sm::make_derive("response_flushes", _stats.response_flushes,
+                        sm::description("Counts flushes of responses to clients. Responses which are ready together are flushed once, "
+                                        "so requests_served divided by this is the average number of responses per flush.")),
+
         sm::make_gauge("requests_serving", _stats.requests_serving,
                         sm::description("Holds a number of requests that are being processed right now.")),
 
@@ -205,6 +214,9 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
                         sm::description(
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _max_request_size))),
+        sm::make_derive("requests_bounced", _stats.requests_bounced,
+                        sm::description("Holds an incrementing counter with the requests that were moved to the shard which owns their partition, "
+                                        "because they were received on another one. A high rate indicates clients which don't connect to the right shard.")),
         sm::make_derive("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
@@ -664,8 +676,14 @@ future<> cql_server::connection::process_request() {
                 _pending_requests_gate.leave();
             });
             auto istream = buf.get_istream();
-            (void)_process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit)
-                    .then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
+            auto process = [this, istream, op, stream, tracing_requested, mem_permit] {
+                return _process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit);
+            };
+            auto& batch_group = _server._config.batch_workload_scheduling_group;
+            auto response_fut = batch_group && _client_state.get_workload_type() == service::client_state::workload_type::batch
+                    ? with_scheduling_group(*batch_group, process)
+                    : process();
+            (void)std::move(response_fut).then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
                     write_response(response_f.get0(), std::move(mem_permit), _compression);
                     _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave)] {});
@@ -697,6 +715,116 @@ void on_compression_buffer_use() {
     }
 }
 
+// zstd streams fragment by fragment, so it needs neither of the buffers
+// above, only its contexts. Level 1 keeps it cheap enough for the request
+// path while still compressing better than LZ4.
+static constexpr int zstd_level = 1;
+
+static void check_zstd(size_t ret, const char* what) {
+    if (ZSTD_isError(ret)) {
+        throw std::runtime_error(format("CQL frame zstd {} failure: {}", what, ZSTD_getErrorName(ret)));
+    }
+}
+
+static ZSTD_CCtx* zstd_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, size_t(*)(ZSTD_CCtx*)> cctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    if (!cctx) {
+        throw std::runtime_error("Unable to initialize CQL frame zstd compression context");
+    }
+    return cctx.get();
+}
+
+static ZSTD_DCtx* zstd_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, size_t(*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (!dctx) {
+        throw std::runtime_error("Unable to initialize CQL frame zstd decompression context");
+    }
+    return dctx.get();
+}
+
+// Decompresses straight into the fragments of the result.
+static fragmented_temporary_buffer zstd_decompress(const fragmented_temporary_buffer& in, size_t uncomp_len) {
+    auto dctx = zstd_dctx();
+    check_zstd(ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only), "uncompression");
+
+    std::vector<temporary_buffer<char>> fragments;
+    for (size_t left = uncomp_len; left;) {
+        auto size = std::min(left, fragmented_temporary_buffer::default_fragment_size);
+        fragments.emplace_back(size);
+        left -= size;
+    }
+    auto fragment = fragments.begin();
+    ZSTD_outBuffer out{nullptr, 0, 0};
+    if (fragment != fragments.end()) {
+        out = ZSTD_outBuffer{fragment->get_write(), fragment->size(), 0};
+    }
+    size_t written = 0;
+    size_t ret = 1;
+    auto step = [&] (ZSTD_inBuffer& zin) {
+        if (out.pos == out.size && fragment != fragments.end() && std::next(fragment) != fragments.end()) {
+            ++fragment;
+            out = ZSTD_outBuffer{fragment->get_write(), fragment->size(), 0};
+        }
+        auto in_pos = zin.pos;
+        auto out_pos = out.pos;
+        ret = ZSTD_decompressStream(dctx, &out, &zin);
+        check_zstd(ret, "uncompression");
+        written += out.pos - out_pos;
+        if (zin.pos == in_pos && out.pos == out_pos) {
+            throw std::runtime_error("CQL frame zstd uncompression failure: data doesn't match the uncompressed length");
+        }
+    };
+    for (bytes_view frag : fragmented_temporary_buffer::view(in)) {
+        ZSTD_inBuffer zin{frag.data(), frag.size(), 0};
+        while (zin.pos < zin.size) {
+            step(zin);
+        }
+    }
+    ZSTD_inBuffer end{nullptr, 0, 0};
+    while (ret) {
+        step(end);
+    }
+    if (written != uncomp_len) {
+        throw std::runtime_error(format("CQL frame zstd uncompression failure: expected {} bytes, got {}", uncomp_len, written));
+    }
+    return fragmented_temporary_buffer(std::move(fragments), uncomp_len);
+}
+
+// Compresses fragment by fragment, never linearizing the input.
+static bytes_ostream zstd_compress(const bytes_ostream& in) {
+    auto cctx = zstd_cctx();
+    check_zstd(ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only), "compression");
+    check_zstd(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level), "compression");
+    check_zstd(ZSTD_CCtx_setPledgedSrcSize(cctx, in.size()), "compression");
+
+    static thread_local std::unique_ptr<char[]> scratch(new char[ZSTD_CStreamOutSize()]);
+    bytes_ostream out;
+    auto input_len = in.size();
+    int8_t header[4] = {
+        int8_t((input_len >> 24) & 0xFF),
+        int8_t((input_len >> 16) & 0xFF),
+        int8_t((input_len >> 8) & 0xFF),
+        int8_t(input_len & 0xFF),
+    };
+    out.write(bytes_view(header, sizeof(header)));
+    auto compress = [&] (ZSTD_inBuffer& zin, ZSTD_EndDirective mode) {
+        size_t ret;
+        do {
+            ZSTD_outBuffer zout{scratch.get(), ZSTD_CStreamOutSize(), 0};
+            ret = ZSTD_compressStream2(cctx, &zout, &zin, mode);
+            check_zstd(ret, "compression");
+            out.write(scratch.get(), zout.pos);
+        } while (mode == ZSTD_e_end ? ret != 0 : zin.pos < zin.size);
+    };
+    for (bytes_view frag : in.fragments()) {
+        ZSTD_inBuffer zin{frag.data(), frag.size(), 0};
+        compress(zin, ZSTD_e_continue);
+    }
+    ZSTD_inBuffer end{nullptr, 0, 0};
+    compress(end, ZSTD_e_end);
+    return out;
+}
+
 }
 
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
@@ -743,6 +871,19 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                 on_compression_buffer_use();
                 return uncomp;
             });
+        } else if (_compression == cql_compression::zstd) {
+            if (length < 4) {
+                throw std::runtime_error(fmt::format("CQL frame truncated: expected to have at least 4 bytes, got {}", length));
+            }
+            return _buffer_reader.read_exactly(_read_buf, length).then([] (fragmented_temporary_buffer buf) {
+                auto linearization_buffer = bytes_ostream();
+                int32_t uncomp_len = request_reader(buf.get_istream(), linearization_buffer).read_int();
+                if (uncomp_len < 0) {
+                    throw std::runtime_error("CQL frame uncompressed length is negative: " + std::to_string(uncomp_len));
+                }
+                buf.remove_prefix(4);
+                return zstd_decompress(buf, uncomp_len);
+            });
         } else {
             throw exceptions::protocol_exception(format("Unknown compression algorithm"));
         }
@@ -762,6 +903,8 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
              _compression = cql_compression::lz4;
          } else if (compression == "snappy") {
              _compression = cql_compression::snappy;
+         } else if (compression == "zstd") {
+             _compression = cql_compression::zstd;
          } else {
              throw exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression));
          }
@@ -873,6 +1016,7 @@ cql_server::connection::process(uint16_t stream, request_reader in, service::cli
                    (process_fn_return_type msg) mutable {
         auto* bounce_msg = std::get_if<shared_ptr<messages::result_message::bounce_to_shard>>(&msg);
         if (bounce_msg) {
+            ++_server._stats.requests_bounced;
             return process_on_shard(*bounce_msg, stream, is, client_state, std::move(permit), trace_state, process_fn);
         }
         auto ptr = std::get<cql_server::result_with_foreign_response_ptr>(std::move(msg));
@@ -1016,6 +1160,15 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
         tracing::add_prepared_query_options(trace_state, options);
     }
 
+    // Only on the shard which received the request, a bounced one is already
+    // where it belongs.
+    if (init_trace && qp.local().db().get_config().forward_requests_to_owning_shard()) {
+        if (auto shard = owning_shard(qp.local(), *prepared, options); shard && *shard != this_shard_id()) {
+            tracing::trace(trace_state, "Moving the request to shard {}, which owns the partition", *shard);
+            return make_ready_future<process_fn_return_type>(::make_shared<messages::result_message::bounce_to_shard>(*shard, cql3::computed_function_values{}));
+        }
+    }
+
     tracing::trace(trace_state, "Processing a statement");
     return qp.local().execute_prepared_without_checking_exception_message(std::move(prepared), std::move(cache_key), query_state, options, needs_authorization)
             .then([trace_state = query_state.get_trace_state(), skip_metadata, q_state = std::move(q_state), stream, version] (auto msg) {
@@ -1030,6 +1183,44 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
     });
 }
 
+// The shard owning the partition a prepared statement reads or writes, if
+// this node is one of its replicas and the whole partition key is given by
+// bind markers. A request received on another shard is better executed
+// there as a whole, than hopping to it for every replica read or write.
+static std::optional<unsigned> owning_shard(cql3::query_processor& qp, const cql3::statements::prepared_statement& prepared, const cql3::query_options& options) {
+    const sstring* ks_name;
+    const sstring* cf_name;
+    if (auto* select = dynamic_cast<const cql3::statements::select_statement*>(prepared.statement.get())) {
+        ks_name = &select->keyspace();
+        cf_name = &select->column_family();
+    } else if (auto* modification = dynamic_cast<const cql3::statements::modification_statement*>(prepared.statement.get())) {
+        ks_name = &modification->keyspace();
+        cf_name = &modification->column_family();
+    } else {
+        return std::nullopt;
+    }
+    if (prepared.partition_key_bind_indices.empty()) {
+        return std::nullopt;
+    }
+    std::vector<bytes> components;
+    components.reserve(prepared.partition_key_bind_indices.size());
+    for (auto i : prepared.partition_key_bind_indices) {
+        auto value = options.get_value_at(i);
+        if (!value.is_value()) {
+            return std::nullopt;
+        }
+        components.push_back(to_bytes(value));
+    }
+    auto schema = qp.db().find_schema(*ks_name, *cf_name);
+    auto token = dht::decorate_key(*schema, partition_key::from_exploded(*schema, components)).token();
+    auto erm = qp.proxy().local_db().find_keyspace(*ks_name).get_effective_replication_map();
+    auto replicas = erm->get_natural_endpoints(token);
+    if (std::find(replicas.begin(), replicas.end(), utils::fb_utilities::get_broadcast_address()) == replicas.end()) {
+        return std::nullopt;
+    }
+    return dht::shard_of(*schema, token);
+}
+
 future<cql_server::result_with_foreign_response_ptr> cql_server::connection::process_execute(uint16_t stream, request_reader in,
         service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
     ++_server._stats.execute_requests;
@@ -1311,6 +1502,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
     opts.insert({"COMPRESSION", "lz4"});
     opts.insert({"COMPRESSION", "snappy"});
+    opts.insert({"COMPRESSION", "zstd"});
     if (_server._config.allow_shard_aware_drivers) {
         opts.insert({"SCYLLA_SHARD", format("{:d}", this_shard_id())});
         opts.insert({"SCYLLA_NR_SHARDS", format("{:d}", smp::count)});
@@ -1457,10 +1649,17 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    ++_pending_responses;
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
         auto message = response->make_message(_version, compression);
         message.on_delete([response = std::move(response)] { });
         return _write_buf.write(std::move(message)).then([this] {
+            // Responses which became ready while this one was written go out
+            // in the same flush.
+            if (--_pending_responses) {
+                return make_ready_future<>();
+            }
+            ++_server._stats.response_flushes;
             return _write_buf.flush();
         });
     });
@@ -1488,6 +1687,9 @@ void cql_server::response::compress(cql_compression compression)
     case cql_compression::snappy:
         compress_snappy();
         break;
+    case cql_compression::zstd:
+        compress_zstd();
+        break;
     default:
         throw std::invalid_argument("Invalid CQL compression algorithm");
     }
@@ -1539,6 +1741,11 @@ void cql_server::response::compress_snappy()
     on_compression_buffer_use();
 }
 
+void cql_server::response::compress_zstd()
+{
+    _body = compression_buffers::zstd_compress(_body);
+}
+
 void cql_server::response::serialize(const event::schema_change& event, uint8_t version)
 {
     if (version >= 3) {
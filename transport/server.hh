@@ -68,6 +68,7 @@ enum class cql_compression {
     none,
     lz4,
     snappy,
+    zstd,
 };
 
 enum cql_frame_flags {
@@ -120,6 +121,8 @@ struct cql_server_config {
     std::optional<uint16_t> shard_aware_transport_port_ssl;
     bool allow_shard_aware_drivers = true;
     smp_service_group bounce_request_smp_service_group = default_smp_service_group();
+    // Requests of connections whose service level has the batch workload type run in this group.
+    std::optional<scheduling_group> batch_workload_scheduling_group;
 };
 
 class cql_server : public seastar::peering_sharded_service<cql_server>, public generic_server::server {
@@ -132,6 +135,8 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving;
         uint64_t requests_blocked_memory;
         uint64_t requests_shed;
+        uint64_t requests_bounced;
+        uint64_t response_flushes;
 
         // cql message stats
         uint64_t startups;
@@ -195,6 +200,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         unsigned _request_cpu = 0;
         bool _ready = false;
         bool _authenticating = false;
+        // Responses passed to write_response() and not yet written. The
+        // output is only flushed after the last of them.
+        unsigned _pending_responses = 0;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
@@ -16,6 +16,7 @@
 #include <chrono>
 #include <random>
 #include <limits>
+#include <span>
 
 #include "UUID.hh"
 #include "db_clock.hh"
@@ -104,6 +105,16 @@ class UUID_gen
         return create_time(when);
     }
 
+    // Like create_time_safe(), but reserves n consecutive decimicroseconds
+    // and returns the first of them, reading the clock once.
+    decimicroseconds create_times_safe(size_t n) {
+        using std::chrono::system_clock;
+        auto millis = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+        decimicroseconds when = std::max(from_unix_timestamp(millis), _last_used_time + decimicroseconds{1});
+        _last_used_time = when + decimicroseconds(int64_t(n) - 1);
+        return when;
+    }
+
 public:
     // We have only 17 timeuuid bits available to store this
     // value.
@@ -120,6 +131,24 @@ class UUID_gen
         return uuid;
     }
 
+    /**
+     * Fills @param out with type 1 UUIDs (time-based UUIDs), in increasing
+     * order and ordered after any UUID the shard generated before, as
+     * repeated calls to get_time_UUID() would. Cheaper than those calls
+     * for batches, as the clock is read once.
+     */
+    static void get_time_UUIDs(std::span<UUID> out)
+    {
+        if (out.empty()) {
+            return;
+        }
+        auto when = _instance.create_times_safe(out.size());
+        for (auto& uuid : out) {
+            uuid = UUID(create_time(when), clock_seq_and_node);
+            when += decimicroseconds{1};
+        }
+    }
+
     /**
      * Creates a type 1 UUID (time-based UUID) with the wall clock time point @param tp.
      *
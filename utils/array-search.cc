@@ -52,6 +52,14 @@ arch_target("default") unsigned array_search_x32_eq_impl(uint8_t val, const uint
     return array_search_eq_impl(val, arr, 32 * nr);
 }
 
+arch_target("default") unsigned array_search_16_min_gt_impl(uint8_t val, const uint8_t* arr) {
+    return array_search_min_gt(val, arr, 16);
+}
+
+arch_target("default") unsigned array_search_32_min_gt_impl(uint8_t val, const uint8_t* arr) {
+    return array_search_min_gt(val, arr, 32);
+}
+
 #ifdef __x86_64__
 
 /*
@@ -100,6 +108,29 @@ arch_target("avx2") int array_search_gt_impl(int64_t val, const int64_t* array,
     return size - cnt;
 }
 
+/*
+ * AVX-512 compares 8 keys in one go and gives the result as a bitmask,
+ * so there's no need to pack it. Nodes of 16 keys take 2 iterations
+ * instead of 4. When the capacity is not a multiple of 8 the last 4 keys
+ * are loaded and compared under a mask, so that nothing past the end of the
+ * array is read. The same requirements on unused elements as for AVX2 apply.
+ */
+arch_target("avx512f") int array_search_gt_impl(int64_t val, const int64_t* array, const int capacity, const int size) {
+    int cnt = 0;
+
+    __m512i k = _mm512_set1_epi64(val);
+    int i = 0;
+    for (; i + 8 <= capacity; i += 8) {
+        cnt += _mm_popcnt_u32(_mm512_cmpgt_epi64_mask(_mm512_loadu_si512(&array[i]), k));
+    }
+    if (i < capacity) {
+        __mmask8 tail = 0x0f;
+        cnt += _mm_popcnt_u32(_mm512_mask_cmpgt_epi64_mask(tail, _mm512_maskz_loadu_epi64(tail, &array[i]), k));
+    }
+
+    return size - cnt;
+}
+
 /*
  * SSE4 version of searching in array for an exact match.
  */
@@ -136,6 +167,47 @@ arch_target("avx2") unsigned array_search_x32_eq_impl(uint8_t val, const uint8_t
     return len;
 }
 
+/*
+ * SSE4.1 version of searching for the smallest element greater than the value.
+ *
+ * Unused elements are negative when compared as signed bytes, so the signed
+ * comparison with the value drops them. The elements which didn't pass are
+ * replaced with the largest used value, the minimum is folded into the lowest
+ * byte and then searched for among the passed elements.
+ */
+arch_target("sse4.1") static inline __m128i min_epi8_fold(__m128i m) {
+    m = _mm_min_epi8(m, _mm_srli_si128(m, 8));
+    m = _mm_min_epi8(m, _mm_srli_si128(m, 4));
+    m = _mm_min_epi8(m, _mm_srli_si128(m, 2));
+    m = _mm_min_epi8(m, _mm_srli_si128(m, 1));
+    return m;
+}
+
+arch_target("sse4.1") unsigned array_search_16_min_gt_impl(uint8_t val, const uint8_t* arr) {
+    auto b = _mm_lddqu_si128((__m128i*)arr);
+    auto gt = _mm_cmpgt_epi8(b, _mm_set1_epi8(val));
+    unsigned mask = _mm_movemask_epi8(gt);
+    if (mask == 0) {
+        return 16;
+    }
+    auto m = min_epi8_fold(_mm_blendv_epi8(_mm_set1_epi8(127), b, gt));
+    auto eq = _mm_cmpeq_epi8(b, _mm_shuffle_epi8(m, _mm_setzero_si128()));
+    return __builtin_ctz(_mm_movemask_epi8(eq) & mask);
+}
+
+arch_target("avx2") unsigned array_search_32_min_gt_impl(uint8_t val, const uint8_t* arr) {
+    auto b = _mm256_lddqu_si256((__m256i*)arr);
+    auto gt = _mm256_cmpgt_epi8(b, _mm256_set1_epi8(val));
+    unsigned mask = _mm256_movemask_epi8(gt);
+    if (mask == 0) {
+        return 32;
+    }
+    auto c = _mm256_blendv_epi8(_mm256_set1_epi8(127), b, gt);
+    auto m = min_epi8_fold(_mm_min_epi8(_mm256_castsi256_si128(c), _mm256_extracti128_si256(c, 1)));
+    auto eq = _mm256_cmpeq_epi8(b, _mm256_broadcastb_epi8(m));
+    return __builtin_ctz(_mm256_movemask_epi8(eq) & mask);
+}
+
 #endif
 
 int array_search_gt(int64_t val, const int64_t* array, const int capacity, const int size) {
@@ -154,4 +226,12 @@ unsigned array_search_x32_eq(uint8_t val, const uint8_t* array, int nr) {
     return array_search_x32_eq_impl(val, array, nr);
 }
 
+unsigned array_search_16_min_gt(uint8_t val, const uint8_t* array) {
+    return array_search_16_min_gt_impl(val, array);
+}
+
+unsigned array_search_32_min_gt(uint8_t val, const uint8_t* array) {
+    return array_search_32_min_gt_impl(val, array);
+}
+
 }
@@ -57,4 +57,32 @@ unsigned array_search_16_eq(uint8_t val, const uint8_t* array);
 unsigned array_search_32_eq(uint8_t val, const uint8_t* array);
 unsigned array_search_x32_eq(uint8_t val, const uint8_t* array, int nr);
 
+/*
+ * array_search_N_min_gt(value, array)
+ *
+ * Returns the index of the smallest element in the array that's greater
+ * than the given value, or N if there's no such. Elements with the top bit
+ * set are unused and never match, value must be below 128.
+ */
+static inline unsigned array_search_min_gt(uint8_t val, const uint8_t* array, unsigned len) {
+    unsigned ret = len;
+    for (unsigned i = 0; i < len; i++) {
+        if (array[i] > val && array[i] < 128 && (ret == len || array[i] < array[ret])) {
+            ret = i;
+        }
+    }
+    return ret;
+}
+
+static inline unsigned array_search_4_min_gt(uint8_t val, const uint8_t* array) {
+    return array_search_min_gt(val, array, 4);
+}
+
+static inline unsigned array_search_8_min_gt(uint8_t val, const uint8_t* array) {
+    return array_search_min_gt(val, array, 8);
+}
+
+unsigned array_search_16_min_gt(uint8_t val, const uint8_t* array);
+unsigned array_search_32_min_gt(uint8_t val, const uint8_t* array);
+
 }
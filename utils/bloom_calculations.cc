@@ -11,6 +11,8 @@
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
 
+#include <cmath>
+
 #include "bloom_calculations.hh"
 
 namespace utils {
@@ -72,5 +74,42 @@ std::vector<int> initialize_opt_k() {
 }
 
 std::vector<int> opt_k_per_buckets = initialize_opt_k();
+
+double split_block_false_positive_rate(double bits_per_element) {
+    constexpr int bits_per_block = 256;
+    constexpr double bits_per_word = 32;
+    const double keys_per_block = bits_per_block / std::max(bits_per_element, 1.0);
+    // Sum the rate for j keys in the block, weighted by the probability of
+    // the block receiving j keys, until the tail no longer matters.
+    const int max_keys = keys_per_block + 20 * std::sqrt(keys_per_block) + 100;
+    double p = std::exp(-keys_per_block);
+    double rate = 0;
+    for (int j = 0; j < max_keys; ++j) {
+        rate += p * std::pow(1 - std::pow(1 - 1 / bits_per_word, j), 8);
+        p *= keys_per_block / (j + 1);
+    }
+    return rate;
+}
+
+double split_block_bits_per_element(double max_false_pos_prob) {
+    if (max_false_pos_prob < split_block_false_positive_rate(max_split_block_bits_per_element)) {
+        throw exceptions::unsupported_operation_exception(format("Unable to satisfy {:f} with {:f} bits per element", max_false_pos_prob, max_split_block_bits_per_element));
+    }
+    // The rate decreases with the number of bits per element.
+    double lo = 1, hi = max_split_block_bits_per_element;
+    if (split_block_false_positive_rate(lo) <= max_false_pos_prob) {
+        return lo;
+    }
+    for (int i = 0; i < 40; ++i) {
+        auto mid = (lo + hi) / 2;
+        if (split_block_false_positive_rate(mid) > max_false_pos_prob) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+
 }
 }
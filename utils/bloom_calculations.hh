@@ -126,6 +126,32 @@ namespace bloom_calculations {
         }
         return std::min(probs.size() - 1, size_t(v));
     }
+
+    /**
+     * The maximum number of bits per element for a split-block bloom filter.
+     */
+    double constexpr max_split_block_bits_per_element = 64;
+
+    /**
+     * Computes the false positive rate of a split-block bloom filter with
+     * the given number of bits per element.
+     *
+     * Since every key sets one bit in each of the eight 32-bit words of a
+     * single 256-bit block, the rate depends on the number of keys which
+     * fall into the block; it is averaged over a Poisson distribution of
+     * that number.
+     */
+    double split_block_false_positive_rate(double bits_per_element);
+
+    /**
+     * Given a maximum tolerable false positive probability, compute the
+     * smallest number of bits per element for a split-block bloom filter
+     * which gives no more than the specified false positive rate.
+     *
+     * @throws unsupported_operation_exception if the rate cannot be met
+     * with max_split_block_bits_per_element bits per element
+     */
+    double split_block_bits_per_element(double max_false_pos_prob);
 }
 
 }
@@ -20,9 +20,16 @@
 #include <seastar/core/loop.hh>
 #include "utils/large_bitset.hh"
 #include <array>
+#include <cmath>
 #include <cstdlib>
 #include "bloom_filter.hh"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#endif
+
 namespace utils {
 namespace filter {
 
@@ -86,5 +93,134 @@ filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter
     large_bitset bitset(num_bits);
     return std::make_unique<murmur3_bloom_filter>(hash, std::move(bitset), format);
 }
+
+thread_local split_block_bloom_filter::stats split_block_bloom_filter::_shard_stats;
+
+// Odd constants used to derive the bit position in each word of a block
+// from a single 32-bit hash, taken from the Parquet bloom filter specification.
+alignas(32) static constexpr uint32_t split_block_salts[split_block_bloom_filter::words_per_block] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+};
+
+// Mask of the bits of the key in the i-th 64-bit storage word of a block
+// (covering 32-bit words 2i and 2i+1).
+static inline uint64_t split_block_mask(uint32_t key, size_t i) {
+    auto lo = uint64_t(1) << ((key * split_block_salts[2 * i]) >> 27);
+    auto hi = uint64_t(1) << ((key * split_block_salts[2 * i + 1]) >> 27);
+    return lo | (hi << 32);
+}
+
+split_block_bloom_filter::split_block_bloom_filter(storage_type storage) noexcept
+    : _storage(std::move(storage))
+    , _nr_blocks(_storage.size() / storage_words_per_block)
+{
+    _stats.memory_size += memory_size();
+}
+
+split_block_bloom_filter::~split_block_bloom_filter() noexcept {
+    _stats.memory_size -= memory_size();
+}
+
+size_t split_block_bloom_filter::first_word_of_block(const std::array<uint64_t, 2>& h) const noexcept {
+    // Maps the hash onto [0, _nr_blocks) without a division.
+    auto block = uint64_t((static_cast<unsigned __int128>(h[0]) * _nr_blocks) >> 64);
+    return block * storage_words_per_block;
+}
+
+void split_block_bloom_filter::add(hashed_key key) {
+    auto h = key.hash();
+    uint64_t* words = &_storage[first_word_of_block(h)];
+    auto k = uint32_t(h[1]);
+    for (size_t i = 0; i < storage_words_per_block; ++i) {
+        words[i] |= split_block_mask(k, i);
+    }
+}
+
+void split_block_bloom_filter::add(const bytes_view& key) {
+    add(make_hashed_key(key));
+}
+
+bool split_block_bloom_filter::is_present(hashed_key key) {
+    auto h = key.hash();
+    const uint64_t* words = &_storage[first_word_of_block(h)];
+    auto k = uint32_t(h[1]);
+#if defined(__AVX2__)
+    auto salts = _mm256_load_si256(reinterpret_cast<const __m256i*>(split_block_salts));
+    auto shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(k), salts), 27);
+    auto mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words));
+    return _mm256_testc_si256(block, mask);
+#elif defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    auto key4 = vdupq_n_u32(k);
+    auto one = vdupq_n_u32(1);
+    auto mask_lo = vshlq_u32(one, vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(key4, vld1q_u32(split_block_salts)), 27)));
+    auto mask_hi = vshlq_u32(one, vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(key4, vld1q_u32(split_block_salts + 4)), 27)));
+    auto block = reinterpret_cast<const uint32_t*>(words);
+    auto missing = vorrq_u32(vbicq_u32(mask_lo, vld1q_u32(block)), vbicq_u32(mask_hi, vld1q_u32(block + 4)));
+    return vmaxvq_u32(missing) == 0;
+#else
+    uint64_t missing = 0;
+    for (size_t i = 0; i < storage_words_per_block; ++i) {
+        missing |= split_block_mask(k, i) & ~words[i];
+    }
+    return !missing;
+#endif
+}
+
+bool split_block_bloom_filter::is_present(const bytes_view& key) {
+    return is_present(make_hashed_key(key));
+}
+
+void split_block_bloom_filter::clear() {
+    for (auto& w : _storage) {
+        w = 0;
+    }
+}
+
+void split_block_bloom_filter::fold() {
+    storage_type folded;
+    folded.reserve(_storage.size() / 2);
+    for (size_t block = 0; block < _storage.size(); block += 2 * storage_words_per_block) {
+        for (size_t i = 0; i < storage_words_per_block; ++i) {
+            folded.push_back(_storage[block + i] | _storage[block + storage_words_per_block + i]);
+        }
+    }
+    _stats.memory_size -= memory_size();
+    _storage = std::move(folded);
+    _nr_blocks /= 2;
+    _stats.memory_size += memory_size();
+}
+
+// The number of blocks for num_elements, before rounding.
+static int64_t split_block_min_blocks(int64_t num_elements, double bits_per_element) {
+    return std::max<int64_t>(1, std::ceil(num_elements * bits_per_element / split_block_bloom_filter::bits_per_block));
+}
+
+void split_block_bloom_filter::shrink(int64_t num_elements, double max_false_pos_prob) {
+    auto min_blocks = uint64_t(split_block_min_blocks(num_elements, bloom_calculations::split_block_bits_per_element(max_false_pos_prob)));
+    while (_nr_blocks % 2 == 0 && _nr_blocks / 2 >= min_blocks) {
+        fold();
+    }
+}
+
+filter_ptr create_split_block_filter(split_block_bloom_filter::storage_type storage) {
+    if (storage.empty() || storage.size() % split_block_bloom_filter::storage_words_per_block) {
+        throw std::invalid_argument(format("Invalid split-block bloom filter size: {} words", storage.size()));
+    }
+    return std::make_unique<split_block_bloom_filter>(std::move(storage));
+}
+
+filter_ptr create_split_block_filter(int64_t num_elements, double bits_per_element) {
+    auto num_blocks = split_block_min_blocks(num_elements, bits_per_element);
+    // Filters of 1024 blocks or more get a multiple of 8 of them, for less
+    // than 1% of memory, so that shrink() can halve them up to three times.
+    if (num_blocks >= 1024) {
+        num_blocks = align_up<int64_t>(num_blocks, 8);
+    }
+    split_block_bloom_filter::storage_type storage;
+    storage.resize(num_blocks * split_block_bloom_filter::storage_words_per_block);
+    return std::make_unique<split_block_bloom_filter>(std::move(storage));
+}
 }
 }
@@ -72,6 +72,67 @@ struct murmur3_bloom_filter: public bloom_filter {
     {}
 };
 
+// A split-block bloom filter, see "Cache-, Hash- and Space-Efficient Bloom Filters"
+// by Putze, Sanders and Singler, and the Parquet bloom filter specification.
+//
+// The filter is an array of 256-bit blocks, each made of eight 32-bit words.
+// A key selects one block and sets a single bit in each of its words, so a
+// lookup touches one cache line. The eight bit positions are derived from the same
+// 32-bit hash with different multiplicative salts, which the compiler turns
+// into a few vector instructions.
+//
+// Blocks are stored as four consecutive 64-bit words of the storage, the
+// lower half of each storage word holding the even 32-bit word of the block.
+class split_block_bloom_filter: public i_filter {
+public:
+    static constexpr size_t words_per_block = 8;
+    static constexpr size_t bits_per_block = words_per_block * 32;
+    static constexpr size_t storage_words_per_block = words_per_block / 2;
+    using storage_type = utils::chunked_vector<uint64_t>;
+private:
+    storage_type _storage;
+    uint64_t _nr_blocks;
+
+    static thread_local struct stats {
+        uint64_t memory_size = 0;
+    } _shard_stats;
+    stats& _stats = _shard_stats;
+public:
+    explicit split_block_bloom_filter(storage_type storage) noexcept;
+    ~split_block_bloom_filter() noexcept;
+
+    uint64_t num_blocks() const noexcept { return _nr_blocks; }
+    const storage_type& get_storage() const noexcept { return _storage; }
+
+    virtual void add(const bytes_view& key) override;
+    virtual bool is_present(const bytes_view& key) override;
+    virtual bool is_present(hashed_key key) override;
+
+    virtual void clear() override;
+    virtual void close() override { }
+
+    virtual size_t memory_size() override {
+        return _storage.memory_size();
+    }
+
+    // Halves the filter while it has an even number of blocks and would still
+    // keep enough of them for num_elements. Every key maps to block k of the
+    // halved filter if it maps to block 2k or 2k + 1, so the halved filter is
+    // made by or-ing those blocks together.
+    virtual void shrink(int64_t num_elements, double max_false_pos_prob) override;
+
+    static const stats& get_shard_stats() noexcept {
+        return _shard_stats;
+    }
+private:
+    void add(hashed_key key);
+    void fold();
+    // Index in the storage of the first word of the block the hash maps to.
+    // The words of a block are contiguous, since a chunked_vector chunk
+    // holds a multiple of storage_words_per_block words.
+    size_t first_word_of_block(const std::array<uint64_t, 2>& h) const noexcept;
+};
+
 struct always_present_filter: public i_filter {
 
     virtual bool is_present(const bytes_view& key) override {
@@ -95,5 +156,7 @@ struct always_present_filter: public i_filter {
 
 filter_ptr create_filter(int hash, large_bitset&& bitset, filter_format format);
 filter_ptr create_filter(int hash, int64_t num_elements, int buckets_per, filter_format format);
+filter_ptr create_split_block_filter(split_block_bloom_filter::storage_type storage);
+filter_ptr create_split_block_filter(int64_t num_elements, double bits_per_element);
 }
 }
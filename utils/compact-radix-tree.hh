@@ -50,6 +50,29 @@ inline unsigned find_in_array<64>(uint8_t val, const uint8_t* arr) {
     return utils::array_search_x32_eq(val, arr, 2);
 }
 
+template <unsigned Size>
+inline unsigned find_min_gt_in_array(uint8_t val, const uint8_t* arr);
+
+template <>
+inline unsigned find_min_gt_in_array<4>(uint8_t val, const uint8_t* arr) {
+    return utils::array_search_4_min_gt(val, arr);
+}
+
+template <>
+inline unsigned find_min_gt_in_array<8>(uint8_t val, const uint8_t* arr) {
+    return utils::array_search_8_min_gt(val, arr);
+}
+
+template <>
+inline unsigned find_min_gt_in_array<16>(uint8_t val, const uint8_t* arr) {
+    return utils::array_search_16_min_gt(val, arr);
+}
+
+template <>
+inline unsigned find_min_gt_in_array<32>(uint8_t val, const uint8_t* arr) {
+    return utils::array_search_32_min_gt(val, arr);
+}
+
 // A union of any number of types.
 
 template <typename... Ts>
@@ -126,6 +149,7 @@ class tree {
     static constexpr unsigned node_index_limit = 1 << radix_bits;
     static_assert(node_index_limit != 0);
     static constexpr node_index_t unused_node_index = node_index_limit;
+    static_assert(unused_node_index == 128, "array searches rely on the unused index having the top bit set");
 
 private:
     /*
@@ -1315,14 +1339,9 @@ class tree {
                 }
             }
 
-            unsigned ui = Size;
-            for (unsigned i = 0; i < Size; i++) {
-                if (has(i) && _idx[i] > ni && (ui == Size || _idx[i] < _idx[ui])) {
-                    ui = i;
-                }
-            }
-
-            if (ui == Size) {
+            // The unused_node_index has the top bit set and is skipped
+            unsigned ui = find_min_gt_in_array<Size>(ni, _idx);
+            if (ui >= Size) {
                 return lower_bound_res();
             }
 
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/smp.hh>
+
+#include "utils/dma_buffer_pool.hh"
+
+namespace utils {
+
+static thread_local dma_buffer_pool the_dma_buffer_pool;
+static thread_local seastar::metrics::metric_groups dma_buffer_pool_metrics;
+
+dma_buffer_pool& local_dma_buffer_pool() noexcept {
+    return the_dma_buffer_pool;
+}
+
+dma_buffer_pool::~dma_buffer_pool() {
+    shrink(0);
+}
+
+size_t dma_buffer_pool::size_class(size_t size) noexcept {
+    return std::countr_zero(size) - std::countr_zero(min_size);
+}
+
+temporary_buffer<char> dma_buffer_pool::allocate(size_t size, size_t alignment) {
+    if (!_max_pooled_bytes || alignment > max_alignment || size < min_size || size > max_size || !std::has_single_bit(size)) {
+        ++_stats.unpooled;
+        return temporary_buffer<char>::aligned(alignment, size);
+    }
+    auto sc = size_class(size);
+    auto& bufs = _free[sc];
+    char* p;
+    if (!bufs.empty()) {
+        ++_stats.hits;
+        p = bufs.back();
+        bufs.pop_back();
+        _stats.pooled_bytes -= size;
+    } else {
+        ++_stats.misses;
+        void* ptr;
+        if (::posix_memalign(&ptr, max_alignment, size)) {
+            throw std::bad_alloc();
+        }
+        p = static_cast<char*>(ptr);
+    }
+    return temporary_buffer<char>(p, size, make_deleter([p, sc, shard = this_shard_id()] {
+        if (shard == this_shard_id()) {
+            local_dma_buffer_pool().release(p, sc);
+        } else {
+            ::free(p);
+        }
+    }));
+}
+
+void dma_buffer_pool::release(char* p, size_t sc) noexcept {
+    auto size = min_size << sc;
+    if (_stats.pooled_bytes + size <= _max_pooled_bytes) {
+        try {
+            _free[sc].push_back(p);
+            ++_stats.releases;
+            _stats.pooled_bytes += size;
+            return;
+        } catch (...) {
+            // Fall through, and free it.
+        }
+    }
+    ++_stats.drops;
+    ::free(p);
+}
+
+void dma_buffer_pool::shrink(size_t max_pooled_bytes) noexcept {
+    // Frees the largest buffers first, they are the cheapest to allocate again per byte.
+    for (size_t sc = size_classes; sc-- > 0 && _stats.pooled_bytes > max_pooled_bytes;) {
+        auto& bufs = _free[sc];
+        while (!bufs.empty() && _stats.pooled_bytes > max_pooled_bytes) {
+            ::free(bufs.back());
+            bufs.pop_back();
+            _stats.pooled_bytes -= min_size << sc;
+        }
+    }
+}
+
+void dma_buffer_pool::init(size_t max_pooled_bytes) {
+    _max_pooled_bytes = max_pooled_bytes;
+    shrink(max_pooled_bytes);
+
+    namespace sm = seastar::metrics;
+    dma_buffer_pool_metrics.clear();
+    dma_buffer_pool_metrics.add_group("dma_buffer_pool", {
+        sm::make_derive("hits", _stats.hits,
+            sm::description("Buffer allocations served by a pooled buffer")),
+        sm::make_derive("misses", _stats.misses,
+            sm::description("Buffer allocations of a pooled size which found no free buffer and went to the allocator")),
+        sm::make_derive("unpooled", _stats.unpooled,
+            sm::description("Buffer allocations of a size or alignment which isn't pooled")),
+        sm::make_derive("releases", _stats.releases,
+            sm::description("Buffers returned to the pool")),
+        sm::make_derive("drops", _stats.drops,
+            sm::description("Buffers freed on release because the pool was full. A high rate means the pool is too small for the write load")),
+        sm::make_gauge("pooled_bytes", _stats.pooled_bytes,
+            sm::description("Bytes held by free buffers in the pool")),
+        sm::make_gauge("max_pooled_bytes", [this] { return _max_pooled_bytes; },
+            sm::description("Bound on the bytes held by free buffers in the pool")),
+    });
+}
+
+} // namespace utils
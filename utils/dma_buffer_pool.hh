@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include "seastarx.hh"
+
+namespace utils {
+
+// A per-shard pool of DMA-aligned write buffers.
+//
+// Writers which allocate and drop large aligned buffers at a high rate, like
+// the commitlog segments, take them from the pool instead of the allocator.
+// A buffer goes back to the pool when the temporary_buffer holding it is
+// destroyed, so users need no explicit release.
+//
+// Only power of two sizes between min_size and max_size, aligned to at most
+// max_alignment, are pooled. Other requests are served by the allocator. The
+// pool keeps at most max_pooled_bytes of free buffers, buffers released past
+// it are freed. The pool is disabled, passing everything to the allocator,
+// until init() is called on the shard.
+class dma_buffer_pool {
+public:
+    static constexpr size_t min_size = 4 * 1024;
+    static constexpr size_t max_size = 1024 * 1024;
+    static constexpr size_t max_alignment = 4096;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t unpooled = 0;
+        uint64_t releases = 0;
+        uint64_t drops = 0;
+        uint64_t pooled_bytes = 0;
+    };
+private:
+    static constexpr size_t size_classes = std::countr_zero(max_size) - std::countr_zero(min_size) + 1;
+
+    std::array<std::vector<char*>, size_classes> _free;
+    size_t _max_pooled_bytes = 0;
+    stats _stats;
+private:
+    static size_t size_class(size_t size) noexcept;
+    void release(char* p, size_t size_class) noexcept;
+    void shrink(size_t max_pooled_bytes) noexcept;
+public:
+    dma_buffer_pool() = default;
+    dma_buffer_pool(const dma_buffer_pool&) = delete;
+    ~dma_buffer_pool();
+
+    // Returns an uninitialized buffer of the given size and alignment.
+    temporary_buffer<char> allocate(size_t size, size_t alignment);
+
+    // Sets the bound of the shard's pool, freeing buffers past it, and registers
+    // the pool's metrics. Can be called again to change the bound.
+    void init(size_t max_pooled_bytes);
+
+    size_t max_pooled_bytes() const noexcept { return _max_pooled_bytes; }
+    const stats& get_stats() const noexcept { return _stats; }
+};
+
+dma_buffer_pool& local_dma_buffer_pool() noexcept;
+
+} // namespace utils
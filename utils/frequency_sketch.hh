@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+// Estimates how many times a key was seen recently, with the count-min
+// sketch of TinyLFU.
+//
+// Every key maps to 4 counters of 4 bits each, one per hash function, and
+// its estimate is the least of them. Counters saturate at 15. After
+// 10 * counters() increments all counters are halved, so that the
+// estimates follow the recent history instead of the whole one.
+//
+// Keys are given as 64-bit hashes, which should be well mixed.
+class frequency_sketch {
+    static constexpr unsigned counters_per_word = 16;
+    static constexpr uint64_t seeds[] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL,
+    };
+
+    std::vector<uint64_t> _table;
+    uint64_t _mask;
+    uint64_t _additions = 0;
+    uint64_t _sample_size;
+private:
+    // Returns the index of the counter selected by the i-th hash function.
+    uint64_t counter_index(uint64_t hash, unsigned i) const noexcept {
+        uint64_t h = (hash + seeds[i]) * seeds[i];
+        h ^= h >> 32;
+        return h & _mask;
+    }
+
+    unsigned get(uint64_t index) const noexcept {
+        return (_table[index / counters_per_word] >> (index % counters_per_word * 4)) & 0xf;
+    }
+
+    void age() noexcept {
+        for (auto& w : _table) {
+            w = (w >> 1) & 0x7777777777777777ULL;
+        }
+        _additions /= 2;
+    }
+public:
+    // The number of counters is rounded up to a power of two.
+    explicit frequency_sketch(uint64_t counters = 1 << 16)
+        : _table(std::bit_ceil(std::max<uint64_t>(counters, counters_per_word)) / counters_per_word)
+        , _mask(_table.size() * counters_per_word - 1)
+        , _sample_size(10 * (_mask + 1))
+    { }
+
+    uint64_t counters() const noexcept {
+        return _mask + 1;
+    }
+
+    unsigned frequency(uint64_t hash) const noexcept {
+        unsigned f = 15;
+        for (unsigned i = 0; i < std::size(seeds); ++i) {
+            f = std::min(f, get(counter_index(hash, i)));
+        }
+        return f;
+    }
+
+    // Counts one more occurrence of the key. Only the least of its counters
+    // are incremented (conservative update), which keeps the estimates of
+    // other keys sharing the others more accurate.
+    void increment(uint64_t hash) noexcept {
+        auto f = frequency(hash);
+        if (f == 15) {
+            return;
+        }
+        for (unsigned i = 0; i < std::size(seeds); ++i) {
+            auto index = counter_index(hash, i);
+            if (get(index) == f) {
+                _table[index / counters_per_word] += uint64_t(1) << (index % counters_per_word * 4);
+            }
+        }
+        if (++_additions >= _sample_size) {
+            age();
+        }
+    }
+};
+
+} // namespace utils
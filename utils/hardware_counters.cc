@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <linux/perf_event.h>
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/smp.hh>
+
+#include "utils/hardware_counters.hh"
+#include "log.hh"
+
+namespace utils {
+
+static logging::logger hclogger("hardware_counters");
+
+hardware_counters::hardware_counters() {
+    namespace sm = seastar::metrics;
+
+    auto add = [this] (const char* name, const char* description, uint64_t config) {
+        auto event = linux_perf_event::scaled_user_hardware_event(config);
+        if (!event.valid()) {
+            if (this_shard_id() == 0) {
+                hclogger.info("Hardware event {} is not available, it won't be exported", name);
+            }
+            return;
+        }
+        _counters.push_back(counter{name, description, std::move(event)});
+    };
+    add("instructions", "Instructions retired in user space by the reactor thread.", PERF_COUNT_HW_INSTRUCTIONS);
+    add("cycles", "CPU cycles spent in user space by the reactor thread.", PERF_COUNT_HW_CPU_CYCLES);
+    add("llc_misses", "Last level cache misses in user space by the reactor thread.", PERF_COUNT_HW_CACHE_MISSES);
+    add("branch_misses", "Mispredicted branches in user space by the reactor thread.", PERF_COUNT_HW_BRANCH_MISSES);
+
+    for (size_t i = 0; i < _counters.size(); ++i) {
+        _metrics.add_group("hardware", {
+            sm::make_derive(_counters[i].name, [this, i] { return _counters[i].event.read(); },
+                    sm::description(_counters[i].description)),
+        });
+    }
+}
+
+} // namespace utils
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
+
+#include "seastarx.hh"
+#include "utils/linux-perf-event.hh"
+
+namespace utils {
+
+// Counts the instructions, cycles, last level cache misses and branch
+// mispredictions of the reactor thread of this shard, in user space, and
+// exports them as metrics, from which IPC and miss rates can be derived.
+//
+// The counters are read only when the metrics are collected. Events that
+// can't be opened, as in containers or virtual machines without access to
+// the PMU, are not exported.
+class hardware_counters {
+    struct counter {
+        const char* name;
+        const char* description;
+        linux_perf_event event;
+    };
+    std::vector<counter> _counters;
+    seastar::metrics::metric_groups _metrics;
+public:
+    hardware_counters();
+    future<> stop() {
+        return make_ready_future<>();
+    }
+};
+
+} // namespace utils
@@ -23,6 +23,9 @@ using filter_ptr = std::unique_ptr<i_filter>;
 enum class filter_format {
     k_l_format,
     m_format,
+    // Split-block bloom filter: all probes of a key fall into a single block
+    // which fits in a cache line. Recorded in the Scylla component.
+    split_block_format,
 };
 
 class hashed_key {
@@ -48,6 +51,13 @@ struct i_filter {
 
     virtual size_t memory_size() = 0;
 
+    /**
+     * Shrinks the filter towards the size get_filter() gives for num_elements,
+     * as far as that is possible without losing the keys already added. Used
+     * when fewer keys were added than the filter was created for.
+     */
+    virtual void shrink(int64_t num_elements, double max_false_pos_prob) { }
+
     /**
      * @return The smallest bloom_filter that can provide the given false
      *         positive probability rate for the given number of elements.
@@ -824,6 +824,23 @@ class tree {
                 return nullptr;
             }
         }
+
+        /*
+         * Returns pointer on the owning tree. Walks up from the
+         * element's node to the root, so takes O(height).
+         */
+        tree_ptr tree_slow() noexcept {
+            node_base_ptr n = revalidate();
+
+            if (n->is_inline()) {
+                return tree::from_inline(n);
+            }
+            node_ptr nd = node::from_base(n);
+            while (!nd->is_root()) {
+                nd = nd->_parent.n;
+            }
+            return nd->_parent.t;
+        }
     };
 
     using iterator_base_const = iterator_base<true>;
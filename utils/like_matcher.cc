@@ -12,6 +12,8 @@
 
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
+#include <cstring>
+#include <optional>
 #include <string>
 
 namespace {
@@ -75,27 +77,115 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// Patterns which are a literal, optionally with '%' at either end.
+enum class literal_kind {
+    exact,    // abc
+    prefix,   // abc%
+    suffix,   // %abc
+    contains, // %abc%
+};
+
+struct literal_pattern {
+    literal_kind kind;
+    bytes literal; // Unescaped.
+};
+
+/// Returns the literal_pattern equivalent to the given LIKE pattern, if there is one.
+///
+/// The wildcards and the escape character are all ASCII, so they can't be a part of
+/// a multi-byte UTF-8 character, and the pattern can be examined byte by byte.
+std::optional<literal_pattern> literal_from_pattern(bytes_view pattern) {
+    size_t leading = 0;
+    while (leading < pattern.size() && pattern[leading] == '%') {
+        ++leading;
+    }
+    bytes literal;
+    bool trailing = false;
+    for (size_t i = leading; i < pattern.size(); ++i) {
+        if (trailing) {
+            // Either '%' or, with something after a '%', not a literal pattern.
+            if (pattern[i] != '%') {
+                return std::nullopt;
+            }
+            continue;
+        }
+        switch (pattern[i]) {
+        case '_':
+            return std::nullopt;
+        case '%':
+            trailing = true;
+            break;
+        case '\\':
+            // A backslash at the end of the pattern matches itself.
+            if (i + 1 < pattern.size()) {
+                ++i;
+            }
+            literal.push_back(pattern[i]);
+            break;
+        default:
+            literal.push_back(pattern[i]);
+            break;
+        }
+    }
+    if (leading && (trailing || literal.empty())) {
+        return literal_pattern{literal_kind::contains, std::move(literal)};
+    } else if (leading) {
+        return literal_pattern{literal_kind::suffix, std::move(literal)};
+    } else if (trailing) {
+        return literal_pattern{literal_kind::prefix, std::move(literal)};
+    }
+    return literal_pattern{literal_kind::exact, std::move(literal)};
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
-    boost::u32regex _re; // Performs pattern matching.
+    // Set for patterns which need no regex; matched by comparing bytes.
+    std::optional<literal_pattern> _literal;
+    std::optional<boost::u32regex> _re; // Performs pattern matching for all other patterns.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
     void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        // Translated even for literal patterns, since that's what rejects invalid UTF-8.
+        auto re = regex_from_pattern(_pattern);
+        _literal = literal_from_pattern(_pattern);
+        if (_literal) {
+            _re.reset();
+        } else {
+            _re = boost::make_u32regex(re, boost::u32regex::basic | boost::u32regex::optimize);
+        }
     }
+    bool match_literal(bytes_view text) const;
 };
 
 like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
     init_re();
 }
 
+bool like_matcher::impl::match_literal(bytes_view text) const {
+    bytes_view literal = _literal->literal;
+    switch (_literal->kind) {
+    case literal_kind::exact:
+        return text == literal;
+    case literal_kind::prefix:
+        return text.starts_with(literal);
+    case literal_kind::suffix:
+        return text.ends_with(literal);
+    case literal_kind::contains:
+        return literal.empty() || ::memmem(text.data(), text.size(), literal.data(), literal.size());
+    }
+    __builtin_unreachable();
+}
+
 bool like_matcher::impl::operator()(bytes_view text) const {
-    return boost::u32regex_match(text.begin(), text.end(), _re);
+    if (_literal) {
+        return match_literal(text);
+    }
+    return boost::u32regex_match(text.begin(), text.end(), *_re);
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
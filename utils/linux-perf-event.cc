@@ -7,7 +7,7 @@
  */
 
 
-#include "linux-perf-event.hh"
+#include "utils/linux-perf-event.hh"
 
 #include <linux/perf_event.h>
 #include <linux/hw_breakpoint.h>
@@ -19,6 +19,7 @@ linux_perf_event::linux_perf_event(const struct ::perf_event_attr& attr, pid_t p
     if (ret != -1) {
         _fd = ret; // ignore failures, can happen in constrained environments such as containers
     }
+    _scaled = attr.read_format & PERF_FORMAT_TOTAL_TIME_RUNNING;
 }
 
 linux_perf_event::~linux_perf_event() {
@@ -34,6 +35,7 @@ linux_perf_event::operator=(linux_perf_event&& x) noexcept {
             ::close(_fd);
         }
         _fd = std::exchange(x._fd, -1);
+        _scaled = x._scaled;
     }
     return *this;
 }
@@ -43,6 +45,18 @@ linux_perf_event::read() {
     if (_fd == -1) {
         return 0;
     }
+    if (_scaled) {
+        struct {
+            uint64_t value;
+            uint64_t time_enabled;
+            uint64_t time_running;
+        } ret{};
+        ::read(_fd, &ret, sizeof(ret));
+        if (!ret.time_running) {
+            return 0;
+        }
+        return double(ret.value) * ret.time_enabled / ret.time_running;
+    }
     uint64_t ret;
     ::read(_fd, &ret, sizeof(ret));
     return ret;
@@ -75,3 +89,27 @@ linux_perf_event::user_instructions_retired() {
             .exclude_hv = 1,
             }, 0, -1, -1, 0);
 }
+
+linux_perf_event
+linux_perf_event::user_cpu_cycles() {
+    return linux_perf_event(perf_event_attr{
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(struct perf_event_attr),
+            .config = PERF_COUNT_HW_CPU_CYCLES,
+            .disabled = 1,
+            .exclude_kernel = 1,
+            .exclude_hv = 1,
+            }, 0, -1, -1, 0);
+}
+
+linux_perf_event
+linux_perf_event::scaled_user_hardware_event(uint64_t config) {
+    return linux_perf_event(perf_event_attr{
+            .type = PERF_TYPE_HARDWARE,
+            .size = sizeof(struct perf_event_attr),
+            .config = config,
+            .read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING,
+            .exclude_kernel = 1,
+            .exclude_hv = 1,
+            }, 0, -1, -1, 0);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2021-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+
+#include <cstdint>
+#include <utility>
+#include <unistd.h>
+
+struct perf_event_attr; // from <linux/perf_event.h>
+
+class linux_perf_event {
+    int _fd = -1;
+    // Opened with PERF_FORMAT_TOTAL_TIME_ENABLED and PERF_FORMAT_TOTAL_TIME_RUNNING,
+    // so that read() can make up for the time the event wasn't counted.
+    bool _scaled = false;
+public:
+    linux_perf_event(const struct ::perf_event_attr& attr, pid_t pid, int cpu, int group_fd, unsigned long flags);
+    linux_perf_event(linux_perf_event&& x) noexcept : _fd(std::exchange(x._fd, -1)), _scaled(x._scaled) {}
+    linux_perf_event& operator=(linux_perf_event&& x) noexcept;
+    ~linux_perf_event();
+    // False if the event could not be opened, in which case read() returns 0.
+    bool valid() const noexcept { return _fd != -1; }
+    uint64_t read();
+    void enable();
+    void disable();
+public:
+    static linux_perf_event user_instructions_retired();
+    static linux_perf_event user_cpu_cycles();
+
+    // Counting events of the calling thread in user space, which are enabled
+    // and, since there may be more events than hardware counters, scaled
+    // according to the share of the time they were counted.
+    static linux_perf_event scaled_user_hardware_event(uint64_t config);
+};
+
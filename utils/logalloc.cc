@@ -26,6 +26,7 @@
 #include <seastar/core/with_scheduling_group.hh>
 #include <seastar/util/alloc_failure_injector.hh>
 #include <seastar/util/backtrace.hh>
+#include <seastar/util/defer.hh>
 #include <seastar/util/later.hh>
 
 #include "utils/logalloc.hh"
@@ -38,6 +39,8 @@
 
 #include <random>
 #include <chrono>
+#include <cstring>
+#include <sys/mman.h>
 
 using namespace std::chrono_literals;
 
@@ -362,19 +365,23 @@ static thread_local tracker& tracker_instance = get_tracker_instance();
 
 using clock = std::chrono::steady_clock;
 
+// Keeps the given amount of memory free ahead of demand, so that
+// the allocations of foreground work rarely have to reclaim synchronously.
 class background_reclaimer {
     scheduling_group _sg;
-    noncopyable_function<void (size_t target)> _reclaim;
+    noncopyable_function<size_t (size_t target)> _reclaim;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
+    size_t _free_memory_threshold;
     future<> _done;
     bool _stopping = false;
-    static constexpr size_t free_memory_threshold = 60'000'000;
+    uint64_t _reclaims = 0;
+    uint64_t _memory_reclaimed = 0;
 private:
     bool have_work() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
-        return memory::stats().free_memory() < free_memory_threshold;
+        return memory::stats().free_memory() < _free_memory_threshold;
 #else
         return false;
 #endif
@@ -400,14 +407,15 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::stats().free_memory());
+            ++_reclaims;
+            _memory_reclaimed += _reclaim(_free_memory_threshold - memory::stats().free_memory());
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
     }
     void adjust_shares() {
         if (have_work()) {
-            auto shares = 1 + (1000 * (free_memory_threshold - memory::stats().free_memory())) / free_memory_threshold;
+            auto shares = 1 + (1000 * (_free_memory_threshold - memory::stats().free_memory())) / _free_memory_threshold;
             _sg.set_shares(shares);
             llogger.trace("background_reclaimer::adjust_shares: {}", shares);
             if (_main_loop_wait) {
@@ -416,10 +424,11 @@ class background_reclaimer {
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    background_reclaimer(scheduling_group sg, size_t free_memory_threshold, noncopyable_function<size_t (size_t target)> reclaim)
             : _sg(sg)
             , _reclaim(std::move(reclaim))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
+            , _free_memory_threshold(free_memory_threshold)
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
             _adjust_shares_timer.arm_periodic(50ms);
@@ -430,6 +439,8 @@ class background_reclaimer {
         main_loop_wake();
         return std::move(_done);
     }
+    uint64_t reclaims() const noexcept { return _reclaims; }
+    uint64_t memory_reclaimed() const noexcept { return _memory_reclaimed; }
 };
 
 class tracker::impl {
@@ -439,6 +450,8 @@ class tracker::impl {
     bool _reclaiming_enabled = true;
     size_t _reclamation_step = 1;
     bool _abort_on_bad_alloc = false;
+    uint64_t _foreground_reclaims = 0;
+    utils::coarse_steady_clock::duration _largest_reclaim_duration{};
 private:
     // Prevents tracker's reclaimer from running while live. Reclaimer may be
     // invoked synchronously with allocator. This guard ensures that this
@@ -489,12 +502,24 @@ class tracker::impl {
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc() { _abort_on_bad_alloc = true; }
     bool should_abort_on_bad_alloc() const { return _abort_on_bad_alloc; }
-    void setup_background_reclaim(scheduling_group sg) {
+    void setup_background_reclaim(scheduling_group sg, size_t free_memory_threshold) {
         assert(!_background_reclaimer);
-        _background_reclaimer.emplace(sg, [this] (size_t target) {
-            reclaim(target, is_preemptible::yes);
+        if (!free_memory_threshold) {
+            return;
+        }
+        _background_reclaimer.emplace(sg, free_memory_threshold, [this] (size_t target) {
+            return reclaim(target, is_preemptible::yes);
         });
     }
+    // Counts the reclaims done synchronously with an allocation.
+    void on_foreground_reclaim() noexcept { ++_foreground_reclaims; }
+    void on_reclaim_cycle(utils::coarse_steady_clock::duration d) noexcept {
+        _largest_reclaim_duration = std::max(_largest_reclaim_duration, d);
+    }
+    std::chrono::microseconds largest_reclaim_duration() const noexcept {
+        return std::chrono::duration_cast<std::chrono::microseconds>(_largest_reclaim_duration);
+    }
+    std::vector<region_stats> get_region_stats();
 private:
     // Like compact_and_evict() but assumes that reclaim_lock is held around the operation.
     size_t compact_and_evict_locked(size_t reserve_segments, size_t bytes, is_preemptible preempt);
@@ -537,6 +562,14 @@ size_t tracker::non_lsa_used_space() const {
     return _impl->non_lsa_used_space();
 }
 
+std::vector<region_stats> tracker::get_region_stats() {
+    return _impl->get_region_stats();
+}
+
+std::chrono::microseconds tracker::largest_reclaim_duration() const {
+    return _impl->largest_reclaim_duration();
+}
+
 void tracker::full_compaction() {
     return _impl->full_compaction();
 }
@@ -688,6 +721,23 @@ class segment_store {
     bool can_allocate_more_segments() {
         return memory::stats().free_memory() >= non_lsa_reserve + segment::size;
     }
+    // Asks the kernel to back the memory in which segments live with
+    // transparent huge pages. Segments are allocated anywhere in the
+    // shard's memory, so this covers all of it.
+    // Returns the number of bytes advised, 0 on failure.
+    size_t advise_huge_pages() const {
+        constexpr uintptr_t huge_page_size = 2 << 20;
+        auto start = align_up(_layout.start, huge_page_size);
+        auto end = align_down(_layout.end, huge_page_size);
+        if (start >= end) {
+            return 0;
+        }
+        if (::madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE)) {
+            llogger.warn("Failed to enable transparent huge pages for LSA memory: {}", strerror(errno));
+            return 0;
+        }
+        return end - start;
+    }
 };
 #else
 class segment_store {
@@ -745,6 +795,9 @@ class segment_store {
         auto i = find_empty();
         return i != _segments.end();
     }
+    size_t advise_huge_pages() const {
+        return 0;
+    }
 };
 #endif
 
@@ -781,6 +834,7 @@ class segment_pool {
     };
 
     size_t _non_lsa_memory_in_use = 0;
+    size_t _huge_pages_advised = 0;
     // Invariants - a segment is in one of the following states:
     //   In use by some region
     //     - set in _lsa_owned_segments_bitmap
@@ -841,6 +895,13 @@ class segment_pool {
     size_t non_lsa_memory_in_use() const {
         return _non_lsa_memory_in_use;
     }
+    void advise_huge_pages() {
+        _huge_pages_advised = _store.advise_huge_pages();
+    }
+    // The memory advised to be backed by transparent huge pages, see segment_store::advise_huge_pages().
+    size_t huge_pages_advised() const {
+        return _huge_pages_advised;
+    }
     size_t total_memory_in_use() const {
         return _non_lsa_memory_in_use + _segments_in_use * segment::size;
     }
@@ -1272,6 +1333,12 @@ class region_impl final : public basic_region_impl {
     region_sanitizer _sanitizer;
     uint64_t _id;
     eviction_fn _eviction_fn;
+    sstring _owner;
+    uint64_t _segments_compacted = 0;
+    uint64_t _memory_compacted = 0;
+    uint64_t _memory_evicted = 0;
+    uint64_t _allocating_section_retries = 0;
+    clock::duration _allocating_section_retry_time{};
 
     region_group::region_heap::handle_type _heap_handle;
 private:
@@ -1486,6 +1553,8 @@ class region_impl final : public basic_region_impl {
 
         free_segment(seg, desc);
         shard_segment_pool.on_segment_compaction(seg_occupancy.used_space());
+        ++_segments_compacted;
+        _memory_compacted += seg_occupancy.used_space();
     }
 
     void close_and_open() {
@@ -1849,10 +1918,39 @@ class region_impl final : public basic_region_impl {
         ++_invalidate_counter;
         auto freed = shard_segment_pool.statistics().memory_freed;
         auto ret = _eviction_fn();
-        shard_segment_pool.on_memory_eviction(shard_segment_pool.statistics().memory_freed - freed);
+        auto evicted = shard_segment_pool.statistics().memory_freed - freed;
+        shard_segment_pool.on_memory_eviction(evicted);
+        _memory_evicted += evicted;
         return ret;
     }
 
+    void set_owner(sstring owner) {
+        _owner = std::move(owner);
+    }
+
+    void on_allocating_section_retry(clock::duration d) noexcept {
+        ++_allocating_section_retries;
+        _allocating_section_retry_time += d;
+    }
+
+    region_stats stats() const {
+        region_stats st{};
+        st.id = _id;
+        st.owner = _owner;
+        st.evictable = _evictable;
+        st.occupancy = occupancy();
+        for (const segment_descriptor& desc : _segment_descs) {
+            auto bucket = std::min<size_t>(desc.occupancy().used_fraction() * st.occupancy_histogram.size(), st.occupancy_histogram.size() - 1);
+            ++st.occupancy_histogram[bucket];
+        }
+        st.segments_compacted = _segments_compacted;
+        st.memory_compacted = _memory_compacted;
+        st.memory_evicted = _memory_evicted;
+        st.allocating_section_retries = _allocating_section_retries;
+        st.allocating_section_retry_time = std::chrono::duration_cast<std::chrono::microseconds>(_allocating_section_retry_time);
+        return st;
+    }
+
     void make_not_evictable() {
         _evictable = false;
         _eviction_fn = {};
@@ -1922,14 +2020,18 @@ void tracker::configure(const config& cfg) {
     }
 
     _impl->set_reclamation_step(cfg.lsa_reclamation_step);
+    if (cfg.transparent_huge_pages) {
+        shard_segment_pool.advise_huge_pages();
+    }
     if (cfg.abort_on_lsa_bad_alloc) {
         _impl->enable_abort_on_bad_alloc();
     }
-    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group);
+    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group, cfg.background_reclaim_free_memory);
     s_sanitizer_report_backtrace = cfg.sanitizer_report_backtrace;
 }
 
 memory::reclaiming_result tracker::reclaim(seastar::memory::reclaimer::request r) {
+    _impl->on_foreground_reclaim();
     return reclaim(std::max(r.bytes_to_reclaim, _impl->reclamation_step() * segment::size))
            ? memory::reclaiming_result::reclaimed_something
            : memory::reclaiming_result::reclaimed_nothing;
@@ -1973,6 +2075,10 @@ occupancy_stats region::occupancy() const {
     return get_impl().occupancy();
 }
 
+void region::set_owner(sstring owner) {
+    get_impl().set_owner(std::move(owner));
+}
+
 region_group* region::group() {
     return get_impl().group();
 }
@@ -2020,6 +2126,16 @@ std::ostream& operator<<(std::ostream& out, const occupancy_stats& stats) {
         stats.used_fraction() * 100, stats.used_space(), stats.total_space());
 }
 
+std::vector<region_stats> tracker::impl::get_region_stats() {
+    reclaiming_lock _(*this);
+    std::vector<region_stats> res;
+    res.reserve(_regions.size());
+    for (auto&& r : _regions) {
+        res.push_back(r->stats());
+    }
+    return res;
+}
+
 occupancy_stats tracker::impl::region_occupancy() {
     reclaiming_lock _(*this);
     occupancy_stats total{};
@@ -2133,6 +2249,10 @@ class reclaim_timer {
     const bool _debug_enabled;
     bool _stall_detected = false;
 
+    // The activity which needed the memory.
+    const utils::stall_activity _activity = utils::current_stall_activity();
+    utils::stall_activity_scope _activity_scope{utils::stall_activity::lsa_reclaim};
+
     size_t _memory_released = 0;
 
     clock::time_point _start;
@@ -2161,6 +2281,7 @@ class reclaim_timer {
 
     ~reclaim_timer() {
         _duration = clock::now() - _start;
+        _tracker.on_reclaim_cycle(_duration);
         _stall_detected = _duration >= engine().get_blocked_reactor_notify_ms();
         if (_debug_enabled || _stall_detected) {
             report();
@@ -2192,8 +2313,8 @@ class reclaim_timer {
         auto info_level = _stall_detected ? log_level::info : log_level::debug;
         auto MiB = 1024*1024;
 
-        timing_logger.log(time_level, "Reclamation cycle took {} us, trying to release {:.3f} MiB {}preemptibly",
-                          _duration / 1us, (float)_memory_to_release / MiB, _preemptible ? "" : "non-");
+        timing_logger.log(time_level, "Reclamation cycle took {} us, trying to release {:.3f} MiB {}preemptibly, during {}",
+                          _duration / 1us, (float)_memory_to_release / MiB, _preemptible ? "" : "non-", utils::to_string(_activity));
         log_if_any(info_level, "reserved segments", _reserve_segments);
         if (_memory_released > 0) {
             auto bytes_per_second =
@@ -2465,6 +2586,21 @@ tracker::impl::impl() {
 
         sm::make_derive("memory_freed", [] { return shard_segment_pool.statistics().memory_freed; },
                         sm::description("Counts number of bytes which were requested to be freed in LSA.")),
+
+        sm::make_gauge("huge_pages_advised_bytes", [] { return shard_segment_pool.huge_pages_advised(); },
+                       sm::description("Holds the amount of memory which LSA asked to be backed by transparent huge pages.")),
+
+        sm::make_gauge("largest_reclaim_duration_us", [this] { return largest_reclaim_duration().count(); },
+                       sm::description("Holds the duration of the longest reclamation cycle, in microseconds.")),
+
+        sm::make_derive("foreground_reclaims", [this] { return _foreground_reclaims; },
+                        sm::description("Counts the reclaims done synchronously, because an allocation couldn't be satisfied from free memory.")),
+
+        sm::make_derive("background_reclaims", [this] { return _background_reclaimer ? _background_reclaimer->reclaims() : 0; },
+                        sm::description("Counts the reclaims done by the background reclaimer to keep free memory ahead of demand.")),
+
+        sm::make_derive("memory_reclaimed_in_background", [this] { return _background_reclaimer ? _background_reclaimer->memory_reclaimed() : 0; },
+                        sm::description("Counts number of bytes which were reclaimed by the background reclaimer.")),
     });
 }
 
@@ -2681,6 +2817,10 @@ void allocating_section::reserve() {
 }
 
 void allocating_section::on_alloc_failure(logalloc::region& r) {
+    auto start = clock::now();
+    auto account = defer([&] () noexcept {
+        r.get_impl().on_allocating_section_retry(clock::now() - start);
+    });
     r.allocator().invalidate_references();
     if (shard_segment_pool.allocation_failure_flag()) {
         _lsa_reserve *= 2;
@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include <seastar/core/memory.hh>
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/smp.hh>
@@ -20,10 +23,12 @@
 #include "seastarx.hh"
 #include "db/timeout_clock.hh"
 #include "utils/entangled.hh"
+#include "utils/stall_activity.hh"
 
 namespace logalloc {
 
 struct occupancy_stats;
+struct region_stats;
 class region;
 class region_impl;
 class allocating_section;
@@ -422,6 +427,10 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // The free memory which the background reclaimer keeps, 0 disables it.
+        size_t background_reclaim_free_memory = 60'000'000;
+        // Advise the kernel to back the memory of segments with transparent huge pages.
+        bool transparent_huge_pages = false;
     };
 
     void configure(const config& cfg);
@@ -464,6 +473,12 @@ class tracker {
     // Returns amount of allocated memory not managed by LSA
     size_t non_lsa_used_space() const;
 
+    // Returns statistics of every region on this shard.
+    std::vector<region_stats> get_region_stats();
+
+    // Returns the duration of the longest reclamation cycle so far.
+    std::chrono::microseconds largest_reclaim_duration() const;
+
     impl& get_impl() { return *_impl; }
 
     // Returns the minimum number of segments reclaimed during single reclamation cycle.
@@ -599,6 +614,24 @@ class occupancy_stats {
     friend std::ostream& operator<<(std::ostream&, const occupancy_stats&);
 };
 
+// Statistics of a single region, see tracker::get_region_stats().
+struct region_stats {
+    uint64_t id;
+    // Set with region::set_owner(), empty if never set.
+    sstring owner;
+    bool evictable;
+    occupancy_stats occupancy;
+    // The number of closed segments by their used fraction, in steps of 10%.
+    std::array<uint64_t, 10> occupancy_histogram;
+    uint64_t segments_compacted;
+    uint64_t memory_compacted;
+    uint64_t memory_evicted;
+    // Retries of allocating sections after allocation failures in the region,
+    // and the time spent increasing the reserves for them.
+    uint64_t allocating_section_retries;
+    std::chrono::microseconds allocating_section_retry_time;
+};
+
 class basic_region_impl : public allocation_strategy {
 protected:
     bool _reclaiming_enabled = true;
@@ -656,6 +689,10 @@ class region {
 
     region_group* group();
 
+    // Tags the region with what its memory is used for, like "cache" or
+    // "memtable ks.cf", for reporting in its region_stats.
+    void set_owner(sstring owner);
+
     // Allocates a buffer of a given size.
     // The buffer's pointer will be aligned to 4KB.
     // Note: it is wasteful to allocate buffers of sizes which are not a multiple of the alignment.
@@ -814,6 +851,7 @@ class allocating_section {
     //
     template<typename Func>
     decltype(auto) operator()(logalloc::region& r, Func&& func) {
+        utils::stall_activity_scope activity(utils::stall_activity::allocating_section);
         return with_reserve([this, &r, &func] {
             return with_reclaiming_disabled(r, func);
         });
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <boost/intrusive/list.hpp>
+#include <cstdint>
 #include <seastar/core/memory.hh>
 
 class evictable {
@@ -26,6 +27,13 @@ class evictable {
 
     virtual void on_evicted() noexcept = 0;
 
+    // Called when the element is about to be evicted. An element which
+    // should be kept for now can move itself elsewhere in the LRU and
+    // return true, and is then not evicted, see lru::evict().
+    virtual bool defer_eviction() noexcept {
+        return false;
+    }
+
     bool is_linked() const {
         return _lru_link.is_linked();
     }
@@ -39,6 +47,17 @@ class evictable {
     }
 };
 
+// A segmented LRU.
+//
+// Elements are kept in one of two segments: the protected one, which add()
+// and touch() use, and the probationary one, which holds elements not known
+// to be worth keeping yet (see add_probationary()). Eviction takes from the
+// probationary segment first, so that a stream of elements used once (like
+// the rows populated by a scan) displaces itself rather than the elements
+// which are used repeatedly.
+//
+// The LRU doesn't know which segment an element is in, users which need
+// it track it themselves.
 class lru {
 private:
     friend class evictable;
@@ -46,37 +65,75 @@ class lru {
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
     lru_type _list;
+    lru_type _probation;
+    uint64_t _probationary_evictions = 0;
 public:
+    static constexpr unsigned max_deferrals = 16;
+
     using reclaiming_result = seastar::memory::reclaiming_result;
 
     ~lru() {
-        _list.clear_and_dispose([] (evictable* e) {
+        auto dispose = [] (evictable* e) {
             e->on_evicted();
-        });
+        };
+        _probation.clear_and_dispose(dispose);
+        _list.clear_and_dispose(dispose);
     }
 
+    // Works for elements of either segment.
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        e._lru_link.unlink();
     }
 
     void add(evictable& e) noexcept {
         _list.push_back(e);
     }
 
+    void add_probationary(evictable& e) noexcept {
+        _probation.push_back(e);
+    }
+
+    // Moves the element to the front of the protected segment.
     void touch(evictable& e) noexcept {
         remove(e);
         add(e);
     }
 
+    // Moves the element to the front of the probationary segment.
+    void touch_probationary(evictable& e) noexcept {
+        remove(e);
+        add_probationary(e);
+    }
+
     // Evicts a single element from the LRU
+    //
+    // Up to max_deferrals elements which defer their eviction are skipped,
+    // after which the next element is evicted regardless, so that eviction
+    // always makes progress.
     reclaiming_result evict() noexcept {
-        if (_list.empty()) {
-            return reclaiming_result::reclaimed_nothing;
+        for (unsigned deferrals = 0; ; ++deferrals) {
+            lru_type* l = &_probation;
+            if (l->empty()) {
+                l = &_list;
+                if (l->empty()) {
+                    return reclaiming_result::reclaimed_nothing;
+                }
+            }
+            evictable& e = l->front();
+            if (deferrals < max_deferrals && e.defer_eviction()) {
+                continue;
+            }
+            if (l == &_probation) {
+                ++_probationary_evictions;
+            }
+            l->pop_front();
+            e.on_evicted();
+            return reclaiming_result::reclaimed_something;
         }
-        evictable& e = _list.front();
-        _list.pop_front();
-        e.on_evicted();
-        return reclaiming_result::reclaimed_something;
+    }
+
+    uint64_t probationary_evictions() const noexcept {
+        return _probationary_evictions;
     }
 
     // Evicts all elements.
@@ -72,7 +72,13 @@ struct blob_storage {
 
 // A managed version of "bytes" (can be used with LSA).
 class managed_bytes {
-    static constexpr size_t max_inline_size = 15;
+public:
+    // Values up to this size are stored in the object itself. It is chosen
+    // so that the common cells, a UUID, timestamp or short string value
+    // behind the atomic cell header, fit, and don't pay for a blob_storage
+    // of their own, whose header is bigger than the value.
+    static constexpr size_t max_inline_size = 31;
+private:
     struct small_blob {
         bytes_view::value_type data[max_inline_size];
         int8_t size; // -1 -> use blob_storage
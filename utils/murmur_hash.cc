@@ -9,6 +9,9 @@
  * SPDX-License-Identifier: (AGPL-3.0-or-later and Apache-2.0)
  */
 
+#include <algorithm>
+#include <limits>
+
 #include "murmur_hash.hh"
 
 namespace utils {
@@ -142,32 +145,32 @@ static inline uint64_t getblock(bytes_view key, uint32_t index)
             | (uint64_t(p[7]) << 56);
 }
 
-void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+static constexpr uint64_t c1 = 0x87c37b91114253d5L;
+static constexpr uint64_t c2 = 0x4cf5ad432745937fL;
+
+static inline void mix_block(uint64_t k1, uint64_t k2, uint64_t& h1, uint64_t& h2)
 {
-    uint32_t length = key.size();
-    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
+    k1 *= c1; k1 = rotl64(k1,31); k1 *= c2; h1 ^= k1;
+
+    h1 = rotl64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+
+    k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2 ^= k2;
 
-    uint64_t h1 = seed;
-    uint64_t h2 = seed;
+    h2 = rotl64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+}
 
-    uint64_t c1 = 0x87c37b91114253d5L;
-    uint64_t c2 = 0x4cf5ad432745937fL;
+// Finishes hashing key, whose blocks before first_block were already mixed into h1 and h2.
+static void hash3_x64_128_from(bytes_view key, uint32_t first_block, uint64_t h1, uint64_t h2, std::array<uint64_t,2> &result)
+{
+    uint32_t length = key.size();
+    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
 
     //----------
     // body
 
-    for(uint32_t i = 0; i < nblocks; i++)
+    for(uint32_t i = first_block; i < nblocks; i++)
     {
-        uint64_t k1 = getblock(key, i*2+0);
-        uint64_t k2 = getblock(key, i*2+1);
-
-        k1 *= c1; k1 = rotl64(k1,31); k1 *= c2; h1 ^= k1;
-
-        h1 = rotl64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
-
-        k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2 ^= k2;
-
-        h2 = rotl64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+        mix_block(getblock(key, i*2+0), getblock(key, i*2+1), h1, h2);
     }
 
     //----------
@@ -218,5 +221,41 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     result[1] = h2;
 }
 
+void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+{
+    hash3_x64_128_from(key, 0, seed, seed, result);
+}
+
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t,2>> results)
+{
+    // Keys are hashed in groups of lanes keys, whose block loops are interleaved
+    // up to the length of the shortest one. The states of the lanes are
+    // independent, so the multiplications of one lane don't wait for those of
+    // the others, and the compiler can vectorize them where the target allows.
+    constexpr size_t lanes = 4;
+    size_t i = 0;
+    for (; i + lanes <= keys.size(); i += lanes) {
+        uint64_t h1[lanes];
+        uint64_t h2[lanes];
+        uint32_t common_blocks = std::numeric_limits<uint32_t>::max();
+        for (size_t l = 0; l < lanes; ++l) {
+            h1[l] = seed;
+            h2[l] = seed;
+            common_blocks = std::min(common_blocks, uint32_t(keys[i + l].size() >> 4));
+        }
+        for (uint32_t b = 0; b < common_blocks; ++b) {
+            for (size_t l = 0; l < lanes; ++l) {
+                mix_block(getblock(keys[i + l], b*2+0), getblock(keys[i + l], b*2+1), h1[l], h2[l]);
+            }
+        }
+        for (size_t l = 0; l < lanes; ++l) {
+            hash3_x64_128_from(keys[i + l], common_blocks, h1[l], h2[l], results[i + l]);
+        }
+    }
+    for (; i < keys.size(); ++i) {
+        hash3_x64_128(keys[i], seed, results[i]);
+    }
+}
+
 } // namespace murmur_hash
 } // namespace utils
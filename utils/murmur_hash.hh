@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <array>
+#include <span>
 
 #include "bytes.hh"
 
@@ -139,6 +140,11 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Hashes each of keys into the matching element of results, which must be as
+// long as keys, with the same result as hash3_x64_128() of each key, but
+// faster than hashing them one by one.
+void hash3_x64_128(std::span<const bytes_view> keys, uint64_t seed, std::span<std::array<uint64_t, 2>> results);
+
 } // namespace murmur_hash
 
 } // namespace utils
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <array>
+
+#include <seastar/core/reactor.hh>
+
+#include "utils/stall_activity.hh"
+#include "seastarx.hh"
+
+namespace utils {
+
+static thread_local std::array<stall_activity_stats, size_t(stall_activity::count)> stall_activity_stats_per_activity;
+
+std::string_view to_string(stall_activity activity) noexcept {
+    switch (activity) {
+    case stall_activity::none: return "none";
+    case stall_activity::allocating_section: return "allocating_section";
+    case stall_activity::lsa_reclaim: return "lsa_reclaim";
+    case stall_activity::memtable_flush: return "memtable_flush";
+    case stall_activity::compaction_planning: return "compaction_planning";
+    case stall_activity::cql_parse: return "cql_parse";
+    case stall_activity::cql_prepare: return "cql_prepare";
+    case stall_activity::cql_execute: return "cql_execute";
+    case stall_activity::count: break;
+    }
+    return "unknown";
+}
+
+const stall_activity_stats& get_stall_activity_stats(stall_activity activity) noexcept {
+    return stall_activity_stats_per_activity[size_t(activity)];
+}
+
+void internal::on_stall_activity_scope_end(stall_activity activity, coarse_steady_clock::duration elapsed) noexcept {
+    if (elapsed < engine().get_blocked_reactor_notify_ms()) {
+        return;
+    }
+    auto& stats = stall_activity_stats_per_activity[size_t(activity)];
+    ++stats.stalls;
+    stats.stall_time += elapsed;
+    ++stall_activity_generation;
+}
+
+} // namespace utils
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "utils/coarse_steady_clock.hh"
+
+// Attributes reactor stalls to the subsystem that caused them.
+//
+// Entry points of synchronous code which is known to stall the reactor at
+// times tag themselves with a stall_activity_scope. Scopes nest, the
+// innermost one being the current activity. A scope which runs for at least
+// the reactor's blocked_reactor_notify_ms is counted as a stall of its
+// activity, unless one of the scopes nested in it was already counted.
+//
+// The scopes measure themselves, they are not sampled by seastar's stall
+// detector, so a stall is attributed only if it is contained in a scope.
+// A scope must not span a suspension point, or it would attribute the time
+// spent in other tasks to its activity.
+
+namespace utils {
+
+enum class stall_activity : uint8_t {
+    none,
+    allocating_section,
+    lsa_reclaim,
+    memtable_flush,
+    compaction_planning,
+    cql_parse,
+    cql_prepare,
+    cql_execute,
+    count,
+};
+
+std::string_view to_string(stall_activity) noexcept;
+
+struct stall_activity_stats {
+    uint64_t stalls = 0;
+    coarse_steady_clock::duration stall_time{0};
+};
+
+// Stalls attributed to the activity on this shard.
+const stall_activity_stats& get_stall_activity_stats(stall_activity) noexcept;
+
+namespace internal {
+
+inline thread_local stall_activity current_stall_activity = stall_activity::none;
+// Bumped on every stall counted, so that the scopes enclosing the one which
+// counted it don't count it again.
+inline thread_local uint64_t stall_activity_generation = 0;
+
+void on_stall_activity_scope_end(stall_activity, coarse_steady_clock::duration) noexcept;
+
+}
+
+inline stall_activity current_stall_activity() noexcept {
+    return internal::current_stall_activity;
+}
+
+class stall_activity_scope {
+    stall_activity _prev;
+    uint64_t _generation;
+    coarse_steady_clock::time_point _start;
+public:
+    explicit stall_activity_scope(stall_activity activity) noexcept
+        : _prev(internal::current_stall_activity)
+        , _generation(internal::stall_activity_generation)
+        , _start(coarse_steady_clock::now())
+    {
+        internal::current_stall_activity = activity;
+    }
+    stall_activity_scope(const stall_activity_scope&) = delete;
+    stall_activity_scope& operator=(const stall_activity_scope&) = delete;
+    ~stall_activity_scope() {
+        auto activity = std::exchange(internal::current_stall_activity, _prev);
+        auto elapsed = coarse_steady_clock::now() - _start;
+        // The coarse clock ticks every few milliseconds, so most scopes see no time pass.
+        if (elapsed.count() && _generation == internal::stall_activity_generation) [[unlikely]] {
+            internal::on_stall_activity_scope_end(activity, elapsed);
+        }
+    }
+};
+
+} // namespace utils
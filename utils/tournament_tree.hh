@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// A tournament (winner) tree over a dynamic set of elements.
+//
+// Elements occupy the leaves of a complete binary tree, and every inner node
+// remembers the winner (the lesser element) of the match played between its
+// children. Changing a leaf replays only the matches on its path to the root,
+// one comparison per level, so replacing the minimum takes log N comparisons
+// where popping from and pushing into a binary heap takes up to twice that.
+//
+// To take advantage of it, pop() doesn't replay the matches: the freed leaf is
+// taken by the next push(). Only if some other operation comes first are the
+// matches replayed with the leaf empty.
+//
+// Each node also remembers whether its match was a tie, so top_has_equal()
+// tells whether the minimum is unique without comparing anything.
+//
+// TriCompare returns std::strong_ordering (or anything comparable with 0).
+template <typename T, typename TriCompare>
+class tournament_tree {
+    using slot_index = uint32_t;
+    static constexpr slot_index none = std::numeric_limits<slot_index>::max();
+
+    TriCompare _cmp;
+    // The leaves. Their number is the capacity, which is a power of two.
+    std::vector<std::optional<T>> _slots;
+    // _nodes[n] is the slot which won the match at node n, or none if the whole
+    // subtree is empty. Children of node n are 2n and 2n + 1, the root is node 1
+    // and slot s is the leaf node s + capacity.
+    std::vector<slot_index> _nodes;
+    // Whether the match at node n was played between equal elements.
+    std::vector<bool> _ties;
+    std::vector<slot_index> _free;
+    // The slot of the last popped element, not replayed yet.
+    slot_index _pending = none;
+    size_t _size = 0;
+private:
+    slot_index capacity() const noexcept {
+        return _slots.size();
+    }
+
+    // Empty subtrees lose every match.
+    void play(slot_index n) {
+        auto a = _nodes[2 * n];
+        auto b = _nodes[2 * n + 1];
+        if (a == none || b == none) {
+            _nodes[n] = a == none ? b : a;
+            _ties[n] = false;
+            return;
+        }
+        auto c = _cmp(*_slots[a], *_slots[b]);
+        _nodes[n] = c <= 0 ? a : b;
+        _ties[n] = c == 0;
+    }
+
+    void replay(slot_index s) {
+        auto leaf = s + capacity();
+        _nodes[leaf] = _slots[s] ? s : none;
+        for (auto n = leaf / 2; n > 0; n /= 2) {
+            play(n);
+        }
+    }
+
+    void grow() {
+        auto old_cap = capacity();
+        auto new_cap = std::max<slot_index>(1, 2 * old_cap);
+        _slots.resize(new_cap);
+        _nodes.assign(2 * new_cap, none);
+        _ties.assign(2 * new_cap, false);
+        for (slot_index s = 0; s < new_cap; ++s) {
+            _nodes[s + new_cap] = _slots[s] ? s : none;
+        }
+        for (auto n = new_cap - 1; n > 0; --n) {
+            play(n);
+        }
+        for (auto s = new_cap; s > old_cap; --s) {
+            _free.push_back(s - 1);
+        }
+    }
+
+    void settle() {
+        if (_pending != none) {
+            replay(_pending);
+            _free.push_back(std::exchange(_pending, none));
+        }
+    }
+public:
+    explicit tournament_tree(TriCompare cmp)
+        : _cmp(std::move(cmp)) {
+    }
+
+    bool empty() const noexcept {
+        return _size == 0;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+    // The minimum. The tree must not be empty.
+    T& top() {
+        settle();
+        return *_slots[_nodes[1]];
+    }
+
+    // Whether some other element is equal to top(). The tree must not be empty.
+    //
+    // The element closest to the minimum lost its match directly to it, so it
+    // is enough to look at the matches on the path of the minimum.
+    bool top_has_equal() {
+        settle();
+        for (auto n = (_nodes[1] + capacity()) / 2; n > 0; n /= 2) {
+            if (_ties[n]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Removes and returns the minimum. The tree must not be empty.
+    T pop() {
+        settle();
+        auto s = _nodes[1];
+        T ret = std::move(*_slots[s]);
+        _slots[s].reset();
+        _pending = s;
+        --_size;
+        return ret;
+    }
+
+    void push(T v) {
+        auto s = std::exchange(_pending, none);
+        if (s == none) {
+            if (_free.empty()) {
+                grow();
+            }
+            s = _free.back();
+            _free.pop_back();
+        }
+        _slots[s].emplace(std::move(v));
+        ++_size;
+        replay(s);
+    }
+
+    void clear() {
+        _free.clear();
+        for (auto s = capacity(); s > 0; --s) {
+            _slots[s - 1].reset();
+            _free.push_back(s - 1);
+        }
+        std::fill(_nodes.begin(), _nodes.end(), none);
+        std::fill(_ties.begin(), _ties.end(), false);
+        _pending = none;
+        _size = 0;
+    }
+
+    // Calls func on each element, in no particular order.
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (auto& slot : _slots) {
+            if (slot) {
+                func(*slot);
+            }
+        }
+    }
+};
+
+} // namespace utils
@@ -6,33 +6,118 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <unordered_map>
+
 #include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/shared_ptr.hh>
 
 // We need to use experimental features of the zstd library (to allocate compression/decompression context),
 // which are available only when the library is linked statically.
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstd.h"
+#include "zdict.h"
 
 #include "compress.hh"
 #include "utils/class_registrator.hh"
 
 static const sstring COMPRESSION_LEVEL = "compression_level";
+static const sstring DICTIONARY_SIZE_KB = "dictionary_size_in_kb";
 static const sstring COMPRESSOR_NAME = compressor::namespace_prefix + "ZstdCompressor";
 
+// The dictionary is kept in memory on every shard for as long as any sstable
+// compressed with it is open, so don't let it grow unreasonably.
+static constexpr int max_dictionary_size_kb = 1024;
+
+// Decompression dictionary, shared by all readers of sstables compressed
+// with the same dictionary on this shard.
+class zstd_ddict : public enable_lw_shared_from_this<zstd_ddict> {
+    bytes _raw;
+    ZSTD_DDict* _ddict;
+
+    static thread_local std::unordered_map<bytes, zstd_ddict*> _registry;
+public:
+    explicit zstd_ddict(bytes raw)
+        : _raw(std::move(raw))
+        , _ddict(ZSTD_createDDict(_raw.data(), _raw.size()))
+    {
+        if (!_ddict) {
+            throw std::runtime_error("Unable to initialize ZSTD decompression dictionary");
+        }
+    }
+    zstd_ddict(const zstd_ddict&) = delete;
+    ~zstd_ddict() {
+        _registry.erase(_raw);
+        ZSTD_freeDDict(_ddict);
+    }
+    const ZSTD_DDict* get() const {
+        return _ddict;
+    }
+
+    static lw_shared_ptr<zstd_ddict> get_or_create(bytes_view raw) {
+        bytes key(raw.begin(), raw.end());
+        auto it = _registry.find(key);
+        if (it != _registry.end()) {
+            return it->second->shared_from_this();
+        }
+        auto d = make_lw_shared<zstd_ddict>(std::move(key));
+        _registry.emplace(d->_raw, d.get());
+        return d;
+    }
+};
+
+thread_local std::unordered_map<bytes, zstd_ddict*> zstd_ddict::_registry;
+
+// Compression dictionary. Only the writer of an sstable compresses with
+// its dictionary, so there is no point in sharing it.
+class zstd_cdict {
+    ZSTD_CDict* _cdict;
+public:
+    zstd_cdict(bytes_view raw, ZSTD_compressionParameters cparams)
+        : _cdict(ZSTD_createCDict_advanced(raw.data(), raw.size(), ZSTD_dlm_byCopy, ZSTD_dct_auto, cparams, ZSTD_defaultCMem))
+    {
+        if (!_cdict) {
+            throw std::runtime_error("Unable to initialize ZSTD compression dictionary");
+        }
+    }
+    zstd_cdict(const zstd_cdict&) = delete;
+    ~zstd_cdict() {
+        ZSTD_freeCDict(_cdict);
+    }
+    const ZSTD_CDict* get() const {
+        return _cdict;
+    }
+};
+
 class zstd_processor : public compressor {
     int _compression_level = 3;
+    size_t _chunk_len;
+    size_t _dictionary_size = 0;
+
+    // Compression and decompression contexts. Shared between a processor
+    // and the dictionary-bound processors derived from it via with_dictionary().
+    struct contexts {
+        size_t cctx_size;
+        // Manages memory for the compression context.
+        std::unique_ptr<char[], free_deleter> cctx_raw;
+        // Compression context. Observer of cctx_raw.
+        ZSTD_CCtx* cctx;
 
-    // Manages memory for the compression context.
-    std::unique_ptr<char[], free_deleter> _cctx_raw;
-    // Compression context. Observer of _cctx_raw.
-    ZSTD_CCtx* _cctx;
+        // Manages memory for the decompression context.
+        std::unique_ptr<char[], free_deleter> dctx_raw;
+        // Decompression context. Observer of dctx_raw.
+        ZSTD_DCtx* dctx;
+    };
+    lw_shared_ptr<contexts> _ctx;
 
-    // Manages memory for the decompression context.
-    std::unique_ptr<char[], free_deleter> _dctx_raw;
-    // Decompression context. Observer of _dctx_raw.
-    ZSTD_DCtx* _dctx;
+    // Engaged only for processors bound to a dictionary.
+    // The compression dictionary is built on first use, since most
+    // processors bound to a dictionary only ever decompress.
+    bytes _dict;
+    mutable std::unique_ptr<zstd_cdict> _cdict;
+    lw_shared_ptr<zstd_ddict> _ddict;
 public:
     zstd_processor(const opt_getter&);
+    zstd_processor(const zstd_processor&, bytes_view dict);
 
     size_t uncompress(const char* input, size_t input_len, char* output,
                     size_t output_len) const override;
@@ -40,10 +125,41 @@ class zstd_processor : public compressor {
                     size_t output_len) const override;
     size_t compress_max_size(size_t input_len) const override;
 
+    ptr_type with_dictionary(bytes_view dict) const override;
+    std::optional<bytes> train_dictionary(const std::vector<bytes_view>& samples) const override;
+    size_t dictionary_size() const override {
+        return _dictionary_size;
+    }
+
     std::set<sstring> option_names() const override;
     std::map<sstring, sstring> options() const override;
+private:
+    ZSTD_compressionParameters cparams(size_t dict_size) const {
+        // We assume that the uncompressed input length is always <= chunk_len.
+        return ZSTD_getCParams(_compression_level, _chunk_len, dict_size);
+    }
+    static lw_shared_ptr<contexts> make_contexts(size_t cctx_size);
 };
 
+lw_shared_ptr<zstd_processor::contexts> zstd_processor::make_contexts(size_t cctx_size) {
+    auto ctx = make_lw_shared<contexts>();
+    ctx->cctx_size = cctx_size;
+    // According to the ZSTD documentation, pointer to the context buffer must be 8-bytes aligned.
+    ctx->cctx_raw = allocate_aligned_buffer<char>(cctx_size, 8);
+    ctx->cctx = ZSTD_initStaticCCtx(ctx->cctx_raw.get(), cctx_size);
+    if (!ctx->cctx) {
+        throw std::runtime_error("Unable to initialize ZSTD compression context");
+    }
+
+    auto dctx_size = ZSTD_estimateDCtxSize();
+    ctx->dctx_raw = allocate_aligned_buffer<char>(dctx_size, 8);
+    ctx->dctx = ZSTD_initStaticDCtx(ctx->dctx_raw.get(), dctx_size);
+    if (!ctx->dctx) {
+        throw std::runtime_error("Unable to initialize ZSTD decompression context");
+    }
+    return ctx;
+}
+
 zstd_processor::zstd_processor(const opt_getter& opts)
     : compressor(COMPRESSOR_NAME) {
     auto level = opts(COMPRESSION_LEVEL);
@@ -63,35 +179,59 @@ zstd_processor::zstd_processor(const opt_getter& opts)
         }
     }
 
+    auto dict_size_kb = opts(DICTIONARY_SIZE_KB);
+    if (dict_size_kb) {
+        int size_kb;
+        try {
+            size_kb = std::stoi(*dict_size_kb);
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(
+                format("Invalid integer value {} for {}", *dict_size_kb, DICTIONARY_SIZE_KB));
+        }
+        if (size_kb < 0 || size_kb > max_dictionary_size_kb) {
+            throw exceptions::configuration_exception(
+                format("{} must be between 0 and {}, got {}", DICTIONARY_SIZE_KB, max_dictionary_size_kb, size_kb));
+        }
+        _dictionary_size = size_t(size_kb) * 1024;
+    }
+
     auto chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB);
     if (!chunk_len_kb) {
         chunk_len_kb = opts(compression_parameters::CHUNK_LENGTH_KB_ERR);
     }
-    auto chunk_len = chunk_len_kb
+    _chunk_len = chunk_len_kb
        // This parameter has already been validated.
        ? std::stoi(*chunk_len_kb) * 1024
        : compression_parameters::DEFAULT_CHUNK_LENGTH;
 
-    // We assume that the uncompressed input length is always <= chunk_len.
-    auto cparams = ZSTD_getCParams(_compression_level, chunk_len, 0);
-    auto cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams);
-    // According to the ZSTD documentation, pointer to the context buffer must be 8-bytes aligned.
-    _cctx_raw = allocate_aligned_buffer<char>(cctx_size, 8);
-    _cctx = ZSTD_initStaticCCtx(_cctx_raw.get(), cctx_size);
-    if (!_cctx) {
-        throw std::runtime_error("Unable to initialize ZSTD compression context");
+    auto cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams(0));
+    if (_dictionary_size) {
+        // Parameters tuned for a dictionary may need a larger context.
+        cctx_size = std::max(cctx_size, ZSTD_estimateCCtxSize_usingCParams(cparams(_dictionary_size)));
     }
+    _ctx = make_contexts(cctx_size);
+}
 
-    auto dctx_size = ZSTD_estimateDCtxSize();
-    _dctx_raw = allocate_aligned_buffer<char>(dctx_size, 8);
-    _dctx = ZSTD_initStaticDCtx(_dctx_raw.get(), dctx_size);
-    if (!_cctx) {
-        throw std::runtime_error("Unable to initialize ZSTD decompression context");
+zstd_processor::zstd_processor(const zstd_processor& o, bytes_view dict)
+    : compressor(COMPRESSOR_NAME)
+    , _compression_level(o._compression_level)
+    , _chunk_len(o._chunk_len)
+    , _dictionary_size(o._dictionary_size)
+    , _ctx(o._ctx)
+    , _dict(dict.begin(), dict.end())
+    , _ddict(zstd_ddict::get_or_create(dict))
+{
+    auto cctx_size = ZSTD_estimateCCtxSize_usingCParams(cparams(dict.size()));
+    if (cctx_size > _ctx->cctx_size) {
+        // The contexts were sized for a different dictionary size.
+        _ctx = make_contexts(cctx_size);
     }
 }
 
 size_t zstd_processor::uncompress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_decompressDCtx(_dctx, output, output_len, input, input_len);
+    auto ret = _ddict
+        ? ZSTD_decompress_usingDDict(_ctx->dctx, output, output_len, input, input_len, _ddict->get())
+        : ZSTD_decompressDCtx(_ctx->dctx, output, output_len, input, input_len);
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD decompression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -100,7 +240,12 @@ size_t zstd_processor::uncompress(const char* input, size_t input_len, char* out
 
 
 size_t zstd_processor::compress(const char* input, size_t input_len, char* output, size_t output_len) const {
-    auto ret = ZSTD_compressCCtx(_cctx, output, output_len, input, input_len, _compression_level);
+    if (_ddict && !_cdict) {
+        _cdict = std::make_unique<zstd_cdict>(_dict, cparams(_dict.size()));
+    }
+    auto ret = _cdict
+        ? ZSTD_compress_usingCDict(_ctx->cctx, output, output_len, input, input_len, _cdict->get())
+        : ZSTD_compressCCtx(_ctx->cctx, output, output_len, input, input_len, _compression_level);
     if (ZSTD_isError(ret)) {
         throw std::runtime_error( format("ZSTD compression failure: {}", ZSTD_getErrorName(ret)));
     }
@@ -111,12 +256,48 @@ size_t zstd_processor::compress_max_size(size_t input_len) const {
     return ZSTD_compressBound(input_len);
 }
 
+compressor::ptr_type zstd_processor::with_dictionary(bytes_view dict) const {
+    return ::make_shared<zstd_processor>(*this, dict);
+}
+
+std::optional<bytes> zstd_processor::train_dictionary(const std::vector<bytes_view>& samples) const {
+    if (!_dictionary_size || samples.empty()) {
+        return std::nullopt;
+    }
+    size_t total_size = 0;
+    for (auto& s : samples) {
+        total_size += s.size();
+    }
+    bytes samples_buffer(bytes::initialized_later(), total_size);
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    auto out = samples_buffer.begin();
+    for (auto& s : samples) {
+        out = std::copy(s.begin(), s.end(), out);
+        sample_sizes.push_back(s.size());
+    }
+
+    bytes dict(bytes::initialized_later(), _dictionary_size);
+    auto ret = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples_buffer.data(), sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(ret)) {
+        // Most likely not enough (or too uniform) data to train on,
+        // compressing without a dictionary is the right fallback.
+        return std::nullopt;
+    }
+    dict.resize(ret);
+    return dict;
+}
+
 std::set<sstring> zstd_processor::option_names() const {
-    return {COMPRESSION_LEVEL};
+    return {COMPRESSION_LEVEL, DICTIONARY_SIZE_KB};
 }
 
 std::map<sstring, sstring> zstd_processor::options() const {
-    return {{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    std::map<sstring, sstring> opts{{COMPRESSION_LEVEL, std::to_string(_compression_level)}};
+    if (_dictionary_size) {
+        opts.emplace(DICTIONARY_SIZE_KB, std::to_string(_dictionary_size / 1024));
+    }
+    return opts;
 }
 
 static const class_registrator<compressor, zstd_processor, const compressor::opt_getter&>